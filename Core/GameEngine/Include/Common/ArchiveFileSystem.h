@@ -54,6 +54,8 @@
 #include "Common/FileSystem.h" // for typedefs, etc.
 #include "Common/STLTypedefs.h"
 
+#include <cstdio>
+
 //----------------------------------------------------------------------------
 //           Forward References
 //----------------------------------------------------------------------------
@@ -164,8 +166,17 @@ protected:
 
 	virtual void loadIntoDirectoryTree(ArchiveFile *archiveFile, Bool overwrite = FALSE);	///< load the archive file's header information and apply it to the global archive directory tree.
 
+	void traceFileOpen(const Char *filename, ArchiveFile *archive);	///< write the first open of each archived file to the access trace, see -archiveTrace
+
 	ArchiveFileMap m_archiveFileMap;
 	ArchivedDirectoryInfo m_rootDirectory;
+
+	// GeneralsX @performance 18/10/2026 The order the archived files are first opened in, for the BIG
+	// archive builder to store them next to each other. Files may be opened from several threads.
+	FastCriticalSectionClass m_accessTraceMutex;
+	FILE *m_accessTrace;
+	Bool m_accessTraceFailed;		///< the trace file could not be created, guarded by m_accessTraceMutex like the rest
+	std::set<AsciiString> m_tracedFiles;
 };
 
 
@@ -107,6 +107,13 @@ protected:
 	void releaseBuffer();
 	void ensureUniqueBufferOfSize(int numCharsNeeded, Bool preserveData, const char* strToCpy, const char* strToCat);
 
+	// GeneralsX @performance 18/10/2026 Short strings get their buffers from a free list of blocks
+	// of one size instead of the dynamic memory allocator, and interned strings share one buffer per
+	// text. An interned buffer has m_numCharsAllocated of 0, so it is never written in place.
+	static AsciiStringData* allocateBuffer(int minBytes);
+	static void freeBuffer(AsciiStringData* data);
+	void shareBuffer(AsciiStringData* data);	///< take a reference to the buffer of another string
+
 public:
 
 	typedef Char value_type;
@@ -382,8 +389,43 @@ public:
 	AsciiString& operator=(const AsciiString& stringSrc);	///< the same as set()
 	AsciiString& operator=(const char* s);				///< the same as set()
 
+	/**
+		Make self share the buffer of the interning table that holds the same text,
+		adding the text to the table if it is not there yet. Meant for immutable
+		identifiers, such as template and audio event names: two interned strings
+		are equal iff they share a buffer, so comparing them is a pointer check.
+		Modifying an interned string gives it a private copy, as with any shared buffer.
+	*/
+	void intern();
+
+	/**
+		return true iff self shares a buffer of the interning table.
+	*/
+	Bool isInterned() const;
+
+	/**
+		Turn the small string buffers and the interning table on or off, to compare
+		against the plain allocations. Strings interned before stay interned.
+	*/
+	static void setStorageEnabled(Bool enabled);
+	static Bool isStorageEnabled();
+
+	/**
+		The number of buffers taken from the dynamic memory allocator so far.
+	*/
+	static UnsignedInt getNumBufferAllocations();
+
+	/**
+		Free the spare small string buffers and drop the references of the interning
+		table. Called when the memory manager shuts down; nothing is interned afterwards.
+	*/
+	static void releaseStorage();
+
 	void debugIgnoreLeaks();
 
+	friend Bool operator==(const AsciiString& s1, const AsciiString& s2);
+	friend Bool operator!=(const AsciiString& s1, const AsciiString& s2);
+
 };
 
 // -----------------------------------------------------
@@ -452,6 +494,12 @@ inline const char* AsciiString::str() const
 	return m_data ? peek() : &TheNullChr;
 }
 
+// -----------------------------------------------------
+inline Bool AsciiString::isInterned() const
+{
+	return m_data != nullptr && m_data->m_numCharsAllocated == 0;
+}
+
 // -----------------------------------------------------
 inline AsciiString& AsciiString::operator=(const AsciiString& stringSrc)
 {
@@ -492,6 +540,8 @@ inline void AsciiString::concat(const char c)
 inline int AsciiString::compare(const AsciiString& stringSrc) const
 {
 	validate();
+	if (m_data == stringSrc.m_data)
+		return 0;
 	return strcmp(this->str(), stringSrc.str());
 }
 
@@ -531,13 +581,17 @@ inline const char* AsciiString::reverseFind(char c) const
 // -----------------------------------------------------
 inline Bool operator==(const AsciiString& s1, const AsciiString& s2)
 {
+	if (s1.m_data == s2.m_data)
+		return true;
+	if (s1.isInterned() && s2.isInterned())
+		return false;
 	return strcmp(s1.str(), s2.str()) == 0;
 }
 
 // -----------------------------------------------------
 inline Bool operator!=(const AsciiString& s1, const AsciiString& s2)
 {
-	return strcmp(s1.str(), s2.str()) != 0;
+	return !(s1 == s2);
 }
 
 // -----------------------------------------------------
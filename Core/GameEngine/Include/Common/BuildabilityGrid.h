@@ -0,0 +1,80 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: BuildabilityGrid.h ///////////////////////////////////////////////////////////////////////
+// What stops construction in each pathfind cell of the map
+// GeneralsX @performance 18/10/2026 The AI placement searches call BuildAssistant::isLocationLegalToBuild
+// for every step they take outward, and each call looked up the terrain type of every footprint sample
+// by name and searched the partition cells for objects in the way. The grid keeps which cells are on
+// restricted terrain tiles and which immobile objects cover them, so the searches can rule out blocked
+// locations before running the full check.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Lib/BaseType.h"
+#include "Common/GameType.h"
+
+#include <vector>
+
+class Object;
+
+class BuildabilityGrid
+{
+public:
+
+	BuildabilityGrid();
+
+	// Forgets the cells of the map, they are set up again on the next query
+	void reset();
+
+	// The immobile objects are placed again on the next query
+	void invalidateObstacles() { m_obstaclesValid = FALSE; }
+
+	// Whether a footprint sample in this pathfind cell stops construction, the same test as
+	// checkSampleBuildLocation makes: the terrain tile under it restricts construction, or the cell is
+	// water, cliff, impassable or off the pathfind map
+	Bool isCellRestricted(Int cellX, Int cellY);
+
+	// An immobile object whose bounds touch this pathfind cell, INVALID_ID if there is none. A cell
+	// touched by several of them keeps only one.
+	ObjectID getObstacleAt(Int cellX, Int cellY);
+
+	// Whether an object always keeps structures from being built on top of it
+	static Bool isObstacle(const Object *obj);
+
+	// Turns the grid off, to check the placement searches against the full checks
+	static void setEnabled(Bool enabled) { s_isEnabled = enabled; }
+	static Bool isEnabled() { return s_isEnabled; }
+
+private:
+
+	void validate();
+	void placeObstacles();
+	Bool isInGrid(Int cellX, Int cellY) const { return cellX >= 0 && cellY >= 0 && cellX < m_cellsX && cellY < m_cellsY; }
+	static Bool isTileRestricted(Int cellX, Int cellY);
+
+	Bool m_isValid;
+	Bool m_obstaclesValid;
+	Int m_cellsX;
+	Int m_cellsY;
+	std::vector<UnsignedByte> m_restrictedTiles;	///< 1 where the terrain tile of the cell restricts construction
+	std::vector<ObjectID> m_obstacles;						///< an immobile object touching each cell
+
+	static Bool s_isEnabled;
+};
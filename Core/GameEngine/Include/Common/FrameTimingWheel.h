@@ -0,0 +1,198 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: FrameTimingWheel.h ///////////////////////////////////////////////////////////////////////
+// Deterministic queue of values that become due on a given logic frame
+// GeneralsX @performance 18/10/2026 Frame keyed queues used to be lists that were walked in full
+// every frame. The wheel only touches the entries that are due.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Lib/BaseType.h"
+
+#include <algorithm>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+/** Hierarchical timing wheel keyed by frame number.
+	*
+	* Entries due within the current block of NEAR_SLOTS frames sit in the near wheel, one slot per
+	* frame. Entries due later in the current span of FAR_SLOTS blocks sit in the far wheel, one slot
+	* per block, and are moved down to the near wheel when their block starts. Anything further out
+	* waits in the overflow list, which is only looked at once per span.
+	*
+	* popDue() hands the due entries back in the order they were scheduled, the same order a list
+	* that is appended to and walked from the front each frame would deal them out. That includes
+	* entries that are scheduled for the current frame while the due entries are being popped, they
+	* come after all entries that were already due. */
+//-------------------------------------------------------------------------------------------------
+template <typename T>
+class FrameTimingWheel
+{
+
+public:
+
+	FrameTimingWheel() : m_currentFrame( 0 ), m_nextSequence( 0 ), m_count( 0 ), m_firingIndex( 0 ) { }
+
+	/// remove all entries and start over at frame 0
+	void clear()
+	{
+		for( Int i = 0; i < NEAR_SLOTS; ++i )
+			m_near[ i ].clear();
+		for( Int i = 0; i < FAR_SLOTS; ++i )
+			m_far[ i ].clear();
+		m_overflow.clear();
+		m_due.clear();
+		m_firing.clear();
+
+		m_currentFrame = 0;
+		m_nextSequence = 0;
+		m_count = 0;
+		m_firingIndex = 0;
+	}
+
+	/// add a value that becomes due on the given frame, frames in the past are due right away
+	void schedule( UnsignedInt frame, const T &value )
+	{
+		Entry entry;
+		entry.m_frame = frame;
+		entry.m_sequence = m_nextSequence++;
+		entry.m_value = value;
+
+		insert( entry );
+		++m_count;
+	}
+
+	/** Advance the wheel to the given frame and take the next due value out of it.
+		* Returns FALSE once there are no more values due on or before that frame */
+	Bool popDue( UnsignedInt frame, T &value )
+	{
+		if( m_firingIndex >= m_firing.size() )
+		{
+			m_firing.clear();
+			m_firingIndex = 0;
+
+			advanceTo( frame );
+			if( m_due.empty() )
+				return FALSE;
+
+			// the slots were filled at different times, put the batch back in scheduling order
+			m_firing.swap( m_due );
+			std::sort( m_firing.begin(), m_firing.end(), isScheduledEarlier );
+		}
+
+		value = m_firing[ m_firingIndex++ ].m_value;
+		--m_count;
+		return TRUE;
+	}
+
+	size_t size() const { return m_count; }
+	Bool isEmpty() const { return m_count == 0; }
+
+private:
+
+	enum
+	{
+		NEAR_BITS = 8,
+		NEAR_SLOTS = 1 << NEAR_BITS,
+		NEAR_MASK = NEAR_SLOTS - 1,
+		FAR_BITS = 6,
+		FAR_SLOTS = 1 << FAR_BITS,
+		FAR_MASK = FAR_SLOTS - 1,
+		SPAN_BITS = NEAR_BITS + FAR_BITS,
+		SPAN_MASK = (1 << SPAN_BITS) - 1
+	};
+
+	struct Entry
+	{
+		UnsignedInt m_frame;
+		UnsignedInt64 m_sequence;			///< order in which the entries were scheduled
+		T m_value;
+	};
+
+	typedef std::vector<Entry> EntryVector;
+
+	static Bool isScheduledEarlier( const Entry &a, const Entry &b )
+	{
+		return a.m_sequence < b.m_sequence;
+	}
+
+	void insert( const Entry &entry )
+	{
+		if( entry.m_frame <= m_currentFrame )
+			m_due.push_back( entry );
+		else if( (entry.m_frame >> NEAR_BITS) == (m_currentFrame >> NEAR_BITS) )
+			m_near[ entry.m_frame & NEAR_MASK ].push_back( entry );
+		else if( (entry.m_frame >> SPAN_BITS) == (m_currentFrame >> SPAN_BITS) )
+			m_far[ (entry.m_frame >> NEAR_BITS) & FAR_MASK ].push_back( entry );
+		else
+			m_overflow.push_back( entry );
+	}
+
+	void advanceTo( UnsignedInt frame )
+	{
+		if( m_count == 0 )
+		{
+			// nothing is waiting, no need to step through the empty slots
+			if( frame > m_currentFrame )
+				m_currentFrame = frame;
+			return;
+		}
+
+		while( m_currentFrame < frame )
+		{
+			++m_currentFrame;
+
+			if( (m_currentFrame & NEAR_MASK) == 0 )
+			{
+				if( (m_currentFrame & SPAN_MASK) == 0 )
+				{
+					EntryVector overflow;
+					overflow.swap( m_overflow );
+					for( size_t i = 0; i < overflow.size(); ++i )
+						insert( overflow[ i ] );
+				}
+
+				// the block of this slot has started, all of its entries go to the near wheel
+				EntryVector &farSlot = m_far[ (m_currentFrame >> NEAR_BITS) & FAR_MASK ];
+				for( size_t i = 0; i < farSlot.size(); ++i )
+					insert( farSlot[ i ] );
+				farSlot.clear();
+			}
+
+			EntryVector &nearSlot = m_near[ m_currentFrame & NEAR_MASK ];
+			if( !nearSlot.empty() )
+			{
+				m_due.insert( m_due.end(), nearSlot.begin(), nearSlot.end() );
+				nearSlot.clear();
+			}
+		}
+	}
+
+	EntryVector m_near[ NEAR_SLOTS ];
+	EntryVector m_far[ FAR_SLOTS ];
+	EntryVector m_overflow;
+	EntryVector m_due;							///< due entries that have not been handed out yet
+	EntryVector m_firing;						///< the batch of due entries popDue() is handing out
+	UnsignedInt m_currentFrame;			///< the wheel has been advanced up to this frame
+	UnsignedInt64 m_nextSequence;
+	size_t m_count;
+	size_t m_firingIndex;
+
+};
@@ -555,6 +555,9 @@ public:
 
 	void memoryPoolUsageReport( const char* filename, FILE *appendToFileInstead = nullptr );
 
+	/// return the number of blocks allocated by all pools and dmas since startup.
+	UnsignedInt getAllocationCount() const;
+
 	#ifdef MEMORYPOOL_DEBUG
 
 		/// perform internal consistency checking
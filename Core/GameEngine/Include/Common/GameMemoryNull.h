@@ -66,6 +66,9 @@ public:
 
 	void memoryPoolUsageReport( const char* filename, FILE *appendToFileInstead = nullptr );
 
+	/// return the number of allocations made since startup, not tracked without the game memory.
+	UnsignedInt getAllocationCount() const { return 0; }
+
 #ifdef MEMORYPOOL_DEBUG
 
 	void debugMemoryReport(Int flags, Int startCheckpoint, Int endCheckpoint, FILE *fp = nullptr );
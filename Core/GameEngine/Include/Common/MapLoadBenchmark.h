@@ -0,0 +1,77 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: MapLoadBenchmark.h ///////////////////////////////////////////////////////////////////////
+// Loads a list of maps back to back and reports how long each stage of the load took
+// GeneralsX @feature 18/10/2026 Lets map load times be tracked per build. Combine with -headless.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+class MapLoadBenchmark
+{
+public:
+
+	/// The stages of GameLogic::startNewGame that are timed separately.
+	enum Stage
+	{
+		STAGE_TERRAIN_LOAD,				///< map.ini and TerrainLogic::loadMap
+		STAGE_SCRIPT_ENGINE,			///< ScriptEngine::newMap
+		STAGE_PARTITION_MANAGER,	///< PartitionManager init and first update
+		STAGE_TERRAIN_NEW_MAP,		///< TerrainLogic::newMap
+		STAGE_PATHFINDER,					///< Pathfinder::newMap, including classifyMap
+		STAGE_MAP_OBJECTS,				///< creating the objects placed on the map
+		STAGE_PRELOAD_ASSETS,			///< GameClient::preloadAssets, W3D models, textures and sounds
+
+		STAGE_COUNT
+	};
+
+	// Load each map in sequence and write one line per map to the report file, if one is given.
+	// Returns exit code 1 if a map failed to load, 0 otherwise.
+	static int benchmarkMaps(const std::vector<AsciiString> &mapNames, const AsciiString &reportFilename);
+
+	static Bool isRunning() { return s_isRunning; }
+
+	// Called by GameLogic while a map is loaded. They do nothing unless the benchmark is running.
+	static void beginMapLoad();
+	static void endMapLoad();
+	static void beginStage(Stage stage);
+	static void endStage(Stage stage);
+
+	// Called when the terrain tiles of a map are decoded, with the time the decoding took and the time
+	// the decoder threads saved the loading thread, in milliseconds.
+	static void addTerrainTileDecode(UnsignedInt decodeTime, UnsignedInt savedTime);
+
+private:
+
+	static Int64 getTimeMicroseconds();
+	static void printResult(FILE *fp, const AsciiString &mapName);
+
+private:
+
+	static Bool s_isRunning;
+	static Bool s_mapLoaded;
+	static Int64 s_mapLoadStart;
+	static Int64 s_mapLoadTime;
+	static Int64 s_stageStart[STAGE_COUNT];
+	static Int64 s_stageTime[STAGE_COUNT];
+	static UnsignedInt s_allocationsAtStart;
+	static UnsignedInt s_allocations;
+	static UnsignedInt s_terrainTileDecodeTime;
+	static UnsignedInt s_terrainTileSavedTime;
+};
@@ -78,14 +78,54 @@ enum GameMessageArgumentDataType CPP_11(: Int)
 	ARGUMENTDATATYPE_UNKNOWN
 };
 
-class GameMessageArgument : public MemoryPoolObject
+// GeneralsX @performance 18/10/2026 Arguments are stored by value now, in the message itself or in
+// a GameMessageArgumentArena, instead of being allocated from a memory pool one by one.
+struct GameMessageArgument
 {
-	MEMORY_POOL_GLUE_WITH_USERLOOKUP_CREATE(GameMessageArgument, "GameMessageArgument")
-public:
 	GameMessageArgumentType			m_data;									///< The data storage of an argument
 	GameMessageArgumentDataType	m_type;									///< The type of the argument.
 };
-EMPTY_DTOR(GameMessageArgument)
+
+class GameMessage;
+
+/**
+ * Bump allocator for the arguments of messages that do not fit in the inline storage of
+ * GameMessage. Storage is never freed one message at a time, the arena is rewound every
+ * frame once the command list has destroyed the messages of the frame. The few messages
+ * that outlive the frame, e.g. ones waiting in a network queue, are tracked and get their
+ * own copy of their arguments before the rewind, which they free themselves.
+ */
+class GameMessageArgumentArena
+{
+
+public:
+
+	GameMessageArgumentArena();
+	~GameMessageArgumentArena();
+
+	GameMessageArgument *allocate( Int count );			///< Return storage for count arguments
+	void addMessage( GameMessage *msg );						///< msg uses storage from the arena now
+	void removeMessage( Int index );								///< The message at index in m_messages is done with its storage
+	void reset();																		///< Move the storage of the remaining messages out and rewind the arena
+
+private:
+
+	GameMessageArgumentArena( const GameMessageArgumentArena& ) = delete;
+	GameMessageArgumentArena& operator=( const GameMessageArgumentArena& ) = delete;
+
+	enum { CHUNK_ARGUMENT_COUNT = 1024 };
+
+	struct Chunk
+	{
+		GameMessageArgument *m_args;
+		Int m_size;
+	};
+
+	std::vector<Chunk> m_chunks;
+	std::vector<GameMessage *> m_messages;				///< The messages that use storage from the arena
+	size_t m_currentChunk;												///< The chunk allocations are taken from
+	Int m_currentChunkUsed;												///< The number of arguments handed out from the current chunk
+};
 
 /**
  * A game message that either lives on TheMessageStream or TheCommandList.
@@ -664,7 +704,7 @@ public:
 	/**
 	 * Return the given argument union.
 	 */
-	UnsignedByte getArgumentCount() const { return static_cast<UnsignedByte>(m_argList.size()); }
+	UnsignedByte getArgumentCount() const { return static_cast<UnsignedByte>(m_argCount); }
 	const GameMessageArgumentType *getArgument( Int argIndex ) const;
 	GameMessageArgumentDataType getArgumentDataType( Int argIndex ) const;
 
@@ -672,6 +712,8 @@ public:
 	void friend_setPrev(GameMessage* m) { m_prev = m; }
 	void friend_setList(GameMessageList* m) { m_list = m; }
 	void friend_setPlayerIndex(Int i) { m_playerIndex = i; }
+	void friend_setArgArenaIndex(Int i) { m_argArenaIndex = i; }
+	void friend_moveArgsOutOfArena();
 
 private:
 	// friend classes are bad. don't use them. no, really.
@@ -684,11 +726,20 @@ private:
 
 	Int m_playerIndex;													///< The Player who issued the command
 
-	std::vector<GameMessageArgument*> m_argList;						///< This message's arguments
+	enum { INLINE_ARGUMENT_COUNT = 8 };
+
+	GameMessageArgument m_inlineArgs[ INLINE_ARGUMENT_COUNT ];	///< Storage for the arguments of most messages
+	GameMessageArgument *m_argList;							///< This message's arguments, m_inlineArgs, storage from the arena of TheCommandList or its own
+	Int m_argCount;															///< The number of arguments in m_argList
+	Int m_argCapacity;													///< The number of arguments that fit in m_argList
+	Int m_argArenaIndex;												///< Where the arena tracks this message, -1 unless m_argList is in the arena
 
 	/// allocate a new argument, add it to list, return pointer to its data
 	GameMessageArgument *allocArg();
 
+	/// give back m_argList if it is not the inline storage
+	void freeArgList();
+
 };
 
 
@@ -816,10 +867,14 @@ public:
 
 	void appendMessageList( GameMessage *list );			///< Adds messages to the end of the command list
 
+	GameMessageArgumentArena *getArgumentArena() { return &m_argumentArena; }	///< Storage for the arguments of long messages
+
 protected:
 
 	void destroyAllMessages();		///< The meat of a reset and a shutdown
 
+	GameMessageArgumentArena m_argumentArena;		///< Outlives all messages, TheCommandList is destroyed last
+
 };
 
 //
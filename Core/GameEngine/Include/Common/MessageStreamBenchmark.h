@@ -0,0 +1,33 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: MessageStreamBenchmark.h /////////////////////////////////////////////////////////////////
+// Measures how many messages per second make it through MessageStream::propagateMessages
+// GeneralsX @feature 18/10/2026 Lets the cost of GameMessage handling be compared between builds.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+class MessageStreamBenchmark
+{
+public:
+
+	// Send the given number of messages through the message stream and the command list, one batch
+	// per frame, and print the throughput. Returns the exit code.
+	static int benchmarkPropagation(Int messageCount);
+};
@@ -0,0 +1,37 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: NetworkBenchmark.h ///////////////////////////////////////////////////////////////////////
+// Runs several lockstep clients in one process over a simulated network and reports how they did
+// GeneralsX @feature 18/10/2026 Lets packet bundling and frame resends be tuned without real machines.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "GameNetwork/LoopbackNetwork.h"
+
+class NetworkBenchmark
+{
+public:
+
+	// Play the given number of frames with a ConnectionManager per player, all connected through a
+	// LoopbackNetwork with the given latency, jitter, loss and reordering. Every player keeps
+	// sending commands. Prints the frame rate, command latency, retransmits, traffic per player
+	// and run ahead changes. Returns exit code 1 if the clients stalled, 0 otherwise.
+	static int benchmarkLockstep(Int players, Int frames, const LoopbackNetwork::Settings &link);
+};
@@ -0,0 +1,170 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: ReplayCommandStream.h ////////////////////////////////////////////////////////////////////
+// Encoding and decoding of the commands in the body of a replay file
+// GeneralsX @performance 18/10/2026 The recorder used to write every field of every command with
+// its own file write. Commands are now encoded into a buffer that is written once per frame, and
+// the compact v2 format stores them with variable length integers.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Common/MessageStream.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+class File;
+
+// Every replay file starts with the magic of its format, without the terminating zero. Both are the
+// same length, so the header fields that follow stay at the same offsets.
+constexpr const char s_genrep[] = "GENREP";
+constexpr const char s_genrepV2[] = "GENRP2";
+static_assert(sizeof(s_genrep) == sizeof(s_genrepV2), "Replay magic lengths must match");
+
+/// The layouts of the replay body. The replay header is the same for all of them.
+enum ReplayFormat CPP_11(: Int)
+{
+	REPLAY_FORMAT_V1 = 1,			///< the retail layout, every field at full width
+	REPLAY_FORMAT_V2 = 2			///< varint frame deltas and arguments, shared argument signatures
+};
+
+/// Flags in the first byte of a v2 replay body
+enum ReplayBodyFlags CPP_11(: Int)
+{
+	REPLAY_BODY_COMPRESSED = 0x01	///< the commands are stored in blocks compressed by the CompressionManager
+};
+
+//-------------------------------------------------------------------------------------------------
+/** One recorded command, the network message plus the frame it was executed on */
+//-------------------------------------------------------------------------------------------------
+struct ReplayCommand
+{
+	UnsignedInt m_frame;
+	Int m_type;											///< GameMessage::Type
+	Int m_playerIndex;
+	std::vector<GameMessageArgument> m_args;
+
+	ReplayCommand() : m_frame( 0 ), m_type( 0 ), m_playerIndex( -1 ) { }
+
+	void set( UnsignedInt frame, const GameMessage *msg );	///< copy the command out of a message
+	void appendArgumentsTo( GameMessage *msg ) const;				///< append the arguments to a new message
+	Bool isSameCommand( const ReplayCommand &other ) const;
+};
+
+//-------------------------------------------------------------------------------------------------
+/** Encodes commands into a buffer and writes the buffer to the replay file in one go.
+	*
+	* For compressed v2 bodies the buffer is only written once it holds a full block, and finish()
+	* writes the last, partial, block. Uncompressed bodies are written by every flush(). */
+//-------------------------------------------------------------------------------------------------
+class ReplayCommandWriter
+{
+
+public:
+
+	ReplayCommandWriter();
+
+	/// start a new body, writes the v2 body flags to the file
+	Bool begin( File *file, ReplayFormat format, UnsignedInt bodyFlags = 0 );
+	void writeCommand( const ReplayCommand &command );
+
+	Bool flush( File *file );				///< write what has been encoded so far
+	Bool finish( File *file );			///< write everything, including a partial compressed block
+
+	ReplayFormat getFormat() const { return m_format; }
+	const std::vector<UnsignedByte> &getPendingBytes() const { return m_buffer; }
+
+private:
+
+	void writeByte( UnsignedByte value ) { m_buffer.push_back( value ); }
+	void writeBytes( const void *data, Int size );
+	void writeVarint( UnsignedInt value );
+	void writeSignedVarint( Int value );
+	void writeArgument( const GameMessageArgument &arg );
+	void writeCommandV1( const ReplayCommand &command );
+	void writeCommandV2( const ReplayCommand &command );
+	Bool writeBlock( File *file, const UnsignedByte *data, size_t size );
+
+	typedef std::map<std::string, UnsignedInt> SignatureMap;
+
+	ReplayFormat m_format;
+	UnsignedInt m_bodyFlags;
+	UnsignedInt m_lastFrame;
+	std::vector<UnsignedByte> m_buffer;
+	std::vector<UnsignedByte> m_packed;
+	std::string m_signature;
+	SignatureMap m_signatures;			///< the signatures written so far and their index
+
+};
+
+//-------------------------------------------------------------------------------------------------
+/** Decodes the commands of a replay body. The file is read in chunks, or in blocks for
+	* compressed v2 bodies, and the commands are decoded from memory. */
+//-------------------------------------------------------------------------------------------------
+class ReplayCommandReader
+{
+
+public:
+
+	ReplayCommandReader();
+
+	/// start reading the body at the current position of the file, reads the v2 body flags
+	Bool begin( File *file, ReplayFormat format, UnsignedInt wideCharBytes );
+	void end();
+
+	/// decode the next command, FALSE at the end of the body or if the body is damaged
+	Bool readCommand( ReplayCommand &command );
+
+	ReplayFormat getFormat() const { return m_format; }
+	UnsignedInt getBodyFlags() const { return m_bodyFlags; }
+
+private:
+
+	Bool fill( size_t bytes );
+	Bool readBlock();
+	Bool readBytes( void *data, Int size );
+	Bool readByte( UnsignedByte &value );
+	Bool readVarint( UnsignedInt &value );
+	Bool readSignedVarint( Int &value );
+	Bool readArgument( GameMessageArgument &arg );
+	Bool readSignature();
+	Bool readCommandV1( ReplayCommand &command );
+	Bool readCommandV2( ReplayCommand &command );
+
+	struct SignatureRun
+	{
+		UnsignedByte m_type;
+		UnsignedInt m_count;
+	};
+	typedef std::vector<SignatureRun> Signature;
+
+	File *m_file;
+	ReplayFormat m_format;
+	UnsignedInt m_bodyFlags;
+	UnsignedInt m_wideCharBytes;
+	UnsignedInt m_lastFrame;
+	std::vector<UnsignedByte> m_data;
+	std::vector<UnsignedByte> m_packed;
+	size_t m_pos;
+	Signature m_signature;									///< signature of the command being decoded
+	std::vector<Signature> m_signatures;		///< v2 signatures in the order they were first seen
+
+};
@@ -0,0 +1,52 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: ReplayConverter.h ////////////////////////////////////////////////////////////////////////
+// Converts retail replays to the compact v2 format and checks that the conversion is lossless
+// GeneralsX @feature 18/10/2026 Lets existing replay collections be shrunk. Combine with -headless.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Common/ReplayCommandStream.h"
+
+class ReplayConverter
+{
+public:
+
+	// Convert each v1 replay to a v2 replay next to it, "name.rep" becomes "name_v2.rep".
+	// The commands of the v2 replay are checked against the original, the v1 body is rebuilt from
+	// them, and both replays are simulated to check that they play back with the same CRCs.
+	// Returns exit code 1 if a replay could not be converted or a check failed, 0 otherwise.
+	static int convertReplays(const std::vector<AsciiString> &filenames, Bool compress);
+
+private:
+
+	struct PlaybackResult
+	{
+		UnsignedInt frames;
+		UnsignedInt crcCount;
+		UnsignedInt crcDigest;
+		Bool sawCRCMismatch;
+	};
+
+	static Bool convertReplay(const AsciiString &filename, Bool compress);
+	static Bool readCommands(const AsciiString &filename, ReplayFormat format, Int bodyOffset, UnsignedInt wideCharBytes,
+		std::vector<ReplayCommand> &commands, std::vector<UnsignedByte> *body);
+	static Bool simulateReplay(const AsciiString &filename, PlaybackResult &result);
+};
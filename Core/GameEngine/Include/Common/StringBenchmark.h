@@ -0,0 +1,36 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: StringBenchmark.h ////////////////////////////////////////////////////////////////////////
+// Measures the allocations and the speed of building and comparing AsciiStrings
+// GeneralsX @feature 18/10/2026 Checks the small string buffers and the interning table against
+// plain allocations and compares their speed.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+class StringBenchmark
+{
+public:
+
+	// Tokenize the INI files the way INI loading builds its strings, and format, copy and compare
+	// the template names the given number of rounds, with and without the small string buffers and
+	// interning. Prints the allocations and timings and returns the exit code, which is not 0 if
+	// the results differ.
+	static int benchmarkStrings(Int rounds);
+};
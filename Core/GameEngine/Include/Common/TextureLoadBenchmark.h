@@ -0,0 +1,33 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: TextureLoadBenchmark.h ///////////////////////////////////////////////////////////////////
+// Measures how fast the texture loader threads decode the textures of the game
+// GeneralsX @feature 18/10/2026 Shows how the texture decoding scales with the number of loader threads.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+class TextureLoadBenchmark
+{
+public:
+
+	// Load all textures in Art/Textures with 1 up to the given number of loader threads and print
+	// the throughput of each. Returns the exit code.
+	static int benchmarkDecoding(Int maxThreads);
+};
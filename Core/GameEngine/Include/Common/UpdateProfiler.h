@@ -0,0 +1,144 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: UpdateProfiler.h /////////////////////////////////////////////////////////////////////////
+// Attributes the time of GameLogic::update to the update modules and subsystems that spent it
+// GeneralsX @performance 18/10/2026 Tells which UpdateModule class and which thing template make
+// a logic frame slow. Enabled with -profileUpdates while simulating replays.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <rts/profile.h>
+
+class UpdateModule;
+
+class UpdateProfiler
+{
+public:
+
+	/// The parts of the logic update that are timed as a whole. Sections may nest.
+	enum Section
+	{
+		SECTION_LOGIC_UPDATE,				///< all of GameLogic::update
+		SECTION_SCRIPT_ENGINE,			///< ScriptEngine::update
+		SECTION_TERRAIN_LOGIC,			///< TerrainLogic::update
+		SECTION_COMMAND_LIST,				///< GameLogic::processCommandList
+		SECTION_UPDATE_MODULES,			///< the normal and sleepy update modules, see the per module stats
+		SECTION_AI,									///< AI::update, includes the players and their AIPlayer
+		SECTION_AI_PLAYER,					///< AIPlayer::update of every player with an AI
+		SECTION_BUILD_ASSISTANT,		///< BuildAssistant::update
+		SECTION_PARTITION_MANAGER,	///< PartitionManager::update
+
+		SECTION_COUNT
+	};
+
+	/// The sleep returned by the update modules is counted in power of two buckets:
+	/// 1 frame, 2-3 frames, 4-7 frames and so on, then the modules that sleep forever.
+	enum
+	{
+		SLEEP_BUCKET_FOREVER = 10,
+		SLEEP_BUCKET_COUNT
+	};
+
+	// Times one section for as long as it lives. Does nothing unless the profiler is running.
+	class SectionScope
+	{
+	public:
+		SectionScope(Section section) : m_section(section), m_start(UpdateProfiler::beginTiming()) {}
+		~SectionScope() { UpdateProfiler::endSection(m_section, m_start); }
+
+	private:
+		Section m_section;
+		Int64 m_start;
+	};
+
+	// Clears all stats and starts recording
+	static void start();
+	static void stop();
+	static Bool isRunning() { return s_isRunning; }
+
+	// Returns the start time to hand to endModule or endSection, 0 if the profiler is not running
+	static Int64 beginTiming() { return s_isRunning ? getTicks() : 0; }
+	static void endModule(const UpdateModule *module, Int64 start, UnsignedInt sleepFrames)
+	{
+		if (start != 0)
+			recordModule(module, start, sleepFrames);
+	}
+	static void endSection(Section section, Int64 start)
+	{
+		if (start != 0)
+			recordSection(section, start);
+	}
+
+	// Class name of the module, such as "PhysicsBehavior"
+	static const AsciiString &getModuleName(const UpdateModule *module);
+
+	// Writes one CSV line per section, module class and thing template, the most expensive first.
+	// Returns false if the file cannot be written.
+	static Bool writeReport(const AsciiString &filename);
+
+	// Prints the sections and the most expensive module classes and thing templates
+	static void printSummary(Int maxLines);
+
+private:
+
+	struct Stats
+	{
+		Stats();
+		void add(Int64 ticks);
+
+		UnsignedInt64 calls;
+		Int64 totalTicks;
+		Int64 worstTicks;
+		UnsignedInt sleeps[SLEEP_BUCKET_COUNT];
+	};
+
+	static Int64 getTicks();
+	static void recordSection(Section section, Int64 start);
+	static void recordModule(const UpdateModule *module, Int64 start, UnsignedInt sleepFrames);
+	static Int getSleepBucket(UnsignedInt sleepFrames);
+
+private:
+
+	static Bool s_isRunning;
+	static Stats s_sections[SECTION_COUNT];
+	static std::vector<Stats> s_modules;				///< indexed by the NameKeyType of the module class
+	static std::vector<Stats> s_templates;			///< indexed by the template ID
+	static std::vector<AsciiString> s_moduleNames;
+	static std::vector<AsciiString> s_templateNames;
+};
+
+// Times a section of the logic update, and makes it a Tracy zone when Tracy is compiled in
+#define UPDATE_PROFILER_SECTION(section, name) \
+	PROFILER_SECTION_NAME(name); \
+	UpdateProfiler::SectionScope updateProfilerSection(section)
+
+// Makes the update call of a module a Tracy zone named after the module class and thing template
+#ifdef PROFILER_ENABLED
+#define UPDATE_PROFILER_MODULE_ZONE(module) \
+	PROFILER_SECTION_NAMECOLOR("UpdateModule", 0x8BC34A); \
+	{ \
+		const AsciiString &moduleName = UpdateProfiler::getModuleName(module); \
+		const AsciiString &templateName = (module)->friend_getObject()->getTemplate()->getName(); \
+		PROFILER_SECTION_TEXT(moduleName.str(), moduleName.getLength()); \
+		PROFILER_SECTION_TEXT(templateName.str(), templateName.getLength()); \
+	}
+#else
+#define UPDATE_PROFILER_MODULE_ZONE(module) ((void)0)
+#endif
@@ -0,0 +1,35 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: WindowLookupBenchmark.h //////////////////////////////////////////////////////////////////
+// Measures the cost of finding windows by id and by position in the shell and in game layouts
+// GeneralsX @feature 18/10/2026 Checks the window id registry and the child hit grids against the
+// full searches of the window tree and compares their speed.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+class WindowLookupBenchmark
+{
+public:
+
+	// Load the shell and in game layouts, look their windows up by id and find the windows under
+	// random points the given number of rounds, with and without the registry and the hit grids.
+	// Prints the timings and returns the exit code, which is not 0 if the results differ.
+	static int benchmarkLookups(Int rounds);
+};
@@ -197,6 +197,9 @@ public:
 	virtual Real getCurrentFPS() = 0;	///< returns the current FPS.
 	virtual Int getLastFrameDrawCalls() = 0;  ///< returns the number of draw calls issued in the previous frame
 
+	/// build and check shadow silhouettes and return the exit code, see -benchmarkShadowSilhouettes
+	virtual Int benchmarkShadowSilhouettes( Int rounds );
+
 protected:
 	virtual void onBeginBatch() { }
 	virtual void onEndBatch() { }
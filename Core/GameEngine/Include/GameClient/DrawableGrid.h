@@ -0,0 +1,101 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: DrawableGrid.h ///////////////////////////////////////////////////////////////////////////
+// Uniform grid of the client drawables for region queries
+// GeneralsX @performance 18/10/2026 Region queries on the client used to walk every drawable in
+// the world. The grid hands back only the drawables in the cells a query overlaps, in the same
+// order as the drawable list.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Common/GameType.h"
+
+class Drawable;
+
+//-------------------------------------------------------------------------------------------------
+/** Grid bookkeeping kept in each drawable, only the DrawableGrid touches it */
+//-------------------------------------------------------------------------------------------------
+struct DrawableGridInfo
+{
+	Int m_bucket;						///< bucket the drawable is stored in, -1 when it is not in the grid
+	Int m_slot;							///< index of the drawable in that bucket
+	UnsignedInt m_order;				///< registration order, the drawable list runs from the highest to the lowest
+
+	DrawableGridInfo() : m_bucket( -1 ), m_slot( -1 ), m_order( 0 ) { }
+};
+
+//-------------------------------------------------------------------------------------------------
+/** Drawables are hashed into buckets by the 2D grid cell of their position. The cell coordinates
+	* wrap around every BUCKET_DIM cells, so maps up to BUCKET_DIM * CELL_SIZE wide get one bucket
+	* per cell and larger maps simply share buckets between far away cells. */
+//-------------------------------------------------------------------------------------------------
+class DrawableGrid
+{
+
+public:
+
+	DrawableGrid();
+
+	void reset();
+
+	void addDrawable( Drawable *draw );				///< add a newly registered drawable
+	void removeDrawable( Drawable *draw );			///< remove a drawable that is being destroyed
+	void updateDrawable( Drawable *draw );			///< move a drawable to the bucket of its current position
+
+	/** Collect the IDs of the drawables whose position lies in the given box, in drawable list
+		* order. Returns FALSE when the box covers so many cells that walking the drawable list is
+		* cheaper, the result is left empty in that case */
+	Bool collectDrawablesInBox( Real loX, Real loY, Real hiX, Real hiY, std::vector<DrawableID> &result );
+
+	Bool isEmpty() const { return m_count == 0; }
+	Real getLowestZ() const { return m_lowestZ; }	///< lowest z any drawable has had since the last reset
+	Real getHighestZ() const { return m_highestZ; }	///< highest z any drawable has had since the last reset
+
+private:
+
+	enum
+	{
+		CELL_SIZE = 100,
+		BUCKET_BITS = 6,
+		BUCKET_DIM = 1 << BUCKET_BITS,
+		BUCKET_COUNT = BUCKET_DIM * BUCKET_DIM,
+		MAX_QUERY_CELLS = BUCKET_COUNT / 2
+	};
+
+	static Int getCellCoord( Real value );
+	static Int getBucket( Int cellX, Int cellY );
+	static Int getBucketForPosition( const Coord3D *pos );
+
+	void insertIntoBucket( Drawable *draw, Int bucket );
+	void removeFromBucket( Drawable *draw );
+	void trackHeight( Real z );
+
+	typedef std::pair<UnsignedInt, Drawable *> OrderedDrawable;
+
+	std::vector<Drawable *> m_buckets[ BUCKET_COUNT ];
+	UnsignedInt m_bucketQueryStamp[ BUCKET_COUNT ];		///< last query that visited each bucket
+	UnsignedInt m_queryStamp;
+	UnsignedInt m_nextOrder;
+	Int m_count;
+	Real m_lowestZ;
+	Real m_highestZ;
+	std::vector<OrderedDrawable> m_queryResult;			///< scratch space reused between queries
+
+};
@@ -55,6 +55,7 @@
 #include "GameClient/DisplayString.h"
 #include "GameClient/WinInstanceData.h"
 #include "GameClient/Color.h"
+#include "GameClient/GameWindowHitGrid.h"
 #include <cstdint>  // TheSuperHackers @build fighter19 11/02/2026 For uintptr_t in WindowMsgData
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -390,6 +391,10 @@ protected:
 
 	void normalizeWindowRegion();  ///< put UL corner in window region.lo
 
+	void childLayoutChanged();  ///< a child was moved, resized, added or removed
+	void parentLayoutChanged() { if( m_parent ) m_parent->childLayoutChanged(); }
+	GameWindowHitGrid::Iterator getChildHitCandidates( Int x, Int y );  ///< children that may hold a point relative to us
+
 	GameWindow *findFirstLeaf();  ///< return first leaf of branch
 	GameWindow *findLastLeaf();  ///< return last leaf of branch
 	GameWindow *findPrevLeaf();  ///< return prev leav in tree
@@ -417,6 +422,7 @@ protected:
 	GameWindow *m_next, *m_prev;	// List of sibling windows
 	GameWindow *m_parent;				// Window which contains this window
 	GameWindow *m_child;			  // List of windows within this window
+	GameWindowHitGrid *m_childHitGrid;  ///< our children sorted by region, made on the first hit test
 
 	//
 	// the following are for "layout screens" and ONLY apply to root/parent
@@ -0,0 +1,96 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: GameWindowHitGrid.h //////////////////////////////////////////////////////////////////////
+// Grid of the child windows of a window, for finding the child under the mouse
+// GeneralsX @performance 18/10/2026 GameWindow::winPointInChild tested every child of every window
+// down the hierarchy on each mouse move. A window now sorts its children into a grid of cells once
+// and only tests the children of the cell under the mouse, until a child is moved, resized, added
+// or removed.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Lib/BaseType.h"
+
+#include <vector>
+
+class GameWindow;
+
+class GameWindowHitGrid
+{
+public:
+
+	// Walks the children that may hold a point, in the order of the child list
+	class Iterator
+	{
+	public:
+
+		// walks all children of the list
+		explicit Iterator(GameWindow *firstChild);
+
+		// walks the given candidates of a grid cell
+		Iterator(GameWindow *const *candidates, Int count);
+
+		GameWindow *get() const { return m_window; }
+		void next();
+
+	private:
+
+		GameWindow *m_window;
+		GameWindow *const *m_candidates;
+		Int m_count;
+		Int m_index;
+	};
+
+	GameWindowHitGrid();
+
+	void invalidate() { m_isValid = FALSE; }
+	Bool isValid() const { return m_isValid; }
+
+	// Sorts the children, starting at firstChild, into the cells their regions cover
+	void build(GameWindow *firstChild);
+
+	// The children whose region may hold the point. x and y are relative to the parent.
+	Iterator getCandidates(Int x, Int y) const;
+
+	// Turns the grids of all windows off, to check the full walk of the children against them
+	static void setEnabled(Bool enabled) { s_isEnabled = enabled; }
+	static Bool isEnabled() { return s_isEnabled; }
+
+private:
+
+	enum
+	{
+		MIN_GRID_CHILDREN = 16,			///< fewer children are all kept in a single cell
+		MAX_CELLS_PER_AXIS = 16
+	};
+
+	Bool m_isValid;
+	Int m_minX;
+	Int m_minY;
+	Int m_maxX;
+	Int m_maxY;
+	Int m_cellShift;							///< the cells are 1 << m_cellShift wide and high
+	Int m_cellsX;
+	Int m_cellsY;
+	std::vector<Int> m_cellStart;							///< first entry of each cell in m_cellChildren, one more at the end
+	std::vector<GameWindow *> m_cellChildren;	///< the children of each cell, in the order of the child list
+
+	static Bool s_isEnabled;
+};
@@ -239,6 +239,8 @@ public:
 	virtual void addWaterVelocity( Real worldX, Real worldY, Real velocity, Real preferredHeight ) = 0;
 	/// get height of water grid at specified position
 	virtual Bool getWaterGridHeight( Real worldX, Real worldY, Real *height) = 0;
+	/// time the water grid motion and check it against the original step, see -benchmarkWaterGrid
+	virtual Bool benchmarkWaterGrid( Int steps );
 
 	/// set detail of terrain tracks.
 	virtual void setTerrainTracksDetail()=0;
@@ -245,6 +245,8 @@ class VideoPlayerInterface : public SubsystemInterface
 		virtual const FieldParse *getFieldParse() const = 0;		///< Return the field parse info
 
 		virtual void notifyVideoPlayerOfNewProvider( Bool nowHasValid ) = 0;		///< Notify the video player that they can now ask for an audio handle, or they need to give theirs up.
+
+		virtual Int benchmarkPlayback( Int frames ) = 0;		///< Play the first frames of each video, report the timings and return the exit code, see -benchmarkVideos
 };
 
 
@@ -294,6 +296,8 @@ class VideoPlayer : public VideoPlayerInterface
 
 		virtual void notifyVideoPlayerOfNewProvider( Bool nowHasValid ) override { }
 
+		virtual Int benchmarkPlayback( Int frames ) override;
+
 		// Implementation specific
 		void remove( VideoStream *stream );										///< remove stream from active list
 
@@ -39,6 +39,7 @@ class Bridge;
 class Object;
 class Weapon;
 class PathfindZoneManager;
+class PathfindZoneWorkers;
 class PathfindCell;
 
 // How close is close enough when moving.
@@ -508,6 +509,10 @@ public:
 	~ZoneBlock();  // not virtual, please don't override without making virtual.  jba.
 
 	void blockCalculateZones(	PathfindCell **map, PathfindLayer layers[], const IRegion2D &bounds);	///< Does zone calculations.
+	void setZoneRange(const ICoord2D &cellOrigin, zoneStorageType firstZone, UnsignedShort numZones); ///< First half of blockCalculateZones, allocates.
+	void calculateEquivalencies(PathfindCell **map, const IRegion2D &bounds); ///< Second half of blockCalculateZones, safe to run on a worker thread.
+	void shiftZones(Int delta);	///< Renumbers the zones when the zones of the blocks before this one changed.
+	void getZoneState(std::vector<Int> &state) const;
 	zoneStorageType getEffectiveZone(LocomotorSurfaceTypeMask acceptableSurfaces, Bool crusher, zoneStorageType zone) const;
 
 	void clearMarkedPassable() {m_markedPassable = false;}
@@ -562,6 +567,11 @@ public:
 	void markZonesDirty() ; ///< Called when the zones need to be recalculated.
 	void updateZonesForModify( PathfindCell **map,  PathfindLayer layers[], const IRegion2D &structureBounds, const IRegion2D &globalBounds ) ; ///< Called to recalculate an area when a structure has been removed.
 	void calculateZones(	PathfindCell **map, PathfindLayer layers[], const IRegion2D &bounds);	///< Does zone calculations.
+	void calculateZonesSerial(	PathfindCell **map, PathfindLayer layers[], const IRegion2D &bounds);	///< The original single threaded zone calculation.
+	void markAllBlocksDirty() { m_blockLabelsValid = false; }	///< Makes the next calculateZones relabel every block.
+	void getZoneState(PathfindCell **map, PathfindLayer layers[], const IRegion2D &bounds, std::vector<Int> &state) const; ///< Everything the zone calculation produces, to compare two calculations.
+	Int getRelabeledBlockCount() const { return m_relabeledBlocks; }	///< Blocks the last calculateZones had to relabel.
+	Int getWorkerThreadCount() const;
 	zoneStorageType getEffectiveZone(LocomotorSurfaceTypeMask acceptableSurfaces, Bool crusher, zoneStorageType zone) const;
 	zoneStorageType getEffectiveTerrainZone(zoneStorageType zone) const;
 
@@ -586,6 +596,24 @@ private:
 	void freeZones();
 	void freeBlocks();
 
+	/// Zone labels of one block, numbered from 1 in the order numberZonesSerial() meets them.
+	struct BlockLabels
+	{
+		IRegion2D bounds;
+		zoneStorageType firstZone;	///< global zone of local zone 1
+		UnsignedByte numZones;
+		UnsignedByte rawZones;			///< zones numberZonesSerial() hands out for this block before merging them
+		Bool connectsToLayer;				///< a cell of the block connects to a bridge layer
+		Bool relabeled;
+	};
+
+	Bool numberZones(PathfindCell **map, PathfindLayer layers[], const IRegion2D &globalBounds);
+	void numberZonesSerial(PathfindCell **map, PathfindLayer layers[], const IRegion2D &globalBounds);
+	void resolveZoneEquivalencies(PathfindCell **map, PathfindLayer layers[], const IRegion2D &globalBounds, Bool serial);
+	void finishZones(PathfindCell **map, const IRegion2D &globalBounds);
+	static void labelBlockJob(void *zoneManager, Int block);
+	static void applyBlockLabelsJob(void *zoneManager, Int block);
+
 private:
 	ZoneBlock			*m_blockOfZoneBlocks;			///< Zone blocks - Info for hierarchical pathfinding at a "blocky" level.
 	ZoneBlock			**m_zoneBlocks;						///< Zone blocks as a matrix - contains matrix indexing into the map.
@@ -600,6 +628,17 @@ private:
 	zoneStorageType *m_terrainZones;
 	zoneStorageType *m_crusherZones;
 	zoneStorageType *m_hierarchicalZones;
+
+	// GeneralsX @performance 18/10/2026 The blocks are labelled on worker threads. The labels and
+	// the cell types they were made from are kept, so a recalculation only relabels changed blocks.
+	PathfindCell	**m_labelMap;							///< map the labels were made for
+	IRegion2D			m_labelBounds;						///< bounds the labels were made for
+	Bool					m_blockLabelsValid;
+	Int						m_relabeledBlocks;				///< blocks relabelled by the last calculateZones
+	std::vector<BlockLabels> m_blockLabels;	///< per block, in the order numberZonesSerial() visits them
+	std::vector<UnsignedShort> m_cellKeys;		///< the cell properties the labels depend on, ZONE_BLOCK_SIZE^2 per block
+	std::vector<UnsignedByte> m_cellLabels;	///< local zone of each cell, ZONE_BLOCK_SIZE^2 per block
+	PathfindZoneWorkers *m_workers;
 };
 
 /**
@@ -680,6 +719,7 @@ public:
 	Bool queueForPath(ObjectID id);	 ///< The object wants to request a pathfind, so put it on the list to process.
 	void processPathfindQueue(); ///< Process some or all of the queued pathfinds.
 	void forceMapRecalculation();	///< Force pathfind map recomputation. If region is given, only that area is recomputed
+	Bool benchmarkZones(Int iterations);	///< Times the zone calculations on the loaded map and checks that they agree, see -benchmarkPathfindZones
 
 	/** Returns an aircraft path to the goal.  */
 	Path *getAircraftPath( const Object *obj, const Coord3D *to);
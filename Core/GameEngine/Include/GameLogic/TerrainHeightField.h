@@ -0,0 +1,106 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: TerrainHeightField.h /////////////////////////////////////////////////////////////////////
+// The height samples of the logical terrain, for the height and normal queries of the game logic
+// GeneralsX @performance 18/10/2026 The game logic asked the terrain render object for every
+// ground height. TerrainLogic now keeps its own copy of the samples and interpolates them the
+// same way BaseHeightMapRenderObjClass::getHeightMapHeight does, to the bit.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+
+class TerrainHeightField
+{
+public:
+
+	TerrainHeightField();
+
+	void clear();
+
+	// Copies the row major samples of a height map, border included
+	void build(const UnsignedByte *data, Int xExtent, Int yExtent, Int borderSize);
+	Bool isBuilt() const { return m_xExtent > 0; }
+
+	Int getXExtent() const { return m_xExtent; }
+	Int getYExtent() const { return m_yExtent; }
+	Int getBorderSize() const { return m_borderSize; }
+
+	// The sample at the given indices, border included. Indices off the map are clamped to its edge.
+	UnsignedByte getClipHeight(Int xIndex, Int yIndex) const;
+
+	// Lowers the sample at the given map grid position to height, never raises it.
+	// Same rule as TerrainVisual::setRawMapHeight, so both copies stay equal.
+	void lowerRawHeight(const ICoord2D *gridPos, Int height);
+
+	// Height and smoothed normal at a world position
+	Real getHeight(Real x, Real y, Coord3D *normal) const;
+
+	// Heights of count positions given as separate x and y arrays. Same results as getHeight.
+	void getHeights(const Real *x, const Real *y, Int count, Real *heights) const;
+	void getHeightsAndNormals(const Real *x, const Real *y, Int count, Real *heights, Coord3D *normals) const;
+
+	// Name of the instruction set getHeights uses
+	static const char *getBatchName();
+
+private:
+
+	// The samples are kept in tiles of 8x8 cells. A tile also holds the samples around its cells the
+	// smoothed normals read, so one query touches a single 128 byte tile instead of four rows.
+	enum
+	{
+		TILE_CELLS_SHIFT = 3,
+		TILE_CELLS = 1 << TILE_CELLS_SHIFT,
+		TILE_APRON_LOW = 1,													///< samples before the first cell of the tile
+		TILE_SAMPLES = TILE_CELLS + 3,							///< samples per tile row
+		TILE_BYTES = 128
+	};
+
+	struct alignas(64) Tile
+	{
+		UnsignedByte samples[TILE_BYTES];
+	};
+
+	Bool isCellInside(Int ix, Int iy) const
+	{
+		return ix >= 1 && iy >= 1 && ix <= m_xExtent - 3 && iy <= m_yExtent - 3;
+	}
+
+	// The sample of the cell corner ix, iy in its tile, the others are at offsets from it
+	const UnsignedByte *getCellCorner(Int ix, Int iy) const
+	{
+		const Tile &tile = m_tiles[(iy >> TILE_CELLS_SHIFT) * m_tilesX + (ix >> TILE_CELLS_SHIFT)];
+		Int localX = (ix & (TILE_CELLS - 1)) + TILE_APRON_LOW;
+		Int localY = (iy & (TILE_CELLS - 1)) + TILE_APRON_LOW;
+		return &tile.samples[localY * TILE_SAMPLES + localX];
+	}
+
+	UnsignedByte getSample(Int xIndex, Int yIndex) const { return *getCellCorner(xIndex, yIndex); }
+	void setSample(Int xIndex, Int yIndex, UnsignedByte height);
+	Real getHeightOffCells(Int ix, Int iy, Coord3D *normal) const;
+	static void getNormal(const UnsignedByte *corner, Real fx, Real fy, Coord3D *normal);
+
+	std::vector<Tile> m_tiles;
+	Int m_xExtent;
+	Int m_yExtent;
+	Int m_borderSize;
+	Int m_tilesX;
+	Int m_tilesY;
+};
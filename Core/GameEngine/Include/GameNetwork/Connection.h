@@ -76,6 +76,8 @@ public:
 	void setQuitting();
 	Bool isQuitting() { return m_isQuitting; }
 
+	UnsignedInt getTotalRetries() const { return m_totalRetries; }	///< Commands sent again because their ACK didn't come in time
+
 #if defined(RTS_DEBUG)
 	void debugPrintCommands();
 #endif
@@ -97,5 +99,6 @@ protected:
 	time_t m_frameGrouping;				///< The minimum time between packet sends.
 	time_t m_lastTimeSent;				///< The time of the last packet send.
 	Int m_numRetries;							///< The number of retries for the last second.
+	UnsignedInt m_totalRetries;		///< The number of retries since the connection was initialized.
 	time_t m_retryMetricsTime;		///< The start time of the current retry metrics thing.
 };
@@ -115,6 +115,10 @@ public:
 
 	UnsignedInt getMinimumCushion();
 
+	// Resend metrics
+	UnsignedInt getCommandRetries();							///< Commands sent again to any connection because their ACK didn't come in time
+	UnsignedInt getFrameResendRequests() const { return m_frameResendRequests; }	///< Frames we asked another player to send again
+
 	void flushConnections();
 
 	void processChat(NetChatCommandMsg *msg); // this actually needs to be public because it is frame-synchronized
@@ -207,6 +211,8 @@ private:
 	Int  m_minFps;
 	UnsignedInt m_smallestPacketArrivalCushion;
 	Bool m_didSelfSlug;
+	time_t m_lastRunAheadMetricsTime;
+	UnsignedInt m_frameResendRequests;
 
 	// -----------------------------------------------------------------------------
 	FileCommandMap s_fileCommandMap;
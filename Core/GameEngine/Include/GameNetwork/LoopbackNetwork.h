@@ -0,0 +1,103 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: LoopbackNetwork.h ////////////////////////////////////////////////////////////////////////
+// An in-memory stand-in for the UDP sockets of several Transports in the same process
+// GeneralsX @feature 18/10/2026 Lets the network code be measured without real machines.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Lib/BaseType.h"
+
+#include <map>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+/** Delivers packets between the Transports attached to it, like a switch between machines.
+	*
+	* Every packet is delayed by the latency plus a random jitter, some are dropped and some are
+	* held back long enough to arrive after the packets sent after them. The random numbers come
+	* from a fixed seed, so a run with the same settings sees the same losses. Delivery times are in
+	* timeGetTime() milliseconds, the clock the network code measures its latencies with. */
+//-------------------------------------------------------------------------------------------------
+class LoopbackNetwork
+{
+
+public:
+
+	struct Settings
+	{
+		Int m_latency;							///< one way delay of every packet, in ms
+		Int m_jitter;								///< up to this many ms are added to the latency of a packet
+		Int m_lossPercent;					///< percent of the packets that are dropped
+		Int m_reorderPercent;				///< percent of the packets that are held back behind later ones
+
+		Settings() : m_latency( 0 ), m_jitter( 0 ), m_lossPercent( 0 ), m_reorderPercent( 0 ) { }
+	};
+
+	/// Traffic of one endpoint, bytes include the transport header like they would on the wire
+	struct Statistics
+	{
+		UnsignedInt m_packetsSent;
+		UnsignedInt m_bytesSent;
+		UnsignedInt m_packetsReceived;
+		UnsignedInt m_bytesReceived;
+		UnsignedInt m_packetsDropped;		///< sent by this endpoint and lost on the way
+
+		Statistics() : m_packetsSent( 0 ), m_bytesSent( 0 ), m_packetsReceived( 0 ), m_bytesReceived( 0 ), m_packetsDropped( 0 ) { }
+	};
+
+	LoopbackNetwork( const Settings &settings );
+
+	/// queue a packet, returns len like a socket write, even if the packet is going to be lost
+	Int write( UnsignedInt fromAddr, UnsignedShort fromPort, const UnsignedByte *buf, Int len, UnsignedInt toAddr, UnsignedShort toPort );
+
+	/// take the next packet that has arrived for the endpoint, returns 0 if there is none yet
+	Int read( UnsignedInt addr, UnsignedShort port, UnsignedByte *buf, Int len, UnsignedInt &fromAddr, UnsignedShort &fromPort );
+
+	const Statistics &getStatistics( UnsignedInt addr, UnsignedShort port ) { return m_endpoints[ makeKey( addr, port ) ].m_statistics; }
+
+private:
+
+	struct Packet
+	{
+		UnsignedInt m_fromAddr;
+		UnsignedShort m_fromPort;
+		std::vector<UnsignedByte> m_data;
+	};
+
+	// in flight packets by delivery time, packets with the same time arrive in the order they were sent
+	typedef std::multimap<UnsignedInt, Packet> PacketQueue;
+
+	struct Endpoint
+	{
+		PacketQueue m_inbox;
+		Statistics m_statistics;
+	};
+
+	typedef std::map<UnsignedInt64, Endpoint> EndpointMap;
+
+	static UnsignedInt64 makeKey( UnsignedInt addr, UnsignedShort port ) { return ( (UnsignedInt64)addr << 16 ) | port; }
+	Int random( Int range );				///< 0 to range-1
+
+	Settings m_settings;
+	UnsignedInt m_seed;
+	EndpointMap m_endpoints;
+
+};
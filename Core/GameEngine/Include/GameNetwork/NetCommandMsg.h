@@ -33,7 +33,7 @@
 #include "GameNetwork/NetPacketStructs.h"
 #include "Common/UnicodeString.h"
 
-class GameMessageArgument;
+struct GameMessageArgument;
 class NetCommandRef;
 
 //-----------------------------------------------------------------------------
@@ -170,7 +170,7 @@ public:
 
 protected:
 	GameMessage::Type m_type;
-	std::vector<GameMessageArgument*> m_argList;
+	std::vector<GameMessageArgument> m_argList;
 };
 
 //-----------------------------------------------------------------------------
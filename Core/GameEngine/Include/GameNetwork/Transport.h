@@ -31,6 +31,8 @@
 #include "GameNetwork/udp.h"
 #include "GameNetwork/NetworkDefs.h"
 
+class LoopbackNetwork;
+
 /**
  * The transport layer handles the UDP socket for the game, and will packetize and
  * de-packetize multiple ACK/CommandPacket/etc packets into larger aggregates.
@@ -47,6 +49,7 @@ public:
 
 	Bool init( AsciiString ip, UnsignedShort port );
 	Bool init( UnsignedInt ip, UnsignedShort port );
+	Bool initLoopback( LoopbackNetwork *network, UnsignedInt ip, UnsignedShort port );	///< Send and receive through an in-memory network instead of a socket
 	void reset();
 	Bool update();									///< Call this once a GameEngine tick, regardless of whether the frame advances.
 
@@ -82,6 +85,10 @@ private:
 	Bool m_winsockInit;
 	UDP *m_udpsock;
 
+	// GeneralsX @feature 18/10/2026 Used instead of m_udpsock by the network benchmark
+	LoopbackNetwork *m_loopback;
+	UnsignedInt m_loopbackAddr;
+
 	// Latency insertion and packet loss
 	Bool m_useLatency;
 	Bool m_usePacketLoss;
@@ -96,5 +103,8 @@ private:
 	Int m_statisticsSlot;
 	UnsignedInt m_lastSecond;
 
+	void clearBuffers();
+	Int writePacket( const UnsignedByte *buf, Int len, UnsignedInt addr, UnsignedShort port );
+	Int readPacket( UnsignedByte *buf, Int len, sockaddr_in *from );
 	Bool isGeneralsPacket( TransportMessage *msg );
 };
@@ -453,6 +453,111 @@ Int parseReplay(char *args[], int num)
 	return 1;
 }
 
+Int parseBenchmarkMapLoad(char *args[], int num)
+{
+	if (num > 1)
+	{
+		AsciiString mapName = args[1];
+		ConvertShortMapPathToLongMapPath(mapName);
+		TheWritableGlobalData->m_benchmarkMapLoads.push_back(mapName);
+
+		TheWritableGlobalData->m_playIntro = FALSE;
+		TheWritableGlobalData->m_playSizzle = FALSE;
+		TheWritableGlobalData->m_shellMapOn = FALSE;
+
+		rts::ClientInstance::setMultiInstance(TRUE);
+		rts::ClientInstance::skipPrimaryInstance();
+
+		return 2;
+	}
+	return 1;
+}
+
+Int parseBenchmarkReport(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkMapLoadReport = args[1];
+		return 2;
+	}
+	return 1;
+}
+
+Int parseBenchmarkPathfindZones(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkPathfindZones = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseBenchmarkWaterLookups(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkWaterLookups = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseBenchmarkLineOfSight(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkLineOfSight = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseBenchmarkHeightQueries(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkHeightQueries = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseBenchmarkBuildPlacement(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkBuildPlacement = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseBenchmarkWaterGrid(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkWaterGrid = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseBenchmarkMessages(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkMessages = atoi(args[1]);
+
+		TheWritableGlobalData->m_playIntro = FALSE;
+		TheWritableGlobalData->m_playSizzle = FALSE;
+		TheWritableGlobalData->m_shellMapOn = FALSE;
+
+		return 2;
+	}
+	return 1;
+}
+
 Int parseJobs(char *args[], int num)
 {
 	if (num > 1)
@@ -1137,6 +1242,206 @@ Int parseClearDebugLevel(char *args[], int num)
 
 // Initial Params are parsed before Windows Creation.
 // Note that except for TheGlobalData, no other global objects exist yet when these are parsed.
+Int parseConvertReplay(char *args[], int num)
+{
+	if (num > 1)
+	{
+		AsciiString filename = args[1];
+		if (!filename.endsWithNoCase(RecorderClass::getReplayExtention()))
+		{
+			printf("Invalid replay name \"%s\"\n", filename.str());
+			exit(1);
+		}
+		TheWritableGlobalData->m_convertReplays.push_back(filename);
+
+		TheWritableGlobalData->m_playIntro = FALSE;
+		TheWritableGlobalData->m_playSizzle = FALSE;
+		TheWritableGlobalData->m_shellMapOn = FALSE;
+
+		rts::ClientInstance::setMultiInstance(TRUE);
+		rts::ClientInstance::skipPrimaryInstance();
+
+		return 2;
+	}
+	return 1;
+}
+
+Int parseCompressReplay(char *args[], int num)
+{
+	TheWritableGlobalData->m_compressConvertedReplays = TRUE;
+	return 1;
+}
+
+Int parseBenchmarkNetwork(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkNetworkPlayers = atoi(args[1]);
+
+		TheWritableGlobalData->m_playIntro = FALSE;
+		TheWritableGlobalData->m_playSizzle = FALSE;
+		TheWritableGlobalData->m_shellMapOn = FALSE;
+
+		return 2;
+	}
+	return 1;
+}
+
+Int parseBenchmarkNetworkFrames(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkNetworkFrames = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseBenchmarkNetworkLatency(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkNetworkLatency = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseBenchmarkNetworkJitter(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkNetworkJitter = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseBenchmarkNetworkLoss(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkNetworkLoss = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseBenchmarkNetworkReorder(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkNetworkReorder = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseArchiveTrace(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_archiveTraceFile = args[1];
+		return 2;
+	}
+	return 1;
+}
+
+Int parseProfileUpdates(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_updateProfileFile = args[1];
+		return 2;
+	}
+	return 1;
+}
+
+Int parseTextureLoaderThreads(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_textureLoaderThreads = atoi(args[1]);
+		return 2;
+	}
+	return 1;
+}
+
+Int parseBenchmarkTextures(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkTextureThreads = atoi(args[1]);
+
+		TheWritableGlobalData->m_playIntro = FALSE;
+		TheWritableGlobalData->m_playSizzle = FALSE;
+		TheWritableGlobalData->m_shellMapOn = FALSE;
+
+		return 2;
+	}
+	return 1;
+}
+
+Int parseBenchmarkWindowLookups(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkWindowLookups = atoi(args[1]);
+
+		TheWritableGlobalData->m_playIntro = FALSE;
+		TheWritableGlobalData->m_playSizzle = FALSE;
+		TheWritableGlobalData->m_shellMapOn = FALSE;
+
+		return 2;
+	}
+	return 1;
+}
+
+Int parseBenchmarkStrings(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkStrings = atoi(args[1]);
+
+		TheWritableGlobalData->m_playIntro = FALSE;
+		TheWritableGlobalData->m_playSizzle = FALSE;
+		TheWritableGlobalData->m_shellMapOn = FALSE;
+
+		return 2;
+	}
+	return 1;
+}
+
+Int parseBenchmarkShadowSilhouettes(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkShadowSilhouettes = atoi(args[1]);
+
+		TheWritableGlobalData->m_playIntro = FALSE;
+		TheWritableGlobalData->m_playSizzle = FALSE;
+		TheWritableGlobalData->m_shellMapOn = FALSE;
+
+		return 2;
+	}
+	return 1;
+}
+
+Int parseBenchmarkVideos(char *args[], int num)
+{
+	if (num > 1)
+	{
+		TheWritableGlobalData->m_benchmarkVideoFrames = atoi(args[1]);
+
+		TheWritableGlobalData->m_playIntro = FALSE;
+		TheWritableGlobalData->m_playSizzle = FALSE;
+		TheWritableGlobalData->m_shellMapOn = FALSE;
+
+		return 2;
+	}
+	return 1;
+}
+
 static CommandLineParam paramsForStartup[] =
 {
 	{ "-win", parseWin },
@@ -1157,6 +1462,118 @@ static CommandLineParam paramsForStartup[] =
 	// (If you have 4 cores, call it with -jobs 4)
 	// If you do not call this, all replays will be simulated in sequence in the same process.
 	{ "-jobs", parseJobs },
+
+	// GeneralsX @feature 18/10/2026
+	// Loads a map, reports how long each stage of the map load took and exits. Combine with -headless.
+	// You can pass this multiple times to load multiple maps in sequence.
+	{ "-benchmarkMapLoad", parseBenchmarkMapLoad },
+
+	// GeneralsX @feature 18/10/2026
+	// Writes the results of -benchmarkMapLoad as CSV to the given file.
+	{ "-benchmarkReport", parseBenchmarkReport },
+
+	// GeneralsX @feature 18/10/2026
+	// With -benchmarkMapLoad, also times the pathfind zone calculations on each map, the given number of
+	// times, and checks that the parallel and incremental calculations give the same zones as the original.
+	{ "-benchmarkPathfindZones", parseBenchmarkPathfindZones },
+
+	// GeneralsX @feature 18/10/2026
+	// With -benchmarkMapLoad, also times the given number of water lookups and trigger area tests spread
+	// over each map, and checks that the bucketed triggers give the same answers as testing all of them.
+	{ "-benchmarkWaterLookups", parseBenchmarkWaterLookups },
+
+	// GeneralsX @feature 18/10/2026
+	// With -benchmarkMapLoad, also times the given number of terrain line of sight checks on each map,
+	// and checks that the cell height pyramid gives the same answers as walking every cell.
+	{ "-benchmarkLineOfSight", parseBenchmarkLineOfSight },
+
+	// GeneralsX @feature 18/10/2026
+	// With -benchmarkMapLoad, also times the given number of ground height queries on each map, and checks
+	// that the logic height field gives the same heights and normals as the terrain render object.
+	{ "-benchmarkHeightQueries", parseBenchmarkHeightQueries },
+
+	// GeneralsX @feature 18/10/2026
+	// With -benchmarkMapLoad, also times the given number of AI structure placement searches spread over
+	// each map, and checks that ruling out spots with the buildability grid places every structure the same.
+	{ "-benchmarkBuildPlacement", parseBenchmarkBuildPlacement },
+
+	// GeneralsX @feature 18/10/2026
+	// With -benchmarkMapLoad, also steps a splashed water grid the given number of times, and checks that
+	// stepping only the points in motion leaves the grid exactly as stepping every point does.
+	{ "-benchmarkWaterGrid", parseBenchmarkWaterGrid },
+
+	// GeneralsX @feature 18/10/2026
+	// Sends the given number of messages through the message stream, reports the throughput and exits.
+	// Combine with -headless.
+	{ "-benchmarkMessages", parseBenchmarkMessages },
+
+	// GeneralsX @feature 18/10/2026
+	// Converts a replay to the compact v2 format, checks that both play back the same and exits.
+	// Combine with -headless. You can pass this multiple times to convert multiple replays.
+	{ "-convertReplay", parseConvertReplay },
+
+	// GeneralsX @feature 18/10/2026
+	// Compresses the body of the replays written by -convertReplay.
+	{ "-compressReplay", parseCompressReplay },
+
+	// GeneralsX @feature 18/10/2026
+	// Plays a game with the given number of network clients in this process, connected through a
+	// simulated network, reports the frame rate, command latency, retransmits and traffic and exits.
+	// Combine with -headless.
+	{ "-benchmarkNetwork", parseBenchmarkNetwork },
+
+	// GeneralsX @feature 18/10/2026
+	// Settings of -benchmarkNetwork: frames to play, one way latency and jitter in ms, and the
+	// percentage of packets that are lost or delivered out of order.
+	{ "-benchmarkNetworkFrames", parseBenchmarkNetworkFrames },
+	{ "-benchmarkNetworkLatency", parseBenchmarkNetworkLatency },
+	{ "-benchmarkNetworkJitter", parseBenchmarkNetworkJitter },
+	{ "-benchmarkNetworkLoss", parseBenchmarkNetworkLoss },
+	{ "-benchmarkNetworkReorder", parseBenchmarkNetworkReorder },
+
+	// GeneralsX @feature 18/10/2026
+	// Writes the archived files to the given file in the order they are first opened. The bigarchive
+	// tool reads it to store the files read at startup and map load next to each other.
+	{ "-archiveTrace", parseArchiveTrace },
+
+	// GeneralsX @feature 18/10/2026
+	// Times every update module, thing template and logic subsystem while simulating replays with
+	// -replay and -headless, and writes the results to the given CSV file, the most expensive first.
+	{ "-profileUpdates", parseProfileUpdates },
+
+	// GeneralsX @feature 18/10/2026
+	// Number of threads that decode the textures loaded in the background. The default is one less
+	// than the number of cores.
+	{ "-textureLoaderThreads", parseTextureLoaderThreads },
+
+	// GeneralsX @feature 18/10/2026
+	// Loads all textures in Art/Textures with 1 up to the given number of loader threads, reports
+	// the textures and texels per second of each and exits. Needs a Direct3D device, so no -headless.
+	{ "-benchmarkTextures", parseBenchmarkTextures },
+
+	// GeneralsX @feature 18/10/2026
+	// Loads the shell and in game layouts, looks their windows up by id and hit tests random points
+	// the given number of rounds with and without the window id registry and the child hit grids,
+	// reports the timings and exits. Do not combine with -headless, it has no real windows.
+	{ "-benchmarkWindowLookups", parseBenchmarkWindowLookups },
+
+	// GeneralsX @feature 18/10/2026
+	// Tokenizes the INI files and formats, copies and compares the template names the given number of
+	// rounds with and without the small string buffers and interning, reports the allocations and
+	// timings and exits. Combine with -headless.
+	{ "-benchmarkStrings", parseBenchmarkStrings },
+
+	// GeneralsX @feature 18/10/2026
+	// Builds the shadow silhouettes of generated meshes from the given number of rounds of lights,
+	// checks them against the original polygon neighbor walk, times a crowd of units with and without
+	// the silhouette cache and exits. Combine with -headless.
+	{ "-benchmarkShadowSilhouettes", parseBenchmarkShadowSilhouettes },
+
+	// GeneralsX @feature 18/10/2026
+	// Plays the given number of frames of each video into a buffer in memory at the frame rate of the
+	// video, once decoding each frame in place and once decoding ahead, checks that the frames match,
+	// reports the frame and decode latencies and exits. Combine with -headless.
+	{ "-benchmarkVideos", parseBenchmarkVideos },
 };
 
 // These Params are parsed during Engine Init before INI data is loaded
@@ -1247,7 +1247,10 @@ void INI::parseAudioEventRTS( INI *ini, void * /*instance*/, void *store, const
 
 	// translate the string into a sound
 	if (stricmp(token, "NoSound") != 0) {
-		theSound->setEventName(AsciiString(token));
+		// GeneralsX @performance 18/10/2026 Intern the name, the same as the audio event infos do
+		AsciiString name(token);
+		name.intern();
+		theSound->setEventName(name);
 	}
 
 	TheAudio->getInfoForAudioEvent(theSound);
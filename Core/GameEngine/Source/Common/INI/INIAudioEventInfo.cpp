@@ -48,6 +48,9 @@ void INI::parseMusicTrackDefinition( INI* ini )
 	// read the name
 	const char* c = ini->getNextToken();
 	name.set( c );
+	// GeneralsX @performance 18/10/2026 The event names are interned, so the AudioEventRTS that
+	// parse them share their buffers and compare against the infos by pointer
+	name.intern();
 
 	track = TheAudio->newAudioEventInfo( name );
 	if (!track) {
@@ -76,6 +79,7 @@ void INI::parseAudioEventDefinition( INI* ini )
 	// read the name
 	const char* c = ini->getNextToken();
 	name.set( c );
+	name.intern();
 
 	track = TheAudio->newAudioEventInfo( name );
 	if (!track) {
@@ -103,6 +107,7 @@ void INI::parseDialogDefinition( INI* ini )
 	// read the name
 	const char* c = ini->getNextToken();
 	name.set( c );
+	name.intern();
 
 	track = TheAudio->newAudioEventInfo( name );
 	if (!track) {
@@ -0,0 +1,248 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: MapLoadBenchmark.cpp /////////////////////////////////////////////////////////////////////
+// Loads a list of maps back to back and reports how long each stage of the load took
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/MapLoadBenchmark.h"
+
+#include "Common/BuildAssistant.h"
+#include "Common/GameEngine.h"
+#include "Common/RandomValue.h"
+#include "GameClient/TerrainVisual.h"
+#include "GameLogic/AI.h"
+#include "GameLogic/AIPathfind.h"
+#include "GameLogic/GameLogic.h"
+#include "GameLogic/TerrainLogic.h"
+
+#include <chrono>
+
+Bool MapLoadBenchmark::s_isRunning = false;
+Bool MapLoadBenchmark::s_mapLoaded = false;
+Int64 MapLoadBenchmark::s_mapLoadStart = 0;
+Int64 MapLoadBenchmark::s_mapLoadTime = 0;
+Int64 MapLoadBenchmark::s_stageStart[STAGE_COUNT];
+Int64 MapLoadBenchmark::s_stageTime[STAGE_COUNT];
+UnsignedInt MapLoadBenchmark::s_allocationsAtStart = 0;
+UnsignedInt MapLoadBenchmark::s_allocations = 0;
+UnsignedInt MapLoadBenchmark::s_terrainTileDecodeTime = 0;
+UnsignedInt MapLoadBenchmark::s_terrainTileSavedTime = 0;
+
+static const char *const TheStageNames[MapLoadBenchmark::STAGE_COUNT] =
+{
+	"terrain_load",
+	"script_engine",
+	"partition_manager",
+	"terrain_new_map",
+	"pathfinder",
+	"map_objects",
+	"preload_assets",
+};
+
+namespace
+{
+UnsignedInt getAllocationCount()
+{
+	return TheMemoryPoolFactory ? TheMemoryPoolFactory->getAllocationCount() : 0;
+}
+} // namespace
+
+Int64 MapLoadBenchmark::getTimeMicroseconds()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void MapLoadBenchmark::beginMapLoad()
+{
+	if (!s_isRunning)
+		return;
+
+	for (Int i = 0; i < STAGE_COUNT; ++i)
+	{
+		s_stageStart[i] = 0;
+		s_stageTime[i] = 0;
+	}
+	s_mapLoaded = false;
+	s_mapLoadTime = 0;
+	s_allocations = 0;
+	s_terrainTileDecodeTime = 0;
+	s_terrainTileSavedTime = 0;
+	s_allocationsAtStart = getAllocationCount();
+	s_mapLoadStart = getTimeMicroseconds();
+}
+
+void MapLoadBenchmark::endMapLoad()
+{
+	if (!s_isRunning)
+		return;
+
+	s_mapLoadTime = getTimeMicroseconds() - s_mapLoadStart;
+	s_allocations = getAllocationCount() - s_allocationsAtStart;
+	s_mapLoaded = true;
+}
+
+void MapLoadBenchmark::beginStage(Stage stage)
+{
+	if (!s_isRunning)
+		return;
+
+	s_stageStart[stage] = getTimeMicroseconds();
+}
+
+void MapLoadBenchmark::endStage(Stage stage)
+{
+	if (!s_isRunning)
+		return;
+
+	// stages may be entered more than once per load, their times add up
+	s_stageTime[stage] += getTimeMicroseconds() - s_stageStart[stage];
+}
+
+void MapLoadBenchmark::addTerrainTileDecode(UnsignedInt decodeTime, UnsignedInt savedTime)
+{
+	if (!s_isRunning)
+		return;
+
+	s_terrainTileDecodeTime += decodeTime;
+	s_terrainTileSavedTime += savedTime;
+}
+
+void MapLoadBenchmark::printResult(FILE *fp, const AsciiString &mapName)
+{
+	// map names never contain quotes, so quoting them is enough to keep commas in them apart
+	fprintf(fp, "\"%s\",%.3f", mapName.str(), s_mapLoadTime / 1000.0);
+	for (Int i = 0; i < STAGE_COUNT; ++i)
+		fprintf(fp, ",%.3f", s_stageTime[i] / 1000.0);
+	fprintf(fp, ",%u,%u,%u\n", s_allocations, s_terrainTileDecodeTime, s_terrainTileSavedTime);
+}
+
+int MapLoadBenchmark::benchmarkMaps(const std::vector<AsciiString> &mapNames, const AsciiString &reportFilename)
+{
+	// Note that we use printf here because this is run from cmd.
+	FILE *report = nullptr;
+	if (!reportFilename.isEmpty())
+	{
+		report = fopen(reportFilename.str(), "w");
+		if (report == nullptr)
+		{
+			printf("Cannot open report file \"%s\"\n", reportFilename.str());
+			return 1;
+		}
+
+		fprintf(report, "map,total_ms");
+		for (Int i = 0; i < STAGE_COUNT; ++i)
+			fprintf(report, ",%s_ms", TheStageNames[i]);
+		fprintf(report, ",allocations,terrain_tile_decode_ms,terrain_tile_saved_ms\n");
+	}
+
+	int numErrors = 0;
+	s_isRunning = true;
+
+	for (size_t i = 0; i < mapNames.size(); ++i)
+	{
+		const AsciiString &mapName = mapNames[i];
+		printf("Loading Map \"%s\"\n", mapName.str());
+		fflush(stdout);
+
+		if (TheGameLogic->isInGame())
+			TheGameLogic->clearGameData();
+
+		s_mapLoaded = false;
+		TheWritableGlobalData->m_pendingFile = mapName;
+		InitRandom(0);
+		TheGameLogic->prepareNewGame(GAME_SINGLE_PLAYER, DIFFICULTY_NORMAL, 0);
+		TheGameLogic->startNewGame(FALSE);
+
+		if (!s_mapLoaded)
+		{
+			printf("Cannot load map\n");
+			fflush(stdout);
+			numErrors++;
+			if (TheGameEngine->getQuitting())
+				break;
+			continue;
+		}
+
+		printf("Total: %.1f ms", s_mapLoadTime / 1000.0);
+		for (Int stage = 0; stage < STAGE_COUNT; ++stage)
+			printf(", %s: %.1f ms", TheStageNames[stage], s_stageTime[stage] / 1000.0);
+		printf(", allocations: %u, terrain tiles: %u ms decoded, %u ms saved\n", s_allocations, s_terrainTileDecodeTime, s_terrainTileSavedTime);
+		fflush(stdout);
+
+		if (TheGlobalData->m_benchmarkPathfindZones > 0)
+		{
+			if (!TheAI->pathfinder()->benchmarkZones(TheGlobalData->m_benchmarkPathfindZones))
+				numErrors++;
+		}
+
+		if (TheGlobalData->m_benchmarkWaterLookups > 0)
+		{
+			if (!TheTerrainLogic->benchmarkWaterLookups(TheGlobalData->m_benchmarkWaterLookups))
+				numErrors++;
+		}
+
+		if (TheGlobalData->m_benchmarkLineOfSight > 0)
+		{
+			if (!TheTerrainLogic->benchmarkLineOfSight(TheGlobalData->m_benchmarkLineOfSight))
+				numErrors++;
+		}
+
+		if (TheGlobalData->m_benchmarkHeightQueries > 0)
+		{
+			if (!TheTerrainLogic->benchmarkHeightQueries(TheGlobalData->m_benchmarkHeightQueries))
+				numErrors++;
+		}
+
+		if (TheGlobalData->m_benchmarkBuildPlacement > 0)
+		{
+			if (!TheBuildAssistant->benchmarkPlacement(TheGlobalData->m_benchmarkBuildPlacement))
+				numErrors++;
+		}
+
+		if (TheGlobalData->m_benchmarkWaterGrid > 0)
+		{
+			if (!TheTerrainVisual->benchmarkWaterGrid(TheGlobalData->m_benchmarkWaterGrid))
+				numErrors++;
+		}
+
+		if (report != nullptr)
+		{
+			printResult(report, mapName);
+			fflush(report);
+		}
+	}
+
+	if (TheGameLogic->isInGame())
+		TheGameLogic->clearGameData();
+
+	s_isRunning = false;
+
+	if (report != nullptr)
+		fclose(report);
+
+	if (mapNames.size() > 1)
+	{
+		printf("Loading of all maps completed. Errors occurred: %d\n", numErrors);
+		fflush(stdout);
+	}
+
+	return numErrors != 0 ? 1 : 0;
+}
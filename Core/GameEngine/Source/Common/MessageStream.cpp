@@ -57,6 +57,10 @@ GameMessage::GameMessage( GameMessage::Type type )
 	m_playerIndex = ThePlayerList->getLocalPlayer()->getPlayerIndex();
 	m_type = type;
 	m_list = nullptr;
+	m_argList = m_inlineArgs;
+	m_argCount = 0;
+	m_argCapacity = INLINE_ARGUMENT_COUNT;
+	m_argArenaIndex = -1;
 }
 
 
@@ -65,10 +69,8 @@ GameMessage::GameMessage( GameMessage::Type type )
  */
 GameMessage::~GameMessage()
 {
-	// free all arguments
-	for( size_t i = 0; i < m_argList.size(); ++i ) {
-		deleteInstance(m_argList[i]);
-	}
+	// hand back the arguments that did not fit in the message
+	freeArgList();
 
 	// detach message from list
 	if (m_list)
@@ -80,8 +82,8 @@ GameMessage::~GameMessage()
  */
 const GameMessageArgumentType *GameMessage::getArgument( Int argIndex ) const
 {
-	if (static_cast<size_t>(argIndex) < m_argList.size())
-		return &m_argList[argIndex]->m_data;
+	if (argIndex >= 0 && argIndex < m_argCount)
+		return &m_argList[argIndex].m_data;
 
 	DEBUG_CRASH(("argument not found"));
 	static const GameMessageArgumentType zero = { 0 };
@@ -93,8 +95,8 @@ const GameMessageArgumentType *GameMessage::getArgument( Int argIndex ) const
  */
 GameMessageArgumentDataType GameMessage::getArgumentDataType( Int argIndex ) const
 {
-	if (static_cast<size_t>(argIndex) < m_argList.size())
-		return m_argList[argIndex]->m_type;
+	if (argIndex >= 0 && argIndex < m_argCount)
+		return m_argList[argIndex].m_type;
 
 	return ARGUMENTDATATYPE_UNKNOWN;
 }
@@ -104,17 +106,62 @@ GameMessageArgumentDataType GameMessage::getArgumentDataType( Int argIndex ) con
  */
 GameMessageArgument *GameMessage::allocArg()
 {
-	// allocate a new argument
-	GameMessageArgument *arg = newInstance(GameMessageArgument);
-	m_argList.push_back(arg);
+	if (m_argCount == m_argCapacity)
+	{
+		// long messages, e.g. selecting a large group, continue in the arena of TheCommandList
+		Int capacity = m_argCapacity * 2;
+		GameMessageArgument *args;
+		if (TheCommandList)
+			args = TheCommandList->getArgumentArena()->allocate(capacity);
+		else
+			args = new GameMessageArgument[capacity];
+		memcpy(args, m_argList, m_argCount * sizeof(GameMessageArgument));
+
+		// the old storage in the arena is given back when the arena is rewound
+		if (m_argArenaIndex < 0)
+			freeArgList();
+
+		m_argList = args;
+		m_argCapacity = capacity;
+		if (TheCommandList && m_argArenaIndex < 0)
+			TheCommandList->getArgumentArena()->addMessage(this);
+	}
+
+	GameMessageArgument *arg = &m_argList[m_argCount++];
 
 	DEBUG_ASSERTCRASH(
-		m_argList.size() <= 255,
+		m_argCount <= 255,
 		("If a GameMessage needs more than 255 arguments, it needs to be split up into multiple GameMessage's.")
 	); 
 	return arg;
 }
 
+/**
+ * Give back argument storage that did not fit in the message
+ */
+void GameMessage::freeArgList()
+{
+	if (m_argList == m_inlineArgs)
+		return;
+
+	if (m_argArenaIndex < 0)
+		delete [] m_argList;
+	else
+		TheCommandList->getArgumentArena()->removeMessage(m_argArenaIndex);	// the storage goes with the next rewind
+}
+
+/**
+ * The arena is about to be rewound while this message still uses it, copy the arguments
+ * into storage of its own
+ */
+void GameMessage::friend_moveArgsOutOfArena()
+{
+	GameMessageArgument *args = new GameMessageArgument[m_argCapacity];
+	memcpy(args, m_argList, m_argCount * sizeof(GameMessageArgument));
+	m_argList = args;
+	m_argArenaIndex = -1;
+}
+
 /**
  * Append an integer argument
  */
@@ -674,6 +721,89 @@ const char *GameMessage::getCommandTypeAsString(GameMessage::Type t)
 }
 
 
+//------------------------------------------------------------------------------------------------
+// GameMessageArgumentArena
+//
+
+/**
+ * Constructor
+ */
+GameMessageArgumentArena::GameMessageArgumentArena()
+{
+	m_currentChunk = 0;
+	m_currentChunkUsed = 0;
+}
+
+/**
+ * Destructor
+ */
+GameMessageArgumentArena::~GameMessageArgumentArena()
+{
+	// messages that are still alive keep their arguments
+	reset();
+
+	for (size_t i = 0; i < m_chunks.size(); ++i)
+		delete [] m_chunks[i].m_args;
+}
+
+/**
+ * Return storage for count arguments. Chunks are kept and reused after the arena is rewound.
+ */
+GameMessageArgument *GameMessageArgumentArena::allocate( Int count )
+{
+	while (m_currentChunk < m_chunks.size() && m_currentChunkUsed + count > m_chunks[m_currentChunk].m_size)
+	{
+		++m_currentChunk;
+		m_currentChunkUsed = 0;
+	}
+
+	if (m_currentChunk == m_chunks.size())
+	{
+		Chunk chunk;
+		chunk.m_size = max(count, (Int)CHUNK_ARGUMENT_COUNT);
+		chunk.m_args = new GameMessageArgument[chunk.m_size];
+		m_chunks.push_back(chunk);
+		m_currentChunkUsed = 0;
+	}
+
+	GameMessageArgument *args = m_chunks[m_currentChunk].m_args + m_currentChunkUsed;
+	m_currentChunkUsed += count;
+	return args;
+}
+
+/**
+ * Track a message that uses storage from the arena
+ */
+void GameMessageArgumentArena::addMessage( GameMessage *msg )
+{
+	msg->friend_setArgArenaIndex((Int)m_messages.size());
+	m_messages.push_back(msg);
+}
+
+/**
+ * Stop tracking a message, the last message takes its place
+ */
+void GameMessageArgumentArena::removeMessage( Int index )
+{
+	GameMessage *last = m_messages.back();
+	m_messages[index] = last;
+	last->friend_setArgArenaIndex(index);
+	m_messages.pop_back();
+}
+
+/**
+ * Rewind the arena. Messages that still use it get storage of their own first.
+ */
+void GameMessageArgumentArena::reset()
+{
+	for (size_t i = 0; i < m_messages.size(); ++i)
+		m_messages[i]->friend_moveArgsOutOfArena();
+	m_messages.clear();
+
+	m_currentChunk = 0;
+	m_currentChunkUsed = 0;
+}
+
 //------------------------------------------------------------------------------------------------
 // GameMessageList
 //
@@ -1235,6 +1365,9 @@ void CommandList::destroyAllMessages()
 	m_firstMessage = nullptr;
 	m_lastMessage = nullptr;
 
+	// the frame has been processed, the argument storage of its messages can be reused
+	m_argumentArena.reset();
+
 }
 
 /**
@@ -0,0 +1,94 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: MessageStreamBenchmark.cpp ///////////////////////////////////////////////////////////////
+// Measures how many messages per second make it through MessageStream::propagateMessages
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/MessageStreamBenchmark.h"
+
+#include "Common/MessageStream.h"
+
+#include <chrono>
+
+namespace
+{
+enum
+{
+	MESSAGES_PER_FRAME = 64,		///< a busy frame with a lot of input and network commands
+	SELECTION_SIZE = 24					///< object ids in a group selection, more than fit in a message inline
+};
+
+UnsignedInt getAllocationCount()
+{
+	return TheMemoryPoolFactory ? TheMemoryPoolFactory->getAllocationCount() : 0;
+}
+
+void appendBenchmarkMessage(Int index)
+{
+	// mostly short commands, with every fourth message a group selection
+	if (index % 4 == 0)
+	{
+		GameMessage *msg = TheMessageStream->appendMessage(GameMessage::MSG_CREATE_SELECTED_GROUP_NO_SOUND);
+		msg->appendBooleanArgument(TRUE);
+		for (Int i = 0; i < SELECTION_SIZE; ++i)
+			msg->appendObjectIDArgument((ObjectID)(index + i + 1));
+	}
+	else
+	{
+		GameMessage *msg = TheMessageStream->appendMessage(GameMessage::MSG_LOGIC_CRC);
+		msg->appendIntegerArgument(index);
+		msg->appendBooleanArgument(FALSE);
+	}
+}
+} // namespace
+
+int MessageStreamBenchmark::benchmarkPropagation(Int messageCount)
+{
+	// Note that we use printf here because this is run from cmd.
+	printf("Propagating %d messages, %d per frame\n", messageCount, (Int)MESSAGES_PER_FRAME);
+	fflush(stdout);
+
+	const UnsignedInt allocationsAtStart = getAllocationCount();
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	Int sent = 0;
+	while (sent < messageCount)
+	{
+		for (Int i = 0; i < MESSAGES_PER_FRAME && sent < messageCount; ++i, ++sent)
+			appendBenchmarkMessage(sent);
+
+		TheMessageStream->propagateMessages();
+
+		// nobody executes the commands, throw them away like GameLogic does once it has
+		TheCommandList->reset();
+	}
+
+	const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	const UnsignedInt allocations = getAllocationCount() - allocationsAtStart;
+
+	const double seconds = std::chrono::duration<double>(end - start).count();
+	const double messagesPerSecond = seconds > 0.0 ? messageCount / seconds : 0.0;
+	printf("Time: %.1f ms, messages per second: %.0f, allocations per message: %.2f\n",
+		seconds * 1000.0, messagesPerSecond, messageCount > 0 ? (double)allocations / messageCount : 0.0);
+	fflush(stdout);
+
+	return 0;
+}
@@ -0,0 +1,394 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: NetworkBenchmark.cpp /////////////////////////////////////////////////////////////////////
+// Runs several lockstep clients in one process over a simulated network and reports how they did
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/NetworkBenchmark.h"
+
+#include "GameClient/DisconnectMenu.h"
+#include "GameLogic/GameLogic.h"
+#include "GameNetwork/ConnectionManager.h"
+#include "GameNetwork/GameInfo.h"
+#include "GameNetwork/NetCommandList.h"
+#include "GameNetwork/NetCommandMsg.h"
+#include "GameNetwork/NetCommandRef.h"
+#include "GameNetwork/Transport.h"
+
+#include <chrono>
+#include <vector>
+
+namespace
+{
+enum
+{
+	BENCHMARK_PORT = 8088,
+	COMMANDS_PER_SECOND = 5,		///< per player, a busy 300 actions per minute
+	SELECTION_SIZE = 24					///< object ids in a group selection, every fourth command is one
+};
+
+//-------------------------------------------------------------------------------------------------
+/** One player. The ConnectionManager is driven the way Network::update drives it, without the
+	* command list, which only exists once per process. */
+//-------------------------------------------------------------------------------------------------
+struct BenchmarkClient
+{
+	ConnectionManager *m_conMgr;
+	DisconnectMenu *m_disconnectMenu;		///< ConnectionManager::init replaces TheDisconnectMenu with its own
+	UnsignedInt m_addr;
+	UnsignedInt m_frame;
+	Int m_runAhead;
+	Int m_frameRate;
+	Int m_lastExecutionFrame;
+	Int m_lastFrameCompleted;
+	Bool m_didSelfSlug;
+	Int64 m_nextFrameTime;							///< microseconds, like everything else in the benchmark
+	Int64 m_nextCommandTime;
+	Int m_commandsSent;
+	Int m_runAheadChanges;
+	Int m_minRunAhead;
+	Int m_maxRunAhead;
+	Int64 m_finishTime;
+};
+
+struct CommandLatency
+{
+	UnsignedInt m_count;
+	double m_total;
+	Int64 m_max;
+
+	CommandLatency() : m_count( 0 ), m_total( 0.0 ), m_max( 0 ) { }
+
+	void add( Int64 latency )
+	{
+		++m_count;
+		m_total += (double)latency;
+		m_max = max( m_max, latency );
+	}
+};
+
+UnsignedInt getBenchmarkAddr(Int player)
+{
+	return 0x7F000001 + player;	// 127.0.0.1 and up
+}
+
+Int64 getMicroseconds(const std::chrono::steady_clock::time_point &start)
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// The network code only looks at the logic frame and the disconnect menu of the client it is working for
+void activateClient(BenchmarkClient &client)
+{
+	TheGameLogic->setFrameForNetworkBenchmark(client.m_frame);
+	TheDisconnectMenu = client.m_disconnectMenu;
+}
+
+// Network::getExecutionFrame
+Int getExecutionFrame(BenchmarkClient &client)
+{
+	const Int logicFrame = client.m_frame + client.m_runAhead;
+	if (logicFrame > client.m_lastExecutionFrame)
+		client.m_lastExecutionFrame = logicFrame;
+	return client.m_lastExecutionFrame;
+}
+
+void sendCommand(BenchmarkClient &client, Int64 now)
+{
+	// mostly short commands, with every fourth command a group selection. The first argument is
+	// the time the command was given, so the clients can tell how long it took to execute it.
+	GameMessage *msg;
+	if (client.m_commandsSent % 4 == 0)
+	{
+		msg = newInstance(GameMessage)(GameMessage::MSG_CREATE_SELECTED_GROUP);
+		msg->appendIntegerArgument((Int)now);
+		msg->appendBooleanArgument(TRUE);
+		for (Int i = 0; i < SELECTION_SIZE; ++i)
+			msg->appendObjectIDArgument((ObjectID)(client.m_commandsSent + i + 1));
+	}
+	else
+	{
+		Coord3D pos;
+		pos.set((Real)(client.m_commandsSent % 1000), (Real)(client.m_frame % 1000), 0.0f);
+		msg = newInstance(GameMessage)(GameMessage::MSG_DO_MOVETO);
+		msg->appendIntegerArgument((Int)now);
+		msg->appendLocationArgument(pos);
+	}
+
+	client.m_conMgr->sendLocalGameMessage(msg, getExecutionFrame(client));
+	deleteInstance(msg);
+	++client.m_commandsSent;
+}
+
+// Network::timeForNewFrame
+Bool timeForNewFrame(BenchmarkClient &client, Int64 now)
+{
+	Int64 frameDelay = 1000000 / client.m_frameRate;
+
+	const Real cushion = client.m_conMgr->getMinimumCushion();
+	const Real runAheadPercentage = client.m_runAhead * (TheGlobalData->m_networkRunAheadSlack / (Real)100.0);
+	if (cushion < runAheadPercentage)
+	{
+		frameDelay += frameDelay / 10;
+		client.m_didSelfSlug = TRUE;
+	}
+
+	if (now < client.m_nextFrameTime)
+		return FALSE;
+
+	if (client.m_nextFrameTime + 2 * frameDelay < now)
+		client.m_nextFrameTime = now;
+	else
+		client.m_nextFrameTime += frameDelay;
+	return TRUE;
+}
+
+// Network::RelayCommandsToCommandList, the game commands are only timed
+void executeFrame(BenchmarkClient &client, Int64 now, CommandLatency &latency)
+{
+	NetCommandList *netcmdlist = client.m_conMgr->getFrameCommandList(client.m_frame);
+	for (NetCommandRef *ref = netcmdlist->getFirstMessage(); ref != nullptr; ref = ref->getNext())
+	{
+		NetCommandMsg *cmdMsg = ref->getCommand();
+		if (cmdMsg->getNetCommandType() == NETCOMMANDTYPE_GAMECOMMAND)
+		{
+			GameMessage *msg = ((NetGameCommandMsg *)cmdMsg)->constructGameMessage();
+			latency.add(now - msg->getArgument(0)->integer);
+			deleteInstance(msg);
+		}
+		else if (cmdMsg->getNetCommandType() == NETCOMMANDTYPE_RUNAHEAD)
+		{
+			// Network::processRunAheadCommand
+			NetRunAheadCommandMsg *runAheadMsg = (NetRunAheadCommandMsg *)cmdMsg;
+			if (runAheadMsg->getRunAhead() != client.m_runAhead)
+				++client.m_runAheadChanges;
+			client.m_runAhead = runAheadMsg->getRunAhead();
+			client.m_frameRate = max<Int>(runAheadMsg->getFrameRate(), 1);
+			client.m_minRunAhead = min(client.m_minRunAhead, client.m_runAhead);
+			client.m_maxRunAhead = max(client.m_maxRunAhead, client.m_runAhead);
+
+			time_t frameGrouping = (1000 * client.m_runAhead) / client.m_frameRate / 2;
+			client.m_conMgr->setFrameGrouping(clamp<time_t>(1, frameGrouping, 500));
+		}
+	}
+	deleteInstance(netcmdlist);
+}
+
+// Network::update, returns TRUE if the client moved on to the next frame
+Bool updateClient(BenchmarkClient &client, Int64 now, Int frames, CommandLatency &latency)
+{
+	const Bool playing = client.m_frame <= (UnsignedInt)frames;
+	while (playing && now >= client.m_nextCommandTime)
+	{
+		sendCommand(client, now);
+		client.m_nextCommandTime += 1000000 / COMMANDS_PER_SECOND;
+	}
+
+	// Network::processCommand, send the command counts of the frames nothing can be added to anymore
+	const Int executionFrame = getExecutionFrame(client);
+	for (Int i = client.m_lastFrameCompleted + 1; i < executionFrame; ++i)
+	{
+		client.m_conMgr->processFrameTick(i);
+		client.m_lastFrameCompleted = i;
+	}
+
+	client.m_conMgr->updateRunAhead(client.m_runAhead, client.m_frameRate, client.m_didSelfSlug, executionFrame);
+	client.m_didSelfSlug = FALSE;
+	client.m_conMgr->update(TRUE);
+
+	if (!playing || !client.m_conMgr->allCommandsReady(client.m_frame))
+		return FALSE;
+
+	client.m_conMgr->handleAllCommandsReady();
+	if (!timeForNewFrame(client, now))
+		return FALSE;
+
+	executeFrame(client, now, latency);
+	++client.m_frame;
+	if (client.m_frame > (UnsignedInt)frames)
+		client.m_finishTime = now;
+	return TRUE;
+}
+} // namespace
+
+int NetworkBenchmark::benchmarkLockstep(Int players, Int frames, const LoopbackNetwork::Settings &link)
+{
+	// Note that we use printf here because this is run from cmd.
+	players = clamp<Int>(2, players, MAX_SLOTS);
+	frames = max(frames, 1);
+	printf("Benchmarking %d players for %d frames, latency %d ms, jitter %d ms, loss %d%%, reorder %d%%\n",
+		players, frames, link.m_latency, link.m_jitter, link.m_lossPercent, link.m_reorderPercent);
+	fflush(stdout);
+
+	LoopbackNetwork network(link);
+
+	SkirmishGameInfo game;
+	game.init();
+	game.setInGame();
+	for (Int i = 0; i < players; ++i)
+	{
+		UnicodeString name;
+		name.format(L"Player%d", i + 1);
+		GameSlot slot;
+		slot.setState(SLOT_PLAYER, name, getBenchmarkAddr(i));
+		slot.setPort(BENCHMARK_PORT);
+		game.setSlot(i, slot);
+	}
+
+	// Network::init and Network::parseUserList for every player
+	const Int startRunAhead = min(max(30, MIN_RUNAHEAD), MAX_FRAMES_AHEAD/2);
+	DisconnectMenu *oldDisconnectMenu = TheDisconnectMenu;
+	std::vector<BenchmarkClient> clients(players);
+	for (Int i = 0; i < players; ++i)
+	{
+		BenchmarkClient &client = clients[i];
+		client.m_addr = getBenchmarkAddr(i);
+		client.m_frame = 1;
+		client.m_runAhead = startRunAhead;
+		client.m_frameRate = 30;
+		client.m_lastExecutionFrame = startRunAhead - 1;
+		client.m_lastFrameCompleted = startRunAhead - 1;
+		client.m_didSelfSlug = FALSE;
+		client.m_nextFrameTime = 0;
+		client.m_nextCommandTime = (Int64)i * 1000000 / (COMMANDS_PER_SECOND * players);
+		client.m_commandsSent = 0;
+		client.m_runAheadChanges = 0;
+		client.m_minRunAhead = startRunAhead;
+		client.m_maxRunAhead = startRunAhead;
+		client.m_finishTime = 0;
+
+		Transport *transport = new Transport;
+		transport->initLoopback(&network, client.m_addr, BENCHMARK_PORT);
+
+		TheGameLogic->setFrameForNetworkBenchmark(0);
+		client.m_conMgr = NEW ConnectionManager;
+		client.m_conMgr->init();
+		client.m_disconnectMenu = TheDisconnectMenu;
+		client.m_conMgr->attachTransport(transport);
+		client.m_conMgr->setLocalAddress(client.m_addr, BENCHMARK_PORT);
+
+		game.setLocalIP(client.m_addr);
+		client.m_conMgr->parseUserList(&game);
+		client.m_conMgr->destroyGameMessages();
+		client.m_conMgr->zeroFrames(1, client.m_runAhead - 1);
+
+		// the game starts on frame 1, see Network::processCommand
+		NetCommandList *netcmdlist = client.m_conMgr->getFrameCommandList(0);
+		deleteInstance(netcmdlist);
+	}
+
+	// stop before the DisconnectManager gives up on a player, it needs the disconnect screen for that
+	const Int64 stallTime = (Int64)TheGlobalData->m_networkDisconnectTime * 1000 * 4 / 5;
+	CommandLatency latency;
+	Int64 networkTime = 0;
+	Bool stalled = FALSE;
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	Int64 lastProgressTime = 0;
+	for (;;)
+	{
+		Bool advanced = FALSE;
+		Bool finished = TRUE;
+		const Int64 now = getMicroseconds(start);
+		for (Int i = 0; i < players; ++i)
+		{
+			activateClient(clients[i]);
+			if (updateClient(clients[i], now, frames, latency))
+				advanced = TRUE;
+			if (clients[i].m_frame <= (UnsignedInt)frames)
+				finished = FALSE;
+		}
+		networkTime += getMicroseconds(start) - now;
+
+		if (finished)
+			break;
+
+		if (advanced)
+		{
+			lastProgressTime = now;
+		}
+		else if (now - lastProgressTime > stallTime)
+		{
+			stalled = TRUE;
+			break;
+		}
+		else
+		{
+			Sleep(1);
+		}
+	}
+	const Int64 elapsed = getMicroseconds(start);
+
+	// Report
+	UnsignedInt slowestFrame = clients[0].m_frame;
+	Int64 finishTime = 0;
+	for (Int i = 0; i < players; ++i)
+	{
+		slowestFrame = min(slowestFrame, clients[i].m_frame);
+		finishTime = max(finishTime, clients[i].m_finishTime);
+	}
+	if (stalled)
+	{
+		printf("Stalled on frame %u, no client got to its next frame for %.1f s\n", slowestFrame, stallTime / 1000000.0);
+		finishTime = elapsed;
+	}
+
+	const Int framesPlayed = (Int)slowestFrame - 1;
+	const double seconds = finishTime / 1000000.0;
+	printf("Frames: %d in %.1f s, %.1f frames per second\n", framesPlayed, seconds, seconds > 0.0 ? framesPlayed / seconds : 0.0);
+	printf("Network time: %.1f ms, %.3f ms per client frame\n", networkTime / 1000.0,
+		framesPlayed > 0 ? networkTime / 1000.0 / ((double)framesPlayed * players) : 0.0);
+	printf("Command latency: %u commands executed, average %.1f ms, max %.1f ms\n", latency.m_count,
+		latency.m_count > 0 ? latency.m_total / latency.m_count / 1000.0 : 0.0, latency.m_max / 1000.0);
+
+	const BenchmarkClient &router = clients[0];
+	printf("Run ahead: started at %d, ended at %d, between %d and %d, %d changes\n",
+		startRunAhead, router.m_runAhead, router.m_minRunAhead, router.m_maxRunAhead, router.m_runAheadChanges);
+
+	UnsignedInt totalRetries = 0;
+	UnsignedInt totalResendRequests = 0;
+	for (Int i = 0; i < players; ++i)
+	{
+		BenchmarkClient &client = clients[i];
+		const LoopbackNetwork::Statistics &stats = network.getStatistics(client.m_addr, BENCHMARK_PORT);
+		const UnsignedInt retries = client.m_conMgr->getCommandRetries();
+		const UnsignedInt resendRequests = client.m_conMgr->getFrameResendRequests();
+		totalRetries += retries;
+		totalResendRequests += resendRequests;
+
+		printf("Player %d: sent %u bytes in %u packets (%.0f bytes per second, %.1f per frame), %u lost, %u retries, %u frame resend requests\n",
+			i + 1, stats.m_bytesSent, stats.m_packetsSent, seconds > 0.0 ? stats.m_bytesSent / seconds : 0.0,
+			framesPlayed > 0 ? (double)stats.m_bytesSent / framesPlayed : 0.0, stats.m_packetsDropped, retries, resendRequests);
+	}
+	printf("Retransmits: %u commands, %u frame resend requests\n", totalRetries, totalResendRequests);
+	fflush(stdout);
+
+	for (Int i = 0; i < players; ++i)
+	{
+		activateClient(clients[i]);
+		clients[i].m_conMgr->destroyGameMessages();
+		delete clients[i].m_conMgr;	// deletes the disconnect menu and the transport too
+	}
+	TheDisconnectMenu = oldDisconnectMenu;
+	TheGameLogic->setFrameForNetworkBenchmark(0);
+
+	return stalled ? 1 : 0;
+}
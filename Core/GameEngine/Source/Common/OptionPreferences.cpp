@@ -192,6 +192,20 @@ Bool OptionPreferences::getArchiveReplaysEnabled() const
 	return FALSE;
 }
 
+// GeneralsX @feature 18/10/2026 Compact replays can only be played back by builds that know the v2 format,
+// so they stay off unless asked for.
+Bool OptionPreferences::getCompactReplaysEnabled() const
+{
+	OptionPreferences::const_iterator it = find("CompactReplays");
+	if (it == end())
+		return FALSE;
+
+	if (stricmp(it->second.str(), "yes") == 0) {
+		return TRUE;
+	}
+	return FALSE;
+}
+
 Bool OptionPreferences::getAlternateMouseModeEnabled()
 {
 	OptionPreferences::const_iterator it = find("UseAlternateMouse");
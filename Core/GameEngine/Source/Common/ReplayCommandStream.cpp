@@ -0,0 +1,795 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: ReplayCommandStream.cpp //////////////////////////////////////////////////////////////////
+// Encoding and decoding of the commands in the body of a replay file
+//
+// v1 command, the retail layout:
+//   UnsignedInt frame, Int type, Int player index,
+//   UnsignedByte number of runs, per run UnsignedByte argument type and UnsignedByte count,
+//   the arguments at full width.
+//
+// v2 body:
+//   UnsignedByte body flags, followed by the commands. If REPLAY_BODY_COMPRESSED is set, the
+//   commands are stored in blocks of UnsignedInt size, UnsignedInt packed size and the packed
+//   data. A packed size of 0 means the block is stored as is.
+//
+// v2 command:
+//   varint frame delta, varint type, varint player index,
+//   varint signature, 0 for a new signature followed by varint number of runs and per run
+//   UnsignedByte argument type and varint count, otherwise the index + 1 of an earlier signature,
+//   the arguments, integers and ids as varints, reals and locations at full width.
+//
+// Signed varints are zig zag encoded.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/ReplayCommandStream.h"
+
+#include "Common/file.h"
+#include "Compression.h"
+
+// Replay wide characters keep the retail UTF-16 layout on every platform.
+typedef uint16_t replay_wide_char_t;
+
+static const size_t READ_CHUNK_BYTES = 8192;
+static const size_t BLOCK_BYTES = 64 * 1024;
+static const UnsignedInt MAX_BLOCK_BYTES = 16 * 1024 * 1024;
+static const size_t MAX_SIGNATURES = 4096;
+static const UnsignedInt MAX_ARGUMENTS = 255;
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void ReplayCommand::set( UnsignedInt frame, const GameMessage *msg )
+{
+	m_frame = frame;
+	m_type = msg->getType();
+	m_playerIndex = msg->getPlayerIndex();
+
+	const Int argCount = msg->getArgumentCount();
+	m_args.resize( argCount );
+	for( Int i = 0; i < argCount; ++i )
+	{
+		m_args[ i ].m_type = msg->getArgumentDataType( i );
+		m_args[ i ].m_data = *msg->getArgument( i );
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void ReplayCommand::appendArgumentsTo( GameMessage *msg ) const
+{
+	for( size_t i = 0; i < m_args.size(); ++i )
+	{
+		const GameMessageArgumentType &data = m_args[ i ].m_data;
+		switch( m_args[ i ].m_type )
+		{
+			case ARGUMENTDATATYPE_INTEGER:			msg->appendIntegerArgument( data.integer ); break;
+			case ARGUMENTDATATYPE_REAL:					msg->appendRealArgument( data.real ); break;
+			case ARGUMENTDATATYPE_BOOLEAN:			msg->appendBooleanArgument( data.boolean ); break;
+			case ARGUMENTDATATYPE_OBJECTID:			msg->appendObjectIDArgument( data.objectID ); break;
+			case ARGUMENTDATATYPE_DRAWABLEID:		msg->appendDrawableIDArgument( data.drawableID ); break;
+			case ARGUMENTDATATYPE_TEAMID:				msg->appendTeamIDArgument( data.teamID ); break;
+			case ARGUMENTDATATYPE_LOCATION:			msg->appendLocationArgument( data.location ); break;
+			case ARGUMENTDATATYPE_PIXEL:				msg->appendPixelArgument( data.pixel ); break;
+			case ARGUMENTDATATYPE_PIXELREGION:	msg->appendPixelRegionArgument( data.pixelRegion ); break;
+			case ARGUMENTDATATYPE_TIMESTAMP:		msg->appendTimestampArgument( data.timestamp ); break;
+			case ARGUMENTDATATYPE_WIDECHAR:			msg->appendWideCharArgument( data.wChar ); break;
+			default: break;
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+static Bool isSameArgument( const GameMessageArgument &a, const GameMessageArgument &b )
+{
+	if( a.m_type != b.m_type )
+		return FALSE;
+
+	const GameMessageArgumentType &x = a.m_data;
+	const GameMessageArgumentType &y = b.m_data;
+	switch( a.m_type )
+	{
+		case ARGUMENTDATATYPE_INTEGER:			return x.integer == y.integer;
+		case ARGUMENTDATATYPE_REAL:					return memcmp( &x.real, &y.real, sizeof( x.real ) ) == 0;
+		case ARGUMENTDATATYPE_BOOLEAN:			return x.boolean == y.boolean;
+		case ARGUMENTDATATYPE_OBJECTID:			return x.objectID == y.objectID;
+		case ARGUMENTDATATYPE_DRAWABLEID:		return x.drawableID == y.drawableID;
+		case ARGUMENTDATATYPE_TEAMID:				return x.teamID == y.teamID;
+		case ARGUMENTDATATYPE_LOCATION:			return memcmp( &x.location, &y.location, sizeof( x.location ) ) == 0;
+		case ARGUMENTDATATYPE_PIXEL:				return x.pixel.x == y.pixel.x && x.pixel.y == y.pixel.y;
+		case ARGUMENTDATATYPE_PIXELREGION:	return memcmp( &x.pixelRegion, &y.pixelRegion, sizeof( x.pixelRegion ) ) == 0;
+		case ARGUMENTDATATYPE_TIMESTAMP:		return x.timestamp == y.timestamp;
+		case ARGUMENTDATATYPE_WIDECHAR:			return x.wChar == y.wChar;
+		default:														return TRUE;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+Bool ReplayCommand::isSameCommand( const ReplayCommand &other ) const
+{
+	if( m_frame != other.m_frame || m_type != other.m_type || m_playerIndex != other.m_playerIndex )
+		return FALSE;
+
+	if( m_args.size() != other.m_args.size() )
+		return FALSE;
+
+	for( size_t i = 0; i < m_args.size(); ++i )
+	{
+		if( !isSameArgument( m_args[ i ], other.m_args[ i ] ) )
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// ReplayCommandWriter
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+ReplayCommandWriter::ReplayCommandWriter()
+{
+	m_format = REPLAY_FORMAT_V1;
+	m_bodyFlags = 0;
+	m_lastFrame = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Start a new body. The v2 body flags are written to the file right away, they are never
+	* part of a compressed block */
+// ------------------------------------------------------------------------------------------------
+Bool ReplayCommandWriter::begin( File *file, ReplayFormat format, UnsignedInt bodyFlags )
+{
+	m_format = format;
+	m_bodyFlags = format == REPLAY_FORMAT_V2 ? bodyFlags : 0;
+	m_lastFrame = 0;
+	m_buffer.clear();
+	m_signatures.clear();
+
+	if( format != REPLAY_FORMAT_V2 )
+		return TRUE;
+
+	UnsignedByte flags = (UnsignedByte)m_bodyFlags;
+	return file->write( &flags, sizeof( flags ) ) == sizeof( flags );
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void ReplayCommandWriter::writeBytes( const void *data, Int size )
+{
+	const UnsignedByte *bytes = static_cast<const UnsignedByte *>( data );
+	m_buffer.insert( m_buffer.end(), bytes, bytes + size );
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void ReplayCommandWriter::writeVarint( UnsignedInt value )
+{
+	while( value >= 0x80 )
+	{
+		writeByte( (UnsignedByte)(value | 0x80) );
+		value >>= 7;
+	}
+	writeByte( (UnsignedByte)value );
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void ReplayCommandWriter::writeSignedVarint( Int value )
+{
+	writeVarint( ((UnsignedInt)value << 1) ^ (UnsignedInt)(value >> 31) );
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void ReplayCommandWriter::writeArgument( const GameMessageArgument &arg )
+{
+	const GameMessageArgumentType &data = arg.m_data;
+
+	if( m_format == REPLAY_FORMAT_V1 )
+	{
+		switch( arg.m_type )
+		{
+			case ARGUMENTDATATYPE_INTEGER:			writeBytes( &data.integer, sizeof( data.integer ) ); break;
+			case ARGUMENTDATATYPE_REAL:					writeBytes( &data.real, sizeof( data.real ) ); break;
+			case ARGUMENTDATATYPE_BOOLEAN:			writeBytes( &data.boolean, sizeof( data.boolean ) ); break;
+			case ARGUMENTDATATYPE_OBJECTID:			writeBytes( &data.objectID, sizeof( data.objectID ) ); break;
+			case ARGUMENTDATATYPE_DRAWABLEID:		writeBytes( &data.drawableID, sizeof( data.drawableID ) ); break;
+			case ARGUMENTDATATYPE_TEAMID:				writeBytes( &data.teamID, sizeof( data.teamID ) ); break;
+			case ARGUMENTDATATYPE_LOCATION:			writeBytes( &data.location, sizeof( data.location ) ); break;
+			case ARGUMENTDATATYPE_PIXEL:				writeBytes( &data.pixel, sizeof( data.pixel ) ); break;
+			case ARGUMENTDATATYPE_PIXELREGION:	writeBytes( &data.pixelRegion, sizeof( data.pixelRegion ) ); break;
+			case ARGUMENTDATATYPE_TIMESTAMP:		writeBytes( &data.timestamp, sizeof( data.timestamp ) ); break;
+			case ARGUMENTDATATYPE_WIDECHAR:
+			{
+				const replay_wide_char_t character = static_cast<replay_wide_char_t>( data.wChar );
+				writeBytes( &character, sizeof( character ) );
+				break;
+			}
+			default:
+				DEBUG_LOG(( "Unknown GameMessageArgumentDataType in ReplayCommandWriter::writeArgument" ));
+				break;
+		}
+		return;
+	}
+
+	switch( arg.m_type )
+	{
+		case ARGUMENTDATATYPE_INTEGER:			writeSignedVarint( data.integer ); break;
+		case ARGUMENTDATATYPE_REAL:					writeBytes( &data.real, sizeof( data.real ) ); break;
+		case ARGUMENTDATATYPE_BOOLEAN:			writeByte( data.boolean ? 1 : 0 ); break;
+		case ARGUMENTDATATYPE_OBJECTID:			writeVarint( (UnsignedInt)data.objectID ); break;
+		case ARGUMENTDATATYPE_DRAWABLEID:		writeVarint( (UnsignedInt)data.drawableID ); break;
+		case ARGUMENTDATATYPE_TEAMID:				writeVarint( data.teamID ); break;
+		case ARGUMENTDATATYPE_LOCATION:			writeBytes( &data.location, sizeof( data.location ) ); break;
+		case ARGUMENTDATATYPE_PIXEL:
+			writeSignedVarint( data.pixel.x );
+			writeSignedVarint( data.pixel.y );
+			break;
+		case ARGUMENTDATATYPE_PIXELREGION:
+			writeSignedVarint( data.pixelRegion.lo.x );
+			writeSignedVarint( data.pixelRegion.lo.y );
+			writeSignedVarint( data.pixelRegion.hi.x );
+			writeSignedVarint( data.pixelRegion.hi.y );
+			break;
+		case ARGUMENTDATATYPE_TIMESTAMP:		writeVarint( data.timestamp ); break;
+		case ARGUMENTDATATYPE_WIDECHAR:			writeVarint( (UnsignedInt)data.wChar ); break;
+		default:
+			DEBUG_LOG(( "Unknown GameMessageArgumentDataType in ReplayCommandWriter::writeArgument" ));
+			break;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void ReplayCommandWriter::writeCommandV1( const ReplayCommand &command )
+{
+	Int type = command.m_type;
+	writeBytes( &command.m_frame, sizeof( command.m_frame ) );
+	writeBytes( &type, sizeof( type ) );
+	writeBytes( &command.m_playerIndex, sizeof( command.m_playerIndex ) );
+
+	// one run for each group of consecutive arguments of the same type, the count is patched in
+	const size_t numTypesPos = m_buffer.size();
+	writeByte( 0 );
+
+	UnsignedByte numTypes = 0;
+	size_t i = 0;
+	while( i < command.m_args.size() )
+	{
+		const GameMessageArgumentDataType runType = command.m_args[ i ].m_type;
+		size_t runEnd = i + 1;
+		while( runEnd < command.m_args.size() && command.m_args[ runEnd ].m_type == runType )
+			++runEnd;
+
+		writeByte( (UnsignedByte)runType );
+		writeByte( (UnsignedByte)(runEnd - i) );
+		++numTypes;
+		i = runEnd;
+	}
+	m_buffer[ numTypesPos ] = numTypes;
+
+	for( i = 0; i < command.m_args.size(); ++i )
+		writeArgument( command.m_args[ i ] );
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void ReplayCommandWriter::writeCommandV2( const ReplayCommand &command )
+{
+	writeSignedVarint( (Int)(command.m_frame - m_lastFrame) );
+	m_lastFrame = command.m_frame;
+	writeVarint( (UnsignedInt)command.m_type );
+	writeSignedVarint( command.m_playerIndex );
+
+	// the signature key is the type and the 16 bit count of each run
+	m_signature.clear();
+	size_t i = 0;
+	while( i < command.m_args.size() )
+	{
+		const GameMessageArgumentDataType runType = command.m_args[ i ].m_type;
+		size_t runEnd = i + 1;
+		while( runEnd < command.m_args.size() && command.m_args[ runEnd ].m_type == runType )
+			++runEnd;
+
+		const size_t count = runEnd - i;
+		m_signature.push_back( (char)runType );
+		m_signature.push_back( (char)(count & 0xFF) );
+		m_signature.push_back( (char)((count >> 8) & 0xFF) );
+		i = runEnd;
+	}
+
+	// most commands of a game share a handful of signatures, refer back to them by index
+	SignatureMap::const_iterator it = m_signatures.find( m_signature );
+	if( it != m_signatures.end() )
+	{
+		writeVarint( it->second + 1 );
+	}
+	else
+	{
+		writeVarint( 0 );
+		writeVarint( (UnsignedInt)(m_signature.size() / 3) );
+		for( size_t run = 0; run < m_signature.size(); run += 3 )
+		{
+			writeByte( (UnsignedByte)m_signature[ run ] );
+			writeVarint( (UnsignedByte)m_signature[ run + 1 ] | ((UnsignedInt)(UnsignedByte)m_signature[ run + 2 ] << 8) );
+		}
+
+		if( m_signatures.size() < MAX_SIGNATURES )
+		{
+			const UnsignedInt index = (UnsignedInt)m_signatures.size();
+			m_signatures[ m_signature ] = index;
+		}
+	}
+
+	for( i = 0; i < command.m_args.size(); ++i )
+		writeArgument( command.m_args[ i ] );
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void ReplayCommandWriter::writeCommand( const ReplayCommand &command )
+{
+	DEBUG_ASSERTCRASH( command.m_args.size() <= MAX_ARGUMENTS, ( "Replay command has too many arguments" ) );
+
+	if( m_format == REPLAY_FORMAT_V2 )
+		writeCommandV2( command );
+	else
+		writeCommandV1( command );
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+Bool ReplayCommandWriter::writeBlock( File *file, const UnsignedByte *data, size_t size )
+{
+	const CompressionType compression = CompressionManager::getPreferredCompression();
+	const Int maxPackedSize = CompressionManager::getMaxCompressedSize( (Int)size, compression );
+	m_packed.resize( maxPackedSize );
+	Int packedSize = CompressionManager::compressData( compression, const_cast<UnsignedByte *>( data ), (Int)size, &m_packed[ 0 ], maxPackedSize );
+
+	// store the block as is if it does not get any smaller
+	if( packedSize <= 0 || packedSize >= (Int)size )
+		packedSize = 0;
+
+	UnsignedInt blockHeader[ 2 ] = { (UnsignedInt)size, (UnsignedInt)packedSize };
+	if( file->write( blockHeader, sizeof( blockHeader ) ) != sizeof( blockHeader ) )
+		return FALSE;
+
+	if( packedSize == 0 )
+		return file->write( data, (Int)size ) == (Int)size;
+
+	return file->write( &m_packed[ 0 ], packedSize ) == packedSize;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+Bool ReplayCommandWriter::flush( File *file )
+{
+	if( m_buffer.empty() )
+		return TRUE;
+
+	if( (m_bodyFlags & REPLAY_BODY_COMPRESSED) == 0 )
+	{
+		const Int size = (Int)m_buffer.size();
+		const Bool success = file->write( &m_buffer[ 0 ], size ) == size;
+		m_buffer.clear();
+		return success;
+	}
+
+	// only full blocks, the rest waits for more commands or for finish()
+	Bool success = TRUE;
+	size_t written = 0;
+	while( success && m_buffer.size() - written >= BLOCK_BYTES )
+	{
+		success = writeBlock( file, &m_buffer[ written ], BLOCK_BYTES );
+		written += BLOCK_BYTES;
+	}
+	m_buffer.erase( m_buffer.begin(), m_buffer.begin() + written );
+	return success;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+Bool ReplayCommandWriter::finish( File *file )
+{
+	Bool success = flush( file );
+
+	if( success && !m_buffer.empty() )
+		success = writeBlock( file, &m_buffer[ 0 ], m_buffer.size() );
+
+	m_buffer.clear();
+	return success;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// ReplayCommandReader
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+ReplayCommandReader::ReplayCommandReader()
+{
+	m_file = nullptr;
+	m_format = REPLAY_FORMAT_V1;
+	m_bodyFlags = 0;
+	m_wideCharBytes = sizeof( replay_wide_char_t );
+	m_lastFrame = 0;
+	m_pos = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+Bool ReplayCommandReader::begin( File *file, ReplayFormat format, UnsignedInt wideCharBytes )
+{
+	end();
+
+	m_file = file;
+	m_format = format;
+	m_wideCharBytes = wideCharBytes;
+
+	if( format != REPLAY_FORMAT_V2 )
+		return TRUE;
+
+	UnsignedByte flags = 0;
+	if( file->read( &flags, sizeof( flags ) ) != sizeof( flags ) )
+		return FALSE;
+
+	if( (flags & ~REPLAY_BODY_COMPRESSED) != 0 )
+	{
+		DEBUG_LOG(( "ReplayCommandReader::begin - unknown replay body flags %X", flags ));
+		return FALSE;
+	}
+
+	m_bodyFlags = flags;
+	return TRUE;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Forget the file, it is owned and closed by the caller */
+// ------------------------------------------------------------------------------------------------
+void ReplayCommandReader::end()
+{
+	m_file = nullptr;
+	m_bodyFlags = 0;
+	m_lastFrame = 0;
+	m_data.clear();
+	m_pos = 0;
+	m_signatures.clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+Bool ReplayCommandReader::readBlock()
+{
+	UnsignedInt blockHeader[ 2 ];
+	if( m_file->read( blockHeader, sizeof( blockHeader ) ) != sizeof( blockHeader ) )
+		return FALSE;
+
+	const UnsignedInt size = blockHeader[ 0 ];
+	const UnsignedInt packedSize = blockHeader[ 1 ];
+	if( size == 0 || size > MAX_BLOCK_BYTES || packedSize > MAX_BLOCK_BYTES )
+	{
+		DEBUG_LOG(( "ReplayCommandReader::readBlock - bad block of %u bytes, %u packed", size, packedSize ));
+		return FALSE;
+	}
+
+	const size_t offset = m_data.size();
+	m_data.resize( offset + size );
+
+	if( packedSize == 0 )
+		return m_file->read( &m_data[ offset ], (Int)size ) == (Int)size;
+
+	m_packed.resize( packedSize );
+	if( m_file->read( &m_packed[ 0 ], (Int)packedSize ) != (Int)packedSize )
+		return FALSE;
+
+	return CompressionManager::decompressData( &m_packed[ 0 ], (Int)packedSize, &m_data[ offset ], (Int)size ) == (Int)size;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Make sure the given number of bytes are decoded into memory */
+// ------------------------------------------------------------------------------------------------
+Bool ReplayCommandReader::fill( size_t bytes )
+{
+	while( m_data.size() - m_pos < bytes )
+	{
+		if( m_file == nullptr )
+			return FALSE;
+
+		if( m_pos > 0 )
+		{
+			m_data.erase( m_data.begin(), m_data.begin() + m_pos );
+			m_pos = 0;
+		}
+
+		if( m_bodyFlags & REPLAY_BODY_COMPRESSED )
+		{
+			if( !readBlock() )
+				return FALSE;
+		}
+		else
+		{
+			const size_t offset = m_data.size();
+			m_data.resize( offset + READ_CHUNK_BYTES );
+			const Int bytesRead = m_file->read( &m_data[ offset ], (Int)READ_CHUNK_BYTES );
+			m_data.resize( offset + (bytesRead > 0 ? bytesRead : 0) );
+			if( bytesRead <= 0 )
+				return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+Bool ReplayCommandReader::readBytes( void *data, Int size )
+{
+	if( !fill( size ) )
+		return FALSE;
+
+	memcpy( data, &m_data[ m_pos ], size );
+	m_pos += size;
+	return TRUE;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+Bool ReplayCommandReader::readByte( UnsignedByte &value )
+{
+	if( m_pos >= m_data.size() && !fill( 1 ) )
+		return FALSE;
+
+	value = m_data[ m_pos++ ];
+	return TRUE;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+Bool ReplayCommandReader::readVarint( UnsignedInt &value )
+{
+	value = 0;
+	for( Int shift = 0; shift < 35; shift += 7 )
+	{
+		UnsignedByte byte;
+		if( !readByte( byte ) )
+			return FALSE;
+
+		value |= (UnsignedInt)(byte & 0x7F) << shift;
+		if( (byte & 0x80) == 0 )
+			return TRUE;
+	}
+
+	DEBUG_LOG(( "ReplayCommandReader::readVarint - varint is too long" ));
+	return FALSE;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+Bool ReplayCommandReader::readSignedVarint( Int &value )
+{
+	UnsignedInt encoded;
+	if( !readVarint( encoded ) )
+		return FALSE;
+
+	value = (Int)(encoded >> 1) ^ -(Int)(encoded & 1);
+	return TRUE;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+Bool ReplayCommandReader::readArgument( GameMessageArgument &arg )
+{
+	GameMessageArgumentType &data = arg.m_data;
+	memset( &data, 0, sizeof( data ) );
+
+	if( m_format == REPLAY_FORMAT_V1 )
+	{
+		switch( arg.m_type )
+		{
+			case ARGUMENTDATATYPE_INTEGER:			return readBytes( &data.integer, sizeof( data.integer ) );
+			case ARGUMENTDATATYPE_REAL:					return readBytes( &data.real, sizeof( data.real ) );
+			case ARGUMENTDATATYPE_BOOLEAN:			return readBytes( &data.boolean, sizeof( data.boolean ) );
+			case ARGUMENTDATATYPE_OBJECTID:			return readBytes( &data.objectID, sizeof( data.objectID ) );
+			case ARGUMENTDATATYPE_DRAWABLEID:		return readBytes( &data.drawableID, sizeof( data.drawableID ) );
+			case ARGUMENTDATATYPE_TEAMID:				return readBytes( &data.teamID, sizeof( data.teamID ) );
+			case ARGUMENTDATATYPE_LOCATION:			return readBytes( &data.location, sizeof( data.location ) );
+			case ARGUMENTDATATYPE_PIXEL:				return readBytes( &data.pixel, sizeof( data.pixel ) );
+			case ARGUMENTDATATYPE_PIXELREGION:	return readBytes( &data.pixelRegion, sizeof( data.pixelRegion ) );
+			case ARGUMENTDATATYPE_TIMESTAMP:		return readBytes( &data.timestamp, sizeof( data.timestamp ) );
+			case ARGUMENTDATATYPE_WIDECHAR:
+			{
+				// legacy Unix replays stored 4 byte wide characters
+				uint32_t character = 0;
+				if( !readBytes( &character, m_wideCharBytes ) )
+					return FALSE;
+				data.wChar = static_cast<WideChar>( character );
+				return TRUE;
+			}
+			default:
+				return TRUE;
+		}
+	}
+
+	UnsignedInt value = 0;
+	switch( arg.m_type )
+	{
+		case ARGUMENTDATATYPE_INTEGER:			return readSignedVarint( data.integer );
+		case ARGUMENTDATATYPE_REAL:					return readBytes( &data.real, sizeof( data.real ) );
+		case ARGUMENTDATATYPE_BOOLEAN:
+		{
+			UnsignedByte flag;
+			if( !readByte( flag ) )
+				return FALSE;
+			data.boolean = flag != 0;
+			return TRUE;
+		}
+		case ARGUMENTDATATYPE_OBJECTID:
+			if( !readVarint( value ) )
+				return FALSE;
+			data.objectID = (ObjectID)value;
+			return TRUE;
+		case ARGUMENTDATATYPE_DRAWABLEID:
+			if( !readVarint( value ) )
+				return FALSE;
+			data.drawableID = (DrawableID)value;
+			return TRUE;
+		case ARGUMENTDATATYPE_TEAMID:				return readVarint( data.teamID );
+		case ARGUMENTDATATYPE_LOCATION:			return readBytes( &data.location, sizeof( data.location ) );
+		case ARGUMENTDATATYPE_PIXEL:
+			return readSignedVarint( data.pixel.x ) && readSignedVarint( data.pixel.y );
+		case ARGUMENTDATATYPE_PIXELREGION:
+			return readSignedVarint( data.pixelRegion.lo.x ) && readSignedVarint( data.pixelRegion.lo.y )
+				&& readSignedVarint( data.pixelRegion.hi.x ) && readSignedVarint( data.pixelRegion.hi.y );
+		case ARGUMENTDATATYPE_TIMESTAMP:		return readVarint( data.timestamp );
+		case ARGUMENTDATATYPE_WIDECHAR:
+			if( !readVarint( value ) )
+				return FALSE;
+			data.wChar = static_cast<WideChar>( value );
+			return TRUE;
+		default:
+			return TRUE;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Read the v2 signature of the next command into m_signature */
+// ------------------------------------------------------------------------------------------------
+Bool ReplayCommandReader::readSignature()
+{
+	UnsignedInt reference;
+	if( !readVarint( reference ) )
+		return FALSE;
+
+	if( reference != 0 )
+	{
+		if( reference > m_signatures.size() )
+		{
+			DEBUG_LOG(( "ReplayCommandReader::readSignature - unknown signature %u", reference ));
+			return FALSE;
+		}
+		m_signature = m_signatures[ reference - 1 ];
+		return TRUE;
+	}
+
+	UnsignedInt numRuns;
+	if( !readVarint( numRuns ) || numRuns > MAX_ARGUMENTS )
+		return FALSE;
+
+	m_signature.resize( numRuns );
+	for( UnsignedInt i = 0; i < numRuns; ++i )
+	{
+		if( !readByte( m_signature[ i ].m_type ) || !readVarint( m_signature[ i ].m_count ) )
+			return FALSE;
+	}
+
+	if( m_signatures.size() < MAX_SIGNATURES )
+		m_signatures.push_back( m_signature );
+
+	return TRUE;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+Bool ReplayCommandReader::readCommandV1( ReplayCommand &command )
+{
+	if( !readBytes( &command.m_frame, sizeof( command.m_frame ) ) )
+		return FALSE;
+
+	if( !readBytes( &command.m_type, sizeof( command.m_type ) ) )
+		return FALSE;
+
+	if( !readBytes( &command.m_playerIndex, sizeof( command.m_playerIndex ) ) )
+		return FALSE;
+
+	UnsignedByte numTypes;
+	if( !readByte( numTypes ) )
+		return FALSE;
+
+	m_signature.resize( numTypes );
+	for( UnsignedByte i = 0; i < numTypes; ++i )
+	{
+		UnsignedByte count;
+		if( !readByte( m_signature[ i ].m_type ) || !readByte( count ) )
+			return FALSE;
+		m_signature[ i ].m_count = count;
+	}
+
+	return TRUE;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+Bool ReplayCommandReader::readCommandV2( ReplayCommand &command )
+{
+	Int frameDelta;
+	if( !readSignedVarint( frameDelta ) )
+		return FALSE;
+
+	command.m_frame = m_lastFrame + (UnsignedInt)frameDelta;
+	m_lastFrame = command.m_frame;
+
+	UnsignedInt type;
+	if( !readVarint( type ) )
+		return FALSE;
+	command.m_type = (Int)type;
+
+	if( !readSignedVarint( command.m_playerIndex ) )
+		return FALSE;
+
+	return readSignature();
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+Bool ReplayCommandReader::readCommand( ReplayCommand &command )
+{
+	const Bool success = m_format == REPLAY_FORMAT_V2 ? readCommandV2( command ) : readCommandV1( command );
+	if( !success )
+		return FALSE;
+
+	UnsignedInt totalArgs = 0;
+	for( size_t i = 0; i < m_signature.size(); ++i )
+		totalArgs += m_signature[ i ].m_count;
+
+	if( totalArgs > MAX_ARGUMENTS )
+	{
+		DEBUG_LOG(( "ReplayCommandReader::readCommand - command has %u arguments", totalArgs ));
+		return FALSE;
+	}
+
+	command.m_args.resize( totalArgs );
+	size_t argIndex = 0;
+	for( size_t i = 0; i < m_signature.size(); ++i )
+	{
+		for( UnsignedInt j = 0; j < m_signature[ i ].m_count; ++j )
+		{
+			GameMessageArgument &arg = command.m_args[ argIndex++ ];
+			arg.m_type = (GameMessageArgumentDataType)m_signature[ i ].m_type;
+			if( !readArgument( arg ) )
+				return FALSE;
+		}
+	}
+
+	return TRUE;
+}
@@ -0,0 +1,268 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: ReplayConverter.cpp //////////////////////////////////////////////////////////////////////
+// Converts retail replays to the compact v2 format and checks that the conversion is lossless
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/ReplayConverter.h"
+
+#include "Common/FileSystem.h"
+#include "Common/file.h"
+#include "Common/Recorder.h"
+#include "GameLogic/GameLogic.h"
+#include "GameClient/GameClient.h"
+
+// ------------------------------------------------------------------------------------------------
+/** Decode all commands of a replay body. If body is given, it receives the raw bytes of the body */
+// ------------------------------------------------------------------------------------------------
+Bool ReplayConverter::readCommands(const AsciiString &filename, ReplayFormat format, Int bodyOffset, UnsignedInt wideCharBytes,
+	std::vector<ReplayCommand> &commands, std::vector<UnsignedByte> *body)
+{
+	File *file = TheFileSystem->openFile(RecorderClass::getReplayFilePath(filename).str(), File::READ | File::BINARY);
+	if (file == nullptr)
+		return FALSE;
+
+	Bool success = file->seek(bodyOffset, File::START) == bodyOffset;
+	if (success)
+	{
+		ReplayCommandReader reader;
+		success = reader.begin(file, format, wideCharBytes);
+
+		ReplayCommand command;
+		while (success && reader.readCommand(command))
+			commands.push_back(command);
+		reader.end();
+	}
+
+	if (success && body != nullptr)
+	{
+		const Int bodySize = file->size() - bodyOffset;
+		body->resize(bodySize);
+		success = file->seek(bodyOffset, File::START) == bodyOffset
+			&& (bodySize == 0 || file->read(&(*body)[0], bodySize) == bodySize);
+	}
+
+	file->close();
+	return success;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+Bool ReplayConverter::simulateReplay(const AsciiString &filename, PlaybackResult &result)
+{
+	if (!TheRecorder->simulateReplay(filename))
+		return FALSE;
+
+	while (TheRecorder->isPlaybackInProgress())
+	{
+		TheGameClient->updateHeadless();
+		TheGameLogic->UPDATE();
+		if (TheRecorder->sawCRCMismatch())
+			break;
+	}
+
+	result.frames = TheGameLogic->getFrame();
+	result.crcCount = TheRecorder->getPlaybackCRCCount();
+	result.crcDigest = TheRecorder->getPlaybackCRCDigest();
+	result.sawCRCMismatch = TheRecorder->sawCRCMismatch();
+	return TRUE;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+Bool ReplayConverter::convertReplay(const AsciiString &filename, Bool compress)
+{
+	RecorderClass::ReplayHeader header;
+	header.forPlayback = FALSE;
+	header.filename = filename;
+	if (!TheRecorder->readReplayHeader(header))
+	{
+		printf("Cannot open replay\n");
+		return FALSE;
+	}
+
+	if (header.format != REPLAY_FORMAT_V1)
+	{
+		printf("Replay is already in the compact format\n");
+		return FALSE;
+	}
+
+	std::vector<ReplayCommand> commands;
+	std::vector<UnsignedByte> body;
+	if (!readCommands(filename, REPLAY_FORMAT_V1, header.bodyOffset, header.wideCharBytes, commands, &body))
+	{
+		printf("Cannot read replay\n");
+		return FALSE;
+	}
+
+	// The header is copied as is, apart from the magic
+	std::vector<char> headerBytes(header.bodyOffset);
+	File *src = TheFileSystem->openFile(RecorderClass::getReplayFilePath(filename).str(), File::READ | File::BINARY);
+	if (src == nullptr)
+		return FALSE;
+	const Bool readHeader = src->read(&headerBytes[0], header.bodyOffset) == header.bodyOffset;
+	src->close();
+	if (!readHeader)
+	{
+		printf("Cannot read replay header\n");
+		return FALSE;
+	}
+	memcpy(&headerBytes[0], s_genrepV2, sizeof(s_genrepV2) - 1);
+
+	AsciiString convertedFilename = filename;
+	convertedFilename.truncateBy(RecorderClass::getReplayExtention().getLength());
+	convertedFilename.concat("_v2");
+	convertedFilename.concat(RecorderClass::getReplayExtention());
+
+	File *dest = TheFileSystem->openFile(RecorderClass::getReplayFilePath(convertedFilename).str(), File::WRITE | File::BINARY);
+	if (dest == nullptr)
+	{
+		printf("Cannot create \"%s\"\n", convertedFilename.str());
+		return FALSE;
+	}
+
+	ReplayCommandWriter writer;
+	Bool written = dest->write(&headerBytes[0], header.bodyOffset) == header.bodyOffset
+		&& writer.begin(dest, REPLAY_FORMAT_V2, compress ? REPLAY_BODY_COMPRESSED : 0);
+	for (size_t i = 0; written && i < commands.size(); ++i)
+		writer.writeCommand(commands[i]);
+	written = written && writer.finish(dest);
+	const Int convertedSize = dest->size();
+	dest->close();
+
+	if (!written)
+	{
+		printf("Cannot write \"%s\"\n", convertedFilename.str());
+		return FALSE;
+	}
+
+	const Int originalSize = header.bodyOffset + (Int)body.size();
+	printf("Wrote \"%s\", %u commands, %d -> %d bytes (%.1f%%)\n", convertedFilename.str(), (UnsignedInt)commands.size(),
+		originalSize, convertedSize, originalSize > 0 ? 100.0 * convertedSize / originalSize : 0.0);
+	fflush(stdout);
+
+	// Read the commands back from the new file
+	RecorderClass::ReplayHeader convertedHeader;
+	convertedHeader.forPlayback = FALSE;
+	convertedHeader.filename = convertedFilename;
+	std::vector<ReplayCommand> convertedCommands;
+	if (!TheRecorder->readReplayHeader(convertedHeader) || convertedHeader.format != REPLAY_FORMAT_V2
+		|| !readCommands(convertedFilename, REPLAY_FORMAT_V2, convertedHeader.bodyOffset, convertedHeader.wideCharBytes, convertedCommands, nullptr))
+	{
+		printf("Cannot read back \"%s\"\n", convertedFilename.str());
+		return FALSE;
+	}
+
+	if (convertedCommands.size() != commands.size())
+	{
+		printf("Read back %u commands instead of %u\n", (UnsignedInt)convertedCommands.size(), (UnsignedInt)commands.size());
+		return FALSE;
+	}
+
+	for (size_t i = 0; i < commands.size(); ++i)
+	{
+		if (!convertedCommands[i].isSameCommand(commands[i]))
+		{
+			printf("Command %u on frame %u does not match\n", (UnsignedInt)i, commands[i].m_frame);
+			return FALSE;
+		}
+	}
+
+	// Rebuild the v1 body, legacy replays with 4 byte wide characters can't be rebuilt byte for byte
+	if (header.wideCharBytes == sizeof(uint16_t))
+	{
+		ReplayCommandWriter rebuilder;
+		rebuilder.begin(nullptr, REPLAY_FORMAT_V1);
+		for (size_t i = 0; i < convertedCommands.size(); ++i)
+			rebuilder.writeCommand(convertedCommands[i]);
+
+		const std::vector<UnsignedByte> &rebuilt = rebuilder.getPendingBytes();
+		if (rebuilt.size() > body.size() || (!rebuilt.empty() && memcmp(&rebuilt[0], &body[0], rebuilt.size()) != 0))
+		{
+			printf("The original commands could not be rebuilt from the compact replay\n");
+			return FALSE;
+		}
+
+		// replays of crashed games can end in a partial command, it was never played back either
+		if (rebuilt.size() < body.size())
+			printf("Ignored %u bytes at the end of the original replay\n", (UnsignedInt)(body.size() - rebuilt.size()));
+	}
+
+	printf("Commands match after the round trip\n");
+	fflush(stdout);
+
+	PlaybackResult original;
+	PlaybackResult converted;
+	if (!simulateReplay(filename, original) || !simulateReplay(convertedFilename, converted))
+	{
+		printf("Cannot simulate replay\n");
+		return FALSE;
+	}
+
+	printf("Original: %u frames, %u CRCs, digest %8.8X%s\n", original.frames, original.crcCount, original.crcDigest,
+		original.sawCRCMismatch ? ", CRC mismatch" : "");
+	printf("Compact:  %u frames, %u CRCs, digest %8.8X%s\n", converted.frames, converted.crcCount, converted.crcDigest,
+		converted.sawCRCMismatch ? ", CRC mismatch" : "");
+
+	if (original.frames != converted.frames || original.crcCount != converted.crcCount
+		|| original.crcDigest != converted.crcDigest || original.sawCRCMismatch != converted.sawCRCMismatch)
+	{
+		printf("Playback CRCs do not match\n");
+		return FALSE;
+	}
+
+	printf("Playback CRCs match\n");
+	return TRUE;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+int ReplayConverter::convertReplays(const std::vector<AsciiString> &filenames, Bool compress)
+{
+	// Note that we use printf here because this is run from cmd.
+	if (!TheGlobalData->m_headless)
+	{
+		printf("-convertReplay needs -headless\n");
+		return 1;
+	}
+
+	int numErrors = 0;
+	for (size_t i = 0; i < filenames.size(); ++i)
+	{
+		printf("Converting Replay \"%s\"\n", filenames[i].str());
+		fflush(stdout);
+
+		if (!convertReplay(filenames[i], compress))
+			numErrors++;
+		fflush(stdout);
+	}
+
+	if (TheGameLogic->isInGame())
+		TheGameLogic->clearGameData();
+
+	if (filenames.size() > 1)
+	{
+		printf("Conversion of all replays completed. Errors occurred: %d\n", numErrors);
+		fflush(stdout);
+	}
+
+	return numErrors != 0 ? 1 : 0;
+}
@@ -23,6 +23,7 @@
 #include "Common/GameEngine.h"
 #include "Common/LocalFileSystem.h"
 #include "Common/Recorder.h"
+#include "Common/UpdateProfiler.h"
 #include "Common/WorkerProcess.h"
 #include "GameLogic/GameLogic.h"
 #include "GameClient/GameClient.h"
@@ -84,6 +85,10 @@ int ReplaySimulation::simulateReplaysInThisProcess(const std::vector<AsciiString
 		return numErrors != 0 ? 1 : 0;
 	}
 	// Note that we use printf here because this is run from cmd.
+	const Bool profileUpdates = !TheGlobalData->m_updateProfileFile.isEmpty();
+	if (profileUpdates)
+		UpdateProfiler::start();
+
 	DWORD totalStartTimeMillis = GetTickCount();
 	for (size_t i = 0; i < filenames.size(); i++)
 	{
@@ -136,6 +141,19 @@ int ReplaySimulation::simulateReplaysInThisProcess(const std::vector<AsciiString
 		fflush(stdout);
 	}
 
+	if (profileUpdates)
+	{
+		// The costs of all replays add up in one report
+		UpdateProfiler::stop();
+		UpdateProfiler::printSummary(10);
+		if (!UpdateProfiler::writeReport(TheGlobalData->m_updateProfileFile))
+		{
+			printf("Cannot write update profile \"%s\"\n", TheGlobalData->m_updateProfileFile.str());
+			fflush(stdout);
+			numErrors++;
+		}
+	}
+
 	return numErrors != 0 ? 1 : 0;
 }
 
@@ -284,7 +302,9 @@ std::vector<AsciiString> ReplaySimulation::resolveFilenameWildcards(const std::v
 int ReplaySimulation::simulateReplays(const std::vector<AsciiString> &filenames, int maxProcesses)
 {
 	std::vector<AsciiString> filenamesResolved = resolveFilenameWildcards(filenames);
-	if (maxProcesses == SIMULATE_REPLAYS_SEQUENTIAL)
+	// GeneralsX @performance 18/10/2026 The update profile is collected in this process, so that it
+	// covers all replays.
+	if (maxProcesses == SIMULATE_REPLAYS_SEQUENTIAL || !TheGlobalData->m_updateProfileFile.isEmpty())
 		return simulateReplaysInThisProcess(filenamesResolved);
 	else
 		return simulateReplaysInWorkerProcesses(filenamesResolved, maxProcesses);
@@ -0,0 +1,209 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: StringBenchmark.cpp //////////////////////////////////////////////////////////////////////
+// Measures the allocations and the speed of building and comparing AsciiStrings
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/StringBenchmark.h"
+
+#include "Common/file.h"
+#include "Common/FileSystem.h"
+#include "Common/ThingFactory.h"
+#include "Common/ThingTemplate.h"
+
+#include <chrono>
+#include <vector>
+
+namespace
+{
+enum
+{
+	NAME_NEIGHBOURS = 8		///< each name is compared against this many names on either side
+};
+
+struct StringResult
+{
+	UnsignedInt checksum;
+	Int tokens;
+	Int matches;
+};
+
+struct StringTiming
+{
+	double iniTime;
+	double nameTime;
+	UnsignedInt iniAllocations;
+	UnsignedInt nameAllocations;
+};
+
+void readLines(const AsciiString &path, std::vector<AsciiString> &lines)
+{
+	File *file = TheFileSystem->openFile(path.str(), File::READ | File::BINARY);
+	if (file == nullptr)
+		return;
+
+	const Int size = file->size();
+	char *buffer = file->readEntireAndClose();
+	const char *lineStart = buffer;
+	for (const char *c = buffer; c <= buffer + size; ++c)
+	{
+		if (c == buffer + size || *c == '\n')
+		{
+			if (c > lineStart)
+				lines.push_back(AsciiString(lineStart, (Int)(c - lineStart)));
+			lineStart = c + 1;
+		}
+	}
+	delete[] buffer;
+}
+
+// the strings INI loading makes: every token of a line becomes an AsciiString, and the name after
+// a block keyword at the start of a line is interned, the way the template and event names are
+void tokenizeIni(const std::vector<AsciiString> &lines, StringResult &result)
+{
+	std::vector<AsciiString> values;
+	for (size_t i = 0; i < lines.size(); ++i)
+	{
+		const Bool isBlock = !isspace((unsigned char)lines[i].getCharAt(0));
+		AsciiString rest = lines[i];
+		AsciiString token;
+		for (Int index = 0; rest.nextToken(&token, " \t\r\n="); ++index)
+		{
+			if (token.startsWith(";") || token.startsWith("//"))
+				break;
+
+			if (isBlock && index == 1)
+				token.intern();
+
+			values.push_back(token);
+			result.checksum = result.checksum * 31 + token.getLength() + (UnsignedByte)token.getCharAt(0);
+			++result.tokens;
+		}
+	}
+}
+
+// the strings the scripts and the interface build from the template names, and the comparisons
+// the factories make to find a template by name
+void useNames(const std::vector<AsciiString> &names, StringResult &result)
+{
+	const Int count = (Int)names.size();
+	for (Int i = 0; i < count; ++i)
+	{
+		AsciiString copy = names[i];
+		AsciiString label;
+		label.format("%s:%d", copy.str(), i);
+		label.concat("_Label");
+		label.toLower();
+		result.checksum = result.checksum * 31 + label.getLength() + (UnsignedByte)label.getCharAt(0);
+
+		for (Int j = MAX(i - NAME_NEIGHBOURS, 0); j <= MIN(i + NAME_NEIGHBOURS, count - 1); ++j)
+		{
+			if (names[j] == copy)
+				++result.matches;
+		}
+	}
+}
+
+double getMilliseconds(const std::chrono::steady_clock::time_point &start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// runs both workloads with the storage on or off, the first pass warms them up
+void runRounds(Bool useStorage, Int rounds, const std::vector<AsciiString> &lines, StringResult &result, StringTiming &timing)
+{
+	AsciiString::setStorageEnabled(useStorage);
+
+	// fresh copies of the template names, interned again when the storage is on
+	std::vector<AsciiString> names;
+	for (const ThingTemplate *tmpl = TheThingFactory->firstTemplate(); tmpl; tmpl = tmpl->friend_getNextTemplate())
+	{
+		AsciiString name(tmpl->getName().str());
+		name.intern();
+		names.push_back(name);
+	}
+
+	StringResult warmup = { 0, 0, 0 };
+	tokenizeIni(lines, warmup);
+	useNames(names, warmup);
+
+	result.checksum = 0;
+	result.tokens = 0;
+	result.matches = 0;
+
+	UnsignedInt allocations = AsciiString::getNumBufferAllocations();
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (Int round = 0; round < rounds; ++round)
+		tokenizeIni(lines, result);
+	timing.iniTime = getMilliseconds(start);
+	timing.iniAllocations = AsciiString::getNumBufferAllocations() - allocations;
+
+	allocations = AsciiString::getNumBufferAllocations();
+	start = std::chrono::steady_clock::now();
+	for (Int round = 0; round < rounds; ++round)
+		useNames(names, result);
+	timing.nameTime = getMilliseconds(start);
+	timing.nameAllocations = AsciiString::getNumBufferAllocations() - allocations;
+}
+} // namespace
+
+int StringBenchmark::benchmarkStrings(Int rounds)
+{
+	FilenameList filenameList;
+	TheFileSystem->getFileListInDirectory("Data\\INI\\", "*.ini", filenameList, TRUE);
+
+	std::vector<AsciiString> lines;
+	for (FilenameListIter it = filenameList.begin(); it != filenameList.end(); ++it)
+		readLines(*it, lines);
+
+	Int templates = 0;
+	for (const ThingTemplate *tmpl = TheThingFactory->firstTemplate(); tmpl; tmpl = tmpl->friend_getNextTemplate())
+		++templates;
+
+	// Note that we use printf here because this is run from cmd.
+	printf("Tokenizing %d INI files with %d lines and using %d template names %d times\n",
+		(Int)filenameList.size(), (Int)lines.size(), templates, rounds);
+	fflush(stdout);
+
+	const Bool wasEnabled = AsciiString::isStorageEnabled();
+
+	StringResult plainResult, storageResult;
+	StringTiming plainTiming, storageTiming;
+	runRounds(FALSE, rounds, lines, plainResult, plainTiming);
+	runRounds(TRUE, rounds, lines, storageResult, storageTiming);
+
+	AsciiString::setStorageEnabled(wasEnabled);
+
+	const Bool match = plainResult.checksum == storageResult.checksum
+		&& plainResult.tokens == storageResult.tokens
+		&& plainResult.matches == storageResult.matches;
+
+	printf("INI tokens (%d per round): plain %.1f ms with %u allocations, small buffers and interning %.1f ms with %u allocations\n",
+		rounds > 0 ? plainResult.tokens / rounds : 0,
+		plainTiming.iniTime, plainTiming.iniAllocations, storageTiming.iniTime, storageTiming.iniAllocations);
+	printf("Template names (%d matches per round): plain %.1f ms with %u allocations, small buffers and interning %.1f ms with %u allocations\n",
+		rounds > 0 ? plainResult.matches / rounds : 0,
+		plainTiming.nameTime, plainTiming.nameAllocations, storageTiming.nameTime, storageTiming.nameAllocations);
+	printf("Results %s\n", match ? "match" : "DO NOT MATCH");
+	fflush(stdout);
+
+	return match ? 0 : 1;
+}
@@ -102,11 +102,16 @@ ArchiveFileSystem *TheArchiveFileSystem = nullptr;
 // ArchivedFileInfo
 //------------------------------------------------------
 ArchiveFileSystem::ArchiveFileSystem()
+	: m_accessTrace(nullptr)
+	, m_accessTraceFailed(FALSE)
 {
 }
 
 ArchiveFileSystem::~ArchiveFileSystem()
 {
+	if (m_accessTrace != nullptr)
+		fclose(m_accessTrace);
+
 	ArchiveFileMap::iterator iter = m_archiveFileMap.begin();
 	while (iter != m_archiveFileMap.end()) {
 		ArchiveFile *file = iter->second;
@@ -294,9 +299,45 @@ File * ArchiveFileSystem::openFile(const Char *filename, Int access, FileInstanc
 	if (archive == nullptr)
 		return nullptr;
 
+	// m_archiveTraceFile is only set by the command line, before any file is opened
+	if (TheGlobalData != nullptr && TheGlobalData->m_archiveTraceFile.isNotEmpty())
+		traceFileOpen(filename, archive);
+
 	return archive->openFile(filename, access);
 }
 
+// Writes a line with the archive name and the lower case path of the file, with backslashes like the
+// paths stored in the BIG files. Only the first open of each file is written.
+void ArchiveFileSystem::traceFileOpen(const Char *filename, ArchiveFile *archive)
+{
+	FastCriticalSectionClass::LockClass lock(m_accessTraceMutex);
+
+	if (m_accessTraceFailed)
+		return;
+
+	AsciiString path;
+	for (const Char *c = filename; *c != '\0'; ++c)
+		path.concat(*c == '/' ? '\\' : *c);
+	path.toLower();
+
+	if (!m_tracedFiles.insert(path).second)
+		return;
+
+	if (m_accessTrace == nullptr)
+	{
+		m_accessTrace = fopen(TheGlobalData->m_archiveTraceFile.str(), "w");
+		if (m_accessTrace == nullptr)
+		{
+			DEBUG_LOG(("ArchiveFileSystem::traceFileOpen - could not open %s", TheGlobalData->m_archiveTraceFile.str()));
+			m_accessTraceFailed = TRUE;
+			return;
+		}
+	}
+
+	fprintf(m_accessTrace, "%s\t%s\n", archive->getName().str(), path.str());
+	fflush(m_accessTrace);
+}
+
 Bool ArchiveFileSystem::getFileInfo(const AsciiString& filename, FileInfo *fileInfo, FileInstance instance) const
 {
 	if (fileInfo == nullptr) {
@@ -46,6 +46,10 @@
 
 #include "Common/CriticalSection.h"
 
+#include <atomic>
+#include <string_view>
+#include <unordered_set>
+
 
 // -----------------------------------------------------
 
@@ -115,14 +119,38 @@ static StringCaseInfo getStringCaseInfo(const char *str)
 	return info;
 }
 
+//-----------------------------------------------------------------------------
+enum
+{
+	SMALL_BUFFER_BYTES = 32,				///< strings whose buffer fits get a block of this size from the free list
+	MAX_FREE_SMALL_BUFFERS = 4096,
+	MAX_INTERNED_REFS = 30000				///< stays below the refcount AsciiString::validate finds suspicious
+};
+
+// the free blocks keep the next block at their start, all of these are guarded by TheAsciiStringCriticalSection
+struct FreeSmallBuffer
+{
+	FreeSmallBuffer* next;
+};
+
+// the text of each interned buffer, which points into the buffer itself
+typedef std::unordered_set<std::string_view> InternTable;
+
+FreeSmallBuffer* TheFreeSmallBuffers = nullptr;
+Int TheNumFreeSmallBuffers = 0;
+Int TheSmallBufferChars = 0;
+InternTable* TheInternTable = nullptr;
+Bool TheStorageIsEnabled = TRUE;
+Bool TheStorageIsReleased = FALSE;
+std::atomic<UnsignedInt> TheNumBufferAllocations(0);
+
 } // namespace
 
 // -----------------------------------------------------
-AsciiString::AsciiString(const AsciiString& stringSrc) : m_data(stringSrc.m_data)
+AsciiString::AsciiString(const AsciiString& stringSrc) : m_data(nullptr)
 {
 	ScopedCriticalSection scopedCriticalSection(TheAsciiStringCriticalSection);
-	if (m_data)
-		++m_data->m_refCount;
+	shareBuffer(stringSrc.m_data);
 	validate();
 }
 
@@ -134,6 +162,8 @@ void AsciiString::validate() const
 		return;
 	DEBUG_ASSERTCRASH(m_data->m_refCount > 0, ("m_refCount is zero"));
 	DEBUG_ASSERTCRASH(m_data->m_refCount < 32000, ("m_refCount is suspiciously large"));
+	if (m_data->m_numCharsAllocated == 0)
+		return;	// interned, the buffer holds exactly its text
 	DEBUG_ASSERTCRASH(m_data->m_numCharsAllocated > 0, ("m_numCharsAllocated is zero"));
 //	DEBUG_ASSERTCRASH(m_data->m_numCharsAllocated < 1024, ("m_numCharsAllocated suspiciously large"));
 	DEBUG_ASSERTCRASH(strlen(m_data->peek())+1 <= m_data->m_numCharsAllocated,("str is too long (%d) for storage",strlen(m_data->peek())+1));
@@ -182,13 +212,8 @@ void AsciiString::ensureUniqueBufferOfSize(int numCharsNeeded, Bool preserveData
 	DEBUG_ASSERTCRASH(TheDynamicMemoryAllocator != nullptr, ("Cannot use dynamic memory allocator before its initialization. Check static initialization order."));
 	DEBUG_ASSERTCRASH(numCharsNeeded <= MAX_LEN, ("AsciiString::ensureUniqueBufferOfSize exceeds max string length %d with requested length %d", MAX_LEN, numCharsNeeded));
 	int minBytes = sizeof(AsciiStringData) + numCharsNeeded*sizeof(char);
-	int actualBytes = TheDynamicMemoryAllocator->getActualAllocationSize(minBytes);
-	AsciiStringData* newData = (AsciiStringData*)TheDynamicMemoryAllocator->allocateBytesDoNotZero(actualBytes, "STR_AsciiString::ensureUniqueBufferOfSize");
+	AsciiStringData* newData = allocateBuffer(minBytes);
 	newData->m_refCount = 1;
-	newData->m_numCharsAllocated = (actualBytes - sizeof(AsciiStringData))/sizeof(char);
-#if defined(RTS_DEBUG)
-	newData->m_debugptr = newData->peek();	// just makes it easier to read in the debugger
-#endif
 
 	if (m_data && preserveData)
 		strcpy(newData->peek(), m_data->peek());
@@ -223,13 +248,191 @@ void AsciiString::releaseBuffer()
 	{
 		if (--m_data->m_refCount == 0)
 		{
-			TheDynamicMemoryAllocator->freeBytes(m_data);
+			freeBuffer(m_data);
 		}
 		m_data = nullptr;
 	}
 	validate();
 }
 
+// -----------------------------------------------------
+AsciiString::AsciiStringData* AsciiString::allocateBuffer(int minBytes)
+{
+	AsciiStringData* data = nullptr;
+	if (minBytes <= SMALL_BUFFER_BYTES && TheStorageIsEnabled)
+	{
+		ScopedCriticalSection scopedCriticalSection(TheAsciiStringCriticalSection);
+
+		if (TheFreeSmallBuffers)
+		{
+			FreeSmallBuffer* block = TheFreeSmallBuffers;
+			TheFreeSmallBuffers = block->next;
+			--TheNumFreeSmallBuffers;
+			data = (AsciiStringData*)block;
+		}
+		else
+		{
+			const int actualBytes = TheDynamicMemoryAllocator->getActualAllocationSize(SMALL_BUFFER_BYTES);
+			data = (AsciiStringData*)TheDynamicMemoryAllocator->allocateBytesDoNotZero(actualBytes, "STR_AsciiString::ensureUniqueBufferOfSize");
+			++TheNumBufferAllocations;
+			TheSmallBufferChars = (actualBytes - sizeof(AsciiStringData))/sizeof(char);
+		}
+		data->m_numCharsAllocated = TheSmallBufferChars;
+	}
+	else
+	{
+		const int actualBytes = TheDynamicMemoryAllocator->getActualAllocationSize(minBytes);
+		data = (AsciiStringData*)TheDynamicMemoryAllocator->allocateBytesDoNotZero(actualBytes, "STR_AsciiString::ensureUniqueBufferOfSize");
+		++TheNumBufferAllocations;
+		data->m_numCharsAllocated = (actualBytes - sizeof(AsciiStringData))/sizeof(char);
+	}
+
+#if defined(RTS_DEBUG)
+	data->m_debugptr = data->peek();	// just makes it easier to read in the debugger
+#endif
+	return data;
+}
+
+// -----------------------------------------------------
+void AsciiString::freeBuffer(AsciiStringData* data)
+{
+	ScopedCriticalSection scopedCriticalSection(TheAsciiStringCriticalSection);
+
+	// a small block is kept whichever way it was allocated, it has room for any short string
+	if (TheStorageIsEnabled && !TheStorageIsReleased &&
+			TheSmallBufferChars > 0 && data->m_numCharsAllocated == TheSmallBufferChars &&
+			TheNumFreeSmallBuffers < MAX_FREE_SMALL_BUFFERS)
+	{
+		FreeSmallBuffer* block = (FreeSmallBuffer*)data;
+		block->next = TheFreeSmallBuffers;
+		TheFreeSmallBuffers = block;
+		++TheNumFreeSmallBuffers;
+		return;
+	}
+
+	TheDynamicMemoryAllocator->freeBytes(data);
+}
+
+// -----------------------------------------------------
+// Any number of strings may copy an interned buffer, its 16 bit refcount would wrap around and free
+// the buffer while it is still in use. Once it has MAX_INTERNED_REFS references, copies get their
+// own buffer instead.
+void AsciiString::shareBuffer(AsciiStringData* data)
+{
+	ScopedCriticalSection scopedCriticalSection(TheAsciiStringCriticalSection);
+
+	DEBUG_ASSERTCRASH(m_data == nullptr, ("the buffer of the string must be released first"));
+	if (data == nullptr)
+		return;
+
+	if (data->m_numCharsAllocated == 0 && data->m_refCount >= MAX_INTERNED_REFS)
+	{
+		const char* text = data->peek();
+		ensureUniqueBufferOfSize((int)strlen(text) + 1, false, text, nullptr);
+		return;
+	}
+
+	m_data = data;
+	++m_data->m_refCount;
+}
+
+// -----------------------------------------------------
+void AsciiString::intern()
+{
+	validate();
+	if (m_data == nullptr || isInterned())
+		return;
+
+	ScopedCriticalSection scopedCriticalSection(TheAsciiStringCriticalSection);
+
+	if (!TheStorageIsEnabled || TheStorageIsReleased)
+		return;
+
+	if (TheInternTable == nullptr)
+		TheInternTable = NEW InternTable;
+
+	const std::string_view text(peek());
+	InternTable::const_iterator it = TheInternTable->find(text);
+	if (it != TheInternTable->end())
+	{
+		AsciiStringData* shared = (AsciiStringData*)it->data() - 1;
+		if (shared->m_refCount >= MAX_INTERNED_REFS)
+			return;
+
+		++shared->m_refCount;
+		releaseBuffer();
+		m_data = shared;
+		validate();
+		return;
+	}
+
+	// a buffer nobody else holds becomes the interned one, otherwise the text gets its own
+	if (m_data->m_refCount != 1)
+	{
+		AsciiStringData* newData = allocateBuffer(sizeof(AsciiStringData) + (text.size() + 1)*sizeof(char));
+		newData->m_refCount = 1;
+		memcpy(newData->peek(), text.data(), text.size() + 1);
+		releaseBuffer();
+		m_data = newData;
+	}
+
+	m_data->m_numCharsAllocated = 0;
+	++m_data->m_refCount;	// the table's own reference
+	TheInternTable->insert(std::string_view(m_data->peek(), text.size()));
+#ifdef MEMORYPOOL_DEBUG
+	TheDynamicMemoryAllocator->debugIgnoreLeaksForThisBlock(m_data);
+#endif
+	validate();
+}
+
+// -----------------------------------------------------
+void AsciiString::setStorageEnabled(Bool enabled)
+{
+	ScopedCriticalSection scopedCriticalSection(TheAsciiStringCriticalSection);
+	TheStorageIsEnabled = enabled;
+}
+
+// -----------------------------------------------------
+Bool AsciiString::isStorageEnabled()
+{
+	return TheStorageIsEnabled;
+}
+
+// -----------------------------------------------------
+UnsignedInt AsciiString::getNumBufferAllocations()
+{
+	return TheNumBufferAllocations;
+}
+
+// -----------------------------------------------------
+void AsciiString::releaseStorage()
+{
+	ScopedCriticalSection scopedCriticalSection(TheAsciiStringCriticalSection);
+
+	while (TheFreeSmallBuffers)
+	{
+		FreeSmallBuffer* block = TheFreeSmallBuffers;
+		TheFreeSmallBuffers = block->next;
+		TheDynamicMemoryAllocator->freeBytes(block);
+	}
+	TheNumFreeSmallBuffers = 0;
+
+	// the strings still holding an interned buffer free it with their last reference
+	if (TheInternTable)
+	{
+		for (InternTable::const_iterator it = TheInternTable->begin(); it != TheInternTable->end(); ++it)
+		{
+			AsciiStringData* shared = (AsciiStringData*)it->data() - 1;
+			if (--shared->m_refCount == 0)
+				TheDynamicMemoryAllocator->freeBytes(shared);
+		}
+		delete TheInternTable;
+		TheInternTable = nullptr;
+	}
+
+	TheStorageIsReleased = TRUE;
+}
+
 // -----------------------------------------------------
 AsciiString::AsciiString(const char* s) : m_data(nullptr)
 {
@@ -261,9 +464,7 @@ void AsciiString::set(const AsciiString& stringSrc)
 	if (&stringSrc != this)
 	{
 		releaseBuffer();
-		m_data = stringSrc.m_data;
-		if (m_data)
-			++m_data->m_refCount;
+		shareBuffer(stringSrc.m_data);
 	}
 	validate();
 }
@@ -0,0 +1,147 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: BuildabilityGrid.cpp /////////////////////////////////////////////////////////////////////
+// What stops construction in each pathfind cell of the map
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/BuildabilityGrid.h"
+
+#include "Common/TerrainTypes.h"
+#include "GameClient/TerrainVisual.h"
+#include "GameLogic/AI.h"
+#include "GameLogic/AIPathfind.h"
+#include "GameLogic/GameLogic.h"
+#include "GameLogic/Object.h"
+
+Bool BuildabilityGrid::s_isEnabled = TRUE;
+
+BuildabilityGrid::BuildabilityGrid() :
+	m_isValid(FALSE),
+	m_obstaclesValid(FALSE),
+	m_cellsX(0),
+	m_cellsY(0)
+{
+}
+
+void BuildabilityGrid::reset()
+{
+	m_isValid = FALSE;
+	m_obstaclesValid = FALSE;
+	m_cellsX = 0;
+	m_cellsY = 0;
+	m_restrictedTiles.clear();
+	m_obstacles.clear();
+}
+
+Bool BuildabilityGrid::isTileRestricted(Int cellX, Int cellY)
+{
+	// the terrain tiles and the pathfind cells are both MAP_XY_FACTOR wide, any point of the cell
+	// finds the same tile as the footprint samples in it do
+	TerrainType *terrain = TheTerrainVisual->getTerrainTile((cellX + 0.5f) * PATHFIND_CELL_SIZE_F, (cellY + 0.5f) * PATHFIND_CELL_SIZE_F);
+	return terrain != nullptr && terrain->getRestrictConstruction();
+}
+
+void BuildabilityGrid::validate()
+{
+	const ICoord2D *extent = TheAI->pathfinder()->getExtent();
+	if (m_isValid && m_cellsX == extent->x + 1 && m_cellsY == extent->y + 1)
+		return;
+
+	m_cellsX = extent->x + 1;
+	m_cellsY = extent->y + 1;
+	m_restrictedTiles.assign(m_cellsX * m_cellsY, 0);
+	for (Int cellY = 0; cellY < m_cellsY; ++cellY)
+	{
+		for (Int cellX = 0; cellX < m_cellsX; ++cellX)
+			m_restrictedTiles[cellY * m_cellsX + cellX] = isTileRestricted(cellX, cellY) ? 1 : 0;
+	}
+
+	m_isValid = TRUE;
+	m_obstaclesValid = FALSE;
+}
+
+Bool BuildabilityGrid::isCellRestricted(Int cellX, Int cellY)
+{
+	PathfindCell *cell = TheAI->pathfinder()->getCell(LAYER_GROUND, cellX, cellY);
+	if (cell == nullptr)
+		return TRUE;
+
+	// the cell types change with bridges and water levels, the pathfinder keeps them up to date
+	enum PathfindCell::CellType type = cell->getType();
+	if (type == PathfindCell::CELL_WATER || type == PathfindCell::CELL_CLIFF || type == PathfindCell::CELL_IMPASSABLE)
+		return TRUE;
+
+	validate();
+	if (!isInGrid(cellX, cellY))
+		return isTileRestricted(cellX, cellY);
+
+	return m_restrictedTiles[cellY * m_cellsX + cellX] != 0;
+}
+
+Bool BuildabilityGrid::isObstacle(const Object *obj)
+{
+	// BuildAssistant::isLocationClearOfObjects lets all of these be built over
+	return obj->isKindOf(KINDOF_IMMOBILE)
+		&& !obj->isKindOf(KINDOF_MINE)
+		&& !obj->isKindOf(KINDOF_INERT)
+		&& !obj->isKindOf(KINDOF_SHRUBBERY)
+		&& !obj->isKindOf(KINDOF_CLEARED_BY_BUILD);
+}
+
+void BuildabilityGrid::placeObstacles()
+{
+	m_obstacles.assign(m_cellsX * m_cellsY, INVALID_ID);
+	for (Object *obj = TheGameLogic->getFirstObject(); obj; obj = obj->getNextObject())
+	{
+		if (!isObstacle(obj))
+			continue;
+
+		const Coord3D *pos = obj->getPosition();
+		const Real radius = obj->getGeometryInfo().getBoundingCircleRadius();
+		const Int loX = MAX(REAL_TO_INT_FLOOR((pos->x - radius) / PATHFIND_CELL_SIZE_F), 0);
+		const Int loY = MAX(REAL_TO_INT_FLOOR((pos->y - radius) / PATHFIND_CELL_SIZE_F), 0);
+		const Int hiX = MIN(REAL_TO_INT_FLOOR((pos->x + radius) / PATHFIND_CELL_SIZE_F), m_cellsX - 1);
+		const Int hiY = MIN(REAL_TO_INT_FLOOR((pos->y + radius) / PATHFIND_CELL_SIZE_F), m_cellsY - 1);
+		for (Int cellY = loY; cellY <= hiY; ++cellY)
+		{
+			for (Int cellX = loX; cellX <= hiX; ++cellX)
+			{
+				ObjectID &id = m_obstacles[cellY * m_cellsX + cellX];
+				if (id == INVALID_ID)
+					id = obj->getID();
+			}
+		}
+	}
+
+	m_obstaclesValid = TRUE;
+}
+
+ObjectID BuildabilityGrid::getObstacleAt(Int cellX, Int cellY)
+{
+	validate();
+	if (!isInGrid(cellX, cellY))
+		return INVALID_ID;
+
+	if (!m_obstaclesValid)
+		placeObstacles();
+
+	return m_obstacles[cellY * m_cellsX + cellX];
+}
@@ -515,7 +515,6 @@ static PoolSizeRec PoolSizes[] =
 	{ "AnimateWindow", 32, 32 },
 	{ "GameFont", 32, 32 },
 	{ "NetCommandRef", 256, 32 },
-	{ "GameMessageArgument", 128, 32 },
 	{ "GameMessageParserArgumentType", 32, 32 },
 	{ "GameMessageParser", 32, 32 },
 	{ "WeaponBonusSet", 32, 32 },
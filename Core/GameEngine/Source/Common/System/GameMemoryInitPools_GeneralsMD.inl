@@ -511,7 +511,6 @@ static PoolSizeRec PoolSizes[] =
 	{ "AnimateWindow", 32, 32 },
 	{ "GameFont", 32, 32 },
 	{ "NetCommandRef", 256, 32 },
-	{ "GameMessageArgument", 1024, 256 },
 	{ "GameMessageParserArgumentType", 32, 32 },
 	{ "GameMessageParser", 32, 32 },
 	{ "WeaponBonusSet", 96, 32 },
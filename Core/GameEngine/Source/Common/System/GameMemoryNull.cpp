@@ -143,6 +143,9 @@ void shutdownMemoryManager()
 {
 	if (TheDynamicMemoryAllocator != nullptr)
 	{
+		// GeneralsX @performance 18/10/2026 Give back the buffers AsciiString keeps for reuse
+		AsciiString::releaseStorage();
+
 		TheDynamicMemoryAllocator->~DynamicMemoryAllocator();
 		free((void *)TheDynamicMemoryAllocator);
 		TheDynamicMemoryAllocator = nullptr;
@@ -0,0 +1,59 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: TextureLoadBenchmark.cpp /////////////////////////////////////////////////////////////////
+// Measures how fast the texture loader threads decode the textures of the game
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/TextureLoadBenchmark.h"
+
+#include "Common/FileSystem.h"
+#include "WW3D2/textureloader.h"
+
+#include <vector>
+
+int TextureLoadBenchmark::benchmarkDecoding(Int maxThreads)
+{
+	FilenameList filenameList;
+	TheFileSystem->getFileListInDirectory("Art\\Textures\\", "*.dds", filenameList, TRUE);
+	TheFileSystem->getFileListInDirectory("Art\\Textures\\", "*.tga", filenameList, TRUE);
+
+	// the texture files are opened by name, the W3D file system knows where to find them
+	std::vector<StringClass> filenames;
+	for (FilenameListIter it = filenameList.begin(); it != filenameList.end(); ++it)
+	{
+		const char *name = it->str();
+		for (const char *c = name; *c != '\0'; ++c)
+		{
+			if (*c == '\\' || *c == '/')
+				name = c + 1;
+		}
+		filenames.push_back(StringClass(name));
+	}
+
+	// Note that we use printf here because this is run from cmd.
+	printf("Loading %d textures with 1 to %d loader threads\n", (Int)filenames.size(), maxThreads);
+	fflush(stdout);
+
+	if (filenames.empty())
+		return 1;
+
+	return TextureLoader::Benchmark_Decoding(&filenames[0], (Int)filenames.size(), maxThreads);
+}
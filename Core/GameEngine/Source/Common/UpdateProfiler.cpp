@@ -0,0 +1,267 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: UpdateProfiler.cpp ///////////////////////////////////////////////////////////////////////
+// Attributes the time of GameLogic::update to the update modules and subsystems that spent it
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/UpdateProfiler.h"
+
+#include "Common/NameKeyGenerator.h"
+#include "Common/ThingTemplate.h"
+#include "GameLogic/Module/UpdateModule.h"
+#include "GameLogic/Object.h"
+
+#include <algorithm>
+#include <chrono>
+
+Bool UpdateProfiler::s_isRunning = false;
+UpdateProfiler::Stats UpdateProfiler::s_sections[SECTION_COUNT];
+std::vector<UpdateProfiler::Stats> UpdateProfiler::s_modules;
+std::vector<UpdateProfiler::Stats> UpdateProfiler::s_templates;
+std::vector<AsciiString> UpdateProfiler::s_moduleNames;
+std::vector<AsciiString> UpdateProfiler::s_templateNames;
+
+static const char *const TheSectionNames[UpdateProfiler::SECTION_COUNT] =
+{
+	"GameLogic::update",
+	"ScriptEngine::update",
+	"TerrainLogic::update",
+	"GameLogic::processCommandList",
+	"UpdateModule::update",
+	"AI::update",
+	"AIPlayer::update",
+	"BuildAssistant::update",
+	"PartitionManager::update",
+};
+
+static const char *const TheSleepBucketNames[UpdateProfiler::SLEEP_BUCKET_COUNT] =
+{
+	"1", "2_3", "4_7", "8_15", "16_31", "32_63", "64_127", "128_255", "256_511", "512_up", "forever",
+};
+
+namespace
+{
+struct ReportLine
+{
+	const char *kind;
+	const char *name;
+	const void *stats;
+	Int64 totalTicks;
+
+	bool operator<(const ReportLine &other) const { return totalTicks > other.totalTicks; }
+};
+
+double ticksToMilliseconds(Int64 ticks)
+{
+	return ticks / 1000000.0;
+}
+
+double ticksToMicroseconds(Int64 ticks)
+{
+	return ticks / 1000.0;
+}
+} // namespace
+
+UpdateProfiler::Stats::Stats() : calls(0), totalTicks(0), worstTicks(0)
+{
+	for (Int i = 0; i < SLEEP_BUCKET_COUNT; ++i)
+		sleeps[i] = 0;
+}
+
+void UpdateProfiler::Stats::add(Int64 ticks)
+{
+	++calls;
+	totalTicks += ticks;
+	if (ticks > worstTicks)
+		worstTicks = ticks;
+}
+
+Int64 UpdateProfiler::getTicks()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void UpdateProfiler::start()
+{
+	for (Int i = 0; i < SECTION_COUNT; ++i)
+		s_sections[i] = Stats();
+	s_modules.clear();
+	s_templates.clear();
+	s_isRunning = true;
+}
+
+void UpdateProfiler::stop()
+{
+	s_isRunning = false;
+}
+
+void UpdateProfiler::recordSection(Section section, Int64 start)
+{
+	s_sections[section].add(getTicks() - start);
+}
+
+Int UpdateProfiler::getSleepBucket(UnsignedInt sleepFrames)
+{
+	if (sleepFrames >= UPDATE_SLEEP_FOREVER)
+		return SLEEP_BUCKET_FOREVER;
+
+	Int bucket = 0;
+	while (sleepFrames > 1 && bucket < SLEEP_BUCKET_FOREVER - 1)
+	{
+		sleepFrames >>= 1;
+		++bucket;
+	}
+	return bucket;
+}
+
+void UpdateProfiler::recordModule(const UpdateModule *module, Int64 start, UnsignedInt sleepFrames)
+{
+	const Int64 ticks = getTicks() - start;
+	const Int bucket = getSleepBucket(sleepFrames);
+
+	// name keys and template IDs are handed out in sequence, so both index a plain array
+	const NameKeyType moduleKey = module->getModuleNameKey();
+	if (static_cast<size_t>(moduleKey) >= s_modules.size())
+		s_modules.resize(moduleKey + 1);
+	Stats &moduleStats = s_modules[moduleKey];
+	moduleStats.add(ticks);
+	moduleStats.sleeps[bucket]++;
+
+	const ThingTemplate *thingTemplate = module->friend_getObject()->getTemplate();
+	const UnsignedShort templateID = thingTemplate->getTemplateID();
+	if (templateID >= s_templates.size())
+	{
+		s_templates.resize(templateID + 1);
+		s_templateNames.resize(templateID + 1);
+	}
+	if (s_templateNames[templateID].isEmpty())
+		s_templateNames[templateID] = thingTemplate->getName();
+	Stats &templateStats = s_templates[templateID];
+	templateStats.add(ticks);
+	templateStats.sleeps[bucket]++;
+}
+
+const AsciiString &UpdateProfiler::getModuleName(const UpdateModule *module)
+{
+	// KEYNAME searches the whole name table, remember what it found
+	const NameKeyType moduleKey = module->getModuleNameKey();
+	if (static_cast<size_t>(moduleKey) >= s_moduleNames.size())
+		s_moduleNames.resize(moduleKey + 1);
+	AsciiString &name = s_moduleNames[moduleKey];
+	if (name.isEmpty())
+		name = KEYNAME(moduleKey);
+	return name;
+}
+
+Bool UpdateProfiler::writeReport(const AsciiString &filename)
+{
+	std::vector<ReportLine> lines;
+
+	for (Int i = 0; i < SECTION_COUNT; ++i)
+	{
+		ReportLine line = { "section", TheSectionNames[i], &s_sections[i], s_sections[i].totalTicks };
+		lines.push_back(line);
+	}
+	if (s_moduleNames.size() < s_modules.size())
+		s_moduleNames.resize(s_modules.size());
+	for (size_t i = 0; i < s_modules.size(); ++i)
+	{
+		if (s_modules[i].calls == 0)
+			continue;
+		if (s_moduleNames[i].isEmpty())
+			s_moduleNames[i] = KEYNAME(static_cast<NameKeyType>(i));
+		ReportLine line = { "module", s_moduleNames[i].str(), &s_modules[i], s_modules[i].totalTicks };
+		lines.push_back(line);
+	}
+	for (size_t i = 0; i < s_templates.size(); ++i)
+	{
+		if (s_templates[i].calls == 0)
+			continue;
+		ReportLine line = { "template", s_templateNames[i].str(), &s_templates[i], s_templates[i].totalTicks };
+		lines.push_back(line);
+	}
+
+	std::stable_sort(lines.begin(), lines.end());
+
+	FILE *fp = fopen(filename.str(), "w");
+	if (fp == nullptr)
+		return false;
+
+	fprintf(fp, "kind,name,calls,total_ms,average_us,worst_us,logic_update_percent");
+	for (Int i = 0; i < SLEEP_BUCKET_COUNT; ++i)
+		fprintf(fp, ",sleep_%s", TheSleepBucketNames[i]);
+	fprintf(fp, "\n");
+
+	const Int64 logicTicks = s_sections[SECTION_LOGIC_UPDATE].totalTicks;
+	for (size_t i = 0; i < lines.size(); ++i)
+	{
+		const Stats &stats = *static_cast<const Stats *>(lines[i].stats);
+		fprintf(fp, "%s,\"%s\",%llu,%.3f,%.3f,%.3f,%.2f", lines[i].kind, lines[i].name,
+			(unsigned long long)stats.calls, ticksToMilliseconds(stats.totalTicks),
+			stats.calls ? ticksToMicroseconds(stats.totalTicks) / stats.calls : 0.0,
+			ticksToMicroseconds(stats.worstTicks),
+			logicTicks ? 100.0 * stats.totalTicks / logicTicks : 0.0);
+		for (Int bucket = 0; bucket < SLEEP_BUCKET_COUNT; ++bucket)
+			fprintf(fp, ",%u", stats.sleeps[bucket]);
+		fprintf(fp, "\n");
+	}
+
+	fclose(fp);
+	return true;
+}
+
+void UpdateProfiler::printSummary(Int maxLines)
+{
+	// Note that we use printf here because this is run from cmd.
+	const Stats &logic = s_sections[SECTION_LOGIC_UPDATE];
+	printf("Logic frames: %llu, total: %.1f ms, worst: %.3f ms\n", (unsigned long long)logic.calls,
+		ticksToMilliseconds(logic.totalTicks), ticksToMilliseconds(logic.worstTicks));
+	for (Int i = 1; i < SECTION_COUNT; ++i)
+	{
+		printf("  %-32s %10.1f ms, worst %8.3f ms\n", TheSectionNames[i],
+			ticksToMilliseconds(s_sections[i].totalTicks), ticksToMilliseconds(s_sections[i].worstTicks));
+	}
+
+	for (Int pass = 0; pass < 2; ++pass)
+	{
+		const std::vector<Stats> &allStats = pass == 0 ? s_modules : s_templates;
+		std::vector<ReportLine> lines;
+		for (size_t i = 0; i < allStats.size(); ++i)
+		{
+			if (allStats[i].calls == 0)
+				continue;
+			ReportLine line = { nullptr, nullptr, &allStats[i], allStats[i].totalTicks };
+			lines.push_back(line);
+		}
+		std::stable_sort(lines.begin(), lines.end());
+
+		printf("Most expensive %s:\n", pass == 0 ? "update modules" : "thing templates");
+		for (size_t i = 0; i < lines.size() && i < static_cast<size_t>(maxLines); ++i)
+		{
+			const Stats &stats = *static_cast<const Stats *>(lines[i].stats);
+			const size_t index = &stats - &allStats[0];
+			const AsciiString name = pass == 0 ? KEYNAME(static_cast<NameKeyType>(index)) : s_templateNames[index];
+			printf("  %-32s %10.1f ms, %10llu calls, worst %8.3f ms\n", name.str(),
+				ticksToMilliseconds(stats.totalTicks), (unsigned long long)stats.calls, ticksToMilliseconds(stats.worstTicks));
+		}
+	}
+	fflush(stdout);
+}
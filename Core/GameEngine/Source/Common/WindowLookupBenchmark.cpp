@@ -0,0 +1,261 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: WindowLookupBenchmark.cpp ////////////////////////////////////////////////////////////////
+// Measures the cost of finding windows by id and by position in the shell and in game layouts
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/WindowLookupBenchmark.h"
+
+#include "Common/FileSystem.h"
+#include "GameClient/Display.h"
+#include "GameClient/GameWindow.h"
+#include "GameClient/GameWindowManager.h"
+#include "GameClient/WindowLayout.h"
+
+#include <chrono>
+#include <set>
+#include <vector>
+
+namespace
+{
+// the menus of the shell and the windows of a running game
+const char *const TheBenchmarkLayouts[] =
+{
+	"Menus/MainMenu.wnd",
+	"Menus/OptionsMenu.wnd",
+	"Menus/KeyboardOptionsMenu.wnd",
+	"Menus/SkirmishGameOptionsMenu.wnd",
+	"Menus/LanLobbyMenu.wnd",
+	"Menus/LanGameOptionsMenu.wnd",
+	"Menus/ReplayMenu.wnd",
+	"Menus/SaveLoad.wnd",
+	"Menus/ScoreScreen.wnd",
+	"ControlBar.wnd",
+	"ControlBarPopupDescription.wnd",
+	"Diplomacy.wnd",
+	"GeneralsExpPoints.wnd",
+	"InGameChat.wnd",
+	"InGamePopupMessage.wnd",
+	"Menus/QuitMenu.wnd",
+	"Menus/DisconnectScreen.wnd",
+};
+
+enum
+{
+	POINTS_PER_ROUND = 1024
+};
+
+struct IdQuery
+{
+	GameWindow *start;
+	Int id;
+};
+
+struct HitResult
+{
+	GameWindow *enabledChild;
+	GameWindow *anyChild;
+};
+
+UnsignedInt nextRandom(UnsignedInt &seed)
+{
+	seed = seed * 1664525u + 1013904223u;
+	return seed >> 8;
+}
+
+void collectWindows(GameWindow *window, std::vector<GameWindow *> &windows)
+{
+	for (; window; window = window->winGetNext())
+	{
+		windows.push_back(window);
+		collectWindows(window->winGetChild(), windows);
+	}
+}
+
+void lookUpAll(const std::vector<IdQuery> &queries, std::vector<GameWindow *> &results)
+{
+	results.resize(queries.size());
+	for (size_t i = 0; i < queries.size(); ++i)
+		results[i] = TheWindowManager->winGetWindowFromId(queries[i].start, queries[i].id);
+}
+
+// the same searches GameWindowManager::findWindowUnderMouse makes, on every top level window
+void hitTestAll(const std::vector<ICoord2D> &points, std::vector<HitResult> &results)
+{
+	results.resize(points.size());
+	for (size_t i = 0; i < points.size(); ++i)
+	{
+		const Int x = points[i].x;
+		const Int y = points[i].y;
+		HitResult &result = results[i];
+		result.enabledChild = nullptr;
+		result.anyChild = nullptr;
+		for (GameWindow *window = TheWindowManager->winGetWindowList(); window; window = window->winGetNext())
+		{
+			if (window->winIsHidden() || !window->winPointInWindow(x, y))
+				continue;
+
+			result.anyChild = window->winPointInAnyChild(x, y, TRUE, TRUE);
+			result.enabledChild = window->winPointInChild(x, y);
+			break;
+		}
+	}
+}
+
+double getMilliseconds(const std::chrono::steady_clock::time_point &start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
+int WindowLookupBenchmark::benchmarkLookups(Int rounds)
+{
+	// Note that we use printf here because this is run from cmd.
+	std::vector<WindowLayout *> layouts;
+	for (size_t i = 0; i < ARRAY_SIZE(TheBenchmarkLayouts); ++i)
+	{
+		AsciiString path;
+		path.format("Window\\%s", TheBenchmarkLayouts[i]);
+		if (!TheFileSystem->doesFileExist(path.str()))
+		{
+			printf("Skipping %s, it is not in this game\n", TheBenchmarkLayouts[i]);
+			continue;
+		}
+
+		WindowLayout *layout = TheWindowManager->winCreateLayout(TheBenchmarkLayouts[i]);
+		if (layout == nullptr)
+			continue;
+
+		layout->hide(FALSE);
+		layouts.push_back(layout);
+	}
+
+	std::vector<GameWindow *> windows;
+	collectWindows(TheWindowManager->winGetWindowList(), windows);
+
+	// every window by id from the top of the window list and from the top window of its layout,
+	// plus as many ids no window has
+	std::vector<IdQuery> queries;
+	std::set<Int> ids;
+	for (size_t i = 0; i < windows.size(); ++i)
+		ids.insert(windows[i]->winGetWindowId());
+	for (size_t i = 0; i < windows.size(); ++i)
+	{
+		GameWindow *root = windows[i];
+		while (root->winGetParent())
+			root = root->winGetParent();
+
+		IdQuery query;
+		query.start = nullptr;
+		query.id = windows[i]->winGetWindowId();
+		queries.push_back(query);
+		query.start = root;
+		queries.push_back(query);
+	}
+	UnsignedInt seed = 0x5eed;
+	const size_t hits = queries.size();
+	for (size_t i = 0; i < windows.size(); ++i)
+	{
+		IdQuery query;
+		query.start = nullptr;
+		do
+		{
+			query.id = (Int)nextRandom(seed);
+		} while (ids.count(query.id) != 0);
+		queries.push_back(query);
+	}
+
+	std::vector<ICoord2D> points(POINTS_PER_ROUND);
+	const Int width = TheDisplay ? (Int)TheDisplay->getWidth() : 800;
+	const Int height = TheDisplay ? (Int)TheDisplay->getHeight() : 600;
+	for (size_t i = 0; i < points.size(); ++i)
+	{
+		points[i].x = (Int)(nextRandom(seed) % width);
+		points[i].y = (Int)(nextRandom(seed) % height);
+	}
+
+	printf("Loaded %d layouts with %d windows, looking up %d ids and hit testing %d points %d times\n",
+		(Int)layouts.size(), (Int)windows.size(), (Int)queries.size(), (Int)points.size(), rounds);
+	fflush(stdout);
+
+	// the full searches give the reference results, the first pass in each mode also warms it up
+	std::vector<GameWindow *> treeLookups, registryLookups;
+	std::vector<HitResult> listHits, gridHits;
+
+	TheWindowManager->setLookupAccelerationEnabled(FALSE);
+	lookUpAll(queries, treeLookups);
+	hitTestAll(points, listHits);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (Int round = 0; round < rounds; ++round)
+		lookUpAll(queries, treeLookups);
+	const double treeLookupTime = getMilliseconds(start);
+
+	start = std::chrono::steady_clock::now();
+	for (Int round = 0; round < rounds; ++round)
+		hitTestAll(points, listHits);
+	const double listHitTime = getMilliseconds(start);
+
+	TheWindowManager->setLookupAccelerationEnabled(TRUE);
+	lookUpAll(queries, registryLookups);
+	hitTestAll(points, gridHits);
+
+	Int mismatches = 0;
+	for (size_t i = 0; i < queries.size(); ++i)
+	{
+		if (registryLookups[i] != treeLookups[i])
+			++mismatches;
+	}
+	for (size_t i = 0; i < points.size(); ++i)
+	{
+		if (gridHits[i].enabledChild != listHits[i].enabledChild || gridHits[i].anyChild != listHits[i].anyChild)
+			++mismatches;
+	}
+
+	start = std::chrono::steady_clock::now();
+	for (Int round = 0; round < rounds; ++round)
+		lookUpAll(queries, registryLookups);
+	const double registryLookupTime = getMilliseconds(start);
+
+	start = std::chrono::steady_clock::now();
+	for (Int round = 0; round < rounds; ++round)
+		hitTestAll(points, gridHits);
+	const double gridHitTime = getMilliseconds(start);
+
+	const double lookups = (double)queries.size() * rounds;
+	const double hitTests = (double)points.size() * rounds;
+	printf("Id lookups (%d hits, %d misses): tree %.1f ms, registry %.1f ms, %.3f us vs %.3f us per lookup\n",
+		(Int)hits, (Int)(queries.size() - hits), treeLookupTime, registryLookupTime,
+		lookups > 0 ? treeLookupTime * 1000.0 / lookups : 0.0, lookups > 0 ? registryLookupTime * 1000.0 / lookups : 0.0);
+	printf("Hit tests: child lists %.1f ms, hit grids %.1f ms, %.3f us vs %.3f us per point\n",
+		listHitTime, gridHitTime,
+		hitTests > 0 ? listHitTime * 1000.0 / hitTests : 0.0, hitTests > 0 ? gridHitTime * 1000.0 / hitTests : 0.0);
+	printf("Results %s\n", mismatches == 0 ? "match" : "DO NOT MATCH");
+	fflush(stdout);
+
+	for (size_t i = 0; i < layouts.size(); ++i)
+	{
+		layouts[i]->destroyWindows();
+		deleteInstance(layouts[i]);
+	}
+
+	return mismatches == 0 ? 0 : 1;
+}
@@ -318,6 +318,16 @@ Display::DebugDisplayCallback *Display::getDebugDisplayCallback()
 	return m_debugDisplayCallback;
 }
 
+//============================================================================
+// Display::benchmarkShadowSilhouettes
+//============================================================================
+
+Int Display::benchmarkShadowSilhouettes( Int rounds )
+{
+	DEBUG_CRASH(("implement ME"));
+	return 1;
+}
+
 void Display::beginBatch()
 {
 	if (m_isBatching)
@@ -0,0 +1,244 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: DrawableGrid.cpp /////////////////////////////////////////////////////////////////////////
+// Uniform grid of the client drawables for region queries
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "GameClient/DrawableGrid.h"
+#include "GameClient/Drawable.h"
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+DrawableGrid::DrawableGrid()
+{
+	m_queryStamp = 0;
+	m_nextOrder = 0;
+	m_count = 0;
+	m_lowestZ = 0.0f;
+	m_highestZ = 0.0f;
+
+	for( Int i = 0; i < BUCKET_COUNT; ++i )
+		m_bucketQueryStamp[ i ] = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Forget all drawables, the caller is destroying them */
+// ------------------------------------------------------------------------------------------------
+void DrawableGrid::reset()
+{
+	for( Int i = 0; i < BUCKET_COUNT; ++i )
+	{
+		m_buckets[ i ].clear();
+		m_bucketQueryStamp[ i ] = 0;
+	}
+
+	m_queryStamp = 0;
+	m_nextOrder = 0;
+	m_count = 0;
+	m_lowestZ = 0.0f;
+	m_highestZ = 0.0f;
+	m_queryResult.clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+Int DrawableGrid::getCellCoord( Real value )
+{
+	// keep bad positions from overflowing the integer conversion
+	constexpr const Real maxCoord = 1000000.0f;
+	if( !(value > -maxCoord) )
+		value = -maxCoord;
+	else if( value > maxCoord )
+		value = maxCoord;
+
+	return REAL_TO_INT_FLOOR( value / CELL_SIZE );
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+Int DrawableGrid::getBucket( Int cellX, Int cellY )
+{
+	return (cellX & (BUCKET_DIM - 1)) | ((cellY & (BUCKET_DIM - 1)) << BUCKET_BITS);
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+Int DrawableGrid::getBucketForPosition( const Coord3D *pos )
+{
+	return getBucket( getCellCoord( pos->x ), getCellCoord( pos->y ) );
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void DrawableGrid::trackHeight( Real z )
+{
+	if( m_count == 1 )
+	{
+		m_lowestZ = z;
+		m_highestZ = z;
+	}
+	else if( z < m_lowestZ )
+		m_lowestZ = z;
+	else if( z > m_highestZ )
+		m_highestZ = z;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void DrawableGrid::insertIntoBucket( Drawable *draw, Int bucket )
+{
+	DrawableGridInfo *info = draw->friend_getGridInfo();
+
+	std::vector<Drawable *> &list = m_buckets[ bucket ];
+	info->m_bucket = bucket;
+	info->m_slot = (Int)list.size();
+	list.push_back( draw );
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void DrawableGrid::removeFromBucket( Drawable *draw )
+{
+	DrawableGridInfo *info = draw->friend_getGridInfo();
+
+	std::vector<Drawable *> &list = m_buckets[ info->m_bucket ];
+	DEBUG_ASSERTCRASH( info->m_slot < (Int)list.size() && list[ info->m_slot ] == draw, ("DrawableGrid bucket is out of sync") );
+
+	// move the last drawable of the bucket into the hole
+	Drawable *last = list.back();
+	list[ info->m_slot ] = last;
+	last->friend_getGridInfo()->m_slot = info->m_slot;
+	list.pop_back();
+
+	info->m_bucket = -1;
+	info->m_slot = -1;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void DrawableGrid::addDrawable( Drawable *draw )
+{
+	DrawableGridInfo *info = draw->friend_getGridInfo();
+	if( info->m_bucket != -1 )
+		return;
+
+	// drawables are prepended to the drawable list, so newer drawables come first
+	info->m_order = ++m_nextOrder;
+
+	++m_count;
+	insertIntoBucket( draw, getBucketForPosition( draw->getPosition() ) );
+	trackHeight( draw->getPosition()->z );
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void DrawableGrid::removeDrawable( Drawable *draw )
+{
+	if( draw->friend_getGridInfo()->m_bucket == -1 )
+		return;
+
+	removeFromBucket( draw );
+	--m_count;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void DrawableGrid::updateDrawable( Drawable *draw )
+{
+	DrawableGridInfo *info = draw->friend_getGridInfo();
+	if( info->m_bucket == -1 )
+		return;
+
+	const Coord3D *pos = draw->getPosition();
+	trackHeight( pos->z );
+
+	Int bucket = getBucketForPosition( pos );
+	if( bucket == info->m_bucket )
+		return;
+
+	removeFromBucket( draw );
+	insertIntoBucket( draw, bucket );
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+static Bool orderedDrawableIsNewer( const std::pair<UnsignedInt, Drawable *> &a, const std::pair<UnsignedInt, Drawable *> &b )
+{
+	return a.first > b.first;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+Bool DrawableGrid::collectDrawablesInBox( Real loX, Real loY, Real hiX, Real hiY, std::vector<DrawableID> &result )
+{
+	result.clear();
+
+	if( !(loX <= hiX && loY <= hiY) )
+		return TRUE;
+
+	Int cellLoX = getCellCoord( loX );
+	Int cellLoY = getCellCoord( loY );
+	Int cellHiX = getCellCoord( hiX );
+	Int cellHiY = getCellCoord( hiY );
+
+	Int cellsX = cellHiX - cellLoX + 1;
+	Int cellsY = cellHiY - cellLoY + 1;
+	if( cellsX > MAX_QUERY_CELLS || cellsY > MAX_QUERY_CELLS || cellsX * cellsY > MAX_QUERY_CELLS )
+		return FALSE;
+
+	// far apart cells can share a bucket, only visit each bucket once
+	if( ++m_queryStamp == 0 )
+	{
+		for( Int i = 0; i < BUCKET_COUNT; ++i )
+			m_bucketQueryStamp[ i ] = 0;
+		m_queryStamp = 1;
+	}
+
+	m_queryResult.clear();
+	for( Int cellY = cellLoY; cellY <= cellHiY; ++cellY )
+	{
+		for( Int cellX = cellLoX; cellX <= cellHiX; ++cellX )
+		{
+			Int bucket = getBucket( cellX, cellY );
+			if( m_bucketQueryStamp[ bucket ] == m_queryStamp )
+				continue;
+			m_bucketQueryStamp[ bucket ] = m_queryStamp;
+
+			const std::vector<Drawable *> &list = m_buckets[ bucket ];
+			for( size_t i = 0; i < list.size(); ++i )
+			{
+				Drawable *draw = list[ i ];
+				const Coord3D *pos = draw->getPosition();
+				if( pos->x >= loX && pos->x <= hiX && pos->y >= loY && pos->y <= hiY )
+					m_queryResult.push_back( OrderedDrawable( draw->friend_getGridInfo()->m_order, draw ) );
+			}
+		}
+	}
+
+	// hand them back in the same order as the drawable list
+	std::sort( m_queryResult.begin(), m_queryResult.end(), orderedDrawableIsNewer );
+
+	result.reserve( m_queryResult.size() );
+	for( size_t i = 0; i < m_queryResult.size(); ++i )
+		result.push_back( m_queryResult[ i ].second->getID() );
+
+	return TRUE;
+}
@@ -110,6 +110,7 @@ GameWindow::GameWindow()
 	m_prev = nullptr;
 	m_parent = nullptr;
 	m_child = nullptr;
+	m_childHitGrid = nullptr;
 
 	m_nextLayout = nullptr;
 	m_prevLayout = nullptr;
@@ -130,6 +131,9 @@ GameWindow::~GameWindow()
 	delete m_editData;
 	m_editData = nullptr;
 
+	delete m_childHitGrid;
+	m_childHitGrid = nullptr;
+
 	unlinkFromTransitionWindows();
 
 }
@@ -200,6 +204,41 @@ void GameWindow::normalizeWindowRegion()
 
 	}
 
+	// every change of our region ends here
+	parentLayoutChanged();
+
+}
+
+// GameWindow::childLayoutChanged =============================================
+/** One of our children was moved, resized, added or removed, sort them
+	* again on the next hit test */
+//=============================================================================
+void GameWindow::childLayoutChanged()
+{
+
+	if( m_childHitGrid )
+		m_childHitGrid->invalidate();
+
+}
+
+// GameWindow::getChildHitCandidates ==========================================
+/** Return the children that may hold the point, x and y are relative to
+	* our origin */
+//=============================================================================
+GameWindowHitGrid::Iterator GameWindow::getChildHitCandidates( Int x, Int y )
+{
+
+	if( m_child == nullptr || GameWindowHitGrid::isEnabled() == FALSE )
+		return GameWindowHitGrid::Iterator( m_child );
+
+	if( m_childHitGrid == nullptr )
+		m_childHitGrid = NEW GameWindowHitGrid;
+
+	if( m_childHitGrid->isValid() == FALSE )
+		m_childHitGrid->build( m_child );
+
+	return m_childHitGrid->getCandidates( x, y );
+
 }
 
 // GameWindow::findFirstLeaf ==================================================
@@ -644,6 +683,8 @@ Int GameWindow::winSetSize( Int width, Int height )
 	m_region.hi.x = m_region.lo.x + width;
 	m_region.hi.y = m_region.lo.y + height;
 
+	parentLayoutChanged();
+
 	TheWindowManager->winSendSystemMsg( this,
 																			GGM_RESIZED,
 																			(WindowMsgData)width,
@@ -1056,6 +1097,7 @@ Color GameWindow::winGetHiliteTextBorderColor()
 Int GameWindow::winSetInstanceData( WinInstanceData *data )
 {
 	DisplayString *text, *tooltipText;
+	Int oldId = m_instData.m_id;
 
 	// save our own instance of text and tooltip text display strings
 	text = m_instData.m_text;
@@ -1079,6 +1121,8 @@ Int GameWindow::winSetInstanceData( WinInstanceData *data )
 	if( data->getTooltipTextLength() )
 		m_instData.setTooltipText( data->getTooltipText() );
 
+	TheWindowManager->winIdChanged( this, oldId );
+
 	return WIN_ERR_OK;
 
 }
@@ -1128,8 +1172,10 @@ void GameWindow::winSetTooltip( UnicodeString tip )
 //=============================================================================
 Int GameWindow::winSetWindowId( Int id )
 {
+	Int oldId = m_instData.m_id;
 
 	m_instData.m_id = id;
+	TheWindowManager->winIdChanged( this, oldId );
 
 	return WIN_ERR_OK;
 
@@ -1255,6 +1301,7 @@ void GameWindow::winSetNext( GameWindow *next )
 {
 
 	m_next = next;
+	parentLayoutChanged();
 
 }
 
@@ -1275,6 +1322,7 @@ void GameWindow::winSetPrev( GameWindow *prev )
 {
 
 	m_prev = prev;
+	parentLayoutChanged();
 
 }
 
@@ -1428,24 +1476,19 @@ Int GameWindow::winDrawWindow()
 //=============================================================================
 GameWindow *GameWindow::winPointInChild( Int x, Int y, Bool ignoreEnableCheck, Bool playDisabledSound )
 {
-	GameWindow *parent;
 	GameWindow *child;
+	ICoord2D parentOrigin;
 	ICoord2D origin;
 
-	for( child = m_child; child; child = child->m_next )
-	{
-
-		origin = child->m_region.lo;
-		parent = child->winGetParent();
+	// children are placed relative to our own screen position
+	winGetScreenPosition( &parentOrigin.x, &parentOrigin.y );
 
-		while( parent )
-		{
+	GameWindowHitGrid::Iterator it = getChildHitCandidates( x - parentOrigin.x, y - parentOrigin.y );
+	for( ; (child = it.get()) != nullptr; it.next() )
+	{
 
-			origin.x += parent->m_region.lo.x;
-			origin.y += parent->m_region.lo.y;
-			parent = parent->m_parent;
-
-		}
+		origin.x = child->m_region.lo.x + parentOrigin.x;
+		origin.y = child->m_region.lo.y + parentOrigin.y;
 
 		if( x >= origin.x && x <= origin.x + child->m_size.x &&
 				y >= origin.y && y <= origin.y + child->m_size.y )
@@ -1482,24 +1525,19 @@ GameWindow *GameWindow::winPointInChild( Int x, Int y, Bool ignoreEnableCheck, B
 //=============================================================================
 GameWindow *GameWindow::winPointInAnyChild( Int x, Int y, Bool ignoreHidden, Bool ignoreEnableCheck )
 {
-	GameWindow *parent;
 	GameWindow *child;
+	ICoord2D parentOrigin;
 	ICoord2D origin;
 
-	for( child = m_child; child; child = child->m_next )
-	{
-
-		origin = child->m_region.lo;
-		parent = child->m_parent;
+	// children are placed relative to our own screen position
+	winGetScreenPosition( &parentOrigin.x, &parentOrigin.y );
 
-		while( parent )
-		{
-
-			origin.x += parent->m_region.lo.x;
-			origin.y += parent->m_region.lo.y;
-			parent = parent->m_parent;
+	GameWindowHitGrid::Iterator it = getChildHitCandidates( x - parentOrigin.x, y - parentOrigin.y );
+	for( ; (child = it.get()) != nullptr; it.next() )
+	{
 
-		}
+		origin.x = child->m_region.lo.x + parentOrigin.x;
+		origin.y = child->m_region.lo.y + parentOrigin.y;
 
 		if( x >= origin.x && x <= origin.x + child->m_size.x &&
 				y >= origin.y && y <= origin.y + child->m_size.y )
@@ -0,0 +1,167 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: GameWindowHitGrid.cpp ////////////////////////////////////////////////////////////////////
+// Grid of the child windows of a window, for finding the child under the mouse
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "GameClient/GameWindowHitGrid.h"
+
+#include "GameClient/GameWindow.h"
+
+Bool GameWindowHitGrid::s_isEnabled = TRUE;
+
+namespace
+{
+struct ChildRect
+{
+	Int loX;
+	Int loY;
+	Int hiX;
+	Int hiY;
+};
+} // namespace
+
+GameWindowHitGrid::Iterator::Iterator(GameWindow *firstChild) :
+	m_window(firstChild),
+	m_candidates(nullptr),
+	m_count(0),
+	m_index(0)
+{
+}
+
+GameWindowHitGrid::Iterator::Iterator(GameWindow *const *candidates, Int count) :
+	m_window(count > 0 ? candidates[0] : nullptr),
+	m_candidates(candidates),
+	m_count(count),
+	m_index(0)
+{
+}
+
+void GameWindowHitGrid::Iterator::next()
+{
+	if (m_candidates == nullptr)
+	{
+		m_window = m_window->winGetNext();
+		return;
+	}
+
+	++m_index;
+	m_window = m_index < m_count ? m_candidates[m_index] : nullptr;
+}
+
+GameWindowHitGrid::GameWindowHitGrid() :
+	m_isValid(FALSE),
+	m_minX(0),
+	m_minY(0),
+	m_maxX(-1),
+	m_maxY(-1),
+	m_cellShift(0),
+	m_cellsX(0),
+	m_cellsY(0)
+{
+}
+
+void GameWindowHitGrid::build(GameWindow *firstChild)
+{
+	std::vector<GameWindow *> children;
+	std::vector<ChildRect> rects;
+
+	// the region of a child holds the points from its position up to its position plus its size,
+	// both included, the same test GameWindow::winPointInChild makes
+	for (GameWindow *child = firstChild; child; child = child->winGetNext())
+	{
+		ChildRect rect;
+		Int width, height;
+		child->winGetPosition(&rect.loX, &rect.loY);
+		child->winGetSize(&width, &height);
+		if (width < 0 || height < 0)
+			continue;
+
+		rect.hiX = rect.loX + width;
+		rect.hiY = rect.loY + height;
+		children.push_back(child);
+		rects.push_back(rect);
+	}
+
+	m_isValid = TRUE;
+	m_cellStart.clear();
+	m_cellChildren.clear();
+	m_cellsX = 0;
+	m_cellsY = 0;
+	if (children.empty())
+		return;
+
+	m_minX = rects[0].loX;
+	m_minY = rects[0].loY;
+	m_maxX = rects[0].hiX;
+	m_maxY = rects[0].hiY;
+	for (size_t i = 1; i < rects.size(); ++i)
+	{
+		m_minX = MIN(m_minX, rects[i].loX);
+		m_minY = MIN(m_minY, rects[i].loY);
+		m_maxX = MAX(m_maxX, rects[i].hiX);
+		m_maxY = MAX(m_maxY, rects[i].hiY);
+	}
+
+	// a few children are cheaper to test than to sort, they only get the bounds check
+	const Int maxCells = (Int)children.size() < MIN_GRID_CHILDREN ? 1 : MAX_CELLS_PER_AXIS;
+	m_cellShift = 0;
+	while (((m_maxX - m_minX) >> m_cellShift) >= maxCells || ((m_maxY - m_minY) >> m_cellShift) >= maxCells)
+		++m_cellShift;
+	m_cellsX = ((m_maxX - m_minX) >> m_cellShift) + 1;
+	m_cellsY = ((m_maxY - m_minY) >> m_cellShift) + 1;
+
+	// count the children of each cell, then place them in list order
+	m_cellStart.assign(m_cellsX * m_cellsY + 1, 0);
+	for (size_t i = 0; i < rects.size(); ++i)
+	{
+		const ChildRect &rect = rects[i];
+		for (Int cellY = (rect.loY - m_minY) >> m_cellShift; cellY <= (rect.hiY - m_minY) >> m_cellShift; ++cellY)
+		{
+			for (Int cellX = (rect.loX - m_minX) >> m_cellShift; cellX <= (rect.hiX - m_minX) >> m_cellShift; ++cellX)
+				++m_cellStart[cellY * m_cellsX + cellX + 1];
+		}
+	}
+	for (size_t cell = 1; cell < m_cellStart.size(); ++cell)
+		m_cellStart[cell] += m_cellStart[cell - 1];
+
+	std::vector<Int> cellEnd(m_cellStart.begin(), m_cellStart.end() - 1);
+	m_cellChildren.resize(m_cellStart.back());
+	for (size_t i = 0; i < rects.size(); ++i)
+	{
+		const ChildRect &rect = rects[i];
+		for (Int cellY = (rect.loY - m_minY) >> m_cellShift; cellY <= (rect.hiY - m_minY) >> m_cellShift; ++cellY)
+		{
+			for (Int cellX = (rect.loX - m_minX) >> m_cellShift; cellX <= (rect.hiX - m_minX) >> m_cellShift; ++cellX)
+				m_cellChildren[cellEnd[cellY * m_cellsX + cellX]++] = children[i];
+		}
+	}
+}
+
+GameWindowHitGrid::Iterator GameWindowHitGrid::getCandidates(Int x, Int y) const
+{
+	if (m_cellsX == 0 || x < m_minX || x > m_maxX || y < m_minY || y > m_maxY)
+		return Iterator(nullptr, 0);
+
+	const Int cell = ((y - m_minY) >> m_cellShift) * m_cellsX + ((x - m_minX) >> m_cellShift);
+	const Int start = m_cellStart[cell];
+	return Iterator(m_cellChildren.data() + start, m_cellStart[cell + 1] - start);
+}
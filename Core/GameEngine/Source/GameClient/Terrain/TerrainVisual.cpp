@@ -98,6 +98,13 @@ Bool TerrainVisual::load( AsciiString filename )
 
 }
 
+//-------------------------------------------------------------------------------------------------
+Bool TerrainVisual::benchmarkWaterGrid( Int steps )
+{
+	DEBUG_CRASH(("implement ME"));
+	return false;
+}
+
 // ------------------------------------------------------------------------------------------------
 /** CRC */
 // ------------------------------------------------------------------------------------------------
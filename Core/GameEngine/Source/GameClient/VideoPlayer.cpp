@@ -279,6 +279,16 @@ void	VideoPlayer::closeAllStreams()
 	}
 }
 
+//============================================================================
+// VideoPlayer::benchmarkPlayback
+//============================================================================
+
+Int VideoPlayer::benchmarkPlayback( Int frames )
+{
+	DEBUG_CRASH(("implement ME"));
+	return 1;
+}
+
 //============================================================================
 // VideoPlayer::remove
 //============================================================================
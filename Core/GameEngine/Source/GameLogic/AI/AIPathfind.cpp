@@ -73,6 +73,12 @@
 //------------------------------------------------------------------------------ Performance Timers
 #include "Common/PerfMetrics.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 //-------------------------------------------------------------------------------------------------
 
 
@@ -2313,7 +2319,143 @@ static void __fastcall resolveZones(Int srcZone, Int targetZone, zoneStorageType
 	}
 }
 
-static void flattenZones(zoneStorageType *zoneArray, zoneStorageType *zoneHierarchical, Int sizeOfZones)
+inline void applyZone(PathfindCell &targetCell, const PathfindCell &sourceCell, zoneStorageType *zoneEquivalency, Int sizeOfZE)
+{
+	DEBUG_ASSERTCRASH(sourceCell.getZone()!=0, ("Unset source zone."));
+	Int srcZone = zoneEquivalency[sourceCell.getZone()];
+	Int targetZone = zoneEquivalency[targetCell.getZone()];
+
+	if (targetZone == 0) {
+		targetCell.setZone(srcZone);
+		return;
+	}
+	if (targetZone == srcZone) {
+		return; // already match.
+	}
+	resolveZones(srcZone, targetZone, zoneEquivalency, sizeOfZE);
+
+}
+
+inline void applyBlockZone(PathfindCell &targetCell, const PathfindCell &sourceCell,
+													 zoneStorageType *zoneEquivalency, Int firstZone, Int sizeOfZE)
+{
+	DEBUG_ASSERTCRASH(sourceCell.getZone()>=firstZone && sourceCell.getZone()<firstZone+sizeOfZE, ("Memory overrun - FATAL ERROR."));
+	Int srcZone = zoneEquivalency[sourceCell.getZone()-firstZone];
+	DEBUG_ASSERTCRASH(targetCell.getZone()>=firstZone && sourceCell.getZone()<firstZone+sizeOfZE, ("Memory overrun - FATAL ERROR."));
+	Int targetZone = zoneEquivalency[targetCell.getZone()-firstZone];
+	if (targetZone == srcZone) {
+		return; // already match.
+	}
+	resolveBlockZones(srcZone, targetZone, zoneEquivalency, sizeOfZE);
+
+}
+
+// GeneralsX @performance 18/10/2026 resolveZones() rewrites the whole equivalency array on every
+// merge, which made the zone calculation quadratic in the number of zones. ZoneEquivalency gives the
+// same results: the entries holding the same zone are kept in one group of a union find, so a merge
+// only links the groups of the two zones and the zone they both become.
+class ZoneEquivalency
+{
+public:
+	ZoneEquivalency() : m_zones(nullptr), m_size(0) {}
+
+	/// Takes over the first size entries of the array until end() writes them back.
+	void begin(zoneStorageType *zones, Int size)
+	{
+		m_zones = zones;
+		m_size = size;
+		m_parent.resize(size);
+		m_zone.resize(size);
+		m_groupOfZone.assign(size, -1);
+		for (Int i=0; i<size; i++) {
+			Int zone = zones[i];
+			DEBUG_ASSERTCRASH(zone<size, ("Bad zone equivalency."));
+			if (m_groupOfZone[zone] < 0) {
+				m_groupOfZone[zone] = i;
+				m_parent[i] = i;
+				m_zone[i] = zone;
+			} else {
+				m_parent[i] = m_groupOfZone[zone];
+			}
+		}
+	}
+
+	void end()
+	{
+		for (Int i=0; i<m_size; i++) {
+			m_zones[i] = get(i);
+		}
+	}
+
+	zoneStorageType get(Int ndx)
+	{
+		return m_zone[findGroup(ndx)];
+	}
+
+	/// Same as resolveZones(srcZone, targetZone, zones, size).
+	void resolve(Int srcZone, Int targetZone)
+	{
+		DEBUG_ASSERTCRASH(srcZone!=0 && targetZone!=0,  ("Bad resolve zones	."));
+		srcZone = get(srcZone);
+		targetZone = get(targetZone);
+		zoneStorageType finalZone = get(targetZone<srcZone ? targetZone : srcZone);
+		Int group = findGroup(m_groupOfZone[finalZone]);
+		group = mergeGroup(group, srcZone, finalZone);
+		group = mergeGroup(group, targetZone, finalZone);
+		m_groupOfZone[finalZone] = group;
+		m_zone[group] = finalZone;
+	}
+
+private:
+	Int findGroup(Int ndx)
+	{
+		while (m_parent[ndx] != ndx) {
+			m_parent[ndx] = m_parent[m_parent[ndx]];
+			ndx = m_parent[ndx];
+		}
+		return ndx;
+	}
+
+	Int mergeGroup(Int group, Int zone, Int finalZone)
+	{
+		if (zone == finalZone || m_groupOfZone[zone] < 0) {
+			return group; // already in the final group.
+		}
+		Int other = findGroup(m_groupOfZone[zone]);
+		m_groupOfZone[zone] = -1;
+		if (other < group) {
+			m_parent[group] = other;
+			return other;
+		}
+		m_parent[other] = group;
+		return group;
+	}
+
+	zoneStorageType *m_zones;
+	Int m_size;
+	std::vector<Int> m_parent;
+	std::vector<zoneStorageType> m_zone;				///< zone of the group, for the group roots
+	std::vector<Int> m_groupOfZone;					///< an entry of the group holding the zone, -1 if no entry holds it
+};
+
+// The equivalency array resolved in place by resolveZones(), the way the original calculation does it.
+class ZoneArray
+{
+public:
+	ZoneArray() : m_zones(nullptr), m_size(0) {}
+
+	void begin(zoneStorageType *zones, Int size) {m_zones = zones; m_size = size;}
+	void end() {}
+	zoneStorageType get(Int ndx) {return m_zones[ndx];}
+	void resolve(Int srcZone, Int targetZone) {resolveZones(srcZone, targetZone, m_zones, m_size);}
+
+private:
+	zoneStorageType *m_zones;
+	Int m_size;
+};
+
+template <class Equivalency>
+static void flattenZones(zoneStorageType *zoneArray, zoneStorageType *zoneHierarchical, Int sizeOfZones, Equivalency &equivalency)
 {
 	Int i;
 	for (i=0; i<sizeOfZones; i++) {
@@ -2323,23 +2465,24 @@ static void flattenZones(zoneStorageType *zoneArray, zoneStorageType *zoneHierar
 		zone2 = zoneHierarchical[zone1];
 		zoneArray[i] = zone2;
 	}
-#if 1
 
+	equivalency.begin(zoneArray, sizeOfZones);
 	for (i=0; i<sizeOfZones; i++) {
-		Int zone1 = zoneArray[i];
+		Int zone1 = equivalency.get(i);
 		Int zone2 = zoneHierarchical[i];
 		if (zone1!=zone2) {
-			resolveZones(zone1, zone2, zoneArray, sizeOfZones);
+			equivalency.resolve(zone1, zone2);
 		}
 	}
-#endif
+	equivalency.end();
 }
 
-inline void applyZone(PathfindCell &targetCell, const PathfindCell &sourceCell, zoneStorageType *zoneEquivalency, Int sizeOfZE)
+template <class Equivalency>
+inline void applyZone(PathfindCell &targetCell, const PathfindCell &sourceCell, Equivalency &equivalency)
 {
 	DEBUG_ASSERTCRASH(sourceCell.getZone()!=0, ("Unset source zone."));
-	Int srcZone = zoneEquivalency[sourceCell.getZone()];
-	Int targetZone = zoneEquivalency[targetCell.getZone()];
+	Int srcZone = equivalency.get(sourceCell.getZone());
+	Int targetZone = equivalency.get(targetCell.getZone());
 
 	if (targetZone == 0) {
 		targetCell.setZone(srcZone);
@@ -2348,24 +2491,297 @@ inline void applyZone(PathfindCell &targetCell, const PathfindCell &sourceCell,
 	if (targetZone == srcZone) {
 		return; // already match.
 	}
-	resolveZones(srcZone, targetZone, zoneEquivalency, sizeOfZE);
+	equivalency.resolve(srcZone, targetZone);
+}
+
+// The zone equivalencies between neighbouring cells of different blocks, for the whole map.
+template <class Equivalency>
+static void resolveCellEquivalencies(PathfindCell **map, PathfindLayer layers[], const IRegion2D &globalBounds,
+	Equivalency &hierarchicalZones, Equivalency &groundWaterZones, Equivalency &groundRubbleZones,
+	Equivalency &groundCliffZones, Equivalency &terrainZones, Equivalency &crusherZones)
+{
+	Int i, j;
+	for( j=globalBounds.lo.y; j<=globalBounds.hi.y; j++ ) {
+		for( i=globalBounds.lo.x; i<=globalBounds.hi.x; i++ ) {
+			PathfindCell &r_thisCell = map[i][j];
+
+			if ( (r_thisCell.getConnectLayer() > LAYER_GROUND) &&
+				(r_thisCell.getType() == PathfindCell::CELL_CLEAR) ) {
+				PathfindLayer *layer = layers + r_thisCell.getConnectLayer();
+				hierarchicalZones.resolve(r_thisCell.getZone(), layer->getZone());
+			}
+
+			if ( i > globalBounds.lo.x && r_thisCell.getZone() != map[i-1][j].getZone() ) {
+				const PathfindCell &r_leftCell = map[i-1][j];
+
+#if RTS_GENERALS && RETAIL_COMPATIBLE_PATHFINDING
+				if (r_thisCell.getType() == r_leftCell.getType()) {
+					applyZone(r_thisCell, r_leftCell, hierarchicalZones);
+				}
+				if (waterGround(r_thisCell, r_leftCell)) {
+					applyZone(r_thisCell, r_leftCell, groundWaterZones);
+				}
+				if (groundRubble(r_thisCell, r_leftCell)) {
+					applyZone(r_thisCell, r_leftCell, groundRubbleZones);
+				}
+				if (groundCliff(r_thisCell, r_leftCell)) {
+					applyZone(r_thisCell, r_leftCell, groundCliffZones);
+				}
+				if (terrain(r_thisCell, r_leftCell)) {
+					applyZone(r_thisCell, r_leftCell, terrainZones);
+				}
+				if (crusherGround(r_thisCell, r_leftCell)) {
+					applyZone(r_thisCell, r_leftCell, crusherZones);
+				}
+#else
+				//if this is true, skip all the ones below
+				if (r_thisCell.getType() == r_leftCell.getType())
+					applyZone(r_thisCell, r_leftCell, hierarchicalZones);
+				else {
+					Bool notTerrainOrCrusher = TRUE; // if this is false, skip the if-else-ladder below
+
+					if (terrain(r_thisCell, r_leftCell)) {
+						applyZone(r_thisCell, r_leftCell, terrainZones);
+						notTerrainOrCrusher = FALSE;
+					}
+
+					if (crusherGround(r_thisCell, r_leftCell)) {
+						applyZone(r_thisCell, r_leftCell, crusherZones);
+						notTerrainOrCrusher = FALSE;
+					}
+
+					if ( notTerrainOrCrusher ) {
+						if (waterGround(r_thisCell, r_leftCell))
+							applyZone(r_thisCell, r_leftCell, groundWaterZones);
+						else if (groundRubble(r_thisCell, r_leftCell))
+							applyZone(r_thisCell, r_leftCell, groundRubbleZones);
+						else if (groundCliff(r_thisCell, r_leftCell))
+							applyZone(r_thisCell, r_leftCell, groundCliffZones);
+					}
+
+				}
+#endif
+
+			}
 
+			if (j>globalBounds.lo.y && r_thisCell.getZone()!=map[i][j-1].getZone()) {
+				const PathfindCell &r_topCell = map[i][j-1];
+
+#if RTS_GENERALS && RETAIL_COMPATIBLE_PATHFINDING
+				if (r_thisCell.getType() == r_topCell.getType()) {
+					applyZone(r_thisCell, r_topCell, hierarchicalZones);
+				}
+				if (waterGround(r_thisCell, r_topCell)) {
+					applyZone(r_thisCell, r_topCell, groundWaterZones);
+				}
+				if (groundRubble(r_thisCell, r_topCell)) {
+					applyZone(r_thisCell, r_topCell, groundRubbleZones);
+				}
+				if (groundCliff(r_thisCell, r_topCell)) {
+					applyZone(r_thisCell, r_topCell, groundCliffZones);
+				}
+				if (terrain(r_thisCell, r_topCell)) {
+					applyZone(r_thisCell, r_topCell, terrainZones);
+				}
+				if (crusherGround(r_thisCell, r_topCell)) {
+					applyZone(r_thisCell, r_topCell, crusherZones);
+				}
+#else
+				//if this is true, skip all the ones below
+				if (r_thisCell.getType() == r_topCell.getType())
+					applyZone(r_thisCell, r_topCell, hierarchicalZones);
+				else {
+					Bool notTerrainOrCrusher = TRUE; // if this is false, skip the if-else-ladder below
+
+					if (terrain(r_thisCell, r_topCell)) {
+						applyZone(r_thisCell, r_topCell, terrainZones);
+						notTerrainOrCrusher = FALSE;
+					}
+
+					if (crusherGround(r_thisCell, r_topCell)) {
+						applyZone(r_thisCell, r_topCell, crusherZones);
+						notTerrainOrCrusher = FALSE;
+					}
+
+					if (notTerrainOrCrusher) {
+						if (waterGround(r_thisCell, r_topCell))
+							applyZone(r_thisCell, r_topCell, groundWaterZones);
+						else if (groundRubble(r_thisCell, r_topCell))
+							applyZone(r_thisCell, r_topCell, groundRubbleZones);
+						else if (groundCliff(r_thisCell, r_topCell))
+							applyZone(r_thisCell, r_topCell, groundCliffZones);
+					}
+
+				}
+#endif
+
+			}
+
+		}
+	}
 }
 
-inline void applyBlockZone(PathfindCell &targetCell, const PathfindCell &sourceCell,
-													 zoneStorageType *zoneEquivalency, Int firstZone, Int sizeOfZE)
+template <class Equivalency>
+static void resolveZoneTables(PathfindCell **map, PathfindLayer layers[], const IRegion2D &globalBounds, Int maxZone,
+	zoneStorageType *hierarchicalZones, zoneStorageType *groundWaterZones, zoneStorageType *groundRubbleZones,
+	zoneStorageType *groundCliffZones, zoneStorageType *terrainZones, zoneStorageType *crusherZones)
 {
-	DEBUG_ASSERTCRASH(sourceCell.getZone()>=firstZone && sourceCell.getZone()<firstZone+sizeOfZE, ("Memory overrun - FATAL ERROR."));
-	Int srcZone = zoneEquivalency[sourceCell.getZone()-firstZone];
-	DEBUG_ASSERTCRASH(targetCell.getZone()>=firstZone && sourceCell.getZone()<firstZone+sizeOfZE, ("Memory overrun - FATAL ERROR."));
-	Int targetZone = zoneEquivalency[targetCell.getZone()-firstZone];
-	if (targetZone == srcZone) {
-		return; // already match.
+	Equivalency hierarchical, groundWater, groundRubble, groundCliff, terrainEquivalency, crusher;
+	hierarchical.begin(hierarchicalZones, maxZone);
+	groundWater.begin(groundWaterZones, maxZone);
+	groundRubble.begin(groundRubbleZones, maxZone);
+	groundCliff.begin(groundCliffZones, maxZone);
+	terrainEquivalency.begin(terrainZones, maxZone);
+	crusher.begin(crusherZones, maxZone);
+
+	resolveCellEquivalencies(map, layers, globalBounds, hierarchical, groundWater, groundRubble, groundCliff, terrainEquivalency, crusher);
+
+	hierarchical.end();
+	groundWater.end();
+	groundRubble.end();
+	groundCliff.end();
+	terrainEquivalency.end();
+	crusher.end();
+
+	//FLATTEN HIERARCHICAL ZONES
+	Int i;
+	for (i=1; i<maxZone; i++) {
+		Int zone = hierarchicalZones[i];
+		hierarchicalZones[i] = hierarchicalZones[zone];
 	}
-	resolveBlockZones(srcZone, targetZone, zoneEquivalency, sizeOfZE);
 
+	//THIS BLOCK IS 20%
+	flattenZones(groundCliffZones, hierarchicalZones, maxZone, groundCliff);
+	flattenZones(groundWaterZones, hierarchicalZones, maxZone, groundWater);
+	flattenZones(groundRubbleZones, hierarchicalZones, maxZone, groundRubble);
+	flattenZones(terrainZones, hierarchicalZones, maxZone, terrainEquivalency);
+	flattenZones(crusherZones, hierarchicalZones, maxZone, crusher);
+}
+
+// The largest zone a PathfindCell can hold.
+static const Int MAX_CELL_ZONES = 0x3fff;
+
+static Int findCellRoot(UnsignedByte *parent, Int ndx)
+{
+	while (parent[ndx] != ndx) {
+		parent[ndx] = parent[parent[ndx]];
+		ndx = parent[ndx];
+	}
+	return ndx;
 }
 
+// GeneralsX @performance 18/10/2026 Threads that work through the zone blocks of the map together with
+// the calling thread. They are kept for the life of the zone manager, since zones are recalculated
+// every few frames whenever a structure is built or destroyed.
+class PathfindZoneWorkers
+{
+public:
+	typedef void (*JobFunc)(void *context, Int job);
+
+	enum { MAX_THREADS = 7 };						///< worker threads in addition to the calling thread
+	enum { JOBS_PER_CLAIM = 16 };				///< blocks a thread takes at a time
+	enum { MIN_JOBS_TO_SHARE = 64 };			///< fewer blocks are done on the calling thread alone
+
+	PathfindZoneWorkers() : m_func(nullptr), m_context(nullptr), m_jobCount(0), m_nextJob(0),
+		m_generation(0), m_busyThreads(0), m_quit(false)
+	{
+		Int numThreads = (Int)std::thread::hardware_concurrency() - 1;
+		if (numThreads > MAX_THREADS)
+			numThreads = MAX_THREADS;
+		for (Int i = 0; i < numThreads; ++i)
+			m_threads.push_back(std::thread(threadFunc, this));
+	}
+
+	~PathfindZoneWorkers()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_quit = true;
+		}
+		m_wake.notify_all();
+		for (size_t i = 0; i < m_threads.size(); ++i)
+			m_threads[i].join();
+	}
+
+	Int getThreadCount() const { return (Int)m_threads.size(); }
+
+	/// Calls func for each job from 0 to jobCount-1, on any thread, and returns when all are done.
+	void run(JobFunc func, void *context, Int jobCount)
+	{
+		if (m_threads.empty() || jobCount < MIN_JOBS_TO_SHARE)
+		{
+			for (Int i = 0; i < jobCount; ++i)
+				func(context, i);
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_func = func;
+			m_context = context;
+			m_jobCount = jobCount;
+			m_nextJob = 0;
+			m_busyThreads = (Int)m_threads.size();
+			++m_generation;
+		}
+		m_wake.notify_all();
+
+		doJobs();
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_done.wait(lock, [this] { return m_busyThreads == 0; });
+	}
+
+private:
+	void doJobs()
+	{
+		for (;;)
+		{
+			Int first = m_nextJob.fetch_add(JOBS_PER_CLAIM);
+			if (first >= m_jobCount)
+				break;
+			Int last = first + JOBS_PER_CLAIM;
+			if (last > m_jobCount)
+				last = m_jobCount;
+			for (Int i = first; i < last; ++i)
+				m_func(m_context, i);
+		}
+	}
+
+	static void threadFunc(PathfindZoneWorkers *workers)
+	{
+		UnsignedInt generation = 0;
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock(workers->m_mutex);
+				workers->m_wake.wait(lock, [&] { return workers->m_quit || workers->m_generation != generation; });
+				if (workers->m_quit)
+					return;
+				generation = workers->m_generation;
+			}
+
+			workers->doJobs();
+
+			std::lock_guard<std::mutex> lock(workers->m_mutex);
+			if (--workers->m_busyThreads == 0)
+				workers->m_done.notify_one();
+		}
+	}
+
+	std::vector<std::thread> m_threads;
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_done;
+	JobFunc m_func;
+	void *m_context;
+	Int m_jobCount;
+	std::atomic<Int> m_nextJob;
+	UnsignedInt m_generation;
+	Int m_busyThreads;
+	Bool m_quit;
+};
+
 //------------------------  ZoneBlock  -------------------------------
 ZoneBlock::ZoneBlock() : m_firstZone(0),
 m_numZones(0),
@@ -2407,7 +2823,6 @@ large enough, reuse.  Then calculate terrain equivalencies. */
 void ZoneBlock::blockCalculateZones(PathfindCell **map, PathfindLayer layers[], const IRegion2D &bounds)
 {
 	Int i, j;
-	m_cellOrigin = bounds.lo;
 	UnsignedInt minZone = map[bounds.lo.x][bounds.lo.y].getZone();
 	UnsignedInt maxZone = minZone;
 
@@ -2419,11 +2834,25 @@ void ZoneBlock::blockCalculateZones(PathfindCell **map, PathfindLayer layers[],
 			if (maxZone<zone) maxZone=zone;
 		}
 	}
-	m_firstZone = minZone;
-	m_numZones = 1 + maxZone - minZone;
+	setZoneRange(bounds.lo, minZone, 1 + maxZone - minZone);
+	calculateEquivalencies(map, bounds);
+}
+
+/* Allocate the zone equivalency arrays for the zones firstZone to firstZone+numZones-1 of this block. */
+void ZoneBlock::setZoneRange(const ICoord2D &cellOrigin, zoneStorageType firstZone, UnsignedShort numZones)
+{
+	m_cellOrigin = cellOrigin;
+	m_firstZone = firstZone;
+	m_numZones = numZones;
 
 	allocateZones();
+}
 
+/* Calculate the terrain equivalencies of the zones in the block.  Only touches the block, so the blocks
+can be done in parallel once their arrays are allocated. */
+void ZoneBlock::calculateEquivalencies(PathfindCell **map, const IRegion2D &bounds)
+{
+	Int i, j;
 	if (m_numZones==1) return; // all zones are equivalent.
 
 	// Determine water/ground equivalent zones, and ground/cliff equivalent zones.
@@ -2471,6 +2900,40 @@ void ZoneBlock::blockCalculateZones(PathfindCell **map, PathfindLayer layers[],
 
 }
 
+/* The zones of the blocks before this one changed, but not the cells of this block.  The equivalencies
+only depend on the cells, so they just move along with the zone numbers. */
+void ZoneBlock::shiftZones(Int delta)
+{
+	m_firstZone += delta;
+	if (m_numZones==1) return; // no zone equivalency tables.
+
+	Int i;
+	for (i=0; i<m_zonesAllocated; i++) {
+		m_groundCliffZones[i] += delta;
+		m_groundWaterZones[i] += delta;
+		m_groundRubbleZones[i] += delta;
+		m_crusherZones[i] += delta;
+	}
+}
+
+void ZoneBlock::getZoneState(std::vector<Int> &state) const
+{
+	state.push_back(m_cellOrigin.x);
+	state.push_back(m_cellOrigin.y);
+	state.push_back(m_firstZone);
+	state.push_back(m_numZones);
+	state.push_back(m_interactsWithBridge);
+	if (m_numZones==1) return; // the tables are not used.
+
+	Int i;
+	for (i=0; i<m_numZones; i++) {
+		state.push_back(m_groundCliffZones[i]);
+		state.push_back(m_groundWaterZones[i]);
+		state.push_back(m_groundRubbleZones[i]);
+		state.push_back(m_crusherZones[i]);
+	}
+}
+
 //
 // Return the zone at this location.
 //
@@ -2576,16 +3039,23 @@ m_crusherZones(nullptr),
 m_hierarchicalZones(nullptr),
 m_blockOfZoneBlocks(nullptr),
 m_zoneBlocks(nullptr),
-m_zonesAllocated(0)
+m_zonesAllocated(0),
+m_labelMap(nullptr),
+m_blockLabelsValid(false),
+m_relabeledBlocks(0),
+m_workers(nullptr)
 {
 	m_zoneBlockExtent.x = 0;
 	m_zoneBlockExtent.y = 0;
+	m_labelBounds.lo.x = m_labelBounds.lo.y = 0;
+	m_labelBounds.hi.x = m_labelBounds.hi.y = -1;
 }
 
 PathfindZoneManager::~PathfindZoneManager()
 {
 	freeZones();
 	freeBlocks();
+	delete m_workers;
 }
 
 void PathfindZoneManager::freeZones()
@@ -2621,6 +3091,9 @@ void PathfindZoneManager::freeBlocks()
 
 	m_zoneBlockExtent.x = 0;
 	m_zoneBlockExtent.y = 0;
+
+	// the labels describe the zones of the blocks just freed.
+	m_blockLabelsValid = false;
 }
 
 /* Allocate zone equivalency arrays large enough to hold m_maxZone entries.  If the arrays are already
@@ -2705,6 +3178,52 @@ void PathfindZoneManager::calculateZones( PathfindCell **map, PathfindLayer laye
 #endif
 #endif
 
+	if (!numberZones(map, layers, globalBounds)) {
+		numberZonesSerial(map, layers, globalBounds);
+	}
+	resolveZoneEquivalencies(map, layers, globalBounds, false);
+
+#ifdef DEBUG_QPF
+#if defined(DEBUG_LOGGING)
+	QueryPerformanceCounter((LARGE_INTEGER *)&endTime64);
+	timeToUpdate = ((double)(endTime64-startTime64) / (double)(freq64));
+
+	if ( updateSamples < 400 ) {
+		averageTimeToUpdate = ((averageTimeToUpdate * updateSamples) + timeToUpdate) / (updateSamples + 1.0f);
+		updateSamples++;
+		DEBUG_LOG(("computing...: %f", averageTimeToUpdate));
+	}
+	else if ( updateSamples == 400 ) {
+		DEBUG_LOG((" =============DONE============= Average time to calculate zones: %f", averageTimeToUpdate));
+		DEBUG_LOG(("                                           Percent of baseline : %f", averageTimeToUpdate/0.003335f));
+		updateSamples = 777;
+	}
+
+#endif
+#endif
+	finishZones(map, globalBounds);
+}
+
+/**
+ * Calculate zones the way the original game does, block after block on the calling thread.
+ * Gives the same zones as calculateZones, it is kept to check and time calculateZones against.
+ */
+void PathfindZoneManager::calculateZonesSerial( PathfindCell **map, PathfindLayer layers[], const IRegion2D &globalBounds )
+{
+	numberZonesSerial(map, layers, globalBounds);
+	resolveZoneEquivalencies(map, layers, globalBounds, true);
+	finishZones(map, globalBounds);
+}
+
+/**
+ * Give each area of the same terrain in a block its own zone, numbered block by block, then
+ * the bridge layers.  Allocates the zone tables and does the equivalencies within each block.
+ */
+void PathfindZoneManager::numberZonesSerial( PathfindCell **map, PathfindLayer layers[], const IRegion2D &globalBounds )
+{
+	// the block labels do not describe the zones numbered here.
+	m_blockLabelsValid = false;
+
 	m_maxZone = 1;	// we start using zone 0 as a flag.
 	const Int maxZones=24000;
 	zoneStorageType zoneEquivalency[maxZones];
@@ -2843,170 +3362,258 @@ void PathfindZoneManager::calculateZones( PathfindCell **map, PathfindLayer laye
 			m_zoneBlocks[xBlock][yBlock].blockCalculateZones(map, layers, bounds);
 		}
 	}
+}
 
-	// Determine water/ground equivalent zones, and ground/cliff equivalent zones.
-	for (i=0; i<m_zonesAllocated; i++) {
-		m_groundCliffZones[i] = i;
-		m_groundWaterZones[i] = i;
-		m_groundRubbleZones[i] = i;
-		m_terrainZones[i] = i;
-		m_crusherZones[i] = i;
-		m_hierarchicalZones[i] = i;
+/**
+ * Same as numberZonesSerial, but the blocks are labelled on the worker threads and only the blocks
+ * with cells that changed since the last call are labelled again.  Returns false, without changing
+ * anything but the labels, if the zones have to be numbered by numberZonesSerial.
+ */
+Bool PathfindZoneManager::numberZones( PathfindCell **map, PathfindLayer layers[], const IRegion2D &globalBounds )
+{
+	Int xCount = (globalBounds.hi.x-globalBounds.lo.x+1+ZONE_BLOCK_SIZE-1)/ZONE_BLOCK_SIZE;
+	Int yCount = (globalBounds.hi.y-globalBounds.lo.y+1+ZONE_BLOCK_SIZE-1)/ZONE_BLOCK_SIZE;
+	Int numBlocks = xCount*yCount;
+	if (xCount != m_zoneBlockExtent.x || yCount != m_zoneBlockExtent.y) {
+		return false;
 	}
 
-	for( j=globalBounds.lo.y; j<=globalBounds.hi.y; j++ ) {
-		for( i=globalBounds.lo.x; i<=globalBounds.hi.x; i++ ) {
-			PathfindCell &r_thisCell = map[i][j];
-
-			if ( (r_thisCell.getConnectLayer() > LAYER_GROUND) &&
-				(r_thisCell.getType() == PathfindCell::CELL_CLEAR) ) {
-				PathfindLayer *layer = layers + r_thisCell.getConnectLayer();
-				resolveZones(r_thisCell.getZone(), layer->getZone(), m_hierarchicalZones, m_maxZone);
-			}
-
-			if ( i > globalBounds.lo.x && r_thisCell.getZone() != map[i-1][j].getZone() ) {
-				const PathfindCell &r_leftCell = map[i-1][j];
-
-#if RTS_GENERALS && RETAIL_COMPATIBLE_PATHFINDING
-				if (r_thisCell.getType() == r_leftCell.getType()) {
-					applyZone(r_thisCell, r_leftCell, m_hierarchicalZones, m_maxZone);
-				}
-				if (waterGround(r_thisCell, r_leftCell)) {
-					applyZone(r_thisCell, r_leftCell, m_groundWaterZones, m_maxZone);
-				}
-				if (groundRubble(r_thisCell, r_leftCell)) {
-					applyZone(r_thisCell, r_leftCell, m_groundRubbleZones, m_maxZone);
-				}
-				if (groundCliff(r_thisCell, r_leftCell)) {
-					applyZone(r_thisCell, r_leftCell, m_groundCliffZones, m_maxZone);
-				}
-				if (terrain(r_thisCell, r_leftCell)) {
-					applyZone(r_thisCell, r_leftCell, m_terrainZones, m_maxZone);
+	if (map != m_labelMap || (Int)m_blockLabels.size() != numBlocks ||
+		globalBounds.lo.x != m_labelBounds.lo.x || globalBounds.lo.y != m_labelBounds.lo.y ||
+		globalBounds.hi.x != m_labelBounds.hi.x || globalBounds.hi.y != m_labelBounds.hi.y) {
+		m_labelMap = map;
+		m_labelBounds = globalBounds;
+		m_blockLabelsValid = false;
+		m_blockLabels.resize(numBlocks);
+		m_cellKeys.resize(numBlocks*ZONE_BLOCK_SIZE*ZONE_BLOCK_SIZE);
+		m_cellLabels.resize(numBlocks*ZONE_BLOCK_SIZE*ZONE_BLOCK_SIZE);
+		Int xBlock, yBlock;
+		for (xBlock = 0; xBlock<xCount; xBlock++) {
+			for (yBlock=0; yBlock<yCount; yBlock++) {
+				IRegion2D &bounds = m_blockLabels[xBlock*yCount + yBlock].bounds;
+				bounds.lo.x = globalBounds.lo.x + xBlock*ZONE_BLOCK_SIZE;
+				bounds.lo.y = globalBounds.lo.y + yBlock*ZONE_BLOCK_SIZE;
+				bounds.hi.x = bounds.lo.x + ZONE_BLOCK_SIZE - 1; // bounds are inclusive.
+				bounds.hi.y = bounds.lo.y + ZONE_BLOCK_SIZE - 1; // bounds are inclusive.
+				if (bounds.hi.x > globalBounds.hi.x) {
+					bounds.hi.x = globalBounds.hi.x;
 				}
-				if (crusherGround(r_thisCell, r_leftCell)) {
-					applyZone(r_thisCell, r_leftCell, m_crusherZones, m_maxZone);
+				if (bounds.hi.y > globalBounds.hi.y) {
+					bounds.hi.y = globalBounds.hi.y;
 				}
-#else
-				//if this is true, skip all the ones below
-				if (r_thisCell.getType() == r_leftCell.getType())
-					applyZone(r_thisCell, r_leftCell, m_hierarchicalZones, m_maxZone);
-				else {
-					Bool notTerrainOrCrusher = TRUE; // if this is false, skip the if-else-ladder below
-
-					if (terrain(r_thisCell, r_leftCell)) {
-						applyZone(r_thisCell, r_leftCell, m_terrainZones, m_maxZone);
-						notTerrainOrCrusher = FALSE;
-					}
+			}
+		}
+	}
+	if (m_workers == nullptr) {
+		m_workers = MSGNEW("PathfindZoneWorkers") PathfindZoneWorkers;
+	}
 
-					if (crusherGround(r_thisCell, r_leftCell)) {
-						applyZone(r_thisCell, r_leftCell, m_crusherZones, m_maxZone);
-						notTerrainOrCrusher = FALSE;
-					}
+	m_workers->run(labelBlockJob, this, numBlocks);
+	m_blockLabelsValid = true;
 
-					if ( notTerrainOrCrusher ) {
-						if (waterGround(r_thisCell, r_leftCell))
-							applyZone(r_thisCell, r_leftCell, m_groundWaterZones, m_maxZone);
-						else if (groundRubble(r_thisCell, r_leftCell))
-							applyZone(r_thisCell, r_leftCell, m_groundRubbleZones, m_maxZone);
-						else if (groundCliff(r_thisCell, r_leftCell))
-							applyZone(r_thisCell, r_leftCell, m_groundCliffZones, m_maxZone);
-					}
+	// numberZonesSerial hands out a zone for each area it finds before merging the areas, and stores
+	// them in the cells, so it has to do the numbering when they don't fit.
+	Int block;
+	Int rawZones = 1;
+	for (block=0; block<numBlocks; block++) {
+		rawZones += m_blockLabels[block].rawZones;
+	}
+	if (rawZones > MAX_CELL_ZONES) {
+		return false;
+	}
 
-				}
-#endif
+	// Number the zones of the blocks in the same order as numberZonesSerial.
+	m_maxZone = 1;	// we start using zone 0 as a flag.
+	m_relabeledBlocks = 0;
+	for (block=0; block<numBlocks; block++) {
+		BlockLabels &labels = m_blockLabels[block];
+		ZoneBlock &zoneBlock = m_blockOfZoneBlocks[block];
+		if (labels.relabeled) {
+			zoneBlock.setZoneRange(labels.bounds.lo, m_maxZone, labels.numZones);
+			m_relabeledBlocks++;
+		} else if (labels.firstZone != m_maxZone) {
+			zoneBlock.shiftZones(m_maxZone - labels.firstZone);
+		}
+		labels.firstZone = m_maxZone;
+		m_maxZone += labels.numZones;
+	}
 
-			}
+	m_workers->run(applyBlockLabelsJob, this, numBlocks);
 
-			if (j>globalBounds.lo.y && r_thisCell.getZone()!=map[i][j-1].getZone()) {
-				const PathfindCell &r_topCell = map[i][j-1];
+	Int i;
+	for (i=0; i<=LAYER_LAST; i++) {
+		PathfindLayer &r_thisLayer = layers[i];
 
-#if RTS_GENERALS && RETAIL_COMPATIBLE_PATHFINDING
-				if (r_thisCell.getType() == r_topCell.getType()) {
-					applyZone(r_thisCell, r_topCell, m_hierarchicalZones, m_maxZone);
-				}
-				if (waterGround(r_thisCell, r_topCell)) {
-					applyZone(r_thisCell, r_topCell, m_groundWaterZones, m_maxZone);
-				}
-				if (groundRubble(r_thisCell, r_topCell)) {
-					applyZone(r_thisCell, r_topCell, m_groundRubbleZones, m_maxZone);
-				}
-				if (groundCliff(r_thisCell, r_topCell)) {
-					applyZone(r_thisCell, r_topCell, m_groundCliffZones, m_maxZone);
-				}
-				if (terrain(r_thisCell, r_topCell)) {
-					applyZone(r_thisCell, r_topCell, m_terrainZones, m_maxZone);
-				}
-				if (crusherGround(r_thisCell, r_topCell)) {
-					applyZone(r_thisCell, r_topCell, m_crusherZones, m_maxZone);
-				}
-#else
-				//if this is true, skip all the ones below
-				if (r_thisCell.getType() == r_topCell.getType())
-					applyZone(r_thisCell, r_topCell, m_hierarchicalZones, m_maxZone);
-				else {
-					Bool notTerrainOrCrusher = TRUE; // if this is false, skip the if-else-ladder below
+		r_thisLayer.setZone( m_maxZone );
+		m_maxZone++;
+		r_thisLayer.applyZone();
 
-					if (terrain(r_thisCell, r_topCell)) {
-						applyZone(r_thisCell, r_topCell, m_terrainZones, m_maxZone);
-						notTerrainOrCrusher = FALSE;
-					}
+		if (!r_thisLayer.isUnused() && !r_thisLayer.isDestroyed()) {
+			ICoord2D ndx;
+			r_thisLayer.getStartCellIndex(&ndx);
+			setBridge(ndx.x, ndx.y, true);
+			r_thisLayer.getEndCellIndex(&ndx);
+			setBridge(ndx.x, ndx.y, true);
+		}
+	}
 
-					if (crusherGround(r_thisCell, r_topCell)) {
-						applyZone(r_thisCell, r_topCell, m_crusherZones, m_maxZone);
-						notTerrainOrCrusher = FALSE;
-					}
+	allocateZones();
+	return true;
+}
 
-					if (notTerrainOrCrusher) {
-						if (waterGround(r_thisCell, r_topCell))
-							applyZone(r_thisCell, r_topCell, m_groundWaterZones, m_maxZone);
-						else if (groundRubble(r_thisCell, r_topCell))
-							applyZone(r_thisCell, r_topCell, m_groundRubbleZones, m_maxZone);
-						else if (groundCliff(r_thisCell, r_topCell))
-							applyZone(r_thisCell, r_topCell, m_groundCliffZones, m_maxZone);
-					}
+/**
+ * Find the areas of the same terrain in a block, and give them local zones in the order the
+ * original calculation meets them, if any cell of the block changed since it was last labelled.
+ */
+void PathfindZoneManager::labelBlockJob(void *zoneManager, Int block)
+{
+	PathfindZoneManager *self = static_cast<PathfindZoneManager *>(zoneManager);
+	BlockLabels &labels = self->m_blockLabels[block];
+	const IRegion2D &bounds = labels.bounds;
+	PathfindCell **map = self->m_labelMap;
+	UnsignedShort *keys = &self->m_cellKeys[block*ZONE_BLOCK_SIZE*ZONE_BLOCK_SIZE];
+	UnsignedByte *cellLabels = &self->m_cellLabels[block*ZONE_BLOCK_SIZE*ZONE_BLOCK_SIZE];
+
+	enum {
+		KEY_TYPE = 0x0f,
+		KEY_FENCE = 0x10,
+		KEY_CONNECTS_TO_LAYER = 0x20
+	};
+
+	Bool changed = !self->m_blockLabelsValid;
+	Int i, j;
+	for( j=bounds.lo.y; j<=bounds.hi.y; j++ )	{
+		for( i=bounds.lo.x; i<=bounds.hi.x; i++ )	{
+			const PathfindCell &cell = map[i][j];
+			UnsignedShort key = cell.getType();
+			if (cell.isObstacleFence()) {
+				key |= KEY_FENCE;
+			}
+			if (cell.getConnectLayer() > LAYER_GROUND) {
+				key |= KEY_CONNECTS_TO_LAYER;
+			}
+			Int ndx = (j-bounds.lo.y)*ZONE_BLOCK_SIZE + i-bounds.lo.x;
+			if (keys[ndx] != key) {
+				keys[ndx] = key;
+				changed = true;
+			}
+		}
+	}
+	labels.relabeled = changed;
+	if (!changed) {
+		return;
+	}
 
+	// Join the cells of the same type, the root of an area is its first cell.
+	UnsignedByte parent[ZONE_BLOCK_SIZE*ZONE_BLOCK_SIZE];
+	Int rawZones = 0;
+	Bool connectsToLayer = false;
+	for( j=bounds.lo.y; j<=bounds.hi.y; j++ )	{
+		for( i=bounds.lo.x; i<=bounds.hi.x; i++ )	{
+			Int ndx = (j-bounds.lo.y)*ZONE_BLOCK_SIZE + i-bounds.lo.x;
+			Int type = keys[ndx] & KEY_TYPE;
+			Bool joined = false;
+			parent[ndx] = ndx;
+			if (i>bounds.lo.x && (keys[ndx-1] & KEY_TYPE) == type) {
+				parent[ndx] = findCellRoot(parent, ndx-1);
+				joined = true;
+			}
+			if (j>bounds.lo.y && (keys[ndx-ZONE_BLOCK_SIZE] & KEY_TYPE) == type) {
+				Int root = findCellRoot(parent, ndx-ZONE_BLOCK_SIZE);
+				Int other = findCellRoot(parent, ndx);
+				if (root < other) {
+					parent[other] = root;
+				} else {
+					parent[root] = other;
 				}
-#endif
-
+				joined = true;
+			}
+			if (!joined) {
+				rawZones++;
+			}
+			if (keys[ndx] & KEY_CONNECTS_TO_LAYER) {
+				connectsToLayer = true;
 			}
-
 		}
 	}
 
-	//FLATTEN HIERARCHICAL ZONES
-	for (i=1; i<m_maxZone; i++) {
-		Int zone = m_hierarchicalZones[i];
-		m_hierarchicalZones[i] = m_hierarchicalZones[zone];
+	UnsignedByte zoneOfRoot[ZONE_BLOCK_SIZE*ZONE_BLOCK_SIZE];
+	Int numZones = 0;
+	for( j=bounds.lo.y; j<=bounds.hi.y; j++ )	{
+		for( i=bounds.lo.x; i<=bounds.hi.x; i++ )	{
+			Int ndx = (j-bounds.lo.y)*ZONE_BLOCK_SIZE + i-bounds.lo.x;
+			Int root = findCellRoot(parent, ndx);
+			if (root == ndx) {
+				zoneOfRoot[root] = ++numZones;
+			}
+			cellLabels[ndx] = zoneOfRoot[root];
+		}
 	}
 
-	//THIS BLOCK IS 20%
-	flattenZones(m_groundCliffZones, m_hierarchicalZones, m_maxZone);
-	flattenZones(m_groundWaterZones, m_hierarchicalZones, m_maxZone);
-	flattenZones(m_groundRubbleZones, m_hierarchicalZones, m_maxZone);
-	flattenZones(m_terrainZones, m_hierarchicalZones, m_maxZone);
-	flattenZones(m_crusherZones, m_hierarchicalZones, m_maxZone);
+	labels.numZones = numZones;
+	labels.rawZones = rawZones;
+	labels.connectsToLayer = connectsToLayer;
+}
 
-#ifdef DEBUG_QPF
-#if defined(DEBUG_LOGGING)
-	QueryPerformanceCounter((LARGE_INTEGER *)&endTime64);
-	timeToUpdate = ((double)(endTime64-startTime64) / (double)(freq64));
+/**
+ * Store the zones of a block in its cells, and calculate the equivalencies of the block if it
+ * was labelled again.
+ */
+void PathfindZoneManager::applyBlockLabelsJob(void *zoneManager, Int block)
+{
+	PathfindZoneManager *self = static_cast<PathfindZoneManager *>(zoneManager);
+	const BlockLabels &labels = self->m_blockLabels[block];
+	const IRegion2D &bounds = labels.bounds;
+	PathfindCell **map = self->m_labelMap;
+	const UnsignedByte *cellLabels = &self->m_cellLabels[block*ZONE_BLOCK_SIZE*ZONE_BLOCK_SIZE];
+	ZoneBlock &zoneBlock = self->m_blockOfZoneBlocks[block];
 
-	if ( updateSamples < 400 ) {
-		averageTimeToUpdate = ((averageTimeToUpdate * updateSamples) + timeToUpdate) / (updateSamples + 1.0f);
-		updateSamples++;
-		DEBUG_LOG(("computing...: %f", averageTimeToUpdate));
+	Int firstZone = labels.firstZone - 1;
+	Int i, j;
+	for( j=bounds.lo.y; j<=bounds.hi.y; j++ )	{
+		for( i=bounds.lo.x; i<=bounds.hi.x; i++ )	{
+			map[i][j].setZone(firstZone + cellLabels[(j-bounds.lo.y)*ZONE_BLOCK_SIZE + i-bounds.lo.x]);
+		}
 	}
-	else if ( updateSamples == 400 ) {
-		DEBUG_LOG((" =============DONE============= Average time to calculate zones: %f", averageTimeToUpdate));
-		DEBUG_LOG(("                                           Percent of baseline : %f", averageTimeToUpdate/0.003335f));
-		updateSamples = 777;
+	zoneBlock.setInteractsWithBridge(labels.connectsToLayer);
+
+	if (labels.relabeled) {
+		zoneBlock.calculateEquivalencies(map, bounds);
 	}
+}
 
-#endif
-#endif
+/**
+ * Calculate the equivalencies of the zones numbered by numberZones or numberZonesSerial, for
+ * the whole map.
+ */
+void PathfindZoneManager::resolveZoneEquivalencies( PathfindCell **map, PathfindLayer layers[], const IRegion2D &globalBounds, Bool serial )
+{
+	Int i;
+	// Determine water/ground equivalent zones, and ground/cliff equivalent zones.
+	for (i=0; i<m_zonesAllocated; i++) {
+		m_groundCliffZones[i] = i;
+		m_groundWaterZones[i] = i;
+		m_groundRubbleZones[i] = i;
+		m_terrainZones[i] = i;
+		m_crusherZones[i] = i;
+		m_hierarchicalZones[i] = i;
+	}
+
+	if (serial) {
+		resolveZoneTables<ZoneArray>(map, layers, globalBounds, m_maxZone, m_hierarchicalZones, m_groundWaterZones,
+			m_groundRubbleZones, m_groundCliffZones, m_terrainZones, m_crusherZones);
+	} else {
+		resolveZoneTables<ZoneEquivalency>(map, layers, globalBounds, m_maxZone, m_hierarchicalZones, m_groundWaterZones,
+			m_groundRubbleZones, m_groundCliffZones, m_terrainZones, m_crusherZones);
+	}
+}
+
+void PathfindZoneManager::finishZones( PathfindCell **map, const IRegion2D &globalBounds )
+{
 #if defined(RTS_DEBUG)
 	if (TheGlobalData->m_debugAI == AI_DEBUG_ZONES)
 	{
+		Int i, j;
 		extern void addIcon(const Coord3D *pos, Real width, Int numFramesDuration, RGBColor color);
 		RGBColor color;
 		memset(&color, 0, sizeof(Color));
@@ -3059,9 +3666,21 @@ void PathfindZoneManager::updateZonesForModify(PathfindCell **map, PathfindLayer
 		bounds.hi.y = globalBounds.hi.y;
 	}
 
+	// GeneralsX @performance 18/10/2026 Only visit the blocks the structure overlaps.
+	Int firstXBlock = bounds.lo.x > globalBounds.lo.x ? (bounds.lo.x-globalBounds.lo.x)/ZONE_BLOCK_SIZE : 0;
+	Int firstYBlock = bounds.lo.y > globalBounds.lo.y ? (bounds.lo.y-globalBounds.lo.y)/ZONE_BLOCK_SIZE : 0;
+	Int lastXBlock = bounds.hi.x > globalBounds.lo.x ? (bounds.hi.x-globalBounds.lo.x)/ZONE_BLOCK_SIZE : 0;
+	Int lastYBlock = bounds.hi.y > globalBounds.lo.y ? (bounds.hi.y-globalBounds.lo.y)/ZONE_BLOCK_SIZE : 0;
+	if (lastXBlock >= m_zoneBlockExtent.x) {
+		lastXBlock = m_zoneBlockExtent.x-1;
+	}
+	if (lastYBlock >= m_zoneBlockExtent.y) {
+		lastYBlock = m_zoneBlockExtent.y-1;
+	}
+
 	Int xBlock, yBlock;
-	for (xBlock = 0; xBlock<m_zoneBlockExtent.x; xBlock++) {
-		for (yBlock=0; yBlock<m_zoneBlockExtent.y; yBlock++) {
+	for (xBlock = firstXBlock; xBlock<=lastXBlock; xBlock++) {
+		for (yBlock=firstYBlock; yBlock<=lastYBlock; yBlock++) {
 			IRegion2D blockBounds;
 			blockBounds.lo.x = globalBounds.lo.x + xBlock*ZONE_BLOCK_SIZE;
 			blockBounds.lo.y = globalBounds.lo.y + yBlock*ZONE_BLOCK_SIZE;
@@ -3174,6 +3793,38 @@ void PathfindZoneManager::updateZonesForModify(PathfindCell **map, PathfindLayer
 
 }
 
+void PathfindZoneManager::getZoneState(PathfindCell **map, PathfindLayer layers[], const IRegion2D &globalBounds, std::vector<Int> &state) const
+{
+	state.clear();
+	state.push_back(m_maxZone);
+
+	Int i, j;
+	for( j=globalBounds.lo.y; j<=globalBounds.hi.y; j++ ) {
+		for( i=globalBounds.lo.x; i<=globalBounds.hi.x; i++ ) {
+			state.push_back(map[i][j].getZone());
+		}
+	}
+	for (i=0; i<=LAYER_LAST; i++) {
+		state.push_back(layers[i].getZone());
+	}
+	for (i=0; i<m_maxZone; i++) {
+		state.push_back(m_hierarchicalZones[i]);
+		state.push_back(m_groundCliffZones[i]);
+		state.push_back(m_groundWaterZones[i]);
+		state.push_back(m_groundRubbleZones[i]);
+		state.push_back(m_terrainZones[i]);
+		state.push_back(m_crusherZones[i]);
+	}
+	for (i=0; i<m_zoneBlockExtent.x*m_zoneBlockExtent.y; i++) {
+		m_blockOfZoneBlocks[i].getZoneState(state);
+	}
+}
+
+Int PathfindZoneManager::getWorkerThreadCount() const
+{
+	return m_workers ? m_workers->getThreadCount() : 0;
+}
+
 //
 // Clear the passable flags.
 //
@@ -4896,6 +5547,102 @@ void Pathfinder::forceMapRecalculation()
 	classifyMap();
 }
 
+static double millisecondsSince(const std::chrono::steady_clock::time_point &start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Time the original zone calculation, the parallel one and the incremental one after a structure
+ * sized area changes, and check that they all give the same zones.  Used by -benchmarkPathfindZones.
+ */
+Bool Pathfinder::benchmarkZones(Int iterations)
+{
+	// Note that we use printf here because this is run from cmd.
+	if (iterations < 1) {
+		iterations = 1;
+	}
+	std::vector<Int> expected;
+	std::vector<Int> state;
+	Bool matches = true;
+	Int i, j, k;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (k=0; k<iterations; k++) {
+		m_zoneManager.calculateZonesSerial(m_map, m_layers, m_extent);
+	}
+	double serialTime = millisecondsSince(start) / iterations;
+	m_zoneManager.getZoneState(m_map, m_layers, m_extent, expected);
+
+	start = std::chrono::steady_clock::now();
+	for (k=0; k<iterations; k++) {
+		m_zoneManager.markAllBlocksDirty();
+		m_zoneManager.calculateZones(m_map, m_layers, m_extent);
+	}
+	double parallelTime = millisecondsSince(start) / iterations;
+	m_zoneManager.getZoneState(m_map, m_layers, m_extent, state);
+	matches = matches && state == expected;
+
+	// Block a structure sized area in the middle of the map, and clear it again.
+	const Int STRUCTURE_CELLS = 6;
+	IRegion2D area;
+	area.lo.x = MAX((m_extent.lo.x + m_extent.hi.x - STRUCTURE_CELLS) / 2, m_extent.lo.x);
+	area.lo.y = MAX((m_extent.lo.y + m_extent.hi.y - STRUCTURE_CELLS) / 2, m_extent.lo.y);
+	area.hi.x = MIN(area.lo.x + STRUCTURE_CELLS - 1, m_extent.hi.x);
+	area.hi.y = MIN(area.lo.y + STRUCTURE_CELLS - 1, m_extent.hi.y);
+	std::vector<PathfindCell::CellType> cellTypes;
+	for (j=area.lo.y; j<=area.hi.y; j++) {
+		for (i=area.lo.x; i<=area.hi.x; i++) {
+			cellTypes.push_back(m_map[i][j].getType());
+		}
+	}
+
+	double incrementalTime = 0;
+	Int relabeledBlocks = 0;
+	for (k=0; k<iterations; k++) {
+		for (j=area.lo.y; j<=area.hi.y; j++) {
+			for (i=area.lo.x; i<=area.hi.x; i++) {
+				m_map[i][j].setType(PathfindCell::CELL_IMPASSABLE);
+			}
+		}
+		start = std::chrono::steady_clock::now();
+		m_zoneManager.calculateZones(m_map, m_layers, m_extent);
+		incrementalTime += millisecondsSince(start);
+		relabeledBlocks += m_zoneManager.getRelabeledBlockCount();
+
+		if (k == 0) {
+			std::vector<Int> blocked;
+			m_zoneManager.getZoneState(m_map, m_layers, m_extent, state);
+			m_zoneManager.calculateZonesSerial(m_map, m_layers, m_extent);
+			m_zoneManager.getZoneState(m_map, m_layers, m_extent, blocked);
+			matches = matches && state == blocked;
+			m_zoneManager.calculateZones(m_map, m_layers, m_extent);
+		}
+
+		Int cell = 0;
+		for (j=area.lo.y; j<=area.hi.y; j++) {
+			for (i=area.lo.x; i<=area.hi.x; i++) {
+				m_map[i][j].setType(cellTypes[cell++]);
+			}
+		}
+		start = std::chrono::steady_clock::now();
+		m_zoneManager.calculateZones(m_map, m_layers, m_extent);
+		incrementalTime += millisecondsSince(start);
+		relabeledBlocks += m_zoneManager.getRelabeledBlockCount();
+	}
+	m_zoneManager.getZoneState(m_map, m_layers, m_extent, state);
+	matches = matches && state == expected;
+
+	printf("Pathfind zones: %d x %d cells, %d zones, %d worker threads\n",
+		m_extent.hi.x - m_extent.lo.x + 1, m_extent.hi.y - m_extent.lo.y + 1, expected[0], m_zoneManager.getWorkerThreadCount());
+	printf("  serial: %.3f ms, parallel: %.3f ms, incremental: %.3f ms with %.1f blocks relabelled, zones %s\n",
+		serialTime, parallelTime, incrementalTime / (2*iterations), (double)relabeledBlocks / (2*iterations),
+		matches ? "match" : "DO NOT MATCH");
+	fflush(stdout);
+
+	return matches;
+}
+
 /**
  * Show all cells touched in the last search
  */
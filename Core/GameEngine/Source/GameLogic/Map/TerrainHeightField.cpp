@@ -0,0 +1,391 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: TerrainHeightField.cpp ///////////////////////////////////////////////////////////////////
+// The height samples of the logical terrain, for the height and normal queries of the game logic
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "Common/MapObject.h"
+#include "GameLogic/TerrainHeightField.h"
+
+#include "WWMath/vector3.h"
+
+// the batched heights use intrinsics where the compiler targets SSE2.
+#if defined(__SSE2__) || defined(__x86_64__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define THF_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+//-------------------------------------------------------------------------------------------------
+TerrainHeightField::TerrainHeightField() :
+	m_xExtent(0),
+	m_yExtent(0),
+	m_borderSize(0),
+	m_tilesX(0),
+	m_tilesY(0)
+{
+}
+
+//-------------------------------------------------------------------------------------------------
+void TerrainHeightField::clear()
+{
+	m_tiles.clear();
+	m_xExtent = 0;
+	m_yExtent = 0;
+	m_borderSize = 0;
+	m_tilesX = 0;
+	m_tilesY = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+void TerrainHeightField::build(const UnsignedByte *data, Int xExtent, Int yExtent, Int borderSize)
+{
+	clear();
+	if (data == nullptr || xExtent < 1 || yExtent < 1)
+		return;
+
+	m_xExtent = xExtent;
+	m_yExtent = yExtent;
+	m_borderSize = borderSize;
+	m_tilesX = (xExtent + TILE_CELLS - 1) >> TILE_CELLS_SHIFT;
+	m_tilesY = (yExtent + TILE_CELLS - 1) >> TILE_CELLS_SHIFT;
+	m_tiles.resize(m_tilesX * m_tilesY);
+
+	for (Int tileY = 0; tileY < m_tilesY; ++tileY)
+	{
+		for (Int tileX = 0; tileX < m_tilesX; ++tileX)
+		{
+			Tile &tile = m_tiles[tileY * m_tilesX + tileX];
+			memset(tile.samples, 0, sizeof(tile.samples));
+			for (Int localY = 0; localY < TILE_SAMPLES; ++localY)
+			{
+				Int yIndex = (tileY << TILE_CELLS_SHIFT) - TILE_APRON_LOW + localY;
+				if (yIndex < 0 || yIndex >= yExtent)
+					continue;
+				for (Int localX = 0; localX < TILE_SAMPLES; ++localX)
+				{
+					Int xIndex = (tileX << TILE_CELLS_SHIFT) - TILE_APRON_LOW + localX;
+					if (xIndex < 0 || xIndex >= xExtent)
+						continue;
+					tile.samples[localY * TILE_SAMPLES + localX] = data[yIndex * xExtent + xIndex];
+				}
+			}
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+void TerrainHeightField::setSample(Int xIndex, Int yIndex, UnsignedByte height)
+{
+	// a sample is in the tile of its cell, in the low apron of the next tile and in the high
+	// aprons of up to 2 tiles before, so each axis has up to 3 tiles to look at
+	Int lastTileX = MIN((xIndex + TILE_APRON_LOW) >> TILE_CELLS_SHIFT, m_tilesX - 1);
+	Int lastTileY = MIN((yIndex + TILE_APRON_LOW) >> TILE_CELLS_SHIFT, m_tilesY - 1);
+	for (Int tileY = MAX(lastTileY - 2, 0); tileY <= lastTileY; ++tileY)
+	{
+		Int localY = yIndex - (tileY << TILE_CELLS_SHIFT) + TILE_APRON_LOW;
+		if (localY < 0 || localY >= TILE_SAMPLES)
+			continue;
+		for (Int tileX = MAX(lastTileX - 2, 0); tileX <= lastTileX; ++tileX)
+		{
+			Int localX = xIndex - (tileX << TILE_CELLS_SHIFT) + TILE_APRON_LOW;
+			if (localX < 0 || localX >= TILE_SAMPLES)
+				continue;
+			m_tiles[tileY * m_tilesX + tileX].samples[localY * TILE_SAMPLES + localX] = height;
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+UnsignedByte TerrainHeightField::getClipHeight(Int xIndex, Int yIndex) const
+{
+	xIndex = clamp(0, xIndex, m_xExtent - 1);
+	yIndex = clamp(0, yIndex, m_yExtent - 1);
+	return getSample(xIndex, yIndex);
+}
+
+//-------------------------------------------------------------------------------------------------
+void TerrainHeightField::lowerRawHeight(const ICoord2D *gridPos, Int height)
+{
+	if (!isBuilt())
+		return;
+
+	// the visual indexes its samples linearly, so an x off the map lands in the next or previous row
+	Int index = (gridPos->y + m_borderSize) * m_xExtent + gridPos->x + m_borderSize;
+	if (index < 0 || index >= m_xExtent * m_yExtent)
+		return;
+
+	Int xIndex = index % m_xExtent;
+	Int yIndex = index / m_xExtent;
+	if (getSample(xIndex, yIndex) > height)
+		setSample(xIndex, yIndex, (UnsignedByte)height);
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Height of a position whose cell has not got all the samples the interpolation needs */
+//-------------------------------------------------------------------------------------------------
+Real TerrainHeightField::getHeightOffCells(Int ix, Int iy, Coord3D *normal) const
+{
+	if (normal)
+	{
+		// return a default normal pointing up
+		normal->x = 0.0f;
+		normal->y = 0.0f;
+		normal->z = 1.0f;
+	}
+	return getClipHeight(ix, iy) * MAP_HEIGHT_SCALE;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Smoothed normal of a cell, same math as BaseHeightMapRenderObjClass::getHeightMapHeight */
+//-------------------------------------------------------------------------------------------------
+void TerrainHeightField::getNormal(const UnsignedByte *corner, Real fx, Real fy, Coord3D *normal)
+{
+	//		9		  8
+	//
+	//10	3-----2		7
+	//	  |    /|
+	//	  |  /  |
+	//		|/    |
+	//11	0-----1		6
+	//
+	//		4			5
+	const UnsignedByte *row4 = corner - TILE_SAMPLES;
+	const UnsignedByte *row0 = corner;
+	const UnsignedByte *row3 = corner + TILE_SAMPLES;
+	const UnsignedByte *row9 = corner + 2 * TILE_SAMPLES;
+	UnsignedByte d0, d1, d2, d3, d4, d5, d6, d7, d8, d9, d11;
+	d0 = row0[0];
+	d1 = row0[1];
+	d2 = row3[1];
+	d3 = row3[0];
+	d4 = row4[0];
+	d5 = row4[1];
+	d6 = row0[2];
+	d7 = row3[2];
+	d8 = row9[1];
+	d9 = row9[0];
+	d11 = row0[-1];
+
+	Real deltaZ_X0 = d1-d11;
+	Real deltaZ_X1 = d6-d0;
+	Real deltaZ_X2 = d7-d3;
+	Real deltaZ_X3 = d6-d0;
+
+	Real deltaZ_Y0 = d3-d4;
+	Real deltaZ_Y1 = d2-d5;
+	Real deltaZ_Y2 = d8-d1;
+	Real deltaZ_Y3 = d9-d0;
+
+	// Interpolate to get the smoothed valued. The (1.0-fy) blend is done in double, as it always was.
+	Real deltaZ_X_Left = deltaZ_X0*(1.0f-fx) + fx*deltaZ_X3;
+	Real deltaZ_X_Right = deltaZ_X1*(1.0f-fx) + fx*deltaZ_X2;
+	Real deltaZ_X = deltaZ_X_Left*(1.0-fy) + fy*deltaZ_X_Right;
+
+	Real deltaZ_Y_Left = deltaZ_Y0*(1.0f-fx) + fx*deltaZ_Y3;
+	Real deltaZ_Y_Right = deltaZ_Y1*(1.0f-fx) + fx*deltaZ_Y2;
+	Real deltaZ_Y = deltaZ_Y_Left*(1.0-fy) + fy*deltaZ_Y_Right;
+
+	Vector3 l2r, n2f, normalAtTexel;
+	l2r.Set(2*MAP_XY_FACTOR/MAP_HEIGHT_SCALE, 0, deltaZ_X);
+	n2f.Set(0, 2*MAP_XY_FACTOR/MAP_HEIGHT_SCALE, deltaZ_Y);
+	Vector3::Normalized_Cross_Product(l2r,n2f, &normalAtTexel);
+	normal->x = normalAtTexel.X;
+	normal->y = normalAtTexel.Y;
+	normal->z = normalAtTexel.Z;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Height of the triangle plane containing the position, and the smoothed normal there */
+//-------------------------------------------------------------------------------------------------
+Real TerrainHeightField::getHeight(Real x, Real y, Coord3D *normal) const
+{
+	if (!isBuilt())
+	{
+		if (normal)
+		{
+			// return a default normal pointing up
+			normal->x = 0.0f;
+			normal->y = 0.0f;
+			normal->z = 1.0f;
+		}
+		return 0;
+	}
+
+	//	3-----2
+	//  |    /|
+	//  |  /  |
+	//	|/    |
+	//  0-----1
+	const Real MAP_XY_FACTOR_INV = 1.0f / MAP_XY_FACTOR;
+
+	float xdiv = x * MAP_XY_FACTOR_INV;
+	float ydiv = y * MAP_XY_FACTOR_INV;
+
+	float ixf = FAST_REAL_FLOOR(xdiv);
+	float iyf = FAST_REAL_FLOOR(ydiv);
+
+	float fx = xdiv - ixf; //get fraction
+	float fy = ydiv - iyf; //get fraction
+
+	Int ix = fast_float2long_round(ixf) + m_borderSize;
+	Int iy = fast_float2long_round(iyf) + m_borderSize;
+	if (!isCellInside(ix, iy))
+		return getHeightOffCells(ix, iy, normal);
+
+	const UnsignedByte *corner = getCellCorner(ix, iy);
+	float height;
+	float p0 = corner[0];
+	float p2 = corner[TILE_SAMPLES + 1];
+	if (fy > fx) // test if we are in the upper triangle
+	{
+		float p3 = corner[TILE_SAMPLES];
+		height = (p3 + (1.0f-fy)*(p0-p3) + fx*(p2-p3)) * MAP_HEIGHT_SCALE;
+	}
+	else
+	{
+		// we are in the lower triangle
+		float p1 = corner[1];
+		height = (p1 + fy*(p2-p1) + (1.0f-fx)*(p0-p1)) * MAP_HEIGHT_SCALE;
+	}
+
+	if (normal)
+		getNormal(corner, fx, fy, normal);
+
+	return height;
+}
+
+//-------------------------------------------------------------------------------------------------
+const char *TerrainHeightField::getBatchName()
+{
+#ifdef THF_USE_SSE2
+	return "SSE2";
+#else
+	return "scalar";
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Heights of count positions, four at a time where SSE2 is available. Every lane does the float
+	operations of getHeight in the same order, so the results are the same to the bit. */
+//-------------------------------------------------------------------------------------------------
+void TerrainHeightField::getHeights(const Real *x, const Real *y, Int count, Real *heights) const
+{
+	Int i = 0;
+#ifdef THF_USE_SSE2
+	if (isBuilt())
+	{
+		const __m128 xyFactorInv = _mm_set1_ps(1.0f / MAP_XY_FACTOR);
+		const __m128 almost1 = _mm_castsi128_ps(_mm_set1_epi32((126<<23)|0x7fffff));
+		const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+		const __m128 truncLimit = _mm_set1_ps(4194304.0f);
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 heightScale = _mm_set1_ps(MAP_HEIGHT_SCALE);
+		const __m128i borderSize = _mm_set1_epi32(m_borderSize);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 xdiv = _mm_mul_ps(_mm_loadu_ps(x + i), xyFactorInv);
+			__m128 ydiv = _mm_mul_ps(_mm_loadu_ps(y + i), xyFactorInv);
+
+			// FAST_REAL_FLOOR truncates by masking the mantissa, which only agrees with the conversion
+			// below for moderate values. Anything else, NaNs included, goes through getHeight.
+			__m128 inRange = _mm_and_ps(_mm_cmplt_ps(_mm_and_ps(xdiv, absMask), truncLimit),
+				_mm_cmplt_ps(_mm_and_ps(ydiv, absMask), truncLimit));
+			if (_mm_movemask_ps(inRange) != 0xf)
+			{
+				for (Int k = i; k < i + 4; ++k)
+					heights[k] = getHeight(x[k], y[k], nullptr);
+				continue;
+			}
+
+			// FAST_REAL_FLOOR: subtract almost 1 from negative values, then truncate
+			__m128 xNegative = _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(xdiv), 31));
+			__m128 yNegative = _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(ydiv), 31));
+			__m128i ixi = _mm_cvttps_epi32(_mm_sub_ps(xdiv, _mm_and_ps(xNegative, almost1)));
+			__m128i iyi = _mm_cvttps_epi32(_mm_sub_ps(ydiv, _mm_and_ps(yNegative, almost1)));
+			__m128 fx = _mm_sub_ps(xdiv, _mm_cvtepi32_ps(ixi));
+			__m128 fy = _mm_sub_ps(ydiv, _mm_cvtepi32_ps(iyi));
+
+			alignas(16) Int ix[4];
+			alignas(16) Int iy[4];
+			_mm_store_si128((__m128i *)ix, _mm_add_epi32(ixi, borderSize));
+			_mm_store_si128((__m128i *)iy, _mm_add_epi32(iyi, borderSize));
+
+			alignas(16) float p0[4];
+			alignas(16) float p1[4];
+			alignas(16) float p2[4];
+			alignas(16) float p3[4];
+			Int offCells = 0;
+			for (Int k = 0; k < 4; ++k)
+			{
+				if (isCellInside(ix[k], iy[k]))
+				{
+					const UnsignedByte *corner = getCellCorner(ix[k], iy[k]);
+					p0[k] = corner[0];
+					p1[k] = corner[1];
+					p2[k] = corner[TILE_SAMPLES + 1];
+					p3[k] = corner[TILE_SAMPLES];
+				}
+				else
+				{
+					offCells |= 1 << k;
+					p0[k] = p1[k] = p2[k] = p3[k] = 0.0f;
+				}
+			}
+
+			__m128 v0 = _mm_load_ps(p0);
+			__m128 v1 = _mm_load_ps(p1);
+			__m128 v2 = _mm_load_ps(p2);
+			__m128 v3 = _mm_load_ps(p3);
+
+			// upper triangle: (p3 + (1.0f-fy)*(p0-p3) + fx*(p2-p3)) * MAP_HEIGHT_SCALE
+			__m128 upper = _mm_add_ps(v3, _mm_mul_ps(_mm_sub_ps(one, fy), _mm_sub_ps(v0, v3)));
+			upper = _mm_mul_ps(_mm_add_ps(upper, _mm_mul_ps(fx, _mm_sub_ps(v2, v3))), heightScale);
+
+			// lower triangle: (p1 + fy*(p2-p1) + (1.0f-fx)*(p0-p1)) * MAP_HEIGHT_SCALE
+			__m128 lower = _mm_add_ps(v1, _mm_mul_ps(fy, _mm_sub_ps(v2, v1)));
+			lower = _mm_mul_ps(_mm_add_ps(lower, _mm_mul_ps(_mm_sub_ps(one, fx), _mm_sub_ps(v0, v1))), heightScale);
+
+			__m128 isUpper = _mm_cmpgt_ps(fy, fx);
+			_mm_storeu_ps(heights + i, _mm_or_ps(_mm_and_ps(isUpper, upper), _mm_andnot_ps(isUpper, lower)));
+
+			for (Int k = 0; offCells != 0; ++k, offCells >>= 1)
+			{
+				if (offCells & 1)
+					heights[i + k] = getHeightOffCells(ix[k], iy[k], nullptr);
+			}
+		}
+	}
+#endif
+
+	for (; i < count; ++i)
+		heights[i] = getHeight(x[i], y[i], nullptr);
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Heights and normals of count positions. The normals blend in double and normalize with
+	WWMath, so they are done one by one to keep them the same as getHeight. */
+//-------------------------------------------------------------------------------------------------
+void TerrainHeightField::getHeightsAndNormals(const Real *x, const Real *y, Int count, Real *heights, Coord3D *normals) const
+{
+	for (Int i = 0; i < count; ++i)
+		heights[i] = getHeight(x[i], y[i], &normals[i]);
+}
@@ -80,6 +80,7 @@ void Connection::init() {
 	m_lastTimeSent = 0;
 	m_frameGrouping = 1;
 	m_numRetries = 0;
+	m_totalRetries = 0;
 	m_retryMetricsTime = 0;
 
 	for (Int i = 0; i < CONNECTION_LATENCY_HISTORY_LENGTH; ++i) {
@@ -267,6 +268,7 @@ UnsignedInt Connection::doSend() {
 					if (CommandRequiresAck(msg->getCommand())) {
 						if (timeLastSent != -1) {
 							++m_numRetries;
+							++m_totalRetries;
 						}
 						doRetryMetrics();
 						msg->setTimeLastSent(curtime);
@@ -314,6 +314,8 @@ void ConnectionManager::init()
 		m_latencyAverages[i] = 0.0; // using zero since all floating point standards should be able to specify 0.0 accurately.
 	}
 	m_smallestPacketArrivalCushion = -1;
+	m_lastRunAheadMetricsTime = 0;
+	m_frameResendRequests = 0;
 
 	m_frameMetrics.init();
 
@@ -1351,10 +1353,11 @@ void ConnectionManager::update(Bool isInGame) {
 }
 
 void ConnectionManager::updateRunAhead(Int oldRunAhead, Int frameRate, Bool didSelfSlug, Int nextExecutionFrame) {
-	static time_t lasttimesent = 0;
+	// GeneralsX @bugfix 18/10/2026 Keep the send time per connection manager rather than in a function static,
+	// so that it starts over with every game and several managers in the same process don't share it.
 	time_t curTime = timeGetTime();
 
-	if ((lasttimesent == 0) || ((curTime - lasttimesent) > TheGlobalData->m_networkRunAheadMetricsTime)) {
+	if ((m_lastRunAheadMetricsTime == 0) || ((curTime - m_lastRunAheadMetricsTime) > TheGlobalData->m_networkRunAheadMetricsTime)) {
 		if (m_localSlot == m_packetRouterSlot) {
 			// We are the packet router, time to compute a new run ahead for this game.
 			m_latencyAverages[m_localSlot] = m_frameMetrics.getAverageLatency();
@@ -1487,7 +1490,7 @@ void ConnectionManager::updateRunAhead(Int oldRunAhead, Int frameRate, Bool didS
 			m_connections[m_packetRouterSlot]->sendNetCommandMsg(msg, 1 << m_packetRouterSlot);
 			msg->detach();
 		}
-		lasttimesent = curTime;
+		m_lastRunAheadMetricsTime = curTime;
 	}
 }
 
@@ -1535,6 +1538,16 @@ UnsignedInt ConnectionManager::getMinimumCushion() {
 	return m_frameMetrics.getMinimumCushion();
 }
 
+UnsignedInt ConnectionManager::getCommandRetries() {
+	UnsignedInt retries = 0;
+	for (Int i = 0; i < MAX_SLOTS; ++i) {
+		if (m_connections[i] != nullptr) {
+			retries += m_connections[i]->getTotalRetries();
+		}
+	}
+	return retries;
+}
+
 /**
  * The commands for the given frame are all ready, time to send out our command count for that frame.
  */
@@ -2583,6 +2596,7 @@ void ConnectionManager::requestFrameDataResend(Int playerID, UnsignedInt frame)
 
 	if (playerID < MAX_SLOTS) {
 		sendLocalCommandDirect(msg, 1 << playerID);
+		++m_frameResendRequests;
 	}
 
 	msg->detach();
@@ -0,0 +1,87 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: LoopbackNetwork.cpp //////////////////////////////////////////////////////////////////////
+// An in-memory stand-in for the UDP sockets of several Transports in the same process
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
+
+#include "GameNetwork/LoopbackNetwork.h"
+
+LoopbackNetwork::LoopbackNetwork( const Settings &settings ) :
+	m_settings( settings ),
+	m_seed( 12345 )
+{
+}
+
+Int LoopbackNetwork::random( Int range )
+{
+	if (range <= 0)
+		return 0;
+
+	m_seed = m_seed * 1664525 + 1013904223;
+	return (Int)((m_seed >> 8) % (UnsignedInt)range);
+}
+
+Int LoopbackNetwork::write( UnsignedInt fromAddr, UnsignedShort fromPort, const UnsignedByte *buf, Int len, UnsignedInt toAddr, UnsignedShort toPort )
+{
+	Statistics &sender = m_endpoints[ makeKey( fromAddr, fromPort ) ].m_statistics;
+	++sender.m_packetsSent;
+	sender.m_bytesSent += len;
+
+	if (random( 100 ) < m_settings.m_lossPercent)
+	{
+		++sender.m_packetsDropped;
+		return len;
+	}
+
+	UnsignedInt delay = m_settings.m_latency + random( m_settings.m_jitter + 1 );
+	if (random( 100 ) < m_settings.m_reorderPercent)
+	{
+		// long enough for the next few packets to overtake this one
+		delay += 1 + m_settings.m_jitter + random( m_settings.m_latency + 1 );
+	}
+
+	PacketQueue &inbox = m_endpoints[ makeKey( toAddr, toPort ) ].m_inbox;
+	PacketQueue::iterator it = inbox.insert( PacketQueue::value_type( timeGetTime() + delay, Packet() ) );
+	it->second.m_fromAddr = fromAddr;
+	it->second.m_fromPort = fromPort;
+	it->second.m_data.assign( buf, buf + len );
+
+	return len;
+}
+
+Int LoopbackNetwork::read( UnsignedInt addr, UnsignedShort port, UnsignedByte *buf, Int len, UnsignedInt &fromAddr, UnsignedShort &fromPort )
+{
+	Endpoint &endpoint = m_endpoints[ makeKey( addr, port ) ];
+	PacketQueue::iterator it = endpoint.m_inbox.begin();
+	if (it == endpoint.m_inbox.end() || (Int)(timeGetTime() - it->first) < 0)
+		return 0;
+
+	// a datagram that doesn't fit is truncated, like it would be by recvfrom
+	const Int size = min( len, (Int)it->second.m_data.size() );
+	memcpy( buf, &it->second.m_data[0], size );
+	fromAddr = it->second.m_fromAddr;
+	fromPort = it->second.m_fromPort;
+	endpoint.m_inbox.erase( it );
+
+	++endpoint.m_statistics.m_packetsReceived;
+	endpoint.m_statistics.m_bytesReceived += size;
+	return size;
+}
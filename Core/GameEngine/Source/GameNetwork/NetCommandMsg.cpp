@@ -114,9 +114,6 @@ NetGameCommandMsg::NetGameCommandMsg(GameMessage *msg) {
  * Destructor
  */
 NetGameCommandMsg::~NetGameCommandMsg() {
-	for (size_t i = 0; i < m_argList.size(); ++i) {
-		deleteInstance(m_argList[i]);
-	}
 }
 
 /**
@@ -124,9 +121,9 @@ NetGameCommandMsg::~NetGameCommandMsg() {
  */
 void NetGameCommandMsg::addArgument(const GameMessageArgumentDataType type, GameMessageArgumentType arg)
 {
-	GameMessageArgument *newArg = newInstance(GameMessageArgument);
-	newArg->m_data = arg;
-	newArg->m_type = type;
+	GameMessageArgument newArg;
+	newArg.m_data = arg;
+	newArg.m_type = type;
 	m_argList.push_back(newArg);
 }
 
@@ -156,7 +153,7 @@ GameMessage *NetGameCommandMsg::constructGameMessage() const
 	retval->friend_setPlayerIndex(ThePlayerList->getPlayerFromSlotIndex(getPlayerID())->getPlayerIndex());
 
 	for (size_t i = 0; i < m_argList.size(); ++i) {
-		const GameMessageArgument* arg = m_argList[i];
+		const GameMessageArgument* arg = &m_argList[i];
 		switch (arg->m_type) {
 
 		case ARGUMENTDATATYPE_INTEGER:
@@ -27,6 +27,7 @@
 
 #include "Common/crc.h"
 #include "GameNetwork/Transport.h"
+#include "GameNetwork/LoopbackNetwork.h"
 #include "GameNetwork/NetworkInterface.h"
 
 
@@ -71,6 +72,8 @@ Transport::Transport()
 {
 	m_winsockInit = false;
 	m_udpsock = nullptr;
+	m_loopback = nullptr;
+	m_loopbackAddr = 0;
 }
 
 Transport::~Transport()
@@ -142,6 +145,39 @@ Bool Transport::init( UnsignedInt ip, UnsignedShort port )
 	fflush(stderr); */
 
 	// ------- Clear buffers --------
+	clearBuffers();
+
+	m_port = port;
+
+#if defined(RTS_DEBUG)
+	if (TheGlobalData->m_latencyAverage > 0 || TheGlobalData->m_latencyNoise)
+		m_useLatency = true;
+
+	if (TheGlobalData->m_packetLoss)
+		m_usePacketLoss = true;
+#endif
+
+	return true;
+}
+
+// GeneralsX @feature 18/10/2026 The packets go through the loopback network instead of a socket.
+// They are still CRC'd and encrypted, so the traffic and the work per packet match a real game.
+Bool Transport::initLoopback( LoopbackNetwork *network, UnsignedInt ip, UnsignedShort port )
+{
+	reset();
+
+	m_loopback = network;
+	m_loopbackAddr = ip;
+	m_port = port;
+	m_useLatency = false;
+	m_usePacketLoss = false;
+
+	clearBuffers();
+	return m_loopback != nullptr;
+}
+
+void Transport::clearBuffers()
+{
 	int i=0;
 	for (; i<MAX_MESSAGES; ++i)
 	{
@@ -162,24 +198,13 @@ Bool Transport::init( UnsignedInt ip, UnsignedShort port )
 	}
 	m_statisticsSlot = 0;
 	m_lastSecond = timeGetTime();
-
-	m_port = port;
-
-#if defined(RTS_DEBUG)
-	if (TheGlobalData->m_latencyAverage > 0 || TheGlobalData->m_latencyNoise)
-		m_useLatency = true;
-
-	if (TheGlobalData->m_packetLoss)
-		m_usePacketLoss = true;
-#endif
-
-	return true;
 }
 
 void Transport::reset()
 {
 	delete m_udpsock;
 	m_udpsock = nullptr;
+	m_loopback = nullptr;
 
 	if (m_winsockInit)
 	{
@@ -205,7 +230,7 @@ Bool Transport::update()
 }
 
 Bool Transport::doSend() {
-	if (!m_udpsock)
+	if (!m_udpsock && !m_loopback)
 	{
 		DEBUG_LOG(("Transport::doSend() - m_udpSock is null!"));
 		return FALSE;
@@ -239,7 +264,7 @@ Bool Transport::doSend() {
 			// Therefore, transmitted data needs to add the extra bytes of the network header to the payloads length
 			int bytesToSend = m_outBuffer[i].length + sizeof(TransportMessageHeader);
 			// Send this message
-			if ((bytesSent = m_udpsock->Write((unsigned char *)(&m_outBuffer[i]), bytesToSend, m_outBuffer[i].addr, m_outBuffer[i].port)) > 0)
+			if ((bytesSent = writePacket((UnsignedByte *)(&m_outBuffer[i]), bytesToSend, m_outBuffer[i].addr, m_outBuffer[i].port)) > 0)
 			{
 				//DEBUG_LOG(("Sending %d bytes to %d.%d.%d.%d:%d", bytesToSend, PRINTF_IP_AS_4_INTS(m_outBuffer[i].addr), m_outBuffer[i].port));
 				m_outgoingPackets[m_statisticsSlot]++;
@@ -291,7 +316,7 @@ Bool Transport::doSend() {
 
 Bool Transport::doRecv()
 {
-	if (!m_udpsock)
+	if (!m_udpsock && !m_loopback)
 	{
 		DEBUG_LOG(("Transport::doRecv() - m_udpSock is null!"));
 		return FALSE;
@@ -313,7 +338,7 @@ Bool Transport::doRecv()
 	int len = MAX_NETWORK_MESSAGE_LEN;
 	size_t bufferIndex = 0;
 //	DEBUG_LOG(("Transport::doRecv - checking"));
-	while ( (len=m_udpsock->Read(buf, MAX_NETWORK_MESSAGE_LEN, &from)) > 0 )
+	while ( (len=readPacket(buf, MAX_NETWORK_MESSAGE_LEN, &from)) > 0 )
 	{
 #if defined(RTS_DEBUG)
 		// Packet loss simulation
@@ -446,6 +471,34 @@ Bool Transport::queueSend(UnsignedInt addr, UnsignedShort port, const UnsignedBy
 	return false;
 }
 
+Int Transport::writePacket( const UnsignedByte *buf, Int len, UnsignedInt addr, UnsignedShort port )
+{
+	if (m_loopback)
+		return m_loopback->write(m_loopbackAddr, m_port, buf, len, addr, port);
+
+	return m_udpsock->Write(buf, len, addr, port);
+}
+
+Int Transport::readPacket( UnsignedByte *buf, Int len, sockaddr_in *from )
+{
+	if (m_loopback)
+	{
+		UnsignedInt fromAddr = 0;
+		UnsignedShort fromPort = 0;
+		const Int size = m_loopback->read(m_loopbackAddr, m_port, buf, len, fromAddr, fromPort);
+		if (size > 0)
+		{
+			memset(from, 0, sizeof(*from));
+			from->sin_family = AF_INET;
+			from->sin_addr.s_addr = htonl(fromAddr);
+			from->sin_port = htons(fromPort);
+		}
+		return size;
+	}
+
+	return m_udpsock->Read(buf, len, from);
+}
+
 Bool Transport::isGeneralsPacket( TransportMessage *msg )
 {
 	if (!msg)
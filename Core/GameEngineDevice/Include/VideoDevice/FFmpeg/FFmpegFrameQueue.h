@@ -0,0 +1,144 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: FFmpegFrameQueue.h ///////////////////////////////////////////////////////////////////////
+// The frames and audio samples of a video, decoded ahead of playback
+// GeneralsX @performance 18/10/2026 FFmpegVideoStream::frameNext decoded packets until the next
+// picture on the thread playing the video, and frameRender then scaled the picture into the locked
+// video buffer, so the menu, briefing and control bar videos stalled the frames they advanced on. The
+// queue decodes a few pictures ahead on a worker thread and converts them to the pixel format of the
+// video buffer there, so playback only copies a ready frame. The audio samples decoded along the way
+// wait in a ring buffer until the thread playing the video hands them to the audio stream.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Lib/BaseType.h"
+#include "GameClient/VideoPlayer.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class FFmpegFile;
+struct AVFrame;
+struct SwsContext;
+
+class FFmpegFrameQueue
+{
+public:
+
+	struct Frame
+	{
+		AVFrame *picture;									///< the decoded picture
+		std::vector<UnsignedByte> pixels;	///< the picture converted for the target buffer
+		VideoBuffer::Type format;					///< format of the pixels, TYPE_UNKNOWN if the picture was not converted
+		Int width;
+		Int height;
+		Int pitch;
+		Int frameNumber;									///< pictures the decoder had produced with this one
+		Int64 decodeMicroseconds;					///< time spent decoding and converting the picture
+	};
+
+	// Sets itself as the frame callback of the file, which must outlive the queue. Starts decoding on
+	// the worker thread if decodeAhead is set, otherwise each frame is decoded when it is asked for.
+	FFmpegFrameQueue(FFmpegFile *file, Bool decodeAhead);
+	~FFmpegFrameQueue();
+
+	// The buffer the pictures decoded from now on are converted for by the worker thread
+	void setTarget(VideoBuffer::Type format, Int width, Int height, Int pitch);
+
+	// The next frame of the video, waiting for the worker thread if it has not decoded it yet. Returns
+	// nullptr at the end of the video. The frame belongs to the caller until it is released.
+	Frame *nextFrame();
+	void releaseFrame(Frame *frame);
+
+	// Forgets the frames and samples decoded so far and seeks the file
+	void seekFrame(Int index);
+
+	// The format of the samples, FALSE until the first ones are decoded
+	Bool getAudioFormat(Int *sampleRate, Int *numChannels, Int *bitsPerSample) const;
+
+	// Removes up to maxBytes of interleaved samples from the ring buffer, returns the bytes removed
+	Int readAudio(UnsignedByte *data, Int maxBytes);
+
+	Bool isDecodingAhead() const { return m_isDecodingAhead; }
+
+	// Scales the picture into dest in the pixel format of the buffer. Returns FALSE if the format is
+	// not supported or the picture could not be scaled.
+	static Bool convertPicture(SwsContext **context, const AVFrame *picture, VideoBuffer::Type format, Int width, Int height, Int pitch, UnsignedByte *dest);
+	static Bool isFormatSupported(VideoBuffer::Type format);
+
+	// Turns decoding ahead off for the streams opened from now on, to compare against the original
+	// playback
+	static void setDecodeAheadEnabled(Bool enabled) { s_isDecodeAheadEnabled = enabled; }
+	static Bool isDecodeAheadEnabled() { return s_isDecodeAheadEnabled; }
+
+private:
+
+	enum
+	{
+		MAX_READY_FRAMES = 4,						///< pictures the worker thread decodes ahead of playback
+		MIN_AUDIO_RING_BYTES = 0x10000,
+		MAX_AUDIO_RING_BYTES = 0x200000			///< about ten seconds of 48 kHz 16 bit stereo
+	};
+
+	static void onFrame(AVFrame *frame, int stream_idx, int stream_type, void *user_data);
+	void addPicture(AVFrame *frame);
+	void addSamples(AVFrame *frame);
+	void writeAudio(const UnsignedByte *data, Int numBytes);
+	Bool decodePicture();
+	void startWorker();
+	void stopWorker();
+	void runWorker();
+	void clearFrames();
+
+	FFmpegFile *m_file;
+	Bool m_isDecodingAhead;
+
+	// touched only by the thread decoding the file
+	Bool m_gotPicture;
+	Int64 m_decodeStart;
+	SwsContext *m_swsContext;
+	std::vector<UnsignedByte> m_sampleBuffer;	///< the samples of one audio frame, interleaved
+
+	// guarded by m_mutex
+	mutable std::mutex m_mutex;
+	std::condition_variable m_frameReady;	///< a frame was queued or the file ended
+	std::condition_variable m_wakeWorker;	///< a frame was taken or the worker must stop
+	std::thread m_worker;
+	Bool m_stopWorker;
+	Bool m_isFinished;
+	std::deque<Frame *> m_readyFrames;
+	std::vector<Frame *> m_freeFrames;
+	VideoBuffer::Type m_targetFormat;
+	Int m_targetWidth;
+	Int m_targetHeight;
+	Int m_targetPitch;
+
+	std::vector<UnsignedByte> m_audioRing;
+	Int m_audioRead;
+	Int m_audioBytes;
+	Int m_sampleRate;
+	Int m_numChannels;
+	Int m_bitsPerSample;
+
+	static Bool s_isDecodeAheadEnabled;
+};
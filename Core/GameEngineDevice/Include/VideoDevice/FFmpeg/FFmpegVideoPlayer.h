@@ -33,13 +33,15 @@
 //----------------------------------------------------------------------------
 
 #include "GameClient/VideoPlayer.h"
+#include "VideoDevice/FFmpeg/FFmpegFrameQueue.h"
+
+#include <vector>
 
 //----------------------------------------------------------------------------
 //           Forward References
 //----------------------------------------------------------------------------
 
 class FFmpegFile;
-struct AVFrame;
 struct SwsContext;
 
 //----------------------------------------------------------------------------
@@ -56,18 +58,22 @@ class FFmpegVideoStream : public VideoStream
 
 	protected:
 		Bool 			m_good = true;			///< Is the stream valid
-		Bool 			m_gotFrame = false;		///< Is the frame ready to be displayed
-		AVFrame 		*m_frame = nullptr;		///< Current frame
-		SwsContext 		*m_swsContext = nullptr;///< SWSContext for scaling
+		FFmpegFrameQueue::Frame *m_frame = nullptr;	///< Current frame
+		SwsContext 		*m_swsContext = nullptr;///< SWSContext for scaling the frames the worker did not convert
 		FFmpegFile		*m_ffmpegFile;			///< The AVUI abstraction											///< Bink streaming handle;
+		FFmpegFrameQueue	*m_frameQueue = nullptr;	///< Frames and samples decoded ahead of playback
 		Char			*m_memFile;				///< Pointer to memory resident file
 		UnsignedInt64	m_startTime = 0;		///< Time the stream started
-		UnsignedByte *	m_audioBuffer = nullptr;///< Audio buffer for the stream
+		Int				m_width = 0;			///< Video width, read before the worker starts decoding
+		Int				m_height = 0;			///< Video height, read before the worker starts decoding
+		Int				m_frameCount = 0;		///< Frames in the video, read before the worker starts decoding
+		UnsignedInt		m_frameTime = 0;		///< Milliseconds each frame is shown
+		std::vector<UnsignedByte> m_pendingAudio;	///< Samples the audio stream had no room for yet
 
 		FFmpegVideoStream(FFmpegFile* file);																///< only BinkVideoPlayer can create these
 		virtual ~FFmpegVideoStream();
 
-		static void onFrame(AVFrame *frame, int stream_idx, int stream_type, void *user_data);
+		void bufferAudio();										///< Hand the decoded samples to the audio stream
 	public:
 
 		virtual void update();											///< Update bink stream
@@ -122,6 +128,8 @@ class FFmpegVideoPlayer : public VideoPlayer
 
 		virtual void notifyVideoPlayerOfNewProvider( Bool nowHasValid );
 		virtual void initializeBinkWithMiles();
+
+		virtual Int benchmarkPlayback( Int frames );	///< Play the videos with and without decoding ahead, see -benchmarkVideos
 };
 
 
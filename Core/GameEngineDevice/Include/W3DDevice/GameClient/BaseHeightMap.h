@@ -207,6 +207,9 @@ public:
 	Real getMaxCellHeight(Real x, Real y) const;	///< returns maximum height of the 4 cell corners.
 	WorldHeightMap *getMap() {return m_map;}	///< returns object holding the heightmap samples - need this for fast access.
 	Bool isClearLineOfSight(const Coord3D& pos, const Coord3D& posOther) const;
+	// GeneralsX @performance 18/10/2026 Compares the checks that use the cell height pyramid of the
+	// logic height map with the cell by cell walk.
+	Bool benchmarkLineOfSight(Int checks) const;	///< returns false if the pyramid answers differ from the cell by cell walk
 
 	Bool getShowImpassableAreas() {return m_showImpassableAreas;}
 	void setShowImpassableAreas(Bool show) {m_showImpassableAreas = show;}
@@ -224,6 +227,7 @@ public:
 	virtual int updateBlock(Int x0, Int y0, Int x1, Int y1, WorldHeightMap *pMap, RefRenderObjListIterator *pLightsIterator) = 0;
 
 protected:
+	Bool isClearLineOfSightOnMap(WorldHeightMap *logicHeightMap, const Coord3D& pos, const Coord3D& posOther, Bool useCellHeightPyramid) const;
 	void scheduleFullUpdate();
 
 	// snapshot methods
@@ -0,0 +1,145 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: W3DShadowSilhouette.h ////////////////////////////////////////////////////////////////////
+// The faces of a shadow casting mesh and the silhouette edges they show to a light
+// GeneralsX @performance 18/10/2026 W3DVolumetricShadow::buildSilhouette walked the polygon neighbor
+// structures of the mesh and fetched the normal and a vertex of every face whenever a unit turned.
+// The faces are now kept in separate arrays and tested four at a time, big meshes are shared with
+// worker threads, and the meshes remember the last silhouettes they built, so the units that share a
+// model and face the same way under the same sun reuse one silhouette instead of building their own.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "WWMath/vector3.h"
+#include "Lib/BaseType.h"
+
+#include <vector>
+
+class W3DShadowSilhouette
+{
+public:
+
+	enum { NO_NEIGHBOR = -1 };
+
+	W3DShadowSilhouette();
+
+	// Allocates the faces, they must all be set before the first silhouette is built
+	void allocate(Int numFaces);
+	Bool isAllocated() const { return !m_faces.empty(); }
+	Int getNumFaces() const { return (Int)m_faces.size(); }
+
+	// The three vertex indices of the face in counter clockwise order, the first vertex and the normal
+	void setFace(Int face, const Short *vertexIndices, const Vector3 &vertex, const Vector3 &normal);
+
+	// A neighbor slot of the face: the polygon on the other side of the shared edge, or NO_NEIGHBOR
+	void setNeighbor(Int face, Int slot, Short neighborFace, Short edgeStart, Short edgeEnd);
+
+	// The silhouette edges seen from the light, in object space, as pairs of vertex indices in the
+	// order buildSilhouette always added them. With the cache enabled the light is first rounded to
+	// a step of its direction and distance, so the edges may be the ones of a nearby light. The
+	// reference stays valid until the next call.
+	const std::vector<Short> &getEdges(const Vector3 &lightPos);
+
+	// The edges seen from exactly this light, never cached
+	void buildEdges(const Vector3 &lightPos, std::vector<Short> &edges);
+
+	// Forgets the silhouettes built so far
+	void clearCache();
+
+	// The light the silhouettes of lightPos are built from while the cache is enabled. Returns FALSE
+	// if the light can not be rounded, its silhouette is then not cached.
+	static Bool getCachedLight(const Vector3 &lightPos, Vector3 *cachedLight);
+
+	// Turns the silhouette cache off, to check the cached silhouettes against the exact ones
+	static void setCacheEnabled(Bool enabled) { s_isCacheEnabled = enabled; }
+	static Bool isCacheEnabled() { return s_isCacheEnabled; }
+
+	// Silhouettes found in and missing from the caches of all meshes so far
+	static UnsignedInt getCacheHits() { return s_cacheHits; }
+	static UnsignedInt getCacheMisses() { return s_cacheMisses; }
+
+	// Stops the worker threads, they are started again when a big mesh needs them
+	static void shutdown();
+
+	// Builds the silhouettes of generated meshes from many lights and checks the face tests, the
+	// cached silhouettes and the threaded ones against the original polygon neighbor walk. Prints the
+	// timings and returns the exit code.
+	static Int benchmark(Int rounds);
+
+	// Name of the instruction set the faces are tested with
+	static const char *getBatchName();
+
+	// Sets visible[face] to 1 for each face from first to last, exclusive, whose front the light sees
+	// and to 0 for the others. first must be a multiple of 4.
+	void classifyFaces(const Vector3 &lightPos, UnsignedByte *visible, Int first, Int last) const;
+
+private:
+
+	enum
+	{
+		MAX_CACHED_SILHOUETTES = 32,		///< silhouettes each mesh remembers
+		MIN_FACES_TO_SHARE = 4096,		///< meshes with fewer faces are tested on the render thread alone
+		FACES_PER_CLAIM = 1024				///< faces a worker thread tests at a time, a multiple of 4
+	};
+
+	struct Neighbor
+	{
+		Short face;			///< index of the neighbor polygon, NO_NEIGHBOR if there is none
+		Short edge[2];	///< the two vertex indices of the shared edge
+	};
+
+	struct Face
+	{
+		Short vertex[3];
+		Neighbor neighbor[3];
+	};
+
+	struct CachedSilhouette
+	{
+		Int key[4];										///< rounded light direction and distance
+		UnsignedInt lastUse;
+		std::vector<Short> edges;
+	};
+
+	static Bool makeLightKey(const Vector3 &lightPos, Int *key, Vector3 *cachedLight);
+	void classify(const Vector3 &lightPos);
+	void findEdges(std::vector<Short> &edges) const;
+	void addEdge(Int visibleFace, Int hiddenFace, std::vector<Short> &edges) const;
+	void addNeighborlessEdges(Int face, std::vector<Short> &edges) const;
+
+	// the first vertex and the normal of each face, padded to a multiple of 4 faces
+	std::vector<Real> m_vertexX;
+	std::vector<Real> m_vertexY;
+	std::vector<Real> m_vertexZ;
+	std::vector<Real> m_normalX;
+	std::vector<Real> m_normalY;
+	std::vector<Real> m_normalZ;
+	std::vector<Face> m_faces;
+	std::vector<UnsignedByte> m_visible;	///< 1 for each face the last light saw the front of
+	std::vector<Short> m_edges;						///< the silhouette of the last light that was not cached
+
+	CachedSilhouette m_cache[MAX_CACHED_SILHOUETTES];
+	Int m_numCached;
+	UnsignedInt m_useCount;
+
+	static Bool s_isCacheEnabled;
+	static UnsignedInt s_cacheHits;
+	static UnsignedInt s_cacheMisses;
+};
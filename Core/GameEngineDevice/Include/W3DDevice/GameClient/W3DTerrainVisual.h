@@ -90,6 +90,7 @@ public:
 	virtual void addWaterVelocity( Real worldX, Real worldY,
 																 Real velocity, Real preferredHeight ) override;
 	virtual Bool getWaterGridHeight( Real worldX, Real worldY, Real *height) override;
+	virtual Bool benchmarkWaterGrid( Int steps ) override;
 
 	virtual void setTerrainTracksDetail() override;
 	virtual void setShoreLineDetail() override;
@@ -330,6 +330,8 @@ private:
 	void zoomCameraOneFrame();							///< Do one frame of a zoom camera movement.
 	void pitchCameraOneFrame();							///< Do one frame of a pitch camera movement.
 	void getAxisAlignedViewRegion(Region3D &axisAlignedRegion);	///< Find 3D Region enclosing all possible drawables.
+	Bool isDrawableInNormalizedRegion( const Drawable *draw, const Region2D &normalizedRegion );	///< Does the drawable center project into the region
+	Bool collectDrawablesInScreenRegion( const IRegion2D *screenRegion, std::vector<DrawableID> &candidates );	///< Drawables from the grid that could project into the region
 	void calcDeltaScroll(Coord2D &screenDelta);
 	bool getDesiredTerrainDrawSize(ICoord2D &dimensions) const;
 	void updateTerrain();
@@ -37,6 +37,7 @@
 #include "Lib/BaseType.h"
 #include "Common/GameType.h"
 #include "Common/Snapshot.h"
+#include "W3DDevice/GameClient/W3DWaterGrid.h"
 
 #define INVALID_WATER_HEIGHT 0.0f	///water height guaranteed to be below all terrain.
 
@@ -119,7 +120,7 @@ public:
 	void getGridResolution(Real *gridCellsX, Real *gridCellsY, Real *cellSize);  ///<get grid resolution params
 	inline void setGridVertexHeight(Int x, Int y, Real value);
 	void getGridVertexHeight(Int x, Int y, Real *value)
-	{	if (m_meshData)	*value=m_meshData[(y+1)*(m_gridCellsX+1+2)+x+1].height+ Get_Position().Z;}
+	{	if (m_meshGrid.isAllocated())	*value=m_meshGrid.getHeight(m_meshGrid.getIndex(x+1,y+1))+ Get_Position().Z;}
 	inline Bool worldToGridSpace(Real worldX, Real worldY, Real &gridX, Real &gridY);	///<convert from world coordinates to grid's local coordinate system.
 
 	void replaceSkyboxTexture(const AsciiString& oldTexName, const AsciiString& newTextName);
@@ -171,20 +172,9 @@ protected:
 	RenderObjClass	*m_skyBox;		///<box around level
 	WaterTracksRenderSystem *m_waterTrackSystem;	///<object responsible for rendering water wakes
 
-	enum WaterMeshStatus
-	{
-		AT_REST = 0x00,
-		IN_MOTION = 0x01
-	};
-	struct WaterMeshData
-	{
-		Real height;										///< height of the 3D mesh at this point
-		Real velocity;									///< velocity in Z that this point is moving up and down
-		UnsignedByte status;						///< status for this grid point
-		UnsignedByte preferredHeight;		///< the hight we prefer to be
-	};
-	WaterMeshData *m_meshData;  ///< heightmap data for 3D Mesh based water.
-	UnsignedInt m_meshDataSize;	///< size of m_meshData
+	// GeneralsX @performance 18/10/2026 The mesh points are kept in separate arrays by W3DWaterGrid,
+	// which only steps the rectangle around the points in motion.
+	W3DWaterGrid m_meshGrid;  ///< heightmap data for 3D Mesh based water.
 	Bool m_meshInMotion;				///< TRUE once we've messed with velocities and are in motion
 	Bool m_doWaterGrid;	///< allows/prevents water grid rendering.
 
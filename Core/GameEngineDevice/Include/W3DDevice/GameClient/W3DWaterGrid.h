@@ -0,0 +1,104 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: W3DWaterGrid.h ///////////////////////////////////////////////////////////////////////////
+// The points of the vertex animated water mesh and their motion
+// GeneralsX @performance 18/10/2026 WaterRenderObjClass::update walked every point of the grid each
+// frame while any of them moved. The point fields are now kept in separate arrays and only the
+// rectangle around the moving points is walked, four points at a time.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Lib/BaseType.h"
+
+#include <vector>
+
+class W3DWaterGrid
+{
+public:
+
+	enum Status
+	{
+		AT_REST = 0x00,
+		IN_MOTION = 0x01
+	};
+
+	W3DWaterGrid();
+
+	// Allocates the points, border included, and puts them all at rest
+	void allocate(Int pointsX, Int pointsY);
+	void release();
+	Bool isAllocated() const { return !m_heights.empty(); }
+
+	// Puts all points at rest at height 0
+	void reset();
+
+	Int getPointsX() const { return m_pointsX; }
+	Int getPointsY() const { return m_pointsY; }
+	Int getPointCount() const { return m_pointsX * m_pointsY; }
+	Int getIndex(Int pointX, Int pointY) const { return pointY * m_pointsX + pointX; }
+
+	// The heights of all points in rows of getPointsX, for the renderer
+	const Real *getHeights() const { return &m_heights[0]; }
+	Real getHeight(Int index) const { return m_heights[index]; }
+	void setHeight(Int index, Real height) { m_heights[index] = height; }
+	Real *getHeightPtr(Int index) { return &m_heights[index]; }
+
+	Real getVelocity(Int index) const { return m_velocities[index]; }
+	UnsignedByte getStatus(Int index) const { return m_status[index]; }
+	UnsignedByte getPreferredHeight(Int index) const { return (UnsignedByte)m_preferredHeights[index]; }
+
+	// Overwrites all fields of a point. Call updateMotionBounds once all points are set.
+	void setPoint(Int index, Real height, Real velocity, UnsignedByte status, UnsignedByte preferredHeight);
+	void updateMotionBounds();
+
+	// Adds velocity to a point and sets it in motion towards its new preferred height
+	void addVelocity(Int pointX, Int pointY, Real velocity, UnsignedByte preferredHeight);
+
+	// Moves the points in motion by one step. Returns TRUE while any point is still in motion.
+	Bool update(Real gravity);
+
+	// The original step over every point of the grid, to check update against
+	Bool updateAllPoints(Real gravity);
+
+	// Runs random splashes on two grids, one stepped with update and one with updateAllPoints.
+	// Prints the timings and returns false if the grids ever differ.
+	static Bool benchmark(Int steps, Real gravity);
+
+	// Name of the instruction set update uses
+	static const char *getBatchName();
+
+private:
+
+	Bool hasMotion() const { return m_motionMinX <= m_motionMaxX; }
+	void clearMotionBounds();
+
+	std::vector<Real> m_heights;						///< height of the 3D mesh at each point
+	std::vector<Real> m_velocities;					///< velocity in Z that each point is moving up and down
+	std::vector<Real> m_preferredHeights;		///< the height each point prefers to be, always a whole number from 0 to 255
+	std::vector<UnsignedByte> m_status;			///< status of each point
+	Int m_pointsX;
+	Int m_pointsY;
+
+	// Inclusive rectangle of points that holds every point in motion. Empty when min is above max.
+	Int m_motionMinX;
+	Int m_motionMaxX;
+	Int m_motionMinY;
+	Int m_motionMaxY;
+};
@@ -94,6 +94,7 @@ struct DataChunkInfo;
 class TerrainTextureClass;
 class AlphaTerrainTextureClass;
 class AlphaEdgeTextureClass;
+class TerrainTileDecoder;
 
 #define NUM_ALPHA_TILES 12
 
@@ -156,6 +157,7 @@ protected:
 
 	TileData			*m_sourceTiles[NUM_SOURCE_TILES];	///< Tiles for m_textureClasses
 	TileData			*m_edgeTiles[NUM_SOURCE_TILES];	///< Tiles for m_textureClasses
+	TerrainTileDecoder	*m_tileDecoder;	///< Decodes the tiles while the map is read, only set in the constructor
 
 	TBlendTileInfo	m_blendedTiles[NUM_BLEND_TILES];
 	TBlendTileInfo	m_extraBlendedTiles[NUM_BLEND_TILES];
@@ -206,7 +208,7 @@ protected:
 	void getUVForNdx(Int ndx, float *minU, float *minV, float *maxU, float*maxV);
 	Bool getUVForTileIndex(Int ndx, Short tileNdx, float U[4], float V[4]);
 	Int getTextureClassFromNdx(Int tileNdx);
-	void readTexClass(TXTextureClass *texClass, TileData **tileData);
+	void readTexClass(TXTextureClass *texClass, TileData **tileData, TerrainTileDecoder &decoder);
 	Int updateTileTexturePositions(Int *edgeHeight); ///< Places each tile in the texture.
 	void initCliffFlagsFromHeights();
 	void setCellCliffFlagFromHeights(Int xIndex, Int yIndex);
@@ -328,6 +330,28 @@ public:  // modify height value
 		Int ndx = (yIndex*m_width)+xIndex;
 		if ((ndx>=0) && (ndx<m_dataSize) && m_data) m_data[ndx]=height;
 	};
+
+public:  // cell height pyramid for the line of sight checks
+	// GeneralsX @performance 18/10/2026 Level 0 holds the highest of the 4 corners of each cell,
+	// each level above the lowest and highest of 2x2 tiles of the level below. Only the logic
+	// height map builds it, other height maps check line of sight cell by cell.
+	void buildCellHeightPyramid();
+	void updateCellHeightPyramid(Int xIndex, Int yIndex);	///< the height at xIndex, yIndex changed
+	Bool hasCellHeightPyramid() const { return !m_cellHeightLevels.empty(); }
+	/// The lowest and highest cell heights of the pyramid tiles covering the cells. Returns false
+	/// if the cells need more than 2x2 tiles of the top level.
+	Bool getCellHeightRange(Int loX, Int loY, Int hiX, Int hiY, UnsignedByte *lowest, UnsignedByte *highest) const;
+
+protected:
+	struct CellHeightLevel
+	{
+		Int width;
+		Int height;
+		std::vector<UnsignedByte> lowest;
+		std::vector<UnsignedByte> highest;
+	};
+	std::vector<CellHeightLevel> m_cellHeightLevels;
+	void updateCellHeightTile(Int level, Int tileX, Int tileY);
 public: // Read tile utilities. jba [7/9/2003]
 	// GeneralsX @feature mrkinglollipop 11/07/2026 Adds expectedTileCount/pIsLegacyGrid so the caller's
 	// INI-declared tile count can disambiguate legacy 64px-grid TGAs from native
@@ -0,0 +1,462 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: FFmpegFrameQueue.cpp /////////////////////////////////////////////////////////////////////
+// The frames and audio samples of a video, decoded ahead of playback
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "VideoDevice/FFmpeg/FFmpegFrameQueue.h"
+
+#include "Common/GameMemory.h"
+#include "VideoDevice/FFmpeg/FFmpegFile.h"
+
+extern "C" {
+	#include <libavcodec/avcodec.h>
+	#include <libswscale/swscale.h>
+}
+
+#include <chrono>
+#include <string.h>
+
+Bool FFmpegFrameQueue::s_isDecodeAheadEnabled = TRUE;
+
+namespace
+{
+Int64 getMicroseconds()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+AVPixelFormat getPixelFormat(VideoBuffer::Type format)
+{
+	switch (format) {
+		case VideoBuffer::TYPE_R8G8B8:
+			return AV_PIX_FMT_RGB24;
+		case VideoBuffer::TYPE_X8R8G8B8:
+			return AV_PIX_FMT_BGR0;
+		case VideoBuffer::TYPE_R5G6B5:
+			return AV_PIX_FMT_RGB565;
+		case VideoBuffer::TYPE_X1R5G5B5:
+			return AV_PIX_FMT_RGB555;
+		default:
+			return AV_PIX_FMT_NONE;
+	}
+}
+} // namespace
+
+FFmpegFrameQueue::FFmpegFrameQueue(FFmpegFile *file, Bool decodeAhead) :
+	m_file(file),
+	m_isDecodingAhead(decodeAhead),
+	m_gotPicture(FALSE),
+	m_decodeStart(0),
+	m_swsContext(nullptr),
+	m_stopWorker(FALSE),
+	m_isFinished(FALSE),
+	m_targetFormat(VideoBuffer::TYPE_UNKNOWN),
+	m_targetWidth(0),
+	m_targetHeight(0),
+	m_targetPitch(0),
+	m_audioRead(0),
+	m_audioBytes(0),
+	m_sampleRate(0),
+	m_numChannels(0),
+	m_bitsPerSample(0)
+{
+	m_file->setFrameCallback(onFrame);
+	m_file->setUserData(this);
+
+	if (m_isDecodingAhead)
+		startWorker();
+}
+
+FFmpegFrameQueue::~FFmpegFrameQueue()
+{
+	stopWorker();
+	m_file->setFrameCallback(nullptr);
+	m_file->setUserData(nullptr);
+
+	clearFrames();
+	for (Frame *frame : m_freeFrames)
+	{
+		av_frame_free(&frame->picture);
+		delete frame;
+	}
+	m_freeFrames.clear();
+
+	sws_freeContext(m_swsContext);
+}
+
+void FFmpegFrameQueue::startWorker()
+{
+	m_stopWorker = FALSE;
+	m_worker = std::thread(&FFmpegFrameQueue::runWorker, this);
+}
+
+void FFmpegFrameQueue::stopWorker()
+{
+	if (!m_worker.joinable())
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopWorker = TRUE;
+	}
+	m_wakeWorker.notify_all();
+	m_worker.join();
+	m_stopWorker = FALSE;
+}
+
+void FFmpegFrameQueue::runWorker()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (!m_stopWorker && !m_isFinished)
+	{
+		if ((Int)m_readyFrames.size() >= MAX_READY_FRAMES)
+		{
+			m_wakeWorker.wait(lock);
+			continue;
+		}
+
+		lock.unlock();
+		const Bool good = decodePicture();
+		lock.lock();
+
+		if (!good)
+		{
+			m_isFinished = TRUE;
+			m_frameReady.notify_all();
+		}
+	}
+}
+
+Bool FFmpegFrameQueue::decodePicture()
+{
+	// the same loop frameNext ran, a picture is queued from the frame callback
+	m_gotPicture = FALSE;
+	m_decodeStart = getMicroseconds();
+	while (!m_gotPicture)
+	{
+		if (!m_file->decodePacket())
+			return FALSE;
+	}
+	return TRUE;
+}
+
+void FFmpegFrameQueue::onFrame(AVFrame *frame, int stream_idx, int stream_type, void *user_data)
+{
+	FFmpegFrameQueue *queue = static_cast<FFmpegFrameQueue *>(user_data);
+	if (stream_type == AVMEDIA_TYPE_VIDEO)
+		queue->addPicture(frame);
+	else if (stream_type == AVMEDIA_TYPE_AUDIO)
+		queue->addSamples(frame);
+}
+
+void FFmpegFrameQueue::addPicture(AVFrame *frame)
+{
+	Frame *entry = nullptr;
+	VideoBuffer::Type format;
+	Int width, height, pitch;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (!m_freeFrames.empty())
+		{
+			entry = m_freeFrames.back();
+			m_freeFrames.pop_back();
+		}
+		format = m_targetFormat;
+		width = m_targetWidth;
+		height = m_targetHeight;
+		pitch = m_targetPitch;
+	}
+
+	if (entry == nullptr)
+	{
+		entry = NEW Frame;
+		entry->picture = av_frame_alloc();
+	}
+
+	av_frame_unref(entry->picture);
+	av_frame_ref(entry->picture, frame);
+	entry->frameNumber = m_file->getCurrentFrame();
+	entry->format = VideoBuffer::TYPE_UNKNOWN;
+
+	// without a worker the picture is converted in frameRender, as it always was
+	if (m_isDecodingAhead && format != VideoBuffer::TYPE_UNKNOWN)
+	{
+		entry->pixels.resize(pitch * height);
+		if (convertPicture(&m_swsContext, frame, format, width, height, pitch, entry->pixels.data()))
+		{
+			entry->format = format;
+			entry->width = width;
+			entry->height = height;
+			entry->pitch = pitch;
+		}
+	}
+	entry->decodeMicroseconds = getMicroseconds() - m_decodeStart;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_readyFrames.push_back(entry);
+	}
+	m_frameReady.notify_all();
+	m_gotPicture = TRUE;
+}
+
+void FFmpegFrameQueue::addSamples(AVFrame *frame)
+{
+	AVSampleFormat sampleFmt = static_cast<AVSampleFormat>(frame->format);
+	const int bytesPerSample = av_get_bytes_per_sample(sampleFmt);
+	const int frameSize = av_samples_get_buffer_size(nullptr, frame->ch_layout.nb_channels, frame->nb_samples, sampleFmt, 1);
+	if (frameSize <= 0 || bytesPerSample <= 0 || frame->ch_layout.nb_channels <= 0 || frame->nb_samples <= 0)
+		return;
+
+	int outputBitsPerSample = bytesPerSample * 8;
+	int outputFrameSize = frameSize;
+	const uint8_t *frameData = frame->data[0];
+
+	// Convert float32 FFmpeg output to PCM16 for robust OpenAL compatibility.
+	if (sampleFmt == AV_SAMPLE_FMT_FLT || sampleFmt == AV_SAMPLE_FMT_FLTP)
+	{
+		outputBitsPerSample = 16;
+		outputFrameSize = frame->nb_samples * frame->ch_layout.nb_channels * (int)sizeof(int16_t);
+		m_sampleBuffer.resize(outputFrameSize);
+		int16_t *dst = reinterpret_cast<int16_t *>(m_sampleBuffer.data());
+		if (sampleFmt == AV_SAMPLE_FMT_FLTP)
+		{
+			for (int sample_idx = 0; sample_idx < frame->nb_samples; ++sample_idx)
+			{
+				for (int channel_idx = 0; channel_idx < frame->ch_layout.nb_channels; ++channel_idx)
+				{
+					const float sample = reinterpret_cast<const float *>(frame->data[channel_idx])[sample_idx];
+					const float clamped = (sample < -1.0f) ? -1.0f : ((sample > 1.0f) ? 1.0f : sample);
+					*dst++ = static_cast<int16_t>(clamped * 32767.0f);
+				}
+			}
+		}
+		else
+		{
+			const float *src = reinterpret_cast<const float *>(frame->data[0]);
+			const int totalSamples = frame->nb_samples * frame->ch_layout.nb_channels;
+			for (int i = 0; i < totalSamples; ++i)
+			{
+				const float clamped = (src[i] < -1.0f) ? -1.0f : ((src[i] > 1.0f) ? 1.0f : src[i]);
+				*dst++ = static_cast<int16_t>(clamped * 32767.0f);
+			}
+		}
+		frameData = m_sampleBuffer.data();
+	}
+	// The format is planar - convert it to interleaved
+	else if (av_sample_fmt_is_planar(sampleFmt))
+	{
+		m_sampleBuffer.resize(outputFrameSize);
+		for (int sample_idx = 0; sample_idx < frame->nb_samples; sample_idx++)
+		{
+			int byte_offset = sample_idx * bytesPerSample;
+			for (int channel_idx = 0; channel_idx < frame->ch_layout.nb_channels; channel_idx++)
+			{
+				uint8_t *dst = &m_sampleBuffer[byte_offset * frame->ch_layout.nb_channels + channel_idx * bytesPerSample];
+				const uint8_t *src = &frame->data[channel_idx][byte_offset];
+				memcpy(dst, src, bytesPerSample);
+			}
+		}
+		frameData = m_sampleBuffer.data();
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_sampleRate = frame->sample_rate;
+	m_numChannels = frame->ch_layout.nb_channels;
+	m_bitsPerSample = outputBitsPerSample;
+	writeAudio(frameData, outputFrameSize);
+}
+
+void FFmpegFrameQueue::writeAudio(const UnsignedByte *data, Int numBytes)
+{
+	// the worker stays a few pictures ahead, so the ring grows to hold the samples of those instead of
+	// making the worker wait for a thread that may be waiting for a picture itself. Nothing reads the
+	// samples when there is no audio to play them on, so past MAX_AUDIO_RING_BYTES the oldest are dropped.
+	if (numBytes <= 0)
+		return;
+
+	const Int frameBytes = MAX(m_numChannels * m_bitsPerSample / 8, 1);
+	if (numBytes > MAX_AUDIO_RING_BYTES)
+	{
+		const Int skip = (numBytes - MAX_AUDIO_RING_BYTES + frameBytes - 1) / frameBytes * frameBytes;
+		data += skip;
+		numBytes -= skip;
+	}
+
+	const Int capacity = (Int)m_audioRing.size();
+	if (m_audioBytes + numBytes > capacity && capacity < MAX_AUDIO_RING_BYTES)
+	{
+		Int newCapacity = MAX(capacity * 2, (Int)MIN_AUDIO_RING_BYTES);
+		while (newCapacity < m_audioBytes + numBytes && newCapacity < MAX_AUDIO_RING_BYTES)
+			newCapacity *= 2;
+		newCapacity = MIN(newCapacity, (Int)MAX_AUDIO_RING_BYTES);
+
+		std::vector<UnsignedByte> ring(newCapacity);
+		const Int firstPart = MIN(m_audioBytes, capacity - m_audioRead);
+		if (firstPart > 0)
+			memcpy(ring.data(), m_audioRing.data() + m_audioRead, firstPart);
+		if (m_audioBytes > firstPart)
+			memcpy(ring.data() + firstPart, m_audioRing.data(), m_audioBytes - firstPart);
+		m_audioRing.swap(ring);
+		m_audioRead = 0;
+	}
+
+	const Int size = (Int)m_audioRing.size();
+	if (m_audioBytes + numBytes > size)
+	{
+		// drop whole sample frames so the channels stay in order
+		Int drop = (m_audioBytes + numBytes - size + frameBytes - 1) / frameBytes * frameBytes;
+		drop = MIN(drop, m_audioBytes);
+		m_audioRead = (m_audioRead + drop) % size;
+		m_audioBytes -= drop;
+	}
+
+	const Int write = (m_audioRead + m_audioBytes) % size;
+	const Int firstPart = MIN(numBytes, size - write);
+	memcpy(m_audioRing.data() + write, data, firstPart);
+	if (numBytes > firstPart)
+		memcpy(m_audioRing.data(), data + firstPart, numBytes - firstPart);
+	m_audioBytes += numBytes;
+}
+
+Int FFmpegFrameQueue::readAudio(UnsignedByte *data, Int maxBytes)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	const Int numBytes = MIN(maxBytes, m_audioBytes);
+	if (numBytes <= 0)
+		return 0;
+
+	const Int size = (Int)m_audioRing.size();
+	const Int firstPart = MIN(numBytes, size - m_audioRead);
+	memcpy(data, m_audioRing.data() + m_audioRead, firstPart);
+	if (numBytes > firstPart)
+		memcpy(data + firstPart, m_audioRing.data(), numBytes - firstPart);
+	m_audioRead = (m_audioRead + numBytes) % size;
+	m_audioBytes -= numBytes;
+	return numBytes;
+}
+
+Bool FFmpegFrameQueue::getAudioFormat(Int *sampleRate, Int *numChannels, Int *bitsPerSample) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	*sampleRate = m_sampleRate;
+	*numChannels = m_numChannels;
+	*bitsPerSample = m_bitsPerSample;
+	return m_numChannels > 0;
+}
+
+void FFmpegFrameQueue::setTarget(VideoBuffer::Type format, Int width, Int height, Int pitch)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_targetFormat = isFormatSupported(format) ? format : VideoBuffer::TYPE_UNKNOWN;
+	m_targetWidth = width;
+	m_targetHeight = height;
+	m_targetPitch = pitch;
+}
+
+FFmpegFrameQueue::Frame *FFmpegFrameQueue::nextFrame()
+{
+	if (!m_isDecodingAhead)
+	{
+		// decode on this thread, the frame callback queues the picture
+		if (m_readyFrames.empty() && !m_isFinished && !decodePicture())
+			m_isFinished = TRUE;
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	if (m_isDecodingAhead)
+		m_frameReady.wait(lock, [this] { return !m_readyFrames.empty() || m_isFinished; });
+
+	if (m_readyFrames.empty())
+		return nullptr;
+
+	Frame *frame = m_readyFrames.front();
+	m_readyFrames.pop_front();
+	lock.unlock();
+
+	m_wakeWorker.notify_one();
+	return frame;
+}
+
+void FFmpegFrameQueue::releaseFrame(Frame *frame)
+{
+	if (frame == nullptr)
+		return;
+
+	// keep the pixels for the next picture, the decoded one can go back to the decoder
+	av_frame_unref(frame->picture);
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_freeFrames.push_back(frame);
+}
+
+void FFmpegFrameQueue::clearFrames()
+{
+	for (Frame *frame : m_readyFrames)
+	{
+		av_frame_unref(frame->picture);
+		m_freeFrames.push_back(frame);
+	}
+	m_readyFrames.clear();
+}
+
+void FFmpegFrameQueue::seekFrame(Int index)
+{
+	stopWorker();
+
+	clearFrames();
+	m_audioRead = 0;
+	m_audioBytes = 0;
+	m_isFinished = FALSE;
+	m_file->seekFrame(index);
+
+	if (m_isDecodingAhead)
+		startWorker();
+}
+
+Bool FFmpegFrameQueue::isFormatSupported(VideoBuffer::Type format)
+{
+	return getPixelFormat(format) != AV_PIX_FMT_NONE;
+}
+
+Bool FFmpegFrameQueue::convertPicture(SwsContext **context, const AVFrame *picture, VideoBuffer::Type format, Int width, Int height, Int pitch, UnsignedByte *dest)
+{
+	const AVPixelFormat dst_pix_fmt = getPixelFormat(format);
+	if (dst_pix_fmt == AV_PIX_FMT_NONE)
+		return FALSE;
+
+	*context = sws_getCachedContext(*context,
+		picture->width,
+		picture->height,
+		static_cast<AVPixelFormat>(picture->format),
+		width,
+		height,
+		dst_pix_fmt,
+		SWS_BICUBIC,
+		nullptr,
+		nullptr,
+		nullptr);
+	if (*context == nullptr)
+		return FALSE;
+
+	int dst_strides[] = { (int)pitch };
+	uint8_t *dst_data[] = { dest };
+	const int result = sws_scale(*context, picture->data, picture->linesize, 0, picture->height, dst_data, dst_strides);
+	return result >= 0;
+}
@@ -55,7 +55,10 @@ extern "C" {
 #include "OpenALAudioDevice/OpenALAudioStream.h"
 #endif
 
+#include <algorithm>
 #include <chrono>
+#include <stdio.h>
+#include <thread>
 
 //----------------------------------------------------------------------------
 //         Externals
@@ -69,6 +72,7 @@ extern "C" {
 #define VIDEO_LANG_PATH_FORMAT "Data/%s/Movies/%s.%s"
 #define VIDEO_PATH	"Data\\Movies"
 #define VIDEO_EXT		"bik"
+#define MAX_AUDIO_CHUNK_BYTES	0x10000
 
 
 
@@ -76,6 +80,39 @@ extern "C" {
 //         Private Types
 //----------------------------------------------------------------------------
 
+namespace
+{
+/// Video buffer in memory, for playing videos without a device
+class MemoryVideoBuffer : public VideoBuffer
+{
+	public:
+		MemoryVideoBuffer() : VideoBuffer( TYPE_X8R8G8B8 ) {}
+
+		virtual	Bool allocate( UnsignedInt width, UnsignedInt height ) override
+		{
+			m_width = m_textureWidth = width;
+			m_height = m_textureHeight = height;
+			m_pitch = width * 4;
+			m_pixels.assign( m_pitch * height, 0 );
+			return TRUE;
+		}
+		virtual void free() override { m_pixels.clear(); }
+		virtual	void* lock() override { return m_pixels.empty() ? nullptr : m_pixels.data(); }
+		virtual void unlock() override {}
+		virtual Bool valid() override { return !m_pixels.empty(); }
+
+		UnsignedInt getChecksum() const
+		{
+			UnsignedInt hash = 2166136261u;
+			for ( UnsignedByte pixel : m_pixels )
+				hash = ( hash ^ pixel ) * 16777619u;
+			return hash;
+		}
+
+	private:
+		std::vector<UnsignedByte> m_pixels;
+};
+} // namespace
 
 
 //----------------------------------------------------------------------------
@@ -100,6 +137,24 @@ extern "C" {
 //         Private Functions
 //----------------------------------------------------------------------------
 
+static Int64 getMicroseconds()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void printLatencies( const char *name, std::vector<Int64> &latencies )
+{
+	if ( latencies.empty() )
+	{
+		printf( "  %s: no frames\n", name );
+		return;
+	}
+
+	std::sort( latencies.begin(), latencies.end() );
+	const size_t last = latencies.size() - 1;
+	printf( "  %s: %d frames, median %.3f ms, 90%% %.3f ms, 99%% %.3f ms, max %.3f ms\n", name, (Int)latencies.size(),
+		latencies[last / 2] / 1000.0, latencies[last * 90 / 100] / 1000.0, latencies[last * 99 / 100] / 1000.0, latencies[last] / 1000.0 );
+}
 
 
 //----------------------------------------------------------------------------
@@ -305,6 +360,88 @@ void FFmpegVideoPlayer::initializeBinkWithMiles()
 	}
 }
 
+
+//============================================================================
+// FFmpegVideoPlayer::benchmarkPlayback
+//============================================================================
+
+Int FFmpegVideoPlayer::benchmarkPlayback( Int frames )
+{
+	const Bool wasDecodingAhead = FFmpegFrameQueue::isDecodeAheadEnabled();
+	std::vector<Int64> frameLatencies[2];
+	std::vector<Int64> decodeLatencies[2];
+	Int numVideos = 0;
+	Int numMismatches = 0;
+
+	printf("Video playback: the first %d frames of each video, paced at its frame rate\n", frames);
+	fflush(stdout);
+
+	for (Int videoIndex = 0; videoIndex < getNumVideos(); ++videoIndex)
+	{
+		const Video *video = getVideo(videoIndex);
+		std::vector<UnsignedInt> checksums[2];
+		Bool isOpen = TRUE;
+
+		// the first run decodes and scales each frame on this thread as playback always did
+		for (Int run = 0; run < 2 && isOpen; ++run)
+		{
+			FFmpegFrameQueue::setDecodeAheadEnabled(run != 0);
+			FFmpegVideoStream *stream = static_cast<FFmpegVideoStream *>(open(video->m_internalName));
+			if (stream == nullptr)
+			{
+				isOpen = FALSE;
+				break;
+			}
+
+			MemoryVideoBuffer buffer;
+			buffer.allocate(stream->width(), stream->height());
+			for (Int frame = 0; frame < frames && stream->m_good; ++frame)
+			{
+				while (!stream->isFrameReady())
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+				const Int64 start = getMicroseconds();
+				stream->frameRender(&buffer);
+				stream->frameNext();
+				frameLatencies[run].push_back(getMicroseconds() - start);
+
+				checksums[run].push_back(buffer.getChecksum());
+				if (stream->m_good)
+					decodeLatencies[run].push_back(stream->m_frame->decodeMicroseconds);
+			}
+			stream->close();
+		}
+
+		if (!isOpen)
+			continue;
+
+		++numVideos;
+		if (checksums[0] != checksums[1])
+		{
+			++numMismatches;
+			printf("  %s: the frames DO NOT MATCH\n", video->m_internalName.str());
+		}
+	}
+
+	FFmpegFrameQueue::setDecodeAheadEnabled(wasDecodingAhead);
+
+	if (numVideos == 0)
+	{
+		printf("No videos could be opened\n");
+		fflush(stdout);
+		return 1;
+	}
+
+	printf("  %d videos played\n", numVideos);
+	printLatencies("frame on this thread, decoded in place", frameLatencies[0]);
+	printLatencies("frame on this thread, decoded ahead", frameLatencies[1]);
+	printLatencies("decoding in place", decodeLatencies[0]);
+	printLatencies("decoding ahead on the worker", decodeLatencies[1]);
+	printf(numMismatches == 0 ? "Results match\n" : "Results DO NOT MATCH\n");
+	fflush(stdout);
+	return numMismatches == 0 ? 0 : 1;
+}
+
 //============================================================================
 // FFmpegVideoStream::FFmpegVideoStream
 //============================================================================
@@ -312,9 +449,6 @@ void FFmpegVideoPlayer::initializeBinkWithMiles()
 FFmpegVideoStream::FFmpegVideoStream(FFmpegFile* file)
 : m_ffmpegFile(file)
 {
-	m_ffmpegFile->setFrameCallback(onFrame);
-	m_ffmpegFile->setUserData(this);
-
 	// GeneralsX @build Mr. Meeseeks 17/06/2026 Prioritize MiniAudio backend over OpenAL to prevent redefinition conflicts
 #ifdef SAGE_USE_MINIAUDIO
 	MiniAudioStream* audioStream = (MiniAudioStream*)TheAudio->getHandleForBink();
@@ -325,9 +459,17 @@ FFmpegVideoStream::FFmpegVideoStream(FFmpegFile* file)
 	audioStream->reset();
 #endif
 
-	// Decode until we have our first video frame
-	while (m_good && m_gotFrame == false)
-		m_good = m_ffmpegFile->decodePacket();
+	// the worker thread owns the decoder from here on
+	m_width = m_ffmpegFile->getWidth();
+	m_height = m_ffmpegFile->getHeight();
+	m_frameCount = m_ffmpegFile->getNumFrames();
+	m_frameTime = m_ffmpegFile->getFrameTime();
+	m_frameQueue = NEW FFmpegFrameQueue(m_ffmpegFile, FFmpegFrameQueue::isDecodeAheadEnabled());
+
+	// Wait until we have our first video frame
+	m_frame = m_frameQueue->nextFrame();
+	m_good = m_frame != nullptr;
+	bufferAudio();
 
 #ifdef SAGE_USE_MINIAUDIO
 	audioStream->setVolume(1.0f);
@@ -367,120 +509,71 @@ FFmpegVideoStream::~FFmpegVideoStream()
 			audioStream->reset();
 	}
 #endif
-	av_freep(&m_audioBuffer);
-	av_frame_free(&m_frame);
+	m_frameQueue->releaseFrame(m_frame);
+	delete m_frameQueue;
 	sws_freeContext(m_swsContext);
 	delete m_ffmpegFile;
 }
 
-void FFmpegVideoStream::onFrame(AVFrame *frame, int stream_idx, int stream_type, void *user_data)
+//============================================================================
+// FFmpegVideoStream::bufferAudio
+//============================================================================
+
+void FFmpegVideoStream::bufferAudio()
 {
-	FFmpegVideoStream *videoStream = static_cast<FFmpegVideoStream *>(user_data);
-	if (stream_type == AVMEDIA_TYPE_VIDEO) {
-		av_frame_free(&videoStream->m_frame);
-		videoStream->m_frame = av_frame_clone(frame);
-		videoStream->m_gotFrame = true;
-	}
 #if defined(SAGE_USE_OPENAL) || defined(SAGE_USE_MINIAUDIO)
-	else if (stream_type == AVMEDIA_TYPE_AUDIO) {
 #ifdef SAGE_USE_MINIAUDIO
-		MiniAudioStream* audioStream = (MiniAudioStream*)TheAudio->getHandleForBink();
+	MiniAudioStream* audioStream = (MiniAudioStream*)TheAudio->getHandleForBink();
 #elif defined(SAGE_USE_OPENAL)
-		OpenALAudioStream* audioStream = (OpenALAudioStream*)TheAudio->getHandleForBink();
+	OpenALAudioStream* audioStream = (OpenALAudioStream*)TheAudio->getHandleForBink();
 #endif
-		AVSampleFormat sampleFmt = static_cast<AVSampleFormat>(frame->format);
-		const int bytesPerSample = av_get_bytes_per_sample(sampleFmt);
-		const int frameSize = av_samples_get_buffer_size(nullptr, frame->ch_layout.nb_channels, frame->nb_samples, sampleFmt, 1);
-		if (frameSize <= 0 || bytesPerSample <= 0 || frame->ch_layout.nb_channels <= 0 || frame->nb_samples <= 0)
-			return;
-
-		int outputBitsPerSample = bytesPerSample * 8;
-		int outputFrameSize = frameSize;
-		uint8_t* frameData = frame->data[0];
-
-		// GeneralsX @bugfix fbraz3 23/04/2026 Convert float32 FFmpeg output to PCM16 for robust OpenAL compatibility.
-		// Issue: https://github.com/fbraz3/GeneralsX/issues/38
-		if (sampleFmt == AV_SAMPLE_FMT_FLT || sampleFmt == AV_SAMPLE_FMT_FLTP)
-		{
-			outputBitsPerSample = 16;
-			outputFrameSize = frame->nb_samples * frame->ch_layout.nb_channels * (int)sizeof(int16_t);
-			videoStream->m_audioBuffer = static_cast<uint8_t*>(av_realloc(videoStream->m_audioBuffer, outputFrameSize));
-			if (videoStream->m_audioBuffer == nullptr)
-			{
-				DEBUG_LOG(("Failed to allocate converted audio buffer"));
-				return;
-			}
-			int16_t *dst = reinterpret_cast<int16_t *>(videoStream->m_audioBuffer);
-			if (sampleFmt == AV_SAMPLE_FMT_FLTP)
-			{
-				for (int sample_idx = 0; sample_idx < frame->nb_samples; ++sample_idx)
-				{
-					for (int channel_idx = 0; channel_idx < frame->ch_layout.nb_channels; ++channel_idx)
-					{
-						const float sample = reinterpret_cast<const float *>(frame->data[channel_idx])[sample_idx];
-						const float clamped = (sample < -1.0f) ? -1.0f : ((sample > 1.0f) ? 1.0f : sample);
-						*dst++ = static_cast<int16_t>(clamped * 32767.0f);
-					}
-				}
-			}
-			else
-			{
-				const float *src = reinterpret_cast<const float *>(frame->data[0]);
-				const int totalSamples = frame->nb_samples * frame->ch_layout.nb_channels;
-				for (int i = 0; i < totalSamples; ++i)
-				{
-					const float clamped = (src[i] < -1.0f) ? -1.0f : ((src[i] > 1.0f) ? 1.0f : src[i]);
-					*dst++ = static_cast<int16_t>(clamped * 32767.0f);
-				}
-			}
-			frameData = videoStream->m_audioBuffer;
-		}
-		// The format is planar - convert it to interleaved
-		else if (av_sample_fmt_is_planar(sampleFmt))
+	Int sampleRate, numChannels, bitsPerSample;
+	if (audioStream == nullptr || !m_frameQueue->getAudioFormat(&sampleRate, &numChannels, &bitsPerSample))
+		return;
+
+	// hand over whole samples, keeping the ones the stream has no room for until the next frame
+	const Int sampleBytes = numChannels * bitsPerSample / 8;
+	const Int maxBytes = MAX_AUDIO_CHUNK_BYTES - MAX_AUDIO_CHUNK_BYTES % sampleBytes;
+	Bool buffered = FALSE;
+	for (;;)
+	{
+		if (m_pendingAudio.empty())
 		{
-			videoStream->m_audioBuffer = static_cast<uint8_t*>(av_realloc(videoStream->m_audioBuffer, outputFrameSize));
-			if (videoStream->m_audioBuffer == nullptr)
-			{
-				DEBUG_LOG(("Failed to allocate audio buffer"));
-				return;
-			}
-			// Write the samples into our audio buffer
-			for (int sample_idx = 0; sample_idx < frame->nb_samples; sample_idx++)
-			{
-				int byte_offset = sample_idx * bytesPerSample;
-				for (int channel_idx = 0; channel_idx < frame->ch_layout.nb_channels; channel_idx++)
-				{
-					uint8_t* dst = &videoStream->m_audioBuffer[byte_offset * frame->ch_layout.nb_channels + channel_idx * bytesPerSample];
-					uint8_t* src = &frame->data[channel_idx][byte_offset];
-					memcpy(dst, src, bytesPerSample);
-				}
-			}
-			frameData = videoStream->m_audioBuffer;
+			m_pendingAudio.resize(maxBytes);
+			m_pendingAudio.resize(m_frameQueue->readAudio(m_pendingAudio.data(), maxBytes));
+			if (m_pendingAudio.empty())
+				break;
 		}
 
 #ifdef SAGE_USE_MINIAUDIO
 		ma_format format = ma_format_unknown;
-		if (outputBitsPerSample == 8) format = ma_format_u8;
-		else if (outputBitsPerSample == 16) format = ma_format_s16;
-		else if (outputBitsPerSample == 32) format = ma_format_f32;
-		audioStream->bufferData(frameData, outputFrameSize, format, frame->sample_rate, frame->ch_layout.nb_channels);
-		audioStream->update();
+		if (bitsPerSample == 8) format = ma_format_u8;
+		else if (bitsPerSample == 16) format = ma_format_s16;
+		else if (bitsPerSample == 32) format = ma_format_f32;
+		if (!audioStream->bufferData(m_pendingAudio.data(), m_pendingAudio.size(), format, sampleRate, numChannels))
+			break;
 #elif defined(SAGE_USE_OPENAL)
-		ALenum format = OpenALAudioManager::getALFormat(frame->ch_layout.nb_channels, outputBitsPerSample);
-		audioStream->bufferData(frameData, outputFrameSize, format, frame->sample_rate);
-		audioStream->update();
+		ALenum format = OpenALAudioManager::getALFormat(numChannels, bitsPerSample);
+		if (!audioStream->bufferData(m_pendingAudio.data(), m_pendingAudio.size(), format, sampleRate))
+			break;
 #endif
+		m_pendingAudio.clear();
+		buffered = TRUE;
 	}
+
+	if (buffered)
+		audioStream->update();
 #endif
 }
 
-
 //============================================================================
 // FFmpegVideoStream::update
 //============================================================================
 
 void FFmpegVideoStream::update()
 {
+	bufferAudio();
+
 #ifdef SAGE_USE_MINIAUDIO
 	MiniAudioStream* audioStream = (MiniAudioStream*)TheAudio->getHandleForBink();
 	if (!audioStream->isPlaying()) {
@@ -507,7 +600,7 @@ void FFmpegVideoStream::update()
 Bool FFmpegVideoStream::isFrameReady()
 {
 	uint64_t time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-	bool ready = (time - m_startTime) >= m_ffmpegFile->getFrameTime() * frameIndex();
+	bool ready = (time - m_startTime) >= m_frameTime * frameIndex();
 	return ready;
 
 	//return !BinkWait( m_handle );
@@ -536,52 +629,32 @@ void FFmpegVideoStream::frameRender( VideoBuffer *buffer )
 		return;
 	}
 
-	if (m_frame->data == nullptr) {
+	if (!FFmpegFrameQueue::isFormatSupported(buffer->format())) {
 		return;
 	}
 
-	AVPixelFormat dst_pix_fmt;
-
-	switch (buffer->format()) {
-		case VideoBuffer::TYPE_R8G8B8:
-			dst_pix_fmt = AV_PIX_FMT_RGB24;
-			break;
-		case VideoBuffer::TYPE_X8R8G8B8:
-			dst_pix_fmt = AV_PIX_FMT_BGR0;
-			break;
-		case VideoBuffer::TYPE_R5G6B5:
-			dst_pix_fmt = AV_PIX_FMT_RGB565;
-			break;
-		case VideoBuffer::TYPE_X1R5G5B5:
-			dst_pix_fmt = AV_PIX_FMT_RGB555;
-			break;
-		default:
-			return;
-	}
-
-	m_swsContext = sws_getCachedContext(m_swsContext,
-		width(),
-		height(),
-		static_cast<AVPixelFormat>(m_frame->format),
-		buffer->width(),
-		buffer->height(),
-		dst_pix_fmt,
-		SWS_BICUBIC,
-		nullptr,
-		nullptr,
-		nullptr);
-
 	uint8_t *buffer_data = static_cast<uint8_t *>(buffer->lock());
 	if (buffer_data == nullptr) {
 		DEBUG_LOG(("Failed to lock videobuffer"));
 		return;
 	}
 
-	int dst_strides[] = { (int)buffer->pitch() };
-	uint8_t *dst_data[] = { buffer_data };
-	[[maybe_unused]] int result =
-		sws_scale(m_swsContext, m_frame->data, m_frame->linesize, 0, height(), dst_data, dst_strides);
-	DEBUG_ASSERTLOG(result >= 0, ("Failed to scale frame"));
+	// the pitch is known once the buffer is locked, the frames decoded from now on are converted for it
+	m_frameQueue->setTarget(buffer->format(), buffer->width(), buffer->height(), buffer->pitch());
+
+	if (m_frame->format == buffer->format()
+		&& m_frame->width == (Int)buffer->width()
+		&& m_frame->height == (Int)buffer->height()
+		&& m_frame->pitch == (Int)buffer->pitch())
+	{
+		memcpy(buffer_data, m_frame->pixels.data(), m_frame->pixels.size());
+	}
+	else
+	{
+		[[maybe_unused]] Bool result = FFmpegFrameQueue::convertPicture(&m_swsContext, m_frame->picture,
+			buffer->format(), buffer->width(), buffer->height(), buffer->pitch(), buffer_data);
+		DEBUG_ASSERTLOG(result, ("Failed to scale frame"));
+	}
 	buffer->unlock();
 }
 
@@ -591,10 +664,19 @@ void FFmpegVideoStream::frameRender( VideoBuffer *buffer )
 
 void FFmpegVideoStream::frameNext()
 {
-	m_gotFrame = false;
-	// Decode until we have our next video frame
-	while (m_good && m_gotFrame == false)
-		m_good = m_ffmpegFile->decodePacket();
+	// Wait until we have our next video frame, the last one stays at the end of the video
+	FFmpegFrameQueue::Frame *frame = m_good ? m_frameQueue->nextFrame() : nullptr;
+	if (frame != nullptr)
+	{
+		m_frameQueue->releaseFrame(m_frame);
+		m_frame = frame;
+	}
+	else
+	{
+		m_good = false;
+	}
+
+	bufferAudio();
 }
 
 //============================================================================
@@ -603,7 +685,7 @@ void FFmpegVideoStream::frameNext()
 
 Int FFmpegVideoStream::frameIndex()
 {
-	return m_ffmpegFile->getCurrentFrame();
+	return m_frame != nullptr ? m_frame->frameNumber : 0;
 }
 
 //============================================================================
@@ -612,7 +694,7 @@ Int FFmpegVideoStream::frameIndex()
 
 Int	FFmpegVideoStream::frameCount()
 {
-	return m_ffmpegFile->getNumFrames();
+	return m_frameCount;
 }
 
 //============================================================================
@@ -621,7 +703,8 @@ Int	FFmpegVideoStream::frameCount()
 
 void FFmpegVideoStream::frameGoto( Int index )
 {
-	m_ffmpegFile->seekFrame(index);
+	m_pendingAudio.clear();
+	m_frameQueue->seekFrame(index);
 }
 
 //============================================================================
@@ -630,7 +713,7 @@ void FFmpegVideoStream::frameGoto( Int index )
 
 Int		FFmpegVideoStream::height()
 {
-	return m_ffmpegFile->getHeight();
+	return m_height;
 }
 
 //============================================================================
@@ -639,7 +722,5 @@ Int		FFmpegVideoStream::height()
 
 Int		FFmpegVideoStream::width()
 {
-	return m_ffmpegFile->getWidth();
+	return m_width;
 }
-
-
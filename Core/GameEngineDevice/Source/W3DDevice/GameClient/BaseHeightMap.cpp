@@ -47,6 +47,8 @@
 //-----------------------------------------------------------------------------
 
 #include <stdlib.h>
+#include <chrono>
+#include <random>
 #include <WW3D2/assetmgr.h>
 #include <WW3D2/texture.h>
 #include <WWMath/tri.h>
@@ -1013,6 +1015,106 @@ Real BaseHeightMapRenderObjClass::getHeightMapHeight(Real x, Real y, Coord3D* no
 	return height;
 }
 
+//=============================================================================
+// Line of sight helpers
+//=============================================================================
+// GeneralsX @performance 18/10/2026 The cell height pyramid of the logic height
+// map lets isClearLineOfSight accept or reject whole runs of cells at once.
+//
+// The line height z is stepped by adding zinc in float, so its exact value at
+// a step is only known after all the additions before it. The runs are tested
+// against bounds of z instead: each addition rounds by at most half an ulp, or
+// 2^-24 of the magnitude. A cell passes when its height is not above z + 0.5,
+// which itself rounds by far less than 0.25 at terrain heights. So a run is
+// clear when its highest cell is at most 0.25 above the lowest bound of z, and
+// blocked when its lowest cell is more than 0.75 above the highest bound.
+//=============================================================================
+namespace
+{
+const Int LOS_PYRAMID_MIN_STEPS = 16;	///< shorter lines are walked cell by cell right away
+const Int LOS_SKIP_STEPS = 16;	///< steps the cell by cell walk tries to skip at once
+const double LOS_CLEAR_MARGIN = 0.25;
+const double LOS_BLOCKED_MARGIN = 0.75;
+const double LOS_MAX_MAGNITUDE = 1048576.0;	///< the margins above hold below this height
+
+enum LineOfSightRun
+{
+	RUN_CLEAR,		///< every cell of the run passes
+	RUN_BLOCKED,	///< every cell of the run fails, and the walk gets to the first one
+	RUN_UNKNOWN
+};
+
+/// The state of the Bresenham walk of isClearLineOfSight at some step
+struct LineOfSightWalk
+{
+	Int x, y;
+	Int xinc1, xinc2, yinc1, yinc2;
+	Int den, num, numadd;
+	Real z, zinc;
+	Real maxHeight;
+	Int xLimit, yLimit;	///< cells at or past these are off the map
+
+	void getCell(Int step, Int *cellX, Int *cellY) const
+	{
+		Int64 t = num + (Int64)step*numadd;
+		Int minorSteps = (Int)(t / den);
+		*cellX = x + step*xinc2 + minorSteps*xinc1;
+		*cellY = y + step*yinc2 + minorSteps*yinc1;
+	}
+
+	Bool isOnMap(Int cellX, Int cellY) const
+	{
+		return cellX >= 0 && cellY >= 0 && cellX < xLimit && cellY < yLimit;
+	}
+};
+
+/// Classifies the steps first..last of the walk, which must all be on the map
+LineOfSightRun classifyLineOfSightRun(const LineOfSightWalk &walk, const WorldHeightMap *logicHeightMap, Int first, Int last)
+{
+	Int x0, y0, x1, y1;
+	walk.getCell(first, &x0, &y0);
+	walk.getCell(last, &x1, &y1);
+	if (!walk.isOnMap(x0, y0) || !walk.isOnMap(x1, y1))
+	{
+		return RUN_UNKNOWN;
+	}
+	UnsignedByte lowestCell, highestCell;
+	if (!logicHeightMap->getCellHeightRange(MIN(x0, x1), MIN(y0, y1), MAX(x0, x1), MAX(y0, y1), &lowestCell, &highestCell))
+	{
+		return RUN_UNKNOWN;
+	}
+
+	double zFirst = (double)walk.z + (double)walk.zinc*first;
+	double zLast = (double)walk.z + (double)walk.zinc*last;
+	double magnitude = MAX(fabs((double)walk.z), MAX(fabs(zFirst), fabs(zLast))) + 1.0;
+	if (!(magnitude < LOS_MAX_MAGNITUDE))
+	{
+		return RUN_UNKNOWN;
+	}
+	double slop = 2.0 * (last + 1) * magnitude / 16777216.0;
+	double lowestZ = MIN(zFirst, zLast) - slop;
+	double highestZ = MAX(zFirst, zLast) + slop;
+
+	// same rounding as the cell by cell walk
+	Real highest = highestCell;
+	highest *= MAP_HEIGHT_SCALE;
+	if (highest <= lowestZ + LOS_CLEAR_MARGIN)
+	{
+		return RUN_CLEAR;
+	}
+
+	// looking up, the walk stops above the highest terrain, and z must not get there before this run.
+	Real lowest = lowestCell;
+	lowest *= MAP_HEIGHT_SCALE;
+	if (lowest > highestZ + LOS_BLOCKED_MARGIN && (walk.zinc <= 0.0f || highestZ < walk.maxHeight))
+	{
+		return RUN_BLOCKED;
+	}
+	return RUN_UNKNOWN;
+}
+
+} // namespace
+
 //=============================================================================
 Bool BaseHeightMapRenderObjClass::isClearLineOfSight(const Coord3D& pos, const Coord3D& posOther) const
 {
@@ -1024,6 +1126,73 @@ Bool BaseHeightMapRenderObjClass::isClearLineOfSight(const Coord3D& pos, const C
 #define DO_BRESENHAM
 #ifdef DO_BRESENHAM
 
+	return isClearLineOfSightOnMap(logicHeightMap, pos, posOther, logicHeightMap->hasCellHeightPyramid());
+
+#else
+
+	// walk a line from obj to objOther and
+	// find the highest point in between 'em. while
+	// we're doing this, also estimate the point on the
+	// line at the same x,y as the high-terrain-point.
+
+	Real fx = pos.x;
+	Real fy = pos.y;
+	Real fz = pos.z;
+	Real fdx = posOther.x - fx;
+	Real fdy = posOther.y - fy;
+	Real fdz = posOther.z - fz;
+
+	// What's the largest step size that will be accurate enough?
+	// Currently we use a step size of about 2 "feet", which
+	// seems acceptable accuracy. If performance here is inadequate,
+	// we can try increasing the step size, but be sure to retest
+	// accuracy.
+	Real len = ceilf(sqrtf(fdx*fdx + fdy*fdy));
+	const Real STEP_LEN = 2.0f;
+	Int numSteps = REAL_TO_INT_CEIL(len / STEP_LEN);
+	if (numSteps < 1) numSteps = 1;
+	Real fnsInv = 1.0f / numSteps;
+	Real fxinc = fdx * fnsInv;
+	Real fyinc = fdy * fnsInv;
+	Real fzinc = fdz * fnsInv;
+	while (numSteps--)
+	{
+		Real terrainHeight = getHeightMapHeight( fx, fy, nullptr );
+
+		// if terrainHeight > fz, we can't see, so punt.
+		// add a little fudge to account for slop.
+		const Real LOS_FUDGE = 0.5f;
+		if (terrainHeight > fz + LOS_FUDGE)
+		{
+			return false;
+		}
+
+		// we're above the max height of the terrain and still looking up, so we're done.
+		// (don't bother for reverse test, since that doesn't generally happen)
+		if (fz >= getMaxHeight() && fzinc > 0.0f)
+		{
+			return true;
+		}
+
+		fx += fxinc;
+		fy += fyinc;
+		fz += fzinc;
+
+	}
+
+	return true;
+#endif
+}
+
+//=============================================================================
+// BaseHeightMapRenderObjClass::isClearLineOfSightOnMap
+//=============================================================================
+/** Walks the cells from pos to posOther and checks the line stays above them.
+	With useCellHeightPyramid the walk skips over runs of cells the cell height
+	pyramid tells, the answer is the same either way. */
+//=============================================================================
+Bool BaseHeightMapRenderObjClass::isClearLineOfSightOnMap(WorldHeightMap *logicHeightMap, const Coord3D& pos, const Coord3D& posOther, Bool useCellHeightPyramid) const
+{
 	/*
 		this is WAY faster, though not quite as accurate... however, the inaccuracy
 		is pretty minimal, so we really should force other code to live with it. (srj)
@@ -1096,6 +1265,18 @@ Bool BaseHeightMapRenderObjClass::isClearLineOfSight(const Coord3D& pos, const C
 	const UnsignedByte* data = logicHeightMap->getDataPtr();
 	Int xExtent = logicHeightMap->getXExtent();
 	Int yExtent = logicHeightMap->getYExtent();
+
+	// GeneralsX @performance 18/10/2026 Try to tell the answer for the whole line from the cell height pyramid first
+	const Real maxHeight = getMaxHeight();
+	if (useCellHeightPyramid && numpixels >= LOS_PYRAMID_MIN_STEPS)
+	{
+		LineOfSightWalk walk = { start_x, start_y, xinc1, xinc2, yinc1, yinc2, den, num, numadd, z, zinc, maxHeight, xExtent-1, yExtent-1 };
+		LineOfSightRun run = classifyLineOfSightRun(walk, logicHeightMap, 0, numpixels-1);
+		if (run != RUN_UNKNOWN)
+		{
+			return run == RUN_CLEAR;
+		}
+	}
 	for (Int curpixel = 0; curpixel < numpixels; curpixel++)
 	{
 		if (x < 0 ||
@@ -1107,6 +1288,36 @@ Bool BaseHeightMapRenderObjClass::isClearLineOfSight(const Coord3D& pos, const C
 			break;
 		}
 
+		// GeneralsX @performance 18/10/2026 Skip runs of cells that are low enough. The additions to
+		// z are still done one by one, so z stays exactly what the cell by cell walk would have.
+		if (useCellHeightPyramid && (curpixel % LOS_SKIP_STEPS) == 0 && numpixels - curpixel >= LOS_SKIP_STEPS)
+		{
+			LineOfSightWalk walk = { x, y, xinc1, xinc2, yinc1, yinc2, den, num, numadd, z, zinc, maxHeight, xExtent-1, yExtent-1 };
+			LineOfSightRun run = classifyLineOfSightRun(walk, logicHeightMap, 0, LOS_SKIP_STEPS-1);
+			if (run == RUN_BLOCKED)
+			{
+				return false;
+			}
+			if (run == RUN_CLEAR)
+			{
+				for (Int step = 0; step < LOS_SKIP_STEPS; step++)
+				{
+					if (z >= maxHeight && zinc > 0.0f)
+					{
+						return true;
+					}
+					z += zinc;
+				}
+				Int64 t = num + (Int64)LOS_SKIP_STEPS*numadd;
+				Int minorSteps = (Int)(t / den);
+				num = (Int)(t % den);
+				x += LOS_SKIP_STEPS*xinc2 + minorSteps*xinc1;
+				y += LOS_SKIP_STEPS*yinc2 + minorSteps*yinc1;
+				curpixel += LOS_SKIP_STEPS - 1;
+				continue;
+			}
+		}
+
 		Int idx = x + y*xExtent;
 		float height = data[idx];
 		height = MAX(height, (float)data[idx + 1]);
@@ -1146,61 +1357,88 @@ Bool BaseHeightMapRenderObjClass::isClearLineOfSight(const Coord3D& pos, const C
 	}
 
 	return result;
+}
 
-#else
-
-	// walk a line from obj to objOther and
-	// find the highest point in between 'em. while
-	// we're doing this, also estimate the point on the
-	// line at the same x,y as the high-terrain-point.
-
-	Real fx = pos.x;
-	Real fy = pos.y;
-	Real fz = pos.z;
-	Real fdx = posOther.x - fx;
-	Real fdy = posOther.y - fy;
-	Real fdz = posOther.z - fz;
-
-	// What's the largest step size that will be accurate enough?
-	// Currently we use a step size of about 2 "feet", which
-	// seems acceptable accuracy. If performance here is inadequate,
-	// we can try increasing the step size, but be sure to retest
-	// accuracy.
-	Real len = ceilf(sqrtf(fdx*fdx + fdy*fdy));
-	const Real STEP_LEN = 2.0f;
-	Int numSteps = REAL_TO_INT_CEIL(len / STEP_LEN);
-	if (numSteps < 1) numSteps = 1;
-	Real fnsInv = 1.0f / numSteps;
-	Real fxinc = fdx * fnsInv;
-	Real fyinc = fdy * fnsInv;
-	Real fzinc = fdz * fnsInv;
-	while (numSteps--)
+//=============================================================================
+// BaseHeightMapRenderObjClass::benchmarkLineOfSight
+//=============================================================================
+/** Checks random lines with and without the cell height pyramid and prints the
+	checks per second of both. Returns false if the answers differ. */
+//=============================================================================
+Bool BaseHeightMapRenderObjClass::benchmarkLineOfSight(Int checks) const
+{
+	// Note that we use printf here because this is run from cmd.
+	if (m_map == nullptr || checks <= 0)
 	{
-		Real terrainHeight = getHeightMapHeight( fx, fy, nullptr );
+		printf("Line of sight: no terrain to check\n");
+		fflush(stdout);
+		return false;
+	}
 
-		// if terrainHeight > fz, we can't see, so punt.
-		// add a little fudge to account for slop.
-		const Real LOS_FUDGE = 0.5f;
-		if (terrainHeight > fz + LOS_FUDGE)
+	WorldHeightMap *logicHeightMap = TheTerrainVisual?TheTerrainVisual->getLogicHeightMap():m_map;
+	if (!logicHeightMap->hasCellHeightPyramid())
+		logicHeightMap->buildCellHeightPyramid();
+
+	Int border = logicHeightMap->getBorderSizeInline();
+	Real loX = -border * MAP_XY_FACTOR;
+	Real loY = -border * MAP_XY_FACTOR;
+	Real hiX = (logicHeightMap->getXExtent() - border - 1) * MAP_XY_FACTOR;
+	Real hiY = (logicHeightMap->getYExtent() - border - 1) * MAP_XY_FACTOR;
+
+	// half the lines are as short as most unit ranges, the others cross much of the map
+	std::mt19937 random(12345);
+	std::uniform_real_distribution<Real> anyX(loX, hiX);
+	std::uniform_real_distribution<Real> anyY(loY, hiY);
+	std::uniform_real_distribution<Real> nearby(-40.0f * MAP_XY_FACTOR, 40.0f * MAP_XY_FACTOR);
+	std::uniform_real_distribution<Real> aboveGround(0.0f, 30.0f);
+	std::vector<Coord3D> from(checks);
+	std::vector<Coord3D> to(checks);
+	for (Int i = 0; i < checks; i++)
+	{
+		from[i].x = anyX(random);
+		from[i].y = anyY(random);
+		if (i & 1)
 		{
-			return false;
+			to[i].x = anyX(random);
+			to[i].y = anyY(random);
 		}
-
-		// we're above the max height of the terrain and still looking up, so we're done.
-		// (don't bother for reverse test, since that doesn't generally happen)
-		if (fz >= getMaxHeight() && fzinc > 0.0f)
+		else
 		{
-			return true;
+			to[i].x = clamp(loX, from[i].x + nearby(random), hiX);
+			to[i].y = clamp(loY, from[i].y + nearby(random), hiY);
 		}
+		from[i].z = getHeightMapHeight(from[i].x, from[i].y, nullptr) + aboveGround(random);
+		to[i].z = getHeightMapHeight(to[i].x, to[i].y, nullptr) + aboveGround(random);
+	}
 
-		fx += fxinc;
-		fy += fyinc;
-		fz += fzinc;
+	std::vector<Bool> cellByCell(checks);
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (Int i = 0; i < checks; i++)
+		cellByCell[i] = isClearLineOfSightOnMap(logicHeightMap, from[i], to[i], false);
+	double cellByCellTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 
-	}
+	std::vector<Bool> pyramid(checks);
+	start = std::chrono::steady_clock::now();
+	for (Int i = 0; i < checks; i++)
+		pyramid[i] = isClearLineOfSightOnMap(logicHeightMap, from[i], to[i], true);
+	double pyramidTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 
-	return true;
-#endif
+	Int numClear = 0;
+	Int numDifferent = 0;
+	for (Int i = 0; i < checks; i++)
+	{
+		if (cellByCell[i])
+			numClear++;
+		if (cellByCell[i] != pyramid[i])
+			numDifferent++;
+	}
+
+	printf("Line of sight: %d checks, %d clear\n", checks, numClear);
+	printf("  cell by cell: %.0f checks/s\n", cellByCellTime > 0.0 ? checks / cellByCellTime : 0.0);
+	printf("  cell height pyramid: %.0f checks/s\n", pyramidTime > 0.0 ? checks / pyramidTime : 0.0);
+	printf("  results %s (%d differ)\n", numDifferent == 0 ? "match" : "DO NOT MATCH", numDifferent);
+	fflush(stdout);
+	return numDifferent == 0;
 }
 
 //=============================================================================
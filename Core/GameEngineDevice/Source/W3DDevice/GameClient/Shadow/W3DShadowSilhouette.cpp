@@ -0,0 +1,877 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: W3DShadowSilhouette.cpp //////////////////////////////////////////////////////////////////
+// The faces of a shadow casting mesh and the silhouette edges they show to a light
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "W3DDevice/GameClient/W3DShadowSilhouette.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <math.h>
+#include <mutex>
+#include <random>
+#include <stdio.h>
+#include <thread>
+#include <utility>
+
+// four faces are tested at once where the compiler targets SSE2 or NEON
+#if defined(__SSE2__) || defined(__x86_64__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SHADOW_SILHOUETTE_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SHADOW_SILHOUETTE_USE_NEON
+#include <arm_neon.h>
+#endif
+
+Bool W3DShadowSilhouette::s_isCacheEnabled = TRUE;
+UnsignedInt W3DShadowSilhouette::s_cacheHits = 0;
+UnsignedInt W3DShadowSilhouette::s_cacheMisses = 0;
+
+namespace
+{
+const Real LIGHT_DIRECTION_STEPS = 256.0f;		///< steps of the cached light direction per unit, about the 0.2 degrees of light change that rebuild a volume
+const Real LIGHT_DISTANCE_STEPS = 16.0f;			///< steps of the cached light distance per doubling, about 4%
+
+/// Threads that test the faces of a big mesh together with the render thread
+class ShadowFaceWorkers
+{
+public:
+
+	enum { MAX_THREADS = 3 };		///< worker threads in addition to the render thread
+
+	ShadowFaceWorkers() :
+		m_silhouette(nullptr),
+		m_visible(nullptr),
+		m_numFaces(0),
+		m_facesPerClaim(0),
+		m_nextFace(0),
+		m_generation(0),
+		m_busyThreads(0),
+		m_quit(false)
+	{
+		Int numThreads = (Int)std::thread::hardware_concurrency() - 1;
+		if (numThreads > MAX_THREADS)
+			numThreads = MAX_THREADS;
+		for (Int i = 0; i < numThreads; ++i)
+			m_threads.push_back(std::thread(threadFunction, this));
+	}
+
+	~ShadowFaceWorkers()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_quit = true;
+		}
+		m_wake.notify_all();
+		for (size_t i = 0; i < m_threads.size(); ++i)
+			m_threads[i].join();
+	}
+
+	Bool hasThreads() const { return !m_threads.empty(); }
+
+	// Tests all faces of the silhouette and returns when they are done
+	void run(const W3DShadowSilhouette *silhouette, const Vector3 &lightPos, UnsignedByte *visible, Int numFaces, Int facesPerClaim)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_silhouette = silhouette;
+			m_lightPos = lightPos;
+			m_visible = visible;
+			m_numFaces = numFaces;
+			m_facesPerClaim = facesPerClaim;
+			m_nextFace = 0;
+			m_busyThreads = (Int)m_threads.size();
+			++m_generation;
+		}
+		m_wake.notify_all();
+
+		classifyFaces();
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_done.wait(lock, [this] { return m_busyThreads == 0; });
+	}
+
+private:
+
+	void classifyFaces()
+	{
+		for (;;)
+		{
+			const Int first = m_nextFace.fetch_add(m_facesPerClaim);
+			if (first >= m_numFaces)
+				break;
+			m_silhouette->classifyFaces(m_lightPos, m_visible, first, MIN(first + m_facesPerClaim, m_numFaces));
+		}
+	}
+
+	static void threadFunction(ShadowFaceWorkers *workers)
+	{
+		UnsignedInt generation = 0;
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock(workers->m_mutex);
+				workers->m_wake.wait(lock, [&] { return workers->m_quit || workers->m_generation != generation; });
+				if (workers->m_quit)
+					return;
+				generation = workers->m_generation;
+			}
+
+			workers->classifyFaces();
+
+			std::lock_guard<std::mutex> lock(workers->m_mutex);
+			if (--workers->m_busyThreads == 0)
+				workers->m_done.notify_one();
+		}
+	}
+
+	std::vector<std::thread> m_threads;
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_done;
+	const W3DShadowSilhouette *m_silhouette;
+	Vector3 m_lightPos;
+	UnsignedByte *m_visible;
+	Int m_numFaces;
+	Int m_facesPerClaim;
+	std::atomic<Int> m_nextFace;
+	UnsignedInt m_generation;
+	Int m_busyThreads;
+	Bool m_quit;
+};
+
+ShadowFaceWorkers *TheShadowFaceWorkers = nullptr;
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+W3DShadowSilhouette::W3DShadowSilhouette() :
+	m_numCached(0),
+	m_useCount(0)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void W3DShadowSilhouette::allocate(Int numFaces)
+{
+	const Int paddedFaces = (numFaces + 3) & ~3;
+
+	// the padding faces have no normal, the light never sees their front
+	m_vertexX.assign(paddedFaces, 0.0f);
+	m_vertexY.assign(paddedFaces, 0.0f);
+	m_vertexZ.assign(paddedFaces, 0.0f);
+	m_normalX.assign(paddedFaces, 0.0f);
+	m_normalY.assign(paddedFaces, 0.0f);
+	m_normalZ.assign(paddedFaces, 0.0f);
+	m_faces.assign(numFaces, Face());
+	m_visible.assign(paddedFaces, 0);
+	for (Int face = 0; face < numFaces; ++face)
+	{
+		for (Int slot = 0; slot < 3; ++slot)
+			setNeighbor(face, slot, NO_NEIGHBOR, 0, 0);
+	}
+	clearCache();
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void W3DShadowSilhouette::setFace(Int face, const Short *vertexIndices, const Vector3 &vertex, const Vector3 &normal)
+{
+	m_faces[face].vertex[0] = vertexIndices[0];
+	m_faces[face].vertex[1] = vertexIndices[1];
+	m_faces[face].vertex[2] = vertexIndices[2];
+	m_vertexX[face] = vertex.X;
+	m_vertexY[face] = vertex.Y;
+	m_vertexZ[face] = vertex.Z;
+	m_normalX[face] = normal.X;
+	m_normalY[face] = normal.Y;
+	m_normalZ[face] = normal.Z;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void W3DShadowSilhouette::setNeighbor(Int face, Int slot, Short neighborFace, Short edgeStart, Short edgeEnd)
+{
+	Neighbor &neighbor = m_faces[face].neighbor[slot];
+	neighbor.face = neighborFace;
+	neighbor.edge[0] = edgeStart;
+	neighbor.edge[1] = edgeEnd;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void W3DShadowSilhouette::clearCache()
+{
+	for (Int i = 0; i < m_numCached; ++i)
+		std::vector<Short>().swap(m_cache[i].edges);
+	m_numCached = 0;
+	m_useCount = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** The light vector of a face goes from the light to its first vertex, the light sees the front of
+	* the face when it points against the normal. The lanes add the products in the order of
+	* Vector3::Dot_Product, so they find the same faces as the original test did. */
+// ------------------------------------------------------------------------------------------------
+void W3DShadowSilhouette::classifyFaces(const Vector3 &lightPos, UnsignedByte *visible, Int first, Int last) const
+{
+	Int face = first;
+
+#if defined(SHADOW_SILHOUETTE_USE_SSE2)
+	const __m128 lightX = _mm_set1_ps(lightPos.X);
+	const __m128 lightY = _mm_set1_ps(lightPos.Y);
+	const __m128 lightZ = _mm_set1_ps(lightPos.Z);
+	const __m128 zero = _mm_setzero_ps();
+	for (; face + 4 <= last; face += 4)
+	{
+		const __m128 x = _mm_sub_ps(_mm_loadu_ps(&m_vertexX[face]), lightX);
+		const __m128 y = _mm_sub_ps(_mm_loadu_ps(&m_vertexY[face]), lightY);
+		const __m128 z = _mm_sub_ps(_mm_loadu_ps(&m_vertexZ[face]), lightZ);
+		const __m128 dot = _mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(x, _mm_loadu_ps(&m_normalX[face])),
+			_mm_mul_ps(y, _mm_loadu_ps(&m_normalY[face]))),
+			_mm_mul_ps(z, _mm_loadu_ps(&m_normalZ[face])));
+		const Int lanes = _mm_movemask_ps(_mm_cmplt_ps(dot, zero));
+		visible[face] = (UnsignedByte)(lanes & 1);
+		visible[face + 1] = (UnsignedByte)((lanes >> 1) & 1);
+		visible[face + 2] = (UnsignedByte)((lanes >> 2) & 1);
+		visible[face + 3] = (UnsignedByte)((lanes >> 3) & 1);
+	}
+#elif defined(SHADOW_SILHOUETTE_USE_NEON)
+	const float32x4_t lightX = vdupq_n_f32(lightPos.X);
+	const float32x4_t lightY = vdupq_n_f32(lightPos.Y);
+	const float32x4_t lightZ = vdupq_n_f32(lightPos.Z);
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	for (; face + 4 <= last; face += 4)
+	{
+		const float32x4_t x = vsubq_f32(vld1q_f32(&m_vertexX[face]), lightX);
+		const float32x4_t y = vsubq_f32(vld1q_f32(&m_vertexY[face]), lightY);
+		const float32x4_t z = vsubq_f32(vld1q_f32(&m_vertexZ[face]), lightZ);
+		const float32x4_t dot = vaddq_f32(vaddq_f32(
+			vmulq_f32(x, vld1q_f32(&m_normalX[face])),
+			vmulq_f32(y, vld1q_f32(&m_normalY[face]))),
+			vmulq_f32(z, vld1q_f32(&m_normalZ[face])));
+		const uint32x4_t lanes = vcltq_f32(dot, zero);
+		visible[face] = (UnsignedByte)(vgetq_lane_u32(lanes, 0) & 1);
+		visible[face + 1] = (UnsignedByte)(vgetq_lane_u32(lanes, 1) & 1);
+		visible[face + 2] = (UnsignedByte)(vgetq_lane_u32(lanes, 2) & 1);
+		visible[face + 3] = (UnsignedByte)(vgetq_lane_u32(lanes, 3) & 1);
+	}
+#endif
+
+	for (; face < last; ++face)
+	{
+		const Real x = m_vertexX[face] - lightPos.X;
+		const Real y = m_vertexY[face] - lightPos.Y;
+		const Real z = m_vertexZ[face] - lightPos.Z;
+		visible[face] = (x * m_normalX[face] + y * m_normalY[face] + z * m_normalZ[face]) < 0.0f ? 1 : 0;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void W3DShadowSilhouette::classify(const Vector3 &lightPos)
+{
+	const Int numFaces = getNumFaces();
+	if (numFaces < MIN_FACES_TO_SHARE)
+	{
+		classifyFaces(lightPos, &m_visible[0], 0, numFaces);
+		return;
+	}
+
+	if (TheShadowFaceWorkers == nullptr)
+		TheShadowFaceWorkers = new ShadowFaceWorkers;
+
+	if (!TheShadowFaceWorkers->hasThreads())
+	{
+		classifyFaces(lightPos, &m_visible[0], 0, numFaces);
+		return;
+	}
+
+	TheShadowFaceWorkers->run(this, lightPos, &m_visible[0], numFaces, FACES_PER_CLAIM);
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Which neighbor slot of the visible face holds the hidden face decides the edge. Its two vertices
+	* are added in the order the visible face has them, so the edge is counter clockwise. */
+// ------------------------------------------------------------------------------------------------
+void W3DShadowSilhouette::addEdge(Int visibleFace, Int hiddenFace, std::vector<Short> &edges) const
+{
+	const Face &visible = m_faces[visibleFace];
+	Int slot = 0;
+	for (Int i = 0; i < 3; ++i)
+	{
+		if (visible.neighbor[i].face == hiddenFace)
+		{
+			slot = i;
+			break;
+		}
+	}
+
+	// the edge leaves out the vertex of the face that is not on it
+	const Neighbor &neighbor = visible.neighbor[slot];
+	if (visible.vertex[0] != neighbor.edge[0] && visible.vertex[0] != neighbor.edge[1])
+	{
+		edges.push_back(visible.vertex[1]);
+		edges.push_back(visible.vertex[2]);
+	}
+	else if (visible.vertex[1] != neighbor.edge[0] && visible.vertex[1] != neighbor.edge[1])
+	{
+		edges.push_back(visible.vertex[2]);
+		edges.push_back(visible.vertex[0]);
+	}
+	else
+	{
+		edges.push_back(visible.vertex[0]);
+		edges.push_back(visible.vertex[1]);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void W3DShadowSilhouette::addNeighborlessEdges(Int faceIndex, std::vector<Short> &edges) const
+{
+	const Face &face = m_faces[faceIndex];
+	for (Int i = 0; i < 3; ++i)
+	{
+		const Short edgeStart = face.vertex[i];
+		const Short edgeEnd = face.vertex[i == 2 ? 0 : i + 1];
+
+		Bool addEdge = TRUE;
+		for (Int j = 0; j < 3; ++j)
+		{
+			const Neighbor &neighbor = face.neighbor[j];
+			if (neighbor.face != NO_NEIGHBOR &&
+					((neighbor.edge[0] == edgeStart && neighbor.edge[1] == edgeEnd) ||
+					 (neighbor.edge[1] == edgeStart && neighbor.edge[0] == edgeEnd)))
+			{
+				addEdge = FALSE;
+				break;
+			}
+		}
+
+		if (addEdge)
+		{
+			edges.push_back(edgeStart);
+			edges.push_back(edgeEnd);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+/** An edge between a face the light sees the front of and one it does not is on the silhouette, as
+	* is an edge of a seen face that has no neighbor. Each shared edge is looked at from the face with
+	* the lower index only, the one buildSilhouette used to mark as processed first. */
+// ------------------------------------------------------------------------------------------------
+void W3DShadowSilhouette::findEdges(std::vector<Short> &edges) const
+{
+	edges.clear();
+	const Int numFaces = getNumFaces();
+	for (Int i = 0; i < numFaces; ++i)
+	{
+		const Face &face = m_faces[i];
+		Bool visibleNeighborless = FALSE;
+		for (Int j = 0; j < 3; ++j)
+		{
+			const Int other = face.neighbor[j].face;
+			if (other != NO_NEIGHBOR && other < i)
+				continue;
+
+			if (m_visible[i])
+			{
+				if (other == NO_NEIGHBOR)
+					visibleNeighborless = TRUE;
+				else if (!m_visible[other])
+					addEdge(i, other, edges);
+			}
+			else if (other != NO_NEIGHBOR && m_visible[other])
+			{
+				addEdge(other, i, edges);
+			}
+		}
+
+		if (visibleNeighborless)
+			addNeighborlessEdges(i, edges);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void W3DShadowSilhouette::buildEdges(const Vector3 &lightPos, std::vector<Short> &edges)
+{
+	classify(lightPos);
+	findEdges(edges);
+}
+
+// ------------------------------------------------------------------------------------------------
+/** The direction of the light is rounded on each axis and its distance on a logarithmic scale, the
+	* light is then put back together from the rounded values alone. */
+// ------------------------------------------------------------------------------------------------
+Bool W3DShadowSilhouette::makeLightKey(const Vector3 &lightPos, Int *key, Vector3 *cachedLight)
+{
+	const Real distance = sqrtf(lightPos.X * lightPos.X + lightPos.Y * lightPos.Y + lightPos.Z * lightPos.Z);
+	if (!(distance > 0.0f))
+		return FALSE;
+
+	key[0] = (Int)floorf(lightPos.X / distance * LIGHT_DIRECTION_STEPS + 0.5f);
+	key[1] = (Int)floorf(lightPos.Y / distance * LIGHT_DIRECTION_STEPS + 0.5f);
+	key[2] = (Int)floorf(lightPos.Z / distance * LIGHT_DIRECTION_STEPS + 0.5f);
+	key[3] = (Int)floorf(log2f(distance) * LIGHT_DISTANCE_STEPS + 0.5f);
+
+	const Real keyLength = sqrtf((Real)(key[0] * key[0] + key[1] * key[1] + key[2] * key[2]));
+	const Real keyDistance = exp2f(key[3] / LIGHT_DISTANCE_STEPS);
+	cachedLight->X = key[0] / keyLength * keyDistance;
+	cachedLight->Y = key[1] / keyLength * keyDistance;
+	cachedLight->Z = key[2] / keyLength * keyDistance;
+	return TRUE;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+Bool W3DShadowSilhouette::getCachedLight(const Vector3 &lightPos, Vector3 *cachedLight)
+{
+	Int key[4];
+	return makeLightKey(lightPos, key, cachedLight);
+}
+
+// ------------------------------------------------------------------------------------------------
+/** The silhouettes are cached by the rounded light and built from it, so a cached silhouette is the
+	* one building it again would give. The silhouette used the longest ago makes room for new ones. */
+// ------------------------------------------------------------------------------------------------
+const std::vector<Short> &W3DShadowSilhouette::getEdges(const Vector3 &lightPos)
+{
+	Int key[4];
+	Vector3 cachedLight;
+	if (!s_isCacheEnabled || !makeLightKey(lightPos, key, &cachedLight))
+	{
+		buildEdges(lightPos, m_edges);
+		return m_edges;
+	}
+
+	++m_useCount;
+	Int oldest = 0;
+	for (Int i = 0; i < m_numCached; ++i)
+	{
+		CachedSilhouette &cached = m_cache[i];
+		if (cached.key[0] == key[0] && cached.key[1] == key[1] && cached.key[2] == key[2] && cached.key[3] == key[3])
+		{
+			++s_cacheHits;
+			cached.lastUse = m_useCount;
+			return cached.edges;
+		}
+		if (cached.lastUse < m_cache[oldest].lastUse)
+			oldest = i;
+	}
+
+	++s_cacheMisses;
+	CachedSilhouette &cached = m_cache[m_numCached < MAX_CACHED_SILHOUETTES ? m_numCached++ : oldest];
+	cached.key[0] = key[0];
+	cached.key[1] = key[1];
+	cached.key[2] = key[2];
+	cached.key[3] = key[3];
+	cached.lastUse = m_useCount;
+	buildEdges(cachedLight, cached.edges);
+	return cached.edges;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void W3DShadowSilhouette::shutdown()
+{
+	delete TheShadowFaceWorkers;
+	TheShadowFaceWorkers = nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+const char *W3DShadowSilhouette::getBatchName()
+{
+#if defined(SHADOW_SILHOUETTE_USE_SSE2)
+	return "SSE2";
+#elif defined(SHADOW_SILHOUETTE_USE_NEON)
+	return "NEON";
+#else
+	return "scalar";
+#endif
+}
+
+namespace
+{
+/// A generated mesh and the polygon neighbor data W3DShadowGeometryMesh keeps for it
+struct BenchmarkMesh
+{
+	const char *name;
+	std::vector<Vector3> vertices;
+	std::vector<Short> indices;				///< three per face
+	std::vector<Vector3> normals;
+	std::vector<Short> neighbors;			///< three per face, the face across each edge or NO_NEIGHBOR
+	std::vector<UnsignedByte> status;	///< the flags the original walk kept in PolyNeighbor::status
+};
+
+const UnsignedByte POLY_VISIBLE = 0x01;
+const UnsignedByte POLY_PROCESSED = 0x02;
+
+void addFace(BenchmarkMesh &mesh, Int a, Int b, Int c)
+{
+	mesh.indices.push_back((Short)a);
+	mesh.indices.push_back((Short)b);
+	mesh.indices.push_back((Short)c);
+}
+
+/// Computes the normals the way W3DShadowGeometryMesh::buildPolygonNormal does and finds the
+/// neighbors across the edges
+void finishMesh(BenchmarkMesh &mesh)
+{
+	const Int numFaces = (Int)mesh.indices.size() / 3;
+	std::map<std::pair<Short, Short>, Short> edgeFaces;
+	for (Int face = 0; face < numFaces; ++face)
+	{
+		const Short *poly = &mesh.indices[face * 3];
+		const Vector3 &v0 = mesh.vertices[poly[0]];
+		const Vector3 &v1 = mesh.vertices[poly[1]];
+		const Vector3 &v2 = mesh.vertices[poly[2]];
+		Vector3 edge1 = v1 - v0;
+		Vector3 edge2 = v1 - v2;
+		Vector3 normal;
+		Vector3::Normalized_Cross_Product(edge2, edge1, &normal);
+		mesh.normals.push_back(normal);
+		for (Int i = 0; i < 3; ++i)
+			edgeFaces[std::make_pair(poly[i], poly[i == 2 ? 0 : i + 1])] = (Short)face;
+	}
+
+	for (Int face = 0; face < numFaces; ++face)
+	{
+		const Short *poly = &mesh.indices[face * 3];
+		for (Int i = 0; i < 3; ++i)
+		{
+			std::map<std::pair<Short, Short>, Short>::const_iterator it = edgeFaces.find(std::make_pair(poly[i == 2 ? 0 : i + 1], poly[i]));
+			mesh.neighbors.push_back(it != edgeFaces.end() ? it->second : (Short)W3DShadowSilhouette::NO_NEIGHBOR);
+		}
+	}
+	mesh.status.assign(numFaces, 0);
+}
+
+/// A bumpy closed ring of segments around its axis and sides around its tube
+void makeTorus(BenchmarkMesh &mesh, const char *name, Int segments, Int sides, std::mt19937 &random)
+{
+	std::uniform_real_distribution<Real> bump(-0.6f, 0.6f);
+	mesh.name = name;
+	for (Int s = 0; s < segments; ++s)
+	{
+		const Real u = 2.0f * 3.14159265f * s / segments;
+		for (Int t = 0; t < sides; ++t)
+		{
+			const Real v = 2.0f * 3.14159265f * t / sides;
+			const Real tube = 4.0f + bump(random);
+			const Real ring = 12.0f + tube * cosf(v);
+			mesh.vertices.push_back(Vector3(ring * cosf(u), ring * sinf(u), 8.0f + tube * sinf(v)));
+		}
+	}
+	for (Int s = 0; s < segments; ++s)
+	{
+		for (Int t = 0; t < sides; ++t)
+		{
+			const Int a = s * sides + t;
+			const Int b = ((s + 1) % segments) * sides + t;
+			const Int c = ((s + 1) % segments) * sides + (t + 1) % sides;
+			const Int d = s * sides + (t + 1) % sides;
+			addFace(mesh, a, b, c);
+			addFace(mesh, a, c, d);
+		}
+	}
+	finishMesh(mesh);
+}
+
+/// A bumpy open sheet, its border edges have no neighbors
+void makeSheet(BenchmarkMesh &mesh, const char *name, Int cells, std::mt19937 &random)
+{
+	std::uniform_real_distribution<Real> height(0.0f, 3.0f);
+	mesh.name = name;
+	for (Int y = 0; y <= cells; ++y)
+	{
+		for (Int x = 0; x <= cells; ++x)
+			mesh.vertices.push_back(Vector3((Real)x, (Real)y, height(random)));
+	}
+	for (Int y = 0; y < cells; ++y)
+	{
+		for (Int x = 0; x < cells; ++x)
+		{
+			const Int a = y * (cells + 1) + x;
+			addFace(mesh, a, a + 1, a + cells + 2);
+			addFace(mesh, a, a + cells + 2, a + cells + 1);
+		}
+	}
+	finishMesh(mesh);
+}
+
+void fillSilhouette(const BenchmarkMesh &mesh, W3DShadowSilhouette &silhouette)
+{
+	const Int numFaces = (Int)mesh.normals.size();
+	silhouette.allocate(numFaces);
+	for (Int face = 0; face < numFaces; ++face)
+	{
+		const Short *poly = &mesh.indices[face * 3];
+		silhouette.setFace(face, poly, mesh.vertices[poly[0]], mesh.normals[face]);
+		for (Int i = 0; i < 3; ++i)
+			silhouette.setNeighbor(face, i, mesh.neighbors[face * 3 + i], poly[i], poly[i == 2 ? 0 : i + 1]);
+	}
+}
+
+/// The edge of the original addSilhouetteEdge
+void addReferenceEdge(const BenchmarkMesh &mesh, Int visible, Int hidden, std::vector<Short> &edges)
+{
+	Int slot = 0;
+	for (Int i = 0; i < 3; ++i)
+	{
+		if (mesh.neighbors[visible * 3 + i] == hidden)
+		{
+			slot = i;
+			break;
+		}
+	}
+	const Short *poly = &mesh.indices[visible * 3];
+	const Short edge0 = poly[slot];
+	const Short edge1 = poly[slot == 2 ? 0 : slot + 1];
+	if (poly[0] != edge0 && poly[0] != edge1)
+	{
+		edges.push_back(poly[1]);
+		edges.push_back(poly[2]);
+	}
+	else if (poly[1] != edge0 && poly[1] != edge1)
+	{
+		edges.push_back(poly[2]);
+		edges.push_back(poly[0]);
+	}
+	else
+	{
+		edges.push_back(poly[0]);
+		edges.push_back(poly[1]);
+	}
+}
+
+/// The original buildSilhouette, with its processing flags
+void buildReferenceEdges(BenchmarkMesh &mesh, const Vector3 &lightPos, std::vector<Short> &edges)
+{
+	const Int numFaces = (Int)mesh.normals.size();
+	edges.clear();
+	for (Int i = 0; i < numFaces; ++i)
+	{
+		mesh.status[i] = 0;
+		Vector3 lightVector = mesh.vertices[mesh.indices[i * 3]] - lightPos;
+		if (Vector3::Dot_Product(lightVector, mesh.normals[i]) < 0.0f)
+			mesh.status[i] |= POLY_VISIBLE;
+	}
+
+	for (Int i = 0; i < numFaces; ++i)
+	{
+		Bool visibleNeighborless = FALSE;
+		for (Int j = 0; j < 3; ++j)
+		{
+			const Int other = mesh.neighbors[i * 3 + j];
+			if (other != W3DShadowSilhouette::NO_NEIGHBOR && (mesh.status[other] & POLY_PROCESSED))
+				continue;
+
+			if (mesh.status[i] & POLY_VISIBLE)
+			{
+				if (other == W3DShadowSilhouette::NO_NEIGHBOR)
+					visibleNeighborless = TRUE;
+				else if (!(mesh.status[other] & POLY_VISIBLE))
+					addReferenceEdge(mesh, i, other, edges);
+			}
+			else if (other != W3DShadowSilhouette::NO_NEIGHBOR && (mesh.status[other] & POLY_VISIBLE))
+			{
+				addReferenceEdge(mesh, other, i, edges);
+			}
+		}
+
+		if (visibleNeighborless)
+		{
+			for (Int j = 0; j < 3; ++j)
+			{
+				if (mesh.neighbors[i * 3 + j] == W3DShadowSilhouette::NO_NEIGHBOR)
+				{
+					edges.push_back(mesh.indices[i * 3 + j]);
+					edges.push_back(mesh.indices[i * 3 + (j == 2 ? 0 : j + 1)]);
+				}
+			}
+		}
+
+		mesh.status[i] |= POLY_PROCESSED;
+	}
+}
+
+/// The sun in the space of a unit at the position, turned by the angle around Z
+Vector3 getLightInObject(const Vector3 &sun, Real x, Real y, Real angle)
+{
+	const Real dx = sun.X - x;
+	const Real dy = sun.Y - y;
+	const Real c = cosf(angle);
+	const Real s = sinf(angle);
+	return Vector3(c * dx + s * dy, c * dy - s * dx, sun.Z);
+}
+
+double getMilliseconds(std::chrono::steady_clock::duration duration)
+{
+	return std::chrono::duration<double, std::milli>(duration).count();
+}
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+/** Checks the silhouettes of generated meshes from random lights against the original neighbor walk,
+	* then times a crowd of units that share a mesh and face a few ways, as a map full of them does. */
+// ------------------------------------------------------------------------------------------------
+Int W3DShadowSilhouette::benchmark(Int rounds)
+{
+	const Real SUN_DISTANCE = 10000.0f;
+	const Int CROWD_UNITS = 200;
+	const Int CROWD_FACINGS = 8;
+
+	std::mt19937 random(rounds);
+	std::uniform_real_distribution<Real> angleDistribution(0.0f, 2.0f * 3.14159265f);
+	std::uniform_real_distribution<Real> elevationDistribution(0.3f, 1.4f);
+	std::uniform_real_distribution<Real> positionDistribution(-2000.0f, 2000.0f);
+	std::uniform_real_distribution<Real> spreadDistribution(-50.0f, 50.0f);
+	std::uniform_real_distribution<Real> jitterDistribution(-0.002f, 0.002f);
+
+	BenchmarkMesh meshes[4];
+	makeTorus(meshes[0], "small ring", 24, 12, random);
+	makeTorus(meshes[1], "big ring", 96, 48, random);
+	makeSheet(meshes[2], "sheet", 32, random);
+	makeSheet(meshes[3], "big sheet", 90, random);
+
+	// Note that we use printf here because this is run from cmd.
+	printf("Shadow silhouettes: %d rounds, faces tested with %s\n", rounds, getBatchName());
+	fflush(stdout);
+
+	const Bool wasCacheEnabled = s_isCacheEnabled;
+	Int mismatches = 0;
+	std::vector<Short> edges;
+	std::vector<Short> referenceEdges;
+
+	for (Int m = 0; m < 4; ++m)
+	{
+		BenchmarkMesh &mesh = meshes[m];
+		W3DShadowSilhouette silhouette;
+		fillSilhouette(mesh, silhouette);
+
+		std::chrono::steady_clock::duration referenceTime(0);
+		std::chrono::steady_clock::duration exactTime(0);
+		Int roundedDifferences = 0;
+		Int meshMismatches = 0;
+
+		for (Int round = 0; round < rounds; ++round)
+		{
+			const Real angle = angleDistribution(random);
+			const Real elevation = elevationDistribution(random);
+			const Vector3 sun(SUN_DISTANCE * cosf(angle) * cosf(elevation), SUN_DISTANCE * sinf(angle) * cosf(elevation), SUN_DISTANCE * sinf(elevation));
+			const Vector3 lightPos = getLightInObject(sun, positionDistribution(random), positionDistribution(random), angleDistribution(random));
+
+			// the exact silhouette is the one the original walk builds
+			const std::chrono::steady_clock::time_point referenceStart = std::chrono::steady_clock::now();
+			buildReferenceEdges(mesh, lightPos, referenceEdges);
+			const std::chrono::steady_clock::time_point exactStart = std::chrono::steady_clock::now();
+			silhouette.buildEdges(lightPos, edges);
+			const std::chrono::steady_clock::time_point exactEnd = std::chrono::steady_clock::now();
+			referenceTime += exactStart - referenceStart;
+			exactTime += exactEnd - exactStart;
+			if (edges != referenceEdges)
+				++meshMismatches;
+			for (Int face = 0; face < silhouette.getNumFaces(); ++face)
+			{
+				if (silhouette.m_visible[face] != (mesh.status[face] & POLY_VISIBLE))
+				{
+					++meshMismatches;
+					break;
+				}
+			}
+
+			// the cached silhouette is the one the original walk builds from the rounded light, found or not
+			Vector3 cachedLight;
+			if (getCachedLight(lightPos, &cachedLight))
+			{
+				s_isCacheEnabled = TRUE;
+				const Bool isExact = silhouette.getEdges(lightPos) == referenceEdges;
+				buildReferenceEdges(mesh, cachedLight, referenceEdges);
+				if (silhouette.getEdges(lightPos) != referenceEdges)
+					++meshMismatches;
+				if (!isExact)
+					++roundedDifferences;
+				s_isCacheEnabled = wasCacheEnabled;
+			}
+		}
+
+		printf("  %s, %d faces: original walk %.3f ms, arrays %.3f ms, %d of the rounded lights change the silhouette, %s\n",
+			mesh.name, silhouette.getNumFaces(), getMilliseconds(referenceTime), getMilliseconds(exactTime),
+			roundedDifferences, meshMismatches == 0 ? "match" : "DO NOT MATCH");
+		fflush(stdout);
+		mismatches += meshMismatches;
+	}
+
+	// a crowd of units of one model, each facing one of a few ways give or take a little, lit by the same sun
+	{
+		BenchmarkMesh &mesh = meshes[0];
+		W3DShadowSilhouette silhouette;
+		fillSilhouette(mesh, silhouette);
+		const Vector3 sun(SUN_DISTANCE * 0.5f, SUN_DISTANCE * 0.3f, SUN_DISTANCE * 0.81f);
+
+		std::vector<Vector3> units;
+		for (Int unit = 0; unit < CROWD_UNITS; ++unit)
+		{
+			const Real facing = 2.0f * 3.14159265f * (unit % CROWD_FACINGS) / CROWD_FACINGS;
+			units.push_back(Vector3(spreadDistribution(random), spreadDistribution(random), facing));
+		}
+
+		std::chrono::steady_clock::duration times[2];
+		const UnsignedInt hitsBefore = s_cacheHits;
+		const UnsignedInt missesBefore = s_cacheMisses;
+		Int numEdges[2] = { 0, 0 };
+		for (Int pass = 0; pass < 2; ++pass)
+		{
+			std::mt19937 jitterRandom(rounds);
+			s_isCacheEnabled = pass == 1;
+			silhouette.clearCache();
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (Int round = 0; round < rounds; ++round)
+			{
+				for (size_t unit = 0; unit < units.size(); ++unit)
+				{
+					const Vector3 lightPos = getLightInObject(sun, units[unit].X, units[unit].Y, units[unit].Z + jitterDistribution(jitterRandom));
+					numEdges[pass] += (Int)silhouette.getEdges(lightPos).size();
+				}
+			}
+			times[pass] = std::chrono::steady_clock::now() - start;
+		}
+		s_isCacheEnabled = wasCacheEnabled;
+
+		const UnsignedInt hits = s_cacheHits - hitsBefore;
+		const UnsignedInt misses = s_cacheMisses - missesBefore;
+		printf("  %d units in %d facings: built every time %.3f ms, cached %.3f ms, %.1f%% found in the cache, %d edges built and %d cached\n",
+			CROWD_UNITS, CROWD_FACINGS, getMilliseconds(times[0]), getMilliseconds(times[1]),
+			hits + misses > 0 ? 100.0 * hits / (hits + misses) : 0.0, numEdges[0] / 2, numEdges[1] / 2);
+	}
+
+	printf("Results %s\n", mismatches == 0 ? "match" : "DO NOT MATCH");
+	fflush(stdout);
+
+	return mismatches == 0 ? 0 : 1;
+}
@@ -562,6 +562,8 @@ Bool W3DTerrainVisual::load( AsciiString filename )
   // allocate new height map data to read from file
   REF_PTR_RELEASE( m_logicHeightMap );
 	m_logicHeightMap = NEW WorldHeightMap(pStrm);
+	// GeneralsX @performance 18/10/2026 The line of sight checks skip over the cells this tells are low enough
+	m_logicHeightMap->buildCellHeightPyramid();
 
 #ifdef DO_SEISMIC_SIMULATIONS
 
@@ -886,6 +888,14 @@ Bool W3DTerrainVisual::getWaterGridHeight( Real worldX, Real worldY, Real *heigh
 	return FALSE;
 }
 
+// ------------------------------------------------------------------------------------------------
+/** The water grid does not depend on the map, the benchmark steps a grid of its own */
+// ------------------------------------------------------------------------------------------------
+Bool W3DTerrainVisual::benchmarkWaterGrid( Int steps )
+{
+	return W3DWaterGrid::benchmark( steps, TheGlobalData->m_gravity );
+}
+
 // ------------------------------------------------------------------------------------------------
 // ------------------------------------------------------------------------------------------------
 void W3DTerrainVisual::setRawMapHeight(const ICoord2D *gridPos, Int height)
@@ -903,6 +913,7 @@ void W3DTerrainVisual::setRawMapHeight(const ICoord2D *gridPos, Int height)
  		if (m_logicHeightMap->getHeight(x,y) > height)
 		{
 			m_logicHeightMap->setRawHeight(x, y, height);
+			m_logicHeightMap->updateCellHeightPyramid(x, y);
 			m_terrainRenderObject->staticLightingChanged(); // OOH! this could benefit from the new Seismic update code
 
 
@@ -1228,6 +1239,7 @@ void W3DTerrainVisual::xfer( Xfer *xfer )
 		xfer->xferUser(data, len);
 		if (xfer->getXferMode() == XFER_LOAD)
     {
+			m_logicHeightMap->buildCellHeightPyramid();
 			// Update the display height map.
 			m_terrainRenderObject->staticLightingChanged();
 		}
@@ -1701,7 +1701,6 @@ void W3DView::update()
 	getAxisAlignedViewRegion(axisAlignedRegion);
 
 	// render all of the visible Drawables
-	/// @todo this needs to use a real region partition or something
 	TheGameClient->iterateDrawablesInRegion( &axisAlignedRegion, drawDrawable, nullptr );
 }
 
@@ -2396,6 +2395,116 @@ View::WorldToScreenReturn W3DView::worldToScreenTriReturn( const Coord3D *w, ICo
   return WTS_INVALID;
 }
 
+//-------------------------------------------------------------------------------------------------
+/** Is the center of the drawable projected inside the normalized screen region */
+//-------------------------------------------------------------------------------------------------
+Bool W3DView::isDrawableInNormalizedRegion( const Drawable *draw, const Region2D &normalizedRegion )
+{
+	Vector3 screen, world;
+
+	// project the center of the drawable to the screen
+	/// @todo use a real 3D position in the drawable
+	const Coord3D *pos = draw->getPosition();
+	world.X = pos->x;
+	world.Y = pos->y;
+	world.Z = pos->z;
+
+	// project the world point to the screen
+	return m_3DCamera->Project( screen, world ) == CameraClass::INSIDE_FRUSTUM &&
+				 screen.X >= normalizedRegion.lo.x &&
+				 screen.X <= normalizedRegion.hi.x &&
+				 screen.Y >= normalizedRegion.lo.y &&
+				 screen.Y <= normalizedRegion.hi.y;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Collect the drawables that could project into the screen region from the client drawable
+	* grid, in drawable list order. Returns FALSE if the grid can't narrow the search down. */
+// GeneralsX @performance 18/10/2026 Drag selection used to project every drawable in the world.
+//-------------------------------------------------------------------------------------------------
+Bool W3DView::collectDrawablesInScreenRegion( const IRegion2D *screenRegion, std::vector<DrawableID> &candidates )
+{
+	DrawableGrid *grid = TheGameClient->getDrawableGrid();
+	if( grid->isEmpty() )
+		return FALSE;
+
+	//
+	// a drawable projects into the screen region only if it lies in the pyramid spanned by the
+	// pick rays through the corners of the region, and all drawables lie between the lowest and
+	// highest heights the grid has seen. Bound the part of the pyramid between those heights.
+	//
+	const Real lowZ = grid->getLowestZ() - 1.0f;
+	const Real highZ = grid->getHighestZ() + 1.0f;
+
+	ICoord2D corners[ 4 ];
+	corners[ 0 ].x = screenRegion->lo.x;	corners[ 0 ].y = screenRegion->lo.y;
+	corners[ 1 ].x = screenRegion->hi.x;	corners[ 1 ].y = screenRegion->lo.y;
+	corners[ 2 ].x = screenRegion->hi.x;	corners[ 2 ].y = screenRegion->hi.y;
+	corners[ 3 ].x = screenRegion->lo.x;	corners[ 3 ].y = screenRegion->hi.y;
+
+	//  points 1-4 are the far ends of the corner rays, point 0 is the camera
+	Vector3 points[ 5 ];
+	for( Int i = 0; i < 4; ++i )
+		getPickRay( &corners[ i ], &points[ 0 ], &points[ i + 1 ] );
+
+	static const Int edges[ 8 ][ 2 ] = { { 0, 1 }, { 0, 2 }, { 0, 3 }, { 0, 4 }, { 1, 2 }, { 2, 3 }, { 3, 4 }, { 4, 1 } };
+
+	Region2D box;
+	Bool found = FALSE;
+	Coord2D point;
+
+	for( Int i = 0; i < 5; ++i )
+	{
+		if( points[ i ].Z >= lowZ && points[ i ].Z <= highZ )
+		{
+			point.x = points[ i ].X;
+			point.y = points[ i ].Y;
+			if( !found )
+				box.lo = box.hi = point;
+			box.lo.x = min( box.lo.x, point.x );
+			box.lo.y = min( box.lo.y, point.y );
+			box.hi.x = max( box.hi.x, point.x );
+			box.hi.y = max( box.hi.y, point.y );
+			found = TRUE;
+		}
+	}
+
+	for( Int i = 0; i < 8; ++i )
+	{
+		const Vector3 &a = points[ edges[ i ][ 0 ] ];
+		const Vector3 &b = points[ edges[ i ][ 1 ] ];
+
+		for( Int plane = 0; plane < 2; ++plane )
+		{
+			Real z = plane ? highZ : lowZ;
+			if( (a.Z - z) * (b.Z - z) >= 0.0f )
+				continue;
+
+			Real t = (z - a.Z) / (b.Z - a.Z);
+			point.x = a.X + (b.X - a.X) * t;
+			point.y = a.Y + (b.Y - a.Y) * t;
+			if( !found )
+				box.lo = box.hi = point;
+			box.lo.x = min( box.lo.x, point.x );
+			box.lo.y = min( box.lo.y, point.y );
+			box.hi.x = max( box.hi.x, point.x );
+			box.hi.y = max( box.hi.y, point.y );
+			found = TRUE;
+		}
+	}
+
+	if( !found )
+	{
+		// the region can't see any height a drawable is at
+		candidates.clear();
+		return TRUE;
+	}
+
+	// leave some room for the precision of the projection
+	constexpr const Real margin = 1.0f;
+	return grid->collectDrawablesInBox( box.lo.x - margin, box.lo.y - margin, box.hi.x + margin, box.hi.y + margin, candidates );
+}
+
 //-------------------------------------------------------------------------------------------------
 /** all the drawables in the view, that fall within the 2D screen region
 	* will call the callback function.  The number of drawables that passed
@@ -2409,13 +2518,8 @@ Int W3DView::iterateDrawablesInRegion( IRegion2D *screenRegion,
 	Bool inside = FALSE;
 	Int count = 0;
 	Drawable *draw;
-	Vector3 screen, world;
-	Coord3D pos;
 	Region2D normalizedRegion;
 
-	/** @todo we need to have partitions of which drawables are in the
-	view so we don't have to march through the whole list */
-
 	//
 	// to do this we are projecting the drawable centers onto the screen,
 	// the W3D camera->project method is used to do this and that method
@@ -2450,6 +2554,25 @@ Int W3DView::iterateDrawablesInRegion( IRegion2D *screenRegion,
 			return 0;
 		}
 	}
+	else if (screenRegion)
+	{
+		// only test the drawables the grid says could be in the region, in the same order
+		std::vector<DrawableID> candidates;
+		if (collectDrawablesInScreenRegion(screenRegion, candidates))
+		{
+			for (size_t i = 0; i < candidates.size(); ++i)
+			{
+				// look it up again, an earlier callback may have destroyed it
+				draw = TheGameClient->findDrawableByID(candidates[i]);
+				if (draw != nullptr && isDrawableInNormalizedRegion(draw, normalizedRegion))
+				{
+					if( callback( draw, userData ) )
+						++count;
+				}
+			}
+			return count;
+		}
+	}
 
 	for( draw = TheGameClient->firstDrawable();
 			 draw;
@@ -2469,28 +2592,8 @@ Int W3DView::iterateDrawablesInRegion( IRegion2D *screenRegion,
 			// no screen region, means all drawbles
 			if( screenRegion == nullptr )
 				inside = TRUE;
-			else
-			{
-
-				// project the center of the drawable to the screen
-				/// @todo use a real 3D position in the drawable
-				pos = *draw->getPosition();
-				world.X = pos.x;
-				world.Y = pos.y;
-				world.Z = pos.z;
-
-				// project the world point to the screen
-				if( m_3DCamera->Project( screen, world ) == CameraClass::INSIDE_FRUSTUM &&
-						screen.X >= normalizedRegion.lo.x &&
-						screen.X <= normalizedRegion.hi.x &&
-						screen.Y >= normalizedRegion.lo.y &&
-						screen.Y <= normalizedRegion.hi.y )
-				{
-
-					inside = TRUE;
-
-				}
-			}
+			else if( isDrawableInNormalizedRegion( draw, normalizedRegion ) )
+				inside = TRUE;
 
 		}
 
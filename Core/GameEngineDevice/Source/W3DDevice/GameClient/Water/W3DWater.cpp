@@ -318,9 +318,7 @@ WaterRenderObjClass::~WaterRenderObjClass()
 		SAFE_RELEASE( m_pBumpTexture2[i]);
 	}
 
-	delete [] m_meshData;
-	m_meshData = nullptr;
-	m_meshDataSize = 0;
+	m_meshGrid.release();
 
 	//Release strings allocated inside global water settings.
 	for  (i=0; i<TIME_OF_DAY_COUNT; i++)
@@ -360,8 +358,6 @@ WaterRenderObjClass::WaterRenderObjClass()
 
 	m_dwWavePixelShader=0;
 	m_dwWaveVertexShader=0;
-	m_meshData=nullptr;
-	m_meshDataSize = 0;
 	m_meshInMotion = FALSE;
 	m_gridOrigin=Vector2(0,0);
 	m_gridDirectionX=Vector2(1.0f,0.0f);
@@ -879,7 +875,7 @@ void WaterRenderObjClass::ReAcquireResources()
 
 	//We're using the same grid for either 3D Water Mesh or Pixel/Vertex shader.  Just
 	//allocate the right size depending on usage
-	if (m_meshData)
+	if (m_meshGrid.isAllocated())
 	{
 		//Create new grid data
 		if (FAILED(generateIndexBuffer(m_gridCellsX+1,m_gridCellsY+1)))
@@ -1170,32 +1166,11 @@ void WaterRenderObjClass::reset()
 {
 
 	// for vertex animated water mesh reset the values
-	if( m_meshData)
+	if( m_meshGrid.isAllocated() )
 	{
-		Int i, j;
-		WaterMeshData *pData;
-		Int	mx = m_gridCellsX + 1;
-		Int my = m_gridCellsY + 1;
 
-		// go through each mesh point and adjust the height according to the velocity
-		for( j = 0, pData = m_meshData; j < (my + 2); j++ )
-		{
-
-			for( i = 0; i < (mx + 2); i++ )
-			{
-
-				// areset grid values for this cell
-				pData->velocity = 0.0f;
-				pData->height = 0.0f;
-				pData->preferredHeight = 0.0f;
-				pData->status = WaterRenderObjClass::AT_REST;
-
-				// on to the next one
-				pData++;
-
-			}
-
-		}
+		// reset grid values for every cell
+		m_meshGrid.reset();
 
 		// mesh data is no longer in motion
 		m_meshInMotion = FALSE;
@@ -1213,13 +1188,11 @@ void WaterRenderObjClass::enableWaterGrid(Bool state)
 	m_drawingRiver = false;
 	m_disableRiver = false;
 
-	if (state && m_meshData == nullptr)
+	if (state && !m_meshGrid.isAllocated())
 	{	//water type has changed, must allocate necessary assets for new water.
 		//contains the current deformed water surface z(height) values.  With 1 vertex invisible border
 		//around surface to speed up normal calculations.
-		m_meshDataSize = (m_gridCellsX+1+2)*(m_gridCellsY+1+2);
-		m_meshData=NEW WaterMeshData[ m_meshDataSize ];
-		memset(m_meshData,0,sizeof(WaterMeshData)*(m_gridCellsX+1+2)*(m_gridCellsY+1+2));
+		m_meshGrid.allocate(m_gridCellsX+1+2, m_gridCellsY+1+2);
 		reset();
 
 		//Release existing grid data
@@ -1260,73 +1233,11 @@ void WaterRenderObjClass::update()
 		// for vertex animated water we need to update the vector field
 		if( m_doWaterGrid && m_meshInMotion == TRUE )
 		{
-			const Real PREFERRED_HEIGHT_FUDGE = 1.0f;		///< this is close enough to at rest
-			const Real AT_REST_VELOCITY_FUDGE = 1.0f;		///< when we're close enough to at rest height and velocity we will stop
-			const Real WATER_DAMPENING = 0.93f;					///< use with up force of 15.0
-			Int i, j;
-			Int	mx = m_gridCellsX+1;
-			Int my = m_gridCellsY+1;
-			WaterMeshData *pData;
-
 			//
-			// we will mark the mesh as clean now ... if any of the fields are still in motion
-			// they will continue to mark the mesh as dirty so processing continues next frame
+			// only the points in motion are stepped, the mesh stays dirty for as long as
+			// any of them are still in motion so processing continues next frame
 			//
-			m_meshInMotion = FALSE;
-
-			// go through each mesh point and adjust the height according to the velocity
-			for( j = 0, pData = m_meshData; j < (my + 2); j++ )
-			{
-
-				for( i = 0; i < (mx + 2); i++ )
-				{
-
-					// only pay attention to mesh points that are in motion
-					if( BitIsSet( pData->status, WaterRenderObjClass::IN_MOTION ) )
-					{
-
-						// DAMPENING to slow the changes down
-						pData->velocity *= WATER_DAMPENING;
-
-						// if the height here is below our preferred height, we want to add upward force to counteract it
-						if( pData->height < pData->preferredHeight )
-							pData->velocity -= TheGlobalData->m_gravity * 3.0f;
-						else
-							pData->velocity += TheGlobalData->m_gravity * 3.0f;
-
-						// adjust the height at this grid location according to the current velocity
-						pData->height = pData->height + pData->velocity;
-
-						//
-						// if we are close enough to our preferred height and our velocity is small enough
-						// this will be our resting location
-						//
-						if( fabs( pData->height - pData->preferredHeight ) < PREFERRED_HEIGHT_FUDGE &&
-								fabs( pData->velocity ) < AT_REST_VELOCITY_FUDGE )
-						{
-
-							BitClear( pData->status, WaterRenderObjClass::IN_MOTION );
-							pData->height = pData->preferredHeight;
-							pData->velocity = 0.0f;
-
-						}
-						else
-						{
-
-							// there is still motion in the mesh, we need to process next frame
-							m_meshInMotion = TRUE;
-
-						}
-
-					}
-
-					// on to the next one
-					pData++;
-
-				}
-
-			}
-
+			m_meshInMotion = m_meshGrid.update( TheGlobalData->m_gravity );
 		}
 
 	}
@@ -2276,7 +2187,7 @@ void WaterRenderObjClass::renderWaterMesh()
 
 	Setting *setting=&m_settings[m_tod];
 
-	WaterMeshData *pData;
+	const Real *pData;
 	Int	mx=m_gridCellsX+1;
 	Int my=m_gridCellsY+1;
 	Int i,j;
@@ -2305,15 +2216,14 @@ void WaterRenderObjClass::renderWaterMesh()
 	static Real PhasePerFrameY=0.1f;
 
 	//update the mesh heights for this frame (update buffer is 2 samples wider/taller due to border)
-	for (j=0,pData=m_meshData; j<(my+2); j++)
+	for (j=0; j<(my+2); j++)
 	{
 		for (i=0; i<(mx+2); i++)
 		{
 			//*pData = WATER_AMP * sin(WATER_FREQ*(0.7f*i + 0.7f*j) - PhasePerFrame);
 
-			pData->height=WATER_OFFSET+WATER_AMP*(sin((float)i*WATER_FREQ*0.4+PhasePerFrameX*0.5)+sin((float)i*WATER_FREQ*0.6+PhasePerFrameX*0.2)+sin((float)j*WATER_FREQ+PhasePerFrameX)+sin((float)j*WATER_FREQ*0.7+PhasePerFrameX*0.3));
+			m_meshGrid.setHeight(m_meshGrid.getIndex(i,j),WATER_OFFSET+WATER_AMP*(sin((float)i*WATER_FREQ*0.4+PhasePerFrameX*0.5)+sin((float)i*WATER_FREQ*0.6+PhasePerFrameX*0.2)+sin((float)j*WATER_FREQ+PhasePerFrameX)+sin((float)j*WATER_FREQ*0.7+PhasePerFrameX*0.3)));
 //			*pData=WATER_OFFSET+WATER_AMP*(sin((float)i*WATER_FREQ*0.4+PhasePerFrameX*0.5)+sin((float)i*WATER_FREQ*0.6+PhasePerFrameX*0.2)+sin((float)j*WATER_FREQ+PhasePerFrameX)+sin((float)j*WATER_FREQ*0.7+PhasePerFrameX*0.3));
-			pData++;
 		}
 	}
 
@@ -2348,7 +2258,7 @@ void WaterRenderObjClass::renderWaterMesh()
 	Real bumpSizeDiv2=0.3f*cellSizeY/BUMP_SIZE;
 
 	//Data has a 1 vertex padding all around it so we don't need to special-case edges.  Improves performance
-	for (j=0,pData=m_meshData+mx+2+1; j<my; j++,pData+=2)	//skip 2 horizontal border samples after each row
+	for (j=0,pData=m_meshGrid.getHeights()+mx+2+1; j<my; j++,pData+=2)	//skip 2 horizontal border samples after each row
 	{
 		Real y=(float)j*cellSizeY;
 		Real v1Offset=m_riverVOrigin+(float)j*vScale + uvCosScale*WWMath::Fast_Sin(sinOffset+y*PI/(8*MAP_XY_FACTOR));
@@ -2358,8 +2268,8 @@ void WaterRenderObjClass::renderWaterMesh()
 		{
 			//compute normal by looking at 4 vertex neightbors
 #ifdef USE_MESH_NORMALS
-			nx.Z=(pData+1)->height - (pData-1)->height;
-			ny.Z=(pData+mx+2)->height - (pData-mx-2)->height;
+			nx.Z=*(pData+1) - *(pData-1);
+			ny.Z=*(pData+mx+2) - *(pData-mx-2);
 //			nx.Z=*(pData+1)-*(pData-1);
 //			ny.Z=*(pData+mx+2)-*(pData-mx-2);
 			Vector3::Cross_Product(nx,ny,&C);
@@ -2371,7 +2281,7 @@ void WaterRenderObjClass::renderWaterMesh()
 			Real x = (float)i*cellSizeX;
 			vb->x=	x;
 			vb->y=	y;
-			vb->z=  pData->height;//WATER_OFFSET+WATER_AMP*(sin((float)i*WATER_FREQ+PhasePerFrame)+cos((float)j*WATER_FREQ+PhasePerFrame));
+			vb->z=  *pData;//WATER_OFFSET+WATER_AMP*(sin((float)i*WATER_FREQ+PhasePerFrame)+cos((float)j*WATER_FREQ+PhasePerFrame));
 
 			vb->diffuse = diffuse;
 #ifdef SCROLL_UV
@@ -2484,9 +2394,9 @@ inline void WaterRenderObjClass::setGridVertexHeight(Int x, Int y, Real value)
 {
 	DEBUG_ASSERTCRASH( x < (m_gridCellsX+1) && y < (m_gridCellsY+1), ("Invalid Water Mesh Coordinates") );
 
-	if (m_meshData)
+	if (m_meshGrid.isAllocated())
 	{
-		m_meshData[(y+1)*(m_gridCellsX+1+2)+x+1].height = value;
+		m_meshGrid.setHeight(m_meshGrid.getIndex(x+1,y+1), value);
 	}
 }
 
@@ -2505,7 +2415,6 @@ void WaterRenderObjClass::addVelocity( Real worldX, Real worldY,
 		Real gx,gy;
 		Real minX,maxX,minY,maxY;
 		Int x,y;
-		WaterMeshData *meshPoint;
 		m_disableRiver = true;
 
 		//check if center falls within grid bounds
@@ -2532,20 +2441,11 @@ void WaterRenderObjClass::addVelocity( Real worldX, Real worldY,
 				for (x=minX; x<=maxX; x++)
 				{
 
-					// get the mesh point that we're concerned with
-					meshPoint = &m_meshData[ (y + 1) * (m_gridCellsX + 1 + 2) + x + 1 ];
-
-					// we now have a new preferred height
-					meshPoint->preferredHeight = preferredHeight;
-
 					//
 					// set the velocity of this point based on the distance from the center of the
-					// "core" point for this call
+					// "core" point for this call, it now has a new preferred height and is "in motion"
 					//
-					meshPoint->velocity = meshPoint->velocity + zVelocity;
-
-					// this point is now "in motion"
-					BitSet( meshPoint->status, WaterRenderObjClass::IN_MOTION );
+					m_meshGrid.addVelocity( x + 1, y + 1, zVelocity, preferredHeight );
 
 				}
 			}
@@ -2591,7 +2491,7 @@ void WaterRenderObjClass::changeGridHeight(Real wx, Real wy, Real delta)
 		for (y=minY; y<=maxY; y++)
 		{
 			for (x=minX; x<=maxX; x++)
-			{	oldData = &m_meshData[(y+1)*(m_gridCellsX+1+2)+x+1].height;
+			{	oldData = m_meshGrid.getHeightPtr(m_meshGrid.getIndex(x+1,y+1));
 				distance = (gx - (Real)x)*(gx - (Real)x) + (gy - (Real)y)*(gy - (Real)y);
 				distance = sqrt(distance);
 				newData = *oldData + 1.0f/(m_gridChangeAtt0+m_gridChangeAtt1*distance+distance*distance*m_gridChangeAtt2)*delta;
@@ -2659,12 +2559,10 @@ void WaterRenderObjClass::setGridResolution(Real gridCellsX, Real gridCellsY, Re
 		m_gridCellsX=gridCellsX;
 		m_gridCellsY=gridCellsY;
 
-		if (m_meshData)
+		if (m_meshGrid.isAllocated())
 		{
 
-			delete [] m_meshData;//free previously allocated grid and allocate new size
-			m_meshData = nullptr;	 // must set to null so that we properly re-allocate
-			m_meshDataSize = 0;
+			m_meshGrid.release();//free previously allocated grid and allocate new size
 
 			Bool enable = m_doWaterGrid;
 			enableWaterGrid(true);	// allocates buffers.
@@ -2704,9 +2602,13 @@ Real WaterRenderObjClass::getWaterHeight(Real x, Real y)
 	iLoc.y = REAL_TO_INT_FLOOR( y + 0.5f );
 	iLoc.z = 0;
 
-	for( PolygonTrigger *pTrig = PolygonTrigger::getFirstPolygonTrigger(); pTrig; pTrig = pTrig->getNext() )
+	// GeneralsX @performance 18/10/2026 Only the triggers bucketed at this location can contain it
+	Int numTriggers = 0;
+	PolygonTrigger *const *triggers = PolygonTrigger::getTriggersAt( iLoc, &numTriggers );
+	for( Int i = 0; i < numTriggers; ++i )
 	{
 
+		const PolygonTrigger *pTrig = triggers[ i ];
 		if( !pTrig->isWaterArea() )
 			continue;
 
@@ -3496,23 +3398,32 @@ void WaterRenderObjClass::xfer( Xfer *xfer )
 	}
 
 	// xfer each of the mesh data points
-	for( UnsignedInt i = 0; i < m_meshDataSize; ++i )
+	for( Int i = 0; i < m_meshGrid.getPointCount(); ++i )
 	{
 
 		// height
-		xfer->xferReal( &m_meshData[ i ].height );
+		Real height = m_meshGrid.getHeight( i );
+		xfer->xferReal( &height );
 
 		// velocity
-		xfer->xferReal( &m_meshData[ i ].velocity );
+		Real velocity = m_meshGrid.getVelocity( i );
+		xfer->xferReal( &velocity );
 
 		// status
-		xfer->xferUnsignedByte( &m_meshData[ i ].status );
+		UnsignedByte status = m_meshGrid.getStatus( i );
+		xfer->xferUnsignedByte( &status );
 
 		// preferred height
-		xfer->xferUnsignedByte( &m_meshData[ i ].preferredHeight );
+		UnsignedByte preferredHeight = m_meshGrid.getPreferredHeight( i );
+		xfer->xferUnsignedByte( &preferredHeight );
+
+		m_meshGrid.setPoint( i, height, velocity, status, preferredHeight );
 
 	}
 
+	// the loaded points in motion must be inside the motion rectangle
+	m_meshGrid.updateMotionBounds();
+
 }
 
 // ------------------------------------------------------------------------------------------------
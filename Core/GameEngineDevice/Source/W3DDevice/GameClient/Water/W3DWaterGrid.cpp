@@ -0,0 +1,482 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: W3DWaterGrid.cpp /////////////////////////////////////////////////////////////////////////
+// The points of the vertex animated water mesh and their motion
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "W3DDevice/GameClient/W3DWaterGrid.h"
+
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <random>
+#include <string.h>
+
+// four points are stepped at once where the compiler targets SSE2 or NEON
+#if defined(__SSE2__) || defined(__x86_64__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WATER_GRID_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define WATER_GRID_USE_NEON
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+const Real PREFERRED_HEIGHT_FUDGE = 1.0f;		///< this is close enough to at rest
+const Real AT_REST_VELOCITY_FUDGE = 1.0f;		///< when we're close enough to at rest height and velocity we will stop
+const Real WATER_DAMPENING = 0.93f;					///< use with up force of 15.0
+
+const UnsignedInt IN_MOTION_IN_FOUR_POINTS = W3DWaterGrid::IN_MOTION * 0x01010101u;
+
+/// Steps one point in motion, exactly the way WaterRenderObjClass::update always did.
+/// Returns TRUE if the point is still in motion.
+inline Bool stepPoint(Real &height, Real &velocity, UnsignedByte &status, Real preferredHeight, Real force)
+{
+	// DAMPENING to slow the changes down
+	velocity *= WATER_DAMPENING;
+
+	// if the height here is below our preferred height, we want to add upward force to counteract it
+	if( height < preferredHeight )
+		velocity -= force;
+	else
+		velocity += force;
+
+	// adjust the height at this grid location according to the current velocity
+	height = height + velocity;
+
+	//
+	// if we are close enough to our preferred height and our velocity is small enough
+	// this will be our resting location
+	//
+	if( fabs( height - preferredHeight ) < PREFERRED_HEIGHT_FUDGE &&
+			fabs( velocity ) < AT_REST_VELOCITY_FUDGE )
+	{
+		BitClear( status, W3DWaterGrid::IN_MOTION );
+		height = preferredHeight;
+		velocity = 0.0f;
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+#if defined(WATER_GRID_USE_SSE2) || defined(WATER_GRID_USE_NEON)
+/// Steps the four points from index, each lane like stepPoint. Points at rest are left alone.
+/// Returns a bit per lane of the points still in motion.
+inline Int stepFourPoints(Real *heights, Real *velocities, UnsignedByte *status, const Real *preferredHeights, Real force)
+{
+	UnsignedInt statusWord;
+	memcpy(&statusWord, status, sizeof(statusWord));
+
+#if defined(WATER_GRID_USE_SSE2)
+	const __m128 damp = _mm_set1_ps(WATER_DAMPENING);
+	const __m128 up = _mm_set1_ps(force);
+	const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i inMotion = _mm_set1_epi32(W3DWaterGrid::IN_MOTION);
+
+	__m128i lanes = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int)statusWord), zero), zero);
+	const __m128 active = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(lanes, inMotion), inMotion));
+
+	const __m128 height = _mm_loadu_ps(heights);
+	const __m128 velocity = _mm_loadu_ps(velocities);
+	const __m128 preferred = _mm_loadu_ps(preferredHeights);
+
+	__m128 newVelocity = _mm_mul_ps(velocity, damp);
+	const __m128 below = _mm_cmplt_ps(height, preferred);
+	newVelocity = _mm_or_ps(_mm_and_ps(below, _mm_sub_ps(newVelocity, up)), _mm_andnot_ps(below, _mm_add_ps(newVelocity, up)));
+	__m128 newHeight = _mm_add_ps(height, newVelocity);
+
+	const __m128 rest = _mm_and_ps(
+		_mm_cmplt_ps(_mm_and_ps(_mm_sub_ps(newHeight, preferred), absMask), _mm_set1_ps(PREFERRED_HEIGHT_FUDGE)),
+		_mm_cmplt_ps(_mm_and_ps(newVelocity, absMask), _mm_set1_ps(AT_REST_VELOCITY_FUDGE)));
+	newHeight = _mm_or_ps(_mm_and_ps(rest, preferred), _mm_andnot_ps(rest, newHeight));
+	newVelocity = _mm_andnot_ps(rest, newVelocity);
+
+	_mm_storeu_ps(heights, _mm_or_ps(_mm_and_ps(active, newHeight), _mm_andnot_ps(active, height)));
+	_mm_storeu_ps(velocities, _mm_or_ps(_mm_and_ps(active, newVelocity), _mm_andnot_ps(active, velocity)));
+
+	const Int stoppedLanes = _mm_movemask_ps(_mm_and_ps(active, rest));
+	const Int movingLanes = _mm_movemask_ps(_mm_andnot_ps(rest, active));
+#else
+	const float32x4_t damp = vdupq_n_f32(WATER_DAMPENING);
+	const float32x4_t up = vdupq_n_f32(force);
+
+	const uint32x4_t lanes = vmovl_u16(vget_low_u16(vmovl_u8(vcreate_u8(statusWord))));
+	const uint32x4_t active = vtstq_u32(lanes, vdupq_n_u32(W3DWaterGrid::IN_MOTION));
+
+	const float32x4_t height = vld1q_f32(heights);
+	const float32x4_t velocity = vld1q_f32(velocities);
+	const float32x4_t preferred = vld1q_f32(preferredHeights);
+
+	float32x4_t newVelocity = vmulq_f32(velocity, damp);
+	const uint32x4_t below = vcltq_f32(height, preferred);
+	newVelocity = vbslq_f32(below, vsubq_f32(newVelocity, up), vaddq_f32(newVelocity, up));
+	float32x4_t newHeight = vaddq_f32(height, newVelocity);
+
+	const uint32x4_t rest = vandq_u32(
+		vcltq_f32(vabsq_f32(vsubq_f32(newHeight, preferred)), vdupq_n_f32(PREFERRED_HEIGHT_FUDGE)),
+		vcltq_f32(vabsq_f32(newVelocity), vdupq_n_f32(AT_REST_VELOCITY_FUDGE)));
+	newHeight = vbslq_f32(rest, preferred, newHeight);
+	newVelocity = vbslq_f32(rest, vdupq_n_f32(0.0f), newVelocity);
+
+	vst1q_f32(heights, vbslq_f32(active, newHeight, height));
+	vst1q_f32(velocities, vbslq_f32(active, newVelocity, velocity));
+
+	const uint32x4_t stopped = vandq_u32(active, rest);
+	const uint32x4_t moving = vbicq_u32(active, rest);
+	const Int stoppedLanes = (vgetq_lane_u32(stopped, 0) & 1) | (vgetq_lane_u32(stopped, 1) & 2) |
+		(vgetq_lane_u32(stopped, 2) & 4) | (vgetq_lane_u32(stopped, 3) & 8);
+	const Int movingLanes = (vgetq_lane_u32(moving, 0) & 1) | (vgetq_lane_u32(moving, 1) & 2) |
+		(vgetq_lane_u32(moving, 2) & 4) | (vgetq_lane_u32(moving, 3) & 8);
+#endif
+
+	for (Int lane = 0; lane < 4; ++lane)
+	{
+		if (stoppedLanes & (1 << lane))
+			BitClear(status[lane], W3DWaterGrid::IN_MOTION);
+	}
+
+	return movingLanes;
+}
+#endif
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+W3DWaterGrid::W3DWaterGrid() :
+	m_pointsX(0),
+	m_pointsY(0)
+{
+	clearMotionBounds();
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void W3DWaterGrid::allocate(Int pointsX, Int pointsY)
+{
+	m_pointsX = pointsX;
+	m_pointsY = pointsY;
+	m_heights.assign(pointsX * pointsY, 0.0f);
+	m_velocities.assign(pointsX * pointsY, 0.0f);
+	m_preferredHeights.assign(pointsX * pointsY, 0.0f);
+	m_status.assign(pointsX * pointsY, AT_REST);
+	clearMotionBounds();
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void W3DWaterGrid::release()
+{
+	std::vector<Real>().swap(m_heights);
+	std::vector<Real>().swap(m_velocities);
+	std::vector<Real>().swap(m_preferredHeights);
+	std::vector<UnsignedByte>().swap(m_status);
+	m_pointsX = 0;
+	m_pointsY = 0;
+	clearMotionBounds();
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void W3DWaterGrid::reset()
+{
+	std::fill(m_heights.begin(), m_heights.end(), 0.0f);
+	std::fill(m_velocities.begin(), m_velocities.end(), 0.0f);
+	std::fill(m_preferredHeights.begin(), m_preferredHeights.end(), 0.0f);
+	std::fill(m_status.begin(), m_status.end(), (UnsignedByte)AT_REST);
+	clearMotionBounds();
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void W3DWaterGrid::clearMotionBounds()
+{
+	m_motionMinX = 0;
+	m_motionMaxX = -1;
+	m_motionMinY = 0;
+	m_motionMaxY = -1;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void W3DWaterGrid::setPoint(Int index, Real height, Real velocity, UnsignedByte status, UnsignedByte preferredHeight)
+{
+	m_heights[index] = height;
+	m_velocities[index] = velocity;
+	m_status[index] = status;
+	m_preferredHeights[index] = preferredHeight;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Fits the motion rectangle around the points in motion, after they were set one by one */
+// ------------------------------------------------------------------------------------------------
+void W3DWaterGrid::updateMotionBounds()
+{
+	clearMotionBounds();
+	for (Int y = 0; y < m_pointsY; ++y)
+	{
+		for (Int x = 0; x < m_pointsX; ++x)
+		{
+			if (BitIsSet(m_status[getIndex(x, y)], IN_MOTION))
+			{
+				if (!hasMotion())
+				{
+					m_motionMinX = x;
+					m_motionMaxX = x;
+					m_motionMinY = y;
+				}
+				m_motionMinX = MIN(m_motionMinX, x);
+				m_motionMaxX = MAX(m_motionMaxX, x);
+				m_motionMaxY = y;
+			}
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+void W3DWaterGrid::addVelocity(Int pointX, Int pointY, Real velocity, UnsignedByte preferredHeight)
+{
+	const Int index = getIndex(pointX, pointY);
+
+	// we now have a new preferred height
+	m_preferredHeights[index] = preferredHeight;
+	m_velocities[index] = m_velocities[index] + velocity;
+
+	// this point is now "in motion"
+	BitSet(m_status[index], IN_MOTION);
+
+	if (!hasMotion())
+	{
+		m_motionMinX = m_motionMaxX = pointX;
+		m_motionMinY = m_motionMaxY = pointY;
+	}
+	else
+	{
+		m_motionMinX = MIN(m_motionMinX, pointX);
+		m_motionMaxX = MAX(m_motionMaxX, pointX);
+		m_motionMinY = MIN(m_motionMinY, pointY);
+		m_motionMaxY = MAX(m_motionMaxY, pointY);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Steps the points inside the motion rectangle, which is then fit around the points still in
+	* motion. The points outside the rectangle are all at rest. */
+// ------------------------------------------------------------------------------------------------
+Bool W3DWaterGrid::update(Real gravity)
+{
+	if (!hasMotion())
+		return FALSE;
+
+	const Real force = gravity * 3.0f;
+	Int minX = m_pointsX;
+	Int maxX = -1;
+	Int minY = m_pointsY;
+	Int maxY = -1;
+
+	for (Int y = m_motionMinY; y <= m_motionMaxY; ++y)
+	{
+		Int x = m_motionMinX;
+		Int index = getIndex(x, y);
+		Bool rowInMotion = FALSE;
+
+#if defined(WATER_GRID_USE_SSE2) || defined(WATER_GRID_USE_NEON)
+		for (; x + 3 <= m_motionMaxX; x += 4, index += 4)
+		{
+			UnsignedInt statusWord;
+			memcpy(&statusWord, &m_status[index], sizeof(statusWord));
+			if ((statusWord & IN_MOTION_IN_FOUR_POINTS) == 0)
+				continue;
+
+			const Int movingLanes = stepFourPoints(&m_heights[index], &m_velocities[index], &m_status[index],
+				&m_preferredHeights[index], force);
+			if (movingLanes != 0)
+			{
+				Int lowLane = 0;
+				while (!(movingLanes & (1 << lowLane)))
+					++lowLane;
+				Int highLane = 3;
+				while (!(movingLanes & (1 << highLane)))
+					--highLane;
+				minX = MIN(minX, x + lowLane);
+				maxX = MAX(maxX, x + highLane);
+				rowInMotion = TRUE;
+			}
+		}
+#endif
+
+		for (; x <= m_motionMaxX; ++x, ++index)
+		{
+			// only pay attention to mesh points that are in motion
+			if (BitIsSet(m_status[index], IN_MOTION) &&
+					stepPoint(m_heights[index], m_velocities[index], m_status[index], m_preferredHeights[index], force))
+			{
+				minX = MIN(minX, x);
+				maxX = MAX(maxX, x);
+				rowInMotion = TRUE;
+			}
+		}
+
+		if (rowInMotion)
+		{
+			minY = MIN(minY, y);
+			maxY = y;
+		}
+	}
+
+	if (maxX < 0)
+	{
+		clearMotionBounds();
+		return FALSE;
+	}
+
+	m_motionMinX = minX;
+	m_motionMaxX = maxX;
+	m_motionMinY = minY;
+	m_motionMaxY = maxY;
+	return TRUE;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+Bool W3DWaterGrid::updateAllPoints(Real gravity)
+{
+	const Real force = gravity * 3.0f;
+	Bool inMotion = FALSE;
+
+	// go through each mesh point and adjust the height according to the velocity
+	for (Int index = 0; index < getPointCount(); ++index)
+	{
+		// only pay attention to mesh points that are in motion
+		if (BitIsSet(m_status[index], IN_MOTION))
+		{
+			if (stepPoint(m_heights[index], m_velocities[index], m_status[index], m_preferredHeights[index], force))
+				inMotion = TRUE;
+		}
+	}
+
+	if (!inMotion)
+		clearMotionBounds();
+	return inMotion;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+const char *W3DWaterGrid::getBatchName()
+{
+#if defined(WATER_GRID_USE_SSE2)
+	return "SSE2";
+#elif defined(WATER_GRID_USE_NEON)
+	return "NEON";
+#else
+	return "scalar";
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Splashes waves into a grid of the size of the shipped maps, the way the wave guides do, and
+	* steps it with update and with updateAllPoints. The two grids must stay equal to the bit. */
+// ------------------------------------------------------------------------------------------------
+Bool W3DWaterGrid::benchmark(Int steps, Real gravity)
+{
+	const Int cells = 128;
+	const Int pointsX = cells + 1 + 2;
+	const Int pointsY = cells + 1 + 2;
+	const Int WAVE_PERIOD = 512;			///< steps from one wave to the next
+	const Int WAVE_STEPS = 32;				///< steps a wave pushes the water for
+	const Int WAVE_SPREAD = 12;				///< distance of the pushed points from the wave center
+
+	W3DWaterGrid grid;
+	W3DWaterGrid reference;
+	grid.allocate(pointsX, pointsY);
+	reference.allocate(pointsX, pointsY);
+
+	std::mt19937 random(steps);
+	std::uniform_int_distribution<Int> pointDistribution(1, cells + 1);
+	std::uniform_int_distribution<Int> spreadDistribution(-WAVE_SPREAD, WAVE_SPREAD);
+	std::uniform_int_distribution<Int> radiusDistribution(0, 4);
+	std::uniform_int_distribution<Int> preferredDistribution(0, 24);
+	std::uniform_real_distribution<Real> velocityDistribution(-20.0f, 20.0f);
+
+	std::chrono::steady_clock::duration gridTime(0);
+	std::chrono::steady_clock::duration referenceTime(0);
+	Int mismatches = 0;
+	Int64 activePoints = 0;
+	Int waveX = 0;
+	Int waveY = 0;
+	const Int64 pointCount = grid.getPointCount();
+
+	for (Int step = 0; step < steps; ++step)
+	{
+		// a wave guide pushes a few points near it every frame for a while, then the water calms down
+		if (step % WAVE_PERIOD == 0)
+		{
+			waveX = pointDistribution(random);
+			waveY = pointDistribution(random);
+		}
+		if (step % WAVE_PERIOD < WAVE_STEPS)
+		{
+			const Int centerX = waveX + spreadDistribution(random);
+			const Int centerY = waveY + spreadDistribution(random);
+			const Int radius = radiusDistribution(random);
+			const Real velocity = velocityDistribution(random);
+			const UnsignedByte preferredHeight = (UnsignedByte)preferredDistribution(random);
+			for (Int y = MAX(1, centerY - radius); y <= MIN(cells + 1, centerY + radius); ++y)
+			{
+				for (Int x = MAX(1, centerX - radius); x <= MIN(cells + 1, centerX + radius); ++x)
+				{
+					grid.addVelocity(x, y, velocity, preferredHeight);
+					reference.addVelocity(x, y, velocity, preferredHeight);
+				}
+			}
+		}
+
+		if (grid.hasMotion())
+			activePoints += (Int64)(grid.m_motionMaxX - grid.m_motionMinX + 1) * (grid.m_motionMaxY - grid.m_motionMinY + 1);
+
+		const std::chrono::steady_clock::time_point gridStart = std::chrono::steady_clock::now();
+		const Bool gridInMotion = grid.update(gravity);
+		const std::chrono::steady_clock::time_point referenceStart = std::chrono::steady_clock::now();
+		const Bool referenceInMotion = reference.updateAllPoints(gravity);
+		const std::chrono::steady_clock::time_point referenceEnd = std::chrono::steady_clock::now();
+		gridTime += referenceStart - gridStart;
+		referenceTime += referenceEnd - referenceStart;
+
+		if (gridInMotion != referenceInMotion ||
+				memcmp(&grid.m_heights[0], &reference.m_heights[0], pointCount * sizeof(Real)) != 0 ||
+				memcmp(&grid.m_velocities[0], &reference.m_velocities[0], pointCount * sizeof(Real)) != 0 ||
+				memcmp(&grid.m_status[0], &reference.m_status[0], pointCount * sizeof(UnsignedByte)) != 0)
+		{
+			++mismatches;
+		}
+	}
+
+	// Note that we use printf here because this is run from cmd.
+	printf("Water grid: %d steps of %dx%d points, %.1f%% of them walked. Motion rectangle (%s): %.3f ms, whole grid: %.3f ms, %s\n",
+		steps, pointsX, pointsY, steps > 0 ? 100.0 * activePoints / ((double)pointCount * steps) : 0.0, getBatchName(),
+		std::chrono::duration<double, std::milli>(gridTime).count(),
+		std::chrono::duration<double, std::milli>(referenceTime).count(),
+		mismatches == 0 ? "match" : "DO NOT MATCH");
+	fflush(stdout);
+
+	return mismatches == 0;
+}
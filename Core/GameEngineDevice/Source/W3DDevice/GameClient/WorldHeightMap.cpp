@@ -32,10 +32,12 @@
 #include "stdlib.h"
 #include "Common/STLTypedefs.h"
 
+#include "Common/CriticalSection.h"
 #include "Common/DataChunk.h"
 //#include "Common/GameFileSystem.h"
 #include "Common/FileSystem.h" // for LOAD_TEST_ASSETS
 #include "Common/GlobalData.h"
+#include "Common/MapLoadBenchmark.h"
 #include "Common/MapReaderWriterInfo.h"
 #include "Common/TerrainTypes.h"
 #include "Common/ThingFactory.h"
@@ -53,6 +55,11 @@
 
 #include "Common/file.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 
 #define K_OBSOLETE_HEIGHT_MAP_VERSION 8
 
@@ -78,6 +85,190 @@ public:
 	};
 };
 
+/* ********* MemoryFileStream class ****************************/
+class MemoryFileStream : public InputStream
+{
+protected:
+	const char *m_data;
+	Int m_size;
+	Int m_pos;
+public:
+	MemoryFileStream(const char *data, Int size):m_data(data), m_size(size), m_pos(0) {};
+	virtual Int read(void *pData, Int numBytes) override {
+			if (numBytes > m_size - m_pos) numBytes = m_size - m_pos;
+			if (numBytes <= 0) return 0;
+			memcpy(pData, m_data + m_pos, numBytes);
+			m_pos += numBytes;
+			return numBytes;
+	};
+};
+
+/* ********* TerrainTileDecoder class ****************************/
+// GeneralsX @performance 18/10/2026 Decoding the terrain tile targas and building their mips used to
+// run one texture class after the other on the main thread. The files are still read on the main
+// thread, since the file system is not thread safe, and worker threads decode them from the first
+// file on, while the rest of the map is read and the alpha tiles are built. The workers only touch
+// the file data and tiles they are handed. The tiles are allocated and, when the file turns out to be
+// unusable, freed again on the main thread, since they come from the memory pools.
+class TerrainTileDecoder
+{
+public:
+	TerrainTileDecoder() : m_nextJob(0), m_noMoreJobs(false), m_decodeTime(0) {}
+	~TerrainTileDecoder() { finish(); }
+
+	/// Take ownership of a whole targa file to be broken down into width*width tiles, and start
+	/// decoding it. Tiles that do not exist yet are allocated here.
+	void addJob(char *fileData, Int fileSize, TileData **tiles, Int width, Bool isLegacyGrid)
+	{
+		DecodeJob job;
+		job.fileData = fileData;
+		job.fileSize = fileSize;
+		job.tiles = tiles;
+		job.width = width;
+		job.isLegacyGrid = isLegacyGrid;
+		job.failed = false;
+
+		Int jobNdx = (Int)m_jobs.size();
+		for (Int i = 0; i < width*width; ++i)
+		{
+			if (tiles[i] == nullptr)
+			{
+				tiles[i] = MSGNEW("WorldHeightMap_readTiles") TileData;
+				NewTile newTile;
+				newTile.job = jobNdx;
+				newTile.tile = &tiles[i];
+				m_newTiles.push_back(newTile);
+			}
+		}
+
+		// The thread bookkeeping is freed on the worker threads through the game memory, which is
+		// only safe to use from several threads once its critical sections are installed.
+		// WorldBuilder does not install them, so it decodes the tiles here.
+		if (TheMemoryPoolCriticalSection == nullptr || TheDmaCriticalSection == nullptr)
+		{
+			job.failed = !decodeJob(job);
+			job.fileData = nullptr;
+			delete [] fileData;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_jobs.push_back(job);
+		}
+		if (job.fileData == nullptr)
+			return;
+		m_jobAdded.notify_one();
+
+		Int numThreads = (Int)std::thread::hardware_concurrency();
+		if (numThreads < 1)
+			numThreads = 1;
+		if ((Int)m_threads.size() < numThreads && (Int)m_threads.size() < (Int)m_jobs.size())
+			m_threads.push_back(std::thread(decodeThreadFunc, this));
+	}
+
+	/// Wait for the decoding to finish and free the file data.
+	void finish()
+	{
+		if (!m_threads.empty())
+		{
+			UnsignedInt waitStart = timeGetTime();
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_noMoreJobs = true;
+			}
+			m_jobAdded.notify_all();
+			for (size_t i = 0; i < m_threads.size(); ++i)
+				m_threads[i].join();
+
+			// decoding on the main thread would have cost the time of all the jobs, it only waited
+			UnsignedInt waitTime = timeGetTime() - waitStart;
+			UnsignedInt decodeTime = m_decodeTime;
+			UnsignedInt savedTime = decodeTime > waitTime ? decodeTime - waitTime : 0;
+			DEBUG_LOG(("TerrainTileDecoder - decoded %d terrain textures in %d ms on %d threads, waited %d ms, %d ms saved",
+				(Int)m_jobs.size(), decodeTime, (Int)m_threads.size(), waitTime, savedTime));
+			MapLoadBenchmark::addTerrainTileDecode(decodeTime, savedTime);
+			m_threads.clear();
+		}
+
+		// readTiles gives up on a file before touching its tiles, free the ones allocated for it
+		// rather than leave them uninitialised
+		for (size_t i = 0; i < m_newTiles.size(); ++i)
+		{
+			if (m_jobs[m_newTiles[i].job].failed)
+				REF_PTR_RELEASE(*m_newTiles[i].tile);
+		}
+
+		for (size_t i = 0; i < m_jobs.size(); ++i)
+			delete [] m_jobs[i].fileData;
+		m_jobs.clear();
+		m_newTiles.clear();
+		m_nextJob = 0;
+		m_noMoreJobs = false;
+		m_decodeTime = 0;
+	}
+
+private:
+	struct DecodeJob
+	{
+		char *fileData;
+		Int fileSize;
+		TileData **tiles;
+		Int width;
+		Bool isLegacyGrid;
+		Bool failed;			///< readTiles could not use the file
+	};
+
+	struct NewTile
+	{
+		Int job;
+		TileData **tile;
+	};
+
+	static Bool decodeJob(const DecodeJob &job)
+	{
+		MemoryFileStream theStream(job.fileData, job.fileSize);
+		return WorldHeightMap::readTiles(&theStream, job.tiles, job.width, job.isLegacyGrid);
+	}
+
+	static void decodeThreadFunc(TerrainTileDecoder *decoder)
+	{
+		for (;;)
+		{
+			DecodeJob job;
+			size_t jobNdx;
+			{
+				std::unique_lock<std::mutex> lock(decoder->m_mutex);
+				while (decoder->m_nextJob >= decoder->m_jobs.size() && !decoder->m_noMoreJobs)
+					decoder->m_jobAdded.wait(lock);
+				if (decoder->m_nextJob >= decoder->m_jobs.size())
+					break;
+				// copied, the main thread may grow the job list meanwhile
+				jobNdx = decoder->m_nextJob++;
+				job = decoder->m_jobs[jobNdx];
+			}
+
+			UnsignedInt jobStart = timeGetTime();
+			Bool decoded = decodeJob(job);
+			decoder->m_decodeTime += timeGetTime() - jobStart;
+
+			if (!decoded)
+			{
+				std::lock_guard<std::mutex> lock(decoder->m_mutex);
+				decoder->m_jobs[jobNdx].failed = true;
+			}
+		}
+	}
+
+	std::vector<DecodeJob> m_jobs;					///< guarded by m_mutex while the workers run
+	std::vector<NewTile> m_newTiles;				///< the tiles addJob allocated, only used on the main thread
+	std::vector<std::thread> m_threads;
+	std::mutex m_mutex;
+	std::condition_variable m_jobAdded;
+	size_t m_nextJob;
+	Bool m_noMoreJobs;
+	std::atomic<UnsignedInt> m_decodeTime;	///< sum of the time spent in each job, what decoding on one thread would cost
+};
+
 
 /* ********* MapObject class ****************************/
 /*static*/ MapObject *MapObject::TheMapObjectListPtr = nullptr;
@@ -447,6 +638,7 @@ WorldHeightMap::WorldHeightMap():
 		m_sourceTiles[i] = nullptr;
 		m_edgeTiles[i] = nullptr;
 	}
+	m_tileDecoder = nullptr;
 
 	TheSidesList->validateSides();
 	setupAlphaTiles();
@@ -488,6 +680,11 @@ WorldHeightMap::WorldHeightMap(ChunkInputStream *pStrm, Bool logicalDataOnly):
 		m_edgeTiles[i]=nullptr;
 	}
 
+	// GeneralsX @performance 18/10/2026 The tiles are decoded while the rest of the map is read, until
+	// the end of the constructor.
+	TerrainTileDecoder tileDecoder;
+	m_tileDecoder = &tileDecoder;
+
 	DataChunkInput file( pStrm );
 
 	if (logicalDataOnly) {
@@ -508,7 +705,7 @@ WorldHeightMap::WorldHeightMap(ChunkInputStream *pStrm, Bool logicalDataOnly):
 		file.registerParser( "GlobalLighting", AsciiString::TheEmptyString, ParseLightingDataChunk );
 	}
 	if (!file.parse(this)) {
-
+		m_tileDecoder = nullptr;
 		throw(ERROR_CORRUPT_FILE_FORMAT);
 	}
 	// patch bad maps.
@@ -535,6 +732,9 @@ WorldHeightMap::WorldHeightMap(ChunkInputStream *pStrm, Bool logicalDataOnly):
 
 	TheSidesList->validateSides();
 	setupAlphaTiles();
+
+	tileDecoder.finish();
+	m_tileDecoder = nullptr;
 }
 
 /** Optimized version of method to get triangle flip state of a terrain cell.  Use this
@@ -720,6 +920,151 @@ void WorldHeightMap::setCliffState(Int xIndex, Int yIndex, Bool state)
 	m_cellCliffState[yIndex*m_flipStateWidth + (xIndex >> 3)] = flagByte;
 }
 
+//=============================================================================
+// buildCellHeightPyramid
+//=============================================================================
+/** Builds the cell height levels from the height samples. */
+//=============================================================================
+void WorldHeightMap::buildCellHeightPyramid()
+{
+	m_cellHeightLevels.clear();
+	if (!m_data || m_width < 2 || m_height < 2) {
+		return;
+	}
+
+	CellHeightLevel cells;
+	cells.width = m_width-1;
+	cells.height = m_height-1;
+	cells.highest.resize(cells.width*cells.height);
+	for (Int j=0; j<cells.height; j++) {
+		for (Int i=0; i<cells.width; i++) {
+			Int ndx = i + j*m_width;
+			UnsignedByte height = m_data[ndx];
+			height = MAX(height, m_data[ndx + 1]);
+			height = MAX(height, m_data[ndx + m_width]);
+			height = MAX(height, m_data[ndx + m_width + 1]);
+			cells.highest[i + j*cells.width] = height;
+		}
+	}
+	cells.lowest = cells.highest;
+	m_cellHeightLevels.push_back(cells);
+
+	while (m_cellHeightLevels.back().width > 1 || m_cellHeightLevels.back().height > 1) {
+		CellHeightLevel level;
+		level.width = (m_cellHeightLevels.back().width + 1) / 2;
+		level.height = (m_cellHeightLevels.back().height + 1) / 2;
+		level.lowest.resize(level.width*level.height);
+		level.highest.resize(level.width*level.height);
+		m_cellHeightLevels.push_back(level);
+		Int top = (Int)m_cellHeightLevels.size() - 1;
+		for (Int j=0; j<level.height; j++) {
+			for (Int i=0; i<level.width; i++) {
+				updateCellHeightTile(top, i, j);
+			}
+		}
+	}
+}
+
+//=============================================================================
+// updateCellHeightTile
+//=============================================================================
+/** Recomputes a tile of a level above 0 from the 2x2 tiles below it. */
+//=============================================================================
+void WorldHeightMap::updateCellHeightTile(Int level, Int tileX, Int tileY)
+{
+	const CellHeightLevel &below = m_cellHeightLevels[level-1];
+	CellHeightLevel &tiles = m_cellHeightLevels[level];
+	UnsignedByte lowest = 0xff;
+	UnsignedByte highest = 0;
+	for (Int j = 2*tileY; j < 2*tileY + 2 && j < below.height; j++) {
+		for (Int i = 2*tileX; i < 2*tileX + 2 && i < below.width; i++) {
+			lowest = MIN(lowest, below.lowest[i + j*below.width]);
+			highest = MAX(highest, below.highest[i + j*below.width]);
+		}
+	}
+	tiles.lowest[tileX + tileY*tiles.width] = lowest;
+	tiles.highest[tileX + tileY*tiles.width] = highest;
+}
+
+//=============================================================================
+// updateCellHeightPyramid
+//=============================================================================
+/** Updates the 4 cells sharing a height sample, and the tiles above them. */
+//=============================================================================
+void WorldHeightMap::updateCellHeightPyramid(Int xIndex, Int yIndex)
+{
+	if (m_cellHeightLevels.empty()) {
+		return;
+	}
+
+	// setRawHeight indexes the samples linearly, an x off the map changed a sample in another row.
+	Int ndx = (yIndex*m_width)+xIndex;
+	if (ndx < 0 || ndx >= m_dataSize) {
+		return;
+	}
+	xIndex = ndx % m_width;
+	yIndex = ndx / m_width;
+
+	CellHeightLevel &cells = m_cellHeightLevels[0];
+	Int loX = MAX(xIndex-1, 0);
+	Int loY = MAX(yIndex-1, 0);
+	Int hiX = MIN(xIndex, cells.width-1);
+	Int hiY = MIN(yIndex, cells.height-1);
+	if (loX > hiX || loY > hiY) {
+		return;
+	}
+	for (Int j=loY; j<=hiY; j++) {
+		for (Int i=loX; i<=hiX; i++) {
+			Int ndx = i + j*m_width;
+			UnsignedByte height = m_data[ndx];
+			height = MAX(height, m_data[ndx + 1]);
+			height = MAX(height, m_data[ndx + m_width]);
+			height = MAX(height, m_data[ndx + m_width + 1]);
+			cells.highest[i + j*cells.width] = height;
+			cells.lowest[i + j*cells.width] = height;
+		}
+	}
+	for (Int level = 1; level < (Int)m_cellHeightLevels.size(); level++) {
+		loX >>= 1;
+		loY >>= 1;
+		hiX >>= 1;
+		hiY >>= 1;
+		for (Int j=loY; j<=hiY; j++) {
+			for (Int i=loX; i<=hiX; i++) {
+				updateCellHeightTile(level, i, j);
+			}
+		}
+	}
+}
+
+//=============================================================================
+// getCellHeightRange
+//=============================================================================
+/** Gets the lowest and highest cell heights of the tiles of the lowest level
+	that covers the cells with at most 2x2 tiles. The cells must be on the map. */
+//=============================================================================
+Bool WorldHeightMap::getCellHeightRange(Int loX, Int loY, Int hiX, Int hiY, UnsignedByte *lowest, UnsignedByte *highest) const
+{
+	Int level = 0;
+	while ((hiX >> level) - (loX >> level) > 1 || (hiY >> level) - (loY >> level) > 1) {
+		level++;
+	}
+	if (level >= (Int)m_cellHeightLevels.size()) {
+		return false;
+	}
+
+	const CellHeightLevel &tiles = m_cellHeightLevels[level];
+	*lowest = 0xff;
+	*highest = 0;
+	for (Int j = loY >> level; j <= (hiY >> level); j++) {
+		for (Int i = loX >> level; i <= (hiX >> level); i++) {
+			*lowest = MIN(*lowest, tiles.lowest[i + j*tiles.width]);
+			*highest = MAX(*highest, tiles.highest[i + j*tiles.width]);
+		}
+	}
+	return true;
+}
+
 Bool WorldHeightMap::ParseWorldDictDataChunk(DataChunkInput &file, DataChunkInfo *info, void *userData)
 {
 	Dict d = file.readDict();
@@ -979,8 +1324,9 @@ Bool WorldHeightMap::ParseBlendTileDataChunk(DataChunkInput &file, DataChunkInfo
 	return pThis->ParseBlendTileData(file, info, userData);
 }
 
-/** Function to read in the tiles for a texture class. */
-void WorldHeightMap::readTexClass(TXTextureClass *texClass, TileData **tileData)
+/** Function to read in the tiles for a texture class. The file is read here, the tiles are
+		broken out of it by the decoder. */
+void WorldHeightMap::readTexClass(TXTextureClass *texClass, TileData **tileData, TerrainTileDecoder &decoder)
 {
 	char path[_MAX_PATH];
 	path[0] = 0;
@@ -1002,11 +1348,12 @@ void WorldHeightMap::readTexClass(TXTextureClass *texClass, TileData **tileData)
 	}
 
 	if (theFile != nullptr) {
-		GDIFileStream theStream(theFile);
+		Int fileSize = theFile->size();
+		char *fileData = theFile->readEntireAndClose();
+		MemoryFileStream theStream(fileData, fileSize);
 		InputStream *pStr = &theStream;
 		Bool isLegacyGrid = false;
 		Int numTiles = WorldHeightMap::countTiles(pStr, nullptr, texClass->numTiles, &isLegacyGrid);
-		theFile->seek(0, File::START);
 		if (numTiles >= texClass->numTiles) {
 			numTiles = texClass->numTiles;
 			Int width;
@@ -1016,9 +1363,10 @@ void WorldHeightMap::readTexClass(TXTextureClass *texClass, TileData **tileData)
 					break;
 				}
 			}
-			WorldHeightMap::readTiles(pStr, tileData+texClass->firstTile, width, isLegacyGrid);
+			decoder.addJob(fileData, fileSize, tileData+texClass->firstTile, width, isLegacyGrid);
+			return;
 		}
-		theFile->close();
+		delete [] fileData;
 	}
 }
 
@@ -1036,6 +1384,8 @@ Bool WorldHeightMap::ParseBlendTileData(DataChunkInput &file, DataChunkInfo *inf
 	if (m_dataSize != len) {
 		throw ERROR_CORRUPT_FILE_FORMAT	;
 	}
+	TerrainTileDecoder chunkDecoder;
+	TerrainTileDecoder &decoder = m_tileDecoder ? *m_tileDecoder : chunkDecoder;
 	m_tileNdxes = MSGNEW("WorldHeightMap_ParseBlendTileData") Short[m_dataSize];
 	m_cliffInfoNdxes = MSGNEW("WorldHeightMap_ParseBlendTileData") Short[m_dataSize];
 	m_blendTileNdxes = MSGNEW("WorldHeightMap_ParseBlendTileData") Short[m_dataSize];
@@ -1104,7 +1454,7 @@ Bool WorldHeightMap::ParseBlendTileData(DataChunkInput &file, DataChunkInfo *inf
 	/*	Int legacy = */ file.readInt();
 
 		m_textureClasses[i].name = file.readAsciiString();
-		readTexClass(&m_textureClasses[i], m_sourceTiles);
+		readTexClass(&m_textureClasses[i], m_sourceTiles, decoder);
 	}
 	m_numEdgeTextureClasses = 0;
 	m_numEdgeTiles = 0;
@@ -1117,7 +1467,7 @@ Bool WorldHeightMap::ParseBlendTileData(DataChunkInput &file, DataChunkInfo *inf
 			m_edgeTextureClasses[i].numTiles = file.readInt();
 			m_edgeTextureClasses[i].width = file.readInt();
 			m_edgeTextureClasses[i].name = file.readAsciiString();
-			readTexClass(&m_edgeTextureClasses[i], m_edgeTiles);
+			readTexClass(&m_edgeTextureClasses[i], m_edgeTiles, decoder);
 		}
 	}
 	for (i=1; i<m_numBlendedTiles; i++) {
@@ -137,8 +137,11 @@ Int CompressionManager::getMaxCompressedSize( Int uncompressedLen, CompressionTy
 
 		case COMPRESSION_BTREE:   // guessing here
 		case COMPRESSION_HUFF:    // guessing here
-		case COMPRESSION_REFPACK: // guessing here
 			return uncompressedLen + 8;
+		case COMPRESSION_REFPACK:
+			// GeneralsX @bugfix 18/10/2026 Data that does not compress is stored as runs of up to 112 literals
+			// with a command byte each, after a header of up to 6 bytes and before an end of stream byte.
+			return uncompressedLen + uncompressedLen / 112 + 8 + 8;
 		case COMPRESSION_ZLIB1:
 		case COMPRESSION_ZLIB2:
 		case COMPRESSION_ZLIB3:
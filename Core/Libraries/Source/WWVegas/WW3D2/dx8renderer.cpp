@@ -61,6 +61,12 @@
 #include "stripoptimizer.h"
 #include "meshgeometry.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 /*
 ** Global Instance of the DX8MeshRender
 */
@@ -68,9 +74,6 @@ DX8MeshRendererClass TheDX8MeshRenderer;
 bool DX8TextureCategoryClass::m_gForceMultiply = false; // Forces opaque materials to use the multiply blend - pseudo transparent effect.  jba.
 // ----------------------------------------------------------------------------
 
-static DynamicVectorClass<Vector3>				_TempVertexBuffer;
-static DynamicVectorClass<Vector3>				_TempNormalBuffer;
-
 static MultiListClass<MeshModelClass>			_RegisteredMeshList;
 static TextureCategoryList							texture_category_delete_list;
 static FVFCategoryList								fvf_category_container_delete_list;
@@ -89,6 +92,182 @@ typedef MultiListIterator<PolyRemover>		PolyRemoverListIterator;
 
 #define VERTEX_BUFFER_OVERFLOW	0xffff		//'Generals' flag to signal when a mesh didn't fit in streaming vertex buffer.
 
+/**
+** SkinJobClass
+** GeneralsX @performance 18/10/2026 A part of a skinned mesh to deform and copy into the
+** dynamic vertex buffer. Big meshes are cut into several jobs so they can be spread over
+** the skinning threads, the jobs write to different parts of the locked buffer.
+*/
+struct SkinJobClass
+{
+	enum { MAX_VERTICES = 512 };
+
+	MeshClass *					Mesh;
+	int							FirstVertex;
+	int							VertexCount;
+	VertexFormatXYZNDUV2 *	Verts;
+};
+
+/**
+** SkinWorkersClass
+** GeneralsX @performance 18/10/2026 Threads that run the skin jobs of a frame together with the
+** render thread. The bone transforms are only read while the skins are deformed.
+*/
+class SkinWorkersClass
+{
+public:
+	enum { MAX_THREADS = 3 };					///< worker threads in addition to the render thread
+	enum { JOBS_PER_CLAIM = 4 };				///< jobs a thread takes at a time
+	enum { MIN_JOBS_TO_SHARE = 32 };			///< fewer jobs are done on the render thread alone
+
+	SkinWorkersClass() : Jobs(nullptr), JobCount(0), NextJob(0), Generation(0), BusyThreads(0), Quit(false)
+	{
+		int num_threads = (int)std::thread::hardware_concurrency() - 1;
+		if (num_threads > MAX_THREADS)
+			num_threads = MAX_THREADS;
+		for (int i = 0; i < num_threads; ++i)
+			Threads.push_back(std::thread(Thread_Function, this));
+	}
+
+	~SkinWorkersClass()
+	{
+		{
+			std::lock_guard<std::mutex> lock(Mutex);
+			Quit = true;
+		}
+		Wake.notify_all();
+		for (size_t i = 0; i < Threads.size(); ++i)
+			Threads[i].join();
+	}
+
+	// Runs all jobs and returns when they are done
+	void Run(const SkinJobClass * jobs, int job_count)
+	{
+		if (Threads.empty() || job_count < MIN_JOBS_TO_SHARE)
+		{
+			for (int i = 0; i < job_count; ++i)
+				Do_Job(jobs[i]);
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(Mutex);
+			Jobs = jobs;
+			JobCount = job_count;
+			NextJob = 0;
+			BusyThreads = (int)Threads.size();
+			++Generation;
+		}
+		Wake.notify_all();
+
+		Do_Jobs();
+
+		std::unique_lock<std::mutex> lock(Mutex);
+		Done.wait(lock, [this] { return BusyThreads == 0; });
+	}
+
+	static void Do_Job(const SkinJobClass & job);
+
+private:
+	void Do_Jobs()
+	{
+		for (;;)
+		{
+			int first = NextJob.fetch_add(JOBS_PER_CLAIM);
+			if (first >= JobCount)
+				break;
+			int last = first + JOBS_PER_CLAIM;
+			if (last > JobCount)
+				last = JobCount;
+			for (int i = first; i < last; ++i)
+				Do_Job(Jobs[i]);
+		}
+	}
+
+	static void Thread_Function(SkinWorkersClass * workers)
+	{
+		unsigned generation = 0;
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock(workers->Mutex);
+				workers->Wake.wait(lock, [&] { return workers->Quit || workers->Generation != generation; });
+				if (workers->Quit)
+					return;
+				generation = workers->Generation;
+			}
+
+			workers->Do_Jobs();
+
+			std::lock_guard<std::mutex> lock(workers->Mutex);
+			if (--workers->BusyThreads == 0)
+				workers->Done.notify_one();
+		}
+	}
+
+	std::vector<std::thread>	Threads;
+	std::mutex						Mutex;
+	std::condition_variable		Wake;
+	std::condition_variable		Done;
+	const SkinJobClass *			Jobs;
+	int								JobCount;
+	std::atomic<int>				NextJob;
+	unsigned							Generation;
+	int								BusyThreads;
+	bool								Quit;
+};
+
+static SkinWorkersClass *							_SkinWorkers = nullptr;
+static std::vector<SkinJobClass>					_SkinJobs;
+
+void SkinWorkersClass::Do_Job(const SkinJobClass & job)
+{
+	Vector3 loc[SkinJobClass::MAX_VERTICES];
+	Vector3 norm[SkinJobClass::MAX_VERTICES];
+
+	MeshModelClass * mmc = job.Mesh->Peek_Model();
+	const Vector2* uv0=mmc->Get_UV_Array_By_Index(0);
+	const Vector2* uv1=mmc->Get_UV_Array_By_Index(1);
+	if (uv0) uv0+=job.FirstVertex;
+	if (uv1) uv1+=job.FirstVertex;
+
+	VertexFormatXYZNDUV2* verts=job.Verts;
+
+	job.Mesh->Get_Deformed_Vertices(loc,norm,job.FirstVertex,job.VertexCount);
+
+	for (int v=0;v<job.VertexCount;++v) {
+		verts[v].x=loc[v][0];
+		verts[v].y=loc[v][1];
+		verts[v].z=loc[v][2];
+		verts[v].nx=norm[v][0];
+		verts[v].ny=norm[v][1];
+		verts[v].nz=norm[v][2];
+		// Force diffuse to white (0xFFFFFFFF) because Base Game infantry
+		// often have black vertex colors baked into their W3D files
+		// which causes them to render completely black in DXVK when D3DTA_DIFFUSE is used.
+		verts[v].diffuse=0xFFFFFFFF;
+
+		if (uv0) {
+			verts[v].u1=(*uv0)[0];
+			verts[v].v1=(*uv0)[1];
+			uv0++;
+		}
+		else {
+			verts[v].u1=0.0f;
+			verts[v].v1=0.0f;
+		}
+		if (uv1) {
+			verts[v].u2=(*uv1)[0];
+			verts[v].v2=(*uv1)[1];
+			uv1++;
+		}
+		else {
+			verts[v].u2=0.0f;
+			verts[v].v2=0.0f;
+		}
+	}
+}
+
 /**
 ** PolyRenderTaskClass
 ** This is a record of a polyrendere that needs to be rendered
@@ -1320,6 +1499,7 @@ void DX8SkinFVFCategoryContainer::Render()
 			VertexFormatXYZNDUV2 * dest_verts = l.Get_Formatted_Vertex_Array();
 			unsigned vertex_offset=0;
 			remainingMesh = nullptr;
+			_SkinJobs.clear();
 
 			while (mesh != nullptr) {
 
@@ -1341,55 +1521,15 @@ void DX8SkinFVFCategoryContainer::Render()
 		WWASSERT((vertex_offset+mesh_vertex_count)<=VisibleVertexCount);
 			DX8_RECORD_SKIN_RENDER(mesh->Get_Num_Polys(),mesh_vertex_count);
 
-				if (_TempVertexBuffer.Length() < mesh_vertex_count) _TempVertexBuffer.Resize(mesh_vertex_count);
-				if (_TempNormalBuffer.Length() < mesh_vertex_count) _TempNormalBuffer.Resize(mesh_vertex_count);
-
-				Vector3* loc=&(_TempVertexBuffer[0]);
-				Vector3* norm=&(_TempNormalBuffer[0]);
-				const Vector2* uv0=mmc->Get_UV_Array_By_Index(0);
-				const Vector2* uv1=mmc->Get_UV_Array_By_Index(1);
-				const unsigned* diffuse=mmc->Get_Color_Array(0,false);
-
-				VertexFormatXYZNDUV2* verts=dest_verts+vertex_offset;
-
-				mesh->Get_Deformed_Vertices(loc,norm);
-
-				for (int v=0;v<mesh_vertex_count;++v) {
-					verts[v].x=(*loc)[0];
-					verts[v].y=(*loc)[1];
-					verts[v].z=(*loc)[2];
-					verts[v].nx=(*norm)[0];
-					verts[v].ny=(*norm)[1];
-					verts[v].nz=(*norm)[2];
-					// Force diffuse to white (0xFFFFFFFF) because Base Game infantry 
-					// often have black vertex colors baked into their W3D files
-					// which causes them to render completely black in DXVK when D3DTA_DIFFUSE is used.
-					verts[v].diffuse=0xFFFFFFFF;
-					if (diffuse) {
-						diffuse++; // Advance the pointer if it exists, to keep it in sync if needed (though we only use it here)
-					}
-
-					if (uv0) {
-						verts[v].u1=(*uv0)[0];
-						verts[v].v1=(*uv0)[1];
-						uv0++;
-					}
-					else {
-						verts[v].u1=0.0f;
-						verts[v].v1=0.0f;
-					}
-					if (uv1) {
-						verts[v].u2=(*uv1)[0];
-						verts[v].v2=(*uv1)[1];
-						uv1++;
-					}
-					else {
-						verts[v].u2=0.0f;
-						verts[v].v2=0.0f;
-					}
-
-					loc++;
-					norm++;
+				// GeneralsX @performance 18/10/2026 Queue the mesh in parts, they are deformed and copied
+				// into the vertex buffer on the skinning threads once all meshes have their place.
+				for (int first=0;first<mesh_vertex_count;first+=SkinJobClass::MAX_VERTICES) {
+					SkinJobClass job;
+					job.Mesh=mesh;
+					job.FirstVertex=first;
+					job.VertexCount=MIN(mesh_vertex_count-first,(int)SkinJobClass::MAX_VERTICES);
+					job.Verts=dest_verts+vertex_offset+first;
+					_SkinJobs.push_back(job);
 				}
 
 				mesh->Set_Base_Vertex_Offset(vertex_offset);
@@ -1398,6 +1538,11 @@ void DX8SkinFVFCategoryContainer::Render()
 
 				mesh = mesh->Peek_Next_Visible_Skin();
 			}
+
+			if (_SkinWorkers == nullptr) {
+				_SkinWorkers = W3DNEW SkinWorkersClass;
+			}
+			_SkinWorkers->Run(_SkinJobs.data(),(int)_SkinJobs.size());
 		}
 
 		SNAPSHOT_SAY(("Set vb: %x ib: %x",&vb.FVF_Info(),index_buffer));
@@ -2012,8 +2157,9 @@ void DX8MeshRendererClass::Shutdown()
 	visible_decal_meshes = nullptr;
 	Invalidate(true);
 	Clear_Pending_Delete_Lists();
-	_TempVertexBuffer.Clear();	//free memory
-	_TempNormalBuffer.Clear();
+	delete _SkinWorkers;
+	_SkinWorkers = nullptr;
+	std::vector<SkinJobClass>().swap(_SkinJobs);	//free memory
 }
 
 // ----------------------------------------------------------------------------
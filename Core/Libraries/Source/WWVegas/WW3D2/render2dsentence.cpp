@@ -40,6 +40,7 @@
 #include "WWDebug/wwprofile.h"
 #include "WWDebug/wwmemlog.h"
 #include "dx8wrapper.h"
+#include "statistics.h"
 
 
 ////////////////////////////////////////////////////////////////////////////////////
@@ -48,6 +49,39 @@
 #define no_TEST_PLACEMENT 1	 // Shows alignment markers for text.
 
 #define TEXTURE_OFFSET 2
+
+// Number of surfaces a sentence keeps around for reuse after its text shrinks
+#define MAX_SPARE_SURFACES 2
+
+// Layout flags that change where glyphs are placed
+enum
+{
+	BUILD_FLAG_HOT_KEY_PARSE	= 1 << 0,
+	BUILD_FLAG_HARD_WORD_WRAP	= 1 << 1,
+	BUILD_FLAG_CENTERED			= 1 << 2,
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////
+//
+//	Clear_Surface_Area
+//
+////////////////////////////////////////////////////////////////////////////////////
+static void
+Clear_Surface_Area (uint16 *dest_ptr, int dest_stride, int x, int y, int width, int height)
+{
+	if (width <= 0 || height <= 0) {
+		return ;
+	}
+
+	int dest_inc	= (dest_stride >> 1);
+	dest_ptr			+= (dest_inc * y) + x;
+	for (int row = 0; row < height; row ++) {
+		::memset (dest_ptr, 0, width * sizeof (uint16));
+		dest_ptr += dest_inc;
+	}
+}
+
 ////////////////////////////////////////////////////////////////////////////////////
 //
 //	Render2DSentenceClass
@@ -72,7 +106,14 @@ Render2DSentenceClass::Render2DSentenceClass () :
 	Centered (false),
 	DrawExtents (0, 0, 0, 0),
 	ParseHotKey( false ),
-	useHardWordWrap( false)
+	useHardWordWrap( false),
+	BuiltFlags (0),
+	BuiltWrapWidth (0),
+	BuiltTextureSizeHint (0),
+	BuiltHotKeyX (0),
+	BuiltHotKeyY (0),
+	IsBuilt (false),
+	BuildTextStart (nullptr)
 {
 	Shader = Render2DClass::Get_Default_Shader ();
 }
@@ -128,10 +169,7 @@ Render2DSentenceClass::Reset ()
 	//
 	//	Make sure we unlock the current surface (if necessary)
 	//
-	if (LockedPtr != nullptr) {
-		CurSurface->Unlock ();
-		LockedPtr = nullptr;
-	}
+	Unlock_Surface ();
 
 	//
 	//	Release our hold on the current surface
@@ -150,8 +188,33 @@ Render2DSentenceClass::Reset ()
 	MonoSpaced = false;
 	ParseHotKey = false;
 
-	Release_Pending_Surfaces ();
 	Reset_Sentence_Data ();
+	Release_Surfaces ();
+
+	ResumePoints.Reset_Active ();
+	GlyphBlits.Reset_Active ();
+	BuiltText = L"";
+	IsBuilt = false;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////
+//
+//	Invalidate
+//
+////////////////////////////////////////////////////////////////////////////////////
+void
+Render2DSentenceClass::Invalidate ()
+{
+	//
+	//	Same state changes as Reset, but the built sentence, its surfaces and
+	// its renderers are kept so Build_Sentence can update them in place
+	//
+	Unlock_Surface ();
+
+	Cursor.Set (0, 0);
+	MonoSpaced = false;
+	ParseHotKey = false;
 }
 
 
@@ -272,7 +335,20 @@ Render2DSentenceClass::Get_Text_Extents (const WCHAR *text)
 Vector2
 Render2DSentenceClass::Get_Formatted_Text_Extents (const WCHAR *text)
 {
-	return Build_Sentence_Not_Centered(text, nullptr, nullptr, true);
+	//
+	//	Only the flags used by the non-centered layout affect the extents
+	//
+	int flags = Get_Build_Flags () & ~BUILD_FLAG_CENTERED;
+
+	Vector2 extents;
+	if (Font->Get_Cached_Extents (text, WrapWidth, flags, extents)) {
+		Debug_Statistics::Record_Sentence_Build (Debug_Statistics::SENTENCE_EXTENTS_CACHE_HIT);
+		return extents;
+	}
+
+	extents = Build_Sentence_Not_Centered(text, nullptr, nullptr, true);
+	Font->Set_Cached_Extents (text, WrapWidth, flags, extents);
+	return extents;
 }
 
 
@@ -291,29 +367,102 @@ Render2DSentenceClass::Reset_Sentence_Data ()
 		REF_PTR_RELEASE (SentenceData[index].Surface);
 	}
 
-	if (SentenceData.Count()>0) {
-		SentenceData.Delete_All ();
+	SentenceData.Reset_Active ();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////
+//
+//	Unlock_Surface
+//
+////////////////////////////////////////////////////////////////////////////////////
+void
+Render2DSentenceClass::Unlock_Surface ()
+{
+	if (LockedPtr != nullptr) {
+		CurSurface->Unlock ();
+		LockedPtr = nullptr;
 	}
 }
 
 
 ////////////////////////////////////////////////////////////////////////////////////
 //
-//	Release_Pending_Surfaces
+//	Release_Surfaces
 //
 ////////////////////////////////////////////////////////////////////////////////////
 void
-Render2DSentenceClass::Release_Pending_Surfaces ()
+Render2DSentenceClass::Release_Surfaces ()
 {
 	//
-	//	Release our hold on each pending surface
+	//	Release our hold on each surface and its texture
 	//
-	for (int index = 0; index < PendingSurfaces.Count (); index ++) {
-		SurfaceClass *curr_surface = PendingSurfaces[index].Surface;
-		REF_PTR_RELEASE (curr_surface);
+	for (int index = 0; index < Surfaces.Count (); index ++) {
+		REF_PTR_RELEASE (Surfaces[index].Surface);
+		REF_PTR_RELEASE (Surfaces[index].Texture);
+	}
+
+	for (int index = 0; index < SpareSurfaces.Count (); index ++) {
+		REF_PTR_RELEASE (SpareSurfaces[index].Surface);
+		REF_PTR_RELEASE (SpareSurfaces[index].Texture);
 	}
 
-	if (PendingSurfaces.Count()>0) PendingSurfaces.Delete_All ();
+	Surfaces.Reset_Active ();
+	SpareSurfaces.Reset_Active ();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////
+//
+//	Retire_Surfaces
+//
+////////////////////////////////////////////////////////////////////////////////////
+void
+Render2DSentenceClass::Retire_Surfaces (int first_index)
+{
+	//
+	//	Move the surfaces (and their textures) to the spare list so the
+	// next build can reuse them instead of creating new ones
+	//
+	for (int index = first_index; index < Surfaces.Count (); index ++) {
+		SpareSurfaces.Add (Surfaces[index]);
+	}
+
+	if (first_index < Surfaces.Count ()) {
+		Surfaces.Set_Active (first_index);
+	}
+
+	while (SpareSurfaces.Count () > MAX_SPARE_SURFACES) {
+		REF_PTR_RELEASE (SpareSurfaces[0].Surface);
+		REF_PTR_RELEASE (SpareSurfaces[0].Texture);
+		SpareSurfaces.Delete (0);
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////
+//
+//	Release_Unused_Renderers
+//
+////////////////////////////////////////////////////////////////////////////////////
+void
+Render2DSentenceClass::Release_Unused_Renderers ()
+{
+	for (int index = Renderers.Count () - 1; index >= 0; index --) {
+
+		bool in_use = false;
+		for (int surface_index = 0; surface_index < Surfaces.Count (); surface_index ++) {
+			if (Surfaces[surface_index].Surface == Renderers[index].Surface) {
+				in_use = true;
+				break;
+			}
+		}
+
+		if (in_use == false) {
+			delete Renderers[index].Renderer;
+			Renderers.Delete (index);
+		}
+	}
 }
 
 
@@ -330,10 +479,7 @@ Render2DSentenceClass::Build_Textures ()
 	//
 	//	Make sure we unlock the current surface
 	//
-	if (LockedPtr != nullptr) {
-		CurSurface->Unlock ();
-		LockedPtr = nullptr;
-	}
+	Unlock_Surface ();
 
 	//
 	//	Release our hold on the current surface
@@ -343,56 +489,55 @@ Render2DSentenceClass::Build_Textures ()
 	TextureStartX = 0;
 
 	//
-	//	Convert all pending surfaces to textures
+	//	Copy all changed surfaces to their textures
 	//
-	for (int index = 0; index < PendingSurfaces.Count (); index ++) {
-		PendingSurfaceStruct &surface_info = PendingSurfaces[index];
+	for (int index = 0; index < Surfaces.Count (); index ++) {
+		SentenceSurfaceStruct &surface_info = Surfaces[index];
+		if (surface_info.IsDirty == false) {
+			continue;
+		}
+
 		SurfaceClass *curr_surface = surface_info.Surface;
 
 		//
-		//	Get the dimensions of the surface
+		//	Create the texture the first time this surface is used
 		//
-		SurfaceClass::SurfaceDescription desc;
-		curr_surface->Get_Description (desc);
+		if (surface_info.Texture == nullptr) {
 
-		//
-		//	Create the new texture
-		//
-		TextureClass *new_texture = W3DNEW TextureClass (desc.Width, desc.Width, WW3D_FORMAT_A4R4G4B4, MIP_LEVELS_1);
-		SurfaceClass *texture_surface = new_texture->Get_Surface_Level ();
+			//
+			//	Get the dimensions of the surface
+			//
+			SurfaceClass::SurfaceDescription desc;
+			curr_surface->Get_Description (desc);
+
+			TextureClass *new_texture = W3DNEW TextureClass (desc.Width, desc.Width, WW3D_FORMAT_A4R4G4B4, MIP_LEVELS_1);
 
-		new_texture->Get_Filter().Set_U_Addr_Mode(TextureFilterClass::TEXTURE_ADDRESS_CLAMP);
-		new_texture->Get_Filter().Set_V_Addr_Mode(TextureFilterClass::TEXTURE_ADDRESS_CLAMP);
-		new_texture->Get_Filter().Set_Min_Filter(TextureFilterClass::FILTER_TYPE_NONE);
-		new_texture->Get_Filter().Set_Mag_Filter(TextureFilterClass::FILTER_TYPE_NONE);
-		new_texture->Get_Filter().Set_Mip_Mapping(TextureFilterClass::FILTER_TYPE_NONE);
+			new_texture->Get_Filter().Set_U_Addr_Mode(TextureFilterClass::TEXTURE_ADDRESS_CLAMP);
+			new_texture->Get_Filter().Set_V_Addr_Mode(TextureFilterClass::TEXTURE_ADDRESS_CLAMP);
+			new_texture->Get_Filter().Set_Min_Filter(TextureFilterClass::FILTER_TYPE_NONE);
+			new_texture->Get_Filter().Set_Mag_Filter(TextureFilterClass::FILTER_TYPE_NONE);
+			new_texture->Get_Filter().Set_Mip_Mapping(TextureFilterClass::FILTER_TYPE_NONE);
+
+			surface_info.Texture = new_texture;
+		}
 
 		//
 		//	Copy the contents of the texture from the surface
 		//
+		SurfaceClass *texture_surface = surface_info.Texture->Get_Surface_Level ();
 		DX8Wrapper::_Copy_DX8_Rects (curr_surface->Peek_D3D_Surface (), nullptr, 0, texture_surface->Peek_D3D_Surface (), nullptr);
 		REF_PTR_RELEASE (texture_surface);
 
 		//
 		//	Assign this texture to any renderers that need it
 		//
-		for (int renderer_index = 0; renderer_index < surface_info.Renderers.Count (); renderer_index ++) {
-			Render2DClass *renderer = surface_info.Renderers[renderer_index];
-			renderer->Set_Texture (new_texture);
+		for (int renderer_index = 0; renderer_index < Renderers.Count (); renderer_index ++) {
+			if (Renderers[renderer_index].Surface == curr_surface) {
+				Renderers[renderer_index].Renderer->Set_Texture (surface_info.Texture);
+			}
 		}
 
-		//
-		//	Release our hold on the objects
-		//
-		REF_PTR_RELEASE (new_texture);
-		REF_PTR_RELEASE (curr_surface);
-	}
-
-	//
-	//	Reset the list
-	//
-	if (PendingSurfaces.Count()>0) {
-		PendingSurfaces.Delete_All ();
+		surface_info.IsDirty = false;
 	}
 }
 
@@ -457,12 +602,13 @@ Render2DSentenceClass::Draw_Sentence (uint32 color)
 				Renderers.Add (render_info);
 
 				//
-				//	Now, add this renderer to the surface pending list
+				//	Use the surface's texture if it has already been built, otherwise
+				// Build_Textures will assign it
 				//
-				for (int surface_index = 0; surface_index < PendingSurfaces.Count (); surface_index ++) {
-					PendingSurfaceStruct &surface_info = PendingSurfaces[surface_index];
-					if (surface_info.Surface == curr_surface) {
-						surface_info.Renderers.Add (curr_renderer);
+				for (int surface_index = 0; surface_index < Surfaces.Count (); surface_index ++) {
+					SentenceSurfaceStruct &surface_info = Surfaces[surface_index];
+					if (surface_info.Surface == curr_surface && surface_info.Texture != nullptr) {
+						curr_renderer->Set_Texture (surface_info.Texture);
 					}
 				}
 			}
@@ -599,23 +745,12 @@ Render2DSentenceClass::Record_Sentence_Chunk ()
 
 ////////////////////////////////////////////////////////////////////////////////////
 //
-//	Allocate_New_Surface
+//	Calculate_Texture_Size
 //
 ////////////////////////////////////////////////////////////////////////////////////
-void
-Render2DSentenceClass::Allocate_New_Surface (const WCHAR *text, bool justCalcExtents)
+int
+Render2DSentenceClass::Calculate_Texture_Size (const WCHAR *text)
 {
-	if (!justCalcExtents)
-	{
-		//
-		//	Unlock the last surface (if necessary)
-		//
-		if (LockedPtr != nullptr) {
-			CurSurface->Unlock ();
-			LockedPtr = nullptr;
-		}
-	}
-
 	//
 	// Calculate the width of the text
 	//
@@ -629,7 +764,7 @@ Render2DSentenceClass::Allocate_New_Surface (const WCHAR *text, bool justCalcExt
 	//
 	//	Find the best texture size for the remaining text
 	//
-	CurrTextureSize = 256;
+	int texture_size = 256;
 	int best_tex_mem_usage = 999999999;
 	for (int pow2 = 6; pow2 <= 8; pow2 ++) {
 
@@ -654,7 +789,7 @@ Render2DSentenceClass::Allocate_New_Surface (const WCHAR *text, bool justCalcExt
 			//
 			int texture_mem_usage = (texture_count * size * size);
 			if (texture_mem_usage < best_tex_mem_usage) {
-				CurrTextureSize		= size;
+				texture_size			= size;
 				best_tex_mem_usage	= texture_mem_usage;
 			}
 		}
@@ -663,7 +798,27 @@ Render2DSentenceClass::Allocate_New_Surface (const WCHAR *text, bool justCalcExt
 	//
 	//	Use whichever is larger, the hint or the calculated size
 	//
-	CurrTextureSize = max (TextureSizeHint, CurrTextureSize);
+	return max (TextureSizeHint, texture_size);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////
+//
+//	Allocate_New_Surface
+//
+////////////////////////////////////////////////////////////////////////////////////
+void
+Render2DSentenceClass::Allocate_New_Surface (const WCHAR *text, bool justCalcExtents)
+{
+	if (!justCalcExtents)
+	{
+		//
+		//	Unlock the last surface (if necessary)
+		//
+		Unlock_Surface ();
+	}
+
+	CurrTextureSize = Calculate_Texture_Size (text);
 
 	if (!justCalcExtents)
 	{
@@ -673,18 +828,50 @@ Render2DSentenceClass::Allocate_New_Surface (const WCHAR *text, bool justCalcExt
 		REF_PTR_RELEASE (CurSurface);
 
 		//
-		//	Create the new surface
+		//	Reuse a surface from an earlier build if there is one of the right size
 		//
-		CurSurface = NEW_REF (SurfaceClass, (CurrTextureSize, CurrTextureSize, WW3D_FORMAT_A4R4G4B4));
-		WWASSERT (CurSurface != nullptr);
-		CurSurface->Add_Ref ();
+		SentenceSurfaceStruct surface_info;
+		surface_info.Surface = nullptr;
+		surface_info.Texture = nullptr;
+		for (int index = 0; index < SpareSurfaces.Count (); index ++) {
+			if (SpareSurfaces[index].Size == CurrTextureSize) {
+				surface_info = SpareSurfaces[index];
+				SpareSurfaces.Delete (index);
+				break;
+			}
+		}
+
+		if (surface_info.Surface != nullptr) {
+
+			//
+			//	Clear the old text, its pixels would otherwise show through the
+			// overlapping columns of the new glyphs
+			//
+			int stride = 0;
+			uint16 *bits = (uint16 *)surface_info.Surface->Lock (&stride);
+			WWASSERT (bits != nullptr);
+			Clear_Surface_Area (bits, stride, 0, 0, CurrTextureSize, CurrTextureSize);
+			surface_info.Surface->Unlock ();
+
+		} else {
+
+			//
+			//	Create the new surface
+			//
+			surface_info.Surface = NEW_REF (SurfaceClass, (CurrTextureSize, CurrTextureSize, WW3D_FORMAT_A4R4G4B4));
+			WWASSERT (surface_info.Surface != nullptr);
+			surface_info.Size = CurrTextureSize;
+		}
 
 		//
 		//	Add this surface to our list
 		//
-		PendingSurfaceStruct surface_info;
-		surface_info.Surface = CurSurface;
-		PendingSurfaces.Add (surface_info);
+		surface_info.TextIndex	= (int)(text - BuildTextStart);
+		surface_info.IsDirty		= true;
+		Surfaces.Add (surface_info);
+
+		CurSurface = surface_info.Surface;
+		CurSurface->Add_Ref ();
 	}
 
 	//
@@ -694,6 +881,157 @@ Render2DSentenceClass::Allocate_New_Surface (const WCHAR *text, bool justCalcExt
 	TextureStartX = 0;
 }
 
+
+////////////////////////////////////////////////////////////////////////////////////
+//
+//	Get_Build_Flags
+//
+////////////////////////////////////////////////////////////////////////////////////
+int
+Render2DSentenceClass::Get_Build_Flags () const
+{
+	int flags = 0;
+	if (ParseHotKey) {
+		flags |= BUILD_FLAG_HOT_KEY_PARSE;
+	}
+	if (useHardWordWrap) {
+		flags |= BUILD_FLAG_HARD_WORD_WRAP;
+	}
+	if (Centered) {
+		flags |= BUILD_FLAG_CENTERED;
+	}
+	return flags;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////
+//
+//	Begin_Full_Build
+//
+////////////////////////////////////////////////////////////////////////////////////
+void
+Render2DSentenceClass::Begin_Full_Build ()
+{
+	Unlock_Surface ();
+	REF_PTR_RELEASE (CurSurface);
+
+	//
+	//	Everything gets laid out again, keep the surfaces around for reuse
+	//
+	Reset_Sentence_Data ();
+	Retire_Surfaces (0);
+	ResumePoints.Reset_Active ();
+	GlyphBlits.Reset_Active ();
+
+	TextureOffset.Set (0, 0);
+	TextureStartX = 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////
+//
+//	Begin_Incremental_Build
+//
+////////////////////////////////////////////////////////////////////////////////////
+bool
+Render2DSentenceClass::Begin_Incremental_Build (const WCHAR *text, ResumePointStruct &resume)
+{
+	if (IsBuilt == false || ResumePoints.Count () == 0) {
+		return false;
+	}
+
+	//
+	//	Find the first character that differs from the text we built last time
+	//
+	const WCHAR *old_text = BuiltText;
+	int diff_index = 0;
+	while (text[diff_index] != 0 && text[diff_index] == old_text[diff_index]) {
+		diff_index ++;
+	}
+
+	//
+	//	Find the last word break laid out before that character. Everything up to
+	// it only depends on text that has not changed. (The wrap test at a word break
+	// looks ahead at the following word, so the break itself has to come first.)
+	//
+	int resume_index = -1;
+	for (int index = ResumePoints.Count () - 1; index >= 0; index --) {
+		if (ResumePoints[index].TextIndex < diff_index) {
+			resume_index = index;
+			break;
+		}
+	}
+
+	if (resume_index < 0) {
+		return false;
+	}
+
+	resume = ResumePoints[resume_index];
+
+	//
+	//	The surfaces we keep must have the size a full rebuild would pick for
+	// the new text, or the glyphs would be packed differently
+	//
+	for (int index = 0; index <= resume.SurfaceIndex; index ++) {
+		if (Calculate_Texture_Size (text + Surfaces[index].TextIndex) != Surfaces[index].Size) {
+			return false;
+		}
+	}
+
+	//
+	//	Throw away everything laid out after the resume point
+	//
+	Unlock_Surface ();
+	for (int index = resume.SentenceCount; index < SentenceData.Count (); index ++) {
+		REF_PTR_RELEASE (SentenceData[index].Surface);
+	}
+	SentenceData.Set_Active (resume.SentenceCount);
+	Retire_Surfaces (resume.SurfaceIndex + 1);
+	ResumePoints.Set_Active (resume_index);
+	GlyphBlits.Set_Active (resume.GlyphCount);
+
+	SentenceSurfaceStruct &surface_info = Surfaces[resume.SurfaceIndex];
+	surface_info.IsDirty = true;
+	REF_PTR_SET (CurSurface, surface_info.Surface);
+	CurrTextureSize = surface_info.Size;
+
+	//
+	//	Clear the rest of the surface from the resume point on
+	//
+	int char_height = Font->Get_Char_Height ();
+	LockedPtr = (uint16 *)CurSurface->Lock (&LockedStride);
+	WWASSERT (LockedPtr != nullptr);
+
+	Clear_Surface_Area (LockedPtr, LockedStride, resume.TextureOffset.I, resume.TextureOffset.J,
+		CurrTextureSize - resume.TextureOffset.I, char_height);
+	Clear_Surface_Area (LockedPtr, LockedStride, 0, resume.TextureOffset.J + char_height,
+		CurrTextureSize, CurrTextureSize - resume.TextureOffset.J - char_height);
+
+	//
+	//	Glyphs are wider than their spacing, so the ones just before the resume point
+	// can reach into the cleared area. Blit them again in their original order, starting
+	// with the first one that reaches it. Blitting the same glyphs again does not change
+	// the pixels left of the resume point.
+	//
+	int first_glyph = resume.GlyphCount;
+	for (int index = resume.GlyphCount - 1; index >= 0; index --) {
+		const GlyphBlitStruct &glyph = GlyphBlits[index];
+		if (glyph.SurfaceIndex != resume.SurfaceIndex || glyph.Y != resume.TextureOffset.J) {
+			break;
+		}
+		if (glyph.X + Font->Get_Char_Width (glyph.Char) > resume.TextureOffset.I) {
+			first_glyph = index;
+		}
+	}
+
+	for (int index = first_glyph; index < resume.GlyphCount; index ++) {
+		const GlyphBlitStruct &glyph = GlyphBlits[index];
+		Font->Blit_Char (glyph.Char, LockedPtr, LockedStride, glyph.X, glyph.Y);
+	}
+
+	return true;
+}
+
 float FindStartingXPos( const WCHAR *text )
 {
 
@@ -950,7 +1288,7 @@ void	Render2DSentenceClass::Build_Sentence_Centered (const WCHAR *text, int *hkX
 //	Build_Sentence_NotCentered
 //
 ////////////////////////////////////////////////////////////////////////////////////
-Vector2	Render2DSentenceClass::Build_Sentence_Not_Centered (const WCHAR *text, int *hkX, int *hkY, bool justCalcExtents)
+Vector2	Render2DSentenceClass::Build_Sentence_Not_Centered (const WCHAR *text, int *hkX, int *hkY, bool justCalcExtents, const ResumePointStruct *resume)
 {
 	Vector2 cursor = Cursor;
 	int textureStartX = TextureStartX;
@@ -961,26 +1299,43 @@ Vector2	Render2DSentenceClass::Build_Sentence_Not_Centered (const WCHAR *text, i
 	bool calcHotKeyX = false;
 	bool dontBlit = false;
 	Vector2i textureOffset = TextureOffset;
+	const WCHAR *text_start = text;
 
-
-	//
-	//	Start fresh
-	//
-	if (!justCalcExtents)
+	if (resume != nullptr)
 	{
-		Reset_Sentence_Data ();
+		//
+		//	Pick up the layout where the unchanged part of the text ended
+		//
+		text					= text_start + resume->TextIndex;
+		Cursor				= resume->Cursor;
+		TextureOffset		= resume->TextureOffset;
+		TextureStartX		= resume->TextureStartX;
+		maxX					= resume->MaxX;
+		hotKeyPosX			= resume->HotKeyPosX;
+		hotKeyPosY			= resume->HotKeyPosY;
+		calcHotKeyX			= resume->CalcHotKeyX;
 	}
-	Cursor.Set (0, 0);
+	else
+	{
+		//
+		//	Start fresh
+		//
+		if (!justCalcExtents)
+		{
+			Reset_Sentence_Data ();
+		}
+		Cursor.Set (0, 0);
 
-	//
-	//	Ensure we have a surface to start with
-	//
-	if (CurSurface == nullptr) {
-		Allocate_New_Surface (text, justCalcExtents);
-	}
+		//
+		//	Ensure we have a surface to start with
+		//
+		if (CurSurface == nullptr) {
+			Allocate_New_Surface (text, justCalcExtents);
+		}
 
-	TextureOffset.Set (TEXTURE_OFFSET, 0);
-	TextureStartX = TEXTURE_OFFSET;
+		TextureOffset.Set (TEXTURE_OFFSET, 0);
+		TextureStartX = TEXTURE_OFFSET;
+	}
 
 	float char_height = Font->Get_Char_Height ();
 
@@ -988,6 +1343,28 @@ Vector2	Render2DSentenceClass::Build_Sentence_Not_Centered (const WCHAR *text, i
 	//	Loop over all the characters in the string
 	//
 	while (text != nullptr) {
+
+		//
+		//	Remember the layout state at each word break so the sentence can be
+		// rebuilt from here if only the text after it changes
+		//
+		if (!justCalcExtents && (*text == L' ' || *text == L'\n'))
+		{
+			ResumePointStruct resume_point;
+			resume_point.TextIndex		= (int)(text - text_start);
+			resume_point.Cursor			= Cursor;
+			resume_point.TextureOffset	= TextureOffset;
+			resume_point.TextureStartX	= TextureStartX;
+			resume_point.MaxX				= maxX;
+			resume_point.SurfaceIndex	= Surfaces.Count () - 1;
+			resume_point.SentenceCount	= SentenceData.Count ();
+			resume_point.GlyphCount		= GlyphBlits.Count ();
+			resume_point.HotKeyPosX		= hotKeyPosX;
+			resume_point.HotKeyPosY		= hotKeyPosY;
+			resume_point.CalcHotKeyX	= calcHotKeyX;
+			ResumePoints.Add (resume_point);
+		}
+
 		WCHAR ch = *text++;
 		dontBlit = false;
 		//
@@ -1110,6 +1487,13 @@ Vector2	Render2DSentenceClass::Build_Sentence_Not_Centered (const WCHAR *text, i
 			if (!justCalcExtents && !dontBlit )
 			{
 				Font->Blit_Char (ch, LockedPtr, LockedStride, TextureOffset.I, TextureOffset.J);
+
+				GlyphBlitStruct glyph;
+				glyph.Char				= ch;
+				glyph.X					= (short)TextureOffset.I;
+				glyph.Y					= (short)TextureOffset.J;
+				glyph.SurfaceIndex	= (short)(Surfaces.Count () - 1);
+				GlyphBlits.Add (glyph);
 			}
 			TextureOffset.I += char_spacing;
 		}
@@ -1147,11 +1531,46 @@ Render2DSentenceClass::Build_Sentence (const WCHAR *text, int *hkX, int *hkY)
 	if (Font == nullptr)
 		return;
 
-	if(Centered && (WrapWidth > 0 || wcschr(text,L'\n')))
-		Build_Sentence_Centered(text, hkX, hkY);
-	else
-		Build_Sentence_Not_Centered(text, hkX, hkY);
+	// GeneralsX @performance 18/10/2026 Reuse what was built last time. Text that did not change
+	// is not rebuilt at all, and text that changed after a word break (timers, counters, chat lines)
+	// is only laid out and blitted again from that break on. Surfaces and textures are kept
+	// across rebuilds instead of being created for every change.
+	int flags = Get_Build_Flags ();
+	bool same_settings = IsBuilt && BuiltFlags == flags && BuiltWrapWidth == WrapWidth && BuiltTextureSizeHint == TextureSizeHint;
 
+	if (same_settings && BuiltText.Compare (text) == 0) {
+		Debug_Statistics::Record_Sentence_Build (Debug_Statistics::SENTENCE_BUILD_UNCHANGED);
+	} else {
+		BuildTextStart = text;
+
+		ResumePointStruct resume;
+		bool centered = (Centered && (WrapWidth > 0 || wcschr(text,L'\n')));
+		if (same_settings && !centered && Begin_Incremental_Build (text, resume)) {
+			Build_Sentence_Not_Centered(text, &BuiltHotKeyX, &BuiltHotKeyY, false, &resume);
+			Debug_Statistics::Record_Sentence_Build (Debug_Statistics::SENTENCE_BUILD_INCREMENTAL);
+		} else {
+			Begin_Full_Build ();
+			if(centered)
+				Build_Sentence_Centered(text, &BuiltHotKeyX, &BuiltHotKeyY);
+			else
+				Build_Sentence_Not_Centered(text, &BuiltHotKeyX, &BuiltHotKeyY);
+			Debug_Statistics::Record_Sentence_Build (Debug_Statistics::SENTENCE_BUILD_FULL);
+		}
+
+		Release_Unused_Renderers ();
+
+		BuildTextStart				= nullptr;
+		BuiltText					= text;
+		BuiltFlags					= flags;
+		BuiltWrapWidth				= WrapWidth;
+		BuiltTextureSizeHint		= TextureSizeHint;
+		IsBuilt						= true;
+	}
+
+	if(hkX)
+		*hkX = BuiltHotKeyX;
+	if(hkY)
+		*hkY = BuiltHotKeyY;
 }
 
 
@@ -1183,6 +1602,13 @@ FontCharsClass::FontCharsClass () :
 {
 	AlternateUnicodeFont = nullptr;
 	::memset( ASCIICharArray, 0, sizeof (ASCIICharArray) );
+
+	for ( int index = 0; index < EXTENTS_CACHE_SIZE; index ++ ) {
+		ExtentsCache[index].Hash		= 0;
+		ExtentsCache[index].WrapWidth	= 0;
+		ExtentsCache[index].Flags		= -1;
+		ExtentsCache[index].Extents.Set( 0, 0 );
+	}
 }
 
 
@@ -1324,6 +1750,69 @@ FontCharsClass::Blit_Char (WCHAR ch, uint16 *dest_ptr, int dest_stride, int x, i
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////
+//
+//	Get_Extents_Hash
+//
+////////////////////////////////////////////////////////////////////////////////////
+unsigned int
+FontCharsClass::Get_Extents_Hash (const WCHAR *text, float wrap_width, int flags)
+{
+	//
+	//	FNV-1a over the 16-bit characters and the layout settings
+	//
+	unsigned int hash = 2166136261u;
+	for ( ; *text != 0; text ++ ) {
+		hash = (hash ^ static_cast<uint16>(*text)) * 16777619u;
+	}
+
+	hash = (hash ^ static_cast<unsigned int>(wrap_width)) * 16777619u;
+	hash = (hash ^ static_cast<unsigned int>(flags)) * 16777619u;
+	return hash;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////
+//
+//	Get_Cached_Extents
+//
+////////////////////////////////////////////////////////////////////////////////////
+bool
+FontCharsClass::Get_Cached_Extents (const WCHAR *text, float wrap_width, int flags, Vector2 &extents)
+{
+	unsigned int hash = Get_Extents_Hash( text, wrap_width, flags );
+	const ExtentsCacheStruct &entry = ExtentsCache[hash % EXTENTS_CACHE_SIZE];
+
+	if (	entry.Hash == hash && entry.WrapWidth == wrap_width &&
+			entry.Flags == flags && entry.Text.Compare( text ) == 0 )
+	{
+		extents = entry.Extents;
+		return true;
+	}
+
+	return false;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////
+//
+//	Set_Cached_Extents
+//
+////////////////////////////////////////////////////////////////////////////////////
+void
+FontCharsClass::Set_Cached_Extents (const WCHAR *text, float wrap_width, int flags, const Vector2 &extents)
+{
+	unsigned int hash = Get_Extents_Hash( text, wrap_width, flags );
+	ExtentsCacheStruct &entry = ExtentsCache[hash % EXTENTS_CACHE_SIZE];
+
+	entry.Hash			= hash;
+	entry.WrapWidth	= wrap_width;
+	entry.Flags			= flags;
+	entry.Extents		= extents;
+	entry.Text			= text;
+}
+
+
 #ifdef _WIN32
 
 ////////////////////////////////////////////////////////////////////////////////////
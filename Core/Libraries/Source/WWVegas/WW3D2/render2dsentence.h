@@ -41,6 +41,7 @@
 #include "WWLib/Vector.h"
 #include "WWMath/vector2i.h"
 #include "WWLib/wwstring.h"
+#include "WWLib/widestring.h"
 #include "WWLib/win.h"
 
 // GeneralsX @build fbraz 11/02/2026 BenderAI - FreeType2 for Linux text rendering (Phase 1.5)
@@ -101,6 +102,11 @@ public:
 
 	void	Blit_Char( WCHAR ch, uint16 *dest_ptr, int dest_stride, int x, int y );
 
+	// GeneralsX @performance 18/10/2026 Formatted text extents are cached per font so that
+	// display strings do not lay out the same text twice when it changes back and forth.
+	bool	Get_Cached_Extents( const WCHAR *text, float wrap_width, int flags, Vector2 &extents );
+	void	Set_Cached_Extents( const WCHAR *text, float wrap_width, int flags, const Vector2 &extents );
+
 private:
 
 	//
@@ -127,6 +133,18 @@ private:
 	void							Grow_Unicode_Array( WCHAR ch );
 	void							Free_Character_Arrays();
 
+	static unsigned int		Get_Extents_Hash( const WCHAR *text, float wrap_width, int flags );
+
+	enum { EXTENTS_CACHE_SIZE = 64 };
+
+	struct ExtentsCacheStruct {
+		unsigned int		Hash;
+		float					WrapWidth;
+		int					Flags;
+		Vector2				Extents;
+		WideStringClass	Text;
+	};
+
 	//
 	//	Private member data
 	//
@@ -161,6 +179,8 @@ private:
 	uint16								FirstUnicodeChar;
 	uint16								LastUnicodeChar;
 	bool									IsBold;
+
+	ExtentsCacheStruct				ExtentsCache[EXTENTS_CACHE_SIZE];
 };
 
 /*
@@ -176,6 +196,10 @@ public:
 	virtual	void	Reset ();
 	void				Reset_Polys ();
 
+	// GeneralsX @performance 18/10/2026 Flags the sentence for rebuilding but keeps its surfaces,
+	// textures and glyph layout so the next Build_Sentence only redoes the part of the text that changed.
+	void				Invalidate ();
+
 	FontCharsClass *	Peek_Font()						{ return Font; }
 	void	Set_Font( FontCharsClass *font );
 
@@ -242,12 +266,46 @@ private:
 		bool operator!= (const SentenceDataStruct &src)	{ return true; }
 	};
 
-	struct PendingSurfaceStruct {
-		SurfaceClass *								Surface;
-		DynamicVectorClass<Render2DClass *>	Renderers;
+	struct SentenceSurfaceStruct {
+		SurfaceClass *		Surface;
+		TextureClass *		Texture;
+		int					Size;
+		int					TextIndex;		// Index of the first character laid out on this surface
+		bool					IsDirty;			// Surface contents need to be copied to the texture
+
+		bool operator== (const SentenceSurfaceStruct &src)	{ return false; }
+		bool operator!= (const SentenceSurfaceStruct &src)	{ return true; }
+	};
+
+	//
+	//	Layout state just before a word break character is processed. The sentence can
+	// be rebuilt from here when only text after the break has changed.
+	//
+	struct ResumePointStruct {
+		int					TextIndex;
+		Vector2				Cursor;
+		Vector2i				TextureOffset;
+		int					TextureStartX;
+		float					MaxX;
+		int					SurfaceIndex;
+		int					SentenceCount;
+		int					GlyphCount;
+		int					HotKeyPosX;
+		int					HotKeyPosY;
+		bool					CalcHotKeyX;
+
+		bool operator== (const ResumePointStruct &src)	{ return false; }
+		bool operator!= (const ResumePointStruct &src)	{ return true; }
+	};
+
+	struct GlyphBlitStruct {
+		WCHAR					Char;
+		short					X;
+		short					Y;
+		short					SurfaceIndex;
 
-		bool operator== (const PendingSurfaceStruct &src)	{ return false; }
-		bool operator!= (const PendingSurfaceStruct &src)	{ return true; }
+		bool operator== (const GlyphBlitStruct &src)	{ return false; }
+		bool operator!= (const GlyphBlitStruct &src)	{ return true; }
 	};
 
 	struct RendererDataStruct {
@@ -265,15 +323,33 @@ private:
 	void	Build_Textures ();
 	void	Record_Sentence_Chunk ();
 	void	Allocate_New_Surface (const WCHAR *text, bool justCalcExtents = false);
-	void	Release_Pending_Surfaces ();
+	int	Calculate_Texture_Size (const WCHAR *text);
+	void	Unlock_Surface ();
+	void	Release_Surfaces ();
+	void	Retire_Surfaces (int first_index);
+	void	Release_Unused_Renderers ();
+	void	Begin_Full_Build ();
+	bool	Begin_Incremental_Build (const WCHAR *text, ResumePointStruct &resume);
+	int	Get_Build_Flags () const;
 	void	Build_Sentence_Centered (const WCHAR *text, int *hkX, int *hkY);
-	Vector2	Build_Sentence_Not_Centered (const WCHAR *text, int *hkX, int *hkY,bool justCalcExtents = false );
+	Vector2	Build_Sentence_Not_Centered (const WCHAR *text, int *hkX, int *hkY,bool justCalcExtents = false, const ResumePointStruct *resume = nullptr );
 	//
 	//	Private member data
 	//
 	DynamicVectorClass<SentenceDataStruct>		SentenceData;
-	DynamicVectorClass<PendingSurfaceStruct>	PendingSurfaces;
+	DynamicVectorClass<SentenceSurfaceStruct>	Surfaces;
+	DynamicVectorClass<SentenceSurfaceStruct>	SpareSurfaces;
 	DynamicVectorClass<RendererDataStruct>		Renderers;
+	DynamicVectorClass<ResumePointStruct>		ResumePoints;
+	DynamicVectorClass<GlyphBlitStruct>			GlyphBlits;
+	WideStringClass								BuiltText;
+	int													BuiltFlags;
+	float												BuiltWrapWidth;
+	int													BuiltTextureSizeHint;
+	int													BuiltHotKeyX;
+	int													BuiltHotKeyY;
+	bool												IsBuilt;
+	const WCHAR *								BuildTextStart;
 	FontCharsClass	*						Font;
 	Vector2											BaseLocation;
 	Vector2											Location;
@@ -349,6 +349,21 @@ int Debug_Statistics::Get_Draw_Calls()
 	return last_frame_draw_calls;
 }
 
+// ----------------------------------------------------------------------------
+
+static int sentence_builds[Debug_Statistics::SENTENCE_BUILD_TYPE_COUNT];
+static int last_frame_sentence_builds[Debug_Statistics::SENTENCE_BUILD_TYPE_COUNT];
+
+void Debug_Statistics::Record_Sentence_Build(SentenceBuildType type)
+{
+	sentence_builds[type]++;
+}
+
+int Debug_Statistics::Get_Sentence_Builds(SentenceBuildType type)
+{
+	return last_frame_sentence_builds[type];
+}
+
 // ----------------------------------------------------------------------------
 //
 //
@@ -365,6 +380,9 @@ void Debug_Statistics::Begin_Statistics()
 	sorting_polygons=0;
 	sorting_vertices=0;
 	draw_calls=0;
+	for (int i=0;i<SENTENCE_BUILD_TYPE_COUNT;++i) {
+		sentence_builds[i]=0;
+	}
 	Record_Texture_Begin();
 	DX8Wrapper::Begin_Statistics();
 //	DX8MeshRendererClass::Begin_Statistics();
@@ -381,6 +399,9 @@ void Debug_Statistics::End_Statistics()
 	last_frame_sorting_polygons=sorting_polygons;
 	last_frame_sorting_vertices=sorting_vertices;
 	last_frame_draw_calls=draw_calls;
+	for (int i=0;i<SENTENCE_BUILD_TYPE_COUNT;++i) {
+		last_frame_sentence_builds[i]=sentence_builds[i];
+	}
 //	DX8MeshRendererClass::End_Statistics();
 	DX8Wrapper::End_Statistics();
 }
@@ -34,6 +34,16 @@ namespace Debug_Statistics
 		RECORD_TEXTURE_DETAILS
 	};
 
+	// GeneralsX @performance 18/10/2026 Counts how text sentences were (re)built during a frame.
+	enum SentenceBuildType
+	{
+		SENTENCE_BUILD_FULL,				// Laid out and blitted from scratch
+		SENTENCE_BUILD_INCREMENTAL,	// Only the text after the first change was laid out again
+		SENTENCE_BUILD_UNCHANGED,		// Text was the same as last time, nothing was rebuilt
+		SENTENCE_EXTENTS_CACHE_HIT,	// Formatted extents came from the font's layout cache
+		SENTENCE_BUILD_TYPE_COUNT
+	};
+
 	// Texture memory tracking system
 	void Record_Texture_Mode(RecordTextureMode m);
 	RecordTextureMode Get_Record_Texture_Mode();
@@ -60,6 +70,9 @@ namespace Debug_Statistics
 	int Get_Sorting_Vertices();
 	int Get_Draw_Calls();
 
+	void Record_Sentence_Build(SentenceBuildType type);
+	int Get_Sentence_Builds(SentenceBuildType type);
+
 	void Begin_Statistics();
 	void End_Statistics();
 	void Shutdown_Statistics();
@@ -60,8 +60,16 @@
 #include "bitmaphandler.h"
 #include "WWDebug/wwprofile.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 bool TextureLoader::TextureLoadSuspended;
 int TextureLoader::TextureInactiveOverrideTime = 0;
+int TextureLoader::LoaderThreadCount = 0;
 
 #define USE_MANAGED_TEXTURES
 
@@ -206,37 +214,146 @@ void SynchronizedTextureLoadTaskListClass::Remove(TextureLoadTaskClass *task)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+//
+// TextureLoadLaneQueueClass implementation
+//
+////////////////////////////////////////////////////////////////////////////////
+
+bool TextureLoadLaneQueueClass::Is_Empty() const
+{
+	for (int lane = 0; lane < TextureLoadTaskClass::LANE_COUNT; ++lane) {
+		if (!Lanes[lane].Is_Empty()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void TextureLoadLaneQueueClass::Push_Front(TextureLoadTaskClass *task)
+{
+	Lanes[task->Get_Lane()].Push_Front(task);
+}
+
+void TextureLoadLaneQueueClass::Push_Back(TextureLoadTaskClass *task)
+{
+	Lanes[task->Get_Lane()].Push_Back(task);
+}
+
+TextureLoadTaskClass *TextureLoadLaneQueueClass::Pop_Front()
+{
+	for (int lane = 0; lane < TextureLoadTaskClass::LANE_COUNT; ++lane) {
+		if (TextureLoadTaskClass *task = Lanes[lane].Pop_Front()) {
+			return task;
+		}
+	}
+	return nullptr;
+}
+
+void TextureLoadLaneQueueClass::Remove(TextureLoadTaskClass *task)
+{
+	// the lane of a task changes with its priority, so look for it on all of them.
+	for (int lane = 0; lane < TextureLoadTaskClass::LANE_COUNT; ++lane) {
+		Lanes[lane].Remove(task);
+	}
+}
+
+bool TextureLoadLaneQueueClass::Contains(TextureLoadTaskClass *task) const
+{
+	for (int lane = 0; lane < TextureLoadTaskClass::LANE_COUNT; ++lane) {
+		if (task->Get_List() == &Lanes[lane]) {
+			return true;
+		}
+	}
+	return false;
+}
+
+
 // Locks
 
 // To prevent deadlock, threads should acquire locks in the order in which
 // they are defined below. No ordering is necessary for the task list locks,
 // since one thread can never hold two at once.
 
+// GeneralsX @performance 18/10/2026 The loader threads hold the background lock only to take a
+// task off the background queue and to hand it back. The mip levels are decoded without it, while
+// the task is in STATE_LOAD_DECODING.
 static FastCriticalSectionClass					_ForegroundCriticalSection;
 static FastCriticalSectionClass					_BackgroundCriticalSection;
 
 // Lists
 
-static SynchronizedTextureLoadTaskListClass	_ForegroundQueue;
-static SynchronizedTextureLoadTaskListClass	_BackgroundQueue;
+static TextureLoadLaneQueueClass					_ForegroundQueue;
+static TextureLoadLaneQueueClass					_BackgroundQueue;
 
 static TextureLoadTaskListClass					_TexLoadFreeList;
 static TextureLoadTaskListClass					_CubeTexLoadFreeList;
 static TextureLoadTaskListClass					_VolTexLoadFreeList;
 
+// Number of tasks the loader threads are decoding. Guarded by the background lock.
+static int												_DecodingTaskCount;
 
-// The background texture loading thread.
-static class LoaderThreadClass : public ThreadClass
+// Signalled when a loader thread is done decoding a task. A task leaves STATE_LOAD_DECODING
+// with both the background lock and this mutex held, so the state can be waited for under
+// the mutex alone. Taken after the background lock.
+static std::mutex										_DecodedMutex;
+static std::condition_variable						_TaskDecoded;
+
+
+// The background texture loading threads.
+// GeneralsX @performance 18/10/2026 Several textures are decoded at once. ThreadClass does not
+// start threads on _UNIX, so the loader threads are std::threads like the skinning workers.
+static class LoaderThreadsClass
 {
 public:
-#ifdef Exception_Handler
-	LoaderThreadClass(const char *thread_name = "Texture loader thread") : ThreadClass(thread_name, &Exception_Handler) {}
-#else
-	LoaderThreadClass(const char *thread_name = "Texture loader thread") : ThreadClass(thread_name) {}
+	LoaderThreadsClass() : Running(false) {}
+	~LoaderThreadsClass() { Stop(); }
+
+	void Start(int num_threads)
+	{
+		Running = true;
+		for (int i = 0; i < num_threads; ++i) {
+			Threads.push_back(std::thread(&LoaderThreadsClass::Thread_Function, this));
+#ifdef _WIN32
+			SetThreadPriority((HANDLE)Threads.back().native_handle(), THREAD_PRIORITY_BELOW_NORMAL);
 #endif
+		}
+	}
+
+	// Returns when the threads have finished the textures they are decoding
+	void Stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(Mutex);
+			Running = false;
+		}
+		Wake.notify_all();
+		for (size_t i = 0; i < Threads.size(); ++i) {
+			Threads[i].join();
+		}
+		Threads.clear();
+	}
+
+	bool Is_Running() const { return !Threads.empty(); }
+
+	// Wakes a thread after a task was put on the background queue
+	void Notify()
+	{
+		// taking the mutex makes sure a thread that just found the queue empty is waiting already.
+		{
+			std::lock_guard<std::mutex> lock(Mutex);
+		}
+		Wake.notify_one();
+	}
 
-	virtual void Thread_Function() override;
-} _TextureLoadThread;
+private:
+	void Thread_Function();
+
+	std::vector<std::thread> Threads;
+	std::mutex Mutex;
+	std::condition_variable Wake;
+	bool Running;
+} _TextureLoadThreads;
 
 
 // TODO: Legacy - remove this call!
@@ -319,26 +436,43 @@ static bool Is_Format_Compressed(WW3DFormat texture_format,bool allow_compressio
 
 void TextureLoader::Init()
 {
-	WWASSERT(!_TextureLoadThread.Is_Running());
+	WWASSERT(!_TextureLoadThreads.Is_Running());
 
 	ThumbnailManagerClass::Init();
 
-	_TextureLoadThread.Execute();
-	_TextureLoadThread.Set_Priority(-4);
+	_TextureLoadThreads.Start(Get_Loader_Thread_Count());
 	TextureInactiveOverrideTime = 0;
 }
 
 
 void TextureLoader::Deinit()
 {
-	FastCriticalSectionClass::LockClass lock(_BackgroundCriticalSection);
-	_TextureLoadThread.Stop();
+	// NOTE: the loader threads need the background lock to hand back the textures
+	// they are decoding, so it must not be held while they are stopped.
+	_TextureLoadThreads.Stop();
 
 	ThumbnailManagerClass::Deinit();
 	TextureLoadTaskClass::Delete_Free_Pool();
 }
 
 
+void TextureLoader::Set_Loader_Thread_Count(int count)
+{
+	WWASSERT(!_TextureLoadThreads.Is_Running());
+	LoaderThreadCount = count;
+}
+
+
+int TextureLoader::Get_Loader_Thread_Count()
+{
+	int count = LoaderThreadCount;
+	if (count <= 0) {
+		count = (int)std::thread::hardware_concurrency() - 1;
+	}
+	return max(1, min(count, (int)MAX_LOADER_THREADS));
+}
+
+
 bool TextureLoader::Is_DX8_Thread()
 {
 	return (ThreadClass::_Get_Current_Thread_ID() == DX8Wrapper::_Get_Main_Thread_ID());
@@ -756,12 +890,24 @@ void TextureLoader::Request_Foreground_Loading(TextureBaseClass *tc)
 			// we need to remove the task from any queue, since we're going
 			// to finish it up right now.
 
-			// halt background thread. After we're holding this lock,
-			// we know the background thread cannot begin loading
-			// mipmap levels for this texture.
-			FastCriticalSectionClass::LockClass background_lock(_BackgroundCriticalSection);
-			_ForegroundQueue.Remove(task);
-			_BackgroundQueue.Remove(task);
+			for (;;) {
+				{
+					// halt loader threads. After we're holding this lock,
+					// we know no loader thread can begin loading mipmap
+					// levels for this texture.
+					FastCriticalSectionClass::LockClass background_lock(_BackgroundCriticalSection);
+					if (task->Get_State() != TextureLoadTaskClass::STATE_LOAD_DECODING) {
+						_ForegroundQueue.Remove(task);
+						_BackgroundQueue.Remove(task);
+						break;
+					}
+				}
+
+				// a loader thread is decoding the mipmap levels already. Let it
+				// finish, that is quicker than starting over.
+				std::unique_lock<std::mutex> decoded_lock(_DecodedMutex);
+				_TaskDecoded.wait(decoded_lock, [task] { return task->Get_State() != TextureLoadTaskClass::STATE_LOAD_DECODING; });
+			}
 		} else {
 			// Since the task manages all the state associated with loading
 			// a texture, we temporarily create one.
@@ -777,8 +923,8 @@ void TextureLoader::Request_Foreground_Loading(TextureBaseClass *tc)
 		// task to the foreground queue.
 
 		// Grab the background lock. After we're holding this lock, we
-		// know the background thread cannot begin loading mipmap levels
-		// for this texture.
+		// know no loader thread can begin loading mipmap levels for
+		// this texture.
 		FastCriticalSectionClass::LockClass background_lock(_BackgroundCriticalSection);
 
 		// if we have a thumbnail task, we should cancel it. Since we are not
@@ -789,20 +935,25 @@ void TextureLoader::Request_Foreground_Loading(TextureBaseClass *tc)
 		}
 
 		if (task) {
-			// if a load task is waiting on the background queue, we need to
-			// move it to the foreground queue.
-			if (task->Get_List() == &_BackgroundQueue) {
+			// upgrade the task priority. A task waiting on a queue moves to the
+			// foreground lane, so the loader threads decode it before any other
+			// texture and Update() applies it first. A task being decoded goes
+			// to the foreground lane when the loader thread hands it back.
+			const bool on_background_queue = _BackgroundQueue.Contains(task);
+			const bool on_foreground_queue = _ForegroundQueue.Contains(task);
+			_BackgroundQueue.Remove(task);
+			_ForegroundQueue.Remove(task);
 
-				// remove task from list
-				_BackgroundQueue.Remove(task);
+			task->Set_Priority(TextureLoadTaskClass::PRIORITY_HIGH);
 
-				// add to foreground queue.
+			if (on_background_queue) {
+				_BackgroundQueue.Push_Back(task);
+				_TextureLoadThreads.Notify();
+			}
+			if (on_foreground_queue) {
 				_ForegroundQueue.Push_Back(task);
 			}
 
-			// upgrade the task priority
-			task->Set_Priority(TextureLoadTaskClass::PRIORITY_HIGH);
-
 		} else {
 			// allocate high priority load task
 			task = TextureLoadTaskClass::Create(tc, TextureLoadTaskClass::TASK_LOAD, TextureLoadTaskClass::PRIORITY_HIGH);
@@ -828,11 +979,11 @@ void TextureLoader::Flush_Pending_Load_Tasks()
 
 		{
 			// we have no pending load tasks when both queues are empty
-			// and the background thread is not processing a texture.
+			// and no loader thread is processing a texture.
 
 			// Grab the background lock. Once we're holding it, we
-			// know that the background thread is not processing any
-			// textures.
+			// know that no loader thread is moving a texture between
+			// the queues.
 
 			// NOTE: It's important that we do only hold on to the background
 			// lock while we check for completion. Otherwise, we will either
@@ -840,7 +991,7 @@ void TextureLoader::Flush_Pending_Load_Tasks()
 			// the foreground lock) or never give the background thread
 			// a chance to empty its queue.
 			FastCriticalSectionClass::LockClass background_lock(_BackgroundCriticalSection);
-			done = _BackgroundQueue.Is_Empty() && _ForegroundQueue.Is_Empty();
+			done = _BackgroundQueue.Is_Empty() && _ForegroundQueue.Is_Empty() && _DecodingTaskCount == 0;
 		}
 
 		// exit loop if no entries in list
@@ -970,6 +1121,7 @@ void TextureLoader::Begin_Load_And_Queue(TextureLoadTaskClass *task)
 		// it has something to do with visually important textures,
 		// like those in the foreground, starting their load last.
 		_BackgroundQueue.Push_Front(task);
+		_TextureLoadThreads.Notify();
 	} else {
 		// unable to load.
 		if (task->Peek_Texture() != nullptr)
@@ -1007,31 +1159,64 @@ void TextureLoader::Load_Thumbnail(TextureBaseClass *tc)
 }
 
 
-void LoaderThreadClass::Thread_Function()
+// Decodes the mipmap levels of the next task on the background queue and hands the task
+// to the foreground queue for the final step. Returns false if there was no task.
+static bool Load_Next_Background_Task()
 {
-	while (running) {
-		// if there are no tasks on the background queue, no need to grab background lock.
-		if (!_BackgroundQueue.Is_Empty()) {
-			// Grab background load so other threads know we could be
-			// loading a texture.
-			FastCriticalSectionClass::LockClass lock(_BackgroundCriticalSection);
+	// if there are no tasks on the background queue, no need to grab background lock.
+	if (_BackgroundQueue.Is_Empty()) {
+		return false;
+	}
 
-			// try to remove a task from the background queue. This could fail
-			// if another thread modified the queue between our test above and
-			// grabbing the lock.
-			TextureLoadTaskClass* task = _BackgroundQueue.Pop_Front();
-			if (task) {
-				// verify task is in proper state for background processing.
-				WWASSERT(task->Get_Type() == TextureLoadTaskClass::TASK_LOAD);
-				WWASSERT(task->Get_State() == TextureLoadTaskClass::STATE_LOAD_BEGUN);
+	TextureLoadTaskClass* task = nullptr;
+	{
+		// try to remove a task from the background queue. This could fail
+		// if another thread modified the queue between our test above and
+		// grabbing the lock.
+		FastCriticalSectionClass::LockClass lock(_BackgroundCriticalSection);
+		task = _BackgroundQueue.Pop_Front();
+		if (!task) {
+			return false;
+		}
 
-				// load mip map levels and return to foreground queue for final step.
-				task->Load();
-				_ForegroundQueue.Push_Back(task);
-			}
+		// verify task is in proper state for background processing.
+		WWASSERT(task->Get_Type() == TextureLoadTaskClass::TASK_LOAD);
+		WWASSERT(task->Get_State() == TextureLoadTaskClass::STATE_LOAD_BEGUN);
+
+		// let other threads know we are loading this texture.
+		task->Set_State(TextureLoadTaskClass::STATE_LOAD_DECODING);
+		++_DecodingTaskCount;
+	}
+
+	// load mip map levels into the locked surfaces. Other loader threads
+	// do the same for other textures meanwhile.
+	task->Load_Mipmaps();
+
+	// return to foreground queue for final step.
+	FastCriticalSectionClass::LockClass lock(_BackgroundCriticalSection);
+	{
+		std::lock_guard<std::mutex> decoded_lock(_DecodedMutex);
+		task->Set_State(TextureLoadTaskClass::STATE_LOAD_MIPMAP);
+	}
+	_TaskDecoded.notify_all();
+	--_DecodingTaskCount;
+	_ForegroundQueue.Push_Back(task);
+	return true;
+}
+
+
+void LoaderThreadsClass::Thread_Function()
+{
+	for (;;) {
+		if (Load_Next_Background_Task()) {
+			continue;
 		}
 
-		Switch_Thread();
+		std::unique_lock<std::mutex> lock(Mutex);
+		Wake.wait(lock, [this] { return !Running || !_BackgroundQueue.Is_Empty(); });
+		if (!Running) {
+			return;
+		}
 	}
 }
 
@@ -1072,6 +1257,18 @@ TextureLoadTaskClass::~TextureLoadTaskClass()
 }
 
 
+TextureLoadTaskClass::LaneType TextureLoadTaskClass::Get_Lane() const
+{
+	if (Priority == PRIORITY_HIGH) {
+		return LANE_FOREGROUND;
+	}
+	if (Type == TASK_THUMBNAIL) {
+		return LANE_THUMBNAIL;
+	}
+	return LANE_BACKGROUND;
+}
+
+
 TextureLoadTaskClass *TextureLoadTaskClass::Create(TextureBaseClass *tc, TaskType type, PriorityType priority)
 {
 	// recycle or create a new texture load task with the given type
@@ -1252,6 +1449,18 @@ bool TextureLoadTaskClass::Begin_Load()
 //
 // ----------------------------------------------------------------------------
 bool TextureLoadTaskClass::Load()
+{
+	bool loaded = Load_Mipmaps();
+
+	State = STATE_LOAD_MIPMAP;
+
+	return loaded;
+}
+
+
+// GeneralsX @performance 18/10/2026 The loading part of Load(). It leaves the state alone,
+// so the loader threads can change it under the background lock.
+bool TextureLoadTaskClass::Load_Mipmaps()
 {
 	WWMEMLOG(MEM_TEXTURE);
 	WWASSERT(Peek_D3D_Texture());
@@ -1268,8 +1477,6 @@ bool TextureLoadTaskClass::Load()
 		loaded = Load_Uncompressed_Mipmap();
 	}
 
-	State = STATE_LOAD_MIPMAP;
-
 	return loaded;
 }
 
@@ -1761,9 +1968,28 @@ void TextureLoadTaskClass::Unlock_Surfaces()
 }
 
 
-bool TextureLoadTaskClass::Load_Compressed_Mipmap()
+// ----------------------------------------------------------------------------
+//
+// Decode the mip levels of a DDS or TGA file into the given surfaces. These
+// only touch CPU memory, so the loader threads run them for several textures
+// at once.
+//
+// ----------------------------------------------------------------------------
+
+static bool Decode_Compressed_Mipmaps
+(
+	const char* filename,
+	WW3DFormat format,
+	unsigned int width,
+	unsigned int height,
+	unsigned int mip_level_count,
+	unsigned int reduction,
+	unsigned char* const* surfaces,
+	const unsigned int* pitches,
+	const Vector3& hsv_shift
+)
 {
-	DDSFileClass dds_file(Texture->Get_Full_Path(), Get_Reduction());
+	DDSFileClass dds_file(filename, reduction);
 
 	// if we can't load from file, indicate error.
 	if (!dds_file.Is_Available() || !dds_file.Load())
@@ -1772,22 +1998,20 @@ bool TextureLoadTaskClass::Load_Compressed_Mipmap()
 	}
 
 	// regular 2d texture
-	unsigned int width = Get_Width();
-	unsigned int height = Get_Height();
-
-	for (unsigned int level = 0; level < Get_Mip_Level_Count(); ++level)
+	for (unsigned int level = 0; level < mip_level_count; ++level)
 	{
 		WWASSERT(width >= MinTextureDim && height >= MinTextureDim);
+		WWASSERT(surfaces[level]);
 
 		dds_file.Copy_Level_To_Surface
 		(
 			level,
-			Get_Format(),
+			format,
 			width,
 			height,
-			Get_Locked_Surface_Ptr(level),
-			Get_Locked_Surface_Pitch(level),
-			HSVShift
+			surfaces[level],
+			pitches[level],
+			hsv_shift
 		);
 
 		width >>= 1;
@@ -1798,39 +2022,47 @@ bool TextureLoadTaskClass::Load_Compressed_Mipmap()
 }
 
 
-bool TextureLoadTaskClass::Load_Uncompressed_Mipmap()
+static bool Decode_Uncompressed_Mipmaps
+(
+	const char* filename,
+	WW3DFormat format,
+	unsigned int width,
+	unsigned int height,
+	unsigned int mip_level_count,
+	unsigned int reduction,
+	unsigned char* const* surfaces,
+	const unsigned int* pitches,
+	const Vector3& hsv
+)
 {
-	if (!Get_Mip_Level_Count())
+	if (!mip_level_count)
 	{
 		return false;
 	}
 
 	Targa targa;
-	if (TARGA_ERROR_HANDLER(targa.Open(Texture->Get_Full_Path(), TGA_READMODE), Texture->Get_Full_Path())) {
+	if (TARGA_ERROR_HANDLER(targa.Open(filename, TGA_READMODE), filename)) {
 		return false;
 	}
 
 	// DX8 uses image upside down compared to TGA
 	targa.Header.ImageDescriptor ^= TGAIDF_YORIGIN;
 
+	// NOTE: the texture can be requested in a different format than the most
+	// obvious from the TGA, so the destination format is the given one.
 	WW3DFormat src_format;
-	WW3DFormat dest_format;
 	unsigned int src_bpp = 0;
-	Get_WW3D_Format(dest_format,src_format,src_bpp,targa);
+	Get_WW3D_Format(src_format,src_bpp,targa);
 	if (src_format==WW3D_FORMAT_UNKNOWN) return false;
 
-	dest_format = Get_Format();	// Texture can be requested in different format than the most obvious from the TGA
-
 	char palette[256*4];
 	targa.SetPalette(palette);
 
 	unsigned int src_width	= targa.Header.Width;
 	unsigned int src_height	= targa.Header.Height;
-	unsigned int width		= Get_Width();
-	unsigned int height		= Get_Height();
 
 	// NOTE: We load the palette but we do not yet support paletted textures!
-	if (TARGA_ERROR_HANDLER(targa.Load(Texture->Get_Full_Path(), TGAF_IMAGE, false), Texture->Get_Full_Path())) {
+	if (TARGA_ERROR_HANDLER(targa.Load(filename, TGAF_IMAGE, false), filename)) {
 		return false;
 	}
 
@@ -1838,7 +2070,7 @@ bool TextureLoadTaskClass::Load_Uncompressed_Mipmap()
 	unsigned char * converted_surface	= nullptr;
 
 	// No paletted format allowed when generating mipmaps
-	Vector3 hsv_shift=HSVShift;
+	Vector3 hsv_shift=hsv;
 	if (	src_format	== WW3D_FORMAT_A1R5G5B5
 		|| src_format	== WW3D_FORMAT_R5G6B5
 		|| src_format	== WW3D_FORMAT_A4R4G4B4
@@ -1848,7 +2080,6 @@ bool TextureLoadTaskClass::Load_Uncompressed_Mipmap()
 		|| src_height	!= height) {
 
 		converted_surface = new unsigned char[width*height*4];
-		dest_format = Get_Valid_Texture_Format(WW3D_FORMAT_A8R8G8B8, false);
 
 		BitmapHandlerClass::Copy_Image(
 			converted_surface,
@@ -1876,17 +2107,17 @@ bool TextureLoadTaskClass::Load_Uncompressed_Mipmap()
 
 	unsigned src_pitch = src_width * src_bpp;
 
-	if (Reduction)
+	if (reduction)
 	{	//texture needs to be reduced so allocate storage for full-sized version.
 		unsigned char * destination_surface	= new unsigned char[width*height*4];
 		//generate upper mip-levels that will be dropped in final texture
-		for (unsigned int level = 0; level < Reduction; ++level) {
+		for (unsigned int level = 0; level < reduction; ++level) {
 		BitmapHandlerClass::Copy_Image(
 			(unsigned char *)destination_surface,
 			width,
 			height,
 			src_pitch,
-			Get_Format(),
+			format,
 			src_surface,
 			src_width,
 			src_height,
@@ -1905,14 +2136,14 @@ bool TextureLoadTaskClass::Load_Uncompressed_Mipmap()
 		delete [] destination_surface;
 	}
 
-	for (unsigned int level = 0; level < Get_Mip_Level_Count(); ++level) {
-		WWASSERT(Get_Locked_Surface_Ptr(level));
+	for (unsigned int level = 0; level < mip_level_count; ++level) {
+		WWASSERT(surfaces[level]);
 		BitmapHandlerClass::Copy_Image(
-			Get_Locked_Surface_Ptr(level),
+			surfaces[level],
 			width,
 			height,
-			Get_Locked_Surface_Pitch(level),
-			Get_Format(),
+			pitches[level],
+			format,
 			src_surface,
 			src_width,
 			src_height,
@@ -1940,6 +2171,144 @@ bool TextureLoadTaskClass::Load_Uncompressed_Mipmap()
 }
 
 
+bool TextureLoadTaskClass::Load_Compressed_Mipmap()
+{
+	return Decode_Compressed_Mipmaps
+	(
+		Texture->Get_Full_Path(),
+		Get_Format(),
+		Get_Width(),
+		Get_Height(),
+		Get_Mip_Level_Count(),
+		Get_Reduction(),
+		LockedSurfacePtr,
+		LockedSurfacePitch,
+		HSVShift
+	);
+}
+
+
+bool TextureLoadTaskClass::Load_Uncompressed_Mipmap()
+{
+	return Decode_Uncompressed_Mipmaps
+	(
+		Texture->Get_Full_Path(),
+		Get_Format(),
+		Get_Width(),
+		Get_Height(),
+		Get_Mip_Level_Count(),
+		Get_Reduction(),
+		LockedSurfacePtr,
+		LockedSurfacePitch,
+		HSVShift
+	);
+}
+
+
+// ----------------------------------------------------------------------------
+//
+// Load the mip levels of the given files through the steps of a background
+// load: Begin_Load creates and locks the surfaces on the main thread, the
+// loader threads run Load_Mipmaps, End_Load unlocks and applies the surfaces
+// on the main thread. Only the Load_Mipmaps part is timed.
+//
+// ----------------------------------------------------------------------------
+
+int TextureLoader::Benchmark_Decoding(const StringClass* filenames, int count, int max_threads)
+{
+	// Note that we use printf here because this is run from cmd.
+	if (!DX8Wrapper::Is_Initted()) {
+		printf("Texture decoding: needs a Direct3D device, run without -headless\n");
+		fflush(stdout);
+		return 1;
+	}
+
+	max_threads = max(1, min(max_threads, (int)MAX_LOADER_THREADS));
+
+	// The number of textures whose surfaces are locked at the same time
+	enum { BATCH_SIZE = 64 };
+
+	// The textures are loaded by hand below, keep their constructor from loading them.
+	const bool thumbnails_enabled = WW3D::Get_Thumbnail_Enabled();
+	WW3D::Set_Thumbnail_Enabled(true);
+
+	int exit_code = 0;
+
+	// Pass 0 is not timed, it brings the files into the file cache.
+	for (int pass = 0; pass <= max_threads; ++pass) {
+		const int num_threads = (pass == 0) ? max_threads : pass;
+
+		int decoded_files = 0;
+		unsigned long long decoded_texels = 0;
+		double seconds = 0.0;
+
+		for (int first = 0; first < count; first += BATCH_SIZE) {
+			std::vector<TextureLoadTaskClass*> tasks;
+			for (int i = first; i < count && i < first + BATCH_SIZE; ++i) {
+				TextureClass* texture = NEW_REF(TextureClass, (filenames[i], filenames[i], MIP_LEVELS_ALL, WW3D_FORMAT_UNKNOWN, true));
+				TextureLoadTaskClass* task = TextureLoadTaskClass::Create(texture, TextureLoadTaskClass::TASK_LOAD, TextureLoadTaskClass::PRIORITY_LOW);
+				REF_PTR_RELEASE(texture);
+
+				if (task->Begin_Load()) {
+					tasks.push_back(task);
+				} else {
+					task->Destroy();
+				}
+			}
+
+			std::vector<unsigned char> loaded(tasks.size(), 0);
+			std::atomic<int> next_task(0);
+			auto load_mipmaps = [&]() {
+				for (int i = next_task++; i < (int)tasks.size(); i = next_task++) {
+					loaded[i] = tasks[i]->Load_Mipmaps();
+				}
+			};
+
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			std::vector<std::thread> threads;
+			for (int i = 0; i < num_threads; ++i) {
+				threads.push_back(std::thread(load_mipmaps));
+			}
+			for (size_t i = 0; i < threads.size(); ++i) {
+				threads[i].join();
+			}
+			seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+			for (size_t i = 0; i < tasks.size(); ++i) {
+				TextureLoadTaskClass* task = tasks[i];
+				if (loaded[i]) {
+					++decoded_files;
+					for (unsigned int level = 0; level < task->Get_Mip_Level_Count(); ++level) {
+						decoded_texels += (unsigned long long)max(task->Get_Width() >> level, 1u) * max(task->Get_Height() >> level, 1u);
+					}
+				}
+				task->End_Load();
+				task->Destroy();
+			}
+		}
+
+		const double megatexels = decoded_texels / (1000.0 * 1000.0);
+
+		if (pass == 0) {
+			printf("Texture decoding: %d of %d files decoded, %.1f Mtexels of mip levels\n", decoded_files, count, megatexels);
+			if (decoded_files == 0) {
+				exit_code = 1;
+				break;
+			}
+			continue;
+		}
+
+		printf("  %d loader thread%s: %9.1f ms, %8.1f textures/s, %8.1f Mtexels/s\n", num_threads, num_threads == 1 ? " " : "s",
+			seconds * 1000.0, decoded_files / seconds, megatexels / seconds);
+	}
+
+	WW3D::Set_Thumbnail_Enabled(thumbnails_enabled);
+
+	fflush(stdout);
+	return exit_code;
+}
+
+
 unsigned char * TextureLoadTaskClass::Get_Locked_Surface_Ptr(unsigned int level)
 {
 	WWASSERT(level<MipLevelCount);
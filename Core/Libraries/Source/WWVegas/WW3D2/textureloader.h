@@ -89,6 +89,16 @@ public:
 
 	static void Set_Texture_Inactive_Override_Time(int time_ms) {TextureInactiveOverrideTime = time_ms;}
 
+	// GeneralsX @performance 18/10/2026 The mip levels of background loads are decoded by a pool of
+	// loader threads. The count must be set before Init. 0 uses one thread less than there are cores.
+	enum { MAX_LOADER_THREADS = 8 };
+	static void Set_Loader_Thread_Count(int count);
+	static int Get_Loader_Thread_Count();
+
+	// Loads the mip levels of the given DDS and TGA files into locked textures with 1 to max_threads
+	// loader threads and prints the throughput of each run. Needs a Direct3D device. Returns the exit code.
+	static int Benchmark_Decoding(const StringClass* filenames, int count, int max_threads);
+
 private:
 	static void Process_Foreground_Load			(TextureLoadTaskClass *task);
 	static void Process_Foreground_Thumbnail	(TextureLoadTaskClass *task);
@@ -97,6 +107,7 @@ private:
 	static void Load_Thumbnail						(TextureBaseClass *tc);
 
 	static bool TextureLoadSuspended;
+	static int LoaderThreadCount;
 
 	// The time in ms before a texture is thrown out.
 	// The default is zero.  The scripted movies set this to reduce texture stalls in movies.
@@ -194,12 +205,22 @@ class TextureLoadTaskClass : public TextureLoadTaskListNodeClass
 			STATE_NONE,
 
 			STATE_LOAD_BEGUN,
+			STATE_LOAD_DECODING,		// a loader thread is decoding the mip levels
 			STATE_LOAD_MIPMAP,
 			STATE_LOAD_COMPLETE,
 
 			STATE_COMPLETE,
 		};
 
+		// The lane of TextureLoadLaneQueueClass the task is queued on
+		enum LaneType {
+			LANE_FOREGROUND,
+			LANE_THUMBNAIL,
+			LANE_BACKGROUND,
+
+			LANE_COUNT
+		};
+
 
 		TextureLoadTaskClass();
 		~TextureLoadTaskClass();
@@ -214,6 +235,7 @@ class TextureLoadTaskClass : public TextureLoadTaskListNodeClass
 		TaskType					Get_Type						() const		{ return Type;				}
 		PriorityType			Get_Priority				() const		{ return Priority;		}
 		StateType				Get_State					() const		{ return State;			}
+		LaneType					Get_Lane						() const;
 
 		WW3DFormat				Get_Format					() const		{ return Format;			}
 		unsigned int			Get_Width					() const		{ return Width;			}
@@ -233,6 +255,7 @@ class TextureLoadTaskClass : public TextureLoadTaskListNodeClass
 
 		bool						Begin_Load					();
 		bool						Load							();
+		bool						Load_Mipmaps				();
 		void						End_Load						();
 		void						Finish_Load					();
 		void						Apply_Missing_Texture	();
@@ -267,6 +290,32 @@ class TextureLoadTaskClass : public TextureLoadTaskListNodeClass
 		StateType				State;
 };
 
+class TextureLoadLaneQueueClass
+{
+	// GeneralsX @performance 18/10/2026 This class keeps a synchronized list per lane of
+	// TextureLoadTaskClass (see TextureLoadTaskClass::LaneType). Tasks are taken from the
+	// foreground lane first, then from the thumbnail lane and last from the background lane.
+
+	public:
+		bool									Is_Empty		() const;
+
+		// Add a task to the beginning or end of the lane of the task
+		void									Push_Front	(TextureLoadTaskClass *task);
+		void									Push_Back	(TextureLoadTaskClass *task);
+
+		// Remove and return the first task of the most urgent lane, or null if all lanes are empty.
+		TextureLoadTaskClass *			Pop_Front	();
+
+		// Remove specified task from its lane, if present
+		void									Remove		(TextureLoadTaskClass *task);
+
+		// Returns true if the task is on one of the lanes
+		bool									Contains		(TextureLoadTaskClass *task) const;
+
+	private:
+		SynchronizedTextureLoadTaskListClass	Lanes[TextureLoadTaskClass::LANE_COUNT];
+};
+
 class CubeTextureLoadTaskClass : public TextureLoadTaskClass
 {
 public:
@@ -45,6 +45,16 @@
 #include "WWLib/cpudetect.h"
 #include <memory.h>
 
+// GeneralsX @performance 18/10/2026 The inline assembly below is only built by the Intel compiler,
+// the batched transforms use intrinsics where the compiler targets SSE or NEON.
+#if defined(__SSE__) || defined(__x86_64__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define VP_USE_SSE
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define VP_USE_NEON
+#include <arm_neon.h>
+#endif
+
 #define SHUFFLE(x, y, z, w)	(((x)&3)<< 6|((y)&3)<<4|((z)&3)<< 2|((w)&3))
 #define	BROADCAST(XMM, INDEX)	__asm	shufps	XMM,XMM,(((INDEX)&3)<< 6|((INDEX)&3)<<4|((INDEX)&3)<< 2|((INDEX)&3))
 
@@ -76,6 +86,105 @@ void VectorProcessorClass::Prefetch(void* address)
 #endif
 }
 
+#if defined(VP_USE_SSE)
+
+// Loads four x,y,z triples and swizzles them to four X, four Y and four Z
+static inline void Load_Vectors(const Vector3* src, __m128& x, __m128& y, __m128& z)
+{
+	const float* f=&src->X;
+	const __m128 a=_mm_loadu_ps(f);		// x0 y0 z0 x1
+	const __m128 b=_mm_loadu_ps(f+4);	// y1 z1 x2 y2
+	const __m128 c=_mm_loadu_ps(f+8);	// z2 x3 y3 z3
+
+	x=_mm_shuffle_ps(a,_mm_shuffle_ps(b,c,_MM_SHUFFLE(1,1,2,2)),_MM_SHUFFLE(2,0,3,0));
+	y=_mm_shuffle_ps(_mm_shuffle_ps(a,b,_MM_SHUFFLE(0,0,1,1)),_mm_shuffle_ps(b,c,_MM_SHUFFLE(2,2,3,3)),_MM_SHUFFLE(2,0,2,0));
+	z=_mm_shuffle_ps(_mm_shuffle_ps(a,b,_MM_SHUFFLE(1,1,2,2)),_mm_shuffle_ps(c,c,_MM_SHUFFLE(3,3,0,0)),_MM_SHUFFLE(2,0,2,0));
+}
+
+// The reverse of Load_Vectors
+static inline void Store_Vectors(Vector3* dst, __m128 x, __m128 y, __m128 z)
+{
+	float* f=&dst->X;
+	_mm_storeu_ps(f,_mm_shuffle_ps(_mm_shuffle_ps(x,y,_MM_SHUFFLE(0,0,0,0)),_mm_shuffle_ps(z,x,_MM_SHUFFLE(1,1,0,0)),_MM_SHUFFLE(2,0,2,0)));
+	_mm_storeu_ps(f+4,_mm_shuffle_ps(_mm_shuffle_ps(y,z,_MM_SHUFFLE(1,1,1,1)),_mm_shuffle_ps(x,y,_MM_SHUFFLE(2,2,2,2)),_MM_SHUFFLE(2,0,2,0)));
+	_mm_storeu_ps(f+8,_mm_shuffle_ps(_mm_shuffle_ps(z,x,_MM_SHUFFLE(3,3,2,2)),_mm_shuffle_ps(y,z,_MM_SHUFFLE(3,3,3,3)),_MM_SHUFFLE(2,0,2,0)));
+}
+
+// Sums in the same order as Matrix3D::Transform_Vector so the results match it
+static inline __m128 Dot3(__m128 a, __m128 b, __m128 c, __m128 x, __m128 y, __m128 z)
+{
+	return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a,x),_mm_mul_ps(b,y)),_mm_mul_ps(c,z));
+}
+
+#elif defined(VP_USE_NEON)
+
+static inline float32x4_t Dot3(float32x4_t a, float32x4_t b, float32x4_t c, float32x4_t x, float32x4_t y, float32x4_t z)
+{
+	return vaddq_f32(vaddq_f32(vmulq_f32(a,x),vmulq_f32(b,y)),vmulq_f32(c,z));
+}
+
+#endif
+
+// Transforms the vertices and, if WITH_NORMALS, rotates the normals. The vertices are done
+// four at a time as four X, four Y and four Z, the rest one at a time.
+template <bool WITH_NORMALS>
+static void Transform_Batch(Vector3* dst_vert, Vector3* dst_norm, const Vector3* src_vert, const Vector3* src_norm, const Matrix3D& mtx, const int count)
+{
+	int i=0;
+
+#if defined(VP_USE_SSE)
+	const __m128 m00=_mm_set1_ps(mtx[0][0]), m01=_mm_set1_ps(mtx[0][1]), m02=_mm_set1_ps(mtx[0][2]), m03=_mm_set1_ps(mtx[0][3]);
+	const __m128 m10=_mm_set1_ps(mtx[1][0]), m11=_mm_set1_ps(mtx[1][1]), m12=_mm_set1_ps(mtx[1][2]), m13=_mm_set1_ps(mtx[1][3]);
+	const __m128 m20=_mm_set1_ps(mtx[2][0]), m21=_mm_set1_ps(mtx[2][1]), m22=_mm_set1_ps(mtx[2][2]), m23=_mm_set1_ps(mtx[2][3]);
+
+	for (; i+4<=count; i+=4) {
+		__m128 x,y,z;
+		Load_Vectors(src_vert+i,x,y,z);
+		Store_Vectors(dst_vert+i,
+			_mm_add_ps(Dot3(m00,m01,m02,x,y,z),m03),
+			_mm_add_ps(Dot3(m10,m11,m12,x,y,z),m13),
+			_mm_add_ps(Dot3(m20,m21,m22,x,y,z),m23));
+
+		if (WITH_NORMALS) {
+			Load_Vectors(src_norm+i,x,y,z);
+			Store_Vectors(dst_norm+i,
+				Dot3(m00,m01,m02,x,y,z),
+				Dot3(m10,m11,m12,x,y,z),
+				Dot3(m20,m21,m22,x,y,z));
+		}
+	}
+#elif defined(VP_USE_NEON)
+	const float32x4_t m00=vdupq_n_f32(mtx[0][0]), m01=vdupq_n_f32(mtx[0][1]), m02=vdupq_n_f32(mtx[0][2]), m03=vdupq_n_f32(mtx[0][3]);
+	const float32x4_t m10=vdupq_n_f32(mtx[1][0]), m11=vdupq_n_f32(mtx[1][1]), m12=vdupq_n_f32(mtx[1][2]), m13=vdupq_n_f32(mtx[1][3]);
+	const float32x4_t m20=vdupq_n_f32(mtx[2][0]), m21=vdupq_n_f32(mtx[2][1]), m22=vdupq_n_f32(mtx[2][2]), m23=vdupq_n_f32(mtx[2][3]);
+
+	for (; i+4<=count; i+=4) {
+		// vld3q and vst3q do the swizzle to and from four X, four Y and four Z
+		float32x4x3_t v=vld3q_f32(&src_vert[i].X);
+		float32x4x3_t o;
+		o.val[0]=vaddq_f32(Dot3(m00,m01,m02,v.val[0],v.val[1],v.val[2]),m03);
+		o.val[1]=vaddq_f32(Dot3(m10,m11,m12,v.val[0],v.val[1],v.val[2]),m13);
+		o.val[2]=vaddq_f32(Dot3(m20,m21,m22,v.val[0],v.val[1],v.val[2]),m23);
+		vst3q_f32(&dst_vert[i].X,o);
+
+		if (WITH_NORMALS) {
+			v=vld3q_f32(&src_norm[i].X);
+			o.val[0]=Dot3(m00,m01,m02,v.val[0],v.val[1],v.val[2]);
+			o.val[1]=Dot3(m10,m11,m12,v.val[0],v.val[1],v.val[2]);
+			o.val[2]=Dot3(m20,m21,m22,v.val[0],v.val[1],v.val[2]);
+			vst3q_f32(&dst_norm[i].X,o);
+		}
+	}
+#endif
+
+	for (; i<count; i++) {
+		Matrix3D::Transform_Vector(mtx,src_vert[i],&dst_vert[i]);
+		if (WITH_NORMALS) {
+			Matrix3D::Rotate_Vector(mtx,src_norm[i],&dst_norm[i]);
+		}
+	}
+}
+
 static Vector4 lastrow(0.0f,0.0f,0.0f,1.0f);
 void VectorProcessorClass::Transform (Vector3* dst,const Vector3 *src, const Matrix3D& mtx, const int count)
 {
@@ -308,10 +417,35 @@ void VectorProcessorClass::Transform (Vector3* dst,const Vector3 *src, const Mat
 	else
 #endif
 	{
-		mtx.mulVector3Array(src, dst, count);
+		Transform_Batch<false>(dst, nullptr, src, nullptr, mtx, count);
 	}
 }
 
+void VectorProcessorClass::Transform_Skinned(Vector3* dst_vert, Vector3* dst_norm, const Vector3* src_vert, const Vector3* src_norm, const Matrix3D& mtx, const int count)
+{
+	if (count<=0) return;
+	Transform_Batch<true>(dst_vert, dst_norm, src_vert, src_norm, mtx, count);
+}
+
+void VectorProcessorClass::Transform_Skinned_Reference(Vector3* dst_vert, Vector3* dst_norm, const Vector3* src_vert, const Vector3* src_norm, const Matrix3D& mtx, const int count)
+{
+	for (int i=0; i<count; i++) {
+		Matrix3D::Transform_Vector(mtx,src_vert[i],&dst_vert[i]);
+		Matrix3D::Rotate_Vector(mtx,src_norm[i],&dst_norm[i]);
+	}
+}
+
+const char* VectorProcessorClass::Get_Skinning_Instruction_Set()
+{
+#if defined(VP_USE_SSE)
+	return "SSE";
+#elif defined(VP_USE_NEON)
+	return "NEON";
+#else
+	return "scalar";
+#endif
+}
+
 void VectorProcessorClass::Transform(Vector4* dst,const Vector3 *src, const Matrix4x4& matrix, const int count)
 {
 	if (count<=0) return;
@@ -41,6 +41,7 @@
  * Clear - clears array to zero                                                                 *
  * Normalize - normalize the array                                                              *
  * MinMax - Finds the min and max of the array                                                  *
+ * Transform_Skinned - transforms vertices and normals of a skin by one bone                    *
  *                                                                                              *
  *----------------------------------------------------------------------------------------------*
  */
@@ -58,6 +59,13 @@ class VectorProcessorClass
 public:
 	static void Transform(Vector3* dst,const Vector3 *src, const Matrix3D& matrix, const int count);
 	static void Transform(Vector4* dst,const Vector3 *src, const Matrix4x4& matrix, const int count);
+
+	// GeneralsX @performance 18/10/2026 Transforms the vertices by the bone matrix and the normals by
+	// its rotation, four at a time with SSE or NEON where the compiler targets them. The reference
+	// does one vertex at a time the way skins were deformed before, to check the batched results.
+	static void Transform_Skinned(Vector3* dst_vert, Vector3* dst_norm, const Vector3* src_vert, const Vector3* src_norm, const Matrix3D& matrix, const int count);
+	static void Transform_Skinned_Reference(Vector3* dst_vert, Vector3* dst_norm, const Vector3* src_vert, const Vector3* src_norm, const Matrix3D& matrix, const int count);
+	static const char* Get_Skinning_Instruction_Set();
 	static void Copy(unsigned *dst,const unsigned *src, const int count);
 	static void Copy(Vector2 *dst,const Vector2 *src, const int count);
 	static void Copy(Vector3 *dst,const Vector3 *src, const int count);
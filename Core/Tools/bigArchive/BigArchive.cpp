@@ -0,0 +1,535 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: BigArchive.cpp //////////////////////////////////////////////////////
+
+#include "BigArchive.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+
+static const char *BIGFileIdentifier = "BIGF";
+
+// StdBIGFileSystem reads the paths into a buffer of this size
+static const size_t MaxArchivePath = 260;
+
+// Packed entries waiting to be written, per thread
+static const Int WriteWindowPerThread = 4;
+
+BigWriteSettings::BigWriteSettings()
+	: compression(CompressionManager::getPreferredCompression())
+	, threads(1)
+{
+}
+
+static UnsignedInt readBE32(const unsigned char *p)
+{
+	return ((UnsignedInt)p[0] << 24) | ((UnsignedInt)p[1] << 16) | ((UnsignedInt)p[2] << 8) | (UnsignedInt)p[3];
+}
+
+static UnsignedInt readLE32(const unsigned char *p)
+{
+	return ((UnsignedInt)p[3] << 24) | ((UnsignedInt)p[2] << 16) | ((UnsignedInt)p[1] << 8) | (UnsignedInt)p[0];
+}
+
+static void writeBE32(std::vector<unsigned char>& out, UnsignedInt value)
+{
+	out.push_back((unsigned char)(value >> 24));
+	out.push_back((unsigned char)(value >> 16));
+	out.push_back((unsigned char)(value >> 8));
+	out.push_back((unsigned char)value);
+}
+
+static void writeLE32(std::vector<unsigned char>& out, UnsignedInt value)
+{
+	out.push_back((unsigned char)value);
+	out.push_back((unsigned char)(value >> 8));
+	out.push_back((unsigned char)(value >> 16));
+	out.push_back((unsigned char)(value >> 24));
+}
+
+std::string normalizeArchivePath(const std::string& path)
+{
+	std::string result = path;
+	for (size_t i = 0; i < result.size(); ++i)
+	{
+		if (result[i] == '/')
+			result[i] = '\\';
+		else if (result[i] >= 'A' && result[i] <= 'Z')
+			result[i] = result[i] - 'A' + 'a';
+	}
+	return result;
+}
+
+static Bool matchesMask(const char *name, const char *mask)
+{
+	for (; *mask != '\0'; ++mask, ++name)
+	{
+		if (*mask == '*')
+		{
+			for (const char *rest = name; ; ++rest)
+			{
+				if (matchesMask(rest, mask + 1))
+					return TRUE;
+				if (*rest == '\0')
+					return FALSE;
+			}
+		}
+		if (*name == '\0')
+			return FALSE;
+		if (*mask != '?' && *mask != *name)
+			return FALSE;
+	}
+	return *name == '\0';
+}
+
+Bool matchesArchiveMask(const std::string& name, const std::string& mask)
+{
+	return matchesMask(normalizeArchivePath(name).c_str(), normalizeArchivePath(mask).c_str());
+}
+
+// Same steps as StdBIGFileSystem::openArchiveFile
+Bool readBigDirectory(const std::string& bigFile, std::vector<BigEntry>& entries, std::string& error)
+{
+	FILE *fp = fopen(bigFile.c_str(), "rb");
+	if (fp == nullptr)
+	{
+		error = "cannot open " + bigFile;
+		return FALSE;
+	}
+
+	fseek(fp, 0, SEEK_END);
+	const long fileSize = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+
+	unsigned char header[16];
+	if (fread(header, 1, sizeof(header), fp) != sizeof(header) || memcmp(header, BIGFileIdentifier, 4) != 0)
+	{
+		error = bigFile + " is not a BIG file";
+		fclose(fp);
+		return FALSE;
+	}
+
+	const UnsignedInt count = readBE32(header + 8);
+	entries.reserve(entries.size() + count);
+
+	for (UnsignedInt i = 0; i < count; ++i)
+	{
+		unsigned char sizes[8];
+		if (fread(sizes, 1, sizeof(sizes), fp) != sizeof(sizes))
+		{
+			error = bigFile + " has a cut off directory";
+			fclose(fp);
+			return FALSE;
+		}
+
+		BigEntry entry;
+		entry.sourceFile = bigFile;
+		entry.sourceOffset = readBE32(sizes);
+		entry.sourceSize = readBE32(sizes + 4);
+
+		Int c;
+		while ((c = fgetc(fp)) > 0)
+			entry.name += (char)c;
+
+		if (c < 0 || entry.name.size() >= MaxArchivePath
+			|| (UnsignedInt64)entry.sourceOffset + entry.sourceSize > (UnsignedInt64)fileSize)
+		{
+			error = bigFile + " has a broken entry " + entry.name;
+			fclose(fp);
+			return FALSE;
+		}
+
+		entries.push_back(entry);
+	}
+
+	fclose(fp);
+	return TRUE;
+}
+
+Bool collectLooseFiles(const std::string& directory, std::vector<BigEntry>& entries, std::string& error)
+{
+	std::error_code code;
+	std::filesystem::recursive_directory_iterator it(directory, code);
+	if (code)
+	{
+		error = "cannot read directory " + directory;
+		return FALSE;
+	}
+
+	std::vector<BigEntry> found;
+	for (; it != std::filesystem::recursive_directory_iterator(); it.increment(code))
+	{
+		if (code)
+		{
+			error = "cannot read directory " + directory;
+			return FALSE;
+		}
+		if (!it->is_regular_file())
+			continue;
+
+		const UnsignedInt64 size = it->file_size();
+		if (size > 0xffffffffu)
+		{
+			error = it->path().string() + " is too big for a BIG file";
+			return FALSE;
+		}
+
+		BigEntry entry;
+		entry.sourceFile = it->path().string();
+		entry.sourceSize = (UnsignedInt)size;
+		entry.name = std::filesystem::relative(it->path(), directory).generic_string();
+		std::replace(entry.name.begin(), entry.name.end(), '/', '\\');
+		found.push_back(entry);
+	}
+
+	// the directory order differs between file systems
+	std::sort(found.begin(), found.end(), [](const BigEntry& a, const BigEntry& b)
+	{
+		return normalizeArchivePath(a.name) < normalizeArchivePath(b.name);
+	});
+
+	entries.insert(entries.end(), found.begin(), found.end());
+	return TRUE;
+}
+
+Bool readEntryData(const BigEntry& entry, std::vector<char>& data)
+{
+	data.resize(entry.sourceSize);
+	if (entry.sourceSize == 0)
+		return TRUE;
+
+	FILE *fp = fopen(entry.sourceFile.c_str(), "rb");
+	if (fp == nullptr)
+		return FALSE;
+
+	const Bool ok = fseek(fp, (long)entry.sourceOffset, SEEK_SET) == 0
+		&& fread(&data[0], 1, data.size(), fp) == data.size();
+	fclose(fp);
+	return ok;
+}
+
+Bool readAccessTrace(const std::string& traceFile, std::vector<std::string>& names, std::string& error)
+{
+	FILE *fp = fopen(traceFile.c_str(), "r");
+	if (fp == nullptr)
+	{
+		error = "cannot open " + traceFile;
+		return FALSE;
+	}
+
+	std::set<std::string> seen(names.begin(), names.end());
+	char line[1024];
+	while (fgets(line, sizeof(line), fp) != nullptr)
+	{
+		size_t length = strlen(line);
+		while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r'))
+			line[--length] = '\0';
+		if (length == 0 || line[0] == '#')
+			continue;
+
+		// the archive the game found the file in comes first
+		const char *name = strrchr(line, '\t');
+		name = name != nullptr ? name + 1 : line;
+
+		std::string normalized = normalizeArchivePath(name);
+		if (seen.insert(normalized).second)
+			names.push_back(normalized);
+	}
+
+	fclose(fp);
+	return TRUE;
+}
+
+Int orderByAccessTrace(std::vector<BigEntry>& entries, const std::vector<std::string>& traceNames)
+{
+	std::map<std::string, Int> traceIndex;
+	for (size_t i = 0; i < traceNames.size(); ++i)
+		traceIndex.insert(std::make_pair(traceNames[i], (Int)i));
+
+	std::vector<Int> rank(entries.size());
+	Int traced = 0;
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		std::map<std::string, Int>::const_iterator it = traceIndex.find(normalizeArchivePath(entries[i].name));
+		rank[i] = it != traceIndex.end() ? it->second : (Int)traceNames.size();
+		if (it != traceIndex.end())
+			++traced;
+	}
+
+	std::vector<size_t> order(entries.size());
+	for (size_t i = 0; i < order.size(); ++i)
+		order[i] = i;
+	std::stable_sort(order.begin(), order.end(), [&rank](size_t a, size_t b) { return rank[a] < rank[b]; });
+
+	std::vector<BigEntry> sorted;
+	sorted.reserve(entries.size());
+	for (size_t i = 0; i < order.size(); ++i)
+		sorted.push_back(entries[order[i]]);
+	entries.swap(sorted);
+
+	return traced;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Writing
+//////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+struct PackedEntry
+{
+	PackedEntry() : ready(FALSE), failed(FALSE), compressed(FALSE), sourceSize(0) {}
+
+	std::vector<char> data;
+	Bool ready;
+	Bool failed;
+	Bool compressed;
+	UnsignedInt sourceSize;
+};
+
+// Hands out the entries to the threads in archive order and lets the writer take them in the same order.
+// The threads stay at most a window ahead of the writer, so only that many packed entries are held.
+class PackQueue
+{
+public:
+	PackQueue(const std::vector<BigEntry>& entries, const BigWriteSettings& settings)
+		: m_entries(entries)
+		, m_settings(settings)
+		, m_packed(entries.size())
+		, m_next(0)
+		, m_written(0)
+		, m_window((size_t)std::max(1, settings.threads) * WriteWindowPerThread)
+		, m_abort(FALSE)
+	{
+	}
+
+	void work()
+	{
+		for (;;)
+		{
+			size_t index;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_spaceCond.wait(lock, [this] { return m_abort || m_next >= m_entries.size() || m_next < m_written + m_window; });
+				if (m_abort || m_next >= m_entries.size())
+					return;
+				index = m_next++;
+			}
+
+			PackedEntry packed;
+			pack(m_entries[index], packed);
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_packed[index] = std::move(packed);
+				m_packed[index].ready = TRUE;
+			}
+			m_readyCond.notify_all();
+		}
+	}
+
+	// Waits for the entry and takes its data
+	void take(size_t index, PackedEntry& packed)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_readyCond.wait(lock, [this, index] { return m_packed[index].ready; });
+		packed = std::move(m_packed[index]);
+		m_packed[index] = PackedEntry();
+	}
+
+	void written(size_t count)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_written = count;
+		}
+		m_spaceCond.notify_all();
+	}
+
+	void abort()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_abort = TRUE;
+		}
+		m_spaceCond.notify_all();
+	}
+
+private:
+	void pack(const BigEntry& entry, PackedEntry& packed) const
+	{
+		packed.sourceSize = entry.sourceSize;
+		if (!readEntryData(entry, packed.data))
+		{
+			packed.failed = TRUE;
+			return;
+		}
+
+		if (m_settings.compression == COMPRESSION_NONE || packed.data.empty())
+			return;
+
+		Bool wanted = FALSE;
+		for (size_t i = 0; i < m_settings.compressMasks.size() && !wanted; ++i)
+			wanted = matchesArchiveMask(entry.name, m_settings.compressMasks[i]);
+
+		// entries that are compressed already, like in a repacked archive, are kept as they are
+		if (!wanted || CompressionManager::isDataCompressed(&packed.data[0], (Int)packed.data.size()))
+			return;
+
+		Int maxSize = CompressionManager::getMaxCompressedSize((Int)packed.data.size(), m_settings.compression);
+		std::vector<char> compressed(maxSize);
+		Int size = CompressionManager::compressData(m_settings.compression, &packed.data[0], (Int)packed.data.size(), &compressed[0], maxSize);
+		if (size > 0 && (size_t)size < packed.data.size())
+		{
+			compressed.resize(size);
+			packed.data.swap(compressed);
+			packed.compressed = TRUE;
+		}
+	}
+
+	const std::vector<BigEntry>& m_entries;
+	const BigWriteSettings& m_settings;
+	std::vector<PackedEntry> m_packed;
+
+	std::mutex m_mutex;
+	std::condition_variable m_readyCond;
+	std::condition_variable m_spaceCond;
+	size_t m_next;
+	size_t m_written;
+	size_t m_window;
+	Bool m_abort;
+};
+
+} // namespace
+
+Bool writeBigArchive(const std::string& bigFile, const std::vector<BigEntry>& entries,
+	const BigWriteSettings& settings, BigWriteStats& stats, std::string& error)
+{
+	stats = BigWriteStats();
+
+	// the header size only depends on the names, so the data can go out before the header
+	UnsignedInt64 headerSize = 16;
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		if (entries[i].name.empty() || entries[i].name.size() >= MaxArchivePath)
+		{
+			error = "bad archive path '" + entries[i].name + "'";
+			return FALSE;
+		}
+		headerSize += 8 + entries[i].name.size() + 1;
+	}
+
+	FILE *fp = fopen(bigFile.c_str(), "wb");
+	if (fp == nullptr)
+	{
+		error = "cannot open " + bigFile + " for writing";
+		return FALSE;
+	}
+
+	PackQueue queue(entries, settings);
+	std::vector<std::thread> threads;
+	for (Int i = 0; i < std::max(1, settings.threads); ++i)
+		threads.push_back(std::thread(&PackQueue::work, &queue));
+
+	std::vector<UnsignedInt> offsets(entries.size());
+	std::vector<UnsignedInt> sizes(entries.size());
+	UnsignedInt64 offset = headerSize;
+	Bool ok = fseek(fp, (long)headerSize, SEEK_SET) == 0;
+	if (!ok)
+		error = "cannot write " + bigFile;
+
+	for (size_t i = 0; i < entries.size() && ok; ++i)
+	{
+		PackedEntry packed;
+		queue.take(i, packed);
+		if (packed.failed)
+		{
+			error = "cannot read " + entries[i].name + " from " + entries[i].sourceFile;
+			ok = FALSE;
+			break;
+		}
+		if (offset + packed.data.size() > 0xffffffffu)
+		{
+			error = "the archive would be bigger than 4 GB";
+			ok = FALSE;
+			break;
+		}
+		if (!packed.data.empty() && fwrite(&packed.data[0], 1, packed.data.size(), fp) != packed.data.size())
+		{
+			error = "cannot write " + bigFile;
+			ok = FALSE;
+			break;
+		}
+
+		offsets[i] = (UnsignedInt)offset;
+		sizes[i] = (UnsignedInt)packed.data.size();
+		offset += packed.data.size();
+
+		++stats.files;
+		if (packed.compressed)
+			++stats.compressed;
+		stats.bytesIn += packed.sourceSize;
+
+		queue.written(i + 1);
+	}
+
+	queue.abort();
+	for (size_t i = 0; i < threads.size(); ++i)
+		threads[i].join();
+
+	if (ok)
+	{
+		std::vector<unsigned char> header;
+		header.reserve((size_t)headerSize);
+		header.insert(header.end(), BIGFileIdentifier, BIGFileIdentifier + 4);
+		writeLE32(header, (UnsignedInt)offset);
+		writeBE32(header, (UnsignedInt)entries.size());
+		writeBE32(header, (UnsignedInt)headerSize);
+		for (size_t i = 0; i < entries.size(); ++i)
+		{
+			writeBE32(header, offsets[i]);
+			writeBE32(header, sizes[i]);
+			header.insert(header.end(), entries[i].name.begin(), entries[i].name.end());
+			header.push_back(0);
+		}
+
+		ok = fseek(fp, 0, SEEK_SET) == 0 && fwrite(&header[0], 1, header.size(), fp) == header.size();
+		if (!ok)
+			error = "cannot write " + bigFile;
+		stats.bytesOut = offset;
+	}
+
+	if (fclose(fp) != 0 && ok)
+	{
+		error = "cannot write " + bigFile;
+		ok = FALSE;
+	}
+	if (!ok)
+		remove(bigFile.c_str());
+
+	return ok;
+}
@@ -0,0 +1,84 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: BigArchive.h ////////////////////////////////////////////////////////
+// Reads and writes BIG archives in the layout StdBIGFileSystem reads:
+//   "BIGF", archive size (little endian), file count (big endian),
+//   header size (big endian), then per file its offset and size (big
+//   endian) and its NUL terminated path, then the file data.
+// GeneralsX @performance 18/10/2026 The entries are compressed on a pool of
+// threads and can be ordered by an access trace written with -archiveTrace.
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Lib/BaseTypeCore.h"
+#include "Compression.h"
+
+#include <string>
+#include <vector>
+
+// A file in a BIG archive, or a loose file to put into one
+struct BigEntry
+{
+	BigEntry() : sourceOffset(0), sourceSize(0) {}
+
+	std::string name;          ///< path in the archive, with backslashes
+	std::string sourceFile;    ///< file holding the data
+	UnsignedInt sourceOffset;  ///< where the data starts in sourceFile
+	UnsignedInt sourceSize;
+};
+
+struct BigWriteSettings
+{
+	BigWriteSettings();
+
+	CompressionType compression;             ///< COMPRESSION_NONE stores everything as is
+	std::vector<std::string> compressMasks;  ///< only entries matching one of these are compressed, eg. "*.map"
+	Int threads;
+};
+
+struct BigWriteStats
+{
+	BigWriteStats() : files(0), compressed(0), bytesIn(0), bytesOut(0) {}
+
+	UnsignedInt files;
+	UnsignedInt compressed;
+	UnsignedInt64 bytesIn;
+	UnsignedInt64 bytesOut;   ///< the whole archive, header included
+};
+
+// Lower case with backslashes, the way the game looks up archived files
+std::string normalizeArchivePath(const std::string& path);
+
+// Case insensitive match of '*' and '?' wildcards
+Bool matchesArchiveMask(const std::string& name, const std::string& mask);
+
+Bool readBigDirectory(const std::string& bigFile, std::vector<BigEntry>& entries, std::string& error);
+Bool collectLooseFiles(const std::string& directory, std::vector<BigEntry>& entries, std::string& error);
+Bool readEntryData(const BigEntry& entry, std::vector<char>& data);
+
+// Reads the file names of an -archiveTrace file, first open first
+Bool readAccessTrace(const std::string& traceFile, std::vector<std::string>& names, std::string& error);
+
+// Moves the traced entries to the front in trace order, the others keep their order behind them.
+// Returns the number of traced entries.
+Int orderByAccessTrace(std::vector<BigEntry>& entries, const std::vector<std::string>& traceNames);
+
+Bool writeBigArchive(const std::string& bigFile, const std::vector<BigEntry>& entries,
+	const BigWriteSettings& settings, BigWriteStats& stats, std::string& error);
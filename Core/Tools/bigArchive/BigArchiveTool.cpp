@@ -0,0 +1,575 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// FILE: BigArchiveTool.cpp //////////////////////////////////////////////////
+// Builds and repacks BIG archives, optionally in the order of an access
+// trace written by the game with -archiveTrace, and compares the cold cache
+// load time of archives.
+//////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <Utility/stdio_adapter.h>
+#include <cstdarg>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <set>
+#include <thread>
+#include "Lib/BaseTypeCore.h"
+#include "Compression.h"
+#include "BigArchive.h"
+
+#if defined(_UNIX)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+// TheSuperHackers @todo Streamline and simplify the logging approach for tools
+static void DebugLog(const char* format, ...)
+{
+	char buffer[1024];
+	buffer[0] = 0;
+	va_list args;
+	va_start(args, format);
+	vsnprintf(buffer, 1024, format, args);
+	va_end(args);
+	printf("%s\n", buffer);
+}
+#define DEBUG_LOG(x) DebugLog x
+
+
+void dumpHelp(const char *exe)
+{
+	DEBUG_LOG(("Usage:"));
+	DEBUG_LOG(("  To build an archive from a directory: %s -create outfile -dir directory <options>", exe));
+	DEBUG_LOG(("  To repack archives into one:          %s -repack outfile -in infile <-in infile...> <options>", exe));
+	DEBUG_LOG(("  To list an archive:                   %s -list infile", exe));
+	DEBUG_LOG(("  To compare the cold cache load time:  %s -benchmark infile <infile...> -trace tracefile <-runs count>", exe));
+	DEBUG_LOG(("  To run the round trip test:           %s -test", exe));
+	DEBUG_LOG((""));
+	DEBUG_LOG(("Options:"));
+	DEBUG_LOG(("  -trace tracefile   store the files in the order of a trace written with the game's -archiveTrace"));
+	DEBUG_LOG(("  -compress mask     compress the files matching the mask, default *.map. The game only"));
+	DEBUG_LOG(("                     decompresses the files it reads as data chunks, like maps and scripts"));
+	DEBUG_LOG(("  -type mode         compression mode, default %s", CompressionManager::getCompressionNameByType(CompressionManager::getPreferredCompression())));
+	DEBUG_LOG(("  -threads count     compression threads, default one per CPU"));
+	DEBUG_LOG((""));
+	DEBUG_LOG(("Compression modes:"));
+	for (int i=COMPRESSION_MIN; i<=COMPRESSION_MAX; ++i)
+	{
+		DEBUG_LOG(("   %s", CompressionManager::getCompressionNameByType((CompressionType)i)));
+	}
+}
+
+// Several archives may hold the same file, the first one wins like in the game
+static void removeDuplicates(std::vector<BigEntry>& entries)
+{
+	std::set<std::string> seen;
+	std::vector<BigEntry> unique;
+	unique.reserve(entries.size());
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		if (seen.insert(normalizeArchivePath(entries[i].name)).second)
+			unique.push_back(entries[i]);
+	}
+	entries.swap(unique);
+}
+
+static Bool buildArchive(const std::string& outFile, std::vector<BigEntry>& entries, const std::vector<std::string>& traceFiles,
+	const BigWriteSettings& settings)
+{
+	removeDuplicates(entries);
+
+	std::vector<std::string> traceNames;
+	for (size_t i = 0; i < traceFiles.size(); ++i)
+	{
+		std::string error;
+		if (!readAccessTrace(traceFiles[i], traceNames, error))
+		{
+			DEBUG_LOG(("%s", error.c_str()));
+			return FALSE;
+		}
+	}
+	if (!traceNames.empty())
+	{
+		Int traced = orderByAccessTrace(entries, traceNames);
+		DEBUG_LOG(("%d of %d files are in the trace and go first", traced, (Int)entries.size()));
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	BigWriteStats stats;
+	std::string error;
+	if (!writeBigArchive(outFile, entries, settings, stats, error))
+	{
+		DEBUG_LOG(("%s", error.c_str()));
+		return FALSE;
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	DEBUG_LOG(("Wrote %u files to '%s', %u compressed with %s, %llu bytes in, %llu bytes out, %.2f s on %d threads",
+		stats.files, outFile.c_str(), stats.compressed, CompressionManager::getCompressionNameByType(settings.compression),
+		(unsigned long long)stats.bytesIn, (unsigned long long)stats.bytesOut, seconds, settings.threads));
+	return TRUE;
+}
+
+static Int listArchive(const std::string& inFile)
+{
+	std::vector<BigEntry> entries;
+	std::string error;
+	if (!readBigDirectory(inFile, entries, error))
+	{
+		DEBUG_LOG(("%s", error.c_str()));
+		return EXIT_FAILURE;
+	}
+
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		DEBUG_LOG(("%10u %10u %s", entries[i].sourceOffset, entries[i].sourceSize, entries[i].name.c_str()));
+	}
+	DEBUG_LOG(("%d files", (Int)entries.size()));
+	return EXIT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Cold cache load time
+//////////////////////////////////////////////////////////////////////////////
+
+// Throws the pages of the file out of the file system cache where the platform allows it
+static Bool dropFileCache(const std::string& file)
+{
+#if defined(_UNIX) && defined(POSIX_FADV_DONTNEED)
+	int fd = open(file.c_str(), O_RDONLY);
+	if (fd < 0)
+		return FALSE;
+	fdatasync(fd);
+	Bool dropped = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+	close(fd);
+	return dropped;
+#else
+	(void)file;
+	return FALSE;
+#endif
+}
+
+// Reads the traced files from the archive in trace order, the way the game opens them
+static Int benchmarkArchives(const std::vector<std::string>& inFiles, const std::vector<std::string>& traceFiles, Int runs)
+{
+	std::vector<std::string> traceNames;
+	for (size_t i = 0; i < traceFiles.size(); ++i)
+	{
+		std::string error;
+		if (!readAccessTrace(traceFiles[i], traceNames, error))
+		{
+			DEBUG_LOG(("%s", error.c_str()));
+			return EXIT_FAILURE;
+		}
+	}
+	if (traceNames.empty())
+	{
+		DEBUG_LOG(("-benchmark needs a -trace with files in it"));
+		return EXIT_FAILURE;
+	}
+
+	for (size_t a = 0; a < inFiles.size(); ++a)
+	{
+		std::vector<BigEntry> entries;
+		std::string error;
+		if (!readBigDirectory(inFiles[a], entries, error))
+		{
+			DEBUG_LOG(("%s", error.c_str()));
+			return EXIT_FAILURE;
+		}
+		orderByAccessTrace(entries, traceNames);
+
+		std::set<std::string> traced(traceNames.begin(), traceNames.end());
+		size_t count = 0;
+		while (count < entries.size() && traced.count(normalizeArchivePath(entries[count].name)) != 0)
+			++count;
+
+		// how far the disk head, or the read ahead, has to jump between the files
+		UnsignedInt64 bytes = 0;
+		UnsignedInt64 jumps = 0;
+		UnsignedInt64 jumpBytes = 0;
+		UnsignedInt64 position = 0;
+		for (size_t i = 0; i < count; ++i)
+		{
+			bytes += entries[i].sourceSize;
+			if (entries[i].sourceOffset != position)
+			{
+				++jumps;
+				jumpBytes += entries[i].sourceOffset > position ? entries[i].sourceOffset - position : position - entries[i].sourceOffset;
+			}
+			position = (UnsignedInt64)entries[i].sourceOffset + entries[i].sourceSize;
+		}
+
+		std::vector<double> times;
+		Bool cold = TRUE;
+		std::vector<char> buffer;
+		for (Int run = 0; run < runs; ++run)
+		{
+			cold = dropFileCache(inFiles[a]) && cold;
+
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			FILE *fp = fopen(inFiles[a].c_str(), "rb");
+			if (fp == nullptr)
+			{
+				DEBUG_LOG(("cannot open %s", inFiles[a].c_str()));
+				return EXIT_FAILURE;
+			}
+			for (size_t i = 0; i < count; ++i)
+			{
+				buffer.resize(std::max<size_t>(buffer.size(), entries[i].sourceSize));
+				fseek(fp, (long)entries[i].sourceOffset, SEEK_SET);
+				if (entries[i].sourceSize != 0)
+					fread(&buffer[0], 1, entries[i].sourceSize, fp);
+			}
+			fclose(fp);
+			times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+		}
+		std::sort(times.begin(), times.end());
+
+		DEBUG_LOG(("%s: %d traced files, %.1f MB, %llu jumps over %.1f MB, median %.1f ms, best %.1f ms%s",
+			inFiles[a].c_str(), (Int)count, bytes / 1048576.0, (unsigned long long)jumps, jumpBytes / 1048576.0,
+			times[times.size() / 2], times[0], cold ? "" : " (could not drop the file cache, times are warm)"));
+	}
+
+	return EXIT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Round trip test
+//////////////////////////////////////////////////////////////////////////////
+
+static UnsignedInt s_testSeed = 12345;
+
+static UnsignedInt testRandom()
+{
+	s_testSeed = s_testSeed * 1103515245 + 12345;
+	return (s_testSeed >> 8) & 0xffffff;
+}
+
+static Bool writeTestFile(const std::filesystem::path& path, const std::vector<char>& data)
+{
+	std::filesystem::create_directories(path.parent_path());
+	FILE *fp = fopen(path.string().c_str(), "wb");
+	if (fp == nullptr)
+		return FALSE;
+	Bool ok = data.empty() || fwrite(&data[0], 1, data.size(), fp) == data.size();
+	return fclose(fp) == 0 && ok;
+}
+
+// The entry as the game would see it after CachedFileInputStream decompressed it
+static Bool readUnpacked(const BigEntry& entry, std::vector<char>& data)
+{
+	if (!readEntryData(entry, data))
+		return FALSE;
+	if (data.empty() || !CompressionManager::isDataCompressed(&data[0], (Int)data.size()))
+		return TRUE;
+
+	std::vector<char> unpacked(CompressionManager::getUncompressedSize(&data[0], (Int)data.size()));
+	if (CompressionManager::decompressData(&data[0], (Int)data.size(), unpacked.empty() ? nullptr : &unpacked[0], (Int)unpacked.size()) != (Int)unpacked.size())
+		return FALSE;
+	data.swap(unpacked);
+	return TRUE;
+}
+
+static Bool readWholeFile(const std::string& file, std::vector<char>& data)
+{
+	BigEntry entry;
+	entry.sourceFile = file;
+	std::error_code code;
+	entry.sourceSize = (UnsignedInt)std::filesystem::file_size(file, code);
+	return !code && readEntryData(entry, data);
+}
+
+#define TEST_CHECK(condition, message) \
+	if (!(condition)) { DEBUG_LOG(("FAILED: %s", message)); return EXIT_FAILURE; }
+
+static Int runRoundTripTest()
+{
+	std::filesystem::path root = std::filesystem::temp_directory_path() / "bigarchive_test";
+	std::error_code code;
+	std::filesystem::remove_all(root, code);
+	std::filesystem::path source = root / "source";
+
+	// Files of all sizes in a few directories, text that compresses and noise that does not
+	const Int fileCount = 300;
+	std::vector<std::string> names;
+	std::vector<std::vector<char> > contents;
+	const char *directories[] = { "Data/INI", "Data/INI/Object", "Maps/Alpine Assault", "Art/Textures", "Window" };
+	const char *extensions[] = { ".ini", ".map", ".tga", ".wnd", ".w3d" };
+	for (Int i = 0; i < fileCount; ++i)
+	{
+		char name[128];
+		snprintf(name, sizeof(name), "%s/File%03d%s", directories[i % 5], i, extensions[(i / 5) % 5]);
+		names.push_back(name);
+
+		UnsignedInt size = i == 0 ? 0 : testRandom() % (i % 7 == 0 ? 300000 : 20000);
+		std::vector<char> data(size);
+		Bool text = (i % 3) != 0;
+		for (UnsignedInt b = 0; b < size; ++b)
+			data[b] = text ? "Object Weapon = 10\r\n"[(b + i) % 20] : (char)testRandom();
+		contents.push_back(data);
+
+		TEST_CHECK(writeTestFile(source / name, data), "cannot write the test files");
+	}
+
+	// 1. Build from the directory and read it back the way StdBIGFileSystem does
+	std::vector<BigEntry> entries;
+	std::string error;
+	TEST_CHECK(collectLooseFiles(source.string(), entries, error), error.c_str());
+	TEST_CHECK(entries.size() == (size_t)fileCount, "not all test files were found");
+
+	BigWriteSettings settings;
+	settings.compressMasks.push_back("*.map");
+	settings.threads = 4;
+	BigWriteStats stats;
+	std::string first = (root / "first.big").string();
+	TEST_CHECK(writeBigArchive(first, entries, settings, stats, error), error.c_str());
+	TEST_CHECK(stats.compressed > 0, "no .map file was compressed");
+	const UnsignedInt compressed = stats.compressed;
+
+	std::vector<char> bytes;
+	TEST_CHECK(readWholeFile(first, bytes), "cannot read the archive");
+	TEST_CHECK(bytes.size() >= 16 && memcmp(&bytes[0], "BIGF", 4) == 0, "bad identifier");
+	const unsigned char *header = (const unsigned char *)&bytes[0];
+	TEST_CHECK((header[4] | (header[5] << 8) | (header[6] << 16) | ((UnsignedInt)header[7] << 24)) == bytes.size(), "archive size does not match");
+
+	std::vector<BigEntry> readBack;
+	TEST_CHECK(readBigDirectory(first, readBack, error), error.c_str());
+	TEST_CHECK(readBack.size() == (size_t)fileCount, "wrong number of files in the archive");
+	for (Int i = 0; i < fileCount; ++i)
+	{
+		std::string name = normalizeArchivePath(names[i]);
+		size_t found = 0;
+		while (found < readBack.size() && normalizeArchivePath(readBack[found].name) != name)
+			++found;
+		TEST_CHECK(found < readBack.size(), "a file is missing from the archive");
+
+		std::vector<char> data;
+		TEST_CHECK(readUnpacked(readBack[found], data), "cannot unpack a file");
+		TEST_CHECK(data == contents[i], "a file changed on the way through the archive");
+
+		Bool stored = readEntryData(readBack[found], data) && !data.empty() && CompressionManager::isDataCompressed(&data[0], (Int)data.size());
+		TEST_CHECK(!stored || matchesArchiveMask(name, "*.map"), "a file outside the compress masks was compressed");
+	}
+
+	// 2. Repack in trace order, on one and on many threads
+	std::string trace = (root / "trace.txt").string();
+	std::vector<std::string> traceOrder;
+	{
+		FILE *fp = fopen(trace.c_str(), "w");
+		TEST_CHECK(fp != nullptr, "cannot write the trace");
+		fprintf(fp, "# startup\n");
+		for (Int i = fileCount - 1; i >= 0; i -= 3)
+		{
+			std::string path = names[i];
+			std::replace(path.begin(), path.end(), '/', '\\');
+			fprintf(fp, "first.big\t%s\n", path.c_str());
+			traceOrder.push_back(normalizeArchivePath(path));
+		}
+		fprintf(fp, "first.big\tdata\\ini\\notinthearchive.ini\n");
+		fclose(fp);
+	}
+
+	std::vector<std::string> traceNames;
+	TEST_CHECK(readAccessTrace(trace, traceNames, error), error.c_str());
+
+	std::vector<BigEntry> repack;
+	TEST_CHECK(readBigDirectory(first, repack, error), error.c_str());
+	Int traced = orderByAccessTrace(repack, traceNames);
+	TEST_CHECK(traced == (Int)traceOrder.size(), "not all traced files were found");
+
+	std::string single = (root / "single.big").string();
+	std::string many = (root / "many.big").string();
+	settings.threads = 1;
+	TEST_CHECK(writeBigArchive(single, repack, settings, stats, error), error.c_str());
+	TEST_CHECK(stats.compressed == 0, "compressed files were compressed again");
+	settings.threads = 8;
+	TEST_CHECK(writeBigArchive(many, repack, settings, stats, error), error.c_str());
+
+	std::vector<char> singleBytes;
+	std::vector<char> manyBytes;
+	TEST_CHECK(readWholeFile(single, singleBytes) && readWholeFile(many, manyBytes), "cannot read the repacked archives");
+	TEST_CHECK(singleBytes == manyBytes, "the thread count changed the archive");
+
+	std::vector<BigEntry> ordered;
+	TEST_CHECK(readBigDirectory(many, ordered, error), error.c_str());
+	TEST_CHECK(ordered.size() == readBack.size(), "the repack lost files");
+	for (size_t i = 0; i < traceOrder.size(); ++i)
+	{
+		TEST_CHECK(normalizeArchivePath(ordered[i].name) == traceOrder[i], "the files are not in trace order");
+		TEST_CHECK(i == 0 || ordered[i].sourceOffset == ordered[i - 1].sourceOffset + ordered[i - 1].sourceSize, "the traced files are not next to each other");
+	}
+	for (size_t i = 0; i < ordered.size(); ++i)
+	{
+		std::vector<char> before;
+		std::vector<char> after;
+		size_t found = 0;
+		while (normalizeArchivePath(readBack[found].name) != normalizeArchivePath(ordered[i].name))
+			++found;
+		TEST_CHECK(readEntryData(readBack[found], before) && readEntryData(ordered[i], after) && before == after, "the repack changed a file");
+	}
+
+	std::filesystem::remove_all(root, code);
+	DEBUG_LOG(("Round trip test passed: %d files, %u compressed, %d traced", fileCount, compressed, traced));
+	return EXIT_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+	std::string createFile;
+	std::string repackFile;
+	std::string listFile;
+	std::string directory;
+	std::vector<std::string> inFiles;
+	std::vector<std::string> benchmarkFiles;
+	std::vector<std::string> traceFiles;
+	Bool test = FALSE;
+	Int runs = 3;
+
+	BigWriteSettings settings;
+	settings.threads = std::max(1, (Int)std::thread::hardware_concurrency());
+	Bool defaultMasks = TRUE;
+	settings.compressMasks.push_back("*.map");
+
+	for (int i=1; i<argc; ++i)
+	{
+		const Bool hasValue = i + 1 < argc;
+
+		if ( stricmp(argv[i], "-help") == 0 )
+		{
+			dumpHelp(argv[0]);
+			return EXIT_SUCCESS;
+		}
+		else if ( strcmp(argv[i], "-test") == 0 )
+		{
+			test = TRUE;
+		}
+		else if ( strcmp(argv[i], "-create") == 0 && hasValue )
+		{
+			createFile = argv[++i];
+		}
+		else if ( strcmp(argv[i], "-repack") == 0 && hasValue )
+		{
+			repackFile = argv[++i];
+		}
+		else if ( strcmp(argv[i], "-list") == 0 && hasValue )
+		{
+			listFile = argv[++i];
+		}
+		else if ( strcmp(argv[i], "-benchmark") == 0 && hasValue )
+		{
+			// all the following plain arguments are archives too
+			benchmarkFiles.push_back(argv[++i]);
+			while (i + 1 < argc && argv[i + 1][0] != '-')
+				benchmarkFiles.push_back(argv[++i]);
+		}
+		else if ( strcmp(argv[i], "-dir") == 0 && hasValue )
+		{
+			directory = argv[++i];
+		}
+		else if ( strcmp(argv[i], "-in") == 0 && hasValue )
+		{
+			inFiles.push_back(argv[++i]);
+		}
+		else if ( strcmp(argv[i], "-trace") == 0 && hasValue )
+		{
+			traceFiles.push_back(argv[++i]);
+		}
+		else if ( strcmp(argv[i], "-compress") == 0 && hasValue )
+		{
+			if (defaultMasks)
+				settings.compressMasks.clear();
+			defaultMasks = FALSE;
+			settings.compressMasks.push_back(argv[++i]);
+		}
+		else if ( strcmp(argv[i], "-threads") == 0 && hasValue )
+		{
+			settings.threads = std::max(1, atoi(argv[++i]));
+		}
+		else if ( strcmp(argv[i], "-runs") == 0 && hasValue )
+		{
+			runs = std::max(1, atoi(argv[++i]));
+		}
+		else if ( strcmp(argv[i], "-type") == 0 && hasValue )
+		{
+			++i;
+			for (int j=COMPRESSION_MIN; j<=COMPRESSION_MAX; ++j)
+			{
+				if ( stricmp(CompressionManager::getCompressionNameByType((CompressionType)j), argv[i]) == 0 )
+				{
+					settings.compression = (CompressionType)j;
+					break;
+				}
+			}
+		}
+		else
+		{
+			DEBUG_LOG(("Unknown argument '%s'", argv[i]));
+			dumpHelp(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (test)
+		return runRoundTripTest();
+
+	if (!listFile.empty())
+		return listArchive(listFile);
+
+	if (!benchmarkFiles.empty())
+		return benchmarkArchives(benchmarkFiles, traceFiles, runs);
+
+	if (!createFile.empty() && !directory.empty())
+	{
+		std::vector<BigEntry> entries;
+		std::string error;
+		if (!collectLooseFiles(directory, entries, error))
+		{
+			DEBUG_LOG(("%s", error.c_str()));
+			return EXIT_FAILURE;
+		}
+		return buildArchive(createFile, entries, traceFiles, settings) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	if (!repackFile.empty() && !inFiles.empty())
+	{
+		if (std::find(inFiles.begin(), inFiles.end(), repackFile) != inFiles.end())
+		{
+			DEBUG_LOG(("Cannot repack '%s' into itself", repackFile.c_str()));
+			return EXIT_FAILURE;
+		}
+
+		std::vector<BigEntry> entries;
+		for (size_t i = 0; i < inFiles.size(); ++i)
+		{
+			std::string error;
+			if (!readBigDirectory(inFiles[i], entries, error))
+			{
+				DEBUG_LOG(("%s", error.c_str()));
+				return EXIT_FAILURE;
+			}
+		}
+		return buildArchive(repackFile, entries, traceFiles, settings) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	dumpHelp(argv[0]);
+	return EXIT_SUCCESS;
+}
@@ -25,6 +25,7 @@
 #endif
 
 #include "mangler.h"
+#include "manglerpacket.h"
 #include "crc.h"
 #include "endian.h"
 
@@ -126,7 +127,6 @@ int main(int argc, char **argv)
 	UDP     udp4;
 	int     port = 4321;
 	config.getInt("PORT", port);
-	uint8 blitz = 0;
 
 	uint32 localIP = 0;
 	Wstring hostIPStr = "";
@@ -157,6 +157,7 @@ int main(int argc, char **argv)
 	INFMSG("sizeof(packet) == " << packet_size);
 	unsigned char *theAddr;
 	fd_set fdset;
+	// GeneralsX @performance 18/10/2026 The request handling is in manglerpacket.cpp, shared with the Unix server.
 	while (1)
 	{
 		retval = udp.Wait(15, 0, fdset);
@@ -169,26 +170,20 @@ int main(int argc, char **argv)
 		{
 			ManglerData *packet = (ManglerData *)buf;
 			theAddr = (unsigned char *)&(addr.sin_addr.s_addr);
-			if (retval != packet_size)
+			bool blitz = false;
+			ManglerResult result = Mangle_Request(buf, retval, addr.sin_addr.s_addr, addr.sin_port, &blitz);
+			if (result == MANGLER_BAD_SIZE)
 			{
 				WRNMSG("Recieved mis-sized packet (" << retval << " bytes) from " << theAddr[0] << "." << theAddr[1] << "." << theAddr[2] << "." << theAddr[3] << ":" << addr.sin_port);
 			}
+			else if (result == MANGLER_BAD_CRC)
+			{
+				WRNMSG("Recieved a bad packet - good length!");
+				continue;
+			}
 			else
 			{
-				if (!Passes_CRC_Check(buf, packet_size))
-				{
-					WRNMSG("Recieved a bad packet - good length!");
-					continue;
-				}
-				packet->NetCommandType = 44;
-				packet->MyMangledPortNumber = addr.sin_port; // not changing to host order, cause its in network byte order now, and the game will expect it to stay that way.
-				packet->MyMangledAddress[0] = theAddr[0];
-				packet->MyMangledAddress[1] = theAddr[1];
-				packet->MyMangledAddress[2] = theAddr[2];
-				packet->MyMangledAddress[3] = theAddr[3];
-				blitz = packet->BlitzMe;
 				INFMSG("Packet ID = " << packet->packetID);
-				Build_Packet_CRC(buf, packet_size);
 				udp.Write(buf,packet_size,ntohl(addr.sin_addr.s_addr), ntohs(addr.sin_port));
 				INFMSG("Saw " << (int)theAddr[0] << "." << (int)theAddr[1] << "." << (int)theAddr[2] << "." << (int)theAddr[3] << ":" << ntohs(addr.sin_port) << ((blitz)?" Blitzed":"") );
 
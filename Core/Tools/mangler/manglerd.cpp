@@ -0,0 +1,112 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// The mangler for Unix, see manglerserver.h.  Answers the same requests with
+// the same bytes as mangler.cpp, but takes its settings from the command line.
+
+#include "manglerserver.h"
+
+#include <arpa/inet.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static volatile sig_atomic_t Quit = 0;
+
+static void Handle_Signal(int)
+{
+	Quit = 1;
+}
+
+static void DisplayHelp(const char *prog)
+{
+	printf("Usage: %s [-ip address] [-port port]... [-workers count] [-stats seconds] [-verbose]\n", prog);
+	printf("  Each port gets the next %d ports for blitz replies.  Default port 4321,\n", BLITZ_SIZE);
+	printf("  default workers one per CPU.\n");
+	exit(0);
+}
+
+int main(int argc, char **argv)
+{
+	ManglerServer::Settings settings;
+	settings.workers = (int)std::thread::hardware_concurrency();
+	if (settings.workers < 1)
+		settings.workers = 1;
+	int statsSeconds = 60;
+
+	for (int i=1; i<argc; ++i)
+	{
+		bool hasValue = i + 1 < argc;
+		if (strcmp(argv[i], "-ip") == 0 && hasValue)
+		{
+			in_addr_t addr = inet_addr(argv[++i]);
+			if (addr == INADDR_NONE)
+			{
+				printf("Bad address %s\n", argv[i]);
+				return 1;
+			}
+			settings.ip = ntohl(addr);
+		}
+		else if (strcmp(argv[i], "-port") == 0 && hasValue)
+			settings.ports.push_back(atoi(argv[++i]));
+		else if (strcmp(argv[i], "-workers") == 0 && hasValue)
+			settings.workers = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-stats") == 0 && hasValue)
+			statsSeconds = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-verbose") == 0)
+			settings.verbose = true;
+		else
+			DisplayHelp(argv[0]);
+	}
+	if (settings.ports.empty())
+		settings.ports.push_back(4321);
+
+	ManglerServer server;
+	if (!server.start(settings))
+	{
+		printf("Couldn't start - %s\n", server.getError().c_str());
+		return 1;
+	}
+
+	for (size_t i=0; i<settings.ports.size(); ++i)
+		printf("Serving port %d-%d\n", settings.ports[i], settings.ports[i] + BLITZ_SIZE);
+	printf("%d workers, %s\n", settings.workers, MANGLER_USE_EPOLL ? "epoll" : "poll");
+	fflush(stdout);
+
+	signal(SIGINT, Handle_Signal);
+	signal(SIGTERM, Handle_Signal);
+
+	int elapsed = 0;
+	while (!Quit)
+	{
+		sleep(1);
+		if (statsSeconds > 0 && ++elapsed % statsSeconds == 0)
+		{
+			ManglerServer::Stats stats;
+			server.getStats(stats);
+			printf("Requests %llu, replies %llu, blitzed %llu, bad size %llu, bad CRC %llu\n",
+			       stats.requests, stats.replies, stats.blitzed, stats.badSize, stats.badCRC);
+			fflush(stdout);
+		}
+	}
+
+	server.stop();
+	return 0;
+}
@@ -0,0 +1,388 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Load generator for the mangler.  Runs a ManglerServer on the loopback
+// unless told to hit another one, then has a number of client threads keep a
+// window of requests in flight each.  Every reply is checked against what
+// Mangle_Request makes of the request, and the round trips are timed.
+// GeneralsX @performance 18/10/2026 Measures packets per second and tail
+// latency of the batched Unix mangler.
+
+#include "manglerserver.h"
+#include "manglerpacket.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <chrono>
+#include <errno.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+typedef std::chrono::steady_clock Clock;
+
+struct LoadSettings
+{
+	unsigned int serverIP;    // host byte order
+	int firstPort;
+	int portCount;
+	int clients;
+	int seconds;
+	int window;               // requests in flight per client
+	bool blitz;
+};
+
+struct ClientResult
+{
+	unsigned long long sent = 0;
+	unsigned long long replies = 0;
+	unsigned long long blitzReplies = 0;
+	unsigned long long lost = 0;
+	unsigned long long wrong = 0;
+	std::vector<unsigned int> latencyUs;
+};
+
+struct InFlight
+{
+	bool busy;
+	unsigned short packetID;
+	Clock::time_point sentAt;
+	unsigned char expected[sizeof(ManglerData)];
+};
+
+static const int LostAfterMs = 1000;
+
+// Binds 1 + BLITZ_SIZE consecutive ports if blitzing, else any one port
+static bool Open_Client(unsigned int ip, bool blitz, int *fds, int *count, unsigned short *port)
+{
+	static std::atomic<int> nextPort(20000);
+
+	*count = blitz ? 1 + BLITZ_SIZE : 1;
+	for (int attempt=0; attempt<1000; ++attempt)
+	{
+		unsigned short base = 0;
+		if (blitz)
+		{
+			int taken = nextPort.fetch_add(1 + BLITZ_SIZE);
+			base = (unsigned short)(20000 + taken % 40000);
+		}
+
+		bool ok = true;
+		int opened = 0;
+		for (; opened<*count && ok; ++opened)
+		{
+			fds[opened] = socket(AF_INET, SOCK_DGRAM, 0);
+			int bufferSize = 1024 * 1024;
+			setsockopt(fds[opened], SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+
+			struct sockaddr_in addr;
+			memset(&addr, 0, sizeof(addr));
+			addr.sin_family = AF_INET;
+			addr.sin_addr.s_addr = htonl(ip);
+			addr.sin_port = htons(blitz ? (unsigned short)(base + opened) : 0);
+			ok = fds[opened] >= 0 && bind(fds[opened], (struct sockaddr *)&addr, sizeof(addr)) == 0;
+		}
+		if (ok)
+		{
+			struct sockaddr_in addr;
+			socklen_t length = sizeof(addr);
+			getsockname(fds[0], (struct sockaddr *)&addr, &length);
+			*port = ntohs(addr.sin_port);
+			return true;
+		}
+
+		for (int i=0; i<opened; ++i)
+		{
+			if (fds[i] >= 0)
+				close(fds[i]);
+		}
+		if (!blitz)
+			break;
+	}
+	return false;
+}
+
+static void Run_Client(const LoadSettings& settings, int index, Clock::time_point end, ClientResult *result)
+{
+	// talk from the loopback to a loopback server, else let the kernel pick
+	unsigned int localIP = (settings.serverIP >> 24) == 127 ? settings.serverIP : 0;
+
+	int fds[1 + BLITZ_SIZE];
+	int fdCount = 0;
+	unsigned short localPort = 0;
+	if (!Open_Client(localIP, settings.blitz, fds, &fdCount, &localPort))
+	{
+		printf("Client %d couldn't bind: %s\n", index, strerror(errno));
+		return;
+	}
+
+	struct sockaddr_in server;
+	memset(&server, 0, sizeof(server));
+	server.sin_family = AF_INET;
+	server.sin_addr.s_addr = htonl(settings.serverIP);
+	server.sin_port = htons((unsigned short)(settings.firstPort + (index % settings.portCount) * (1 + BLITZ_SIZE)));
+
+	std::vector<InFlight> window(settings.window);
+	for (size_t i=0; i<window.size(); ++i)
+		window[i].busy = false;
+	unsigned short nextID = (unsigned short)(index * 7919);
+	result->latencyUs.reserve(1 << 20);
+
+	struct pollfd pollFds[1 + BLITZ_SIZE];
+	for (int i=0; i<fdCount; ++i)
+	{
+		pollFds[i].fd = fds[i];
+		pollFds[i].events = POLLIN;
+	}
+
+	Clock::time_point lastLostCheck = Clock::now();
+	while (Clock::now() < end)
+	{
+		// keep the window full
+		for (size_t slot=0; slot<window.size(); ++slot)
+		{
+			InFlight& flight = window[slot];
+			if (flight.busy)
+				continue;
+
+			// the packet ID picks the slot, so reuse IDs of this slot only
+			while (nextID % window.size() != slot)
+				++nextID;
+			flight.packetID = nextID++;
+
+			ManglerData packet;
+			memset(&packet, 0, sizeof(packet));
+			packet.magic = htons((unsigned short)0xf00d);
+			packet.packetID = flight.packetID;
+			packet.NetCommandType = NET_MANGLER_REQUEST;
+			packet.BlitzMe = settings.blitz ? 1 : 0;
+			packet.Padding = (unsigned short)(index + slot);
+			Mangler_Build_CRC((unsigned char *)&packet, sizeof(packet));
+
+			// the server will see us at our bound address, which for a remote
+			// server is only known from its reply
+			memcpy(flight.expected, &packet, sizeof(packet));
+			if (localIP)
+				Mangle_Request(flight.expected, sizeof(packet), htonl(localIP), htons(localPort), nullptr);
+
+			flight.sentAt = Clock::now();
+			if (sendto(fds[0], &packet, sizeof(packet), 0, (struct sockaddr *)&server, sizeof(server)) == sizeof(packet))
+			{
+				flight.busy = true;
+				++result->sent;
+			}
+			else
+				break; // send buffer is full, try again after reading
+		}
+
+		if (poll(pollFds, fdCount, 10) <= 0)
+			continue;
+
+		unsigned char buf[1024];
+		for (int f=0; f<fdCount; ++f)
+		{
+			if (!(pollFds[f].revents & POLLIN))
+				continue;
+
+			ssize_t length;
+			while ((length = recv(fds[f], buf, sizeof(buf), MSG_DONTWAIT)) >= 0)
+			{
+				Clock::time_point now = Clock::now();
+				if (length != sizeof(ManglerData) || !Mangler_Passes_CRC(buf, (int)length)
+					|| buf[offsetof(ManglerData, NetCommandType)] != NET_MANGLER_RESPONSE)
+				{
+					++result->wrong;
+					continue;
+				}
+				if (f > 0)
+				{
+					++result->blitzReplies;
+					continue;
+				}
+
+				unsigned short packetID;
+				memcpy(&packetID, buf + offsetof(ManglerData, packetID), sizeof(packetID));
+				InFlight& flight = window[packetID % window.size()];
+				if (!flight.busy || flight.packetID != packetID)
+					continue; // came in after we gave up on it
+
+				if (!localIP)
+				{
+					unsigned int mangledAddress;
+					unsigned short mangledPort;
+					memcpy(&mangledAddress, buf + offsetof(ManglerData, MyMangledAddress), sizeof(mangledAddress));
+					memcpy(&mangledPort, buf + offsetof(ManglerData, MyMangledPortNumber), sizeof(mangledPort));
+					Mangle_Request(flight.expected, sizeof(ManglerData), mangledAddress, mangledPort, nullptr);
+				}
+				if (memcmp(buf, flight.expected, sizeof(ManglerData)) != 0)
+					++result->wrong;
+
+				result->latencyUs.push_back((unsigned int)std::chrono::duration_cast<std::chrono::microseconds>(now - flight.sentAt).count());
+				++result->replies;
+				flight.busy = false;
+			}
+		}
+
+		Clock::time_point now = Clock::now();
+		if (now - lastLostCheck > std::chrono::milliseconds(100))
+		{
+			lastLostCheck = now;
+			for (size_t slot=0; slot<window.size(); ++slot)
+			{
+				if (window[slot].busy && now - window[slot].sentAt > std::chrono::milliseconds(LostAfterMs))
+				{
+					window[slot].busy = false;
+					++result->lost;
+				}
+			}
+		}
+	}
+
+	for (int i=0; i<fdCount; ++i)
+		close(fds[i]);
+}
+
+static void DisplayHelp(const char *prog)
+{
+	printf("Usage: %s [-server ip:port] [-ports count] [-workers count] [-clients count]\n", prog);
+	printf("          [-seconds count] [-window count] [-blitz]\n");
+	printf("  Without -server a mangler is run on 127.0.0.1 on ports 4321 and up.\n");
+	exit(0);
+}
+
+int main(int argc, char **argv)
+{
+	LoadSettings settings;
+	settings.serverIP = INADDR_LOOPBACK;
+	settings.firstPort = 4321;
+	settings.portCount = 1;
+	settings.clients = 8;
+	settings.seconds = 5;
+	settings.window = 32;
+	settings.blitz = false;
+	bool ownServer = true;
+	int workers = 2;
+
+	for (int i=1; i<argc; ++i)
+	{
+		bool hasValue = i + 1 < argc;
+		if (strcmp(argv[i], "-server") == 0 && hasValue)
+		{
+			char address[64];
+			strncpy(address, argv[++i], sizeof(address) - 1);
+			address[sizeof(address) - 1] = 0;
+			char *colon = strchr(address, ':');
+			if (colon)
+			{
+				*colon = 0;
+				settings.firstPort = atoi(colon + 1);
+			}
+			settings.serverIP = ntohl(inet_addr(address));
+			ownServer = false;
+		}
+		else if (strcmp(argv[i], "-ports") == 0 && hasValue)
+			settings.portCount = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-workers") == 0 && hasValue)
+			workers = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-clients") == 0 && hasValue)
+			settings.clients = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-seconds") == 0 && hasValue)
+			settings.seconds = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-window") == 0 && hasValue)
+			settings.window = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-blitz") == 0)
+			settings.blitz = true;
+		else
+			DisplayHelp(argv[0]);
+	}
+	if (settings.portCount < 1 || settings.clients < 1 || settings.window < 1 || settings.seconds < 1)
+		DisplayHelp(argv[0]);
+
+	// the base ports are spaced so that their blitz ports don't overlap
+	ManglerServer server;
+	if (ownServer)
+	{
+		ManglerServer::Settings serverSettings;
+		serverSettings.ip = settings.serverIP;
+		serverSettings.workers = workers;
+		for (int i=0; i<settings.portCount; ++i)
+			serverSettings.ports.push_back(settings.firstPort + i * (1 + BLITZ_SIZE));
+		if (!server.start(serverSettings))
+		{
+			printf("Couldn't start the mangler - %s\n", server.getError().c_str());
+			return 1;
+		}
+		printf("Mangler on 127.0.0.1, %d ports, %d workers, %s\n", settings.portCount, workers,
+		       MANGLER_USE_EPOLL ? "epoll" : "poll");
+	}
+
+	printf("%d clients, %d in flight each, %d seconds%s\n", settings.clients, settings.window, settings.seconds,
+	       settings.blitz ? ", blitzing" : "");
+	fflush(stdout);
+
+	std::vector<ClientResult> results(settings.clients);
+	std::vector<std::thread> clients;
+	Clock::time_point start = Clock::now();
+	Clock::time_point end = start + std::chrono::seconds(settings.seconds);
+	for (int i=0; i<settings.clients; ++i)
+		clients.push_back(std::thread(Run_Client, std::cref(settings), i, end, &results[i]));
+	for (size_t i=0; i<clients.size(); ++i)
+		clients[i].join();
+	double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+	ClientResult total;
+	for (size_t i=0; i<results.size(); ++i)
+	{
+		total.sent += results[i].sent;
+		total.replies += results[i].replies;
+		total.blitzReplies += results[i].blitzReplies;
+		total.lost += results[i].lost;
+		total.wrong += results[i].wrong;
+		total.latencyUs.insert(total.latencyUs.end(), results[i].latencyUs.begin(), results[i].latencyUs.end());
+	}
+	std::sort(total.latencyUs.begin(), total.latencyUs.end());
+
+	unsigned long long packets = total.sent + total.replies + total.blitzReplies;
+	printf("Sent %llu, replies %llu, blitz replies %llu, lost %llu, wrong %llu\n",
+	       total.sent, total.replies, total.blitzReplies, total.lost, total.wrong);
+	printf("%.0f requests/s, %.0f packets/s\n", total.replies / elapsed, packets / elapsed);
+
+	if (!total.latencyUs.empty())
+	{
+		const std::vector<unsigned int>& latency = total.latencyUs;
+		size_t last = latency.size() - 1;
+		printf("Latency us: p50 %u, p99 %u, p99.9 %u, max %u\n",
+		       latency[last * 50 / 100], latency[last * 99 / 100], latency[last * 999 / 1000], latency[last]);
+	}
+
+	if (ownServer)
+	{
+		ManglerServer::Stats stats;
+		server.getStats(stats);
+		printf("Mangler saw %llu requests, sent %llu replies, %llu bad size, %llu bad CRC\n",
+		       stats.requests, stats.replies, stats.badSize, stats.badCRC);
+		server.stop();
+	}
+
+	return total.wrong ? 1 : 0;
+}
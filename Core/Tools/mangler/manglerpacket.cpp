@@ -0,0 +1,82 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "manglerpacket.h"
+
+#include <cstddef>
+#include <cstring>
+
+/*
+** Same as Add_CRC in crc.cpp.  That one keeps the CRC in an unsigned long,
+** which is 64 bits on 64-bit Unix and would give other CRCs than Windows.
+*/
+static unsigned int Packet_CRC(const unsigned char *buf, int len)
+{
+	unsigned int crc = 0;
+	for (int i=4; i<len; i++)
+	{
+		unsigned int hibit = (crc & 0x80000000) ? 1 : 0;
+		crc <<= 1;
+		crc += buf[i];
+		crc += hibit;
+	}
+	return crc;
+}
+
+void Mangler_Build_CRC(unsigned char *buf, int len)
+{
+	if (!buf || len < 5)
+		return;
+
+	unsigned int crc = Packet_CRC(buf, len);
+	buf[0] = (unsigned char)(crc >> 24);
+	buf[1] = (unsigned char)(crc >> 16);
+	buf[2] = (unsigned char)(crc >> 8);
+	buf[3] = (unsigned char)crc;
+}
+
+bool Mangler_Passes_CRC(const unsigned char *buf, int len)
+{
+	if (!buf || len < 5)
+		return false;
+
+	unsigned int crc = Packet_CRC(buf, len);
+	return buf[0] == (unsigned char)(crc >> 24) && buf[1] == (unsigned char)(crc >> 16)
+		&& buf[2] == (unsigned char)(crc >> 8) && buf[3] == (unsigned char)crc;
+}
+
+ManglerResult Mangle_Request(unsigned char *buf, int len, unsigned int fromAddr, unsigned short fromPort, bool *blitz)
+{
+	const int packet_size = sizeof(ManglerData);
+	if (len != packet_size)
+		return MANGLER_BAD_SIZE;
+
+	if (!Mangler_Passes_CRC(buf, packet_size))
+		return MANGLER_BAD_CRC;
+
+	// The port stays in network byte order, the game expects it that way.
+	const unsigned char command = NET_MANGLER_RESPONSE;
+	memcpy(buf + offsetof(ManglerData, NetCommandType), &command, sizeof(command));
+	memcpy(buf + offsetof(ManglerData, MyMangledPortNumber), &fromPort, sizeof(fromPort));
+	memcpy(buf + offsetof(ManglerData, MyMangledAddress), &fromAddr, sizeof(fromAddr));
+	if (blitz)
+		*blitz = buf[offsetof(ManglerData, BlitzMe)] != 0;
+
+	Mangler_Build_CRC(buf, packet_size);
+	return MANGLER_REPLY;
+}
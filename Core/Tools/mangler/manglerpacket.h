@@ -0,0 +1,48 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// What the mangler does to a request, shared by the Windows mangler and the
+// batched Unix server.  It has no wlib or socket library dependencies.
+// GeneralsX @performance 18/10/2026 Split out of mangler.cpp so every build
+// answers with the same bytes.
+
+#pragma once
+
+#include "mangler.h"
+
+typedef enum ManglerResult {
+	MANGLER_BAD_SIZE,   // not a ManglerData, no reply
+	MANGLER_BAD_CRC,    // right size but the CRC does not match, no reply
+	MANGLER_REPLY       // buf holds the reply
+} ManglerResult;
+
+/*
+** Turns the request in buf into the reply, in place.  fromAddr and fromPort
+** are the sender as found in a sockaddr_in, so in network byte order.  If the
+** sender asked for a port blitz, blitz is set and the same reply goes to the
+** next BLITZ_SIZE ports of the sender as well.
+*/
+ManglerResult Mangle_Request(unsigned char *buf, int len, unsigned int fromAddr, unsigned short fromPort, bool *blitz);
+
+/*
+** The packet CRC of Build_Packet_CRC and Passes_CRC_Check, always done in
+** 32 bits.  len includes the 4-byte CRC at the head, which is stored in
+** network byte order.
+*/
+void Mangler_Build_CRC(unsigned char *buf, int len);
+bool Mangler_Passes_CRC(const unsigned char *buf, int len);
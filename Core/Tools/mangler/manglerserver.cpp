@@ -0,0 +1,454 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "manglerserver.h"
+#include "manglerpacket.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#if MANGLER_USE_EPOLL
+#include <sys/epoll.h>
+#endif
+
+// Packets taken off a socket at once
+static const int BatchSize = 64;
+
+// Batches taken off one socket before the other sockets get a turn
+static const int BatchesPerTurn = 16;
+
+// Anything bigger is cut off by the kernel, and is mis-sized anyway
+static const int PacketBufferSize = 1024;
+
+struct ManglerServer::Batch
+{
+	unsigned char buffers[BatchSize][PacketBufferSize];
+	struct sockaddr_in from[BatchSize];
+	int length[BatchSize];
+
+	// which of the packets get a reply, and which a blitz
+	int replies[BatchSize];
+	int replyCount;
+	int blitzes[BatchSize];
+	int blitzCount;
+	struct sockaddr_in blitzTo[BatchSize];
+
+#if MANGLER_USE_EPOLL
+	struct mmsghdr messages[BatchSize];
+	struct iovec vectors[BatchSize];
+#endif
+};
+
+ManglerServer::Settings::Settings()
+{
+	ip = 0;
+	workers = 1;
+	verbose = false;
+}
+
+ManglerServer::ManglerServer()
+{
+	m_running = false;
+}
+
+ManglerServer::~ManglerServer()
+{
+	stop();
+}
+
+int ManglerServer::openSocket(int port)
+{
+	int fd = socket(AF_INET, SOCK_DGRAM, 0);
+	if (fd < 0)
+	{
+		m_error = std::string("socket: ") + strerror(errno);
+		return -1;
+	}
+
+	// every worker binds the same ports, the kernel picks one per client
+	int on = 1;
+	setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+	if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) != 0 && m_settings.workers > 1)
+	{
+		m_error = std::string("SO_REUSEPORT: ") + strerror(errno);
+		close(fd);
+		return -1;
+	}
+
+	// room for bursts while the worker is busy with another port
+	int bufferSize = 4 * 1024 * 1024;
+	setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+	setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &bufferSize, sizeof(bufferSize));
+
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(m_settings.ip);
+	addr.sin_port = htons((unsigned short)port);
+	if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+	{
+		char error[64];
+		snprintf(error, sizeof(error), "bind to port %d: ", port);
+		m_error = error;
+		m_error += strerror(errno);
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+bool ManglerServer::openSockets(Worker& worker)
+{
+#if MANGLER_USE_EPOLL
+	worker.pollFd = epoll_create1(0);
+	if (worker.pollFd < 0)
+	{
+		m_error = std::string("epoll_create1: ") + strerror(errno);
+		return false;
+	}
+#else
+	worker.pollFd = -1;
+#endif
+
+	for (size_t i=0; i<m_settings.ports.size(); ++i)
+	{
+		PortSockets sockets;
+		sockets.port = m_settings.ports[i];
+		sockets.request = openSocket(sockets.port);
+		for (int b=0; b<BLITZ_SIZE; ++b)
+			sockets.blitz[b] = sockets.request < 0 ? -1 : openSocket(sockets.port + b + 1);
+		worker.sockets.push_back(sockets);
+
+		if (sockets.request < 0)
+			return false;
+		for (int b=0; b<BLITZ_SIZE; ++b)
+		{
+			if (sockets.blitz[b] < 0)
+				return false;
+		}
+
+#if MANGLER_USE_EPOLL
+		struct epoll_event event;
+		memset(&event, 0, sizeof(event));
+		event.events = EPOLLIN;
+		event.data.u32 = (unsigned int)i;
+		if (epoll_ctl(worker.pollFd, EPOLL_CTL_ADD, sockets.request, &event) != 0)
+		{
+			m_error = std::string("epoll_ctl: ") + strerror(errno);
+			return false;
+		}
+#endif
+	}
+
+	return true;
+}
+
+void ManglerServer::closeSockets(Worker& worker)
+{
+	for (size_t i=0; i<worker.sockets.size(); ++i)
+	{
+		PortSockets& sockets = worker.sockets[i];
+		if (sockets.request >= 0)
+			close(sockets.request);
+		for (int b=0; b<BLITZ_SIZE; ++b)
+		{
+			if (sockets.blitz[b] >= 0)
+				close(sockets.blitz[b]);
+		}
+	}
+	worker.sockets.clear();
+
+	if (worker.pollFd >= 0)
+		close(worker.pollFd);
+	worker.pollFd = -1;
+}
+
+bool ManglerServer::start(const Settings& settings)
+{
+	stop();
+
+	m_settings = settings;
+	m_error.clear();
+
+	if (m_settings.workers < 1 || m_settings.ports.empty())
+	{
+		m_error = "need at least one worker and one port";
+		return false;
+	}
+	for (size_t i=0; i<m_settings.ports.size(); ++i)
+	{
+		if (m_settings.ports[i] <= 0 || m_settings.ports[i] + BLITZ_SIZE > 65535)
+		{
+			m_error = "port out of range";
+			return false;
+		}
+	}
+
+	for (int i=0; i<m_settings.workers; ++i)
+	{
+		Worker *worker = new Worker;
+		worker->requests = 0;
+		worker->replies = 0;
+		worker->blitzed = 0;
+		worker->badSize = 0;
+		worker->badCRC = 0;
+		m_workers.push_back(worker);
+
+		if (!openSockets(*worker))
+		{
+			for (size_t w=0; w<m_workers.size(); ++w)
+			{
+				closeSockets(*m_workers[w]);
+				delete m_workers[w];
+			}
+			m_workers.clear();
+			return false;
+		}
+	}
+
+	m_running = true;
+	for (size_t i=0; i<m_workers.size(); ++i)
+		m_workers[i]->thread = std::thread(&ManglerServer::run, this, m_workers[i]);
+
+	return true;
+}
+
+void ManglerServer::stop()
+{
+	m_running = false;
+	for (size_t i=0; i<m_workers.size(); ++i)
+	{
+		if (m_workers[i]->thread.joinable())
+			m_workers[i]->thread.join();
+		closeSockets(*m_workers[i]);
+		delete m_workers[i];
+	}
+	m_workers.clear();
+}
+
+void ManglerServer::getStats(Stats& stats) const
+{
+	memset(&stats, 0, sizeof(stats));
+	for (size_t i=0; i<m_workers.size(); ++i)
+	{
+		const Worker& worker = *m_workers[i];
+		stats.requests += worker.requests;
+		stats.replies += worker.replies;
+		stats.blitzed += worker.blitzed;
+		stats.badSize += worker.badSize;
+		stats.badCRC += worker.badCRC;
+	}
+}
+
+void ManglerServer::run(Worker *worker)
+{
+	Batch *batch = new Batch;
+
+	// wake up now and then to see if we should stop
+	const int waitMs = 100;
+
+	while (m_running)
+	{
+#if MANGLER_USE_EPOLL
+		struct epoll_event events[16];
+		int count = epoll_wait(worker->pollFd, events, 16, waitMs);
+		for (int i=0; i<count; ++i)
+			serve(*worker, worker->sockets[events[i].data.u32], *batch);
+#else
+		std::vector<struct pollfd> fds(worker->sockets.size());
+		for (size_t i=0; i<fds.size(); ++i)
+		{
+			fds[i].fd = worker->sockets[i].request;
+			fds[i].events = POLLIN;
+			fds[i].revents = 0;
+		}
+		int count = poll(&fds[0], fds.size(), waitMs);
+		for (size_t i=0; count > 0 && i<fds.size(); ++i)
+		{
+			if (fds[i].revents & POLLIN)
+				serve(*worker, worker->sockets[i], *batch);
+		}
+#endif
+	}
+
+	delete batch;
+}
+
+void ManglerServer::serve(Worker& worker, const PortSockets& sockets, Batch& batch)
+{
+	for (int turn=0; turn<BatchesPerTurn; ++turn)
+	{
+		int count = 0;
+
+#if MANGLER_USE_EPOLL
+		for (int i=0; i<BatchSize; ++i)
+		{
+			batch.vectors[i].iov_base = batch.buffers[i];
+			batch.vectors[i].iov_len = PacketBufferSize;
+			memset(&batch.messages[i].msg_hdr, 0, sizeof(batch.messages[i].msg_hdr));
+			batch.messages[i].msg_hdr.msg_iov = &batch.vectors[i];
+			batch.messages[i].msg_hdr.msg_iovlen = 1;
+			batch.messages[i].msg_hdr.msg_name = &batch.from[i];
+			batch.messages[i].msg_hdr.msg_namelen = sizeof(batch.from[i]);
+		}
+
+		count = recvmmsg(sockets.request, batch.messages, BatchSize, MSG_DONTWAIT, nullptr);
+		if (count <= 0)
+			return;
+
+		for (int i=0; i<count; ++i)
+		{
+			bool cut = (batch.messages[i].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+			batch.length[i] = cut ? PacketBufferSize + 1 : (int)batch.messages[i].msg_len;
+		}
+#else
+		for (; count<BatchSize; ++count)
+		{
+			socklen_t fromLength = sizeof(batch.from[count]);
+			ssize_t length = recvfrom(sockets.request, batch.buffers[count], PacketBufferSize, MSG_DONTWAIT,
+			                          (struct sockaddr *)&batch.from[count], &fromLength);
+			if (length < 0)
+				break;
+			batch.length[count] = (int)length;
+		}
+		if (count == 0)
+			return;
+#endif
+
+		reply(worker, sockets, batch, count);
+
+		if (count < BatchSize)
+			return; // drained
+	}
+}
+
+#if MANGLER_USE_EPOLL
+// Sends them all, dropping the ones the socket won't take like a lost packet
+static void Send_All(int fd, struct mmsghdr *messages, int count)
+{
+	int sent = 0;
+	int retries = 0;
+	while (sent < count)
+	{
+		int result = sendmmsg(fd, messages + sent, count - sent, 0);
+		if (result > 0)
+		{
+			sent += result;
+			continue;
+		}
+
+		if ((errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS) && retries++ < 10)
+		{
+			struct pollfd fds;
+			fds.fd = fd;
+			fds.events = POLLOUT;
+			poll(&fds, 1, 1);
+			continue;
+		}
+
+		++sent;
+	}
+}
+#endif
+
+void ManglerServer::reply(Worker& worker, const PortSockets& sockets, Batch& batch, int count)
+{
+	batch.replyCount = 0;
+	batch.blitzCount = 0;
+	unsigned long long badSize = 0;
+	unsigned long long badCRC = 0;
+
+	for (int i=0; i<count; ++i)
+	{
+		const struct sockaddr_in& from = batch.from[i];
+		bool blitz = false;
+		ManglerResult result = Mangle_Request(batch.buffers[i], batch.length[i], from.sin_addr.s_addr, from.sin_port, &blitz);
+		if (result == MANGLER_BAD_SIZE)
+		{
+			++badSize;
+			continue;
+		}
+		if (result == MANGLER_BAD_CRC)
+		{
+			++badCRC;
+			continue;
+		}
+
+		batch.replies[batch.replyCount++] = i;
+		if (blitz)
+			batch.blitzes[batch.blitzCount++] = i;
+
+		if (m_settings.verbose)
+		{
+			const unsigned char *addr = (const unsigned char *)&from.sin_addr.s_addr;
+			printf("Saw %d.%d.%d.%d:%d on port %d%s\n", addr[0], addr[1], addr[2], addr[3], ntohs(from.sin_port),
+			       sockets.port, blitz ? " Blitzed" : "");
+		}
+	}
+
+	const int packet_size = sizeof(ManglerData);
+
+	// the reply goes back from the port the request came in on, a blitz
+	// goes from each of the next ports to the same port offset of the client
+	for (int b=-1; b<BLITZ_SIZE; ++b)
+	{
+		int fd = b < 0 ? sockets.request : sockets.blitz[b];
+		const int *which = b < 0 ? batch.replies : batch.blitzes;
+		int sendCount = b < 0 ? batch.replyCount : batch.blitzCount;
+		if (!sendCount)
+			continue;
+
+		for (int i=0; i<sendCount; ++i)
+		{
+			batch.blitzTo[i] = batch.from[which[i]];
+			batch.blitzTo[i].sin_port = htons((unsigned short)(ntohs(batch.from[which[i]].sin_port) + b + 1));
+
+#if MANGLER_USE_EPOLL
+			batch.vectors[i].iov_base = batch.buffers[which[i]];
+			batch.vectors[i].iov_len = packet_size;
+			memset(&batch.messages[i].msg_hdr, 0, sizeof(batch.messages[i].msg_hdr));
+			batch.messages[i].msg_hdr.msg_iov = &batch.vectors[i];
+			batch.messages[i].msg_hdr.msg_iovlen = 1;
+			batch.messages[i].msg_hdr.msg_name = &batch.blitzTo[i];
+			batch.messages[i].msg_hdr.msg_namelen = sizeof(batch.blitzTo[i]);
+#else
+			sendto(fd, batch.buffers[which[i]], packet_size, 0, (struct sockaddr *)&batch.blitzTo[i], sizeof(batch.blitzTo[i]));
+#endif
+		}
+
+#if MANGLER_USE_EPOLL
+		Send_All(fd, batch.messages, sendCount);
+#endif
+	}
+
+	worker.requests += count;
+	worker.replies += batch.replyCount + BLITZ_SIZE * batch.blitzCount;
+	worker.blitzed += batch.blitzCount;
+	worker.badSize += badSize;
+	worker.badCRC += badCRC;
+}
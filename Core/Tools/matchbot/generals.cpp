@@ -98,74 +98,6 @@ std::string uintToString(unsigned int val)
 	return s;
 }
 
-MapBitSet MapSetUnion(const MapBitSet& a, const MapBitSet& b)
-{
-	MapBitSet c;
-	if (a.size() != b.size())
-		return c;
-
-	for (int i=0; i<(int)a.size(); ++i)
-	{
-		c.push_back(a[i] && b[i]);
-	}
-
-	return c;
-}
-
-int MapSetCount(const MapBitSet& a)
-{
-	int count=0;
-	for (int i=0; i<(int)a.size(); ++i)
-	{
-		//DBGMSG(a[i]);
-		if (a[i])
-			++count;
-	}
-	return count;
-}
-
-// =====================================================================
-// Users
-// =====================================================================
-
-GeneralsUser::GeneralsUser()
-{
-	status = STATUS_INCHANNEL;
-	points = 1;
-	minPoints = maxPoints = 100;
-	country = color = -1;
-	pseudoPing.clear();
-	matchStart = time(nullptr);
-	timeToWiden = 0;
-	widened = false;
-	numPlayers = 2;
-	discons = maxDiscons = 2;
-	maps.clear();
-	maxPing = 1000;
-}
-
-static const int MaxPingValue = 255*255*2;
-
-int calcPingDelta(const GeneralsUser *a, const GeneralsUser *b)
-{
-	if (!a || !b || a->pseudoPing.size() != b->pseudoPing.size())
-		return MaxPingValue; // Max ping
-
-	int bestPing = MaxPingValue;
-	for (int i=0; i<(int)a->pseudoPing.size(); ++i)
-	{
-		int p1, p2;
-		p1 = a->pseudoPing[i];
-		p2 = b->pseudoPing[i];
-
-		if (p1 * p1 + p2 * p2 < bestPing)
-			bestPing = p1 * p1 + p2 * p2;
-	}
-
-	return (int)sqrt(bestPing);
-}
-
-
 // =====================================================================
 // Matcher thread
 // =====================================================================
@@ -188,6 +120,7 @@ GeneralsMatcher::GeneralsMatcher()
 	INFMSG("weightLowPing = " << weightLowPing);
 	INFMSG("weightAvgPoints = " << weightAvgPoints);
 	INFMSG("totalWeight = " << totalWeight);
+	m_matchFinder.setWeights(weightLowPing, weightAvgPoints);
 
 	Global.config.getInt("SecondsBetweenPoolSizeAnnouncements", m_secondsBetweenPoolSizeAnnouncements, nullptr);
 	if (m_secondsBetweenPoolSizeAnnouncements < 10)
@@ -451,79 +384,10 @@ void GeneralsMatcher::checkMatches()
 	}
 }
 
-double GeneralsMatcher::computeMatchFitness(const std::string& i1, const GeneralsUser *u1, const std::string& i2, const GeneralsUser *u2)
-{
-	//DBGMSG("matching "<<i1<< " vs "<<i2);
-	if (u1->status != STATUS_WORKING || u2->status != STATUS_WORKING)
-		return 0.0;
-
-	// see if they pinged the same # of servers (sanity).
-	if (u1->pseudoPing.size() != u2->pseudoPing.size())
-		return 0.0;
-
-	// check point percentage ranges
-	int p1 = max(1,u1->points), p2 = max(1,u2->points);
-	double p1percent = (double)p2/(double)p1;
-	double p2percent = (double)p1/(double)p2;
-	//DBGMSG("points: " << p1 << "," << p2 << " - " << p1percent << "," << p2percent);
-	if (!u1->widened && ( p1percent < u1->minPoints || p1percent > u1->maxPoints ))
-		return 0.0;
-
-	if (!u2->widened && ( p2percent < u2->minPoints || p2percent > u2->maxPoints ))
-		return 0.0;
-
-
-	int minP = min(p1, p2);
-	int maxP = max(p1, p2);
-	double pointPercent = (double)minP/(double)maxP;
-	//DBGMSG("\tpointPercent = "<<pointPercent);
-
-	// check pings
-	int pingDelta = calcPingDelta(u1, u2);
-	if (!u1->widened && pingDelta > u1->maxPing)
-		return 0.0;
-	if (!u2->widened && pingDelta > u2->maxPing)
-		return 0.0;
-	//DBGMSG("pingDelta="<<pingDelta);
-
-	//DBGMSG(u1->discons << "," << u1->maxDiscons << "  " << u2->discons << "," << u2->maxDiscons);
-	// check discons
-	if (u1->maxDiscons && (!u1->widened && u2->discons > u1->maxDiscons))
-		return 0.0;
-	if (u2->maxDiscons && (!u2->widened && u1->discons > u2->maxDiscons))
-		return 0.0;
-	//DBGMSG("Made it through discons");
-
-	{
-		MapBitSet tmp = MapSetUnion(u1->maps, u2->maps);
-		if (!MapSetCount(tmp))
-			return 0.0;
-	}
-
-	// they have something in common.  calculate match fitness.
-	double matchFitness = ( weightAvgPoints * (1-pointPercent) +
-	                        weightLowPing * (MaxPingValue - pingDelta)/MaxPingValue ) / (double)totalWeight;
-	//DBGMSG("Match fitness: "<<matchFitness);
-
-	/*
-	DBGMSG(i1->first << " vs " << i2->first << " has fitness " << matchFitness
-			   "\tpointPercent: " << pointPercent << "\n"
-			   "\tpingDelta: " << pingDelta << "\n"
-			   "\twidened: " << u1->widened << u2->widened << "\n"
-			   "\tweightAvgPoints: " << weightAvgPoints << "\n"
-			   "\tweightLowPing: " << weightLowPing << "\n"
-			   "\ttotalWeight: " << totalWeight
-			  );
-				*/
-
-	return matchFitness;
-}
-
 void GeneralsMatcher::checkMatchesInUserMap(UserMap& userMap, int ladderID, int numPlayers, bool showPoolSize)
 {
-	UserMap::iterator i1, i2, i3, i4, i5, i6, i7, i8;
-	GeneralsUser *u1, *u2, *u3, *u4, *u5, *u6, *u7, *u8;
-	static const double fitnessThreshold = 0.3;
+	UserMap::iterator i1;
+	GeneralsUser *u1;
 	time_t now = time(nullptr);
 
 	std::string s;
@@ -553,205 +417,34 @@ void GeneralsMatcher::checkMatchesInUserMap(UserMap& userMap, int ladderID, int
 		}
 	}
 
-	// iterate through all users, looking for a match
-	for (i1 = userMap.begin(); i1 != userMap.end(); ++i1)
-	{
-		u1 = i1->second;
-		if (u1->status != STATUS_WORKING)
-			continue;
-
-		GeneralsUser *bestUser = nullptr;
-		double bestMatchFitness = 0.0;
-		std::string bestName = "";
-
-		// look at everybody left
-		i2 = i1;
-		for (++i2; i2 != userMap.end(); ++i2)
-		{
-			u2 = i2->second;
-			if (u2->status != STATUS_WORKING)
-				continue;
-
-			double matchFitness = computeMatchFitness(i1->first, u1, i2->first, u2);
-			if (matchFitness > fitnessThreshold)
-			{
-				if (numPlayers == 2)
-				{
-					if (matchFitness > bestMatchFitness)
-					{
-						// possibly match 2 players
-						bestMatchFitness = matchFitness;
-						bestUser = u2;
-						bestName = i2->first;
-					}
-				}
-				else
-				{
-					i3 = i2;
-					for (++i3; i3 != userMap.end(); ++i3)
-					{
-						u3 = i3->second;
-						if (u3->status != STATUS_WORKING)
-							continue;
-
-						double matchFitness1 = computeMatchFitness(i1->first, u1, i3->first, u3);
-						double matchFitness2 = computeMatchFitness(i2->first, u2, i3->first, u3);
-						MapBitSet tmp = MapSetUnion(u1->maps, u2->maps);
-						tmp = MapSetUnion(tmp, u3->maps);
-						if (MapSetCount(tmp) && matchFitness1 > fitnessThreshold && matchFitness2 > fitnessThreshold)
-						{
-							i4 = i3;
-							for (++i4; i4 != userMap.end(); ++i4)
-							{
-								u4 = i4->second;
-								if (u4->status != STATUS_WORKING)
-									continue;
-
-								double matchFitness1 = computeMatchFitness(i1->first, u1, i4->first, u4);
-								double matchFitness2 = computeMatchFitness(i2->first, u2, i4->first, u4);
-								double matchFitness3 = computeMatchFitness(i3->first, u3, i4->first, u4);
-								MapBitSet tmp = MapSetUnion(u1->maps, u2->maps);
-								tmp = MapSetUnion(tmp, u3->maps);
-								tmp = MapSetUnion(tmp, u4->maps);
-								if (MapSetCount(tmp) && matchFitness1 > fitnessThreshold && matchFitness2 > fitnessThreshold && matchFitness3 > fitnessThreshold)
-								{
-									if (numPlayers == 4)
-									{
-										// match 4 players
-										sendMatchInfo(i1->first, i2->first, i3->first, i4->first, "", "", "", "",
-										              u1, u2, u3, u4, nullptr, nullptr, nullptr, nullptr, 4, ladderID);
-										break;
-									}
-									else
-									{
-
-										i5 = i4;
-										for (++i5; i5 != userMap.end(); ++i5)
-										{
-											u5 = i5->second;
-											if (u5->status != STATUS_WORKING)
-												continue;
-
-											double matchFitness1 = computeMatchFitness(i1->first, u1, i5->first, u5);
-											double matchFitness2 = computeMatchFitness(i2->first, u2, i5->first, u5);
-											double matchFitness3 = computeMatchFitness(i3->first, u3, i5->first, u5);
-											double matchFitness4 = computeMatchFitness(i4->first, u4, i5->first, u5);
-											MapBitSet tmp = MapSetUnion(u1->maps, u2->maps);
-											tmp = MapSetUnion(tmp, u3->maps);
-											tmp = MapSetUnion(tmp, u4->maps);
-											tmp = MapSetUnion(tmp, u5->maps);
-											if (MapSetCount(tmp) && matchFitness1 > fitnessThreshold && matchFitness2 > fitnessThreshold && matchFitness3 > fitnessThreshold && matchFitness4 > fitnessThreshold)
-											{
-												i6 = i5;
-												for (++i6; i6 != userMap.end(); ++i6)
-												{
-													u6 = i6->second;
-													if (u6->status != STATUS_WORKING)
-														continue;
-
-													double matchFitness1 = computeMatchFitness(i1->first, u1, i6->first, u6);
-													double matchFitness2 = computeMatchFitness(i2->first, u2, i6->first, u6);
-													double matchFitness3 = computeMatchFitness(i3->first, u3, i6->first, u6);
-													double matchFitness4 = computeMatchFitness(i4->first, u4, i6->first, u6);
-													double matchFitness5 = computeMatchFitness(i5->first, u5, i6->first, u6);
-													MapBitSet tmp = MapSetUnion(u1->maps, u2->maps);
-													tmp = MapSetUnion(tmp, u3->maps);
-													tmp = MapSetUnion(tmp, u4->maps);
-													tmp = MapSetUnion(tmp, u5->maps);
-													tmp = MapSetUnion(tmp, u6->maps);
-													if (MapSetCount(tmp) && matchFitness1 > fitnessThreshold && matchFitness2 > fitnessThreshold && matchFitness3 > fitnessThreshold && matchFitness4 > fitnessThreshold && matchFitness5 > fitnessThreshold)
-													{
-														if (numPlayers == 6)
-														{
-															// match 6 players
-															sendMatchInfo(i1->first, i2->first, i3->first, i4->first, i5->first, i6->first, "", "",
-															              u1, u2, u3, u4, u5, u6, nullptr, nullptr, 6, ladderID);
-															break;
-														}
-														else
-														{
-
-															i7 = i6;
-															for (++i7; i7 != userMap.end(); ++i7)
-															{
-																u7 = i7->second;
-																if (u7->status != STATUS_WORKING)
-																	continue;
-
-																double matchFitness1 = computeMatchFitness(i1->first, u1, i7->first, u7);
-																double matchFitness2 = computeMatchFitness(i2->first, u2, i7->first, u7);
-																double matchFitness3 = computeMatchFitness(i3->first, u3, i7->first, u7);
-																double matchFitness4 = computeMatchFitness(i4->first, u4, i7->first, u7);
-																double matchFitness5 = computeMatchFitness(i5->first, u5, i7->first, u7);
-																double matchFitness6 = computeMatchFitness(i6->first, u6, i7->first, u7);
-																MapBitSet tmp = MapSetUnion(u1->maps, u2->maps);
-																tmp = MapSetUnion(tmp, u3->maps);
-																tmp = MapSetUnion(tmp, u4->maps);
-																tmp = MapSetUnion(tmp, u5->maps);
-																tmp = MapSetUnion(tmp, u6->maps);
-																tmp = MapSetUnion(tmp, u7->maps);
-																if (MapSetCount(tmp) && matchFitness1 > fitnessThreshold && matchFitness2 > fitnessThreshold && matchFitness3 > fitnessThreshold && matchFitness4 > fitnessThreshold && matchFitness5 > fitnessThreshold && matchFitness6 > fitnessThreshold)
-																{
-																	i8 = i7;
-																	for (++i8; i8 != userMap.end(); ++i8)
-																	{
-																		u8 = i8->second;
-																		if (u8->status != STATUS_WORKING)
-																			continue;
-
-																		double matchFitness1 = computeMatchFitness(i1->first, u1, i8->first, u8);
-																		double matchFitness2 = computeMatchFitness(i2->first, u2, i8->first, u8);
-																		double matchFitness3 = computeMatchFitness(i3->first, u3, i8->first, u8);
-																		double matchFitness4 = computeMatchFitness(i4->first, u4, i8->first, u8);
-																		double matchFitness5 = computeMatchFitness(i5->first, u5, i8->first, u8);
-																		double matchFitness6 = computeMatchFitness(i6->first, u6, i8->first, u8);
-																		double matchFitness7 = computeMatchFitness(i7->first, u7, i8->first, u8);
-																		MapBitSet tmp = MapSetUnion(u1->maps, u2->maps);
-																		tmp = MapSetUnion(tmp, u3->maps);
-																		tmp = MapSetUnion(tmp, u4->maps);
-																		tmp = MapSetUnion(tmp, u5->maps);
-																		tmp = MapSetUnion(tmp, u6->maps);
-																		tmp = MapSetUnion(tmp, u7->maps);
-																		tmp = MapSetUnion(tmp, u8->maps);
-																		if (MapSetCount(tmp) && matchFitness1 > fitnessThreshold && matchFitness2 > fitnessThreshold && matchFitness3 > fitnessThreshold && matchFitness4 > fitnessThreshold && matchFitness5 > fitnessThreshold && matchFitness6 > fitnessThreshold && matchFitness7 > fitnessThreshold)
-																		{
-																			// match 8 players
-																			sendMatchInfo(i1->first, i2->first, i3->first, i4->first, i5->first, i6->first, i7->first, i8->first,
-																			              u1, u2, u3, u4, u5, u6, u7, u8, 8, ladderID);
-																			break;
-																		}
-																	}
-																}
-															}
-
-														}
-													}
-												}
-											}
-										}
-
-									}
-								}
-							}
-						}
-					}
-				}
-			}
-		}
+	// GeneralsX @performance 18/10/2026 Look for matches with the bucketed match finder instead of
+	// one nested loop per player, and send all matches found instead of only the first 1v1.
+	m_matches.clear();
+	m_matchFinder.findMatches(userMap, numPlayers, m_matches);
 
-		if (bestUser && numPlayers == 2)
+	for (int i=0; i<(int)m_matches.size(); ++i)
+	{
+		const GeneralsMatch& match = m_matches[i];
+		if (match.numPlayers == 2)
 		{
-			// we had a match.  send the info.
-			DBGMSG("Matching " << i1->first << " with " << bestName << ":"
-			       "\tmatch fitness: " << bestMatchFitness << "\n"
+			GeneralsUser *bestUser = match.users[1];
+			u1 = match.users[0];
+			DBGMSG("Matching " << match.names[0] << " with " << match.names[1] << ":"
+			       "\tmatch fitness: " << match.fitness << "\n"
 			       "\tpoint percentage: " << (1-bestUser->points/(double)u1->points)*100 << "\n"
-			       "\tpoints: " << u1->points << ", " << u2->points << "\n"
+			       "\tpoints: " << u1->points << ", " << bestUser->points << "\n"
 			       "\tping in ms: " << sqrt(1000000 * calcPingDelta(u1, bestUser) / (255*255*2)) << "\n"
 			       "\tprevious attempts: " << u1->widened << ", " << bestUser->widened);
-			sendMatchInfo(i1->first, bestName, "", "", "", "", "", "",
-			              u1, bestUser, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, 2, ladderID);
-			break;
 		}
+
+		GeneralsUser *users[GeneralsMatch::MAX_PLAYERS];
+		for (int p=0; p<GeneralsMatch::MAX_PLAYERS; ++p)
+			users[p] = (p < match.numPlayers) ? match.users[p] : nullptr;
+
+		sendMatchInfo(match.names[0], match.names[1], match.names[2], match.names[3],
+		              match.names[4], match.names[5], match.names[6], match.names[7],
+		              users[0], users[1], users[2], users[3], users[4], users[5], users[6], users[7],
+		              match.numPlayers, ladderID);
 	}
 
 	dumpUsers();
@@ -25,6 +25,7 @@
 //#include <dictionary.h>
 //#include <arraylist.h>
 #include "matcher.h"
+#include "matchfinder.h"
 #include "global.h"
 
 #include <string>
@@ -33,62 +34,10 @@
 #include <map>
 #include <Utility/hash_map_adapter.h>
 
-typedef std::vector<bool> MapBitSet;
-
-// =====================================================================
-// Users
-// =====================================================================
-
-// Here are the states a matcher can be in:
-typedef enum
-{
-    STATUS_INVAL = 0,
-    STATUS_INCHANNEL,  // Just entered the channel
-    STATUS_WORKING,    // Sent info, needs to be matched
-    STATUS_MATCHED,    // Been matched, but is still in the channel
-} UserStatus;
-
-class GeneralsUser
-{
-public:
-	GeneralsUser();
-	UserStatus status;
-
-	int points, minPoints, maxPoints;
-
-	int discons, maxDiscons;
-
-	int country;
-	int color;
-
-	bool widened;
-	time_t timeToWiden;
-	time_t matchStart; // when did we request a match?
-
-	// This is a ping to a designated 3rd-party server who just
-	// responds to pings.  The idea is that if the game server is
-	// behind a firewall, the client will have a 1000ms ping to it,
-	// even though he might be very close.  To combat this, we have
-	// clients & servers ping some 3rd-party servers & calculate a
-	// pesudo-ping based on the sum of pings server-->3rd-->client.
-	std::vector<int> pseudoPing;
-	int maxPing;
-
-	unsigned int IP;
-	int NAT;
-
-	MapBitSet maps;
-
-	int numPlayers;
-};
-
 // =====================================================================
 // Matcher class
 // =====================================================================
 
-typedef std::map<std::string, GeneralsUser*> UserMap;
-typedef std::map<int, UserMap> LadderMap;
-
 class GeneralsMatcher : public MatcherClass
 {
 public:
@@ -115,8 +64,6 @@ private:
 	UserMap m_nonLadderUsers4v4;
 	UserMap m_nonMatchingUsers;
 
-	double computeMatchFitness(const std::string& i1, const GeneralsUser *u1, const std::string& i2, const GeneralsUser *u2);
-
 	GeneralsUser* findUser(const std::string& who);
 	GeneralsUser* findUserInLadder(const std::string& who, int ladderID);
 	GeneralsUser* findUserInAnyLadder(const std::string& who);
@@ -155,6 +102,9 @@ private:
 	int weightAvgPoints;
 	int totalWeight;
 
+	GeneralsMatchFinder m_matchFinder;
+	MatchList m_matches;
+
 	time_t m_nextPoolSizeAnnouncement;
 	int m_secondsBetweenPoolSizeAnnouncements;
 
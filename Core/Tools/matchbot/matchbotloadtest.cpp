@@ -0,0 +1,401 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// matchbotloadtest.cpp : Load test for the GeneralsMatchFinder.
+//
+// First checks the finder against a copy of the nested loops it replaced on
+// many small random pools, then feeds thousands of simulated players through
+// the 1v1, 2v2, 3v3 and 4v4 pools and reports how many matches the finder
+// makes per second and how long the players waited.
+//
+// Usage: matchbotloadtest [players per minute] [minutes]
+
+#include "matchfinder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+static const int NumMaps = 24;
+static const int NumPingServers = 3;
+static const int TeamSizes[] = { 2, 4, 6, 8 };
+static const int NumTeamSizes = sizeof(TeamSizes) / sizeof(TeamSizes[0]);
+static const int GiveUpSeconds = 300;
+
+// =====================================================================
+// Simulated players
+// =====================================================================
+
+class RandomSource
+{
+public:
+	RandomSource(unsigned int seed) : m_seed(seed) { }
+
+	int Int(int low, int high)
+	{
+		m_seed = m_seed * 1664525 + 1013904223;
+		return low + (int)((m_seed >> 8) % (unsigned int)(high - low + 1));
+	}
+
+private:
+	unsigned int m_seed;
+};
+
+// A player the way the game describes himself in the CINFO message.  The
+// game sends its point range in percent, like PointsMin 50 and PointsMax 200.
+static void makeUser(RandomSource& rnd, GeneralsUser& user, time_t now)
+{
+	user.status = STATUS_WORKING;
+	user.points = rnd.Int(0, 3) ? rnd.Int(1, 400) : rnd.Int(400, 5000);
+	user.minPoints = rnd.Int(50, 100);
+	user.maxPoints = rnd.Int(100, 200);
+	user.discons = rnd.Int(0, 2) ? 0 : rnd.Int(1, 10);
+	user.maxDiscons = rnd.Int(0, 10);
+	user.maxPing = rnd.Int(100, 400);
+	user.widened = false;
+	user.timeToWiden = rnd.Int(0, 4) ? now + rnd.Int(10, 120) : 0;
+	user.matchStart = now;
+
+	user.pseudoPing.clear();
+	for (int i=0; i<NumPingServers; ++i)
+		user.pseudoPing.push_back(rnd.Int(10, 255));
+
+	user.maps.clear();
+	for (int m=0; m<NumMaps; ++m)
+		user.maps.push_back(rnd.Int(0, 2) != 0);
+}
+
+static void widen(GeneralsUser& user)
+{
+	user.timeToWiden = 0;
+	user.widened = true;
+	for (int m=0; m<(int)user.maps.size(); ++m)
+		user.maps[m] = 1;
+}
+
+// =====================================================================
+// The nested loops of the old GeneralsMatcher::checkMatchesInUserMap
+// =====================================================================
+
+typedef std::vector<UserMap::iterator> UserIterators;
+
+static bool oldExtendGroup(const GeneralsMatchFinder& finder, UserMap& userMap, UserIterators& group,
+                           int numPlayers, const MapBitSet& maps)
+{
+	UserMap::iterator it = group.back();
+	for (++it; it != userMap.end(); ++it)
+	{
+		GeneralsUser *user = it->second;
+		if (user->status != STATUS_WORKING)
+			continue;
+
+		bool fits = true;
+		for (int i=0; i<(int)group.size() && fits; ++i)
+			fits = finder.computeMatchFitness(group[i]->second, user) > GeneralsMatchFinder::FitnessThreshold;
+		if (!fits)
+			continue;
+
+		// the old loops only checked the common maps from the third player on
+		MapBitSet tmp = MapSetUnion(maps, user->maps);
+		if (group.size() >= 2 && !MapSetCount(tmp))
+			continue;
+
+		group.push_back(it);
+		if ((int)group.size() == numPlayers || oldExtendGroup(finder, userMap, group, numPlayers, tmp))
+			return true;
+		group.pop_back();
+	}
+	return false;
+}
+
+static void oldCheckMatches(const GeneralsMatchFinder& finder, UserMap& userMap, int numPlayers, MatchList& matches)
+{
+	for (UserMap::iterator i1 = userMap.begin(); i1 != userMap.end(); ++i1)
+	{
+		GeneralsUser *u1 = i1->second;
+		if (u1->status != STATUS_WORKING)
+			continue;
+
+		GeneralsMatch match;
+		match.numPlayers = numPlayers;
+		match.fitness = 0.0;
+
+		if (numPlayers == 2)
+		{
+			UserMap::iterator best = userMap.end();
+			double bestMatchFitness = 0.0;
+			UserMap::iterator i2 = i1;
+			for (++i2; i2 != userMap.end(); ++i2)
+			{
+				if (i2->second->status != STATUS_WORKING)
+					continue;
+				double matchFitness = finder.computeMatchFitness(u1, i2->second);
+				if (matchFitness > GeneralsMatchFinder::FitnessThreshold && matchFitness > bestMatchFitness)
+				{
+					bestMatchFitness = matchFitness;
+					best = i2;
+				}
+			}
+			if (best == userMap.end())
+				continue;
+
+			match.names[0] = i1->first;
+			match.users[0] = u1;
+			match.names[1] = best->first;
+			match.users[1] = best->second;
+			match.fitness = bestMatchFitness;
+		}
+		else
+		{
+			UserIterators group;
+			group.push_back(i1);
+			if (!oldExtendGroup(finder, userMap, group, numPlayers, u1->maps))
+				continue;
+
+			for (int i=0; i<numPlayers; ++i)
+			{
+				match.names[i] = group[i]->first;
+				match.users[i] = group[i]->second;
+			}
+		}
+
+		for (int i=0; i<numPlayers; ++i)
+			match.users[i]->status = STATUS_MATCHED;
+		matches.push_back(match);
+
+		// the old loops stopped after the first 1v1 match
+		if (numPlayers == 2)
+			break;
+	}
+}
+
+// =====================================================================
+// Small pools, old and new have to agree
+// =====================================================================
+
+static void makePool(RandomSource& rnd, std::vector<GeneralsUser>& users, UserMap& userMap, int size)
+{
+	users.resize(size);
+	for (int i=0; i<size; ++i)
+	{
+		makeUser(rnd, users[i], 0);
+
+		// mostly point ranges as ratios, so the rating bands get used
+		if (rnd.Int(0, 3))
+		{
+			users[i].minPoints = rnd.Int(0, 1);
+			users[i].maxPoints = rnd.Int(1, 4);
+		}
+		if (!rnd.Int(0, 3))
+			widen(users[i]);
+		if (!rnd.Int(0, 7))
+			users[i].pseudoPing[rnd.Int(0, NumPingServers - 1)] = 0;
+		users[i].status = rnd.Int(0, 9) ? STATUS_WORKING : STATUS_MATCHED;
+	}
+
+	userMap.clear();
+	for (int i=0; i<size; ++i)
+	{
+		char name[32];
+		snprintf(name, sizeof(name), "player%d", rnd.Int(0, 99999));
+		userMap[name] = &users[i];
+	}
+}
+
+static bool sameMatches(const MatchList& a, const MatchList& b)
+{
+	if (a.size() != b.size())
+		return false;
+	for (size_t i=0; i<a.size(); ++i)
+	{
+		if (a[i].numPlayers != b[i].numPlayers)
+			return false;
+		for (int p=0; p<a[i].numPlayers; ++p)
+		{
+			if (a[i].names[p] != b[i].names[p])
+				return false;
+		}
+	}
+	return true;
+}
+
+static bool checkSmallPools()
+{
+	RandomSource rnd(12345);
+	int pools = 0;
+	int matches = 0;
+
+	for (int trial=0; trial<4000; ++trial)
+	{
+		GeneralsMatchFinder finder;
+		finder.setWeights(rnd.Int(0, 10), rnd.Int(0, 10));
+
+		int numPlayers = TeamSizes[trial % NumTeamSizes];
+		int size = rnd.Int(numPlayers, numPlayers == 2 ? 40 : 16);
+
+		unsigned int seed = rnd.Int(0, 0x7fffffff);
+		std::vector<GeneralsUser> oldUsers, newUsers;
+		UserMap oldMap, newMap;
+		RandomSource oldRnd(seed), newRnd(seed);
+		makePool(oldRnd, oldUsers, oldMap, size);
+		makePool(newRnd, newUsers, newMap, size);
+
+		MatchList oldMatches, newMatches;
+		oldCheckMatches(finder, oldMap, numPlayers, oldMatches);
+		finder.findMatches(newMap, numPlayers, newMatches);
+
+		// the old loops made one 1v1 match per call
+		if (numPlayers == 2 && newMatches.size() > 1)
+			newMatches.resize(1);
+
+		if (!sameMatches(oldMatches, newMatches))
+		{
+			printf("FAILED: pool %d with %d users waiting for %d player games got different matches\n", trial, size, numPlayers);
+			return false;
+		}
+
+		++pools;
+		matches += (int)oldMatches.size();
+	}
+
+	printf("%d small pools, %d matches, same as the old nested loops\n", pools, matches);
+	return true;
+}
+
+// =====================================================================
+// Load
+// =====================================================================
+
+static double percentile(std::vector<int>& values, double p)
+{
+	if (values.empty())
+		return 0.0;
+	std::sort(values.begin(), values.end());
+	size_t i = (size_t)(p * (values.size() - 1) + 0.5);
+	return values[i];
+}
+
+int main(int argc, char* argv[])
+{
+	if (!checkSmallPools())
+		return 1;
+
+	int playersPerMinute = argc > 1 ? atoi(argv[1]) : 1000;
+	int minutes = argc > 2 ? atoi(argv[2]) : 20;
+	if (playersPerMinute <= 0 || minutes <= 0)
+	{
+		printf("Usage: matchbotloadtest [players per minute] [minutes]\n");
+		return 1;
+	}
+
+	GeneralsMatchFinder finder;
+	finder.setWeights(1, 1);
+
+	RandomSource rnd(54321);
+	UserMap pools[NumTeamSizes];
+	std::vector<int> waits[NumTeamSizes];
+	int nextPlayer = 0;
+	int players = 0;
+	int gaveUp[NumTeamSizes] = { 0 };
+	int matchCount = 0;
+	int largestPool = 0;
+	double matcherTime = 0.0;
+	MatchList matches;
+
+	// One check per simulated second, like the matchbot's loop
+	const int seconds = minutes * 60;
+	for (time_t now = 1; now <= seconds; ++now)
+	{
+		int arrivals = playersPerMinute / 60 + (rnd.Int(0, 59) < playersPerMinute % 60 ? 1 : 0);
+		for (int i=0; i<arrivals; ++i)
+		{
+			GeneralsUser *user = new GeneralsUser;
+			makeUser(rnd, *user, now);
+			int team = rnd.Int(0, 9) < 6 ? 0 : rnd.Int(1, NumTeamSizes - 1);
+			user->numPlayers = TeamSizes[team];
+
+			char name[32];
+			snprintf(name, sizeof(name), "player%08d", (nextPlayer++ * 7919) % 100000000);
+			pools[team][name] = user;
+			++players;
+		}
+
+		for (int team=0; team<NumTeamSizes; ++team)
+		{
+			UserMap& pool = pools[team];
+			largestPool = std::max(largestPool, (int)pool.size());
+
+			for (UserMap::iterator it = pool.begin(); it != pool.end(); )
+			{
+				GeneralsUser *user = it->second;
+				if (now - user->matchStart > GiveUpSeconds)
+				{
+					// nobody to play with, he leaves the channel
+					++gaveUp[team];
+					delete user;
+					pool.erase(it++);
+					continue;
+				}
+				if (user->timeToWiden && user->timeToWiden < now)
+					widen(*user);
+				++it;
+			}
+
+			matches.clear();
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			finder.findMatches(pool, TeamSizes[team], matches);
+			std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+			matcherTime += std::chrono::duration<double>(end - start).count();
+
+			// matched players leave the channel
+			for (size_t m=0; m<matches.size(); ++m)
+			{
+				for (int p=0; p<matches[m].numPlayers; ++p)
+				{
+					GeneralsUser *user = matches[m].users[p];
+					waits[team].push_back((int)(now - user->matchStart));
+					pool.erase(matches[m].names[p]);
+					delete user;
+				}
+			}
+			matchCount += (int)matches.size();
+		}
+	}
+
+	printf("%d players over %d minutes, largest pool %d\n", players, minutes, largestPool);
+	printf("%d matches in %.3f s of matching, %.0f matches per second\n", matchCount, matcherTime,
+	       matcherTime > 0.0 ? matchCount / matcherTime : 0.0);
+
+	for (int team=0; team<NumTeamSizes; ++team)
+	{
+		int left = (int)pools[team].size();
+		int matched = (int)waits[team].size();
+		printf("%dv%d: %d matched, %d gave up, %d still waiting, wait p50 %.0f s, p90 %.0f s, p99 %.0f s, max %.0f s\n",
+		       TeamSizes[team] / 2, TeamSizes[team] / 2, matched, gaveUp[team], left,
+		       percentile(waits[team], 0.5), percentile(waits[team], 0.9), percentile(waits[team], 0.99),
+		       percentile(waits[team], 1.0));
+
+		for (UserMap::iterator it = pools[team].begin(); it != pools[team].end(); ++it)
+			delete it->second;
+	}
+
+	return 0;
+}
@@ -0,0 +1,894 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "matchfinder.h"
+
+#include <algorithm>
+#include <cmath>
+
+MapBitSet MapSetUnion(const MapBitSet& a, const MapBitSet& b)
+{
+	MapBitSet c;
+	if (a.size() != b.size())
+		return c;
+
+	for (int i=0; i<(int)a.size(); ++i)
+	{
+		c.push_back(a[i] && b[i]);
+	}
+
+	return c;
+}
+
+int MapSetCount(const MapBitSet& a)
+{
+	int count=0;
+	for (int i=0; i<(int)a.size(); ++i)
+	{
+		//DBGMSG(a[i]);
+		if (a[i])
+			++count;
+	}
+	return count;
+}
+
+// Same as MapSetCount(MapSetUnion(a, b)) != 0, without building the set
+static bool haveCommonMap(const MapBitSet& a, const MapBitSet& b)
+{
+	if (a.size() != b.size())
+		return false;
+
+	for (int i=0; i<(int)a.size(); ++i)
+	{
+		if (a[i] && b[i])
+			return true;
+	}
+	return false;
+}
+
+// =====================================================================
+// Users
+// =====================================================================
+
+GeneralsUser::GeneralsUser()
+{
+	status = STATUS_INCHANNEL;
+	points = 1;
+	minPoints = maxPoints = 100;
+	country = color = -1;
+	pseudoPing.clear();
+	matchStart = time(nullptr);
+	timeToWiden = 0;
+	widened = false;
+	numPlayers = 2;
+	discons = maxDiscons = 2;
+	maps.clear();
+	maxPing = 1000;
+}
+
+int calcPingDelta(const GeneralsUser *a, const GeneralsUser *b)
+{
+	if (!a || !b || a->pseudoPing.size() != b->pseudoPing.size())
+		return MaxPingValue; // Max ping
+
+	int bestPing = MaxPingValue;
+	for (int i=0; i<(int)a->pseudoPing.size(); ++i)
+	{
+		int p1, p2;
+		p1 = a->pseudoPing[i];
+		p2 = b->pseudoPing[i];
+
+		if (p1 * p1 + p2 * p2 < bestPing)
+			bestPing = p1 * p1 + p2 * p2;
+	}
+
+	return (int)sqrt(bestPing);
+}
+
+// =====================================================================
+// Match finder
+// =====================================================================
+
+const double GeneralsMatchFinder::FitnessThreshold = 0.3;
+
+// Four rating bands per doubling of the points.  Bands only decide which
+// users get compared, the point range checks themselves are done by
+// computeMatchFitness, so the band edges need not be exact.
+static const double BandsPerDoubling = 4.0;
+
+// How many fit table lookups one group search may do.  Only huge pools get
+// there, and the seed is tried again next time.
+static const size_t MaxGroupWork = 1 << 22;
+
+namespace
+{
+	template <typename Candidates>
+	struct CandidatePointsLess
+	{
+		explicit CandidatePointsLess(const Candidates& c) : candidates(&c) {}
+		bool operator()(int a, int b) const
+		{
+			int pointsA = (*candidates)[a].points;
+			int pointsB = (*candidates)[b].points;
+			return pointsA < pointsB || (pointsA == pointsB && a < b);
+		}
+		const Candidates *candidates;
+	};
+}
+
+// Slack for the rounding of the band edges and of the fitness bounds
+static const double BoundSlack = 1e-9;
+
+GeneralsMatchFinder::GeneralsMatchFinder()
+{
+	setWeights(0, 0);
+	m_pool = nullptr;
+	m_stamp = 0;
+	m_groupWork = 0;
+	m_groupCut = false;
+}
+
+void GeneralsMatchFinder::setWeights(int weightLowPing, int weightAvgPoints)
+{
+	m_weightLowPing = weightLowPing;
+	m_weightAvgPoints = weightAvgPoints;
+	m_totalWeight = weightLowPing + weightAvgPoints;
+
+	// users that did not fit before might now
+	m_pools.clear();
+}
+
+void GeneralsMatchFinder::KnownUser::set(const GeneralsUser *user)
+{
+	points = user->points;
+	minPoints = user->minPoints;
+	maxPoints = user->maxPoints;
+	discons = user->discons;
+	maxDiscons = user->maxDiscons;
+	widened = user->widened;
+	pseudoPing = user->pseudoPing;
+	maxPing = user->maxPing;
+	maps = user->maps;
+}
+
+bool GeneralsMatchFinder::KnownUser::isSame(const GeneralsUser *user) const
+{
+	return points == user->points && minPoints == user->minPoints && maxPoints == user->maxPoints
+		&& discons == user->discons && maxDiscons == user->maxDiscons && widened == user->widened
+		&& maxPing == user->maxPing && pseudoPing == user->pseudoPing && maps == user->maps;
+}
+
+double GeneralsMatchFinder::computeMatchFitness(const GeneralsUser *u1, const GeneralsUser *u2) const
+{
+	if (u1->status != STATUS_WORKING || u2->status != STATUS_WORKING)
+		return 0.0;
+
+	// see if they pinged the same # of servers (sanity).
+	if (u1->pseudoPing.size() != u2->pseudoPing.size())
+		return 0.0;
+
+	// check point percentage ranges
+	int p1 = std::max(1,u1->points), p2 = std::max(1,u2->points);
+	double p1percent = (double)p2/(double)p1;
+	double p2percent = (double)p1/(double)p2;
+	if (!u1->widened && ( p1percent < u1->minPoints || p1percent > u1->maxPoints ))
+		return 0.0;
+
+	if (!u2->widened && ( p2percent < u2->minPoints || p2percent > u2->maxPoints ))
+		return 0.0;
+
+
+	int minP = std::min(p1, p2);
+	int maxP = std::max(p1, p2);
+	double pointPercent = (double)minP/(double)maxP;
+
+	// check pings
+	int pingDelta = calcPingDelta(u1, u2);
+	if (!u1->widened && pingDelta > u1->maxPing)
+		return 0.0;
+	if (!u2->widened && pingDelta > u2->maxPing)
+		return 0.0;
+
+	// check discons
+	if (u1->maxDiscons && (!u1->widened && u2->discons > u1->maxDiscons))
+		return 0.0;
+	if (u2->maxDiscons && (!u2->widened && u1->discons > u2->maxDiscons))
+		return 0.0;
+
+	if (!haveCommonMap(u1->maps, u2->maps))
+		return 0.0;
+
+	// they have something in common.  calculate match fitness.
+	double matchFitness = ( m_weightAvgPoints * (1-pointPercent) +
+	                        m_weightLowPing * (MaxPingValue - pingDelta)/MaxPingValue ) / (double)m_totalWeight;
+
+	return matchFitness;
+}
+
+int GeneralsMatchFinder::bandForPoints(double points)
+{
+	if (points < 1.0)
+		return 0;
+	return (int)floor(log(points) / log(2.0) * BandsPerDoubling);
+}
+
+double GeneralsMatchFinder::bandLowPoints(int band)
+{
+	return pow(2.0, band / BandsPerDoubling);
+}
+
+// The best fitness two users from these bands could have.  The point part of
+// the fitness grows with the difference in points, which is largest between
+// the outer band edges.  The ping part is integer math, so it only reaches
+// weightLowPing for a ping of 0, which needs both users to have a 0 ping to
+// the same server.
+double GeneralsMatchFinder::fitnessBound(int band1, int band2, bool zeroPing) const
+{
+	if (m_weightLowPing < 0 || m_weightAvgPoints < 0 || m_totalWeight <= 0)
+		return HUGE_VAL; // no bound for odd weights
+
+	double lowest = bandLowPoints(std::min(band1, band2));
+	double highest = bandLowPoints(std::max(band1, band2) + 1);
+	double pointPercent = std::max(1.0, lowest) / highest;
+
+	int pingDelta = zeroPing ? 0 : 1;
+	return ( m_weightAvgPoints * (1-pointPercent) +
+	         m_weightLowPing * (MaxPingValue - pingDelta)/MaxPingValue ) / (double)m_totalWeight + BoundSlack;
+}
+
+void GeneralsMatchFinder::buildIndex(UserMap& userMap, int numPlayers)
+{
+	std::pair<PoolMap::iterator, bool> inserted = m_pools.insert(PoolMap::value_type(&userMap, Pool()));
+	m_pool = &inserted.first->second;
+	if (inserted.second)
+	{
+		m_pool->slotCount = 0;
+		m_pool->slotCapacity = 0;
+	}
+	KnownUserMap& known = m_pool->users;
+	KnownUserMap::iterator knownIt = known.begin();
+
+	m_candidates.clear();
+	m_newCandidates.clear();
+	for (size_t b=0; b<m_bands.size(); ++b)
+	{
+		RatingBand& band = m_bands[b];
+		band.widened.clear();
+		band.narrow.clear();
+		band.partnerLow = HUGE_VAL;
+		band.partnerHigh = -HUGE_VAL;
+		band.zeroPing = false;
+	}
+
+	for (UserMap::iterator it = userMap.begin(); it != userMap.end(); ++it)
+	{
+		GeneralsUser *user = it->second;
+		if (user->status != STATUS_WORKING)
+			continue;
+
+		Candidate c;
+		c.name = &it->first;
+		c.user = user;
+		c.points = std::max(1, user->points);
+		c.band = bandForPoints(c.points);
+		c.zeroPing = std::find(user->pseudoPing.begin(), user->pseudoPing.end(), 0) != user->pseudoPing.end();
+		c.mapMask = 0;
+		for (int m=0; m<(int)user->maps.size(); ++m)
+		{
+			if (user->maps[m])
+				c.mapMask |= 1u << (m & 31);
+		}
+
+		// both maps are sorted by name, the known users that are gone free their slot
+		while (knownIt != known.end() && knownIt->first < it->first)
+		{
+			m_pool->freeSlots.push_back(knownIt->second.slot);
+			known.erase(knownIt++);
+		}
+		if (knownIt != known.end() && knownIt->first == it->first)
+		{
+			c.refit = !knownIt->second.isSame(user);
+			c.isNew = c.refit || !knownIt->second.settled;
+			c.known = knownIt++;
+		}
+		else
+		{
+			c.refit = true;
+			c.isNew = true;
+			c.known = known.insert(knownIt, KnownUserMap::value_type(it->first, KnownUser()));
+			if (m_pool->freeSlots.empty())
+			{
+				c.known->second.slot = m_pool->slotCount++;
+			}
+			else
+			{
+				c.known->second.slot = m_pool->freeSlots.back();
+				m_pool->freeSlots.pop_back();
+			}
+		}
+		if (c.refit)
+			c.known->second.set(user);
+		c.slot = c.known->second.slot;
+		c.known->second.settled = false;
+		c.searchCut = false;
+		if (c.isNew)
+			m_newCandidates.push_back((int)m_candidates.size());
+
+		if (c.band >= (int)m_bands.size())
+		{
+			RatingBand empty;
+			empty.partnerLow = HUGE_VAL;
+			empty.partnerHigh = -HUGE_VAL;
+			empty.zeroPing = false;
+			m_bands.resize(c.band + 1, empty);
+		}
+
+		RatingBand& band = m_bands[c.band];
+		if (user->widened)
+		{
+			band.widened.push_back((int)m_candidates.size());
+		}
+		else
+		{
+			band.narrow.push_back((int)m_candidates.size());
+			if (user->minPoints <= user->maxPoints)
+			{
+				band.partnerLow = std::min(band.partnerLow, (double)c.points * user->minPoints);
+				band.partnerHigh = std::max(band.partnerHigh, (double)c.points * user->maxPoints);
+			}
+		}
+		band.zeroPing = band.zeroPing || c.zeroPing;
+		m_candidates.push_back(c);
+	}
+
+	while (knownIt != known.end())
+	{
+		m_pool->freeSlots.push_back(knownIt->second.slot);
+		known.erase(knownIt++);
+	}
+
+	// 1v1 looks for the best fitness, not just for who fits
+	if (numPlayers > 2)
+	{
+		buildFitTable();
+		m_stamps.assign(m_candidates.size(), 0);
+		m_stamp = 0;
+	}
+}
+
+// Work out who fits whom for the users who are new or changed.  Everybody
+// else still fits the same users as in the last call.
+void GeneralsMatchFinder::buildFitTable()
+{
+	Pool& pool = *m_pool;
+	if (pool.slotCount > pool.slotCapacity)
+	{
+		int oldCapacity = pool.slotCapacity;
+		int oldWords = (oldCapacity + 31) / 32;
+		std::vector<unsigned int> oldFits;
+		oldFits.swap(pool.fits);
+
+		pool.slotCapacity = std::max(pool.slotCount, oldCapacity * 2);
+		int words = (pool.slotCapacity + 31) / 32;
+		pool.fits.assign((size_t)pool.slotCapacity * words, 0);
+		for (int slot=0; slot<oldCapacity; ++slot)
+			std::copy(oldFits.begin() + (size_t)slot * oldWords, oldFits.begin() + (size_t)(slot + 1) * oldWords,
+			          pool.fits.begin() + (size_t)slot * words);
+	}
+
+	size_t words = (pool.slotCapacity + 31) / 32;
+	for (size_t i=0; i<m_candidates.size(); ++i)
+	{
+		const Candidate& c = m_candidates[i];
+		if (!c.refit)
+			continue;
+
+		int slot = c.slot;
+		unsigned int *row = &pool.fits[slot * words];
+		for (size_t j=0; j<m_candidates.size(); ++j)
+		{
+			const Candidate& other = m_candidates[j];
+			if (other.refit && j < i)
+				continue; // done with his row
+
+			int otherSlot = other.slot;
+			bool fit = j != i && (c.mapMask & other.mapMask) && computeMatchFitness(c.user, other.user) > FitnessThreshold;
+			unsigned int *otherRow = &pool.fits[otherSlot * words];
+			if (fit)
+			{
+				row[otherSlot / 32] |= 1u << (otherSlot % 32);
+				otherRow[slot / 32] |= 1u << (slot % 32);
+			}
+			else
+			{
+				row[otherSlot / 32] &= ~(1u << (otherSlot % 32));
+				otherRow[slot / 32] &= ~(1u << (slot % 32));
+			}
+		}
+	}
+}
+
+// Same as computeMatchFitness > FitnessThreshold in group pools, users that
+// got matched in this call fit nobody
+bool GeneralsMatchFinder::fits(int candidate1, int candidate2) const
+{
+	const Candidate& c1 = m_candidates[candidate1];
+	const Candidate& c2 = m_candidates[candidate2];
+	if (c1.user->status != STATUS_WORKING || c2.user->status != STATUS_WORKING)
+		return false;
+
+	return fitsInRow(fitRow(candidate1), c2.slot);
+}
+
+const unsigned int *GeneralsMatchFinder::fitRow(int candidate) const
+{
+	size_t words = (m_pool->slotCapacity + 31) / 32;
+	return &m_pool->fits[m_candidates[candidate].slot * words];
+}
+
+// Remember who is left waiting.  Any two of them that could have been
+// matched were, so they can only fit somebody new next time.  A user whose
+// group search was cut short stays new, so it is done again next time.
+void GeneralsMatchFinder::settlePool()
+{
+	for (size_t i=0; i<m_candidates.size(); ++i)
+	{
+		const Candidate& c = m_candidates[i];
+		if (c.user->status == STATUS_WORKING)
+		{
+			c.known->second.settled = !c.searchCut;
+		}
+		else
+		{
+			m_pool->freeSlots.push_back(c.known->second.slot);
+			m_pool->users.erase(c.known);
+		}
+	}
+	m_pool = nullptr;
+}
+
+// The bands that can hold a partner for seed.  Unless he widened his search,
+// a partner needs points between minPoints and maxPoints times his own.
+void GeneralsMatchFinder::collectBands(const Candidate& seed, std::vector<int>& bands) const
+{
+	bands.clear();
+
+	int lowBand = 0;
+	int highBand = (int)m_bands.size() - 1;
+	if (!seed.user->widened)
+	{
+		double lowPoints = (double)seed.points * seed.user->minPoints;
+		double highPoints = (double)seed.points * seed.user->maxPoints;
+		if (highPoints < 1.0 || lowPoints > highPoints)
+			return;
+
+		// one band of margin on both sides for rounding
+		lowBand = std::max(lowBand, bandForPoints(lowPoints) - 1);
+		highBand = std::min(highBand, bandForPoints(highPoints) + 1);
+	}
+
+	for (int b=lowBand; b<=highBand; ++b)
+	{
+		const RatingBand& band = m_bands[b];
+		if (band.widened.empty() && !acceptsNarrow(band, seed))
+			continue;
+		if (fitnessBound(seed.band, b, seed.zeroPing && band.zeroPing) <= FitnessThreshold)
+			continue;
+		bands.push_back(b);
+	}
+}
+
+// Can any of the users in the band that did not widen their search take the seed?
+bool GeneralsMatchFinder::acceptsNarrow(const RatingBand& band, const Candidate& seed) const
+{
+	if (band.narrow.empty())
+		return false;
+
+	double points = seed.points;
+	return points >= band.partnerLow * (1 - BoundSlack) && points <= band.partnerHigh * (1 + BoundSlack);
+}
+
+// How many of these candidates could at most be in one group.  Two users can
+// only beat the fitness threshold if their points are far enough apart, so a
+// group is a chain of users with points that far apart from the next.  The
+// longest such chain is found by always taking the next user that is, and
+// doing that from both ends gives it for every prefix and suffix of the
+// sorted points, which bounds the group through any one more user.  The
+// candidates come sorted by points.
+void GeneralsMatchFinder::buildChains(const std::vector<int>& byPoints, PointChains& chains) const
+{
+	chains.points.clear();
+	chains.up.clear();
+	chains.down.clear();
+	chains.longest = (int)byPoints.size();
+	chains.maxPointPercent = HUGE_VAL;
+
+	if (m_weightLowPing < 0 || m_weightAvgPoints <= 0 || m_totalWeight <= 0)
+		return; // no bound for odd weights
+
+	bool zeroPing = false;
+	for (size_t i=0; i<byPoints.size(); ++i)
+	{
+		const Candidate& c = m_candidates[byPoints[i]];
+		chains.points.push_back(c.points);
+		zeroPing = zeroPing || c.zeroPing;
+	}
+
+	// the largest point percentage that can still beat the threshold
+	int pingDelta = zeroPing ? 0 : 1;
+	double pingPart = m_weightLowPing * (MaxPingValue - pingDelta)/MaxPingValue;
+	double maxPointPercent = 1 - (FitnessThreshold * m_totalWeight - pingPart) / m_weightAvgPoints + BoundSlack;
+	if (maxPointPercent > 1.0)
+		return;
+
+	size_t count = chains.points.size();
+
+	// up[i] is the longest chain of the lowest i points
+	chains.up.resize(count + 1);
+	chains.up[0] = 0;
+	int length = 0;
+	double last = 0.0;
+	for (size_t i=0; i<count; ++i)
+	{
+		if (!length || last / chains.points[i] < maxPointPercent)
+		{
+			++length;
+			last = chains.points[i];
+		}
+		chains.up[i + 1] = length;
+	}
+
+	// down[i] is the longest chain of the points from i on
+	chains.down.resize(count + 1);
+	chains.down[count] = 0;
+	length = 0;
+	for (size_t i=count; i-- > 0; )
+	{
+		if (!length || chains.points[i] / last < maxPointPercent)
+		{
+			++length;
+			last = chains.points[i];
+		}
+		chains.down[i] = length;
+	}
+
+	chains.longest = chains.up[count];
+	chains.maxPointPercent = maxPointPercent;
+}
+
+// The longest chain of the sorted points from start to end.  It is at most one
+// longer than what the chain from the lowest points gained there, as that one
+// always takes the next it can.
+int GeneralsMatchFinder::chainBetween(const PointChains& chains, size_t start, size_t end) const
+{
+	if (start >= end)
+		return 0;
+	if (start == 0)
+		return chains.up[end];
+	if (end == chains.points.size())
+		return chains.down[start];
+	return std::min<int>(chains.up[end] - chains.up[start] + 1, (int)(end - start));
+}
+
+// How many of the candidates could at most be in a group with both of these
+// users, who may be the same.  The ones with points below, between and above
+// theirs chain separately, and only within the range both users accept.
+int GeneralsMatchFinder::chainWith(const PointChains& chains, const Candidate& a, const Candidate& b) const
+{
+	if (chains.maxPointPercent > 1.0)
+		return chains.longest;
+
+	const std::vector<int>& points = chains.points;
+	double low = std::min(a.points, b.points);
+	double high = std::max(a.points, b.points);
+	double r = chains.maxPointPercent;
+
+	double rangeLow = 0.0;
+	double rangeHigh = HUGE_VAL;
+	const Candidate *pair[2] = { &a, &b };
+	for (int i=0; i<2; ++i)
+	{
+		const GeneralsUser *user = pair[i]->user;
+		if (user->widened)
+			continue;
+		rangeLow = std::max(rangeLow, (double)pair[i]->points * user->minPoints * (1 - BoundSlack));
+		rangeHigh = std::min(rangeHigh, (double)pair[i]->points * user->maxPoints * (1 + BoundSlack));
+	}
+	if (rangeLow > rangeHigh)
+		return 0;
+
+	size_t rangeStart = std::lower_bound(points.begin(), points.end(), rangeLow) - points.begin();
+	size_t rangeEnd = std::upper_bound(points.begin(), points.end(), rangeHigh) - points.begin();
+
+	size_t belowEnd = std::lower_bound(points.begin(), points.end(), low * r) - points.begin();
+	size_t betweenStart = std::upper_bound(points.begin(), points.end(), low / r) - points.begin();
+	size_t betweenEnd = std::lower_bound(points.begin(), points.end(), high * r) - points.begin();
+	size_t aboveStart = std::upper_bound(points.begin(), points.end(), high / r) - points.begin();
+
+	return chainBetween(chains, rangeStart, std::min(belowEnd, rangeEnd))
+		+ chainBetween(chains, std::max(betweenStart, rangeStart), std::min(betweenEnd, rangeEnd))
+		+ chainBetween(chains, std::max(aboveStart, rangeStart), rangeEnd);
+}
+
+bool GeneralsMatchFinder::findPartner(int seed, GeneralsMatch& match)
+{
+	const Candidate& s = m_candidates[seed];
+
+	std::vector<int> bands;
+	collectBands(s, bands);
+
+	// The bands furthest from the seed could give the best fitness, so look at
+	// them first and skip the closer ones that can't beat the best partner yet.
+	int bestIndex = -1;
+	double bestMatchFitness = 0.0;
+	size_t low = 0;
+	size_t high = bands.size();
+	while (low < high)
+	{
+		int b = (s.band - bands[low] >= bands[high - 1] - s.band) ? bands[low++] : bands[--high];
+		const RatingBand& band = m_bands[b];
+		if (fitnessBound(s.band, b, s.zeroPing && band.zeroPing) < bestMatchFitness)
+			continue;
+
+		for (int narrow=0; narrow<2; ++narrow)
+		{
+			if (narrow && !acceptsNarrow(band, s))
+				break;
+
+			const std::vector<int>& users = narrow ? band.narrow : band.widened;
+			for (std::vector<int>::const_iterator it = std::upper_bound(users.begin(), users.end(), seed); it != users.end(); ++it)
+			{
+				const Candidate& c = m_candidates[*it];
+				if ((!s.isNew && !c.isNew) || !(s.mapMask & c.mapMask))
+					continue;
+
+				double matchFitness = computeMatchFitness(s.user, c.user);
+				if (matchFitness <= FitnessThreshold)
+					continue;
+
+				// the old loops kept the first user in map order on a tie
+				if (matchFitness > bestMatchFitness || (matchFitness == bestMatchFitness && *it < bestIndex))
+				{
+					bestMatchFitness = matchFitness;
+					bestIndex = *it;
+				}
+			}
+		}
+	}
+
+	if (bestIndex < 0)
+		return false;
+
+	match.numPlayers = 2;
+	match.names[0] = *s.name;
+	match.users[0] = s.user;
+	match.names[1] = *m_candidates[bestIndex].name;
+	match.users[1] = m_candidates[bestIndex].user;
+	match.fitness = bestMatchFitness;
+	return true;
+}
+
+// m_groupLists[depth] holds the candidates, in map order, that fit all of the
+// group so far.  Picking them in that order finds the group the old loops found.
+bool GeneralsMatchFinder::extendGroup(int depth, int numPlayers)
+{
+	const std::vector<int>& list = m_groupLists[depth];
+
+	// a group of settled users only can't fit together, so without a new
+	// user so far there has to be one left to pick
+	std::vector<size_t>& newUsers = m_groupNewUsers[depth];
+	newUsers.clear();
+	for (size_t i=0; i<list.size(); ++i)
+	{
+		if (m_candidates[list[i]].isNew)
+			newUsers.push_back(i);
+	}
+
+	for (size_t i=0; i + (numPlayers - depth) <= list.size(); ++i)
+	{
+		if (!m_groupHasNew[depth] && (newUsers.empty() || i > newUsers.back()))
+			break;
+
+		const Candidate& c = m_candidates[list[i]];
+		if (!(m_groupMapMask[depth-1] & c.mapMask))
+			continue;
+
+		// enough of the others have to be far enough from him in points
+		if (depth + 1 + chainWith(m_groupChains[depth], c, c) < numPlayers)
+			continue;
+
+		// there has to be a map they all have
+		m_groupMaps[depth] = MapSetUnion(m_groupMaps[depth-1], c.user->maps);
+		if (!MapSetCount(m_groupMaps[depth]))
+			continue;
+
+		m_group[depth] = list[i];
+		m_groupMapMask[depth] = m_groupMapMask[depth-1] & c.mapMask;
+		if (depth + 1 == numPlayers)
+			return true;
+
+		// without a new user so far, one of the new ones after him has to
+		// fit him, and enough others have to fit them both
+		bool hasNew = m_groupHasNew[depth] || c.isNew;
+		if (!hasNew)
+		{
+			bool fitsNew = false;
+			for (std::vector<size_t>::const_iterator it = std::upper_bound(newUsers.begin(), newUsers.end(), i);
+			     it != newUsers.end() && !fitsNew; ++it)
+			{
+				const Candidate& other = m_candidates[list[*it]];
+				fitsNew = depth + 2 + chainWith(m_groupChains[depth], c, other) >= numPlayers
+					&& fits(list[i], list[*it]);
+			}
+			if (!fitsNew)
+				continue;
+		}
+
+		// give up on this seed rather than stall the whole matchbot
+		m_groupWork += list.size() - i;
+		if (m_groupWork > MaxGroupWork)
+		{
+			m_groupCut = true;
+			return false;
+		}
+
+		// the ones that fit him too
+		std::vector<int>& next = m_groupLists[depth + 1];
+		bool nextHasNew = false;
+		next.clear();
+		++m_stamp;
+		const unsigned int *row = fitRow(list[i]); // nobody gets matched during the search
+		for (size_t j=i+1; j<list.size(); ++j)
+		{
+			const Candidate& other = m_candidates[list[j]];
+			if (fitsInRow(row, other.slot))
+			{
+				next.push_back(list[j]);
+				nextHasNew = nextHasNew || other.isNew;
+				m_stamps[list[j]] = m_stamp;
+			}
+		}
+
+		if (!hasNew && !nextHasNew)
+			continue;
+
+		if ((int)next.size() < numPlayers - depth - 1)
+			continue;
+
+		// the same ones sorted by points, taken from this level without sorting
+		const std::vector<int>& byPoints = m_groupByPoints[depth];
+		std::vector<int>& nextByPoints = m_groupByPoints[depth + 1];
+		nextByPoints.clear();
+		for (size_t j=0; j<byPoints.size(); ++j)
+		{
+			if (m_stamps[byPoints[j]] == m_stamp)
+				nextByPoints.push_back(byPoints[j]);
+		}
+
+		buildChains(nextByPoints, m_groupChains[depth + 1]);
+		if (depth + 1 + m_groupChains[depth + 1].longest < numPlayers)
+			continue;
+
+		m_groupHasNew[depth + 1] = hasNew;
+
+		if (extendGroup(depth + 1, numPlayers))
+			return true;
+	}
+
+	return false;
+}
+
+bool GeneralsMatchFinder::findGroup(int seed, int numPlayers, GeneralsMatch& match)
+{
+	const Candidate& s = m_candidates[seed];
+
+	std::vector<int> bands;
+	collectBands(s, bands);
+
+	// a settled seed needs somebody new to play with
+	if (!s.isNew)
+	{
+		bool fitsNew = false;
+		for (std::vector<int>::const_iterator it = std::upper_bound(m_newCandidates.begin(), m_newCandidates.end(), seed);
+		     it != m_newCandidates.end() && !fitsNew; ++it)
+		{
+			fitsNew = fits(seed, *it);
+		}
+		if (!fitsNew)
+			return false;
+	}
+
+	// everybody after the seed who fits him
+	std::vector<int>& list = m_groupLists[1];
+	list.clear();
+	for (size_t i=0; i<bands.size(); ++i)
+	{
+		const RatingBand& band = m_bands[bands[i]];
+		for (int narrow=0; narrow<2; ++narrow)
+		{
+			if (narrow && !acceptsNarrow(band, s))
+				break;
+
+			const std::vector<int>& users = narrow ? band.narrow : band.widened;
+			for (std::vector<int>::const_iterator it = std::upper_bound(users.begin(), users.end(), seed); it != users.end(); ++it)
+			{
+				if (fits(seed, *it))
+					list.push_back(*it);
+			}
+		}
+	}
+
+	if ((int)list.size() < numPlayers - 1)
+		return false;
+
+	std::vector<int>& byPoints = m_groupByPoints[1];
+	byPoints = list;
+	std::sort(byPoints.begin(), byPoints.end(), CandidatePointsLess<std::vector<Candidate> >(m_candidates));
+	buildChains(byPoints, m_groupChains[1]);
+	if (1 + m_groupChains[1].longest < numPlayers)
+		return false;
+
+	// map order, so the first group found is the one the old loops found
+	std::sort(list.begin(), list.end());
+
+	m_group[0] = seed;
+	m_groupHasNew[1] = s.isNew;
+	m_groupWork = 0;
+	m_groupCut = false;
+	m_groupMaps[0] = s.user->maps;
+	m_groupMapMask[0] = s.mapMask;
+	if (!extendGroup(1, numPlayers))
+	{
+		m_candidates[seed].searchCut = m_groupCut;
+		return false;
+	}
+
+	match.numPlayers = numPlayers;
+	for (int i=0; i<numPlayers; ++i)
+	{
+		match.names[i] = *m_candidates[m_group[i]].name;
+		match.users[i] = m_candidates[m_group[i]].user;
+	}
+	match.fitness = 0.0;
+	return true;
+}
+
+void GeneralsMatchFinder::findMatches(UserMap& userMap, int numPlayers, MatchList& matches)
+{
+	if (numPlayers < 2 || numPlayers > GeneralsMatch::MAX_PLAYERS)
+		return;
+
+	buildIndex(userMap, numPlayers);
+
+	for (int seed=0; seed<(int)m_candidates.size(); ++seed)
+	{
+		if (m_candidates[seed].user->status != STATUS_WORKING)
+			continue;
+
+		GeneralsMatch match;
+		bool found = (numPlayers == 2) ? findPartner(seed, match) : findGroup(seed, numPlayers, match);
+		if (!found)
+			continue;
+
+		for (int i=0; i<match.numPlayers; ++i)
+			match.users[i]->status = STATUS_MATCHED;
+		matches.push_back(match);
+	}
+
+	settlePool();
+}
@@ -0,0 +1,255 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// The part of the matchbot that decides who plays whom. It has no GameSpy
+// or wlib dependencies, so it can be built and load tested on any platform.
+// GeneralsX @performance 18/10/2026 Replaces the nested loops of
+// GeneralsMatcher::checkMatchesInUserMap, which were O(n^8) for 4v4.
+
+#pragma once
+
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+typedef std::vector<bool> MapBitSet;
+
+MapBitSet MapSetUnion(const MapBitSet& a, const MapBitSet& b);
+int MapSetCount(const MapBitSet& a);
+
+// =====================================================================
+// Users
+// =====================================================================
+
+// Here are the states a matcher can be in:
+typedef enum
+{
+    STATUS_INVAL = 0,
+    STATUS_INCHANNEL,  // Just entered the channel
+    STATUS_WORKING,    // Sent info, needs to be matched
+    STATUS_MATCHED,    // Been matched, but is still in the channel
+} UserStatus;
+
+class GeneralsUser
+{
+public:
+	GeneralsUser();
+	UserStatus status;
+
+	int points, minPoints, maxPoints;
+
+	int discons, maxDiscons;
+
+	int country;
+	int color;
+
+	bool widened;
+	time_t timeToWiden;
+	time_t matchStart; // when did we request a match?
+
+	// This is a ping to a designated 3rd-party server who just
+	// responds to pings.  The idea is that if the game server is
+	// behind a firewall, the client will have a 1000ms ping to it,
+	// even though he might be very close.  To combat this, we have
+	// clients & servers ping some 3rd-party servers & calculate a
+	// pesudo-ping based on the sum of pings server-->3rd-->client.
+	std::vector<int> pseudoPing;
+	int maxPing;
+
+	unsigned int IP;
+	int NAT;
+
+	MapBitSet maps;
+
+	int numPlayers;
+};
+
+typedef std::map<std::string, GeneralsUser*> UserMap;
+typedef std::map<int, UserMap> LadderMap;
+
+static const int MaxPingValue = 255*255*2;
+
+int calcPingDelta(const GeneralsUser *a, const GeneralsUser *b);
+
+// =====================================================================
+// Match finder
+// =====================================================================
+
+struct GeneralsMatch
+{
+	enum { MAX_PLAYERS = 8 };
+
+	int numPlayers;
+	std::string names[MAX_PLAYERS];
+	GeneralsUser *users[MAX_PLAYERS];
+	double fitness; // of the pair, only set for 1v1 matches
+};
+
+typedef std::vector<GeneralsMatch> MatchList;
+
+// Finds the matches in one pool of waiting users, i.e. one ladder or one
+// non-ladder team size.  The users are put in buckets by rating band, each
+// with a folded mask of their maps, so a user is only compared against the
+// bands his point range allows and the bands that can still beat the fitness
+// threshold.  The users are still visited in the order of the UserMap, so
+// the matches are the ones the old nested loops found:
+//   1v1 - every waiting user in turn gets the partner with the best fitness
+//         of the users after him.  The old loops stopped after the first
+//         1v1 match of a call, this goes on with the remaining users.
+//   2v2 and up - every waiting user in turn gets the first group (in map
+//         order) of users after him that all fit each other.  Groups are
+//         pruned by how many users with points far enough apart are left.
+// The finder remembers who was left waiting in each pool.  Those users did
+// not fit together last time, so only matches with somebody who is new or
+// changed (e.g. widened his search) since then are looked for, and for group
+// pools who fits whom is kept in a table that only gets their rows redone.
+// In huge pools a group search can give up on a seed and try it again next
+// time.
+class GeneralsMatchFinder
+{
+public:
+	GeneralsMatchFinder();
+
+	void setWeights(int weightLowPing, int weightAvgPoints);
+
+	double computeMatchFitness(const GeneralsUser *u1, const GeneralsUser *u2) const;
+
+	// Appends the matches to the list and sets the matched users to
+	// STATUS_MATCHED.  Users that are not STATUS_WORKING are skipped.
+	// The pool is recognized by its address in later calls.
+	void findMatches(UserMap& userMap, int numPlayers, MatchList& matches);
+
+	static const double FitnessThreshold;
+
+private:
+	// What the finder keeps of a user who was left waiting in a pool
+	struct KnownUser
+	{
+		int points, minPoints, maxPoints;
+		int discons, maxDiscons;
+		bool widened;
+		std::vector<int> pseudoPing;
+		int maxPing;
+		MapBitSet maps;
+
+		int slot;     // his row and column in the fit table of the pool
+		bool settled; // matching him with everybody else who is known was tried
+
+		void set(const GeneralsUser *user);
+		bool isSame(const GeneralsUser *user) const;
+	};
+
+	typedef std::map<std::string, KnownUser> KnownUserMap;
+
+	// The users left waiting in one pool, and for group pools which of them
+	// fit each other, so that is only worked out again for who is new.
+	struct Pool
+	{
+		KnownUserMap users;
+		std::vector<int> freeSlots;
+		int slotCount;
+		int slotCapacity;
+		std::vector<unsigned int> fits; // slotCapacity rows of slotCapacity bits
+	};
+
+	typedef std::map<const UserMap*, Pool> PoolMap;
+
+	struct Candidate
+	{
+		const std::string *name;
+		GeneralsUser *user;
+		KnownUserMap::iterator known;
+		int slot;
+		int points;
+		int band;
+		bool zeroPing; // pinged a server in 0 ms
+		bool isNew;    // was not left waiting by the last call, or has changed since
+		bool refit;    // his part of the fit table has to be worked out
+		bool searchCut; // his group search gave up before it was done
+		unsigned int mapMask; // the maps folded onto 32 bits
+	};
+
+	struct RatingBand
+	{
+		// candidate indices, ascending
+		std::vector<int> widened;
+		std::vector<int> narrow;
+
+		// the points the narrow users accept in a partner, all together
+		double partnerLow, partnerHigh;
+
+		bool zeroPing; // holds a user with a 0 ms ping
+	};
+
+	// The longest chains of points far enough apart to fit each other
+	struct PointChains
+	{
+		std::vector<int> points; // sorted
+		std::vector<int> up;     // up[i] - of the lowest i points
+		std::vector<int> down;   // down[i] - of the points from i on
+		int longest;
+		double maxPointPercent;  // above 1 if the weights give no bound
+	};
+
+	void buildIndex(UserMap& userMap, int numPlayers);
+	void buildFitTable();
+	bool fits(int candidate1, int candidate2) const;
+	const unsigned int *fitRow(int candidate) const;
+	static bool fitsInRow(const unsigned int *row, int slot) { return (row[slot / 32] >> (slot % 32)) & 1; }
+	void settlePool();
+	void collectBands(const Candidate& seed, std::vector<int>& bands) const;
+	bool acceptsNarrow(const RatingBand& band, const Candidate& seed) const;
+	double fitnessBound(int band1, int band2, bool zeroPing) const;
+	void buildChains(const std::vector<int>& byPoints, PointChains& chains) const;
+	int chainBetween(const PointChains& chains, size_t start, size_t end) const;
+	int chainWith(const PointChains& chains, const Candidate& a, const Candidate& b) const;
+
+	bool findPartner(int seed, GeneralsMatch& match);
+	bool findGroup(int seed, int numPlayers, GeneralsMatch& match);
+	bool extendGroup(int depth, int numPlayers);
+
+	static int bandForPoints(double points);
+	static double bandLowPoints(int band);
+
+	// Weights for various matching parameters
+	int m_weightLowPing;
+	int m_weightAvgPoints;
+	int m_totalWeight;
+
+	PoolMap m_pools;
+	Pool *m_pool; // of the current call
+
+	std::vector<Candidate> m_candidates;    // waiting users in map order
+	std::vector<int> m_newCandidates;       // indices of the new ones
+	std::vector<RatingBand> m_bands;
+
+	// scratch space of findGroup
+	std::vector<int> m_groupLists[GeneralsMatch::MAX_PLAYERS];
+	std::vector<int> m_groupByPoints[GeneralsMatch::MAX_PLAYERS]; // the same, sorted by points
+	PointChains m_groupChains[GeneralsMatch::MAX_PLAYERS];
+	std::vector<unsigned int> m_stamps; // per candidate, m_stamp if in the list being built
+	unsigned int m_stamp;
+	bool m_groupHasNew[GeneralsMatch::MAX_PLAYERS];
+	std::vector<size_t> m_groupNewUsers[GeneralsMatch::MAX_PLAYERS]; // positions in m_groupLists
+	int m_group[GeneralsMatch::MAX_PLAYERS];
+	MapBitSet m_groupMaps[GeneralsMatch::MAX_PLAYERS];
+	unsigned int m_groupMapMask[GeneralsMatch::MAX_PLAYERS];
+	size_t m_groupWork;
+	bool m_groupCut;
+};
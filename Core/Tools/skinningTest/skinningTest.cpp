@@ -0,0 +1,245 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// skinningTest.cpp : Compares the batched skinning of VectorProcessorClass against the one
+// vertex at a time reference. Both deform the same skins, the results must agree within a
+// small tolerance. Also times the batched path spread over threads like the renderer does.
+//
+
+#include "WWMath/vp.h"
+#include "WWMath/vector3.h"
+#include "WWMath/matrix3d.h"
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+static const int SKINS = 300;				// infantry on screen
+static const int BONES = 24;
+static const int SKIN_VERTICES = 420;
+static const int JOB_VERTICES = 512;		// same as SkinJobClass::MAX_VERTICES in the renderer
+static const float TOLERANCE = 1.0e-4f;
+
+//-------------------------------------------------------------------------------------------------
+/** Deterministic random numbers */
+//-------------------------------------------------------------------------------------------------
+class RandomSource
+{
+public:
+	RandomSource() : m_seed( 12345 ) { }
+
+	unsigned next()
+	{
+		m_seed = m_seed * 1664525 + 1013904223;
+		return m_seed >> 8;
+	}
+
+	float nextFloat( float lo, float hi )
+	{
+		return lo + ( hi - lo ) * ( next() & 0xffff ) / 65535.0f;
+	}
+
+private:
+	unsigned m_seed;
+};
+
+//-------------------------------------------------------------------------------------------------
+/** The vertices of all skins one after the other, sorted by bone within each skin like W3D skins */
+//-------------------------------------------------------------------------------------------------
+struct SkinData
+{
+	std::vector<Vector3> verts;
+	std::vector<Vector3> norms;
+	std::vector<unsigned short> bones;
+	std::vector<Matrix3D> transforms;		// BONES per skin
+};
+
+static void makeSkins( SkinData &data )
+{
+	RandomSource random;
+	const int count = SKINS * SKIN_VERTICES;
+	data.verts.resize( count );
+	data.norms.resize( count );
+	data.bones.resize( count );
+	data.transforms.resize( SKINS * BONES );
+
+	for( int skin = 0; skin < SKINS; ++skin )
+	{
+		for( int bone = 0; bone < BONES; ++bone )
+		{
+			Matrix3D &tm = data.transforms[ skin * BONES + bone ];
+			tm.Make_Identity();
+			tm.Rotate_Z( random.nextFloat( -3.14f, 3.14f ) );
+			tm.Rotate_X( random.nextFloat( -3.14f, 3.14f ) );
+			tm.Set_Translation( Vector3( random.nextFloat( -500.0f, 500.0f ), random.nextFloat( -500.0f, 500.0f ), random.nextFloat( 0.0f, 50.0f ) ) );
+		}
+
+		// runs of random length on increasing bones, some of them shorter than four vertices
+		int bone = 0;
+		int runLeft = 1 + random.next() % 40;
+		for( int v = 0; v < SKIN_VERTICES; ++v )
+		{
+			const int i = skin * SKIN_VERTICES + v;
+			if( runLeft-- == 0 && bone < BONES - 1 )
+			{
+				++bone;
+				runLeft = random.next() % 40;
+			}
+			data.bones[ i ] = (unsigned short)bone;
+			data.verts[ i ].Set( random.nextFloat( -10.0f, 10.0f ), random.nextFloat( -10.0f, 10.0f ), random.nextFloat( 0.0f, 20.0f ) );
+			data.norms[ i ].Set( random.nextFloat( -1.0f, 1.0f ), random.nextFloat( -1.0f, 1.0f ), random.nextFloat( -1.0f, 1.0f ) );
+			data.norms[ i ].Normalize();
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Deforms vertices first to first+count-1 of a skin, a run of vertices on one bone at a time */
+//-------------------------------------------------------------------------------------------------
+typedef void (*TransformFunc)( Vector3 *, Vector3 *, const Vector3 *, const Vector3 *, const Matrix3D &, const int );
+
+static void deformPart( const SkinData &data, int skin, int first, int count, Vector3 *outVerts, Vector3 *outNorms, TransformFunc transform )
+{
+	const int base = skin * SKIN_VERTICES + first;
+	const unsigned short *bones = &data.bones[ base ];
+	for( int vi = 0; vi < count; )
+	{
+		int cnt = vi + 1;
+		while( cnt < count && bones[ cnt ] == bones[ vi ] )
+			++cnt;
+		transform( outVerts + base + vi, outNorms + base + vi, &data.verts[ base + vi ], &data.norms[ base + vi ],
+			data.transforms[ skin * BONES + bones[ vi ] ], cnt - vi );
+		vi = cnt;
+	}
+}
+
+static void deformAll( const SkinData &data, std::vector<Vector3> &outVerts, std::vector<Vector3> &outNorms, TransformFunc transform )
+{
+	for( int skin = 0; skin < SKINS; ++skin )
+		deformPart( data, skin, 0, SKIN_VERTICES, &outVerts[ 0 ], &outNorms[ 0 ], transform );
+}
+
+static void deformThreaded( const SkinData &data, std::vector<Vector3> &outVerts, std::vector<Vector3> &outNorms, int threads )
+{
+	std::vector<std::thread> workers;
+	for( int t = 0; t < threads; ++t )
+	{
+		workers.push_back( std::thread( [&data, &outVerts, &outNorms, t, threads]
+		{
+			for( int skin = t; skin < SKINS; skin += threads )
+			{
+				for( int first = 0; first < SKIN_VERTICES; first += JOB_VERTICES )
+				{
+					const int count = SKIN_VERTICES - first < JOB_VERTICES ? SKIN_VERTICES - first : JOB_VERTICES;
+					deformPart( data, skin, first, count, &outVerts[ 0 ], &outNorms[ 0 ], VectorProcessorClass::Transform_Skinned );
+				}
+			}
+		} ) );
+	}
+	for( size_t t = 0; t < workers.size(); ++t )
+		workers[ t ].join();
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Largest difference relative to the size of the reference value */
+//-------------------------------------------------------------------------------------------------
+static float maxError( const std::vector<Vector3> &reference, const std::vector<Vector3> &test )
+{
+	float worst = 0.0f;
+	for( size_t i = 0; i < reference.size(); ++i )
+	{
+		for( int axis = 0; axis < 3; ++axis )
+		{
+			const float ref = reference[ i ][ axis ];
+			const float error = fabsf( test[ i ][ axis ] - ref ) / ( fabsf( ref ) > 1.0f ? fabsf( ref ) : 1.0f );
+			if( error > worst )
+				worst = error;
+		}
+	}
+	return worst;
+}
+
+static double elapsedMs( std::chrono::steady_clock::time_point start )
+{
+	return std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+}
+
+int main( int argc, char* argv[] )
+{
+	int iterations = 50;
+	if( argc > 1 )
+		iterations = atoi( argv[ 1 ] ) > 0 ? atoi( argv[ 1 ] ) : 1;
+
+	int threads = (int)std::thread::hardware_concurrency();
+	if( threads < 1 )
+		threads = 1;
+	if( threads > 4 )
+		threads = 4;
+
+	SkinData data;
+	makeSkins( data );
+
+	const size_t count = data.verts.size();
+	std::vector<Vector3> refVerts( count ), refNorms( count );
+	std::vector<Vector3> batchVerts( count ), batchNorms( count );
+	std::vector<Vector3> threadVerts( count ), threadNorms( count );
+
+	printf( "%d skins of %d vertices on %d bones, %d iterations, %s\n", SKINS, SKIN_VERTICES, BONES, iterations,
+		VectorProcessorClass::Get_Skinning_Instruction_Set() );
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for( int i = 0; i < iterations; ++i )
+		deformAll( data, refVerts, refNorms, VectorProcessorClass::Transform_Skinned_Reference );
+	const double refTime = elapsedMs( start );
+
+	start = std::chrono::steady_clock::now();
+	for( int i = 0; i < iterations; ++i )
+		deformAll( data, batchVerts, batchNorms, VectorProcessorClass::Transform_Skinned );
+	const double batchTime = elapsedMs( start );
+
+	start = std::chrono::steady_clock::now();
+	for( int i = 0; i < iterations; ++i )
+		deformThreaded( data, threadVerts, threadNorms, threads );
+	const double threadTime = elapsedMs( start );
+
+	printf( "reference:         %8.3f ms per frame\n", refTime / iterations );
+	printf( "batched:           %8.3f ms per frame\n", batchTime / iterations );
+	printf( "batched %d threads: %8.3f ms per frame\n", threads, threadTime / iterations );
+
+	const float errors[] = {
+		maxError( refVerts, batchVerts ),
+		maxError( refNorms, batchNorms ),
+		maxError( refVerts, threadVerts ),
+		maxError( refNorms, threadNorms ),
+	};
+	float worst = 0.0f;
+	for( int i = 0; i < 4; ++i )
+		worst = errors[ i ] > worst ? errors[ i ] : worst;
+
+	if( worst > TOLERANCE )
+	{
+		printf( "FAILED: the batched skins differ from the reference by %g\n", worst );
+		return 1;
+	}
+
+	printf( "Batched skins agree with the reference, largest difference %g\n", worst );
+	return 0;
+}
@@ -0,0 +1,161 @@
+/*
+**	Command & Conquer Generals Zero Hour(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// timingWheelTest.cpp : Compares the FrameTimingWheel against the list it replaced in the
+// WeaponStore. Both are fed the same events, the order the events come out in must match.
+//
+
+#include "Common/FrameTimingWheel.h"
+
+#include <chrono>
+#include <list>
+#include <stdio.h>
+#include <vector>
+
+struct PendingEvent
+{
+	UnsignedInt m_id;
+	UnsignedInt m_frame;
+};
+
+static const UnsignedInt PENDING_EVENTS = 12000;
+static const UnsignedInt FRAMES = 20000;
+
+//-------------------------------------------------------------------------------------------------
+/** Deterministic random numbers, each queue gets its own generator with the same seed */
+//-------------------------------------------------------------------------------------------------
+class EventSource
+{
+public:
+	EventSource() : m_seed( 12345 ), m_nextID( 0 ) { }
+
+	PendingEvent makeEvent( UnsignedInt curFrame )
+	{
+		// mostly short delays like shells and bullets, with some long ones and some for right now
+		UnsignedInt delay;
+		UnsignedInt kind = random() % 100;
+		if( kind < 1 )
+			delay = 0;
+		else if( kind < 2 )
+			delay = 16000 + random() % 24000;
+		else if( kind < 10 )
+			delay = 300 + random() % 4700;
+		else
+			delay = 1 + random() % 300;
+
+		PendingEvent event;
+		event.m_id = m_nextID++;
+		event.m_frame = curFrame + delay;
+		return event;
+	}
+
+private:
+	UnsignedInt random()
+	{
+		m_seed = m_seed * 1664525 + 1013904223;
+		return m_seed >> 8;
+	}
+
+	UnsignedInt m_seed;
+	UnsignedInt m_nextID;
+};
+
+//-------------------------------------------------------------------------------------------------
+/** The old WeaponStore::update, walk the whole list every frame */
+//-------------------------------------------------------------------------------------------------
+static void runList( std::vector<UnsignedInt> &fired )
+{
+	EventSource source;
+	std::list<PendingEvent> pending;
+	for( UnsignedInt i = 0; i < PENDING_EVENTS; ++i )
+		pending.push_back( source.makeEvent( 0 ) );
+
+	for( UnsignedInt curFrame = 0; curFrame < FRAMES; ++curFrame )
+	{
+		for( std::list<PendingEvent>::iterator it = pending.begin(); it != pending.end(); )
+		{
+			if( curFrame >= it->m_frame )
+			{
+				fired.push_back( it->m_id );
+				pending.push_back( source.makeEvent( curFrame ) );
+				it = pending.erase( it );
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+static void runWheel( std::vector<UnsignedInt> &fired )
+{
+	EventSource source;
+	FrameTimingWheel<PendingEvent> pending;
+	for( UnsignedInt i = 0; i < PENDING_EVENTS; ++i )
+	{
+		PendingEvent event = source.makeEvent( 0 );
+		pending.schedule( event.m_frame, event );
+	}
+
+	for( UnsignedInt curFrame = 0; curFrame < FRAMES; ++curFrame )
+	{
+		PendingEvent event;
+		while( pending.popDue( curFrame, event ) )
+		{
+			fired.push_back( event.m_id );
+			PendingEvent next = source.makeEvent( curFrame );
+			pending.schedule( next.m_frame, next );
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+static double timeRun( void (*run)( std::vector<UnsignedInt> & ), std::vector<UnsignedInt> &fired )
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	run( fired );
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::milli>( end - start ).count();
+}
+
+int main( int argc, char* argv[] )
+{
+	printf( "%u pending events over %u frames\n", PENDING_EVENTS, FRAMES );
+
+	std::vector<UnsignedInt> listFired;
+	std::vector<UnsignedInt> wheelFired;
+	listFired.reserve( PENDING_EVENTS * 8 );
+	wheelFired.reserve( PENDING_EVENTS * 8 );
+
+	double listTime = timeRun( runList, listFired );
+	double wheelTime = timeRun( runWheel, wheelFired );
+
+	printf( "list:  %u events fired in %.2f ms\n", (UnsignedInt)listFired.size(), listTime );
+	printf( "wheel: %u events fired in %.2f ms\n", (UnsignedInt)wheelFired.size(), wheelTime );
+
+	if( listFired != wheelFired )
+	{
+		printf( "FAILED: the events were fired in a different order\n" );
+		return 1;
+	}
+
+	printf( "Events were fired in the same order\n" );
+	return 0;
+}
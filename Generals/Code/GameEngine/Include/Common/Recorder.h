@@ -25,6 +25,7 @@
 #pragma once
 
 #include "Common/MessageStream.h"
+#include "Common/ReplayCommandStream.h"
 #include "GameNetwork/GameInfo.h"
 
 class File;
@@ -110,6 +111,9 @@ public:
 		Bool playerDiscons[MAX_SLOTS];
 		AsciiString gameOptions;
 		Int localPlayerIndex;
+		ReplayFormat format;
+		Int bodyOffset;																///< file offset of the first command
+		UnsignedInt wideCharBytes;
 	};
 	Bool readReplayHeader( ReplayHeader& header );
 
@@ -121,6 +125,7 @@ public:
 	static AsciiString getReplayArchiveDir();					///< Returns the directory that holds the archived replay files.
 	static AsciiString getReplayExtention();					///< Returns the file extention for replay files.
 	static AsciiString getLastReplayFileName();				///< Returns the filename used for the default replay.
+	static AsciiString getReplayFilePath(const AsciiString& filename);	///< Returns the path a replay filename refers to.
 
 	GameInfo *getGameInfo() { return &m_gameInfo; }	///< Returns the slot list for playback game start
 
@@ -134,6 +139,10 @@ public:
 	void cleanUpReplayFile();										///< after a crash, send replay/debug info to a central repository
 
 	void setArchiveEnabled(Bool enable) { m_archiveReplays = enable; } ///< Enable or disable replay archiving.
+	void setCompactReplaysEnabled(Bool enable) { m_compactReplays = enable; } ///< Record new replays in the compact v2 format.
+
+	UnsignedInt getPlaybackCRCCount() const { return m_playbackCRCCount; }		///< number of game CRCs checked during playback
+	UnsignedInt getPlaybackCRCDigest() const { return m_playbackCRCDigest; }	///< digest of all game CRCs checked during playback
 	void stopRecording();															///< Stop recording and close m_file.
 protected:
 	void startRecording(GameDifficulty diff, Int originalGameMode, Int rankPoints, Int maxFPS);					///< Start recording to m_file.
@@ -150,8 +159,6 @@ protected:
 	void writeReplayWideChar(WideChar value);
 	void readNextFrame();															///< Read the next frame number to execute a command on.
 	void appendNextCommand();													///< Read the next GameMessage and append it to TheCommandList.
-	void writeArgument(GameMessageArgumentDataType type, const GameMessageArgumentType arg);
-	void readArgument(GameMessageArgumentDataType type, GameMessage *msg);
 
 	struct CullBadCommandsResult
 	{
@@ -174,6 +181,15 @@ protected:
 
 	Bool m_doingAnalysis;
 	Bool m_archiveReplays;														///< if true, each replay is archived to the replay archive folder after recording
+	Bool m_compactReplays;														///< if true, replays are recorded in the v2 format
+
+	// GeneralsX @performance 18/10/2026 Commands are encoded into a buffer that is written once per frame.
+	ReplayCommandWriter m_commandWriter;
+	ReplayCommandReader m_commandReader;
+	ReplayCommand m_command;													///< scratch command for recording
+	ReplayCommand m_nextCommand;											///< the next command to be played back
+	UnsignedInt m_playbackCRCCount;
+	UnsignedInt m_playbackCRCDigest;
 
 	Int m_originalGameMode; // valid in replays
 
@@ -37,6 +37,7 @@
 #include "GameClient/Color.h"
 #include "WWMath/matrix3d.h"
 #include "GameClient/DrawableInfo.h"
+#include "GameClient/DrawableGrid.h"
 
 // FORWARD REFERENCES /////////////////////////////////////////////////////////////////////////////
 class PositionalSound;
@@ -425,6 +426,7 @@ public:
 	void prependToList(Drawable **pListHead);
 	void removeFromList(Drawable **pListHead);
 	void setID( DrawableID id );											///< set this drawable's unique ID
+	DrawableGridInfo *friend_getGridInfo() { return &m_gridInfo; }	///< for use ONLY by DrawableGrid
 
 	const ModelConditionFlags& getModelConditionFlags() const { return m_conditionState; }
 
@@ -673,6 +675,7 @@ private:
 	DrawableID m_id;						///< this drawable's unique ID
 	Drawable *m_nextDrawable;
 	Drawable *m_prevDrawable;		///< list links
+	DrawableGridInfo m_gridInfo;	///< where this drawable is in the client drawable grid
 
   DynamicAudioEventInfo *m_customSoundAmbientInfo; ///< If not nullptr, info about the ambient sound to attach to this object
 
@@ -78,6 +78,12 @@ protected:
 	mutable Real			m_radius;
 	Int								m_riverStart;	///< Identifies the start point of the river.
 	mutable Bool			m_boundsNeedsUpdate;
+	// GeneralsX @performance 18/10/2026 Cells of m_coverageCellSize over m_bounds that are
+	// entirely inside or outside the polygon answer pointInTrigger without the exact test.
+	mutable std::vector<UnsignedByte> m_coverage; ///< CoverageType per cell, row by row.
+	mutable Int				m_coverageCellSize;
+	mutable Int				m_coverageWidth;
+	mutable Bool			m_coverageNeedsUpdate;
 	Bool							m_exportWithScripts;
 	Bool							m_isWaterArea; ///< Used to specify water areas in the map.
 	Bool							m_isRiver;		///< Used to specify that a water area is a river.
@@ -85,9 +91,29 @@ protected:
 	static PolygonTrigger* ThePolygonTriggerListPtr;
 	static Int s_currentID; ///< Current id for new triggers.
 
+	// GeneralsX @performance 18/10/2026 The triggers of the list bucketed by their bounds, so a
+	// point is only tested against the triggers that can contain it.
+	static std::vector<PolygonTrigger*> s_bucketTriggers; ///< The triggers of each bucket, in list order.
+	static std::vector<Int> s_bucketStarts; ///< Index of the first trigger of each bucket in s_bucketTriggers, one more for the end.
+	static IRegion2D s_bucketBounds;
+	static Int s_bucketCellSize;
+	static Int s_bucketWidth;
+	static Int s_bucketHeight;
+	static Bool s_bucketsNeedUpdate;
+
+	enum CoverageType
+	{
+		COVERAGE_OUTSIDE,
+		COVERAGE_INSIDE,
+		COVERAGE_EXACT,		///< an edge passes near the cell, each point needs the exact test.
+	};
+
 protected:
 	void reallocate();
 	void updateBounds() const;
+	void updateCoverage() const;
+	void invalidateCoverage();
+	static void updateBuckets();
 
 	// snapshot methods
 	virtual void crc( Xfer *xfer ) override;
@@ -105,11 +131,13 @@ public:
 	/// Writes Triggers Info
 	static void WritePolygonTriggersDataChunk(DataChunkOutput &chunkWriter);
 	static void deleteTriggers();
+	/// The triggers whose bounds may contain the point, in list order. Valid until the triggers change.
+	static PolygonTrigger *const *getTriggersAt(const ICoord3D &point, Int *count);
 
 public:
 	static void addPolygonTrigger(PolygonTrigger *pTrigger);
 	static void removePolygonTrigger(PolygonTrigger *pTrigger);
-	void setNextPoly(PolygonTrigger *nextPoly) {m_nextPolygonTrigger = nextPoly;} ///< Link the next map object.
+	void setNextPoly(PolygonTrigger *nextPoly) {m_nextPolygonTrigger = nextPoly; s_bucketsNeedUpdate = true;} ///< Link the next map object.
 	void addPoint(const ICoord3D &point);
 	void setPoint(const ICoord3D &point, Int ndx);
 	void insertPoint(const ICoord3D &point, Int ndx);
@@ -127,6 +155,7 @@ public:
 	const PolygonTrigger *getNext() const {return m_nextPolygonTrigger;}
 	const AsciiString& getTriggerName()  const {return m_triggerName;} ///< Gets the trigger name.
 	Bool pointInTrigger(ICoord3D &point) const;
+	Bool pointInTriggerExact(const ICoord3D &point) const; ///< pointInTrigger without the coverage cells, always runs the exact test.
 	Bool doExportWithScripts() const {return m_exportWithScripts;}
 	void setDoExportWithScripts(Bool val) {m_exportWithScripts = val;}
 	Bool isWaterArea() const {return m_isWaterArea;}
@@ -33,6 +33,7 @@
 #include "Common/Snapshot.h"
 #include "Common/STLTypedefs.h"
 #include "GameClient/TerrainRoads.h"
+#include "GameLogic/TerrainHeightField.h"
 
 typedef std::vector<ICoord2D> VecICoord2D;
 
@@ -229,12 +230,16 @@ public:
 
 	virtual Real getGroundHeight( Real x, Real y, Coord3D* normal = nullptr )  const;
 	virtual Real getLayerHeight(Real x, Real y, PathfindLayerEnum layer, Coord3D* normal = nullptr, Bool clip = true) const;
+	void getGroundHeights( const Real *x, const Real *y, Int count, Real *heights ) const;	///< getGroundHeight for count positions
+	const TerrainHeightField &getHeightField() const { return m_heightField; }	///< logic copy of the height samples, empty until a map is loaded
+	virtual Bool benchmarkHeightQueries( Int queries );	///< Times ground height queries on the loaded map, see -benchmarkHeightQueries
 	virtual void getExtent( Region3D *extent ) const { DEBUG_CRASH(("not implemented"));  }		///< @todo This should not be a stub - this should own this functionality
 	virtual void getExtentIncludingBorder( Region3D *extent ) const { DEBUG_CRASH(("not implemented"));  }		///< @todo This should not be a stub - this should own this functionality
 	virtual void getMaximumPathfindExtent( Region3D *extent ) const { DEBUG_CRASH(("not implemented"));  }		///< @todo This should not be a stub - this should own this functionality
 	virtual Coord3D findClosestEdgePoint( const Coord3D *closestTo ) const ;
 	virtual Coord3D findFarthestEdgePoint( const Coord3D *farthestFrom ) const ;
 	virtual Bool isClearLineOfSight(const Coord3D& pos, const Coord3D& posOther) const;
+	virtual Bool benchmarkLineOfSight( Int checks );	///< Times line of sight checks on the loaded map, see -benchmarkLineOfSight
 
 	virtual AsciiString getSourceFilename() { return m_filenameString; }
 
@@ -244,6 +249,7 @@ public:
 	virtual Bool isCliffCell( Real x, Real y) const;			///< is point cliff cell
 	virtual const WaterHandle* getWaterHandle( Real x, Real y );					///< get water handle at this location
 	virtual const WaterHandle* getWaterHandleByName( AsciiString name );	///< get water handle by name
+	Bool benchmarkWaterLookups( Int lookups );	///< Times the water and trigger area lookups on the loaded map and checks that they agree, see -benchmarkWaterLookups
 	virtual Real getWaterHeight( const WaterHandle *water );							///< get height of water table
 	virtual void setWaterHeight( const WaterHandle *water,
 															 Real height,
@@ -311,6 +317,7 @@ public:
 	Int getActiveBoundary() { return m_activeBoundary; }
 	void setActiveBoundary(Int newActiveBoundary);
 
+	void setRawMapHeight( const ICoord2D *gridPos, Int height );	///< lowers a height sample of the logic and of TheTerrainVisual
   void flattenTerrain(Object *obj);  ///< Flatten the terrain under a building.
 
 protected:
@@ -339,6 +346,7 @@ protected:
 	UnsignedByte	*m_mapData;									///< array of height samples
 	Int	m_mapDX;															///< width of map samples
 	Int	m_mapDY;															///< height of map samples
+	TerrainHeightField m_heightField;					///< height samples the ground height queries read
 
 	VecICoord2D m_boundaries;
 	Int m_activeBoundary;
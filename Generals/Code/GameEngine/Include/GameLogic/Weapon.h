@@ -31,6 +31,7 @@
 
 // INCLUDES ///////////////////////////////////////////////////////////////////////////////////////
 #include "Common/AudioEventRTS.h"
+#include "Common/FrameTimingWheel.h"
 #include "Common/GameCommon.h"
 
 #include "GameLogic/Damage.h"
@@ -867,7 +868,8 @@ private:
 	typedef std::hash_map<NameKeyType, WeaponTemplate*, rts::hash<NameKeyType>, rts::equal_to<NameKeyType>/**/> WeaponTemplateMap;
 	WeaponTemplateMap m_weaponTemplateHashMap;
 
-	std::list<WeaponDelayedDamageInfo> m_weaponDDI;
+	// GeneralsX @performance 18/10/2026 Keyed by damage frame so that update only touches the damage that is due.
+	FrameTimingWheel<WeaponDelayedDamageInfo> m_weaponDDI;
 };
 
 // EXTERNALS //////////////////////////////////////////////////////////////////////////////////////
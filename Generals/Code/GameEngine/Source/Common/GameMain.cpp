@@ -30,7 +30,16 @@
 
 #include "Common/FramePacer.h"
 #include "Common/GameEngine.h"
+#include "Common/MapLoadBenchmark.h"
+#include "Common/MessageStreamBenchmark.h"
+#include "Common/NetworkBenchmark.h"
+#include "Common/ReplayConverter.h"
 #include "Common/ReplaySimulation.h"
+#include "Common/StringBenchmark.h"
+#include "Common/TextureLoadBenchmark.h"
+#include "Common/WindowLookupBenchmark.h"
+#include "GameClient/Display.h"
+#include "GameClient/VideoPlayer.h"
 
 
 /**
@@ -49,6 +58,47 @@ Int GameMain()
 	{
 		exitcode = ReplaySimulation::simulateReplays(TheGlobalData->m_simulateReplays, TheGlobalData->m_simulateReplayJobs);
 	}
+	else if (!TheGlobalData->m_benchmarkMapLoads.empty())
+	{
+		exitcode = MapLoadBenchmark::benchmarkMaps(TheGlobalData->m_benchmarkMapLoads, TheGlobalData->m_benchmarkMapLoadReport);
+	}
+	else if (TheGlobalData->m_benchmarkMessages > 0)
+	{
+		exitcode = MessageStreamBenchmark::benchmarkPropagation(TheGlobalData->m_benchmarkMessages);
+	}
+	else if (!TheGlobalData->m_convertReplays.empty())
+	{
+		exitcode = ReplayConverter::convertReplays(TheGlobalData->m_convertReplays, TheGlobalData->m_compressConvertedReplays);
+	}
+	else if (TheGlobalData->m_benchmarkNetworkPlayers > 0)
+	{
+		LoopbackNetwork::Settings link;
+		link.m_latency = TheGlobalData->m_benchmarkNetworkLatency;
+		link.m_jitter = TheGlobalData->m_benchmarkNetworkJitter;
+		link.m_lossPercent = TheGlobalData->m_benchmarkNetworkLoss;
+		link.m_reorderPercent = TheGlobalData->m_benchmarkNetworkReorder;
+		exitcode = NetworkBenchmark::benchmarkLockstep(TheGlobalData->m_benchmarkNetworkPlayers, TheGlobalData->m_benchmarkNetworkFrames, link);
+	}
+	else if (TheGlobalData->m_benchmarkTextureThreads > 0)
+	{
+		exitcode = TextureLoadBenchmark::benchmarkDecoding(TheGlobalData->m_benchmarkTextureThreads);
+	}
+	else if (TheGlobalData->m_benchmarkWindowLookups > 0)
+	{
+		exitcode = WindowLookupBenchmark::benchmarkLookups(TheGlobalData->m_benchmarkWindowLookups);
+	}
+	else if (TheGlobalData->m_benchmarkStrings > 0)
+	{
+		exitcode = StringBenchmark::benchmarkStrings(TheGlobalData->m_benchmarkStrings);
+	}
+	else if (TheGlobalData->m_benchmarkShadowSilhouettes > 0)
+	{
+		exitcode = TheDisplay->benchmarkShadowSilhouettes(TheGlobalData->m_benchmarkShadowSilhouettes);
+	}
+	else if (TheGlobalData->m_benchmarkVideoFrames > 0)
+	{
+		exitcode = TheVideoPlayer->benchmarkPlayback(TheGlobalData->m_benchmarkVideoFrames);
+	}
 	else
 	{
 		// run it
@@ -999,6 +999,31 @@ GlobalData::GlobalData()
 
 	m_simulateReplays.clear();
 	m_simulateReplayJobs = SIMULATE_REPLAYS_SEQUENTIAL;
+	m_benchmarkMapLoads.clear();
+	m_benchmarkMapLoadReport.clear();
+	m_benchmarkPathfindZones = 0;
+	m_benchmarkWaterLookups = 0;
+	m_benchmarkLineOfSight = 0;
+	m_benchmarkHeightQueries = 0;
+	m_benchmarkBuildPlacement = 0;
+	m_benchmarkWaterGrid = 0;
+	m_benchmarkMessages = 0;
+	m_convertReplays.clear();
+	m_compressConvertedReplays = FALSE;
+	m_benchmarkNetworkPlayers = 0;
+	m_benchmarkNetworkFrames = 900;
+	m_benchmarkNetworkLatency = 50;
+	m_benchmarkNetworkJitter = 10;
+	m_benchmarkNetworkLoss = 0;
+	m_benchmarkNetworkReorder = 0;
+	m_archiveTraceFile.clear();
+	m_updateProfileFile.clear();
+	m_textureLoaderThreads = 0;
+	m_benchmarkTextureThreads = 0;
+	m_benchmarkWindowLookups = 0;
+	m_benchmarkStrings = 0;
+	m_benchmarkShadowSilhouettes = 0;
+	m_benchmarkVideoFrames = 0;
 
 	for (i = LEVEL_FIRST; i <= LEVEL_LAST; ++i)
 		m_healthBonus[i] = 1.0f;
@@ -65,6 +65,7 @@
 #include "Common/ThingFactory.h"
 #include "Common/ThingTemplate.h"
 #include "Common/TunnelTracker.h"
+#include "Common/UpdateProfiler.h"
 #include "Common/Upgrade.h"
 #include "Common/WellKnownKeys.h"
 #include "Common/Xfer.h"
@@ -663,7 +664,10 @@ void Player::addToPriorityBuildList(AsciiString templateName, Coord3D *pos, Real
 void Player::update()
 {
 	if (m_ai)
+	{
+		UPDATE_PROFILER_SECTION(UpdateProfiler::SECTION_AI_PLAYER, "AIPlayer");
 		m_ai->update();
+	}
 
 	// Allow the teams this player owns to update themselves.
 
@@ -39,7 +39,6 @@
 #include "GameClient/GameText.h"
 
 #include "GameNetwork/LANAPICallbacks.h"
-#include "GameNetwork/GameMessageParser.h"
 #include "GameNetwork/GameSpy/PeerDefs.h"
 #include "GameNetwork/networkutil.h"
 #include "GameLogic/GameLogic.h"
@@ -48,7 +47,6 @@
 #include "Common/OptionPreferences.h"
 #include "Common/version.h"
 
-constexpr const char s_genrep[] = "GENREP";
 constexpr const UnsignedInt replayBufferBytes = 8192;
 
 Int REPLAY_CRC_INTERVAL = 100;
@@ -303,6 +301,9 @@ RecorderClass::RecorderClass()
 	m_currentFilePosition = 0;
 	m_doingAnalysis = FALSE;
 	m_archiveReplays = FALSE;
+	m_compactReplays = FALSE;
+	m_playbackCRCCount = 0;
+	m_playbackCRCDigest = 0;
 	m_nextFrame = 0;
 	m_wasDesync = FALSE;
 	init(); // just for the heck of it.
@@ -341,12 +342,14 @@ void RecorderClass::init() {
 
 	OptionPreferences optionPref;
 	m_archiveReplays = optionPref.getArchiveReplaysEnabled();
+	m_compactReplays = optionPref.getCompactReplaysEnabled();
 }
 
 /**
  * Reset the recorder to the "initialized state."
  */
 void RecorderClass::reset() {
+	m_commandReader.end();
 	if (m_file != nullptr) {
 		m_file->close();
 		m_file = nullptr;
@@ -411,6 +414,7 @@ void RecorderClass::updatePlayback() {
  * reaching the end of the playback file.
  */
 void RecorderClass::stopPlayback() {
+	m_commandReader.end();
 	if (m_file != nullptr) {
 		m_file->close();
 		m_file = nullptr;
@@ -473,6 +477,7 @@ void RecorderClass::updateRecord()
 
 	if (needFlush) {
 		DEBUG_ASSERTCRASH(m_file != nullptr, ("RecorderClass::updateRecord() - unexpected call to fflush(m_file)"));
+		m_commandWriter.flush(m_file);
 		m_file->flush();
 	}
 }
@@ -502,7 +507,8 @@ void RecorderClass::startRecording(GameDifficulty diff, Int originalGameMode, In
 		return;
 	}
 	// TheSuperHackers @info the null terminator needs to be ignored to maintain retail replay file layout
-	m_file->writeFormat("%s", s_genrep);
+	const ReplayFormat format = m_compactReplays ? REPLAY_FORMAT_V2 : REPLAY_FORMAT_V1;
+	m_file->writeFormat("%s", format == REPLAY_FORMAT_V2 ? s_genrepV2 : s_genrep);
 
 	//
 	// save space for stats to be filled in.
@@ -638,6 +644,9 @@ void RecorderClass::startRecording(GameDifficulty diff, Int originalGameMode, In
 
 	DEBUG_LOG(("RecorderClass::startRecording() - diff=%d, mode=%d, FPS=%d", diff, originalGameMode, maxFPS));
 
+	// The commands follow
+	m_commandWriter.begin(m_file, format);
+
 	/*
 	// Write the map name.
 	fprintf(m_file, "%s", (TheGlobalData->m_mapName).str());
@@ -652,6 +661,10 @@ void RecorderClass::startRecording(GameDifficulty diff, Int originalGameMode, In
  * every game.
  */
 void RecorderClass::stopRecording() {
+	// the stats are written at fixed offsets behind the end of the file, so write out the commands first
+	if (m_file != nullptr)
+		m_commandWriter.finish(m_file);
+
 	logGameEnd();
 	if (TheNetwork)
 	{
@@ -705,19 +718,11 @@ void RecorderClass::archiveReplay(AsciiString fileName)
  * Write this game message to the record file. This also writes the game message's execution frame.
  */
 void RecorderClass::writeToFile(GameMessage * msg) {
-	// Write the frame number for this command.
-	UnsignedInt frame = TheGameLogic->getFrame();
-	m_file->write(&frame, sizeof(frame));
-
-	// Write the command type
-	GameMessage::Type type = msg->getType();
-	m_file->write(&type, sizeof(type));
-
-	// Write the player index
-	Int playerIndex = msg->getPlayerIndex();
-	m_file->write(&playerIndex, sizeof(playerIndex));
+	// Copy the command together with the frame it is executed on.
+	m_command.set(TheGameLogic->getFrame(), msg);
 
 #ifdef DEBUG_LOGGING
+	GameMessage::Type type = msg->getType();
 	AsciiString commandName = msg->getCommandAsString();
 	if (type < GameMessage::MSG_BEGIN_NETWORK_MESSAGES || type > GameMessage::MSG_END_NETWORK_MESSAGES)
 	{
@@ -734,75 +739,18 @@ void RecorderClass::writeToFile(GameMessage * msg) {
 		//commandName.str(), msg->getPlayerIndex(), TheGameLogic->getFrame()));
 #endif // DEBUG_LOGGING
 
-	GameMessageParser *parser = newInstance(GameMessageParser)(msg);
-	UnsignedByte numTypes = parser->getNumTypes();
-	m_file->write(&numTypes, sizeof(numTypes));
-
-	GameMessageParserArgumentType *argType = parser->getFirstArgumentType();
-	while (argType != nullptr) {
-		UnsignedByte type = (UnsignedByte)(argType->getType());
-		m_file->write(&type, sizeof(type));
-
-		UnsignedByte argTypeCount = (UnsignedByte)(argType->getArgCount());
-		m_file->write(&argTypeCount, sizeof(argTypeCount));
-
-		argType = argType->getNext();
-	}
-
-	const size_t argsCount = msg->getArgumentCount();
-
-	for (size_t i = 0; i < argsCount; ++i) {
-		GameMessageArgumentDataType argType = msg->getArgumentDataType(i);
-		const GameMessageArgumentType* arg = msg->getArgument(i);
-		writeArgument(argType, *arg);
-	}
-
-	deleteInstance(parser);
-	parser = nullptr;
-
+	// GeneralsX @performance 18/10/2026 Encode into the command buffer, updateRecord() writes it to m_file once per frame.
+	m_commandWriter.writeCommand(m_command);
 }
 
-void RecorderClass::writeArgument(GameMessageArgumentDataType type, const GameMessageArgumentType arg) {
-
-	switch (type) {
-
-		case ARGUMENTDATATYPE_INTEGER:
-			m_file->write( &(arg.integer), sizeof(arg.integer) );
-			break;
-		case ARGUMENTDATATYPE_REAL:
-			m_file->write( &(arg.real), sizeof(arg.real) );
-			break;
-		case ARGUMENTDATATYPE_BOOLEAN:
-			m_file->write( &(arg.boolean), sizeof(arg.boolean) );
-			break;
-		case ARGUMENTDATATYPE_OBJECTID:
-			m_file->write( &(arg.objectID), sizeof(arg.objectID) );
-			break;
-		case ARGUMENTDATATYPE_DRAWABLEID:
-			m_file->write( &(arg.drawableID), sizeof(arg.drawableID) );
-			break;
-		case ARGUMENTDATATYPE_TEAMID:
-			m_file->write( &(arg.teamID), sizeof(arg.teamID) );
-			break;
-		case ARGUMENTDATATYPE_LOCATION:
-			m_file->write( &(arg.location), sizeof(arg.location) );
-			break;
-		case ARGUMENTDATATYPE_PIXEL:
-			m_file->write( &(arg.pixel), sizeof(arg.pixel) );
-			break;
-		case ARGUMENTDATATYPE_PIXELREGION:
-			m_file->write( &(arg.pixelRegion), sizeof(arg.pixelRegion) );
-			break;
-		case ARGUMENTDATATYPE_TIMESTAMP:
-			m_file->write( &(arg.timestamp), sizeof(arg.timestamp) );
-			break;
-		case ARGUMENTDATATYPE_WIDECHAR:
-			writeReplayWideChar(arg.wChar);
-			break;
-		default:
-			DEBUG_LOG(("Unknown GameMessageArgumentDataType in RecorderClass::writeArgument"));
-			break;
-	}
+/**
+ * Returns the path of a replay file in the replay directory.
+ */
+AsciiString RecorderClass::getReplayFilePath(const AsciiString& filename)
+{
+	AsciiString filepath = getReplayDir();
+	filepath.concat(filename.str());
+	return filepath;
 }
 
 /**
@@ -811,8 +759,7 @@ void RecorderClass::writeArgument(GameMessageArgumentDataType type, const GameMe
  */
 Bool RecorderClass::readReplayHeader(ReplayHeader& header)
 {
-	AsciiString filepath = getReplayDir();
-	filepath.concat(header.filename.str());
+	AsciiString filepath = getReplayFilePath(header.filename);
 
 	// TheSuperHackers @performance More buffered data reduces disk overhead and will improve fast forward playback
 	const UnsignedInt buffersize = header.forPlayback ? replayBufferBytes : File::BUFFERSIZE;
@@ -827,7 +774,11 @@ Bool RecorderClass::readReplayHeader(ReplayHeader& header)
 	// Read the GENREP header.
 	char genrep[sizeof(s_genrep) - 1] = {0};
 	m_file->read( &genrep, sizeof(s_genrep) - 1 );
-	if ( strncmp(genrep, s_genrep, sizeof(s_genrep) - 1 ) != 0 ) {
+	if ( strncmp(genrep, s_genrep, sizeof(s_genrep) - 1 ) == 0 ) {
+		header.format = REPLAY_FORMAT_V1;
+	} else if ( strncmp(genrep, s_genrepV2, sizeof(s_genrepV2) - 1 ) == 0 ) {
+		header.format = REPLAY_FORMAT_V2;
+	} else {
 		DEBUG_LOG(("RecorderClass::readReplayHeader - replay file did not have GENREP at the start."));
 		m_file->close();
 		m_file = nullptr;
@@ -858,6 +809,7 @@ Bool RecorderClass::readReplayHeader(ReplayHeader& header)
 	m_replayWideCharBytes = probeBytes == static_cast<Int>(sizeof(firstReplayCharacter)) && (firstReplayCharacter & 0xFFFF0000u) == 0
 		? sizeof(uint32_t)
 		: sizeof(replay_wide_char_t);
+	header.wideCharBytes = m_replayWideCharBytes;
 
 	// Read the Replay Name.  We don't actually do anything with it. Oh well.
 	header.replayName = readUnicodeString();
@@ -903,6 +855,9 @@ Bool RecorderClass::readReplayHeader(ReplayHeader& header)
 		m_gameInfo.setLocalIP(localIP);
 	}
 
+	// The difficulty, game mode, rank points and max FPS come last, then the commands.
+	header.bodyOffset = m_file->seek(0, File::CURRENT) + 4 * sizeof(Int);
+
 	if (!header.forPlayback)
 	{
 		m_gameInfo.endGame();
@@ -1041,6 +996,10 @@ void RecorderClass::handleCRCMessage(UnsignedInt newCRC, Int playerIndex, Bool f
 	const Bool isLocalPlayer = !p || ThePlayerList->getSlotIndex(playerIndex) == localPlayerIndex;
 	if (isLocalPlayer)
 	{
+		// GeneralsX @feature 18/10/2026 Lets two playbacks of the same game be compared, see ReplayConverter.
+		++m_playbackCRCCount;
+		m_playbackCRCDigest = m_playbackCRCDigest * 31 + newCRC;
+
 		UnsignedInt playbackCRC = m_crcInfo->readCRC();
 		//DEBUG_LOG(("RecorderClass::handleCRCMessage() - Comparing CRCs of InGame:%8.8X Replay:%8.8X Frame:%d from Player %d",
 		//	playbackCRC, newCRC, TheGameLogic->getFrame()-m_crcInfo->GetQueueSize()-1, playerIndex));
@@ -1215,6 +1174,16 @@ Bool RecorderClass::playbackFile(AsciiString filename)
 
 	DEBUG_LOG(("RecorderClass::playbackFile() - original game was mode %d", m_originalGameMode));
 
+	if (!m_commandReader.begin(m_file, header.format, m_replayWideCharBytes))
+	{
+		DEBUG_LOG(("RecorderClass::playbackFile() - replay file has an unknown command layout."));
+		m_file->close();
+		m_file = nullptr;
+		return FALSE;
+	}
+	m_playbackCRCCount = 0;
+	m_playbackCRCDigest = 0;
+
 	// TheSuperHackers @fix helmutbuhler 03/04/2025
 	// In case we restart a replay, we need to clear the command list.
 	// Otherwise a crc message remains and messes up the crc calculation on the restarted replay.
@@ -1340,13 +1309,60 @@ void RecorderClass::readNextFrame() {
 		return;
 	}
 
-	Int bytesRead = m_file->read(&m_nextFrame, sizeof(m_nextFrame));
-	if (bytesRead != sizeof(m_nextFrame)) {
+	// The whole command is decoded here, appendNextCommand() turns it into a message.
+	if (!m_commandReader.readCommand(m_nextCommand)) {
 		DEBUG_LOG(("RecorderClass::readNextFrame - read failed on frame %d", TheGameLogic->getFrame()));
 		m_nextFrame = -1;
 		stopPlayback();
+		return;
+	}
+	m_nextFrame = m_nextCommand.m_frame;
+}
+
+#ifdef DEBUG_LOGGING
+static void logArgument(const GameMessageArgument &arg)
+{
+	const GameMessageArgumentType &data = arg.m_data;
+	switch (arg.m_type) {
+		case ARGUMENTDATATYPE_INTEGER:
+			DEBUG_LOG(("Integer argument: %d (%8.8X)", data.integer, data.integer));
+			break;
+		case ARGUMENTDATATYPE_REAL:
+			DEBUG_LOG(("Real argument: %g (%8.8X)", data.real, *(int *)&data.real));
+			break;
+		case ARGUMENTDATATYPE_BOOLEAN:
+			DEBUG_LOG(("Bool argument: %d", data.boolean));
+			break;
+		case ARGUMENTDATATYPE_OBJECTID:
+			DEBUG_LOG(("Object ID argument: %d", data.objectID));
+			break;
+		case ARGUMENTDATATYPE_DRAWABLEID:
+			DEBUG_LOG(("Drawable ID argument: %d", data.drawableID));
+			break;
+		case ARGUMENTDATATYPE_TEAMID:
+			DEBUG_LOG(("Team ID argument: %d", data.teamID));
+			break;
+		case ARGUMENTDATATYPE_LOCATION:
+			DEBUG_LOG(("Coord3D argument: %g %g %g (%8.8X %8.8X %8.8X)", data.location.x, data.location.y, data.location.z,
+				*(int *)&data.location.x, *(int *)&data.location.y, *(int *)&data.location.z));
+			break;
+		case ARGUMENTDATATYPE_PIXEL:
+			DEBUG_LOG(("Pixel argument: %d,%d", data.pixel.x, data.pixel.y));
+			break;
+		case ARGUMENTDATATYPE_PIXELREGION:
+			DEBUG_LOG(("Pixel Region argument: %d,%d -> %d,%d", data.pixelRegion.lo.x, data.pixelRegion.lo.y, data.pixelRegion.hi.x, data.pixelRegion.hi.y));
+			break;
+		case ARGUMENTDATATYPE_TIMESTAMP:  // Not to be confused with Terrance Stamp... Kneel before Zod!!!
+			DEBUG_LOG(("Timestamp argument: %d", data.timestamp));
+			break;
+		case ARGUMENTDATATYPE_WIDECHAR:
+			DEBUG_LOG(("WideChar argument: %d (%lc)", data.wChar, data.wChar));
+			break;
+		default:
+			break;
 	}
 }
+#endif // DEBUG_LOGGING
 
 /**
  * This reads the next command from the replay file and appends it to TheCommandList.
@@ -1359,13 +1375,7 @@ void RecorderClass::appendNextCommand() {
 		return;
 	}
 
-	GameMessage::Type type;
-	Int bytesRead = m_file->read(&type, sizeof(type));
-	if (bytesRead != sizeof(type)) {
-		DEBUG_LOG(("RecorderClass::appendNextCommand - read failed on frame %d", m_nextFrame/*TheGameLogic->getFrame()*/));
-		return;
-	}
-
+	GameMessage::Type type = (GameMessage::Type)m_nextCommand.m_type;
 	GameMessage *msg = newInstance(GameMessage)(type);
 
 #ifdef DEBUG_LOGGING
@@ -1380,9 +1390,7 @@ void RecorderClass::appendNextCommand() {
 	}
 #endif // DEBUG_LOGGING
 
-	Int playerIndex = -1;
-	m_file->read(&playerIndex, sizeof(playerIndex));
-	msg->friend_setPlayerIndex(playerIndex);
+	msg->friend_setPlayerIndex(m_nextCommand.m_playerIndex);
 
 	// don't debug log this if we're debugging sync errors, as it will cause diff problems between a game and it's replay...
 #ifdef DEBUG_LOGGING
@@ -1398,45 +1406,15 @@ void RecorderClass::appendNextCommand() {
 	}
 #endif
 
-	UnsignedByte numTypes = 0;
-	Int totalArgs = 0;
-	m_file->read(&numTypes, sizeof(numTypes));
-
-	GameMessageParser *parser = newInstance(GameMessageParser)();
-	for (UnsignedByte i = 0; i < numTypes; ++i) {
-		UnsignedByte type = (UnsignedByte)ARGUMENTDATATYPE_UNKNOWN;
-		m_file->read(&type, sizeof(type));
-		UnsignedByte numArgs = 0;
-		m_file->read(&numArgs, sizeof(numArgs));
-		parser->addArgType((GameMessageArgumentDataType)type, numArgs);
-		totalArgs += numArgs;
-	}
-
-	GameMessageParserArgumentType *parserArgType = parser->getFirstArgumentType();
-	GameMessageArgumentDataType lasttype = ARGUMENTDATATYPE_UNKNOWN;
-	Int argsLeftForType = 0;
-	if (parserArgType != nullptr) {
-		lasttype = parserArgType->getType();
-		argsLeftForType = parserArgType->getArgCount();
-	}
-	for (Int j = 0; j < totalArgs; ++j) {
-		readArgument(lasttype, msg);
-
-		--argsLeftForType;
-		if (argsLeftForType == 0) {
-			DEBUG_ASSERTCRASH(parserArgType != nullptr, ("parserArgType was null when it shouldn't have been."));
-			if (parserArgType == nullptr) {
-				return;
-			}
+	m_nextCommand.appendArgumentsTo(msg);
 
-			parserArgType = parserArgType->getNext();
-			// parserArgType is allowed to be null here, this is the case if there are no more arguments.
-			if (parserArgType != nullptr) {
-				argsLeftForType = parserArgType->getArgCount();
-				lasttype = parserArgType->getType();
-			}
-		}
+#ifdef DEBUG_LOGGING
+	if (m_doingAnalysis)
+	{
+		for (size_t i = 0; i < m_nextCommand.m_args.size(); ++i)
+			logArgument(m_nextCommand.m_args[i]);
 	}
+#endif
 
 	if (type != GameMessage::MSG_BEGIN_NETWORK_MESSAGES && type != GameMessage::MSG_CLEAR_GAME_DATA && !m_doingAnalysis)
 	{
@@ -1447,148 +1425,6 @@ void RecorderClass::appendNextCommand() {
 		deleteInstance(msg);
 		msg = nullptr;
 	}
-
-	deleteInstance(parser);
-	parser = nullptr;
-}
-
-void RecorderClass::readArgument(GameMessageArgumentDataType type, GameMessage *msg) {
-	switch (type) {
-		case ARGUMENTDATATYPE_INTEGER: {
-			Int theint;
-			m_file->read(&theint, sizeof(theint));
-			msg->appendIntegerArgument(theint);
-#ifdef DEBUG_LOGGING
-			if (m_doingAnalysis)
-			{
-				DEBUG_LOG(("Integer argument: %d (%8.8X)", theint, theint));
-			}
-#endif
-			break;
-		}
-		case ARGUMENTDATATYPE_REAL: {
-			Real thereal;
-			m_file->read(&thereal, sizeof(thereal));
-			msg->appendRealArgument(thereal);
-#ifdef DEBUG_LOGGING
-			if (m_doingAnalysis)
-			{
-				DEBUG_LOG(("Real argument: %g (%8.8X)", thereal, *(int *)&thereal));
-			}
-#endif
-			break;
-		}
-		case ARGUMENTDATATYPE_BOOLEAN: {
-			Bool thebool;
-			m_file->read(&thebool, sizeof(thebool));
-			msg->appendBooleanArgument(thebool);
-#ifdef DEBUG_LOGGING
-			if (m_doingAnalysis)
-			{
-				DEBUG_LOG(("Bool argument: %d", thebool));
-			}
-#endif
-			break;
-		}
-		case ARGUMENTDATATYPE_OBJECTID: {
-			ObjectID theid;
-			m_file->read(&theid, sizeof(theid));
-			msg->appendObjectIDArgument(theid);
-#ifdef DEBUG_LOGGING
-			if (m_doingAnalysis)
-			{
-				DEBUG_LOG(("Object ID argument: %d", theid));
-			}
-#endif
-			break;
-		}
-		case ARGUMENTDATATYPE_DRAWABLEID: {
-			DrawableID theid;
-			m_file->read(&theid, sizeof(theid));
-			msg->appendDrawableIDArgument(theid);
-#ifdef DEBUG_LOGGING
-			if (m_doingAnalysis)
-			{
-				DEBUG_LOG(("Drawable ID argument: %d", theid));
-			}
-#endif
-			break;
-		}
-		case ARGUMENTDATATYPE_TEAMID: {
-			UnsignedInt theid;
-			m_file->read(&theid, sizeof(theid));
-			msg->appendTeamIDArgument(theid);
-#ifdef DEBUG_LOGGING
-			if (m_doingAnalysis)
-			{
-				DEBUG_LOG(("Team ID argument: %d", theid));
-			}
-#endif
-			break;
-		}
-		case ARGUMENTDATATYPE_LOCATION: {
-			Coord3D loc;
-			m_file->read(&loc, sizeof(loc));
-			msg->appendLocationArgument(loc);
-#ifdef DEBUG_LOGGING
-			if (m_doingAnalysis)
-			{
-				DEBUG_LOG(("Coord3D argument: %g %g %g (%8.8X %8.8X %8.8X)", loc.x, loc.y, loc.z,
-					*(int *)&loc.x, *(int *)&loc.y, *(int *)&loc.z));
-			}
-#endif
-			break;
-		}
-		case ARGUMENTDATATYPE_PIXEL: {
-			ICoord2D pixel;
-			m_file->read(&pixel, sizeof(pixel));
-			msg->appendPixelArgument(pixel);
-#ifdef DEBUG_LOGGING
-			if (m_doingAnalysis)
-			{
-				DEBUG_LOG(("Pixel argument: %d,%d", pixel.x, pixel.y));
-			}
-#endif
-			break;
-		}
-		case ARGUMENTDATATYPE_PIXELREGION: {
-			IRegion2D reg;
-			m_file->read(&reg, sizeof(reg));
-			msg->appendPixelRegionArgument(reg);
-#ifdef DEBUG_LOGGING
-			if (m_doingAnalysis)
-			{
-				DEBUG_LOG(("Pixel Region argument: %d,%d -> %d,%d", reg.lo.x, reg.lo.y, reg.hi.x, reg.hi.y));
-			}
-#endif
-			break;
-		}
-		case ARGUMENTDATATYPE_TIMESTAMP: {  // Not to be confused with Terrance Stamp... Kneel before Zod!!!
-			UnsignedInt stamp;
-			m_file->read(&stamp, sizeof(stamp));
-			msg->appendTimestampArgument(stamp);
-#ifdef DEBUG_LOGGING
-			if (m_doingAnalysis)
-			{
-				DEBUG_LOG(("Timestamp argument: %d", stamp));
-			}
-#endif
-			break;
-		}
-		case ARGUMENTDATATYPE_WIDECHAR: {
-			WideChar theid = static_cast<WideChar>(readReplayWideChar());
-			msg->appendWideCharArgument(theid);
-#ifdef DEBUG_LOGGING
-			if (m_doingAnalysis)
-			{
-				DEBUG_LOG(("WideChar argument: %d (%lc)", theid, theid));
-			}
-#endif
-			break;
-		}
-		default:
-			break;
-	}
 }
 
 /**
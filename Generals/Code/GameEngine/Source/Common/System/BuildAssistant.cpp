@@ -55,6 +55,8 @@
 #include "GameLogic/Module/ProductionUpdate.h"
 #include "GameLogic/Module/ParkingPlaceBehavior.h"
 
+#include <chrono>
+
 // PUBLIC DATA ////////////////////////////////////////////////////////////////////////////////////
 BuildAssistant *TheBuildAssistant = nullptr;
 
@@ -159,6 +161,8 @@ void BuildAssistant::reset()
 	// clear the sell list
 	m_sellList.clear();
 
+	m_buildabilityGrid.reset();
+
 }
 
 static const Real FRAMES_TO_ALLOW_SCAFFOLD = LOGICFRAMES_PER_SECOND * 1.5f;
@@ -476,6 +480,7 @@ struct SampleBuildData
 	Bool terrainRestricted; ///< one of the terrain tiles prevents building
 	Real hiZ;								///< highest sample point used
 	Real loZ;								///< lowest sample point used
+	BuildabilityGrid *grid;	///< restricted terrain of each cell
 };
 
 //-------------------------------------------------------------------------------------------------
@@ -486,29 +491,43 @@ static void checkSampleBuildLocation( const Coord3D *samplePoint, void *userData
 	TerrainType *terrain;
 	SampleBuildData *sampleData = (SampleBuildData *)userData;
 
-	// get the terrain tile here
-	terrain = TheTerrainVisual->getTerrainTile( samplePoint->x, samplePoint->y );
-	if( terrain )
+	Int cellX = REAL_TO_INT_FLOOR( samplePoint->x / PATHFIND_CELL_SIZE );
+	Int cellY = REAL_TO_INT_FLOOR( samplePoint->y / PATHFIND_CELL_SIZE );
+
+	// GeneralsX @performance 18/10/2026 The grid keeps the restricts building flag of the terrain tile
+	// of each cell instead of looking the tile up by name for every sample.
+	if( BuildabilityGrid::isEnabled() )
 	{
 
-		// check for the restricts building flag
-		if( terrain->getRestrictConstruction() )
+		if( sampleData->grid->isCellRestricted( cellX, cellY ) )
 			sampleData->terrainRestricted = TRUE;
 
 	}
+	else
+	{
 
-	Int cellX = REAL_TO_INT_FLOOR( samplePoint->x / PATHFIND_CELL_SIZE );
-	Int cellY = REAL_TO_INT_FLOOR( samplePoint->y / PATHFIND_CELL_SIZE );
+		// get the terrain tile here
+		terrain = TheTerrainVisual->getTerrainTile( samplePoint->x, samplePoint->y );
+		if( terrain )
+		{
 
-	PathfindCell* cell = TheAI->pathfinder()->getCell( LAYER_GROUND, cellX, cellY );
-	if (!cell) {
-		sampleData->terrainRestricted = TRUE;
-	}	else {
-		enum PathfindCell::CellType type = cell->getType();
-		if ( (type == PathfindCell::CELL_WATER) || (type == PathfindCell::CELL_CLIFF) ||
-			(type == PathfindCell::CELL_IMPASSABLE)) {
-			sampleData->terrainRestricted = true;
+			// check for the restricts building flag
+			if( terrain->getRestrictConstruction() )
+				sampleData->terrainRestricted = TRUE;
+
+		}
+
+		PathfindCell* cell = TheAI->pathfinder()->getCell( LAYER_GROUND, cellX, cellY );
+		if (!cell) {
+			sampleData->terrainRestricted = TRUE;
+		}	else {
+			enum PathfindCell::CellType type = cell->getType();
+			if ( (type == PathfindCell::CELL_WATER) || (type == PathfindCell::CELL_CLIFF) ||
+				(type == PathfindCell::CELL_IMPASSABLE)) {
+				sampleData->terrainRestricted = true;
+			}
 		}
+
 	}
 
 	//
@@ -544,7 +563,8 @@ void BuildAssistant::iterateFootprint( const ThingTemplate *build,
 																			 const Coord3D *worldPos,
 																			 Real sampleResolution,
 																			 IterateFootprintFunc func,
-																			 void *funcUserData )
+																			 void *funcUserData,
+																			 Bool sampleHeights )
 {
 
 	// sanity
@@ -617,8 +637,11 @@ void BuildAssistant::iterateFootprint( const ThingTemplate *build,
 			if( x > halfFootprintWidth )
 				x = halfFootprintWidth;
 
-			// transform to world
-			v.Set( x, y, TheTerrainLogic->getGroundHeight( x, y ) );
+			//
+			// transform to world, the rotation leaves x and y of the result apart from z so leaving
+			// out the heights does not move the sample points
+			//
+			v.Set( x, y, sampleHeights ? TheTerrainLogic->getGroundHeight( x, y ) : 0.0f );
 			transform.Transform_Vector( transform, v, &v );
 
 			// for circular geometries we must actually be within the circle
@@ -638,7 +661,7 @@ void BuildAssistant::iterateFootprint( const ThingTemplate *build,
 			Coord3D pos;
 			pos.x = v.X;
 			pos.y = v.Y;
-			pos.z = TheTerrainLogic->getGroundHeight( pos.x, pos.y );
+			pos.z = sampleHeights ? TheTerrainLogic->getGroundHeight( pos.x, pos.y ) : 0.0f;
 			func( &pos, funcUserData );
 
 		}
@@ -989,6 +1012,7 @@ LegalBuildCode BuildAssistant::isLocationLegalToBuild( const Coord3D *worldPos,
 		sampleData.terrainRestricted = FALSE;
 		sampleData.hiZ = terrainExtent.lo.z;  // note we set hi point to lowest point
 		sampleData.loZ = terrainExtent.hi.z;  // note we set lo point to highest point
+		sampleData.grid = &m_buildabilityGrid;
 
 		// quick check at triple res.
 		iterateFootprint( build, angle, worldPos, 3*sampleResolution,
@@ -1015,6 +1039,330 @@ LegalBuildCode BuildAssistant::isLocationLegalToBuild( const Coord3D *worldPos,
 
 }
 
+//-------------------------------------------------------------------------------------------------
+/** This structure is passed along to checkSampleBuildabilityGrid while iterating the footprint
+	* of a location the buildability grid may rule out */
+//-------------------------------------------------------------------------------------------------
+struct SampleGridData
+{
+	enum { MAX_OBSTACLES = 8 };
+
+	BuildabilityGrid *grid;
+	Region3D mapRegion;
+	Bool checkTerrain;				///< look for restricted terrain like isLocationLegalToBuild does
+	Bool checkObstacles;			///< collect the immobile objects under the footprint
+	Bool terrainRestricted;		///< one of the samples is on restricted terrain
+	ObjectID obstacles[ MAX_OBSTACLES ];
+	Int numObstacles;
+};
+
+//-------------------------------------------------------------------------------------------------
+/** Checks a sample point of a footprint against the buildability grid */
+//-------------------------------------------------------------------------------------------------
+static void checkSampleBuildabilityGrid( const Coord3D *samplePoint, void *userData )
+{
+	SampleGridData *sampleData = (SampleGridData *)userData;
+	if( sampleData->terrainRestricted )
+		return;
+
+	Int cellX = REAL_TO_INT_FLOOR( samplePoint->x / PATHFIND_CELL_SIZE );
+	Int cellY = REAL_TO_INT_FLOOR( samplePoint->y / PATHFIND_CELL_SIZE );
+
+	if( sampleData->checkTerrain )
+	{
+
+		if( sampleData->grid->isCellRestricted( cellX, cellY ) )
+			sampleData->terrainRestricted = TRUE;
+
+		// too close to edge of map?
+		if (TheGlobalData->m_MinDistFromEdgeOfMapForBuild > 0.0f)
+		{
+			if (samplePoint->x < sampleData->mapRegion.lo.x + TheGlobalData->m_MinDistFromEdgeOfMapForBuild
+					|| samplePoint->x > sampleData->mapRegion.hi.x - TheGlobalData->m_MinDistFromEdgeOfMapForBuild
+					|| samplePoint->y < sampleData->mapRegion.lo.y + TheGlobalData->m_MinDistFromEdgeOfMapForBuild
+					|| samplePoint->y > sampleData->mapRegion.hi.y - TheGlobalData->m_MinDistFromEdgeOfMapForBuild)
+			{
+				sampleData->terrainRestricted = TRUE;
+			}
+		}
+
+	}
+
+	if( sampleData->checkObstacles && sampleData->numObstacles < SampleGridData::MAX_OBSTACLES )
+	{
+
+		ObjectID id = sampleData->grid->getObstacleAt( cellX, cellY );
+		if( id == INVALID_ID )
+			return;
+
+		for( Int i = 0; i < sampleData->numObstacles; ++i )
+		{
+			if( sampleData->obstacles[ i ] == id )
+				return;
+		}
+		sampleData->obstacles[ sampleData->numObstacles++ ] = id;
+
+	}
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Query if the buildability grid shows that isLocationLegalToBuild fails at this location.
+	* When this returns FALSE the location may still be illegal. */
+//-------------------------------------------------------------------------------------------------
+Bool BuildAssistant::isLocationKnownIllegalToBuild( const Coord3D *worldPos,
+																										const ThingTemplate *build,
+																										Real angle,
+																										UnsignedInt options )
+{
+
+	if( !BuildabilityGrid::isEnabled() || build == nullptr || worldPos == nullptr )
+		return FALSE;
+
+	SampleGridData sampleData;
+	sampleData.grid = &m_buildabilityGrid;
+	TheTerrainLogic->getExtent( &sampleData.mapRegion );
+	sampleData.checkTerrain = BitIsSet( options, TERRAIN_RESTRICTIONS );
+	// an immobile object is in the way of whoever builds, unless stealthed objects may be ignored
+	sampleData.checkObstacles = BitIsSet( options, NO_OBJECT_OVERLAP ) && !BitIsSet( options, IGNORE_STEALTHED );
+	sampleData.terrainRestricted = FALSE;
+	sampleData.numObstacles = 0;
+	if( !sampleData.checkTerrain && !sampleData.checkObstacles )
+		return FALSE;
+
+	//
+	// the careful pass of the terrain check in isLocationLegalToBuild takes these same samples, when
+	// one of them is restricted that check fails unless an earlier one already did
+	//
+	iterateFootprint( build, angle, worldPos, MAP_XY_FACTOR, checkSampleBuildabilityGrid, &sampleData, FALSE );
+	if( sampleData.terrainRestricted == TRUE )
+		return TRUE;
+
+	const GeometryInfo &geom = build->getTemplateGeometryInfo();
+	const Real searchDist = geom.getBoundingSphereRadius() * 1.1f;
+	for( Int i = 0; i < sampleData.numObstacles; ++i )
+	{
+
+		Object *them = TheGameLogic->findObjectByID( sampleData.obstacles[ i ] );
+		if( them == nullptr || them->friend_getPartitionData() == nullptr )
+			continue;
+
+		// the object may have died since the grid was filled in
+		if( !BuildabilityGrid::isObstacle( them ) || isRemovableForConstruction( them ) == TRUE )
+			continue;
+
+		// the test PartitionFilterWouldCollide makes for isLocationClearOfObjects
+		if( !ThePartitionManager->geomCollidesWithGeom( worldPos, geom, angle,
+																									 them->getPosition(), them->getGeometryInfo(), them->getOrientation() ) )
+			continue;
+
+		//
+		// iteratePotentialCollisions only finds objects whose bounding sphere is near enough, keep
+		// away from its limit so rounding cannot tell the two apart
+		//
+		const Coord3D *themPos = them->getPosition();
+		Real dx = themPos->x - worldPos->x;
+		Real dy = themPos->y - worldPos->y;
+		Real dz = themPos->z + them->getGeometryInfo().getZDeltaToCenterPosition() - worldPos->z;
+		Real dist = sqrtf( dx * dx + dy * dy + dz * dz ) - them->getGeometryInfo().getBoundingSphereRadius();
+		if( dist < 0.99f * searchDist )
+			return TRUE;
+
+	}
+
+	return FALSE;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Query if we can build at this location, ruling out the locations the buildability grid
+	* shows blocked before running isLocationLegalToBuild */
+//-------------------------------------------------------------------------------------------------
+LegalBuildCode BuildAssistant::isCandidateLocationLegalToBuild( const Coord3D *worldPos,
+																																const ThingTemplate *build,
+																																Real angle,
+																																UnsignedInt options,
+																																const Object *builderObject,
+																																Player *player )
+{
+
+	if( isLocationKnownIllegalToBuild( worldPos, build, angle, options ) )
+		return LBC_GENERIC_FAILURE;
+
+	return isLocationLegalToBuild( worldPos, build, angle, options, builderObject, player );
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** An object was placed, moved or removed from the partition manager */
+//-------------------------------------------------------------------------------------------------
+void BuildAssistant::objectFootprintChanged( const Object *obj )
+{
+
+	if( obj && BuildabilityGrid::isObstacle( obj ) )
+		m_buildabilityGrid.invalidateObstacles();
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** The placement search AIPlayer::calcClosestConstructionZoneLocation makes, walking the edges
+	* of growing squares around the location until a spot on one of them is legal */
+//-------------------------------------------------------------------------------------------------
+Bool BuildAssistant::searchPlacement( const ThingTemplate *build, const Coord3D *location, Bool useGrid,
+																			Coord3D *result, Int *fullChecks )
+{
+
+	const UnsignedInt options = CLEAR_PATH | TERRAIN_RESTRICTIONS | NO_OBJECT_OVERLAP;
+	const Real searchDist = 20 * PATHFIND_CELL_SIZE_F;	// SUPPLY_CENTER_CLOSE_DIST of AIPlayer
+	const Real angle = build->getPlacementViewAngle();
+	auto isLegal = [&]( const Coord3D *pos ) -> Bool
+	{
+		if( useGrid && isLocationKnownIllegalToBuild( pos, build, angle, options ) )
+			return FALSE;
+
+		++(*fullChecks);
+		return isLocationLegalToBuild( pos, build, angle, options, nullptr, nullptr ) == LBC_OK;
+	};
+
+	Coord3D newPos = *location;
+	for( Real posOffset = 0; posOffset < 2 * searchDist; posOffset += 2 * PATHFIND_CELL_SIZE_F )
+	{
+
+		Real offset = posOffset / 2;
+		Real xPos, yPos;
+		yPos = location->y - offset;
+		for( xPos = location->x - offset; xPos <= location->x + offset; xPos += PATHFIND_CELL_SIZE_F )
+		{
+			newPos.x = xPos;
+			newPos.y = yPos;
+			if( isLegal( &newPos ) )
+				break;
+
+			newPos.y = yPos + posOffset;
+			if( isLegal( &newPos ) )
+				break;
+		}
+		if( xPos <= location->x + offset )
+		{
+			*result = newPos;
+			return TRUE;
+		}
+
+		xPos = location->x - offset;
+		for( yPos = location->y - offset; yPos <= location->y + offset; yPos += PATHFIND_CELL_SIZE_F )
+		{
+			newPos.x = xPos;
+			newPos.y = yPos;
+			if( isLegal( &newPos ) )
+				break;
+
+			newPos.x = xPos + posOffset;
+			if( isLegal( &newPos ) )
+				break;
+		}
+		if( yPos <= location->y + offset )
+		{
+			*result = newPos;
+			return TRUE;
+		}
+
+	}
+
+	result->zero();
+	return FALSE;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Runs AI placement searches spread over the loaded map, once with the full checks for every
+	* spot and once ruling spots out with the buildability grid first. Prints the timings and returns
+	* false if the two ever place a structure differently. */
+//-------------------------------------------------------------------------------------------------
+Bool BuildAssistant::benchmarkPlacement( Int searches )
+{
+	// Note that we use printf here because this is run from cmd.
+	std::vector<const ThingTemplate *> templates;
+	for( const ThingTemplate *tmpl = TheThingFactory->firstTemplate(); tmpl; tmpl = tmpl->friend_getNextTemplate() )
+	{
+		if( tmpl->isKindOf( KINDOF_STRUCTURE ) && tmpl->isBuildableItem() && !isLineBuildTemplate( tmpl ) )
+			templates.push_back( tmpl );
+	}
+	if( templates.empty() )
+	{
+		printf( "Build placement: no structures to place\n" );
+		fflush( stdout );
+		return false;
+	}
+
+	Int side = 1;
+	while( side * side < searches )
+		++side;
+
+	Region3D extent;
+	TheTerrainLogic->getExtent( &extent );
+	std::vector<Coord3D> locations;
+	locations.reserve( side * side );
+	for( Int j = 0; j < side; ++j )
+	{
+		for( Int i = 0; i < side; ++i )
+		{
+			Coord3D location;
+			location.x = extent.lo.x + ( extent.hi.x - extent.lo.x ) * ( i + 0.5f ) / side;
+			location.y = extent.lo.y + ( extent.hi.y - extent.lo.y ) * ( j + 0.5f ) / side;
+			location.z = TheTerrainLogic->getGroundHeight( location.x, location.y );
+			locations.push_back( location );
+		}
+	}
+
+	std::vector<Coord3D> expected( locations.size() );
+	std::vector<Coord3D> placed( locations.size() );
+	Int fullChecks = 0;
+	Int numPlaced = 0;
+	BuildabilityGrid::setEnabled( FALSE );
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for( size_t k = 0; k < locations.size(); ++k )
+	{
+		if( searchPlacement( templates[ k % templates.size() ], &locations[ k ], FALSE, &expected[ k ], &fullChecks ) )
+			++numPlaced;
+		TheTerrainVisual->removeAllBibs();	// isLocationLegalToBuild adds bib feedback, turn it off.
+	}
+	double fullTime = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+	BuildabilityGrid::setEnabled( TRUE );
+
+	// filling the grid in happens once per map and again after immobile objects change, time it apart
+	m_buildabilityGrid.reset();
+	start = std::chrono::steady_clock::now();
+	m_buildabilityGrid.getObstacleAt( 0, 0 );
+	double setupTime = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+
+	Int gridChecks = 0;
+	start = std::chrono::steady_clock::now();
+	for( size_t k = 0; k < locations.size(); ++k )
+	{
+		searchPlacement( templates[ k % templates.size() ], &locations[ k ], TRUE, &placed[ k ], &gridChecks );
+		TheTerrainVisual->removeAllBibs();	// isLocationLegalToBuild adds bib feedback, turn it off.
+	}
+	double gridTime = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+
+	Bool matches = true;
+	for( size_t k = 0; k < locations.size(); ++k )
+	{
+		if( placed[ k ].x != expected[ k ].x || placed[ k ].y != expected[ k ].y || placed[ k ].z != expected[ k ].z )
+			matches = false;
+	}
+
+	const double numSearches = (double)locations.size();
+	printf( "Build placement: %d searches over %d structures, %d placed\n",
+		(Int)locations.size(), (Int)templates.size(), numPlaced );
+	printf( "  full checks %.3f ms per search (%d checks), grid %.3f ms per search (%d checks), grid setup %.3f ms; placements %s\n",
+		fullTime / numSearches, fullChecks, gridTime / numSearches, gridChecks, setupTime,
+		matches ? "match" : "DO NOT MATCH" );
+	fflush( stdout );
+
+	return matches;
+
+}
+
 //-------------------------------------------------------------------------------------------------
 /** Adds bibs to structures near to worldPos */
 //-------------------------------------------------------------------------------------------------
@@ -4148,6 +4148,10 @@ void Drawable::setPosition(const Coord3D *pos)
 //-------------------------------------------------------------------------------------------------
 void Drawable::reactToTransformChange(const Matrix3D* oldMtx, const Coord3D* oldPos, Real oldAngle)
 {
+	// GeneralsX @performance 18/10/2026 Move to the grid cell of the new position.
+	if (TheGameClient)	// WB has no GameClient!
+		TheGameClient->notifyDrawableMoved(this);
+
 	for (DrawModule** dm = getDrawModules(); *dm; ++dm)
 	{
 		(*dm)->reactToTransformChange(oldMtx, oldPos, oldAngle);
@@ -587,6 +587,13 @@ static void saveOptions()
 		TheRecorder->setArchiveEnabled(enabled);
 	}
 
+	// GeneralsX @todo Add checkbox ?
+	{
+		Bool enabled = pref->getCompactReplaysEnabled();
+		(*pref)["CompactReplays"] = enabled ? "yes" : "no";
+		TheRecorder->setCompactReplaysEnabled(enabled);
+	}
+
 	//-------------------------------------------------------------------------------------------------
 	// scroll speed val
 	val = GadgetSliderGetPosition(sliderScrollSpeed);
@@ -194,6 +194,8 @@ GameWindowManager::GameWindowManager()
 	m_cursorBitmap = nullptr;
 	m_captureFlags = 0;
 
+	m_useWindowIdMap = TRUE;
+
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -310,6 +312,10 @@ void GameWindowManager::insertWindowAheadOf( GameWindow *window,
 	if( window == nullptr )
 		return;
 
+	// the hit grid of the parent doesn't know about the new child yet
+	if( aheadOf && aheadOf->winGetParent() )
+		aheadOf->winGetParent()->childLayoutChanged();
+
 	// we'll say that an aheadOf window means at the head of the list
 	if( aheadOf == nullptr )
 	{
@@ -386,6 +392,8 @@ void GameWindowManager::unlinkWindow( GameWindow *window )
 void GameWindowManager::unlinkChildWindow( GameWindow *window )
 {
 
+	window->parentLayoutChanged();
+
 	if( window->m_prev )
 	{
 
@@ -487,6 +495,8 @@ void GameWindowManager::addWindowToParent( GameWindow *window,
 	if( parent )
 	{
 
+		parent->childLayoutChanged();
+
 		// add to parent's list of children
 		window->m_prev = nullptr;
 		window->m_next = parent->m_child;
@@ -513,6 +523,8 @@ void GameWindowManager::addWindowToParentAtEnd( GameWindow *window,
 	if( parent )
 	{
 
+		parent->childLayoutChanged();
+
 		window->m_prev = nullptr;
 		window->m_next = nullptr;
 		if( parent->m_child )
@@ -657,6 +669,23 @@ GameWindow *GameWindowManager::winGetWindowFromId( GameWindow *window, Int id )
 	if( window == nullptr )
 		window = m_windowList;
 
+	if( m_useWindowIdMap == FALSE )
+		return findWindowFromIdInTree( window, id );
+
+	GameWindow *found = findWindowFromIdInRegistry( window, id );
+	DEBUG_ASSERTCRASH( found == findWindowFromIdInTree( window, id ),
+										 ("winGetWindowFromId(): the window id registry is out of date for id %d", id) );
+	return found;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Search 'window', the windows after it and all their children for the
+	* first window with the id, depth first */
+//-------------------------------------------------------------------------------------------------
+GameWindow *GameWindowManager::findWindowFromIdInTree( GameWindow *window, Int id )
+{
+
 	for( ; window; window = window->m_next )
 	{
 
@@ -664,7 +693,7 @@ GameWindow *GameWindowManager::winGetWindowFromId( GameWindow *window, Int id )
 			return window;
 		else if( window->m_child )
 		{
-			GameWindow *child = winGetWindowFromId( window->m_child, id );
+			GameWindow *child = findWindowFromIdInTree( window->m_child, id );
 
 			if( child )
 				return child;
@@ -677,6 +706,140 @@ GameWindow *GameWindowManager::winGetWindowFromId( GameWindow *window, Int id )
 
 }
 
+//-------------------------------------------------------------------------------------------------
+/** Look the id up in the registry, and find which of the windows with it
+	* the tree search from 'window' would reach */
+//-------------------------------------------------------------------------------------------------
+GameWindow *GameWindowManager::findWindowFromIdInRegistry( GameWindow *window, Int id )
+{
+	// more windows sharing an id than this are searched for in the tree
+	const size_t MAX_ID_CANDIDATES = 8;
+
+	if( window == nullptr )
+		return nullptr;
+
+	WindowIdMap::const_iterator it = m_windowIdMap.find( id );
+	if( it == m_windowIdMap.end() )
+		return nullptr;
+
+	const GameWindowVector &windows = it->second;
+	if( windows.size() > MAX_ID_CANDIDATES )
+		return findWindowFromIdInTree( window, id );
+
+	GameWindow *found = nullptr;
+	for( size_t i = 0; i < windows.size(); ++i )
+	{
+
+		if( isInIdSearchScope( windows[ i ], window ) == FALSE )
+			continue;
+
+		// only the tree search knows which of two comes first
+		if( found )
+			return findWindowFromIdInTree( window, id );
+
+		found = windows[ i ];
+
+	}
+
+	return found;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Would the tree search from 'window' reach 'found'? It does if an ancestor
+	* of 'found', or 'found' itself, is 'window' or one of the windows after it */
+//-------------------------------------------------------------------------------------------------
+Bool GameWindowManager::isInIdSearchScope( GameWindow *found, GameWindow *window )
+{
+	GameWindow *level = found;
+
+	// climb to the level of the sibling list 'window' is on
+	while( level && level->m_parent != window->m_parent )
+		level = level->m_parent;
+
+	if( level == nullptr )
+		return FALSE;
+
+	for( ; window; window = window->m_next )
+	{
+
+		if( window == level )
+			return TRUE;
+
+	}
+
+	return FALSE;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** File a window under its current id */
+//-------------------------------------------------------------------------------------------------
+void GameWindowManager::registerWindowId( GameWindow *window )
+{
+
+	m_windowIdMap[ window->winGetWindowId() ].push_back( window );
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Take a window out of the registry */
+//-------------------------------------------------------------------------------------------------
+Bool GameWindowManager::unregisterWindowId( GameWindow *window, Int id )
+{
+
+	WindowIdMap::iterator it = m_windowIdMap.find( id );
+	if( it == m_windowIdMap.end() )
+		return FALSE;
+
+	// windows are usually re-filed or destroyed soon after they are created, look from the back
+	GameWindowVector &windows = it->second;
+	for( size_t i = windows.size(); i > 0; --i )
+	{
+
+		if( windows[ i - 1 ] == window )
+		{
+
+			windows[ i - 1 ] = windows.back();
+			windows.pop_back();
+			if( windows.empty() )
+				m_windowIdMap.erase( it );
+			return TRUE;
+
+		}
+
+	}
+
+	return FALSE;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** The id of a window changed, file it under the new one. Destroyed windows
+	* are not in the registry and stay out of it */
+//-------------------------------------------------------------------------------------------------
+void GameWindowManager::winIdChanged( GameWindow *window, Int oldId )
+{
+
+	if( window->winGetWindowId() == oldId )
+		return;
+
+	if( unregisterWindowId( window, oldId ) )
+		registerWindowId( window );
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Turn the window id registry and the child hit grids on or off */
+//-------------------------------------------------------------------------------------------------
+void GameWindowManager::setLookupAccelerationEnabled( Bool enabled )
+{
+
+	m_useWindowIdMap = enabled;
+	GameWindowHitGrid::setEnabled( enabled );
+
+}
+
 //-------------------------------------------------------------------------------------------------
 /** Gets the Window List Pointer */
 //-------------------------------------------------------------------------------------------------
@@ -1353,6 +1516,8 @@ GameWindow *GameWindowManager::winCreate( GameWindow *parent,
 
 	}
 
+	registerWindowId( window );
+
 	// If this is a child window add it to the parent's window list
 	if( parent )
 		addWindowToParent( window, parent );
@@ -1414,6 +1579,7 @@ Int GameWindowManager::winDestroy( GameWindow *window )
 		return WIN_ERR_OK;
 
 	BitSet( window->m_status, WIN_STATUS_DESTROYED );
+	unregisterWindowId( window, window->winGetWindowId() );
 	window->freeImages();
 
 	if( m_mouseCaptor == window )
@@ -564,14 +564,14 @@ Object *AIPlayer::buildStructureWithDozer(const ThingTemplate *bldgPlan, BuildLi
 					if (isSkirmishAI()) xPos += PATHFIND_CELL_SIZE_F;
 					newPos.x = xPos;
 					newPos.y = yPos;
-					valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, bldgPlan, angle,
+					valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, bldgPlan, angle,
 																							 BuildAssistant::CLEAR_PATH |
 																							 BuildAssistant::TERRAIN_RESTRICTIONS |
 																							 BuildAssistant::NO_OBJECT_OVERLAP,
 																							 dozer, m_player ) == LBC_OK;
 					if (valid) break;
 					newPos.y = yPos+posOffset;
-					valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, bldgPlan, angle,
+					valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, bldgPlan, angle,
 																							 BuildAssistant::CLEAR_PATH |
 																							 BuildAssistant::TERRAIN_RESTRICTIONS |
 																							 BuildAssistant::NO_OBJECT_OVERLAP,
@@ -583,14 +583,14 @@ Object *AIPlayer::buildStructureWithDozer(const ThingTemplate *bldgPlan, BuildLi
 					if (isSkirmishAI()) yPos += PATHFIND_CELL_SIZE_F;
 					newPos.x = xPos;
 					newPos.y = yPos;
-					valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, bldgPlan, angle,
+					valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, bldgPlan, angle,
 																							 BuildAssistant::CLEAR_PATH |
 																							 BuildAssistant::TERRAIN_RESTRICTIONS |
 																							 BuildAssistant::NO_OBJECT_OVERLAP,
 																							 dozer, m_player ) == LBC_OK;
 					if (valid) break;
 					newPos.x = xPos+posOffset;
-					valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, bldgPlan, angle,
+					valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, bldgPlan, angle,
 																							 BuildAssistant::CLEAR_PATH |
 																							 BuildAssistant::TERRAIN_RESTRICTIONS |
 																							 BuildAssistant::NO_OBJECT_OVERLAP,
@@ -1808,7 +1808,7 @@ void AIPlayer::buildBySupplies(Int minimumCash, const AsciiString& thingName)
 				for (xPos = location.x-offset; xPos <= location.x+offset; xPos+=PATHFIND_CELL_SIZE_F) {
 					newPos.x = xPos;
 					newPos.y = yPos;
-					valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, tTemplate, angle,
+					valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, tTemplate, angle,
 																							 BuildAssistant::CLEAR_PATH |
 																							 BuildAssistant::TERRAIN_RESTRICTIONS |
 																							 BuildAssistant::NO_OBJECT_OVERLAP,
@@ -1817,7 +1817,7 @@ void AIPlayer::buildBySupplies(Int minimumCash, const AsciiString& thingName)
 					if( TheGlobalData->m_debugSupplyCenterPlacement )
 						DEBUG_LOG(("buildBySupplies -- Fail at (%.2f,%.2f)", newPos.x, newPos.y));
 					newPos.y = yPos+posOffset;
-					valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, tTemplate, angle,
+					valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, tTemplate, angle,
 																							 BuildAssistant::CLEAR_PATH |
 																							 BuildAssistant::TERRAIN_RESTRICTIONS |
 																							 BuildAssistant::NO_OBJECT_OVERLAP,
@@ -1830,7 +1830,7 @@ void AIPlayer::buildBySupplies(Int minimumCash, const AsciiString& thingName)
 				for (yPos = location.y-offset; yPos <= location.y+offset; yPos+=PATHFIND_CELL_SIZE_F) {
 					newPos.x = xPos;
 					newPos.y = yPos;
-					valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, tTemplate, angle,
+					valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, tTemplate, angle,
 																							 BuildAssistant::CLEAR_PATH |
 																							 BuildAssistant::TERRAIN_RESTRICTIONS |
 																							 BuildAssistant::NO_OBJECT_OVERLAP,
@@ -1839,7 +1839,7 @@ void AIPlayer::buildBySupplies(Int minimumCash, const AsciiString& thingName)
 					if( TheGlobalData->m_debugSupplyCenterPlacement )
 						DEBUG_LOG(("buildBySupplies -- Fail at (%.2f,%.2f)", newPos.x, newPos.y));
 					newPos.x = xPos+posOffset;
-					valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, tTemplate, angle,
+					valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, tTemplate, angle,
 																							 BuildAssistant::CLEAR_PATH |
 																							 BuildAssistant::TERRAIN_RESTRICTIONS |
 																							 BuildAssistant::NO_OBJECT_OVERLAP,
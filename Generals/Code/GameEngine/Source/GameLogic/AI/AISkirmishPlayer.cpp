@@ -682,7 +682,7 @@ void AISkirmishPlayer::buildAIBaseDefenseStructure(const AsciiString &thingName,
 		/* See if we can build there. */
 		Bool canBuild;
 		Real placeAngle = tTemplate->getPlacementViewAngle();
-		canBuild = LBC_OK == TheBuildAssistant->isLocationLegalToBuild(&buildPos, tTemplate, placeAngle,
+		canBuild = LBC_OK == TheBuildAssistant->isCandidateLocationLegalToBuild(&buildPos, tTemplate, placeAngle,
 			BuildAssistant::TERRAIN_RESTRICTIONS|BuildAssistant::NO_OBJECT_OVERLAP, nullptr, m_player);
 		TheTerrainVisual->removeAllBibs();	// isLocationLegalToBuild adds bib feedback, turn it off.  jba.
 		if (flank) {
@@ -38,6 +38,20 @@
 /* ********* PolygonTrigger class ****************************/
 PolygonTrigger *PolygonTrigger::ThePolygonTriggerListPtr = nullptr;
 Int PolygonTrigger::s_currentID = 1;
+std::vector<PolygonTrigger*> PolygonTrigger::s_bucketTriggers;
+std::vector<Int> PolygonTrigger::s_bucketStarts;
+IRegion2D PolygonTrigger::s_bucketBounds;
+Int PolygonTrigger::s_bucketCellSize = 1;
+Int PolygonTrigger::s_bucketWidth = 0;
+Int PolygonTrigger::s_bucketHeight = 0;
+Bool PolygonTrigger::s_bucketsNeedUpdate = true;
+
+// GeneralsX @performance 18/10/2026 A trigger is covered by at most this many cells per side,
+// and the buckets cover the map with at most this many buckets per side.
+static const Int MAX_COVERAGE_CELLS = 32;
+static const Int MIN_COVERAGE_CELL_SIZE = 4;
+static const Int MAX_TRIGGER_BUCKETS = 64;
+static const Int MIN_TRIGGER_BUCKET_SIZE = 10*MAP_XY_FACTOR;
 /**
  PolygonTrigger - Constructor.
 */
@@ -49,7 +63,10 @@ m_sizePoints(0),
 m_exportWithScripts(false),
 m_isWaterArea(false),
 m_isRiver(FALSE),
-m_riverStart(0)
+m_riverStart(0),
+m_coverageCellSize(1),
+m_coverageWidth(0),
+m_coverageNeedsUpdate(true)
 {
 	if (initialAllocation < 2) initialAllocation = 2;
 	m_points = NEW ICoord3D[initialAllocation];		// pool[]ify
@@ -285,6 +302,7 @@ void PolygonTrigger::addPolygonTrigger(PolygonTrigger *pTrigger)
 	}
 	pTrigger->m_nextPolygonTrigger = ThePolygonTriggerListPtr;
 	ThePolygonTriggerListPtr = pTrigger;
+	s_bucketsNeedUpdate = true;
 }
 
 /**
@@ -310,6 +328,7 @@ void PolygonTrigger::removePolygonTrigger(PolygonTrigger *pTrigger)
 		}
 	}
 	pTrigger->m_nextPolygonTrigger = nullptr;
+	s_bucketsNeedUpdate = true;
 }
 
 /**
@@ -320,6 +339,7 @@ void PolygonTrigger::deleteTriggers()
 	PolygonTrigger *pList = ThePolygonTriggerListPtr;
 	ThePolygonTriggerListPtr = nullptr;
 	s_currentID = 1;
+	s_bucketsNeedUpdate = true;
 	deleteInstance(pList);
 }
 
@@ -337,6 +357,7 @@ void PolygonTrigger::addPoint(const ICoord3D &point)
 	m_points[m_numPoints] = point;
 	m_numPoints++;
 	m_boundsNeedsUpdate = true;
+	invalidateCoverage();
 }
 
 /**
@@ -355,6 +376,10 @@ void PolygonTrigger::setPoint(const ICoord3D &point, Int ndx)
 	if (ndx>m_numPoints) { // Can't skip points.
 		return;
 	}
+	// Changing the water height only moves the points up and down, the coverage stays.
+	if (m_points[ndx].x != point.x || m_points[ndx].y != point.y) {
+		invalidateCoverage();
+	}
 	m_points[ndx] = point;
 	m_boundsNeedsUpdate = true;
 }
@@ -382,6 +407,7 @@ void PolygonTrigger::insertPoint(const ICoord3D &point, Int ndx)
 	m_points[ndx] = point;
 	m_numPoints++;
 	m_boundsNeedsUpdate = true;
+	invalidateCoverage();
 }
 
 /**
@@ -399,6 +425,7 @@ void PolygonTrigger::deletePoint(Int ndx)
 	}
 	m_numPoints--;
 	m_boundsNeedsUpdate = true;
+	invalidateCoverage();
 }
 
 void PolygonTrigger::getCenterPoint(Coord3D* pOutCoord)	const
@@ -439,6 +466,33 @@ Bool PolygonTrigger::pointInTrigger(ICoord3D &point) const
 	if (point.x > m_bounds.hi.x) return false;
 	if (point.y > m_bounds.hi.y) return false;
 
+	// GeneralsX @performance 18/10/2026 Most points are answered by the cell they fall in.
+	if (m_coverageNeedsUpdate) {
+		updateCoverage();
+	}
+	Int cellX = (point.x - m_bounds.lo.x) / m_coverageCellSize;
+	Int cellY = (point.y - m_bounds.lo.y) / m_coverageCellSize;
+	switch (m_coverage[cellY*m_coverageWidth + cellX]) {
+		case COVERAGE_OUTSIDE: return false;
+		case COVERAGE_INSIDE: return true;
+	}
+
+	return pointInTriggerExact(point);
+}
+
+/**
+ PolygonTrigger - pointInTriggerExact.
+*/
+Bool PolygonTrigger::pointInTriggerExact(const ICoord3D &point) const
+{
+	if (m_boundsNeedsUpdate) {
+		updateBounds();
+	}
+	if (point.x < m_bounds.lo.x) return false;
+	if (point.y < m_bounds.lo.y) return false;
+	if (point.x > m_bounds.hi.x) return false;
+	if (point.y > m_bounds.hi.y) return false;
+
 	Bool inside = false;
 	Int i;
 	for (i=0; i<m_numPoints; i++) {
@@ -467,6 +521,183 @@ Bool PolygonTrigger::pointInTrigger(ICoord3D &point) const
 	return inside;
 }
 
+/**
+ PolygonTrigger::updateCoverage - Classifies the cells over the bounds.
+ The exact test counts the edges crossed by a ray from the point to +x, and counts an edge
+ when the point is at or below one end and above the other. As long as no edge comes within
+ a unit of a cell, that count is the same for every point of the cell, so one point
+ decides for all of them.
+*/
+void PolygonTrigger::updateCoverage() const
+{
+	if (m_boundsNeedsUpdate) {
+		updateBounds();
+	}
+	m_coverageNeedsUpdate = false;
+	m_coverage.clear();
+	m_coverageWidth = 0;
+	if (m_numPoints == 0) {
+		return;
+	}
+
+	Int extent = max(m_bounds.hi.x - m_bounds.lo.x, m_bounds.hi.y - m_bounds.lo.y) + 1;
+	m_coverageCellSize = max(MIN_COVERAGE_CELL_SIZE, (extent + MAX_COVERAGE_CELLS - 1) / MAX_COVERAGE_CELLS);
+	m_coverageWidth = (m_bounds.hi.x - m_bounds.lo.x) / m_coverageCellSize + 1;
+	Int height = (m_bounds.hi.y - m_bounds.lo.y) / m_coverageCellSize + 1;
+	m_coverage.assign(m_coverageWidth * height, COVERAGE_OUTSIDE);
+
+	// Mark the cells an edge passes within a unit of.
+	std::vector<Bool> nearEdge(m_coverage.size(), false);
+	Int i;
+	for (i=0; i<m_numPoints; i++) {
+		const ICoord3D &pt1 = m_points[i];
+		const ICoord3D &pt2 = m_points[i==m_numPoints-1 ? 0 : i+1];
+		Int loCellX = max(0, (min(pt1.x, pt2.x) - 1 - m_bounds.lo.x) / m_coverageCellSize);
+		Int loCellY = max(0, (min(pt1.y, pt2.y) - 1 - m_bounds.lo.y) / m_coverageCellSize);
+		Int hiCellX = min(m_coverageWidth - 1, (max(pt1.x, pt2.x) + 1 - m_bounds.lo.x) / m_coverageCellSize);
+		Int hiCellY = min(height - 1, (max(pt1.y, pt2.y) + 1 - m_bounds.lo.y) / m_coverageCellSize);
+		Int64 dx = pt2.x - pt1.x;
+		Int64 dy = pt2.y - pt1.y;
+		for (Int cellY = loCellY; cellY <= hiCellY; cellY++) {
+			for (Int cellX = loCellX; cellX <= hiCellX; cellX++) {
+				// The cell grown by a unit, the edge misses it if all corners are on one side.
+				Int64 x0 = m_bounds.lo.x + cellX*m_coverageCellSize - 1 - pt1.x;
+				Int64 y0 = m_bounds.lo.y + cellY*m_coverageCellSize - 1 - pt1.y;
+				Int64 x1 = x0 + m_coverageCellSize + 1;
+				Int64 y1 = y0 + m_coverageCellSize + 1;
+				Int64 c00 = dx*y0 - dy*x0;
+				Int64 c10 = dx*y0 - dy*x1;
+				Int64 c01 = dx*y1 - dy*x0;
+				Int64 c11 = dx*y1 - dy*x1;
+				if ((c00 > 0 && c10 > 0 && c01 > 0 && c11 > 0) || (c00 < 0 && c10 < 0 && c01 < 0 && c11 < 0)) {
+					continue;
+				}
+				nearEdge[cellY*m_coverageWidth + cellX] = true;
+			}
+		}
+	}
+
+	for (Int cellY = 0; cellY < height; cellY++) {
+		for (Int cellX = 0; cellX < m_coverageWidth; cellX++) {
+			Int cell = cellY*m_coverageWidth + cellX;
+			if (nearEdge[cell]) {
+				m_coverage[cell] = COVERAGE_EXACT;
+				continue;
+			}
+			ICoord3D corner;
+			corner.x = m_bounds.lo.x + cellX*m_coverageCellSize;
+			corner.y = m_bounds.lo.y + cellY*m_coverageCellSize;
+			corner.z = 0;
+			m_coverage[cell] = pointInTriggerExact(corner) ? COVERAGE_INSIDE : COVERAGE_OUTSIDE;
+		}
+	}
+}
+
+/**
+ PolygonTrigger::invalidateCoverage - The points moved across the map.
+*/
+void PolygonTrigger::invalidateCoverage()
+{
+	m_coverageNeedsUpdate = true;
+	s_bucketsNeedUpdate = true;
+}
+
+/**
+ PolygonTrigger::updateBuckets - Buckets the triggers of the list by their bounds.
+*/
+void PolygonTrigger::updateBuckets()
+{
+	s_bucketsNeedUpdate = false;
+	s_bucketTriggers.clear();
+	s_bucketStarts.clear();
+	s_bucketWidth = 0;
+	s_bucketHeight = 0;
+
+	Bool haveBounds = false;
+	PolygonTrigger *pTrig;
+	for (pTrig=getFirstPolygonTrigger(); pTrig; pTrig = pTrig->getNext()) {
+		if (pTrig->m_numPoints == 0) {
+			continue;
+		}
+		if (pTrig->m_boundsNeedsUpdate) {
+			pTrig->updateBounds();
+		}
+		if (!haveBounds) {
+			s_bucketBounds = pTrig->m_bounds;
+			haveBounds = true;
+			continue;
+		}
+		s_bucketBounds.lo.x = min(s_bucketBounds.lo.x, pTrig->m_bounds.lo.x);
+		s_bucketBounds.lo.y = min(s_bucketBounds.lo.y, pTrig->m_bounds.lo.y);
+		s_bucketBounds.hi.x = max(s_bucketBounds.hi.x, pTrig->m_bounds.hi.x);
+		s_bucketBounds.hi.y = max(s_bucketBounds.hi.y, pTrig->m_bounds.hi.y);
+	}
+	if (!haveBounds) {
+		return;
+	}
+
+	Int extent = max(s_bucketBounds.hi.x - s_bucketBounds.lo.x, s_bucketBounds.hi.y - s_bucketBounds.lo.y) + 1;
+	s_bucketCellSize = max(MIN_TRIGGER_BUCKET_SIZE, (extent + MAX_TRIGGER_BUCKETS - 1) / MAX_TRIGGER_BUCKETS);
+	s_bucketWidth = (s_bucketBounds.hi.x - s_bucketBounds.lo.x) / s_bucketCellSize + 1;
+	s_bucketHeight = (s_bucketBounds.hi.y - s_bucketBounds.lo.y) / s_bucketCellSize + 1;
+
+	// Count the triggers per bucket, then fill the buckets in list order.
+	s_bucketStarts.assign(s_bucketWidth*s_bucketHeight + 1, 0);
+	for (Int pass = 0; pass < 2; pass++) {
+		for (pTrig=getFirstPolygonTrigger(); pTrig; pTrig = pTrig->getNext()) {
+			if (pTrig->m_numPoints == 0) {
+				continue;
+			}
+			Int loX = (pTrig->m_bounds.lo.x - s_bucketBounds.lo.x) / s_bucketCellSize;
+			Int loY = (pTrig->m_bounds.lo.y - s_bucketBounds.lo.y) / s_bucketCellSize;
+			Int hiX = (pTrig->m_bounds.hi.x - s_bucketBounds.lo.x) / s_bucketCellSize;
+			Int hiY = (pTrig->m_bounds.hi.y - s_bucketBounds.lo.y) / s_bucketCellSize;
+			for (Int y = loY; y <= hiY; y++) {
+				for (Int x = loX; x <= hiX; x++) {
+					Int bucket = y*s_bucketWidth + x;
+					if (pass == 0) {
+						s_bucketStarts[bucket + 1]++;
+					} else {
+						s_bucketTriggers[s_bucketStarts[bucket]++] = pTrig;
+					}
+				}
+			}
+		}
+		if (pass == 0) {
+			for (size_t i = 1; i < s_bucketStarts.size(); i++) {
+				s_bucketStarts[i] += s_bucketStarts[i-1];
+			}
+			s_bucketTriggers.resize(s_bucketStarts.back());
+		} else {
+			// The fill moved each start to the start of the next bucket, move them back.
+			for (size_t i = s_bucketStarts.size() - 1; i > 0; i--) {
+				s_bucketStarts[i] = s_bucketStarts[i-1];
+			}
+			s_bucketStarts[0] = 0;
+		}
+	}
+}
+
+/**
+ PolygonTrigger::getTriggersAt - The triggers whose bounds may contain the point.
+*/
+PolygonTrigger *const *PolygonTrigger::getTriggersAt(const ICoord3D &point, Int *count)
+{
+	if (s_bucketsNeedUpdate) {
+		updateBuckets();
+	}
+	*count = 0;
+	if (s_bucketWidth == 0) {
+		return nullptr;
+	}
+	if (point.x < s_bucketBounds.lo.x || point.y < s_bucketBounds.lo.y) return nullptr;
+	if (point.x > s_bucketBounds.hi.x || point.y > s_bucketBounds.hi.y) return nullptr;
+
+	Int bucket = ((point.y - s_bucketBounds.lo.y) / s_bucketCellSize)*s_bucketWidth + (point.x - s_bucketBounds.lo.x) / s_bucketCellSize;
+	*count = s_bucketStarts[bucket + 1] - s_bucketStarts[bucket];
+	return *count > 0 ? &s_bucketTriggers[s_bucketStarts[bucket]] : nullptr;
+}
+
 // ------------------------------------------------------------------------------------------------
 const WaterHandle* PolygonTrigger::getWaterHandle()	const
 {
@@ -540,5 +771,6 @@ void PolygonTrigger::xfer( Xfer *xfer )
 // ------------------------------------------------------------------------------------------------
 void PolygonTrigger::loadPostProcess()
 {
+	invalidateCoverage();
 
 }
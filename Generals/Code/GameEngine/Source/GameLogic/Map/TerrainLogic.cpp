@@ -60,6 +60,8 @@
 #include "WWMath/plane.h"
 #include "WWMath/tri.h"
 
+#include <chrono>
+
 
 // GLOBALS ////////////////////////////////////////////////////////////////////////////////////////
 TerrainLogic *TheTerrainLogic = nullptr;
@@ -1011,6 +1013,7 @@ void TerrainLogic::reset()
 	deleteBridges();
 	PolygonTrigger::deleteTriggers();
 	m_numWaterToUpdate = 0;
+	m_heightField.clear();
 
 }
 
@@ -1425,6 +1428,17 @@ Bool TerrainLogic::isClearLineOfSight(const Coord3D& pos, const Coord3D& posOthe
 	return false;
 }
 
+//-------------------------------------------------------------------------------------------------
+/** Only the terrain logic of a device has the terrain to check lines against */
+//-------------------------------------------------------------------------------------------------
+Bool TerrainLogic::benchmarkLineOfSight( [[maybe_unused]] Int checks )
+{
+	// Note that we use printf here because this is run from cmd.
+	printf("Line of sight: not supported by this terrain logic\n");
+	fflush(stdout);
+	return false;
+}
+
 //-------------------------------------------------------------------------------------------------
 /** default get height for terrain logic */
 //-------------------------------------------------------------------------------------------------
@@ -1449,6 +1463,41 @@ Real TerrainLogic::getLayerHeight( Real x, Real y, PathfindLayerEnum layer, Coor
 
 }
 
+//-------------------------------------------------------------------------------------------------
+/** Ground heights of count positions given as separate x and y arrays */
+//-------------------------------------------------------------------------------------------------
+void TerrainLogic::getGroundHeights( const Real *x, const Real *y, Int count, Real *heights ) const
+{
+	if( m_heightField.isBuilt() )
+	{
+		m_heightField.getHeights( x, y, count, heights );
+		return;
+	}
+
+	for( Int i = 0; i < count; ++i )
+		heights[ i ] = getGroundHeight( x[ i ], y[ i ] );
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Only the terrain logic of a device builds the height field to query */
+//-------------------------------------------------------------------------------------------------
+Bool TerrainLogic::benchmarkHeightQueries( [[maybe_unused]] Int queries )
+{
+	// Note that we use printf here because this is run from cmd.
+	printf("Height queries: not supported by this terrain logic\n");
+	fflush(stdout);
+	return false;
+}
+
+//-------------------------------------------------------------------------------------------------
+/** Lowers a height sample. The logic reads its own copy, the visual draws from its own. */
+//-------------------------------------------------------------------------------------------------
+void TerrainLogic::setRawMapHeight( const ICoord2D *gridPos, Int height )
+{
+	m_heightField.lowerRawHeight( gridPos, height );
+	TheTerrainVisual->setRawMapHeight( gridPos, height );
+}
+
 //-------------------------------------------------------------------------------------------------
 /** default isCliffCell for terrain logic */
 //-------------------------------------------------------------------------------------------------
@@ -2202,11 +2251,13 @@ const WaterHandle* TerrainLogic::getWaterHandle( Real x, Real y )
 	iLoc.z = 0;
 
 	// Look for water areas in the polygon triggers
-	for( PolygonTrigger *pTrig = PolygonTrigger::getFirstPolygonTrigger();
-			 pTrig;
-			 pTrig = pTrig->getNext() )
+	// GeneralsX @performance 18/10/2026 Only the triggers bucketed at this location can contain it
+	Int numTriggers = 0;
+	PolygonTrigger *const *triggers = PolygonTrigger::getTriggersAt( iLoc, &numTriggers );
+	for( Int i = 0; i < numTriggers; ++i )
 	{
 
+		const PolygonTrigger *pTrig = triggers[ i ];
 		if( !pTrig->isWaterArea() )
 			continue;
 
@@ -2252,6 +2303,141 @@ const WaterHandle* TerrainLogic::getWaterHandle( Real x, Real y )
 
 }
 
+// ------------------------------------------------------------------------------------------------
+/** Time the water lookups and the script trigger area tests of the polygon triggers at points
+	* spread evenly over the map, with and without the buckets and coverage cells of the triggers.
+	* Returns false if they do not give the same answers. */
+// ------------------------------------------------------------------------------------------------
+Bool TerrainLogic::benchmarkWaterLookups( Int lookups )
+{
+	// Note that we use printf here because this is run from cmd.
+	Int side = 1;
+	while( side * side < lookups )
+		++side;
+
+	Region3D extent;
+	getExtent( &extent );
+	std::vector<ICoord3D> points;
+	points.reserve( side * side );
+	for( Int j = 0; j < side; ++j )
+	{
+		for( Int i = 0; i < side; ++i )
+		{
+			Real x = extent.lo.x + ( extent.hi.x - extent.lo.x ) * ( i + 0.5f ) / side;
+			Real y = extent.lo.y + ( extent.hi.y - extent.lo.y ) * ( j + 0.5f ) / side;
+			ICoord3D iLoc;
+			iLoc.x = REAL_TO_INT_FLOOR( x + 0.5f );
+			iLoc.y = REAL_TO_INT_FLOOR( y + 0.5f );
+			iLoc.z = 0;
+			points.push_back( iLoc );
+		}
+	}
+
+	Int numTriggers = 0;
+	Int numWaterAreas = 0;
+	for( PolygonTrigger *pTrig = PolygonTrigger::getFirstPolygonTrigger(); pTrig; pTrig = pTrig->getNext() )
+	{
+		++numTriggers;
+		if( pTrig->isWaterArea() )
+			++numWaterAreas;
+	}
+
+	// the first lookup builds the buckets and coverage cells, keep that out of the timing
+	Int warmup = 0;
+	PolygonTrigger::getTriggersAt( points[ 0 ], &warmup );
+	for( PolygonTrigger *pTrig = PolygonTrigger::getFirstPolygonTrigger(); pTrig; pTrig = pTrig->getNext() )
+		pTrig->pointInTrigger( points[ 0 ] );
+
+	std::vector<const WaterHandle *> expected( points.size() );
+	std::vector<const WaterHandle *> indexed( points.size() );
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for( size_t k = 0; k < points.size(); ++k )
+	{
+		const WaterHandle *waterHandle = nullptr;
+		Real waterZ = 0.0f;
+		for( PolygonTrigger *pTrig = PolygonTrigger::getFirstPolygonTrigger(); pTrig; pTrig = pTrig->getNext() )
+		{
+			if( pTrig->isWaterArea() && pTrig->pointInTriggerExact( points[ k ] ) && pTrig->getPoint( 0 )->z >= waterZ )
+			{
+				waterZ = pTrig->getPoint( 0 )->z;
+				waterHandle = pTrig->getWaterHandle();
+			}
+		}
+		expected[ k ] = waterHandle;
+	}
+	double linearWaterTime = std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now() - start ).count();
+
+	start = std::chrono::steady_clock::now();
+	for( size_t k = 0; k < points.size(); ++k )
+	{
+		const WaterHandle *waterHandle = nullptr;
+		Real waterZ = 0.0f;
+		Int count = 0;
+		PolygonTrigger *const *triggers = PolygonTrigger::getTriggersAt( points[ k ], &count );
+		for( Int i = 0; i < count; ++i )
+		{
+			const PolygonTrigger *pTrig = triggers[ i ];
+			if( pTrig->isWaterArea() && pTrig->pointInTrigger( points[ k ] ) && pTrig->getPoint( 0 )->z >= waterZ )
+			{
+				waterZ = pTrig->getPoint( 0 )->z;
+				waterHandle = pTrig->getWaterHandle();
+			}
+		}
+		indexed[ k ] = waterHandle;
+	}
+	double indexedWaterTime = std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now() - start ).count();
+	Bool matches = indexed == expected;
+
+	// the script conditions test one trigger area at a time
+	Int exactInside = 0;
+	start = std::chrono::steady_clock::now();
+	for( size_t k = 0; k < points.size(); ++k )
+	{
+		for( PolygonTrigger *pTrig = PolygonTrigger::getFirstPolygonTrigger(); pTrig; pTrig = pTrig->getNext() )
+		{
+			if( pTrig->pointInTriggerExact( points[ k ] ) )
+				++exactInside;
+		}
+	}
+	double exactAreaTime = std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now() - start ).count();
+
+	Int coveredInside = 0;
+	start = std::chrono::steady_clock::now();
+	for( size_t k = 0; k < points.size(); ++k )
+	{
+		for( PolygonTrigger *pTrig = PolygonTrigger::getFirstPolygonTrigger(); pTrig; pTrig = pTrig->getNext() )
+		{
+			if( pTrig->pointInTrigger( points[ k ] ) )
+				++coveredInside;
+		}
+	}
+	double coveredAreaTime = std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now() - start ).count();
+
+	for( size_t k = 0; k < points.size() && matches; ++k )
+	{
+		for( PolygonTrigger *pTrig = PolygonTrigger::getFirstPolygonTrigger(); pTrig; pTrig = pTrig->getNext() )
+		{
+			if( pTrig->pointInTrigger( points[ k ] ) != pTrig->pointInTriggerExact( points[ k ] ) )
+			{
+				matches = false;
+				break;
+			}
+		}
+	}
+	matches = matches && exactInside == coveredInside;
+
+	const double numPoints = (double)points.size();
+	const double numAreaTests = numPoints * MAX( numTriggers, 1 );
+	printf( "Polygon triggers: %d triggers, %d water areas, %d lookups\n", numTriggers, numWaterAreas, (Int)points.size() );
+	printf( "  water lookup: linear %.3f us, bucketed %.3f us; area test: exact %.3f us, covered %.3f us; answers %s\n",
+		linearWaterTime / numPoints, indexedWaterTime / numPoints, exactAreaTime / numAreaTests, coveredAreaTime / numAreaTests,
+		matches ? "match" : "DO NOT MATCH" );
+	fflush( stdout );
+
+	return matches;
+
+}
+
 // ------------------------------------------------------------------------------------------------
 /** Get water handle by name assigned from the editor */
 // ------------------------------------------------------------------------------------------------
@@ -2746,33 +2932,33 @@ void TerrainLogic::flattenTerrain(Object *obj)
 						ICoord2D gridPos;
 						gridPos.x = i;
 						gridPos.y = j;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i-1;
 						gridPos.y = j;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i+1;
 						gridPos.y = j;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i;
 						gridPos.y = j-1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i;
 						gridPos.y = j+1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 
 						//Added the corners so it does a whole 3X3 square... ML
 						gridPos.x = i-1;
 						gridPos.y = j-1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i+1;
 						gridPos.y = j+1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i+1;
 						gridPos.y = j-1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i-1;
 						gridPos.y = j+1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 
 					}
 				}
@@ -2827,33 +3013,33 @@ void TerrainLogic::flattenTerrain(Object *obj)
 						ICoord2D gridPos;
 						gridPos.x = i;
 						gridPos.y = j;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i-1;
 						gridPos.y = j;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i+1;
 						gridPos.y = j;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i;
 						gridPos.y = j-1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i;
 						gridPos.y = j+1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 
 						//Added the corners so it does a whole 3X3 square... ML
 						gridPos.x = i-1;
 						gridPos.y = j-1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i+1;
 						gridPos.y = j+1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i+1;
 						gridPos.y = j-1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 						gridPos.x = i-1;
 						gridPos.y = j+1;
-						TheTerrainVisual->setRawMapHeight(&gridPos, rawDataHeight);
+						setRawMapHeight(&gridPos, rawDataHeight);
 
 
 					}
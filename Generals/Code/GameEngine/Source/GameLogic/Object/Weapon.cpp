@@ -1560,20 +1560,14 @@ WeaponTemplate *WeaponStore::newOverride(WeaponTemplate *weaponTemplate)
 //-------------------------------------------------------------------------------------------------
 void WeaponStore::update()
 {
-	for (std::list<WeaponDelayedDamageInfo>::iterator ddi = m_weaponDDI.begin(); ddi != m_weaponDDI.end(); )
+	// the damage comes out in the order it was set, as it did from the list this used to be
+	UnsignedInt curFrame = TheGameLogic->getFrame();
+	WeaponDelayedDamageInfo ddi;
+	while (m_weaponDDI.popDue(curFrame, ddi))
 	{
-		UnsignedInt curFrame = TheGameLogic->getFrame();
-		if (curFrame >= ddi->m_delayDamageFrame)
-		{
-			// we never do projectile-detonation-damage via this code path.
-			const Bool isProjectileDetonation = false;
-			ddi->m_delayedWeapon->dealDamageInternal(ddi->m_delaySourceID, ddi->m_delayIntendedVictimID, &ddi->m_delayDamagePos, ddi->m_bonus, isProjectileDetonation);
-			ddi = m_weaponDDI.erase(ddi);
-		}
-		else
-		{
-			++ddi;
-		}
+		// we never do projectile-detonation-damage via this code path.
+		const Bool isProjectileDetonation = false;
+		ddi.m_delayedWeapon->dealDamageInternal(ddi.m_delaySourceID, ddi.m_delayIntendedVictimID, &ddi.m_delayDamagePos, ddi.m_bonus, isProjectileDetonation);
 	}
 }
 
@@ -1624,7 +1618,7 @@ void WeaponStore::setDelayedDamage(const WeaponTemplate *weapon, const Coord3D*
 	wi.m_delaySourceID = sourceID;
 	wi.m_delayIntendedVictimID = victimID;
 	wi.m_bonus = bonus;
-	m_weaponDDI.push_back(wi);
+	m_weaponDDI.schedule(whichFrame, wi);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -53,6 +53,7 @@
 #include "Common/GameUtility.h"
 #include "Common/INI.h"
 #include "Common/LatchRestore.h"
+#include "Common/MapLoadBenchmark.h"
 #include "Common/MapObject.h"
 #include "Common/MultiplayerSettings.h"
 #include "Common/OSDisplay.h"
@@ -67,6 +68,7 @@
 #include "Common/ThingFactory.h"
 #include "Common/Team.h"
 #include "Common/ThingTemplate.h"
+#include "Common/UpdateProfiler.h"
 #include "GameClient/Water.h"
 #include "Common/WellKnownKeys.h"
 #include "Common/Xfer.h"
@@ -1073,6 +1075,7 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 #endif
 
 	setLoadingMap( TRUE );
+	MapLoadBenchmark::beginMapLoad();
 
 	if( loadingSaveGame == FALSE )
 	{
@@ -1205,7 +1208,7 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 	//****************************//
 
 	// Get the m_loadScreen for this kind of game
-	if(!m_loadScreen && !(TheRecorder && TheRecorder->getMode() == RECORDERMODETYPE_SIMULATION_PLAYBACK))
+	if(!m_loadScreen && !(TheRecorder && TheRecorder->getMode() == RECORDERMODETYPE_SIMULATION_PLAYBACK) && !MapLoadBenchmark::isRunning())
 	{
 		m_loadScreen = getLoadScreen( loadingSaveGame );
 		if(m_loadScreen && !TheGlobalData->m_headless)
@@ -1234,10 +1237,12 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 	DEBUG_ASSERTCRASH(m_frame == 0, ("framecounter expected to be 0 here"));
 
 	// before loading the map, load the map.ini file in the same directory.
+	MapLoadBenchmark::beginStage(MapLoadBenchmark::STAGE_TERRAIN_LOAD);
 	loadMapINI( TheGlobalData->m_mapName );
 
 	// load a map
 	TheTerrainLogic->loadMap( TheGlobalData->m_mapName, false );
+	MapLoadBenchmark::endStage(MapLoadBenchmark::STAGE_TERRAIN_LOAD);
 	// anytime the world's size changes, must reset the partition mgr
 	//ThePartitionManager->init();
 
@@ -1442,7 +1447,9 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 	updateLoadProgress(LOAD_PROGRESS_POST_PLAYER_LIST_RESET);
 
 	// Tell the script engine that a newe set of scripts is loaded.
+	MapLoadBenchmark::beginStage(MapLoadBenchmark::STAGE_SCRIPT_ENGINE);
 	TheScriptEngine->newMap();
+	MapLoadBenchmark::endStage(MapLoadBenchmark::STAGE_SCRIPT_ENGINE);
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_SCRIPT_ENGINE_NEW_MAP);
@@ -1604,8 +1611,10 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 	setHeight( extent.hi.y - extent.lo.y );
 
 	// anytime the world's size changes, must reset the partition mgr
+	MapLoadBenchmark::beginStage(MapLoadBenchmark::STAGE_PARTITION_MANAGER);
 	ThePartitionManager->init();
 	ThePartitionManager->refreshShroudForLocalPlayer();// Can't do this until after init, and doesn't seem right to do in init
+	MapLoadBenchmark::endStage(MapLoadBenchmark::STAGE_PARTITION_MANAGER);
 
 	TheGhostObjectManager->setLocalPlayerIndex(localPlayer->getPlayerIndex());
 	TheGhostObjectManager->reset();
@@ -1614,7 +1623,9 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 	updateLoadProgress(LOAD_PROGRESS_POST_GHOST_OBJECT_MANAGER_RESET);
 
 	// update the terrain logic now that all is loaded
+	MapLoadBenchmark::beginStage(MapLoadBenchmark::STAGE_TERRAIN_NEW_MAP);
 	TheTerrainLogic->newMap( loadingSaveGame );
+	MapLoadBenchmark::endStage(MapLoadBenchmark::STAGE_TERRAIN_NEW_MAP);
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_TERRAIN_LOGIC_NEW_MAP);
@@ -1674,7 +1685,9 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 
 	// tell the AI about it
 	// Note that it is important that the pathfinder be called before the map objects are loaded.
+	MapLoadBenchmark::beginStage(MapLoadBenchmark::STAGE_PATHFINDER);
 	TheAI->pathfinder()->newMap();
+	MapLoadBenchmark::endStage(MapLoadBenchmark::STAGE_PATHFINDER);
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_PATHFINDER_NEW_MAP);
@@ -1715,6 +1728,8 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 	DEBUG_LOG(("%s", Buf));
 	#endif
 
+	MapLoadBenchmark::beginStage(MapLoadBenchmark::STAGE_MAP_OBJECTS);
+
 	if( loadingSaveGame == FALSE )
 	{
 		Int progressCount = LOAD_PROGRESS_LOOP_ALL_THE_FREAKN_OBJECTS;
@@ -1811,6 +1826,8 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 
 	}
 
+	MapLoadBenchmark::endStage(MapLoadBenchmark::STAGE_MAP_OBJECTS);
+
 	#ifdef DUMP_PERF_STATS
 	GetPrecisionTimer(&endTime64);
 	sprintf(Buf,"After loading objects=%f",((double)(endTime64-startTime64)/(double)(freq64)*1000.0));
@@ -1867,6 +1884,7 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 	// will build and various damage states for all the structures on the map so that we
 	// don't have big pauses when building those objects or switching to those states
 	//
+	MapLoadBenchmark::beginStage(MapLoadBenchmark::STAGE_PRELOAD_ASSETS);
 	if( TheGlobalData->m_preloadAssets )
 	{
 		if (TheGlobalData->m_preloadEverything)
@@ -1879,6 +1897,7 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 			TheGameClient->preloadAssets( TheGlobalData->m_timeOfDay );
 		}
 	}
+	MapLoadBenchmark::endStage(MapLoadBenchmark::STAGE_PRELOAD_ASSETS);
 
 	//put this here somewhat randomly.
 	TheControlBar->hideCommunicator( FALSE );
@@ -1945,7 +1964,9 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 
 	// update partition info - We need to do the initial update so that it can be queried
 	// during the first frame.  jba.
+	MapLoadBenchmark::beginStage(MapLoadBenchmark::STAGE_PARTITION_MANAGER);
 	ThePartitionManager->update();
+	MapLoadBenchmark::endStage(MapLoadBenchmark::STAGE_PARTITION_MANAGER);
 
 	#ifdef DUMP_PERF_STATS
 	GetPrecisionTimer(&endTime64);
@@ -2166,6 +2187,7 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 	//ReAllows quit menu to work during loading scene
 	//setGameLoading(FALSE);
 	setLoadingMap( FALSE );
+	MapLoadBenchmark::endMapLoad();
 
 #ifdef DUMP_PERF_STATS
 	GetPrecisionTimer(&endTime64);
@@ -3298,6 +3320,7 @@ void GameLogic::update()
 {
 	USE_PERF_TIMER(GameLogic_update)
 	PROFILER_SECTION_COLOR(0x4CAF50);
+	UpdateProfiler::SectionScope profileLogicUpdate(UpdateProfiler::SECTION_LOGIC_UPDATE);
 
 	// GeneralsX @bugfix fbraz3 16/07/2026 Lock FPU state before every simulation frame
 	ScopedFPUGuard fpuGuard;
@@ -3345,6 +3368,7 @@ void GameLogic::update()
 
 	// update (execute) scripts
 	{
+		UPDATE_PROFILER_SECTION(UpdateProfiler::SECTION_SCRIPT_ENGINE, "ScriptEngine");
 		TheScriptEngine->UPDATE();
 	}
 
@@ -3357,6 +3381,7 @@ void GameLogic::update()
 	// Note - TerrainLogic update needs to happen after ScriptEngine update, but before object updates.  jba.
 	// This way changes in bridges are noted in the script engine before being cleared in TerrainLogic->update
 	{
+		UPDATE_PROFILER_SECTION(UpdateProfiler::SECTION_TERRAIN_LOGIC, "TerrainLogic");
 		TheTerrainLogic->UPDATE();
 	}
 
@@ -3405,9 +3430,12 @@ void GameLogic::update()
 
 	// process client commands
 	{
+		UPDATE_PROFILER_SECTION(UpdateProfiler::SECTION_COMMAND_LIST, "CommandList");
 		processCommandList( TheCommandList );
 	}
 
+	const Int64 profileModulesStart = UpdateProfiler::beginTiming();
+
 #ifdef ALLOW_NONSLEEPY_UPDATES
 	{
 		for (std::list<UpdateModulePtr>::const_iterator it = m_normalUpdates.begin(); it != m_normalUpdates.end(); ++it)
@@ -3426,6 +3454,8 @@ void GameLogic::update()
 			{
 				USE_PERF_TIMER(GameLogic_update_normal)
 
+				UPDATE_PROFILER_MODULE_ZONE(u);
+				const Int64 profileStart = UpdateProfiler::beginTiming();
 				m_curUpdateModule = u;
 
 				#ifdef DEBUG_LOGGING
@@ -3436,6 +3466,7 @@ void GameLogic::update()
 				#endif
 
 				m_curUpdateModule = nullptr;
+				UpdateProfiler::endModule(u, profileStart, UPDATE_SLEEP_NONE);
 			}
 		}
 	}
@@ -3475,6 +3506,8 @@ void GameLogic::update()
 				USE_PERF_TIMER(GameLogic_update_sleepy)
 
 				//DEBUG_LOG(("calling update %08lx (%d %d)...",update,update->friend_getNextCallFrame(),update->friend_getNextCallPhase()));
+				UPDATE_PROFILER_MODULE_ZONE(u);
+				const Int64 profileStart = UpdateProfiler::beginTiming();
 				m_curUpdateModule = u;
 
 				sleepLen = u->update();
@@ -3483,6 +3516,7 @@ void GameLogic::update()
 					sleepLen = UPDATE_SLEEP_NONE;
 
 				m_curUpdateModule = nullptr;
+				UpdateProfiler::endModule(u, profileStart, sleepLen);
 
 			}
 
@@ -3492,20 +3526,25 @@ void GameLogic::update()
 		}
 	}
 
+	UpdateProfiler::endSection(UpdateProfiler::SECTION_UPDATE_MODULES, profileModulesStart);
+
 	validateSleepyUpdate();
 
 	// update the Artificial Intelligence system
 	{
+		UPDATE_PROFILER_SECTION(UpdateProfiler::SECTION_AI, "AI");
 		TheAI->UPDATE();
 	}
 
 	// production updates
 	{
+		UPDATE_PROFILER_SECTION(UpdateProfiler::SECTION_BUILD_ASSISTANT, "BuildAssistant");
 		TheBuildAssistant->UPDATE();
 	}
 
 	// update partition info
 	{
+		UPDATE_PROFILER_SECTION(UpdateProfiler::SECTION_PARTITION_MANAGER, "PartitionManager");
 		ThePartitionManager->UPDATE();
 	}
 
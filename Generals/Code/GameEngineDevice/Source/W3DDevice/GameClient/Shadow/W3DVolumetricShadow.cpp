@@ -53,6 +53,7 @@
 #include "Common/DrawModule.h"
 #include "W3DDevice/GameClient/W3DVolumetricShadow.h"
 #include "W3DDevice/GameClient/W3DShadow.h"
+#include "W3DDevice/GameClient/W3DShadowSilhouette.h"
 #include "WW3D2/statistics.h"
 #include "GameLogic/TerrainLogic.h"
 #include "WW3D2/dx8caps.h"
@@ -229,9 +230,6 @@ const Int MAX_POLYGON_NEIGHBORS = 3;  // we use nothing but triangles for
 																			// most 3 neighbors
 const Int NO_NEIGHBOR = -1;  // entry value for neighbor when there isn't one
 
-const Byte POLY_VISIBLE	  = 0x01;  // polygon is visible from light
-const Byte POLY_PROCESSED = 0x02;  // this poly has been processed
-
 // STRUCT /////////////////////////////////////////////////////////////////////
 
 // NeighborEdge ---------------------------------------------------------------
@@ -250,7 +248,6 @@ struct  PolyNeighbor
 {
 
 	Short myIndex;  // our polygon index so we know who we are
-	Byte status;  // status flags used when processing neighbors
 	NeighborEdge neighbor[ MAX_POLYGON_NEIGHBORS ];
 
 };
@@ -297,6 +294,8 @@ public:
 	int GetNumPolygon () const {return m_numPolygons;}
 	/// given loaded geometry this builds the polygon neighbor information
 	void buildPolygonNeighbors();
+	/// the faces of this mesh the silhouettes are built from, filled on first use
+	W3DShadowSilhouette &getSilhouette();
 	void buildPolygonNormals()
 	{
 		if (!m_polygonNormals)
@@ -344,6 +343,7 @@ protected:
 	Int m_numPolyNeighbors;  // length of m_polyNeighbors and the number of polygons
 							 // in our current geometry.
 	W3DShadowGeometry *m_parentGeometry; // mesh hierarchy containing this mesh.
+	W3DShadowSilhouette m_silhouette;	///< the faces in separate arrays and the silhouettes built from them
 
 };
 
@@ -816,6 +816,37 @@ PolyNeighbor *W3DShadowGeometryMesh::GetPolyNeighbor( Int polyIndex )
 
 }
 
+// getSilhouette ==============================================================
+// The faces of this mesh and their neighbors, copied from the polygon neighbor
+// information the first time a silhouette is built
+// ============================================================================
+W3DShadowSilhouette &W3DShadowGeometryMesh::getSilhouette()
+{
+	if (m_silhouette.isAllocated())
+		return m_silhouette;
+
+	m_silhouette.allocate( m_numPolygons );
+	for (Int i = 0; i < m_numPolygons; i++)
+	{
+		Short poly[ 3 ];
+		Vector3 vertex;
+		Vector3 normal;
+
+		PolyNeighbor *polyNeighbor = GetPolyNeighbor( i );
+		GetPolygonIndex( i, poly, 3 );
+		GetVertex( poly[ 0 ], &vertex );
+		GetPolygonNormal( i, &normal );
+		m_silhouette.setFace( i, poly, vertex, normal );
+		for (Int j = 0; j < MAX_POLYGON_NEIGHBORS; j++)
+		{
+			const NeighborEdge &neighbor = polyNeighbor->neighbor[ j ];
+			m_silhouette.setNeighbor( i, j, neighbor.neighborIndex, neighbor.neighborEdgeIndex[ 0 ], neighbor.neighborEdgeIndex[ 1 ] );
+		}
+	}
+
+	return m_silhouette;
+}
+
 // buildPolygonNeighbors ======================================================
 // Whenever we set a new geometry we want to build some information about
 // the faces in the new geometry so that we can efficiently traverse across
@@ -2004,12 +2035,6 @@ void W3DVolumetricShadow::updateMeshVolume(Int meshIndex, Int lightIndex, const
 			// source perspective
 			//
 
-			if (m_numSilhouetteIndices[meshIndex] != 0)
-			{	//this silhouette was built before and is being updated.
-				//this probably means it will change again in the future.
-				//make future updates faster by pre-caching face normals.
-				m_geometry->getMesh(meshIndex)->buildPolygonNormals();
-			}
 			resetSilhouette(meshIndex);
 			buildSilhouette(meshIndex, &lightPosObject);
 
@@ -2078,342 +2103,40 @@ void W3DVolumetricShadow::updateMeshVolume(Int meshIndex, Int lightIndex, const
 	}
 }
 
-// addSilhouetteEdge ==========================================================
-// It has been determined that the polygon neighbor in the "neighborIndex"
-// of "visible" needs to be added to the silhouette.  We will add those two
-// vertex indices to the silhouette in the order they were specified in
-// "visible" to assure that the constructed edge is in counter clockwise order
-// ============================================================================
-void W3DVolumetricShadow::addSilhouetteEdge(Int meshIndex, PolyNeighbor *visible, PolyNeighbor *hidden )
-{
-	Int i;
-	Int neighborIndex = 0;
-	Short visibleIndexList[ 3 ];
-	Short edgeStart, edgeEnd;
-
-	W3DShadowGeometryMesh *geomMesh=m_geometry->getMesh(meshIndex);
-
-	// sanity
-	assert( visible && hidden );
-
-	//
-	// which index in the neighbor list of "visible" refers to the
-	// polygon "hidden"
-	//
-	for( i = 0; i < MAX_POLYGON_NEIGHBORS; i++ )
-	{
-
-		if( visible->neighbor[ i ].neighborIndex == hidden->myIndex )
-		{
-
-			neighborIndex = i;
-			break;  // exit for
-
-		}
-
-	}
-
-	// get the three vertex indices of "visible"
-	geomMesh->GetPolygonIndex( visible->myIndex, visibleIndexList, 3 );
-
-	//
-	// we know that 2 of the 3 vertex indices will be present in the edge.
-	// will construct the edge as follows to ensure we have counter
-	// clockwise order.  note that this assumes the vertices of the
-	// polygons specified in the geometry are in counter clockwise order,
-	// which they are
-	//
-	// 1) [ v1  Absent, v2 Present, v3 Present ] -> edge = (v2, v3)
-	// 2) [ v1 Present, v2  Absent, v3 Present ] -> edge = (v3, v1)
-	// 3) [ v1 Present, v2 Present, v3 Absent  ] -> edge = (v1, v2)
-	//
-	if( (visibleIndexList[ 0 ] !=
-			 visible->neighbor[ neighborIndex ].neighborEdgeIndex[ 0 ]) &&
-			(visibleIndexList[ 0 ] !=
-			visible->neighbor[ neighborIndex ].neighborEdgeIndex[ 1 ]) )
-	{
-
-		// case 1 above
-		edgeStart = visibleIndexList[ 1 ];
-		edgeEnd = visibleIndexList[ 2 ];
-
-	}
-	else if( (visibleIndexList[ 1 ] !=
-					 visible->neighbor[ neighborIndex ].neighborEdgeIndex[ 0 ]) &&
-					 (visibleIndexList[ 1 ] !=
-					 visible->neighbor[ neighborIndex ].neighborEdgeIndex[ 1 ]) )
-	{
-
-		// case 2 above
-		edgeStart = visibleIndexList[ 2 ];
-		edgeEnd = visibleIndexList[ 0 ];
-
-	}
-	else
-	{
-
-		// case 3 above
-		edgeStart = visibleIndexList[ 0 ];
-		edgeEnd = visibleIndexList[ 1 ];
-
-	}
-
-	// add to silhouette edge list
-	addSilhouetteIndices(meshIndex, edgeStart, edgeEnd );
-
-}
-
-// addNeighborlessEdges =======================================================
-// Given a polygon neighbor information, it has been determined that this
-// polygon is visible and has edges which are not connected to other
-// polygons, these edges need to be added to the silhouette.  The edge(s)
-// must be added in such an order that we create silhouette edges in a
-// counter clockwise order.
-// ============================================================================
-void W3DVolumetricShadow::addNeighborlessEdges(Int meshIndex, PolyNeighbor *us )
-{
-	Short vertexIndexList[ 3 ];
-	Int i, j;
-	Short edgeStart, edgeEnd;
-	Bool addEdge;
-
-	// sanity
-	assert( us );
-
-	W3DShadowGeometryMesh *geomMesh = m_geometry->getMesh(meshIndex);
-
-	// get the vertex index list from the geometry
-	geomMesh->GetPolygonIndex( us->myIndex, vertexIndexList, 3 );
-
-	//
-	// go through each edge, if these indices to NOT appear TOGETHER in
-	// neighbor list then we must add it.
-	//
-	for( i = 0; i < 3; i++ )
-	{
-
-		// get the edge start and end vertex indices
-		edgeStart = vertexIndexList[ i ];
-		if( i == 2 )
-			edgeEnd = vertexIndexList[ 0 ];  // wraps to begging of list
-		else
-			edgeEnd = vertexIndexList[ i + 1 ];
-
-		// do these two vertices appear in a neighbor list of the poly?
-		addEdge = TRUE;
-		for( j = 0; j < MAX_POLYGON_NEIGHBORS; j++ )
-		{
-
-			if( us->neighbor[ j ].neighborIndex != NO_NEIGHBOR )
-			{
-
-				if( (us->neighbor[ j ].neighborEdgeIndex[ 0 ] == edgeStart &&
-						 us->neighbor[ j ].neighborEdgeIndex[ 1 ] == edgeEnd) ||
-						(us->neighbor[ j ].neighborEdgeIndex[ 1 ] == edgeStart &&
-						 us->neighbor[ j ].neighborEdgeIndex[ 0 ] == edgeEnd) )
-				{
-
-					addEdge = FALSE;
-					break;  // exit for j, no need to search on
-
-				}
-
-			}
-
-		}
-
-		// add the edge if no neighbors have that edge
-		if( addEdge == TRUE )
-		{
-
-			addSilhouetteIndices(meshIndex, edgeStart, edgeEnd );
-
-		}
-
-	}
-
-}
-
-// addSilhouetteIndices =======================================================
-// Add these two indices to the silhouette data
-// ============================================================================
-void W3DVolumetricShadow::addSilhouetteIndices(Int meshIndex, Short edgeStart, Short edgeEnd )
-{
-
-//	DBGPRINTF(( "addSilhouetteIndices: Adding (%d,%d), the storage before the add is = (%d/%d)\n",
-//							edgeStart, edgeEnd, m_numSilhouetteIndices, m_maxSilhouetteEntries ));
-
-	// add to silhouette edge list
-	assert( m_numSilhouetteIndices[meshIndex] < m_maxSilhouetteEntries[meshIndex] );
-	m_silhouetteIndex[meshIndex][ m_numSilhouetteIndices[meshIndex]++ ] = edgeStart;
-	assert( m_numSilhouetteIndices[meshIndex] < m_maxSilhouetteEntries[meshIndex] );
-	m_silhouetteIndex[meshIndex][ m_numSilhouetteIndices[meshIndex]++ ] = edgeEnd;
-
-}
-
 // buildSilhouette ============================================================
 // Given a light position, and our polygon neighbor information this will
 // build the silhouette of the object edges from the given light position
 // ============================================================================
 void W3DVolumetricShadow::buildSilhouette(Int meshIndex, Vector3 *lightPosObject)
 {
-	PolyNeighbor *polyNeighbor;  // the poly we're looking at right now
-	Vector3 normal;  // normal of current polygon
-	Vector3 lightVector;  // vector from light to polygon
-	Bool visibleNeighborless;
-	Int numPolys;  // number of polys in our geometry
 	W3DShadowGeometryMesh *geomMesh;
-	Int i, j;
 	Int meshEdgeStart=0; //index to first edge contributed by specific mesh
-
-	//
-	// go through each of our shadow geometry polygon info and find out
-	// which polys are visible from this light source and which ones are not
-	//
+	Int numIndices;
 
 	geomMesh = m_geometry->getMesh(meshIndex);
 
 	//record where this meshes indices will begin.
 	meshEdgeStart=m_numSilhouetteIndices[meshIndex];
 
-	numPolys = geomMesh->GetNumPolygon();
-	for( i = 0; i < numPolys; i++ )
-	{
-		Short poly[ 3 ];
-		Vector3 vertex;
-
-		// get this polygon neighbor information
-		polyNeighbor = geomMesh->GetPolyNeighbor( i );
-
-		// take this opportunity to initialize our processing flags to zero
-		polyNeighbor->status = 0;
-
-		// get the normal for this polygon
-		geomMesh->GetPolygonNormal( i, &normal );
-
-		// get the vertex indices at this polygon
-		geomMesh->GetPolygonIndex( i, poly, 3 );
-
-		//
-		// find out "lightVector" to this polygon
-		//
-		// since our light source could be very close to the object and that
-		// would change the shadow we are going to say that the light vector
-		// is from the light position to one of the vertices in the polygon.
-		// To be more correct we should use the center of the polygon but
-		// this is a good approximation ... an ever broader approximation that
-		// we could use would be the object center
-		//
-		geomMesh->GetVertex( poly[ 0 ], &vertex );
-		lightVector= vertex - *lightPosObject;
-
-		//
-		// dot the light vector with the normal of the polygon to see if the
-		// poly is visible from this location
-		//
-		if( Vector3::Dot_Product( lightVector, normal ) < 0.0f )
-			BitSet( polyNeighbor->status, POLY_VISIBLE );
-
-	}
-
 	//
-	// check all our polys using our poly neighbors, where one poly neighbor
-	// is not the same visible status as a neighbor that represents a
-	// silhouette edge
+	// the mesh finds the polys visible from this light source and the edges
+	// between them and the ones that are not, or takes them from another
+	// shadow of the same model that was lit from nearly the same place
 	//
-	for( i = 0; i < numPolys; i++ )
+	const std::vector<Short> &edges = geomMesh->getSilhouette().getEdges( *lightPosObject );
+	numIndices = (Int)edges.size();
+	if( meshEdgeStart + numIndices > m_maxSilhouetteEntries[meshIndex] )
 	{
-		PolyNeighbor *otherNeighbor;
-
-		// get this poly neighbor ... this is "us"
-		polyNeighbor = geomMesh->GetPolyNeighbor( i );
-
-		// initialize ourselves to not be a visible edge
-		visibleNeighborless = FALSE;
 
-		// check our 3 potential neighbors
-		for( j = 0; j < MAX_POLYGON_NEIGHBORS; j++ )
-		{
-
-			// initialize this neighbor to nuttin
-			otherNeighbor = nullptr;
-
-			// get our neighbor if present and cull them if processed
-			if( polyNeighbor->neighbor[ j ].neighborIndex != NO_NEIGHBOR )
-			{
-
-				// get the jth polygon neighbor ... this is "them"
-				otherNeighbor =
-					geomMesh->GetPolyNeighbor(
-						polyNeighbor->neighbor[ j ].neighborIndex );
-
-				//
-				// ignore neighbors that are marked as processed as those
-				// ones have already detected edges if present
-				//
-				if( BitIsSet( otherNeighbor->status, POLY_PROCESSED ) )
-					continue;  // for j
-
-			}
-
-			//
-			// finally, if our own visible status is different from our
-			// neighbor visible status then that defines an edge we must
-			// add to the silhouette.  Also, a visible polygon that has
-			// no neighbor automatically makes a silhouette edge.  Note that
-			// if we have no neighbor we just record the fact that we have
-			// real model end edges to add after this inner j loop;
-			//
-			if( BitIsSet( polyNeighbor->status, POLY_VISIBLE ) )
-			{
-
-				// check for no neighbor edges
-				if( otherNeighbor == nullptr )
-				{
-
-					visibleNeighborless = TRUE;
-
-				}
-				else if( BitIsSet( otherNeighbor->status, POLY_VISIBLE ) == FALSE )
-				{
-
-					// "we" are visible and "they" are not
-					addSilhouetteEdge(meshIndex, polyNeighbor, otherNeighbor );
-
-				}
-
-			}
-			else if( otherNeighbor != nullptr &&
-							 BitIsSet( otherNeighbor->status, POLY_VISIBLE ) )
-			{
-
-				// "they" are visible and "we" are not
-				addSilhouetteEdge(meshIndex, otherNeighbor, polyNeighbor );
-
-			}
-
-		}
-
-		//
-		// if this polygon is visible, add any edges that are not
-		// neighbors of adjacent polygons.
-		//
-		if( visibleNeighborless == TRUE )
-		{
-
-			addNeighborlessEdges(meshIndex, polyNeighbor );
-
-		}
-
-		//
-		// this polyNeighbor is now considered "processed", any other
-		// polygons that reference back to this one can ignore their
-		// processing cause any edges were already detected
-		//
-		BitSet( polyNeighbor->status, POLY_PROCESSED );
+		assert( 0 );
+		numIndices = (m_maxSilhouetteEntries[meshIndex] - meshEdgeStart) & ~1;
 
 	}
 
+	if( numIndices > 0 )
+		memcpy( &m_silhouetteIndex[meshIndex][ meshEdgeStart ], &edges[ 0 ], numIndices * sizeof( Short ) );
+	m_numSilhouetteIndices[meshIndex] += numIndices;
+
 	//record number of edge indices contrinuted by this mesh
 	m_numIndicesPerMesh[meshIndex]=m_numSilhouetteIndices[meshIndex]-meshEdgeStart;
 
@@ -3605,6 +3328,7 @@ W3DVolumetricShadowManager::~W3DVolumetricShadowManager()
 	m_W3DShadowGeometryManager = nullptr;
 	delete TheW3DBufferManager;
 	TheW3DBufferManager=nullptr;
+	W3DShadowSilhouette::shutdown();
 
 	//all shadows should be freed up at this point but check anyway
 	assert(m_shadowList==nullptr);
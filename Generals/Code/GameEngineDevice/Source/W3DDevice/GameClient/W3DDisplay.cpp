@@ -85,6 +85,7 @@ static void drawFramerateBar();
 #include "W3DDevice/GameClient/W3DWater.h"
 #include "W3DDevice/GameClient/W3DVideoBuffer.h"
 #include "W3DDevice/GameClient/W3DShaderManager.h"
+#include "W3DDevice/GameClient/W3DShadowSilhouette.h"
 #include "W3DDevice/GameClient/W3DDebugDisplay.h"
 #include "W3DDevice/GameClient/W3DProjectedShadow.h"
 #include "W3DDevice/GameClient/W3DScreenshot.h"
@@ -937,6 +938,9 @@ void W3DDisplay::init()
 		DX8Wrapper::Set_Display_Size_Provider(SDL3_GetNativeDisplaySize, SDL3_GetWindowSizeInPixels);
 #endif
 
+		// GeneralsX @performance 18/10/2026 The texture loader threads start with the render device
+		TextureLoader::Set_Loader_Thread_Count(TheGlobalData->m_textureLoaderThreads);
+
 		if (WW3D::Init( ApplicationHWnd ) != WW3D_ERROR_OK)
 			throw ERROR_INVALID_D3D;	//failed to initialize.  User probably doesn't have DX 8.1
 
@@ -1486,6 +1490,14 @@ void W3DDisplay::gatherDebugStats()
 			TheTerrainRenderObject->getNumShoreLineTiles(FALSE));
 		m_displayStrings[TerrainStats]->setText( unibuffer );
 
+		// text stats
+		unibuffer.format( L"Text Builds: full %d, incremental %d, unchanged %d, extents cached %d",
+			Debug_Statistics::Get_Sentence_Builds(Debug_Statistics::SENTENCE_BUILD_FULL),
+			Debug_Statistics::Get_Sentence_Builds(Debug_Statistics::SENTENCE_BUILD_INCREMENTAL),
+			Debug_Statistics::Get_Sentence_Builds(Debug_Statistics::SENTENCE_BUILD_UNCHANGED),
+			Debug_Statistics::Get_Sentence_Builds(Debug_Statistics::SENTENCE_EXTENTS_CACHE_HIT));
+		m_displayStrings[TextStats]->setText( unibuffer );
+
 		// misc debug info
 		Coord3D camPos = TheTacticalView->getPosition();
 		Real zoom = TheTacticalView->getZoom();
@@ -1896,6 +1908,13 @@ Int W3DDisplay::getLastFrameDrawCalls()
 	return Debug_Statistics::Get_Draw_Calls();
 }
 
+//=============================================================================
+// The silhouettes do not depend on the map or the device, the benchmark builds meshes of its own
+Int W3DDisplay::benchmarkShadowSilhouettes( Int rounds )
+{
+	return W3DShadowSilhouette::benchmark( rounds );
+}
+
 //=============================================================================
 void W3DDisplay::step()
 {
@@ -140,8 +140,10 @@ void W3DDisplayString::notifyTextChanged()
 	m_textChanged = TRUE;
 
 	// reset data for our text renderer
-	m_textRenderer.Reset();
-	m_textRendererHotKey.Reset();
+	// GeneralsX @performance 18/10/2026 Invalidate instead of Reset so the next build can reuse
+	// the surfaces of the old text and only rebuild the part of it that changed.
+	m_textRenderer.Invalidate();
+	m_textRendererHotKey.Invalidate();
 
 }
 
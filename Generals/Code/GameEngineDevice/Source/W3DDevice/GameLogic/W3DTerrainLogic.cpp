@@ -38,9 +38,12 @@
 #include "GameClient/GameClient.h"
 
 #include "GameClient/MapUtil.h"
+#include "GameClient/TerrainVisual.h"
 #include "GameLogic/AI.h"
 #include "GameLogic/AIPathfind.h"
 
+#include <chrono>
+
 
 //-------------------------------------------------------------------------------------------------
 //-------------------------------------------------------------------------------------------------
@@ -153,6 +156,10 @@ Bool W3DTerrainLogic::loadMap( AsciiString filename , Bool query )
 		}
 		m_mapMinZ = minHt * MAP_HEIGHT_SCALE;
 		m_mapMaxZ = maxHt * MAP_HEIGHT_SCALE;
+
+		// GeneralsX @performance 18/10/2026 Keep the samples for the ground height queries
+		m_heightField.build(terrainHeightMap->getDataPtr(), m_mapDX, m_mapDY, terrainHeightMap->getBorderSizeInline());
+
 		//release temporary object used for loading height values
 		REF_PTR_RELEASE(terrainHeightMap);
 	}
@@ -252,11 +259,109 @@ Bool W3DTerrainLogic::isClearLineOfSight(const Coord3D& pos, const Coord3D& posO
 	}
 }
 
+//-------------------------------------------------------------------------------------------------
+/** Times ground height queries through the terrain render object, the height field and its batch,
+	and checks that all three give the same heights and normals to the bit. */
+//-------------------------------------------------------------------------------------------------
+Bool W3DTerrainLogic::benchmarkHeightQueries( Int queries )
+{
+	// Note that we use printf here because this is run from cmd.
+	if (!TheTerrainRenderObject || !m_heightField.isBuilt() || queries <= 0)
+	{
+		printf("Height queries: no terrain to query\n");
+		fflush(stdout);
+		return false;
+	}
+
+	// spread the positions over the map and a bit past its edges, with repeatable fractions
+	Region3D extent;
+	getExtentIncludingBorder(&extent);
+	Real width = extent.hi.x - extent.lo.x + 4 * MAP_XY_FACTOR;
+	Real height = extent.hi.y - extent.lo.y + 4 * MAP_XY_FACTOR;
+	std::vector<Real> x(queries);
+	std::vector<Real> y(queries);
+	UnsignedInt seed = 12345;
+	for (Int i = 0; i < queries; ++i)
+	{
+		seed = seed * 1664525 + 1013904223;
+		x[i] = extent.lo.x - 2 * MAP_XY_FACTOR + width * ((seed >> 8) / 16777216.0f);
+		seed = seed * 1664525 + 1013904223;
+		y[i] = extent.lo.y - 2 * MAP_XY_FACTOR + height * ((seed >> 8) / 16777216.0f);
+	}
+
+	std::vector<Real> renderHeights(queries);
+	std::vector<Coord3D> renderNormals(queries);
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (Int i = 0; i < queries; ++i)
+		renderHeights[i] = TheTerrainRenderObject->getHeightMapHeight(x[i], y[i], nullptr);
+	double renderTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::vector<Real> fieldHeights(queries);
+	start = std::chrono::steady_clock::now();
+	for (Int i = 0; i < queries; ++i)
+		fieldHeights[i] = m_heightField.getHeight(x[i], y[i], nullptr);
+	double fieldTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::vector<Real> batchHeights(queries);
+	start = std::chrono::steady_clock::now();
+	m_heightField.getHeights(&x[0], &y[0], queries, &batchHeights[0]);
+	double batchTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::vector<Real> normalHeights(queries);
+	std::vector<Coord3D> fieldNormals(queries);
+	m_heightField.getHeightsAndNormals(&x[0], &y[0], queries, &normalHeights[0], &fieldNormals[0]);
+	for (Int i = 0; i < queries; ++i)
+		TheTerrainRenderObject->getHeightMapHeight(x[i], y[i], &renderNormals[i]);
+
+	Int numDifferent = 0;
+	for (Int i = 0; i < queries; ++i)
+	{
+		if (memcmp(&renderHeights[i], &fieldHeights[i], sizeof(Real)) != 0
+			|| memcmp(&renderHeights[i], &batchHeights[i], sizeof(Real)) != 0
+			|| memcmp(&renderHeights[i], &normalHeights[i], sizeof(Real)) != 0
+			|| memcmp(&renderNormals[i], &fieldNormals[i], sizeof(Coord3D)) != 0)
+		{
+			numDifferent++;
+		}
+	}
+
+	printf("Height queries: %d queries\n", queries);
+	printf("  terrain render object: %.0f queries/s\n", renderTime > 0.0 ? queries / renderTime : 0.0);
+	printf("  height field: %.0f queries/s\n", fieldTime > 0.0 ? queries / fieldTime : 0.0);
+	printf("  height field batch (%s): %.0f queries/s\n", TerrainHeightField::getBatchName(), batchTime > 0.0 ? queries / batchTime : 0.0);
+	printf("  results %s (%d differ)\n", numDifferent == 0 ? "match" : "DO NOT MATCH", numDifferent);
+	fflush(stdout);
+	return numDifferent == 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+Bool W3DTerrainLogic::benchmarkLineOfSight( Int checks )
+{
+	if (TheTerrainRenderObject)
+	{
+		return TheTerrainRenderObject->benchmarkLineOfSight(checks);
+	}
+	else
+	{
+		// Note that we use printf here because this is run from cmd.
+		printf("Line of sight: no terrain to check\n");
+		fflush(stdout);
+		return false;
+	}
+}
+
 //-------------------------------------------------------------------------------------------------
 /** W3D specific get height function for logical terrain */
 //-------------------------------------------------------------------------------------------------
 Real W3DTerrainLogic::getGroundHeight( Real x, Real y, Coord3D* normal ) const
 {
+	// GeneralsX @performance 18/10/2026 The logic copy of the height samples gives the same heights
+	// as the terrain render object, without going through it.
+	if (m_heightField.isBuilt())
+	{
+		return m_heightField.getHeight(x, y, normal);
+	}
+
 #define USE_THE_TERRAIN_OBJECT
 #ifdef USE_THE_TERRAIN_OBJECT
 	// TheSuperHackers @logic-client-separation helmutbuhler 11/04/2025
@@ -286,7 +391,16 @@ Real W3DTerrainLogic::getLayerHeight( Real x, Real y, PathfindLayerEnum layer, C
 {
 #ifdef USE_THE_TERRAIN_OBJECT
 
-	if (!TheTerrainRenderObject)
+	Real height;
+	if (m_heightField.isBuilt())
+	{
+		height = m_heightField.getHeight(x, y, normal);
+	}
+	else if (TheTerrainRenderObject)
+	{
+		height = TheTerrainRenderObject->getHeightMapHeight(x,y,normal);
+	}
+	else
 	{
 		if (normal)
 		{
@@ -298,8 +412,6 @@ Real W3DTerrainLogic::getLayerHeight( Real x, Real y, PathfindLayerEnum layer, C
 		return 0;
 	}
 
-	Real height = TheTerrainRenderObject->getHeightMapHeight(x,y,normal);
-
 	if (layer != LAYER_GROUND)
 	{
 		Coord3D loc;
@@ -382,4 +494,13 @@ void W3DTerrainLogic::loadPostProcess()
 	// extend base class
 	TerrainLogic::loadPostProcess();
 
+	// GeneralsX @performance 18/10/2026 The save game holds the height samples of the terrain visual,
+	// which may have been flattened under buildings since the map was loaded.
+	WorldHeightMap *logicHeightMap = TheTerrainVisual ? TheTerrainVisual->getLogicHeightMap() : nullptr;
+	if (logicHeightMap)
+	{
+		m_heightField.build(logicHeightMap->getDataPtr(), logicHeightMap->getXExtent(),
+			logicHeightMap->getYExtent(), logicHeightMap->getBorderSizeInline());
+	}
+
 }
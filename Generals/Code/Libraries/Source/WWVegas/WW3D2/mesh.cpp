@@ -494,6 +494,12 @@ void	MeshClass::Get_Deformed_Vertices(Vector3 *dst_vert, Vector3 *dst_norm)
 	Model->get_deformed_vertices(dst_vert,dst_norm,Container->Get_HTree());
 }
 
+void	MeshClass::Get_Deformed_Vertices(Vector3 *dst_vert, Vector3 *dst_norm, int first_vertex, int vertex_count)
+{
+	WWASSERT(Model->Get_Flag(MeshGeometryClass::SKIN));
+	Model->get_deformed_vertices(dst_vert,dst_norm,Container->Get_HTree(),first_vertex,vertex_count);
+}
+
 
 /***********************************************************************************************
  * MeshClass::Get_Deformed_Vertices -- Gets the deformed vertices for a skin                   *
@@ -272,11 +272,22 @@ void MeshModelClass::Shadow_Render(SpecialRenderInfoClass & rinfo,const Matrix3D
 // Destination pointers MUST point to arrays large enough to hold all vertices
 void MeshModelClass::get_deformed_vertices(Vector3 *dst_vert,const HTreeClass * htree)
 {
+	int vertex_count=Get_Vertex_Count();
 	Vector3 * src_vert = Vertex->Get_Array();
 	uint16 * bonelink = VertexBoneLink->Get_Array();
-	for (int vi = 0; vi < Get_Vertex_Count(); vi++) {
-		const Matrix3D & tm = htree->Get_Transform(bonelink[vi]);
-		Matrix3D::Transform_Vector(tm, src_vert[vi], &(dst_vert[vi]));
+
+	// GeneralsX @performance 18/10/2026 Transform each run of vertices on the same bone at once
+	for (int vi = 0; vi < vertex_count;) {
+		int idx=bonelink[vi];
+		int cnt;
+		for (cnt = vi + 1; cnt < vertex_count; cnt++) {
+			if (idx!=bonelink[cnt]) {
+				break;
+			}
+		}
+
+		VectorProcessorClass::Transform(dst_vert+vi,src_vert+vi,htree->Get_Transform(idx),cnt-vi);
+		vi=cnt;
 	}
 }
 
@@ -284,33 +295,35 @@ void MeshModelClass::get_deformed_vertices(Vector3 *dst_vert,const HTreeClass *
 // Destination pointers MUST point to arrays large enough to hold all vertices
 void MeshModelClass::get_deformed_vertices(Vector3 *dst_vert, Vector3 *dst_norm,const HTreeClass * htree)
 {
-	int vi;
-	int vertex_count=Get_Vertex_Count();
-	Vector3 * src_vert = Vertex->Get_Array();
+	get_deformed_vertices(dst_vert,dst_norm,htree,0,Get_Vertex_Count());
+}
+
+
+// Destination pointers MUST point to arrays large enough to hold vertex_count vertices
+void MeshModelClass::get_deformed_vertices(Vector3 *dst_vert, Vector3 *dst_norm,const HTreeClass * htree, int first_vertex, int vertex_count)
+{
+	WWASSERT(first_vertex >= 0 && first_vertex + vertex_count <= Get_Vertex_Count());
+
+	const Vector3 * src_vert = Vertex->Get_Array() + first_vertex;
 #if (OPTIMIZE_VNORMS)
-	Vector3 * src_norm = (Vector3 *)Get_Vertex_Normal_Array();
+	const Vector3 * src_norm = (const Vector3 *)Get_Vertex_Normal_Array() + first_vertex;
 #else
-	Vector3 * src_norm = VertexNorm->Get_Array();
+	const Vector3 * src_norm = VertexNorm->Get_Array() + first_vertex;
 #endif
-	uint16 * bonelink = VertexBoneLink->Get_Array();
-
-	for (vi = 0; vi < vertex_count;) {
-		const Matrix3D & tm = htree->Get_Transform(bonelink[vi]);
-
-		// Make a copy so we can set the translation to zero
-		Matrix3D mytm=tm;
+	const uint16 * bonelink = VertexBoneLink->Get_Array() + first_vertex;
 
+	// GeneralsX @performance 18/10/2026 The vertices are sorted by bone. Each run of vertices on the
+	// same bone is transformed in one batch, the normals in the same pass by the bone rotation.
+	for (int vi = 0; vi < vertex_count;) {
 		int idx=bonelink[vi];
 		int cnt;
-		for (cnt = vi; cnt < vertex_count; cnt++) {
+		for (cnt = vi + 1; cnt < vertex_count; cnt++) {
 			if (idx!=bonelink[cnt]) {
 				break;
 			}
 		}
 
-		VectorProcessorClass::Transform(dst_vert+vi,src_vert+vi,mytm,cnt-vi);
-		mytm.Set_Translation(Vector3(0.0f,0.0f,0.0f));
-		VectorProcessorClass::Transform(dst_norm+vi,src_norm+vi,mytm,cnt-vi);
+		VectorProcessorClass::Transform_Skinned(dst_vert+vi,dst_norm+vi,src_vert+vi,src_norm+vi,htree->Get_Transform(idx),cnt-vi);
 		vi=cnt;
 	}
 }
@@ -34,6 +34,7 @@
 #include "Common/STLTypedefs.h"
 #include "Lib/BaseType.h"
 #include "Common/SubsystemInterface.h"
+#include "Common/BuildabilityGrid.h"
 #include "GameLogic/Object.h"
 
 // FORWARD DECLARATIONS ///////////////////////////////////////////////////////////////////////////
@@ -135,7 +136,8 @@ public:
 												 const Coord3D *worldPos,
 												 Real sampleResolution,
 												 IterateFootprintFunc func,
-												 void *funcUserData );
+												 void *funcUserData,
+												 Bool sampleHeights = TRUE );	// when FALSE the sample points are passed with a z of 0
 
 	/// create object from a build and put it in the world now
 	virtual Object *buildObjectNow( Object *constructorObject, const ThingTemplate *what,
@@ -154,6 +156,16 @@ public:
 																								 const Object *builderObject,
 																								 Player *player);
 
+	/// query if we can build at this location, for searches that try many locations and only need to know
+	/// if one is legal. Locations the buildability grid shows blocked fail without running all the checks,
+	/// so the reason of a failure may not be the one isLocationLegalToBuild gives.
+	virtual LegalBuildCode isCandidateLocationLegalToBuild( const Coord3D *worldPos,
+																													const ThingTemplate *build,
+																													Real angle,
+																													UnsignedInt options,
+																													const Object *builderObject,
+																													Player *player );
+
 	/// query if we can build at this location
 	virtual LegalBuildCode isLocationClearOfObjects( const Coord3D *worldPos,
 																								 const ThingTemplate *build,
@@ -190,6 +202,12 @@ public:
 
 	void xferTheSellList(Xfer *xfer );
 
+	/// an object was placed, moved or removed from the partition manager
+	void objectFootprintChanged( const Object *obj );
+
+	/// times AI placement searches on the loaded map with and without the buildability grid, see -benchmarkBuildPlacement
+	Bool benchmarkPlacement( Int searches );
+
 protected:
 
 	/// some objects will be "cleared" automatically when constructing
@@ -204,9 +222,18 @@ protected:
 	Bool moveObjectsForConstruction( const ThingTemplate *whatToBuild,
 																	 const Coord3D *pos, Real angle, Player *playerToBuild );
 
+	/// whether the buildability grid shows that isLocationLegalToBuild fails at this location
+	Bool isLocationKnownIllegalToBuild( const Coord3D *worldPos, const ThingTemplate *build,
+																			Real angle, UnsignedInt options );
+
+	/// the placement search AIPlayer makes around a location, for benchmarkPlacement
+	Bool searchPlacement( const ThingTemplate *build, const Coord3D *location, Bool useGrid,
+												Coord3D *result, Int *fullChecks );
+
 	Coord3D *m_buildPositions;			///< array used to create a line of build locations (think walls)
 	Int m_buildPositionSize;				///< number of elements in the build position array
 	ObjectSellList m_sellList;			///< list of objects currently going through the "sell process"
+	BuildabilityGrid m_buildabilityGrid;	///< terrain and immobile objects that stop construction in each cell
 
 };
 
@@ -360,6 +360,31 @@ public:
 
 	std::vector<AsciiString> m_simulateReplays; ///< If not empty, simulate this list of replays and exit.
 	Int m_simulateReplayJobs; ///< Maximum number of processes to use for simulation, or SIMULATE_REPLAYS_SEQUENTIAL for sequential simulation
+	std::vector<AsciiString> m_benchmarkMapLoads; ///< If not empty, load this list of maps, report the load times and exit.
+	AsciiString m_benchmarkMapLoadReport; ///< CSV file the map load times are written to, if not empty
+	Int m_benchmarkPathfindZones; ///< If not 0, time the pathfind zone calculations this many times on each benchmarked map
+	Int m_benchmarkWaterLookups; ///< If not 0, time this many water lookups and trigger area tests on each benchmarked map
+	Int m_benchmarkLineOfSight; ///< If not 0, time this many terrain line of sight checks on each benchmarked map
+	Int m_benchmarkHeightQueries; ///< If not 0, time this many ground height queries on each benchmarked map
+	Int m_benchmarkBuildPlacement; ///< If not 0, time this many AI structure placement searches on each benchmarked map
+	Int m_benchmarkWaterGrid; ///< If not 0, time this many water grid motion steps on each benchmarked map
+	Int m_benchmarkMessages; ///< If not 0, send this many messages through the message stream, report the throughput and exit.
+	std::vector<AsciiString> m_convertReplays; ///< If not empty, convert this list of replays to the compact format, check them and exit.
+	Bool m_compressConvertedReplays; ///< If true, the converted replays are compressed
+	Int m_benchmarkNetworkPlayers; ///< If not 0, run this many network clients over a simulated network, report the results and exit.
+	Int m_benchmarkNetworkFrames; ///< Number of frames the network clients play
+	Int m_benchmarkNetworkLatency; ///< One way latency of the simulated network, in ms
+	Int m_benchmarkNetworkJitter; ///< Random latency added to each packet of the simulated network, up to this many ms
+	Int m_benchmarkNetworkLoss; ///< Percent of the packets the simulated network drops
+	Int m_benchmarkNetworkReorder; ///< Percent of the packets the simulated network delivers out of order
+	AsciiString m_archiveTraceFile; ///< If not empty, the archived files are written to this file in the order they are first opened
+	AsciiString m_updateProfileFile; ///< If not empty, the cost of the logic updates is written to this file after simulating replays
+	Int m_textureLoaderThreads; ///< Number of threads decoding textures in the background, 0 for one less than the number of cores
+	Int m_benchmarkTextureThreads; ///< If not 0, decode all textures with 1 up to this many threads, report the throughput and exit.
+	Int m_benchmarkWindowLookups; ///< If not 0, look windows up by id and position this many rounds, report the timings and exit.
+	Int m_benchmarkStrings; ///< If not 0, build and compare strings with and without the small string buffers and interning this many rounds, report the allocations and timings and exit.
+	Int m_benchmarkShadowSilhouettes; ///< If not 0, build and check shadow silhouettes from this many rounds of lights, report the timings and exit.
+	Int m_benchmarkVideoFrames; ///< If not 0, play this many frames of each video with and without decoding ahead, report the latencies and exit.
 
 	Int m_maxParticleCount;						///< maximum number of particles that can exist
 	Int m_maxFieldParticleCount;			///< maximum number of field-type particles that can exist (roughly)
@@ -537,7 +537,8 @@ public:
 	// these are intended ONLY for the private use of ThingFactory and do not use
 	// the m_override pointer, it deals only with templates at the "top" level
 	//
-	void friend_setTemplateName( const AsciiString& name ) { m_nameString = name; }
+	// GeneralsX @performance 18/10/2026 Template names are interned, so comparing them is a pointer check
+	void friend_setTemplateName( const AsciiString& name ) { m_nameString = name; m_nameString.intern(); }
 	ThingTemplate *friend_getNextTemplate() const { return m_nextThingTemplate; }
 	void friend_setNextTemplate(ThingTemplate *tmplate) { m_nextThingTemplate = tmplate; }
 	void friend_setTemplateID(UnsignedShort id) { m_templateID = id; }
@@ -96,6 +96,8 @@ public:
 
 	virtual void setFrame( UnsignedInt frame ) { m_frame = frame; }			///< Set the GameClient's internal frame number
 	virtual void registerDrawable( Drawable *draw );										///< Given a drawable, register it with the GameClient and give it a unique ID
+	void notifyDrawableMoved( Drawable *draw ) { m_drawableGrid.updateDrawable( draw ); }	///< Keep the drawable grid up to date with the drawable's position
+	DrawableGrid *getDrawableGrid() { return &m_drawableGrid; }					///< Spatial index of all the drawables in the world
 
 	void step(); ///< Do one fixed time step
 
@@ -171,6 +173,7 @@ protected:
 	UnsignedInt m_frame;																				///< Simulation frame number from server
 
 	Drawable *m_drawableList;																		///< All of the drawables in the world
+	DrawableGrid m_drawableGrid;																///< All of the drawables in the world by position
 //	DrawablePtrHash m_drawableHash;															///< Used for DrawableID lookups
 	DrawablePtrVector m_drawableVector;
 
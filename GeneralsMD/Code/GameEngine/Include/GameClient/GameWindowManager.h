@@ -273,6 +273,10 @@ public:
 	down the hierarchy.  If 'window' is nullptr then all windows will
 	be searched */
 	virtual GameWindow *winGetWindowFromId( GameWindow *window, Int id );
+	void winIdChanged( GameWindow *window, Int oldId );  ///< file a window under its new id
+
+	/// turn the window id registry and the child hit grids on or off, to check them against the full searches
+	void setLookupAccelerationEnabled( Bool enabled );
 	virtual Int winCapture( GameWindow *window );  ///< captures the mouse
 	virtual Int winRelease( GameWindow *window );  ///< release mouse capture
 	virtual GameWindow *winGetCapture();  ///< current mouse capture settings
@@ -340,6 +344,12 @@ protected:
 
 	void dumpWindow( GameWindow *window );  ///< for debugging
 
+	void registerWindowId( GameWindow *window );  ///< file a window under its current id
+	Bool unregisterWindowId( GameWindow *window, Int id );  ///< returns FALSE if it wasn't filed under id
+	GameWindow *findWindowFromIdInRegistry( GameWindow *window, Int id );
+	GameWindow *findWindowFromIdInTree( GameWindow *window, Int id );  ///< the depth first search of winGetWindowFromId
+	static Bool isInIdSearchScope( GameWindow *found, GameWindow *window );  ///< is found in the trees searched from window
+
 	GameWindow *m_windowList;			// list of all top level windows
 	GameWindow *m_windowTail;			// last in windowList
 
@@ -355,6 +365,13 @@ protected:
 	const Image *m_cursorBitmap;
 	UnsignedInt m_captureFlags;
 
+	// GeneralsX @performance 18/10/2026 winGetWindowFromId searched the whole window tree on every
+	// call. All windows are now filed under their id as well, from creation to destruction.
+	typedef std::vector<GameWindow *> GameWindowVector;
+	typedef std::hash_map< Int, GameWindowVector, rts::hash<Int>, rts::equal_to<Int> > WindowIdMap;
+	WindowIdMap m_windowIdMap;
+	Bool m_useWindowIdMap;
+
 };
 
 // INLINE /////////////////////////////////////////////////////////////////////////////////////////
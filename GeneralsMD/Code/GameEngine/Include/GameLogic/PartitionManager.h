@@ -386,6 +386,8 @@ private:
 	PartitionData								*m_prev;									///< prev module in master list
 	PartitionData								*m_nextDirty;
 	PartitionData								*m_prevDirty;
+	PartitionData								*m_nextShroudDirtyGhost;		///< next module in the list of ghost owners with invalid shroud status
+	PartitionData								*m_prevShroudDirtyGhost;		///< prev module in the list of ghost owners with invalid shroud status
 
 	Int													m_coiArrayCount;					///< number of COIs allocated (may be more than are in use)
 	Int													m_coiInUseCount;					///< number of COIs that are actually in use
@@ -582,6 +584,32 @@ public:
 		m_nextDirty = 0;
 	}
 
+	// GeneralsX @performance 18/10/2026 Objects owning a ghost object are kept in a list while their
+	// shroud status is invalid, so that the client only refreshes those for the non local players.
+	PartitionData *friend_getNextShroudDirtyGhost() const { return m_nextShroudDirtyGhost; }
+	Bool isInListShroudDirtyGhosts(PartitionData* const* pListHead) const
+	{
+		return (*pListHead == this || m_prevShroudDirtyGhost || m_nextShroudDirtyGhost);
+	}
+	void prependToShroudDirtyGhosts(PartitionData** pListHead)
+	{
+		m_nextShroudDirtyGhost = *pListHead;
+		if (*pListHead)
+			(*pListHead)->m_prevShroudDirtyGhost = this;
+		*pListHead = this;
+	}
+	void removeFromShroudDirtyGhosts(PartitionData** pListHead)
+	{
+		if (m_nextShroudDirtyGhost)
+			m_nextShroudDirtyGhost->m_prevShroudDirtyGhost = m_prevShroudDirtyGhost;
+		if (m_prevShroudDirtyGhost)
+			m_prevShroudDirtyGhost->m_nextShroudDirtyGhost = m_nextShroudDirtyGhost;
+		else
+			*pListHead = m_nextShroudDirtyGhost;
+		m_prevShroudDirtyGhost = 0;
+		m_nextShroudDirtyGhost = 0;
+	}
+
 };
 
 //=====================================
@@ -1249,6 +1277,7 @@ private:
 	Int							m_totalCellCount;	///< x * y
 	PartitionCell*	m_cells;					///< array of cells
 	PartitionData*	m_dirtyModules;
+	PartitionData*	m_shroudDirtyGhosts;	///< objects owning a ghost object whose shroud status needs to be refreshed
 	Bool						m_updatedSinceLastReset;	///< Used to force a return of OBJECTSHROUD_INVALID before update has been called.
 
 	std::queue<SightingInfo *> m_pendingUndoShroudReveals;	///< Anything can queue up an Undo to happen later. This is a queue, because "later" is a constant
@@ -1489,6 +1518,34 @@ public:
 		}
 	}
 
+	Bool isInListShroudDirtyGhosts(PartitionData* o) const
+	{
+		return o->isInListShroudDirtyGhosts(&m_shroudDirtyGhosts);
+	}
+	void prependToShroudDirtyGhosts(PartitionData* o)
+	{
+		o->prependToShroudDirtyGhosts(&m_shroudDirtyGhosts);
+	}
+	void removeFromShroudDirtyGhosts(PartitionData* o)
+	{
+		o->removeFromShroudDirtyGhosts(&m_shroudDirtyGhosts);
+	}
+	void removeAllShroudDirtyGhosts()
+	{
+		while (m_shroudDirtyGhosts)
+		{
+			PartitionData *tmp = m_shroudDirtyGhosts;
+			removeFromShroudDirtyGhosts(tmp);
+		}
+	}
+
+	/**
+		Refresh the shroud status of the given players for the objects owning a ghost object whose
+		status was invalidated, so that they take or free their fog snapshots in time. Objects that are
+		up to date for all of the given players are not visited again until their status is invalidated.
+	*/
+	void updateShroudDirtyGhosts(const Int *playerIndices, Int numPlayers);
+
 	/**
 		virtual Reveals the map for the given player, but does not override Shroud generation.  (Script)
 		*/
@@ -84,6 +84,7 @@
 #include "GameLogic/GameLogic.h"
 #include "GameLogic/GhostObject.h"
 #include "GameLogic/Object.h"
+#include "GameLogic/PartitionManager.h"
 #include "GameLogic/ScriptEngine.h"		// For TheScriptEngine - jkmcd
 
 #define DRAWABLE_HASH_SIZE	8192
@@ -478,6 +479,7 @@ void GameClient::reset()
 		destroyDrawable( draw );
 	}
 	m_drawableList = nullptr;
+	m_drawableGrid.reset();
 
 	TheDisplay->reset();
 	TheTerrainVisual->reset();
@@ -518,6 +520,9 @@ void GameClient::registerDrawable( Drawable *draw )
 	// add the drawable to the master list
 	draw->prependToList( &m_drawableList );
 
+	// and to the grid used for region queries
+	m_drawableGrid.addDrawable( draw );
+
 }
 
 /** -----------------------------------------------------------------------------------------------
@@ -632,6 +637,12 @@ void GameClient::update()
 				}
 				//update ghost objects which don't have drawables or objects.
 				TheGhostObjectManager->updateOrphanedObjects(nonLocalPlayerIndices, numNonLocalPlayers);
+
+				// GeneralsX @performance 18/10/2026 Update the shrouded status for the non local players only
+				// for the objects that own a ghost object and whose status was invalidated since the last update,
+				// instead of asking every drawable's object for every player each frame.
+				if (numNonLocalPlayers > 0)
+					ThePartitionManager->updateShroudDirtyGhosts(nonLocalPlayerIndices, numNonLocalPlayers);
 			}
 			else
 			{
@@ -658,21 +669,6 @@ void GameClient::update()
 				Object *object=draw->getObject();
 				if (object)
 				{
-					if (TheGhostObjectManager->trackAllPlayers())
-					{
-						// TheSuperHackers @info Update the shrouded status for all objects
-						// that own a ghost object for all non local players. This is costly.
-						if (object->hasGhostObject())
-						{
-							Int *playerIndex = nonLocalPlayerIndices;
-							Int *const playerIndexEnd = nonLocalPlayerIndices + numNonLocalPlayers;
-							for (; playerIndex < playerIndexEnd; ++playerIndex)
-							{
-								object->getShroudedStatus(*playerIndex);
-							}
-						}
-					}
-
 					ObjectShroudStatus ss=object->getShroudedStatus(localPlayerIndex);
 					if (ss >= OBJECTSHROUD_FOGGED && draw->getShroudClearFrame() != InvalidShroudClearFrame) {
 						UnsignedInt limit = 2*LOGICFRAMES_PER_SECOND;
@@ -812,6 +808,32 @@ void GameClient::iterateDrawablesInRegion( Region3D *region, GameClientFuncPtr u
 {
 	Drawable *draw, *nextDrawable;
 
+	// GeneralsX @performance 18/10/2026 Only visit the drawables in the grid cells the region
+	// overlaps. The grid returns them in drawable list order, so callers see the same sequence.
+	if( region != nullptr )
+	{
+		std::vector<DrawableID> candidates;
+		if( m_drawableGrid.collectDrawablesInBox( region->lo.x, region->lo.y, region->hi.x, region->hi.y, candidates ) )
+		{
+			for( size_t i = 0; i < candidates.size(); ++i )
+			{
+				// look it up again, an earlier callback may have destroyed it
+				draw = findDrawableByID( candidates[ i ] );
+				if( draw == nullptr )
+					continue;
+
+				Coord3D pos = *draw->getPosition();
+				if( pos.x >= region->lo.x && pos.x <= region->hi.x &&
+						pos.y >= region->lo.y && pos.y <= region->hi.y &&
+						pos.z >= region->lo.z && pos.z <= region->hi.z )
+				{
+					(*userFunc)( draw, userData );
+				}
+			}
+			return;
+		}
+	}
+
 	for( draw = m_drawableList; draw; draw=nextDrawable )
 	{
 		nextDrawable = draw->getNextDrawable();
@@ -858,6 +880,7 @@ void GameClient::destroyDrawable( Drawable *draw )
 
 	// remove from the master list
 	draw->removeFromList(&m_drawableList);
+	m_drawableGrid.removeDrawable( draw );
 
 	//
 	// because drawables and objects are tightly coupled, not only MUST we maintain
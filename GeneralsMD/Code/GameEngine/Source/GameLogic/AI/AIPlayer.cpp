@@ -571,14 +571,14 @@ Object *AIPlayer::buildStructureWithDozer(const ThingTemplate *bldgPlan, BuildLi
 					if (isSkirmishAI()) xPos += PATHFIND_CELL_SIZE_F;
 					newPos.x = xPos;
 					newPos.y = yPos;
-					valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, bldgPlan, angle,
+					valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, bldgPlan, angle,
 																							 BuildAssistant::CLEAR_PATH |
 																							 BuildAssistant::TERRAIN_RESTRICTIONS |
 																							 BuildAssistant::NO_OBJECT_OVERLAP,
 																							 dozer, m_player ) == LBC_OK;
 					if (valid) break;
 					newPos.y = yPos+posOffset;
-					valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, bldgPlan, angle,
+					valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, bldgPlan, angle,
 																							 BuildAssistant::CLEAR_PATH |
 																							 BuildAssistant::TERRAIN_RESTRICTIONS |
 																							 BuildAssistant::NO_OBJECT_OVERLAP,
@@ -590,14 +590,14 @@ Object *AIPlayer::buildStructureWithDozer(const ThingTemplate *bldgPlan, BuildLi
 					if (isSkirmishAI()) yPos += PATHFIND_CELL_SIZE_F;
 					newPos.x = xPos;
 					newPos.y = yPos;
-					valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, bldgPlan, angle,
+					valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, bldgPlan, angle,
 																							 BuildAssistant::CLEAR_PATH |
 																							 BuildAssistant::TERRAIN_RESTRICTIONS |
 																							 BuildAssistant::NO_OBJECT_OVERLAP,
 																							 dozer, m_player ) == LBC_OK;
 					if (valid) break;
 					newPos.x = xPos+posOffset;
-					valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, bldgPlan, angle,
+					valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, bldgPlan, angle,
 																							 BuildAssistant::CLEAR_PATH |
 																							 BuildAssistant::TERRAIN_RESTRICTIONS |
 																							 BuildAssistant::NO_OBJECT_OVERLAP,
@@ -1932,7 +1932,7 @@ void AIPlayer::buildBySupplies(Int minimumCash, const AsciiString& thingName)
 				for (xPos = location.x-offset; xPos <= location.x+offset; xPos+=PATHFIND_CELL_SIZE_F) {
 					newPos.x = xPos;
 					newPos.y = yPos;
-					valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, tTemplate, angle,
+					valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, tTemplate, angle,
 																							 BuildAssistant::CLEAR_PATH |
 																							 BuildAssistant::TERRAIN_RESTRICTIONS |
 																							 BuildAssistant::NO_OBJECT_OVERLAP,
@@ -1941,7 +1941,7 @@ void AIPlayer::buildBySupplies(Int minimumCash, const AsciiString& thingName)
 					if( TheGlobalData->m_debugSupplyCenterPlacement )
 						DEBUG_LOG(("buildBySupplies -- Fail at (%.2f,%.2f)", newPos.x, newPos.y));
 					newPos.y = yPos+posOffset;
-					valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, tTemplate, angle,
+					valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, tTemplate, angle,
 																							 BuildAssistant::CLEAR_PATH |
 																							 BuildAssistant::TERRAIN_RESTRICTIONS |
 																							 BuildAssistant::NO_OBJECT_OVERLAP,
@@ -1955,7 +1955,7 @@ void AIPlayer::buildBySupplies(Int minimumCash, const AsciiString& thingName)
 				for (yPos = location.y-offset; yPos <= location.y+offset; yPos+=PATHFIND_CELL_SIZE_F) {
 					newPos.x = xPos;
 					newPos.y = yPos;
-					valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, tTemplate, angle,
+					valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, tTemplate, angle,
 																							 BuildAssistant::CLEAR_PATH |
 																							 BuildAssistant::TERRAIN_RESTRICTIONS |
 																							 BuildAssistant::NO_OBJECT_OVERLAP,
@@ -1964,7 +1964,7 @@ void AIPlayer::buildBySupplies(Int minimumCash, const AsciiString& thingName)
 					if( TheGlobalData->m_debugSupplyCenterPlacement )
 						DEBUG_LOG(("buildBySupplies -- Fail at (%.2f,%.2f)", newPos.x, newPos.y));
 					newPos.x = xPos+posOffset;
-					valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, tTemplate, angle,
+					valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, tTemplate, angle,
 																							 BuildAssistant::CLEAR_PATH |
 																							 BuildAssistant::TERRAIN_RESTRICTIONS |
 																							 BuildAssistant::NO_OBJECT_OVERLAP,
@@ -2030,7 +2030,7 @@ Bool AIPlayer::calcClosestConstructionZoneLocation( const ThingTemplate *constru
 			{
 				newPos.x = xPos;
 				newPos.y = yPos;
-				valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, constructTemplate, angle,
+				valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, constructTemplate, angle,
 																						 BuildAssistant::CLEAR_PATH |
 																						 BuildAssistant::TERRAIN_RESTRICTIONS |
 																						 BuildAssistant::NO_OBJECT_OVERLAP,
@@ -2039,7 +2039,7 @@ Bool AIPlayer::calcClosestConstructionZoneLocation( const ThingTemplate *constru
 					break;
 
 				newPos.y = yPos + posOffset;
-				valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, constructTemplate, angle,
+				valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, constructTemplate, angle,
 																						 BuildAssistant::CLEAR_PATH |
 																						 BuildAssistant::TERRAIN_RESTRICTIONS |
 																						 BuildAssistant::NO_OBJECT_OVERLAP,
@@ -2054,7 +2054,7 @@ Bool AIPlayer::calcClosestConstructionZoneLocation( const ThingTemplate *constru
 			{
 				newPos.x = xPos;
 				newPos.y = yPos;
-				valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, constructTemplate, angle,
+				valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, constructTemplate, angle,
 																						 BuildAssistant::CLEAR_PATH |
 																						 BuildAssistant::TERRAIN_RESTRICTIONS |
 																						 BuildAssistant::NO_OBJECT_OVERLAP,
@@ -2063,7 +2063,7 @@ Bool AIPlayer::calcClosestConstructionZoneLocation( const ThingTemplate *constru
 					break;
 
 				newPos.x = xPos + posOffset;
-				valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, constructTemplate, angle,
+				valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, constructTemplate, angle,
 																						 BuildAssistant::CLEAR_PATH |
 																						 BuildAssistant::TERRAIN_RESTRICTIONS |
 																						 BuildAssistant::NO_OBJECT_OVERLAP,
@@ -2142,7 +2142,7 @@ void AIPlayer::buildSpecificBuildingNearestTeam( const AsciiString &thingName, c
 			{
 				newPos.x = xPos;
 				newPos.y = yPos;
-				valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, tTemplate, angle,
+				valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, tTemplate, angle,
 																						 BuildAssistant::CLEAR_PATH |
 																						 BuildAssistant::TERRAIN_RESTRICTIONS |
 																						 BuildAssistant::NO_OBJECT_OVERLAP,
@@ -2151,7 +2151,7 @@ void AIPlayer::buildSpecificBuildingNearestTeam( const AsciiString &thingName, c
 					break;
 
 				newPos.y = yPos + posOffset;
-				valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, tTemplate, angle,
+				valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, tTemplate, angle,
 																						 BuildAssistant::CLEAR_PATH |
 																						 BuildAssistant::TERRAIN_RESTRICTIONS |
 																						 BuildAssistant::NO_OBJECT_OVERLAP,
@@ -2166,7 +2166,7 @@ void AIPlayer::buildSpecificBuildingNearestTeam( const AsciiString &thingName, c
 			{
 				newPos.x = xPos;
 				newPos.y = yPos;
-				valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, tTemplate, angle,
+				valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, tTemplate, angle,
 																						 BuildAssistant::CLEAR_PATH |
 																						 BuildAssistant::TERRAIN_RESTRICTIONS |
 																						 BuildAssistant::NO_OBJECT_OVERLAP,
@@ -2175,7 +2175,7 @@ void AIPlayer::buildSpecificBuildingNearestTeam( const AsciiString &thingName, c
 					break;
 
 				newPos.x = xPos + posOffset;
-				valid = TheBuildAssistant->isLocationLegalToBuild( &newPos, tTemplate, angle,
+				valid = TheBuildAssistant->isCandidateLocationLegalToBuild( &newPos, tTemplate, angle,
 																						 BuildAssistant::CLEAR_PATH |
 																						 BuildAssistant::TERRAIN_RESTRICTIONS |
 																						 BuildAssistant::NO_OBJECT_OVERLAP,
@@ -50,6 +50,7 @@
 #include "PreRTS.h"	// This must go first in EVERY cpp file in the GameEngine
 
 #include "Common/ActionManager.h"
+#include "Common/BuildAssistant.h"
 #include "Common/DiscreteCircle.h"
 #include "Common/GameEngine.h"
 #include "Common/GameState.h"
@@ -1549,6 +1550,8 @@ PartitionData::PartitionData()
 	m_prev = nullptr;
 	m_nextDirty = nullptr;
 	m_prevDirty = nullptr;
+	m_nextShroudDirtyGhost = nullptr;
+	m_prevShroudDirtyGhost = nullptr;
 	m_object = nullptr;
 	m_ghostObject = nullptr;
 	m_coiArrayCount = 0;
@@ -1578,6 +1581,8 @@ PartitionData::~PartitionData()
 		ThePartitionManager->removeFromDirtyModules(this);
 		//DEBUG_ASSERTCRASH(!ThePartitionManager->isInListDirtyModules(this), ("hmm"));
 	}
+	if (ThePartitionManager && ThePartitionManager->isInListShroudDirtyGhosts(this))
+		ThePartitionManager->removeFromShroudDirtyGhosts(this);
 }
 
 //-----------------------------------------------------------------------------
@@ -2156,6 +2161,10 @@ void PartitionData::updateCellsTouched()
 	// so it must all be invalidated.
 	invalidateShroudedStatusForAllPlayers();
 
+	// GeneralsX @performance 18/10/2026 The buildability grid places the immobile objects again.
+	if (obj && TheBuildAssistant)
+		TheBuildAssistant->objectFootprintChanged(obj);
+
 #ifdef INTENSE_DEBUG
 	for (Int i = 0; i < m_coiInUseCount; i++)
 	{
@@ -2178,6 +2187,9 @@ void PartitionData::invalidateShroudedStatusForPlayer(Int playerIndex)
 	if (m_shroudedness[playerIndex] != OBJECTSHROUD_INVALID && m_shroudedness[playerIndex] != OBJECTSHROUD_INVALID_BUT_PREVIOUS_VALID)
 #endif
 		m_shroudedness[playerIndex] = OBJECTSHROUD_INVALID;
+
+	if (m_object && m_ghostObject && !ThePartitionManager->isInListShroudDirtyGhosts(this))
+		ThePartitionManager->prependToShroudDirtyGhosts(this);
 }
 
 //-----------------------------------------------------------------------------
@@ -2319,7 +2331,13 @@ void PartitionData::attachToObject(Object* object)
 			}
 		}
 		if (makeGhostObject)
+		{
 			m_ghostObject = TheGhostObjectManager->addGhostObject(object, this);
+
+			// nobody has computed our shroud status yet
+			if (m_ghostObject && !ThePartitionManager->isInListShroudDirtyGhosts(this))
+				ThePartitionManager->prependToShroudDirtyGhosts(this);
+		}
 	}
 
 	//DEBUG_LOG(("attach pd for pd %08lx obj %08lx",this,m_object));
@@ -2355,6 +2373,9 @@ void PartitionData::detachFromObject()
 
 	//DEBUG_LOG(("detach pd for pd %08lx obj %08lx",this,m_object));
 
+	if (ThePartitionManager->isInListShroudDirtyGhosts(this))
+		ThePartitionManager->removeFromShroudDirtyGhosts(this);
+
 	// no longer attached to object
 	m_object = nullptr;
 	TheGhostObjectManager->removeGhostObject(m_ghostObject);
@@ -2401,6 +2422,9 @@ void PartitionData::detachFromGhostObject()
 
 	//DEBUG_LOG(("detach pd for pd %08lx obj %08lx",this,m_object));
 
+	if (ThePartitionManager->isInListShroudDirtyGhosts(this))
+		ThePartitionManager->removeFromShroudDirtyGhosts(this);
+
 	// no longer attached to object
 	m_object = nullptr;
 	m_ghostObject = nullptr;
@@ -2621,6 +2645,7 @@ PartitionManager::PartitionManager()
 	m_worldExtents.lo.zero();
 	m_worldExtents.hi.zero();
 	m_dirtyModules = nullptr;
+	m_shroudDirtyGhosts = nullptr;
 	m_updatedSinceLastReset = false;
 #ifdef FASTER_GCO
 	m_maxGcoRadius = 0;
@@ -2647,15 +2672,27 @@ static void calcHeights(const Region3D& world, Real cellSize, Int x, Int y, Real
 	Real step = cellSize / numSteps;
 	loZ = HUGE_DIST;		// huge positive
 	hiZ = -HUGE_DIST;		// huge negative
+
+	// GeneralsX @performance 18/10/2026 Query the heights of all the sample points of the cell in one batch
+	std::vector<Real> sampleX;
+	std::vector<Real> sampleY;
 	for (Real yy = 0; yy <= cellSize; yy += step)
 	{
 		for (Real xx = 0; xx <= cellSize; xx += step)
 		{
-			Real h = TheTerrainLogic->getGroundHeight( xbase + xx, ybase + yy );
-			if (h < loZ) loZ = h;
-			if (h > hiZ) hiZ = h;
+			sampleX.push_back(xbase + xx);
+			sampleY.push_back(ybase + yy);
 		}
 	}
+	Int numSamples = (Int)sampleX.size();
+	std::vector<Real> heights(numSamples);
+	TheTerrainLogic->getGroundHeights(&sampleX[0], &sampleY[0], numSamples, &heights[0]);
+	for (Int i = 0; i < numSamples; i++)
+	{
+		Real h = heights[i];
+		if (h < loZ) loZ = h;
+		if (h > hiZ) hiZ = h;
+	}
 }
 #endif
 
@@ -2752,6 +2789,7 @@ void PartitionManager::shutdown()
 {
 	m_updatedSinceLastReset = false;
 	removeAllDirtyModules();
+	removeAllShroudDirtyGhosts();
 
 #ifdef RTS_DEBUG
 	// the above *should* remove all the touched cells (via unRegisterObject), but let's check:
@@ -2942,6 +2980,10 @@ void PartitionManager::unRegisterObject( Object* object )
 	if( mod == nullptr )
 		return;
 
+	// GeneralsX @performance 18/10/2026 The buildability grid places the immobile objects again.
+	if( TheBuildAssistant )
+		TheBuildAssistant->objectFootprintChanged( object );
+
 	GhostObject *ghost;
 
 	// need to figure out if any players have a fogged memory of this object.
@@ -3117,6 +3159,39 @@ void PartitionManager::refreshShroudForLocalPlayer()
 	}
 }
 
+//-----------------------------------------------------------------------------
+void PartitionManager::updateShroudDirtyGhosts(const Int *playerIndices, Int numPlayers)
+{
+	PartitionData *next;
+	for (PartitionData *mod = m_shroudDirtyGhosts; mod; mod = next)
+	{
+		// getting the status never unlinks other modules, but it may relink this one
+		next = mod->friend_getNextShroudDirtyGhost();
+
+		Object *object = mod->getObject();
+		if (object == nullptr || mod->getGhostObject() == nullptr || object->isKindOf(KINDOF_ALWAYS_VISIBLE))
+		{
+			removeFromShroudDirtyGhosts(mod);
+			continue;
+		}
+
+		// snapshots need the drawable, keep it listed until it has one
+		if (object->getDrawable() == nullptr)
+			continue;
+
+		Bool allValid = TRUE;
+		for (Int i = 0; i < numPlayers; ++i)
+		{
+			ObjectShroudStatus status = mod->getShroudedStatus(playerIndices[i]);
+			if (status == OBJECTSHROUD_INVALID || status == OBJECTSHROUD_INVALID_BUT_PREVIOUS_VALID)
+				allValid = FALSE;
+		}
+
+		if (allValid)
+			removeFromShroudDirtyGhosts(mod);
+	}
+}
+
 //-----------------------------------------------------------------------------
 CellShroudStatus PartitionManager::getShroudStatusForPlayer(Int playerIndex, Int x, Int y) const
 {
@@ -53,6 +53,7 @@
 #include "Common/GameUtility.h"
 #include "Common/INI.h"
 #include "Common/LatchRestore.h"
+#include "Common/MapLoadBenchmark.h"
 #include "Common/MapObject.h"
 #include "Common/MultiplayerSettings.h"
 #include "Common/OSDisplay.h"
@@ -67,6 +68,7 @@
 #include "Common/ThingFactory.h"
 #include "Common/Team.h"
 #include "Common/ThingTemplate.h"
+#include "Common/UpdateProfiler.h"
 #include "GameClient/Water.h"
 #include "GameClient/Snow.h"
 #include "Common/WellKnownKeys.h"
@@ -1211,6 +1213,7 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 #endif
 
 	setLoadingMap( TRUE );
+	MapLoadBenchmark::beginMapLoad();
 
 	if( loadingSaveGame == FALSE )
 	{
@@ -1366,7 +1369,7 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 	//****************************//
 
 	// Get the m_loadScreen for this kind of game
-	if(!m_loadScreen && !(TheRecorder && TheRecorder->getMode() == RECORDERMODETYPE_SIMULATION_PLAYBACK))
+	if(!m_loadScreen && !(TheRecorder && TheRecorder->getMode() == RECORDERMODETYPE_SIMULATION_PLAYBACK) && !MapLoadBenchmark::isRunning())
 	{
 		m_loadScreen = getLoadScreen( loadingSaveGame );
 		if(m_loadScreen)
@@ -1395,10 +1398,12 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 	DEBUG_ASSERTCRASH(m_frame == 0, ("framecounter expected to be 0 here"));
 
 	// before loading the map, load the map.ini file in the same directory.
+	MapLoadBenchmark::beginStage(MapLoadBenchmark::STAGE_TERRAIN_LOAD);
 	loadMapINI( TheGlobalData->m_mapName );
 
 	// load a map
 	TheTerrainLogic->loadMap( TheGlobalData->m_mapName, false );
+	MapLoadBenchmark::endStage(MapLoadBenchmark::STAGE_TERRAIN_LOAD);
 	// anytime the world's size changes, must reset the partition mgr
 	//ThePartitionManager->init();
 
@@ -1603,7 +1608,9 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 	updateLoadProgress(LOAD_PROGRESS_POST_PLAYER_LIST_RESET);
 
 	// Tell the script engine that a newe set of scripts is loaded.
+	MapLoadBenchmark::beginStage(MapLoadBenchmark::STAGE_SCRIPT_ENGINE);
 	TheScriptEngine->newMap();
+	MapLoadBenchmark::endStage(MapLoadBenchmark::STAGE_SCRIPT_ENGINE);
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_SCRIPT_ENGINE_NEW_MAP);
@@ -1789,8 +1796,10 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 	setHeight( extent.hi.y - extent.lo.y );
 
 	// anytime the world's size changes, must reset the partition mgr
+	MapLoadBenchmark::beginStage(MapLoadBenchmark::STAGE_PARTITION_MANAGER);
 	ThePartitionManager->init();
 	ThePartitionManager->refreshShroudForLocalPlayer();// Can't do this until after init, and doesn't seem right to do in init
+	MapLoadBenchmark::endStage(MapLoadBenchmark::STAGE_PARTITION_MANAGER);
 
 	TheGhostObjectManager->setLocalPlayerIndex(localPlayer->getPlayerIndex());
 	TheGhostObjectManager->reset();
@@ -1799,7 +1808,9 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 	updateLoadProgress(LOAD_PROGRESS_POST_GHOST_OBJECT_MANAGER_RESET);
 
 	// update the terrain logic now that all is loaded
+	MapLoadBenchmark::beginStage(MapLoadBenchmark::STAGE_TERRAIN_NEW_MAP);
 	TheTerrainLogic->newMap( loadingSaveGame );
+	MapLoadBenchmark::endStage(MapLoadBenchmark::STAGE_TERRAIN_NEW_MAP);
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_TERRAIN_LOGIC_NEW_MAP);
@@ -1859,7 +1870,9 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 
 	// tell the AI about it
 	// Note that it is important that the pathfinder be called before the map objects are loaded.
+	MapLoadBenchmark::beginStage(MapLoadBenchmark::STAGE_PATHFINDER);
 	TheAI->pathfinder()->newMap();
+	MapLoadBenchmark::endStage(MapLoadBenchmark::STAGE_PATHFINDER);
 
 	// update the loadscreen
 	updateLoadProgress(LOAD_PROGRESS_POST_PATHFINDER_NEW_MAP);
@@ -1900,6 +1913,8 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 	DEBUG_LOG(("%s", Buf));
 	#endif
 
+	MapLoadBenchmark::beginStage(MapLoadBenchmark::STAGE_MAP_OBJECTS);
+
 	Bool useTrees = TheGlobalData->m_useTrees;
 
 	// If forceFluffToProp == true, removable objects get created on client only. [7/14/2003]
@@ -2048,6 +2063,8 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 
 	}
 
+	MapLoadBenchmark::endStage(MapLoadBenchmark::STAGE_MAP_OBJECTS);
+
 	#ifdef DUMP_PERF_STATS
 	GetPrecisionTimer(&endTime64);
 	sprintf(Buf,"After loading objects=%f",((double)(endTime64-startTime64)/(double)(freq64)*1000.0));
@@ -2131,6 +2148,7 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 	// will build and various damage states for all the structures on the map so that we
 	// don't have big pauses when building those objects or switching to those states
 	//
+	MapLoadBenchmark::beginStage(MapLoadBenchmark::STAGE_PRELOAD_ASSETS);
 	if( TheGlobalData->m_preloadAssets )
 	{
 		if (TheGlobalData->m_preloadEverything)
@@ -2143,6 +2161,7 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 			TheGameClient->preloadAssets( TheGlobalData->m_timeOfDay );
 		}
 	}
+	MapLoadBenchmark::endStage(MapLoadBenchmark::STAGE_PRELOAD_ASSETS);
 
 	//put this here somewhat randomly.
 	TheControlBar->hideCommunicator( FALSE );
@@ -2209,7 +2228,9 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 
 	// update partition info - We need to do the initial update so that it can be queried
 	// during the first frame.  jba.
+	MapLoadBenchmark::beginStage(MapLoadBenchmark::STAGE_PARTITION_MANAGER);
 	ThePartitionManager->update();
+	MapLoadBenchmark::endStage(MapLoadBenchmark::STAGE_PARTITION_MANAGER);
 
 	#ifdef DUMP_PERF_STATS
 	GetPrecisionTimer(&endTime64);
@@ -2479,6 +2500,7 @@ void GameLogic::tryStartNewGame( Bool loadingSaveGame )
 	//ReAllows quit menu to work during loading scene
 	//setGameLoading(FALSE);
 	setLoadingMap( FALSE );
+	MapLoadBenchmark::endMapLoad();
 
 #ifdef DUMP_PERF_STATS
 	GetPrecisionTimer(&endTime64);
@@ -3843,6 +3865,7 @@ void GameLogic::update()
 {
 	USE_PERF_TIMER(GameLogic_update)
 	PROFILER_SECTION_COLOR(0x4CAF50);
+	UpdateProfiler::SectionScope profileLogicUpdate(UpdateProfiler::SECTION_LOGIC_UPDATE);
 
 	// GeneralsX @bugfix fbraz3 16/07/2026 Lock FPU state before every simulation frame
 	ScopedFPUGuard fpuGuard;
@@ -3896,6 +3919,7 @@ void GameLogic::update()
 
 	// update (execute) scripts
 	{
+		UPDATE_PROFILER_SECTION(UpdateProfiler::SECTION_SCRIPT_ENGINE, "ScriptEngine");
 		TheScriptEngine->UPDATE();
 	}
 
@@ -3908,6 +3932,7 @@ void GameLogic::update()
 	// Note - TerrainLogic update needs to happen after ScriptEngine update, but before object updates.  jba.
 	// This way changes in bridges are noted in the script engine before being cleared in TerrainLogic->update
 	{
+		UPDATE_PROFILER_SECTION(UpdateProfiler::SECTION_TERRAIN_LOGIC, "TerrainLogic");
 		TheTerrainLogic->UPDATE();
 	}
 
@@ -3956,9 +3981,12 @@ void GameLogic::update()
 
 	// process client commands
 	{
+		UPDATE_PROFILER_SECTION(UpdateProfiler::SECTION_COMMAND_LIST, "CommandList");
 		processCommandList( TheCommandList );
 	}
 
+	const Int64 profileModulesStart = UpdateProfiler::beginTiming();
+
 #ifdef ALLOW_NONSLEEPY_UPDATES
 	{
 		for (std::list<UpdateModulePtr>::const_iterator it = m_normalUpdates.begin(); it != m_normalUpdates.end(); ++it)
@@ -3977,6 +4005,8 @@ void GameLogic::update()
 			{
 				USE_PERF_TIMER(GameLogic_update_normal)
 
+				UPDATE_PROFILER_MODULE_ZONE(u);
+				const Int64 profileStart = UpdateProfiler::beginTiming();
 				m_curUpdateModule = u;
 
 				#ifdef DEBUG_LOGGING
@@ -3987,6 +4017,7 @@ void GameLogic::update()
 				#endif
 
 				m_curUpdateModule = nullptr;
+				UpdateProfiler::endModule(u, profileStart, UPDATE_SLEEP_NONE);
 			}
 		}
 	}
@@ -4026,6 +4057,8 @@ void GameLogic::update()
 				USE_PERF_TIMER(GameLogic_update_sleepy)
 
 				//DEBUG_LOG(("calling update %08lx (%d %d)...",update,update->friend_getNextCallFrame(),update->friend_getNextCallPhase()));
+				UPDATE_PROFILER_MODULE_ZONE(u);
+				const Int64 profileStart = UpdateProfiler::beginTiming();
 				m_curUpdateModule = u;
 
 				sleepLen = u->update();
@@ -4034,6 +4067,7 @@ void GameLogic::update()
 					sleepLen = UPDATE_SLEEP_NONE;
 
 				m_curUpdateModule = nullptr;
+				UpdateProfiler::endModule(u, profileStart, sleepLen);
 
 			}
 
@@ -4043,20 +4077,25 @@ void GameLogic::update()
 		}
 	}
 
+	UpdateProfiler::endSection(UpdateProfiler::SECTION_UPDATE_MODULES, profileModulesStart);
+
 	validateSleepyUpdate();
 
 	// update the Artificial Intelligence system
 	{
+		UPDATE_PROFILER_SECTION(UpdateProfiler::SECTION_AI, "AI");
 		TheAI->UPDATE();
 	}
 
 	// production updates
 	{
+		UPDATE_PROFILER_SECTION(UpdateProfiler::SECTION_BUILD_ASSISTANT, "BuildAssistant");
 		TheBuildAssistant->UPDATE();
 	}
 
 	// update partition info
 	{
+		UPDATE_PROFILER_SECTION(UpdateProfiler::SECTION_PARTITION_MANAGER, "PartitionManager");
 		ThePartitionManager->UPDATE();
 	}
 
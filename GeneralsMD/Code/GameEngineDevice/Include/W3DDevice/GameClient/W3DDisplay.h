@@ -151,6 +151,7 @@ public:
 	virtual Real getAverageFPS() override;						///< return the average FPS.
 	virtual Real getCurrentFPS() override;						///< return the current FPS.
 	virtual Int getLastFrameDrawCalls() override;				///< returns the number of draw calls issued in the previous frame
+	virtual Int benchmarkShadowSilhouettes( Int rounds ) override;
 
 protected:
 
@@ -207,6 +208,7 @@ protected:
 		NetFPSAverages,		///< debug display all players' average fps.
 		SelectedInfo,			///< debug display for the selected object in the UI
 		TerrainStats,			///< debug display for the terrain renderer
+		TextStats,				///< debug display for text sentence builds
 
 		DisplayStringCount
 	};
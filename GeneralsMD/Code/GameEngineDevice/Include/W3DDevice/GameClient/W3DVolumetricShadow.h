@@ -34,7 +34,6 @@
 class W3DShadowGeometry;	//forward reference
 class W3DShadowGeometryManager;	//forward reference
 struct Geometry;	//forward reference
-struct PolyNeighbor;	//forward reference
 class W3DVolumetricShadow;	//forward reference
 class Drawable;	//forward reference
 
@@ -136,9 +135,6 @@ class W3DVolumetricShadow	: public Shadow
 
 		// silhouette tools
 		void buildSilhouette(Int meshIndex, Vector3 *lightPosWorld);
-		void addSilhouetteEdge(Int meshIndex, PolyNeighbor *visible, PolyNeighbor *hidden );
-		void addNeighborlessEdges(Int meshIndex, PolyNeighbor *us );
-		void addSilhouetteIndices(Int meshIndex, Short edgeStart, Short edgeEnd );
 		Bool allocateSilhouette(Int meshIndex, Int numVertices );  // allocate memory for sil
 		void deleteSilhouette(Int meshIndex );  // resets and frees silhouette memory
 		void resetSilhouette( Int meshIndex );  // reset silhouette to empty
@@ -67,6 +67,10 @@ public:
 
 	virtual Bool isClearLineOfSight(const Coord3D& pos, const Coord3D& posOther) const override;
 
+	virtual Bool benchmarkLineOfSight( Int checks ) override;
+
+	virtual Bool benchmarkHeightQueries( Int queries ) override;
+
 protected:
 
 	// snapshot methods
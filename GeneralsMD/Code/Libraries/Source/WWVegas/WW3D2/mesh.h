@@ -135,6 +135,8 @@ public:
 
 	void								Get_Deformed_Vertices(Vector3 *dst_vert, Vector3 *dst_norm);
 	void								Get_Deformed_Vertices(Vector3 *dst_vert);
+	// GeneralsX @performance 18/10/2026 Deforms vertex_count vertices starting at first_vertex
+	void								Get_Deformed_Vertices(Vector3 *dst_vert, Vector3 *dst_norm, int first_vertex, int vertex_count);
 
 	void								Set_Lighting_Environment(LightEnvironmentClass * light_env) { if (light_env) {m_localLightEnv=*light_env;LightEnvironment = &m_localLightEnv;} else {LightEnvironment = nullptr;} }
 	LightEnvironmentClass *		Get_Lighting_Environment() { return LightEnvironment; }
@@ -221,6 +221,9 @@ protected:
 	// Destination pointers MUST point to arrays large enough to hold all vertices
 	void get_deformed_vertices(Vector3 *dst_vert, Vector3 *dst_norm, const HTreeClass * htree);
 	void get_deformed_vertices(Vector3 *dst_vert, const HTreeClass * htree);
+	// GeneralsX @performance 18/10/2026 Deforms vertex_count vertices starting at first_vertex into
+	// dst_vert[0] and dst_norm[0], so the parts of a big skin can be deformed on different threads
+	void get_deformed_vertices(Vector3 *dst_vert, Vector3 *dst_norm, const HTreeClass * htree, int first_vertex, int vertex_count);
 	void get_deformed_screenspace_vertices(Vector4 *dst_vert,const RenderInfoClass & rinfo,const Matrix3D & mesh_tm,const HTreeClass * htree);
 
 	// General info